@@ -41,8 +41,17 @@
   #pragma warning(disable : 4702) // unreachable code
 #endif
 
-#include "duktape/src-noline/duktape.c"
+#if defined (BLUEPRINT_DUKTAPE_ROM_BUILTINS) && BLUEPRINT_DUKTAPE_ROM_BUILTINS
+ #if ! __has_include ("duktape/src-rom/duktape.c")
+  #error "BLUEPRINT_DUKTAPE_ROM_BUILTINS needs the ROM build of Duktape in duktape/src-rom, see blueprint.h"
+ #endif
+ #include "duktape/src-rom/duktape.c"
+#else
+ #include "duktape/src-noline/duktape.c"
+#endif
+#include "duktape/extras/cbor/duk_cbor.c"
 #include "duktape/extras/console/duk_console.c"
+#include "duktape/extras/module-node/duk_module_node.c"
 
 #include "blueprint.h"
 
@@ -62,7 +71,19 @@
  #pragma warning (pop)
 #endif
 
+#include "core/blueprint_CanvasView.cpp"
+#include "core/blueprint_FilmstripView.cpp"
+#include "core/blueprint_KeyboardView.cpp"
+#include "core/blueprint_MeterView.cpp"
+#include "core/blueprint_NoteGridView.cpp"
 #include "core/blueprint_ReactApplicationRoot.cpp"
+#include "core/blueprint_ScopeView.cpp"
+#include "core/blueprint_ShaderView.cpp"
 #include "core/blueprint_ShadowView.cpp"
+#include "core/blueprint_SliderView.cpp"
+#include "core/blueprint_SpectrumView.cpp"
+#include "core/blueprint_TextInputView.cpp"
 #include "core/blueprint_TextShadowView.cpp"
 #include "core/blueprint_View.cpp"
+#include "core/blueprint_VirtualListView.cpp"
+#include "core/blueprint_WaveformView.cpp"
@@ -21,10 +21,103 @@
 #define BLUEPRINT_H_INCLUDED
 
 
+//==============================================================================
+/** Config: BLUEPRINT_DUKTAPE_PERFORMANCE_PROFILE
+    Builds Duktape with Blueprint's performance profile: fastints, a larger
+    string table and literal cache, and no debugger support. See
+    duktape/config/examples/blueprint.yaml.
+*/
+#ifndef BLUEPRINT_DUKTAPE_PERFORMANCE_PROFILE
+ #define BLUEPRINT_DUKTAPE_PERFORMANCE_PROFILE 0
+#endif
+
+/** Config: BLUEPRINT_DUKTAPE_ROM_BUILTINS
+    Builds against a Duktape with its built-in objects and strings in ROM, so
+    that every Duktape heap in the process shares them rather than creating its
+    own. This needs the ROM build of Duktape in duktape/src-rom, generated from
+    the duktape directory with:
+
+    python2 tools/configure.py --source-directory src-input --config-metadata config
+        --output-directory src-rom --rom-support
+        --option-file config/examples/blueprint.yaml
+        --option-file config/examples/rom_builtins.yaml
+        --fixup-line '#include "duk_config_blueprint.h"'
+
+    The built-in objects are then read-only, apart from the global object.
+*/
+#ifndef BLUEPRINT_DUKTAPE_ROM_BUILTINS
+ #define BLUEPRINT_DUKTAPE_ROM_BUILTINS 0
+#endif
+
+/** Config: BLUEPRINT_SCRIPT_WATCHDOG
+    Builds Duktape with its interrupt counter and execution timeout check,
+    through which each root's ScriptWatchdog puts a time budget on every call
+    into JavaScript. Disable it to save the interpreter the counting.
+*/
+#ifndef BLUEPRINT_SCRIPT_WATCHDOG
+ #define BLUEPRINT_SCRIPT_WATCHDOG 1
+#endif
+
+/** Config: BLUEPRINT_TRACING
+    Records a timeline of bridge calls, event dispatches, layout and painting
+    through the TraceRecorder, for export to chrome://tracing or Perfetto.
+    When disabled, the recorder and its trace points compile out entirely.
+*/
+#ifndef BLUEPRINT_TRACING
+ #define BLUEPRINT_TRACING 0
+#endif
+
+/** Config: BLUEPRINT_CONSOLE_LOGGING
+    Writes JavaScript's console output out through the ConsoleLogger, on a
+    background thread. When disabled, the console methods do nothing, so a
+    shipping build pays nothing for stray logs.
+*/
+#ifndef BLUEPRINT_CONSOLE_LOGGING
+ #define BLUEPRINT_CONSOLE_LOGGING 1
+#endif
+
+/** Config: BLUEPRINT_FLATTEN_LAYOUT_VIEWS
+    Leaves plain Views which only ever receive flex layout properties out of
+    the component hierarchy, mounting their children on the nearest real
+    ancestor instead. Such views paint nothing and handle no events, so this
+    only saves components.
+*/
+#ifndef BLUEPRINT_FLATTEN_LAYOUT_VIEWS
+ #define BLUEPRINT_FLATTEN_LAYOUT_VIEWS 1
+#endif
+
+
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+// Property bindings can read parameters directly where the project has them.
+#if JUCE_MODULE_AVAILABLE_juce_audio_processors
+ #include <juce_audio_processors/juce_audio_processors.h>
+#endif
+
+// Sample buffers take audio buffers, and scopes decimate with the vectorised
+// float operations, where the project has the module.
+#if JUCE_MODULE_AVAILABLE_juce_audio_basics
+ #include <juce_audio_basics/juce_audio_basics.h>
+#endif
+
+// Waveform views read audio files, so they're only available with the module.
+#if JUCE_MODULE_AVAILABLE_juce_audio_formats
+ #include <juce_audio_formats/juce_audio_formats.h>
+#endif
+
+// Spectrum views need the FFT, so they're only available with the module.
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+ #include <juce_dsp/juce_dsp.h>
+#endif
+
+// Roots can render through OpenGL where the project has the module; it's left
+// out of our dependencies so that projects without OpenGL needn't link it.
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+ #include <juce_opengl/juce_opengl.h>
+#endif
+
 #include "yoga/yoga/YGMacros.h"
 
 // This is a hacky workaround for an issue introduced in the YG_ENUM_BEGIN
@@ -52,16 +145,91 @@
 #include "yoga/yoga/Yoga-internal.h"
 #include "yoga/yoga/Yoga.h"
 
-#include "duktape/src-noline/duktape.h"
+#if BLUEPRINT_DUKTAPE_ROM_BUILTINS
+ #include "duktape/src-rom/duktape.h"
+#else
+ #include "duktape/src-noline/duktape.h"
+#endif
+#include "duktape/extras/cbor/duk_cbor.h"
 #include "duktape/extras/console/duk_console.h"
+#include "duktape/extras/module-node/duk_module_node.h"
 
+#include "core/blueprint_AnimatedValue.h"
+#include "core/blueprint_AssetPreloader.h"
+#include "core/blueprint_AssetStore.h"
+#include "core/blueprint_BridgeRecording.h"
+#include "core/blueprint_BytecodeBundle.h"
+#include "core/blueprint_CacheManager.h"
+#include "core/blueprint_CanvasView.h"
+#include "core/blueprint_CborPayload.h"
+#include "core/blueprint_CoalescedEventChannel.h"
+#include "core/blueprint_ConsoleLogger.h"
+#include "core/blueprint_DrawableCache.h"
+#include "core/blueprint_DukStringCache.h"
+#include "core/blueprint_DuktapeAllocator.h"
+#include "core/blueprint_EditableDrawable.h"
+#include "core/blueprint_FilmstripView.h"
+#include "core/blueprint_FontCache.h"
+#include "core/blueprint_FrameScheduler.h"
+#include "core/blueprint_GlyphRunCache.h"
+#include "core/blueprint_HeapCensus.h"
+#include "core/blueprint_HeapMeter.h"
+#include "core/blueprint_IconAtlas.h"
+#include "core/blueprint_Identifiers.h"
+#include "core/blueprint_IdleCollector.h"
 #include "core/blueprint_ImageView.h"
+#include "core/blueprint_KeyboardView.h"
+#include "core/blueprint_LayoutAnimator.h"
+#include "core/blueprint_LayoutSnapshot.h"
+#include "core/blueprint_ListModel.h"
+#include "core/blueprint_MeasuredShadowView.h"
+#include "core/blueprint_MeterBallistics.h"
+#include "core/blueprint_MeterView.h"
+#include "core/blueprint_MipmapCache.h"
+#include "core/blueprint_NativeCollections.h"
+#include "core/blueprint_NativeFunction.h"
+#include "core/blueprint_NoteGridModel.h"
+#include "core/blueprint_NoteGridView.h"
+#include "core/blueprint_ObjectCensus.h"
+#include "core/blueprint_PaintProfiler.h"
+#include "core/blueprint_ParameterStore.h"
+#include "core/blueprint_ParameterTarget.h"
+#include "core/blueprint_ParkedRoot.h"
+#include "core/blueprint_PerformanceOverlay.h"
+#include "core/blueprint_PerformanceStats.h"
+#include "core/blueprint_PropertyBinding.h"
+#include "core/blueprint_RasterCache.h"
 #include "core/blueprint_RawTextView.h"
+#include "core/blueprint_RealtimeEventQueue.h"
 #include "core/blueprint_ReactApplicationRoot.h"
+#include "core/blueprint_SampleRingBuffer.h"
+#include "core/blueprint_ScopeView.h"
+#include "core/blueprint_ScriptProfiler.h"
+#include "core/blueprint_ScriptThread.h"
+#include "core/blueprint_ScriptWatchdog.h"
+#include "core/blueprint_ScriptWorker.h"
 #include "core/blueprint_ScrollView.h"
 #include "core/blueprint_ScrollViewContentShadowView.h"
+#include "core/blueprint_ShaderView.h"
 #include "core/blueprint_ShadowView.h"
+#include "core/blueprint_SlabAllocator.h"
+#include "core/blueprint_SliderView.h"
+#include "core/blueprint_SpectrumAnalyser.h"
+#include "core/blueprint_SpectrumView.h"
+#include "core/blueprint_TextInputView.h"
 #include "core/blueprint_TextShadowView.h"
+#include "core/blueprint_TextSpanView.h"
 #include "core/blueprint_TextView.h"
 #include "core/blueprint_ThrottleMap.h"
+#include "core/blueprint_TiledRasterizer.h"
+#include "core/blueprint_TraceRecorder.h"
+#include "core/blueprint_TimerQueue.h"
+#include "core/blueprint_ValueChannel.h"
+#include "core/blueprint_ValueTreeStore.h"
 #include "core/blueprint_View.h"
+#include "core/blueprint_ViewPropertyTable.h"
+#include "core/blueprint_ViewStyle.h"
+#include "core/blueprint_ViewTable.h"
+#include "core/blueprint_VirtualListView.h"
+#include "core/blueprint_WaveformThumbnailCache.h"
+#include "core/blueprint_WaveformView.h"
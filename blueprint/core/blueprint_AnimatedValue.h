@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    blueprint_AnimatedValue.h
+    Created: 15 Oct 2026 1:22:09am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** An AnimatedValue moves a single number along one of three curves, as time
+        is fed to it from the frame scheduler.
+
+        - Timing runs from `from` to `to` over a fixed duration with an easing.
+        - Spring runs from `from` towards `to` as a damped spring, starting with
+          the given velocity, and settles when both its speed and its distance
+          from `to` are negligible.
+        - Decay starts at `from` with the given velocity and slows down by the
+          deceleration factor each millisecond, ignoring `to`, and settles once
+          its speed falls below the rest velocity.
+
+        Velocities are in units per millisecond.
+     */
+    class AnimatedValue
+    {
+    public:
+        //==============================================================================
+        enum class Curve
+        {
+            Timing,
+            Spring,
+            Decay,
+        };
+
+        enum class Easing
+        {
+            Linear,
+            EaseIn,
+            EaseOut,
+            EaseInOut,
+        };
+
+        struct Config
+        {
+            Curve curve = Curve::Timing;
+
+            // Timing
+            double durationMs = 300.0;
+            Easing easing = Easing::EaseInOut;
+
+            // Spring
+            double stiffness = 100.0;
+            double damping = 10.0;
+            double mass = 1.0;
+
+            // Spring and decay
+            double velocity = 0.0;
+            double deceleration = 0.998;
+
+            // Decay: the speed below which it comes to rest, or 0 to pick one
+            // from its travel, so that it stops at the same point at any scale.
+            double restVelocity = 0.0;
+        };
+
+        //==============================================================================
+        AnimatedValue (double _from, double _to, const Config& _config)
+            : from(_from), to(_to), config(_config), value(_from), velocity(_config.velocity)
+        {
+        }
+
+        //==============================================================================
+        /** Parses an animation config from the object JavaScript hands us, e.g.
+            `{type: 'spring', stiffness: 180, damping: 12}`.
+         */
+        static Config parseConfig (const juce::var& v)
+        {
+            Config c;
+            const auto type = v.getProperty("type", "timing").toString();
+
+            if (type == "spring")
+                c.curve = Curve::Spring;
+            else if (type == "decay")
+                c.curve = Curve::Decay;
+
+            const auto easing = v.getProperty("easing", "easeInOut").toString();
+
+            if (easing == "linear")
+                c.easing = Easing::Linear;
+            else if (easing == "easeIn")
+                c.easing = Easing::EaseIn;
+            else if (easing == "easeOut")
+                c.easing = Easing::EaseOut;
+
+            c.durationMs = juce::jmax(0.0, (double) v.getProperty("duration", c.durationMs));
+            c.stiffness = v.getProperty("stiffness", c.stiffness);
+            c.damping = v.getProperty("damping", c.damping);
+            c.mass = juce::jmax(1.0e-6, (double) v.getProperty("mass", c.mass));
+            c.velocity = v.getProperty("velocity", c.velocity);
+            c.deceleration = juce::jlimit(0.0, 0.999999, (double) v.getProperty("deceleration", c.deceleration));
+            c.restVelocity = juce::jmax(0.0, (double) v.getProperty("restVelocity", c.restVelocity));
+
+            return c;
+        }
+
+        //==============================================================================
+        /** Advances the value to the given time since the animation started, and
+            returns the new value.
+         */
+        double advance (double elapsedMs)
+        {
+            switch (config.curve)
+            {
+                case Curve::Timing: advanceTiming(elapsedMs); break;
+                case Curve::Spring: advanceSpring(elapsedMs); break;
+                case Curve::Decay:  advanceDecay(elapsedMs);  break;
+            }
+
+            return value;
+        }
+
+        /** Returns the current value. */
+        double getValue() const { return value; }
+
+        /** Returns true once the value has come to rest. */
+        bool isFinished() const { return finished; }
+
+    private:
+        //==============================================================================
+        static double ease (Easing easing, double t)
+        {
+            switch (easing)
+            {
+                case Easing::Linear:    return t;
+                case Easing::EaseIn:    return t * t * t;
+                case Easing::EaseOut:   return 1.0 - std::pow(1.0 - t, 3.0);
+                case Easing::EaseInOut: return t < 0.5 ? 4.0 * t * t * t : 1.0 - std::pow(-2.0 * t + 2.0, 3.0) / 2.0;
+            }
+
+            return t;
+        }
+
+        void advanceTiming (double elapsedMs)
+        {
+            const double t = config.durationMs > 0.0 ? juce::jlimit(0.0, 1.0, elapsedMs / config.durationMs) : 1.0;
+
+            value = from + (to - from) * ease(config.easing, t);
+            finished = (t >= 1.0);
+        }
+
+        void advanceSpring (double elapsedMs)
+        {
+            // We integrate in fixed steps of a millisecond, so that the motion
+            // doesn't depend on the frame rate. Stiffness and damping are per
+            // second, as is usual, and velocity per millisecond.
+            const double dt = 0.001;
+            double v = velocity * 1000.0;
+
+            for (; integratedMs + 1.0 <= elapsedMs; integratedMs += 1.0)
+            {
+                const double a = (-config.stiffness * (value - to) - config.damping * v) / config.mass;
+                v += a * dt;
+                value += v * dt;
+            }
+
+            velocity = v / 1000.0;
+
+            const double restThreshold = 0.001 * juce::jmax(1.0, std::abs(to - from));
+
+            if (std::abs(velocity) < restThreshold && std::abs(value - to) < restThreshold)
+            {
+                value = to;
+                velocity = 0.0;
+                finished = true;
+            }
+        }
+
+        void advanceDecay (double elapsedMs)
+        {
+            const double k = 1.0 - config.deceleration;
+            const double decay = std::exp(-k * elapsedMs);
+
+            // The speed falls as e^(-kt), and what's left of the travel is the
+            // speed over k. With the default rest velocity, we stop once that's
+            // under a thousandth of the whole travel, or of 1 for a short one.
+            const double restVelocity = config.restVelocity > 0.0
+                                            ? config.restVelocity
+                                            : 0.001 * juce::jmax(k, std::abs(config.velocity));
+
+            value = from + (config.velocity / k) * (1.0 - decay);
+            velocity = config.velocity * decay;
+            finished = std::abs(velocity) < restVelocity;
+        }
+
+        //==============================================================================
+        double from;
+        double to;
+        Config config;
+
+        double value;
+        double velocity;
+        double integratedMs = 0.0;
+        bool finished = false;
+    };
+
+}
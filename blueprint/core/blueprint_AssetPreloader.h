@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    blueprint_AssetPreloader.h
+    Created: 15 Oct 2026 11:09:27pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "blueprint_DrawableCache.h"
+#include "blueprint_FontCache.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The AssetPreloader decodes the images and resolves the typefaces a bundle
+        is going to use, in parallel on a thread pool, while its root is still
+        reading and compiling the bundle, so that they're ready by the first
+        commit rather than decoded one at a time as its views mount.
+
+        What to preload comes from a manifest, which a bundle ships alongside
+        itself as JSON: `main.js` with `main.assets.json`, say.
+
+            {
+                "images": ["binary:knob_svg", "file:///path/to/background.png"],
+                "fonts": [{ "family": "Inter", "style": 1, "sizes": [12, 14] }, "Inter"]
+            }
+
+        Images are given as ImageView sources, exactly as the views give them,
+        since they're decoded into the DrawableCache under the source. Fonts are
+        a family, with the juce::Font style flags of the `font-style` property;
+        a typeface serves every size of its family and style. Any sizes given
+        have their glyphs warmed too, with FontCache::warmGlyphs.
+
+        Hold the preloader through a juce::SharedResourcePointer<AssetPreloader>.
+        Its pool is shared by every root in the process.
+     */
+    class AssetPreloader
+    {
+    public:
+        //==============================================================================
+        /** What a bundle asks to have preloaded. */
+        struct Manifest
+        {
+            struct Font
+            {
+                juce::String family;
+                int style = 0;
+                std::vector<float> sizes;
+            };
+
+            juce::StringArray images;
+            std::vector<Font> fonts;
+
+            bool isEmpty() const { return images.isEmpty() && fonts.empty(); }
+
+            /** Reads a manifest from its parsed JSON, skipping any entry it
+                doesn't understand.
+             */
+            static Manifest fromVar (const juce::var& json)
+            {
+                Manifest manifest;
+
+                if (auto* images = json["images"].getArray())
+                    for (const auto& image : *images)
+                        if (image.isString() && image.toString().isNotEmpty())
+                            manifest.images.addIfNotAlreadyThere(image.toString());
+
+                if (auto* fonts = json["fonts"].getArray())
+                {
+                    for (const auto& font : *fonts)
+                    {
+                        Font f;
+                        f.family = font.isString() ? font.toString() : font["family"].toString();
+                        f.style = font.isObject() ? (int) font["style"] : 0;
+
+                        if (auto* sizes = font["sizes"].getArray())
+                            for (const auto& size : *sizes)
+                                if ((float) size > 0.0f)
+                                    f.sizes.push_back((float) size);
+
+                        if (f.family.isNotEmpty())
+                            manifest.fonts.push_back(f);
+                    }
+                }
+
+                return manifest;
+            }
+
+            /** Reads a manifest file, returning an empty manifest if there's no
+                such file or it isn't JSON.
+             */
+            static Manifest fromFile (const juce::File& file)
+            {
+                if (!file.existsAsFile())
+                    return {};
+
+                juce::var json;
+                const auto result = juce::JSON::parse(file.loadFileAsString(), json);
+
+                if (result.failed())
+                {
+                    DBG("Failed to read asset manifest: " << result.getErrorMessage());
+                    return {};
+                }
+
+                return fromVar(json);
+            }
+        };
+
+        /** Returns the manifest file that goes with the given bundle. */
+        static juce::File getManifestFileFor (const juce::File& bundle)
+        {
+            return bundle.getSiblingFile(bundle.getFileNameWithoutExtension() + ".assets.json");
+        }
+
+        //==============================================================================
+        /** What one root asked for. A batch holds each asset as it comes in, so
+            that the caches evict none of them before the views come to use them,
+            until the batch itself is released.
+         */
+        class Batch
+        {
+        public:
+            Batch() = default;
+
+            /** Returns the number of assets still being loaded. */
+            int getNumPending() const { return numPending.load(); }
+
+            /** Returns true once every asset has been loaded, or failed to. */
+            bool isComplete() const { return numPending.load() == 0; }
+
+        private:
+            friend class AssetPreloader;
+
+            void add (DrawableCache::DrawableHandle drawable)
+            {
+                if (drawable != nullptr)
+                {
+                    const juce::ScopedLock sl (lock);
+                    drawables.push_back(std::move(drawable));
+                }
+
+                --numPending;
+            }
+
+            void add (juce::Typeface::Ptr typeface)
+            {
+                if (typeface != nullptr)
+                {
+                    const juce::ScopedLock sl (lock);
+                    typefaces.push_back(std::move(typeface));
+                }
+
+                --numPending;
+            }
+
+            juce::CriticalSection lock;
+            std::vector<DrawableCache::DrawableHandle> drawables;
+            std::vector<juce::Typeface::Ptr> typefaces;
+            std::atomic<int> numPending { 0 };
+
+            JUCE_DECLARE_NON_COPYABLE (Batch)
+        };
+
+        using BatchHandle = std::shared_ptr<Batch>;
+
+        //==============================================================================
+        AssetPreloader() = default;
+
+        ~AssetPreloader()
+        {
+            // The jobs load into the caches, so they stop first.
+            pool.removeAllJobs(true, -1);
+        }
+
+        /** Starts loading everything in the manifest, returning the batch which
+            holds it. Images already decoded are taken from the cache at once.
+         */
+        BatchHandle preload (const Manifest& manifest)
+        {
+            auto batch = std::make_shared<Batch>();
+            batch->numPending = manifest.images.size() + static_cast<int>(manifest.fonts.size());
+
+            for (const auto& source : manifest.images)
+            {
+                if (auto drawable = drawableCache->getCachedDrawable(source))
+                {
+                    batch->add(std::move(drawable));
+                    continue;
+                }
+
+                pool.addJob([this, batch, source]() {
+                    batch->add(drawableCache->getDrawable(source));
+                });
+            }
+
+            for (const auto& font : manifest.fonts)
+            {
+                pool.addJob([this, batch, font]() {
+                    fontCache->warmGlyphs(font.family, font.style, font.sizes);
+                    batch->add(fontCache->getFont(font.family, 12.0f, font.style, 0.0f)->getTypefacePtr());
+                });
+            }
+
+            return batch;
+        }
+
+    private:
+        //==============================================================================
+        juce::SharedResourcePointer<DrawableCache> drawableCache;
+        juce::SharedResourcePointer<FontCache> fontCache;
+
+        // Decoding is all CPU, so the pool leaves a core for the message thread.
+        juce::ThreadPool pool { juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AssetPreloader)
+    };
+
+}
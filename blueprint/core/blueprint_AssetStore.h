@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    blueprint_AssetStore.h
+    Created: 15 Oct 2026 7:18:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The AssetStore is a process-wide store of immutable data shared between
+        roots, such as the bytecode compiled from a bundle.
+
+        A session with many instances of a plugin opens the same bundle in every
+        editor. Rather than each root reading or compiling its own copy, the first
+        to need an asset makes it and the rest share it, keyed by a hash of the
+        content it was made from. An asset lives for as long as anything holds it,
+        and is released along with the last holder; the store itself keeps no
+        reference.
+
+        Drawables and typefaces have stores of their own, the DrawableCache and
+        the FontCache, and bundle sources are mapped from file, so their pages are
+        already shared by the OS.
+
+        Hold the store through a juce::SharedResourcePointer<AssetStore>; it's
+        safe to use from any thread.
+     */
+    class AssetStore
+    {
+    public:
+        //==============================================================================
+        using Asset = std::shared_ptr<const juce::MemoryBlock>;
+
+        /** Makes an asset's data, returning false and setting the error if it
+            can't.
+         */
+        using Factory = std::function<bool (juce::MemoryBlock& data, juce::String& error)>;
+
+        AssetStore() = default;
+
+        //==============================================================================
+        /** Returns the asset with the given key if something still holds it, or
+            otherwise makes it with the factory and stores it. Returns nullptr if
+            the factory fails.
+
+            The factory runs without the store locked, so two threads after the
+            same new asset may both make it; the first stored is the one shared.
+         */
+        Asset getOrCreate (juce::int64 key, const Factory& factory, juce::String& error)
+        {
+            if (auto asset = find(key))
+                return asset;
+
+            auto data = std::make_shared<juce::MemoryBlock>();
+
+            if (!factory(*data, error))
+                return nullptr;
+
+            const juce::ScopedLock sl (lock);
+            auto& entry = assets[key];
+
+            if (auto existing = entry.lock())
+                return existing;
+
+            Asset asset (std::move(data));
+            entry = asset;
+
+            return asset;
+        }
+
+        /** Returns the asset with the given key if something still holds it, or
+            nullptr.
+         */
+        Asset find (juce::int64 key)
+        {
+            const juce::ScopedLock sl (lock);
+            auto it = assets.find(key);
+
+            if (it == assets.end())
+                return nullptr;
+
+            if (auto asset = it->second.lock())
+                return asset;
+
+            assets.erase(it);
+            return nullptr;
+        }
+
+        /** Returns the number of assets held, and the bytes they take. */
+        size_t getNumAssets (size_t* totalBytes = nullptr)
+        {
+            const juce::ScopedLock sl (lock);
+            size_t numAssets = 0;
+            size_t bytes = 0;
+
+            for (auto it = assets.begin(); it != assets.end();)
+            {
+                if (auto asset = it->second.lock())
+                {
+                    ++numAssets;
+                    bytes += asset->getSize();
+                    ++it;
+                }
+                else
+                {
+                    it = assets.erase(it);
+                }
+            }
+
+            if (totalBytes != nullptr)
+                *totalBytes = bytes;
+
+            return numAssets;
+        }
+
+    private:
+        //==============================================================================
+        juce::CriticalSection lock;
+        std::unordered_map<juce::int64, std::weak_ptr<const juce::MemoryBlock>> assets;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AssetStore)
+    };
+
+}
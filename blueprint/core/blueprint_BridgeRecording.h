@@ -0,0 +1,337 @@
+/*
+  ==============================================================================
+
+    blueprint_BridgeRecording.h
+    Created: 15 Oct 2026 9:02:44pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "blueprint_Identifiers.h"
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A recording of a root's bridge traffic, for reproducing a slowdown seen in
+        the field: the tree operations JavaScript asked for, the commits they
+        came in, the events the root dispatched, and the calls to native methods,
+        each stamped with the root's clock time.
+
+        A BridgeRecorder writes the traffic to a stream as it goes, in a compact
+        binary form: a byte for the kind of each record, its time as a
+        variable-length count of microseconds since the last, view ids and
+        indices as variable-length ints, and names, such as property names and
+        event types, written once and then referred to by index. Values go as
+        juce::var streams.
+
+        A BridgeRecording reads the records back, for a root to replay with
+        `replayBridgeRecording`. See ReactApplicationRoot.
+     */
+    struct BridgeRecording
+    {
+        //==============================================================================
+        /** The kinds of record. */
+        enum RecordType : juce::uint8
+        {
+            DefineName,
+            CreateView,
+            CreateTextView,
+            SetProperty,
+            SetProperties,
+            SetText,
+            AddChild,
+            RemoveChild,
+            MoveChild,
+            BeginCommit,
+            EndCommit,
+            Event,
+            ViewEvent,
+            NativeMethod,
+            numRecordTypes
+        };
+
+        /** What to replay of a recording. */
+        enum class ReplayMode
+        {
+            /** The tree operations and native method calls, into a root with no
+                bundle, for profiling layout and paint alone.
+             */
+            TreeOperations,
+
+            /** The events, into a root running the bundle the recording was made
+                with, which then asks for the tree operations afresh.
+             */
+            Events
+        };
+
+        /** One record. Fields a kind of record doesn't have are left as they are. */
+        struct Record
+        {
+            RecordType type = DefineName;
+            double timeMs = 0.0;
+
+            ViewId viewId = 0;
+            ViewId childId = 0;
+            int index = -1;
+
+            juce::Identifier name;
+            juce::var value;
+            std::vector<ViewId> path;
+            juce::Array<juce::var> args;
+        };
+
+        //==============================================================================
+        /** Reads a recording from the given stream, returning false, with what
+            could be read, if it's not one or it's cut short.
+         */
+        bool read (juce::InputStream& in)
+        {
+            records.clear();
+
+            if (in.readInt() != magic || in.readInt() != version)
+                return false;
+
+            std::vector<juce::Identifier> names;
+            double time = 0.0;
+
+            while (!in.isExhausted())
+            {
+                Record r;
+                const auto type = static_cast<RecordType>(in.readByte());
+
+                if (type >= numRecordTypes)
+                    return false;
+
+                r.type = type;
+                time += in.readCompressedInt() / 1000.0;
+                r.timeMs = time;
+
+                auto readName = [&]() {
+                    const int i = in.readCompressedInt();
+                    return juce::isPositiveAndBelow(i, (int) names.size()) ? names[(size_t) i] : juce::Identifier();
+                };
+
+                auto readArgs = [&]() {
+                    for (int n = in.readCompressedInt(); --n >= 0;)
+                        r.args.add(juce::var::readFromStream(in));
+                };
+
+                switch (type)
+                {
+                    case DefineName:
+                        names.push_back(in.readString());
+                        continue;
+
+                    case CreateView:
+                        r.viewId = in.readCompressedInt();
+                        r.name = readName();
+                        break;
+
+                    case CreateTextView:
+                    case SetText:
+                    case SetProperties:
+                        r.viewId = in.readCompressedInt();
+                        r.value = juce::var::readFromStream(in);
+                        break;
+
+                    case SetProperty:
+                        r.viewId = in.readCompressedInt();
+                        r.name = readName();
+                        r.value = juce::var::readFromStream(in);
+                        break;
+
+                    case AddChild:
+                    case MoveChild:
+                        r.viewId = in.readCompressedInt();
+                        r.childId = in.readCompressedInt();
+                        r.index = in.readCompressedInt();
+                        break;
+
+                    case RemoveChild:
+                        r.viewId = in.readCompressedInt();
+                        r.childId = in.readCompressedInt();
+                        break;
+
+                    case BeginCommit:
+                    case EndCommit:
+                        break;
+
+                    case ViewEvent:
+                        for (int n = in.readCompressedInt(); --n >= 0;)
+                            r.path.push_back(in.readCompressedInt());
+
+                        r.name = readName();
+                        readArgs();
+                        break;
+
+                    case Event:
+                    case NativeMethod:
+                        r.name = readName();
+                        readArgs();
+                        break;
+
+                    case numRecordTypes:
+                        return false;
+                }
+
+                records.push_back(std::move(r));
+            }
+
+            return true;
+        }
+
+        //==============================================================================
+        std::vector<Record> records;
+
+        static constexpr int magic = 0x43525042; // "BPRC"
+        static constexpr int version = 1;
+    };
+
+    //==============================================================================
+    /** Writes a root's bridge traffic to a stream as it happens. See
+        BridgeRecording. The root records on the message thread.
+     */
+    class BridgeRecorder
+    {
+    public:
+        //==============================================================================
+        /** Starts a recording into the given stream, at the given clock time. */
+        BridgeRecorder (std::unique_ptr<juce::OutputStream> _out, double startTimeMs)
+            : out(std::move(_out)), lastTimeMs(startTimeMs)
+        {
+            out->writeInt(BridgeRecording::magic);
+            out->writeInt(BridgeRecording::version);
+        }
+
+        ~BridgeRecorder()
+        {
+            out->flush();
+        }
+
+        //==============================================================================
+        void recordCreateView (double timeMs, ViewId viewId, const juce::Identifier& viewType)
+        {
+            const int name = getNameIndex(viewType);
+            begin(BridgeRecording::CreateView, timeMs);
+            out->writeCompressedInt(viewId);
+            out->writeCompressedInt(name);
+        }
+
+        /** Records the creation of a text view, the setting of a raw text value,
+            or of a batch of properties, as an object.
+         */
+        void recordValue (BridgeRecording::RecordType type, double timeMs, ViewId viewId, const juce::var& value)
+        {
+            begin(type, timeMs);
+            out->writeCompressedInt(viewId);
+            value.writeToStream(*out);
+        }
+
+        void recordSetProperty (double timeMs, ViewId viewId, const juce::Identifier& propertyName, const juce::var& value)
+        {
+            const int name = getNameIndex(propertyName);
+            begin(BridgeRecording::SetProperty, timeMs);
+            out->writeCompressedInt(viewId);
+            out->writeCompressedInt(name);
+            value.writeToStream(*out);
+        }
+
+        /** Records a child added, removed or moved; the index is ignored for a
+            removal.
+         */
+        void recordChild (BridgeRecording::RecordType type, double timeMs, ViewId parentId, ViewId childId, int index = -1)
+        {
+            begin(type, timeMs);
+            out->writeCompressedInt(parentId);
+            out->writeCompressedInt(childId);
+
+            if (type != BridgeRecording::RemoveChild)
+                out->writeCompressedInt(index);
+        }
+
+        void recordCommit (bool isBeginning, double timeMs)
+        {
+            begin(isBeginning ? BridgeRecording::BeginCommit : BridgeRecording::EndCommit, timeMs);
+        }
+
+        /** Records an event, or a native method call, by name. */
+        void recordCall (BridgeRecording::RecordType type, double timeMs, const juce::Identifier& callName,
+                         const juce::var* args, int numArgs)
+        {
+            const int name = getNameIndex(callName);
+            begin(type, timeMs);
+            out->writeCompressedInt(name);
+            writeArgs(args, numArgs);
+        }
+
+        void recordViewEvent (double timeMs, const ViewId* path, size_t pathLength, const juce::Identifier& eventType,
+                              const juce::var* args, int numArgs)
+        {
+            const int name = getNameIndex(eventType);
+            begin(BridgeRecording::ViewEvent, timeMs);
+            out->writeCompressedInt(static_cast<int>(pathLength));
+
+            for (size_t i = 0; i < pathLength; ++i)
+                out->writeCompressedInt(path[i]);
+
+            out->writeCompressedInt(name);
+            writeArgs(args, numArgs);
+        }
+
+    private:
+        //==============================================================================
+        void begin (BridgeRecording::RecordType type, double timeMs)
+        {
+            // A gap too long for an int just waits less on replay.
+            const double micros = juce::jmax(0.0, timeMs - lastTimeMs) * 1000.0;
+            lastTimeMs = juce::jmax(lastTimeMs, timeMs);
+
+            out->writeByte(static_cast<char>(type));
+            out->writeCompressedInt((int) juce::jmin(micros, (double) std::numeric_limits<int>::max()));
+        }
+
+        /** Returns the index of the given name, writing it out on its first use. */
+        int getNameIndex (const juce::Identifier& name)
+        {
+            auto it = nameIndices.find(name);
+
+            if (it != nameIndices.end())
+                return it->second;
+
+            const int index = static_cast<int>(nameIndices.size());
+            nameIndices[name] = index;
+
+            begin(BridgeRecording::DefineName, lastTimeMs);
+            out->writeString(name.toString());
+
+            return index;
+        }
+
+        void writeArgs (const juce::var* args, int numArgs)
+        {
+            out->writeCompressedInt(numArgs);
+
+            for (int i = 0; i < numArgs; ++i)
+                args[i].writeToStream(*out);
+        }
+
+        //==============================================================================
+        std::unique_ptr<juce::OutputStream> out;
+        double lastTimeMs;
+        std::unordered_map<juce::Identifier, int, IdentifierHash> nameIndices;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BridgeRecorder)
+    };
+
+}
@@ -0,0 +1,296 @@
+/*
+  ==============================================================================
+
+    blueprint_BytecodeBundle.h
+    Created: 15 Oct 2026 2:41:52am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#if ! JUCE_WINDOWS
+ #include <sys/stat.h>
+ #include <unistd.h>
+#endif
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Precompiled JavaScript bundles.
+
+        Compiling a multi-megabyte React bundle is most of the time it takes to
+        open an editor, so a bundle can be compiled once and its Duktape bytecode
+        kept, either in a cache directory or embedded in the binary, and then
+        loaded without lexing or compiling anything.
+
+        Duktape's bytecode carries no version information of its own, and loading
+        bytecode from a different Duktape version or configuration is undefined
+        behaviour. So we wrap it in a small header recording a fingerprint of the
+        Duktape build and a hash of the source it came from, and refuse anything
+        whose fingerprint doesn't match ours.
+
+        Duktape trusts the bytecode it loads, and a crafted file can run code
+        in the host, so a cache directory must be one only the current user
+        can write to. Use `getDefaultCacheDirectory`, under the user's
+        application data. On POSIX systems the cache directory is made private
+        to the user, and a cached bundle is used only if it and its directory
+        belong to the user and no one else can write to them. Otherwise the
+        source is compiled again.
+     */
+    struct BytecodeBundle
+    {
+        //==============================================================================
+        /** The version of the header format, bumped whenever it changes. */
+        static constexpr int formatVersion = 1;
+
+        /** Returns a fingerprint of the Duktape version and configuration compiled
+            into this binary, which bytecode has to match to be loaded.
+         */
+        static juce::int64 getDuktapeFingerprint()
+        {
+            juce::String config;
+
+            config << DUK_GIT_DESCRIBE << ":" << DUK_GIT_COMMIT << ":" << (int) DUK_VERSION
+                   << ":ptr" << (int) sizeof(void*)
+#if defined(DUK_USE_BYTEORDER)
+                   << ":order" << (int) DUK_USE_BYTEORDER
+#endif
+#if defined(DUK_USE_PACKED_TVAL)
+                   << ":packed"
+#endif
+#if defined(DUK_USE_FASTINT)
+                   << ":fastint"
+#endif
+#if defined(DUK_USE_ROM_OBJECTS)
+                   << ":rom"
+#endif
+                   << ":format" << formatVersion;
+
+            return config.hashCode64();
+        }
+
+        /** Returns a hash identifying a bundle's source. */
+        static juce::int64 hashSource (const char* utf8, size_t numBytes)
+        {
+            // 64-bit FNV-1a, straight over the bytes
+            juce::uint64 hash = 14695981039346656037ull;
+
+            for (size_t i = 0; i < numBytes; ++i)
+            {
+                hash ^= static_cast<juce::uint8>(utf8[i]);
+                hash *= 1099511628211ull;
+            }
+
+            // The length is mixed in so that two bundles of different sizes never
+            // share a cache entry, however unlucky the hash.
+            return static_cast<juce::int64>(hash ^ static_cast<juce::uint64>(numBytes));
+        }
+
+        //==============================================================================
+        /** Compiles JavaScript source into a bytecode bundle, returning false with a
+            description of the problem if the source doesn't compile.
+
+            The context's stack is left as it was.
+         */
+        static bool compile (duk_context* ctx, const char* utf8, size_t numBytes, const juce::String& fileName,
+                             juce::MemoryBlock& bundle, juce::String& error)
+        {
+            duk_push_string(ctx, fileName.toRawUTF8());
+
+            if (duk_pcompile_lstring_filename(ctx, 0, utf8, numBytes) != 0)
+            {
+                error = duk_safe_to_string(ctx, -1);
+                duk_pop(ctx);
+                return false;
+            }
+
+            duk_dump_function(ctx);
+
+            duk_size_t size = 0;
+            const void* data = duk_get_buffer(ctx, -1, &size);
+
+            bundle.reset();
+            juce::MemoryOutputStream out (bundle, false);
+            out.write("BPBC", 4);
+            out.writeInt(formatVersion);
+            out.writeInt64(getDuktapeFingerprint());
+            out.writeInt64(hashSource(utf8, numBytes));
+            out.writeInt((int) size);
+            out.write(data, size);
+            out.flush();
+
+            duk_pop(ctx);
+            return true;
+        }
+
+        /** Checks that the data is a bytecode bundle this build can load, and if so
+            points at the bytecode within it.
+         */
+        static bool getBytecode (const void* data, size_t size, const void*& bytecode, size_t& bytecodeSize,
+                                 juce::String& error)
+        {
+            if (data == nullptr || size < headerSize || std::memcmp(data, "BPBC", 4) != 0)
+            {
+                error = "not a bytecode bundle";
+                return false;
+            }
+
+            juce::MemoryInputStream in (data, size, false);
+            in.skipNextBytes(4);
+
+            const int version = in.readInt();
+            const juce::int64 fingerprint = in.readInt64();
+            in.readInt64();
+            const int payloadSize = in.readInt();
+
+            if (version != formatVersion || fingerprint != getDuktapeFingerprint())
+            {
+                error = "the bundle was compiled by a different Duktape build";
+                return false;
+            }
+
+            if (payloadSize <= 0 || (size_t) payloadSize != size - headerSize)
+            {
+                error = "the bundle is truncated";
+                return false;
+            }
+
+            bytecode = static_cast<const char*>(data) + headerSize;
+            bytecodeSize = (size_t) payloadSize;
+            return true;
+        }
+
+        /** Returns the hash of the source a bundle was compiled from, or 0 if the
+            data isn't a bundle.
+         */
+        static juce::int64 getSourceHash (const void* data, size_t size)
+        {
+            if (data == nullptr || size < headerSize || std::memcmp(data, "BPBC", 4) != 0)
+                return 0;
+
+            juce::MemoryInputStream in (data, size, false);
+            in.skipNextBytes(4 + 4 + 8);
+            return in.readInt64();
+        }
+
+        /** Fetches the bundle for the given source from the cache directory, or
+            failing that compiles the source in a Duktape heap of its own and
+            caches the result. With no cache directory, always compiles.
+
+            Touches no shared state, so is safe to call from any thread.
+         */
+        static bool compileWithCache (const char* utf8, size_t numBytes, const juce::String& fileName,
+                                      const juce::File& cacheDirectory, juce::MemoryBlock& bundle, juce::String& error)
+        {
+            const auto sourceHash = hashSource(utf8, numBytes);
+            const bool useCache = (cacheDirectory != juce::File()) && makePrivateDirectory(cacheDirectory);
+            const auto cacheFile = useCache ? getCacheFile(cacheDirectory, sourceHash) : juce::File();
+
+            if (useCache && isPrivateToUser(cacheFile) && cacheFile.loadFileAsData(bundle) && getSourceHash(bundle.getData(), bundle.getSize()) == sourceHash)
+            {
+                const void* bytecode = nullptr;
+                size_t bytecodeSize = 0;
+                juce::String cacheError;
+
+                if (getBytecode(bundle.getData(), bundle.getSize(), bytecode, bytecodeSize, cacheError))
+                    return true;
+            }
+
+            duk_context* ctx = duk_create_heap_default();
+            const bool compiled = compile(ctx, utf8, numBytes, fileName, bundle, error);
+            duk_destroy_heap(ctx);
+
+            if (!compiled)
+                return false;
+
+            // Failing to cache only costs us the compile next time.
+            if (useCache && cacheFile.replaceWithData(bundle.getData(), bundle.getSize()))
+                restrictToUser(cacheFile, false);
+            else if (useCache)
+                DBG("Failed to write bytecode cache: " << cacheFile.getFullPathName());
+
+            return true;
+        }
+
+        /** Returns a cache directory for the given application, under the
+            current user's application data, where no other user can plant a
+            bundle.
+         */
+        static juce::File getDefaultCacheDirectory (const juce::String& applicationName)
+        {
+            return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                       .getChildFile(applicationName)
+                       .getChildFile("BytecodeCache");
+        }
+
+        //==============================================================================
+        /** Reads a bundle from file into memory without copying it, returning true
+            if the file could be mapped. An empty file can't be.
+         */
+        static bool mapBundle (const juce::File& file, std::unique_ptr<juce::MemoryMappedFile>& mapped)
+        {
+            mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+            return mapped->getData() != nullptr && mapped->getSize() > 0;
+        }
+
+        /** The file in which the bytecode for the given source is cached. */
+        static juce::File getCacheFile (const juce::File& cacheDirectory, juce::int64 sourceHash)
+        {
+            return cacheDirectory.getChildFile(juce::String::toHexString(sourceHash)
+                                               + "-" + juce::String::toHexString(getDuktapeFingerprint())
+                                               + ".bpbc");
+        }
+
+    private:
+        //==============================================================================
+        static constexpr size_t headerSize = 4 + 4 + 8 + 8 + 4;
+
+        /** Creates the directory if need be and makes it private to the user,
+            returning false if it can't be trusted with bytecode.
+         */
+        static bool makePrivateDirectory (const juce::File& directory)
+        {
+            if (!directory.createDirectory())
+                return false;
+
+            restrictToUser(directory, true);
+            return isPrivateToUser(directory);
+        }
+
+        /** Takes away every permission of the group and other users. */
+        static void restrictToUser (const juce::File& file, bool isDirectory)
+        {
+           #if ! JUCE_WINDOWS
+            chmod(file.getFullPathName().toRawUTF8(), isDirectory ? 0700 : 0600);
+           #else
+            // A user's application data is private to them already.
+            juce::ignoreUnused(file, isDirectory);
+           #endif
+        }
+
+        /** Returns true if the file, or directory, isn't a link, belongs to the
+            current user, and no one else can write to it. A missing file is
+            trusted, as there's nothing in it to load.
+         */
+        static bool isPrivateToUser (const juce::File& file)
+        {
+           #if ! JUCE_WINDOWS
+            struct stat info;
+
+            if (lstat(file.getFullPathName().toRawUTF8(), &info) != 0)
+                return !file.exists();
+
+            return !S_ISLNK(info.st_mode)
+                && info.st_uid == geteuid()
+                && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+           #else
+            juce::ignoreUnused(file);
+            return true;
+           #endif
+        }
+    };
+
+}
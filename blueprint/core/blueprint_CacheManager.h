@@ -0,0 +1,277 @@
+/*
+  ==============================================================================
+
+    blueprint_CacheManager.h
+    Created: 15 Oct 2026 9:41:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The CacheManager bounds the memory of Blueprint's process-wide caches: the
+        DrawableCache, FontCache, GlyphRunCache, IconAtlas, MipmapCache and
+        WaveformThumbnailCache.
+
+        Every cache hands out shared entries, and never evicts one something still
+        holds. What it keeps that nothing holds is bounded by its byte budget,
+        least recently used first out, and it trims itself back to that budget
+        as it adds entries. The manager sets those budgets by cache name, trims
+        every cache back to its budget when an editor closes and releases its
+        views, and, when the host is short of memory, drops everything nothing
+        holds with `releaseUnused`. `getStats` reports each cache's size.
+
+        Each cache registers itself with a Registration for as long as it lives.
+        Hold the manager through a juce::SharedResourcePointer<CacheManager>; it's
+        safe to use from any thread.
+     */
+    class CacheManager
+    {
+    public:
+        //==============================================================================
+        /** The size of one cache. */
+        struct Stats
+        {
+            size_t numEntries = 0;
+            size_t numBytes = 0;
+
+            // Of numBytes, what nothing outside the cache holds.
+            size_t unusedBytes = 0;
+            size_t budgetBytes = 0;
+
+            /** Counts an entry with `numBytes` and `isUnused()`. */
+            template <typename Entry>
+            void add (const Entry& entry)
+            {
+                ++numEntries;
+                numBytes += entry.numBytes;
+
+                if (entry.isUnused())
+                    unusedBytes += entry.numBytes;
+            }
+        };
+
+        /** What a cache gives the manager. The manager calls these with its own
+            lock held, so a cache mustn't call the manager with its own.
+         */
+        class Cache
+        {
+        public:
+            virtual ~Cache() = default;
+
+            virtual Stats getCacheStats() = 0;
+
+            /** Sets how many bytes of entries nothing holds the cache may keep, and
+                trims it to that.
+             */
+            virtual void setCacheBudget (size_t numBytes) = 0;
+
+            /** Evicts entries nothing holds, least recently used first, until those
+                left add up to no more than the given number of bytes.
+             */
+            virtual void trimCache (size_t maxUnusedBytes) = 0;
+        };
+
+        /** Registers a cache with the manager under the given name for as long as
+            it lives. A cache declares one as its last member, so that it's gone
+            before anything the cache's methods use.
+         */
+        class Registration
+        {
+        public:
+            Registration (const juce::String& _name, Cache& _cache)
+                : name(_name), cache(_cache)
+            {
+                manager->add(name, cache);
+            }
+
+            ~Registration()
+            {
+                manager->remove(cache);
+            }
+
+        private:
+            juce::SharedResourcePointer<CacheManager> manager;
+            const juce::String name;
+            Cache& cache;
+
+            JUCE_DECLARE_NON_COPYABLE (Registration)
+        };
+
+        /** A cache's budget, and when to trim back to it: each time a quarter of
+            the budget more has been added since the last trim, so that the passes
+            over the cache a trim takes are spread over the entries added.
+         */
+        struct Budget
+        {
+            explicit Budget (size_t numBytes) : budgetBytes(numBytes) {}
+
+            /** Counts the bytes of a new entry, returning true if it's time to trim. */
+            bool added (size_t numBytes)
+            {
+                addedBytes += numBytes;
+                return addedBytes > budgetBytes / 4;
+            }
+
+            void trimmed() { addedBytes = 0; }
+
+            size_t budgetBytes;
+            size_t addedBytes = 0;
+        };
+
+        //==============================================================================
+        /** Gathers the entries of a cache which nothing holds, to evict the least
+            recently used of them. Entries need `numBytes`, `lastUse`, from a
+            counter the cache bumps on each lookup, and `isUnused()`. Erasing an
+            entry must leave the others' iterators valid, as it does in the
+            standard maps.
+         */
+        class LruEviction
+        {
+        public:
+            /** Adds the unused entries of a map. */
+            template <typename Map>
+            void add (Map& map)
+            {
+                for (auto it = map.begin(); it != map.end(); ++it)
+                {
+                    if (!it->second.isUnused())
+                        continue;
+
+                    unusedBytes += it->second.numBytes;
+                    candidates.push_back({ it->second.lastUse, it->second.numBytes, [&map, it]() { map.erase(it); } });
+                }
+            }
+
+            /** Evicts the least recently used of the entries added until those left
+                add up to no more than the given number of bytes.
+             */
+            void evictTo (size_t maxUnusedBytes)
+            {
+                if (unusedBytes <= maxUnusedBytes)
+                    return;
+
+                std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+                    return a.lastUse < b.lastUse;
+                });
+
+                for (auto& c : candidates)
+                {
+                    if (unusedBytes <= maxUnusedBytes)
+                        break;
+
+                    unusedBytes -= c.numBytes;
+                    c.erase();
+                }
+            }
+
+        private:
+            struct Candidate
+            {
+                juce::uint64 lastUse;
+                size_t numBytes;
+                std::function<void()> erase;
+            };
+
+            std::vector<Candidate> candidates;
+            size_t unusedBytes = 0;
+        };
+
+        //==============================================================================
+        CacheManager() = default;
+
+        //==============================================================================
+        /** Sets the budget of the named cache, now and whenever it's made:
+            "drawables", "fonts", "glyphs", "icons", "mipmaps" or "waveforms".
+         */
+        void setBudget (const juce::String& name, size_t numBytes)
+        {
+            const juce::ScopedLock sl (lock);
+            budgets[name] = numBytes;
+
+            for (auto& entry : caches)
+                if (entry.name == name)
+                    entry.cache->setCacheBudget(numBytes);
+        }
+
+        /** Trims every cache back to its budget, as when an editor closes and its
+            views let go of their entries.
+         */
+        void trimToBudgets()
+        {
+            const juce::ScopedLock sl (lock);
+
+            for (auto& entry : caches)
+                entry.cache->trimCache(entry.cache->getCacheStats().budgetBytes);
+        }
+
+        /** Evicts everything nothing holds from every cache, for when the host is
+            short of memory. What's evicted is made again as it's next needed.
+         */
+        void releaseUnused()
+        {
+            const juce::ScopedLock sl (lock);
+
+            for (auto& entry : caches)
+                entry.cache->trimCache(0);
+        }
+
+        /** Returns the size of each cache, by name. */
+        std::map<juce::String, Stats> getStats()
+        {
+            const juce::ScopedLock sl (lock);
+            std::map<juce::String, Stats> stats;
+
+            for (auto& entry : caches)
+                stats[entry.name] = entry.cache->getCacheStats();
+
+            return stats;
+        }
+
+    private:
+        //==============================================================================
+        struct Entry
+        {
+            juce::String name;
+            Cache* cache;
+        };
+
+        void add (const juce::String& name, Cache& cache)
+        {
+            const juce::ScopedLock sl (lock);
+            caches.push_back({ name, &cache });
+
+            auto it = budgets.find(name);
+
+            if (it != budgets.end())
+                cache.setCacheBudget(it->second);
+        }
+
+        void remove (Cache& cache)
+        {
+            const juce::ScopedLock sl (lock);
+
+            caches.erase(std::remove_if(caches.begin(), caches.end(), [&cache](const Entry& e) { return e.cache == &cache; }),
+                         caches.end());
+        }
+
+        //==============================================================================
+        juce::CriticalSection lock;
+        std::vector<Entry> caches;
+        std::map<juce::String, size_t> budgets;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CacheManager)
+    };
+
+}
@@ -0,0 +1,352 @@
+/*
+  ==============================================================================
+
+    blueprint_CanvasView.cpp
+    Created: 15 Oct 2026 8:03:26am
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    void CanvasView::setProperty (const juce::Identifier& name, const juce::var& value)
+    {
+        View::setProperty(name, value);
+
+        if (name == IDs::drawing)
+            setDrawing(value);
+
+        if (name == IDs::drawing || name == IDs::rasterize)
+            raster.invalidate();
+    }
+
+    //==============================================================================
+    void CanvasView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("CanvasView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "CanvasView");
+
+        View::paint(g);
+
+        if (operations.empty())
+            return;
+
+        // The view's opacity is already applied to the component as a whole.
+        if (style.rasterize)
+        {
+            return raster.draw(g, getLocalBounds(), 1.0f, [this](juce::Graphics& target) {
+                replay(target);
+            });
+        }
+
+        replay(g);
+    }
+
+    //==============================================================================
+    void CanvasView::setDrawing (const juce::var& drawing)
+    {
+        operations.clear();
+
+        const auto* block = drawing[IDs::commands].getBinaryData();
+        const auto* strings = drawing[IDs::strings].getArray();
+
+        if (block == nullptr)
+            return;
+
+        const float* commands = static_cast<const float*>(block->getData());
+        const size_t numCommands = block->getSize() / sizeof(float);
+        size_t pos = 0;
+        bool truncated = false;
+
+        auto next = [&]() -> float {
+            if (pos < numCommands)
+                return commands[pos++];
+
+            truncated = true;
+            return 0.0f;
+        };
+
+        auto nextString = [&]() -> juce::String {
+            const int index = (int) next();
+
+            if (strings == nullptr || !juce::isPositiveAndBelow(index, strings->size()))
+                return {};
+
+            return strings->getReference(index).toString();
+        };
+
+        auto nextPoint = [&]() -> juce::Point<float> {
+            const float x = next();
+            return { x, next() };
+        };
+
+        auto nextRect = [&]() -> juce::Rectangle<float> {
+            const float x = next();
+            const float y = next();
+            const float w = next();
+            return { x, y, w, next() };
+        };
+
+        // The drawing state saved and restored along with the transform and clip.
+        struct State
+        {
+            juce::FillType fill { juce::Colours::black };
+            juce::FillType stroke { juce::Colours::black };
+            float lineWidth = 1.0f;
+            float alpha = 1.0f;
+            FontCache::FontHandle font;
+        };
+
+        std::vector<State> savedStates;
+        State state;
+        state.font = fontCache->getFont({}, 14.0f, juce::Font::plain, 0.0f);
+
+        juce::Path path;
+
+        auto withAlpha = [&](juce::FillType fill) {
+            if (state.alpha < 1.0f)
+                fill.setOpacity(fill.getOpacity() * state.alpha);
+
+            return fill;
+        };
+
+        auto add = [&](Operation::Type type) -> Operation& {
+            operations.push_back({});
+            operations.back().type = type;
+            return operations.back();
+        };
+
+        while (pos < numCommands && !truncated)
+        {
+            const auto opcode = static_cast<Opcode>((int) next());
+
+            switch (opcode)
+            {
+                case Opcode::BeginPath:
+                    path.clear();
+                    break;
+                case Opcode::MoveTo:
+                    path.startNewSubPath(nextPoint());
+                    break;
+                case Opcode::LineTo:
+                    path.lineTo(nextPoint());
+                    break;
+                case Opcode::QuadraticTo:
+                {
+                    const auto control = nextPoint();
+                    path.quadraticTo(control, nextPoint());
+                    break;
+                }
+                case Opcode::CubicTo:
+                {
+                    const auto control1 = nextPoint();
+                    const auto control2 = nextPoint();
+                    path.cubicTo(control1, control2, nextPoint());
+                    break;
+                }
+                case Opcode::ClosePath:
+                    path.closeSubPath();
+                    break;
+                case Opcode::Rect:
+                    path.addRectangle(nextRect());
+                    break;
+                case Opcode::RoundedRect:
+                {
+                    const auto rect = nextRect();
+                    path.addRoundedRectangle(rect, next());
+                    break;
+                }
+                case Opcode::Ellipse:
+                    path.addEllipse(nextRect());
+                    break;
+                case Opcode::Arc:
+                {
+                    const auto centre = nextPoint();
+                    const float radius = next();
+                    const float fromRadians = next();
+                    const float toRadians = next();
+
+                    path.addCentredArc(centre.x, centre.y, radius, radius, 0.0f, fromRadians, toRadians, path.isEmpty());
+                    break;
+                }
+                case Opcode::Fill:
+                {
+                    auto& op = add(Operation::FillPath);
+                    op.path = path;
+                    op.fill = withAlpha(state.fill);
+                    break;
+                }
+                case Opcode::Stroke:
+                {
+                    auto& op = add(Operation::StrokePath);
+                    op.path = path;
+                    op.fill = withAlpha(state.stroke);
+                    op.lineWidth = state.lineWidth;
+                    break;
+                }
+                case Opcode::Clip:
+                    add(Operation::ClipPath).path = path;
+                    break;
+                case Opcode::FillRect:
+                {
+                    auto& op = add(Operation::FillRect);
+                    op.rect = nextRect();
+                    op.fill = withAlpha(state.fill);
+                    break;
+                }
+                case Opcode::StrokeRect:
+                {
+                    auto& op = add(Operation::StrokeRect);
+                    op.rect = nextRect();
+                    op.fill = withAlpha(state.stroke);
+                    op.lineWidth = state.lineWidth;
+                    break;
+                }
+                case Opcode::FillText:
+                {
+                    auto& op = add(Operation::DrawText);
+                    op.text = nextString();
+                    op.rect = nextRect();
+                    op.justification = (int) next();
+                    op.fill = withAlpha(state.fill);
+                    op.font = state.font;
+                    break;
+                }
+                case Opcode::SetFillColor:
+                    state.fill = juce::FillType(juce::Colour::fromString(nextString()));
+                    break;
+                case Opcode::SetStrokeColor:
+                    state.stroke = juce::FillType(juce::Colour::fromString(nextString()));
+                    break;
+                case Opcode::SetLinearGradient:
+                case Opcode::SetRadialGradient:
+                {
+                    const bool isRadial = opcode == Opcode::SetRadialGradient;
+                    const bool isStroke = next() != 0.0f;
+
+                    juce::ColourGradient gradient;
+                    gradient.isRadial = isRadial;
+                    gradient.point1 = nextPoint();
+
+                    if (isRadial)
+                        gradient.point2 = gradient.point1.translated(next(), 0.0f);
+                    else
+                        gradient.point2 = nextPoint();
+
+                    const int numStops = (int) next();
+
+                    for (int i = 0; i < numStops && !truncated; ++i)
+                    {
+                        const double offset = juce::jlimit(0.0, 1.0, (double) next());
+                        gradient.addColour(offset, juce::Colour::fromString(nextString()));
+                    }
+
+                    (isStroke ? state.stroke : state.fill) = juce::FillType(gradient);
+                    break;
+                }
+                case Opcode::SetLineWidth:
+                    state.lineWidth = juce::jmax(0.0f, next());
+                    break;
+                case Opcode::SetFont:
+                {
+                    const auto family = nextString();
+                    const float size = juce::jmax(1.0f, next());
+                    state.font = fontCache->getFont(family, size, (int) next(), 0.0f);
+                    break;
+                }
+                case Opcode::SetGlobalAlpha:
+                    state.alpha = juce::jlimit(0.0f, 1.0f, next());
+                    break;
+                case Opcode::Save:
+                    savedStates.push_back(state);
+                    add(Operation::SaveState);
+                    break;
+                case Opcode::Restore:
+                    // As on the web, a restore with nothing saved does nothing.
+                    if (savedStates.empty())
+                        break;
+
+                    state = savedStates.back();
+                    savedStates.pop_back();
+                    add(Operation::RestoreState);
+                    break;
+                case Opcode::Translate:
+                {
+                    const auto delta = nextPoint();
+                    add(Operation::Transform).transform = juce::AffineTransform::translation(delta);
+                    break;
+                }
+                case Opcode::Rotate:
+                    add(Operation::Transform).transform = juce::AffineTransform::rotation(next());
+                    break;
+                case Opcode::Scale:
+                {
+                    const auto factors = nextPoint();
+                    add(Operation::Transform).transform = juce::AffineTransform::scale(factors.x, factors.y);
+                    break;
+                }
+                default:
+                    // An opcode we don't know means we can't tell where the next
+                    // one starts, so we keep what we've decoded so far.
+                    DBG("Unknown canvas opcode: " << (int) opcode);
+                    truncated = true;
+                    break;
+            }
+        }
+
+        jassert (!truncated);
+
+        // Replaying balances the graphics state the drawing left saved.
+        for (size_t i = 0; i < savedStates.size(); ++i)
+            add(Operation::RestoreState);
+    }
+
+    void CanvasView::replay (juce::Graphics& g) const
+    {
+        juce::Graphics::ScopedSaveState state (g);
+
+        for (auto& op : operations)
+        {
+            switch (op.type)
+            {
+                case Operation::FillPath:
+                    g.setFillType(op.fill);
+                    g.fillPath(op.path);
+                    break;
+                case Operation::StrokePath:
+                    g.setFillType(op.fill);
+                    g.strokePath(op.path, juce::PathStrokeType(op.lineWidth));
+                    break;
+                case Operation::ClipPath:
+                    g.reduceClipRegion(op.path);
+                    break;
+                case Operation::FillRect:
+                    g.setFillType(op.fill);
+                    g.fillRect(op.rect);
+                    break;
+                case Operation::StrokeRect:
+                    g.setFillType(op.fill);
+                    g.drawRect(op.rect, op.lineWidth);
+                    break;
+                case Operation::DrawText:
+                    g.setFillType(op.fill);
+                    g.setFont(*op.font);
+                    g.drawText(op.text, op.rect, juce::Justification(op.justification), true);
+                    break;
+                case Operation::SaveState:
+                    g.saveState();
+                    break;
+                case Operation::RestoreState:
+                    g.restoreState();
+                    break;
+                case Operation::Transform:
+                    g.addTransform(op.transform);
+                    break;
+            }
+        }
+    }
+
+}
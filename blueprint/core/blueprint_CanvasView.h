@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    blueprint_CanvasView.h
+    Created: 15 Oct 2026 8:03:26am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "blueprint_FontCache.h"
+#include "blueprint_RasterCache.h"
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The CanvasView class is a core view which paints a retained list of
+        drawing commands recorded on the JavaScript side.
+
+        Its `drawing` property is an object with a `commands` Float32Array of
+        opcodes and their operands, and a `strings` array which the operands
+        index into for colours, font names and text. The view decodes the
+        commands once, building their paths, fills and fonts, and replays the
+        decoded list on each paint until it's given a new drawing.
+
+        The Opcode values must match the CanvasOpcodes in the juce-blueprint
+        package's lib/CanvasContext.js.
+
+        With `rasterize`, the drawing is rendered once to an image at the
+        display's scale, and repaints blit that until the drawing, the view's
+        size or the scale changes.
+     */
+    class CanvasView : public View
+    {
+    public:
+        //==============================================================================
+        enum class Opcode
+        {
+            BeginPath = 1,          // ()
+            MoveTo,                 // (x, y)
+            LineTo,                 // (x, y)
+            QuadraticTo,            // (cx, cy, x, y)
+            CubicTo,                // (c1x, c1y, c2x, c2y, x, y)
+            ClosePath,              // ()
+            Rect,                   // (x, y, w, h)
+            RoundedRect,            // (x, y, w, h, radius)
+            Ellipse,                // (x, y, w, h)
+            Arc,                    // (cx, cy, radius, fromRadians, toRadians)
+            Fill,                   // ()
+            Stroke,                 // ()
+            Clip,                   // ()
+            FillRect,               // (x, y, w, h)
+            StrokeRect,             // (x, y, w, h)
+            FillText,               // (text, x, y, w, h, justification)
+            SetFillColor,           // (colour)
+            SetStrokeColor,         // (colour)
+            SetLinearGradient,      // (target, x1, y1, x2, y2, numStops, [offset, colour]...)
+            SetRadialGradient,      // (target, cx, cy, radius, numStops, [offset, colour]...)
+            SetLineWidth,           // (width)
+            SetFont,                // (family, size, styleFlags)
+            SetGlobalAlpha,         // (alpha)
+            Save,                   // ()
+            Restore,                // ()
+            Translate,              // (x, y)
+            Rotate,                 // (radians)
+            Scale,                  // (sx, sy)
+        };
+
+        //==============================================================================
+        CanvasView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+    private:
+        //==============================================================================
+        /** One step of the decoded drawing. */
+        struct Operation
+        {
+            enum Type
+            {
+                FillPath,
+                StrokePath,
+                ClipPath,
+                FillRect,
+                StrokeRect,
+                DrawText,
+                SaveState,
+                RestoreState,
+                Transform,
+            };
+
+            Type type;
+            juce::Path path;
+            juce::Rectangle<float> rect;
+            juce::FillType fill;
+            float lineWidth = 1.0f;
+            FontCache::FontHandle font;
+            juce::String text;
+            int justification = 0;
+            juce::AffineTransform transform;
+        };
+
+        /** Decodes a drawing's commands into the list of operations to replay. */
+        void setDrawing (const juce::var& drawing);
+
+        void replay (juce::Graphics& g) const;
+
+        //==============================================================================
+        juce::SharedResourcePointer<FontCache> fontCache;
+        std::vector<Operation> operations;
+        RasterCache raster;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CanvasView)
+    };
+
+}
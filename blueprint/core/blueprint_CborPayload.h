@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    blueprint_CborPayload.h
+    Created: 15 Oct 2026 6:41:27pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+
+#include "blueprint_NativeFunction.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A juce::var bound for JavaScript as CBOR, for bulk payloads like parameter
+        snapshots, preset lists or the state sent when the editor opens.
+
+        The var is encoded to CBOR in C++ and decoded into JavaScript values by
+        Duktape's CBOR extra in one pass over the bytes, rather than pushed a value
+        and a property at a time. Pass one as an event argument, or return one from
+        a native function:
+        @code
+        root.dispatchEvent("presets", CborPayload(presetList));
+        @endcode
+
+        Numbers, strings, bools, arrays, objects and binary data, which arrives as
+        a buffer, all survive the trip; a void var arrives as null and methods are
+        dropped.
+     */
+    struct CborPayload
+    {
+        CborPayload() = default;
+        CborPayload (juce::var v) : value(std::move(v)) {}
+
+        juce::var value;
+
+        //==============================================================================
+        /** Encodes a var as CBOR. */
+        static juce::MemoryBlock encode (const juce::var& v)
+        {
+            juce::MemoryOutputStream out;
+            write(out, v);
+
+            return out.getMemoryBlock();
+        }
+
+        /** Pushes the value to the stack, by way of CBOR. */
+        static void push (duk_context* ctx, const juce::var& v)
+        {
+            juce::MemoryOutputStream out;
+            write(out, v);
+
+            // The decode replaces the buffer with what it decoded.
+            const auto size = out.getDataSize();
+            auto* buffer = duk_push_fixed_buffer(ctx, size);
+
+            if (size > 0)
+                std::memcpy(buffer, out.getData(), size);
+
+            duk_cbor_decode(ctx, -1, 0);
+        }
+
+    private:
+        //==============================================================================
+        enum MajorType : juce::uint8
+        {
+            UnsignedInt = 0x00,
+            NegativeInt = 0x20,
+            ByteString  = 0x40,
+            TextString  = 0x60,
+            Array       = 0x80,
+            Map         = 0xa0,
+        };
+
+        static constexpr juce::uint8 falseByte = 0xf4;
+        static constexpr juce::uint8 trueByte = 0xf5;
+        static constexpr juce::uint8 nullByte = 0xf6;
+        static constexpr juce::uint8 undefinedByte = 0xf7;
+        static constexpr juce::uint8 float64Byte = 0xfb;
+
+        /** Writes a major type with its argument, in the shortest form. */
+        static void writeHead (juce::OutputStream& out, MajorType type, juce::uint64 n)
+        {
+            if (n < 24)
+                return (void) out.writeByte((char) (type | n));
+
+            if (n <= 0xff)
+            {
+                out.writeByte((char) (type | 24));
+                out.writeByte((char) n);
+            }
+            else if (n <= 0xffff)
+            {
+                out.writeByte((char) (type | 25));
+                out.writeShortBigEndian((short) n);
+            }
+            else if (n <= 0xffffffffULL)
+            {
+                out.writeByte((char) (type | 26));
+                out.writeIntBigEndian((int) n);
+            }
+            else
+            {
+                out.writeByte((char) (type | 27));
+                out.writeInt64BigEndian((juce::int64) n);
+            }
+        }
+
+        static void writeInt (juce::OutputStream& out, juce::int64 n)
+        {
+            if (n >= 0)
+                writeHead(out, UnsignedInt, (juce::uint64) n);
+            else
+                writeHead(out, NegativeInt, (juce::uint64) (-(n + 1)));
+        }
+
+        static void writeString (juce::OutputStream& out, const juce::String& s)
+        {
+            const auto numBytes = s.getNumBytesAsUTF8();
+            writeHead(out, TextString, numBytes);
+            out.write(s.toRawUTF8(), numBytes);
+        }
+
+        static void write (juce::OutputStream& out, const juce::var& v)
+        {
+            if (v.isVoid())
+                return (void) out.writeByte((char) nullByte);
+            if (v.isUndefined())
+                return (void) out.writeByte((char) undefinedByte);
+            if (v.isBool())
+                return (void) out.writeByte((char) ((bool) v ? trueByte : falseByte));
+            if (v.isInt() || v.isInt64())
+                return writeInt(out, (juce::int64) v);
+
+            if (v.isDouble())
+            {
+                const auto d = (double) v;
+
+                // Whole numbers, which most are, take a byte or a few rather
+                // than nine.
+                if (d == std::floor(d) && std::abs(d) < 9007199254740992.0 && !(d == 0.0 && std::signbit(d)))
+                    return writeInt(out, (juce::int64) d);
+
+                out.writeByte((char) float64Byte);
+                out.writeDoubleBigEndian(d);
+                return;
+            }
+
+            if (v.isString())
+                return writeString(out, v.toString());
+
+            if (auto* block = v.getBinaryData())
+            {
+                writeHead(out, ByteString, block->getSize());
+                out.write(block->getData(), block->getSize());
+                return;
+            }
+
+            if (auto* array = v.getArray())
+            {
+                writeHead(out, Array, (juce::uint64) array->size());
+
+                for (const auto& e : *array)
+                    write(out, e);
+
+                return;
+            }
+
+            if (auto* o = v.getDynamicObject())
+            {
+                const auto& properties = o->getProperties();
+                int numProperties = 0;
+
+                for (const auto& p : properties)
+                    if (!p.value.isMethod())
+                        ++numProperties;
+
+                writeHead(out, Map, (juce::uint64) numProperties);
+
+                for (const auto& p : properties)
+                {
+                    if (p.value.isMethod())
+                        continue;
+
+                    writeString(out, p.name.toString());
+                    write(out, p.value);
+                }
+
+                return;
+            }
+
+            out.writeByte((char) nullByte);
+        }
+    };
+
+    template <>
+    struct DukValue<CborPayload>
+    {
+        static void push (duk_context* ctx, const CborPayload& v) { CborPayload::push(ctx, v.value); }
+    };
+
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    blueprint_CoalescedEventChannel.h
+    Created: 14 Oct 2026 10:26:05pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_ThrottleMap.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A keyed channel of values where only the latest value for each key matters,
+        such as parameter values under host automation.
+
+        Any thread, including the audio thread, may set a key's value without
+        locking or allocating. The message thread then drains the channel once a
+        frame, seeing each key that changed exactly once, with its latest value,
+        however many times it was set in the meantime. With a throttle window, a
+        key goes out at most once per window, and always with its final value;
+        see ThrottleMap.
+     */
+    class CoalescedEventChannel
+    {
+    public:
+        //==============================================================================
+        /** Creates a channel for keys in the range [0, numKeys).
+
+            The channel raises the given flag whenever it has changes, so that its
+            owner knows to drain it.
+         */
+        CoalescedEventChannel (const juce::Identifier& _eventType, int numKeys, std::atomic<bool>& _pendingFlag,
+                               double throttleWindowMs = 0.0)
+            : eventType(_eventType),
+              values(numKeys, throttleWindowMs),
+              pendingFlag(_pendingFlag)
+        {
+        }
+
+        //==============================================================================
+        /** Sets the latest value for the given key. Safe to call from any thread. */
+        void set (int key, double value)
+        {
+            if (values.set(key, value))
+                pendingFlag.store(true, std::memory_order_release);
+        }
+
+        /** Invokes the callback with (int key, double value) for each key due to go
+            out, returning the time at which the next throttled key falls due, or
+            -1 if there's none. Only one thread may drain.
+         */
+        template <typename Fn>
+        double drain (double timeNowMs, Fn&& fn)
+        {
+            return values.flush(timeNowMs, std::forward<Fn>(fn));
+        }
+
+        /** Returns the event type the channel's changes are dispatched as. */
+        const juce::Identifier& getEventType() const { return eventType; }
+
+        /** Returns the number of keys in the channel. */
+        int getNumKeys() const { return values.getNumKeys(); }
+
+    private:
+        //==============================================================================
+        const juce::Identifier eventType;
+        ThrottleMap values;
+        std::atomic<bool>& pendingFlag;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoalescedEventChannel)
+    };
+
+}
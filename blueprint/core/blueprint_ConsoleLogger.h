@@ -0,0 +1,308 @@
+/*
+  ==============================================================================
+
+    blueprint_ConsoleLogger.h
+    Created: 15 Oct 2026 7:41:09pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#include "blueprint_RealtimeEventQueue.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** JavaScript's `console`, written out on a background thread.
+
+        Each message is formatted on the thread which logged it and pushed to a
+        lock-free queue, and a logger thread writes the queue out to stdout, or
+        stderr for warnings and errors, a batch at a time. So a script logging
+        heavily, as it does while the MethodTracer is on, only pays for the
+        formatting and never waits on the terminal. Messages too long for a
+        queue entry are cut short, and if a burst outruns the logger the excess
+        is dropped and counted.
+
+        Messages below the current level return before anything is formatted;
+        in release builds the level starts at warnings. With the module's
+        BLUEPRINT_CONSOLE_LOGGING option disabled, every method is a no-op and
+        there's no logger thread at all.
+
+        Hold the logger through a juce::SharedResourcePointer<ConsoleLogger>;
+        every root in the process shares its thread.
+     */
+    class ConsoleLogger : private juce::Thread
+    {
+    public:
+        //==============================================================================
+        /** How much gets logged, each level including those above it. */
+        enum Level
+        {
+            Off = 0,
+            Error,
+            Warn,
+            Info,
+            Debug,
+        };
+
+        ConsoleLogger()
+            : juce::Thread("Blueprint console"),
+              records(queueCapacity)
+        {
+            if (compiledIn)
+                startThread();
+        }
+
+        ~ConsoleLogger() override
+        {
+            if (compiledIn)
+                stopThread(-1);
+
+            writeQueued();
+        }
+
+        //==============================================================================
+        /** Sets the most detailed level to log; any thread. */
+        void setLevel (Level newLevel) { level.store(newLevel, std::memory_order_relaxed); }
+
+        /** Returns the most detailed level logged. */
+        Level getLevel() const { return level.load(std::memory_order_relaxed); }
+
+        /** Returns true if messages of the given level are logged. */
+        bool isEnabled (Level messageLevel) const
+        {
+            return compiledIn && messageLevel != Off && messageLevel <= level.load(std::memory_order_relaxed);
+        }
+
+        /** Queues a message for the logger thread, cutting it short if it's too
+            long. Safe to call from any thread; never blocks or allocates.
+         */
+        void log (Level messageLevel, const char* utf8, size_t numBytes)
+        {
+            if (!isEnabled(messageLevel))
+                return;
+
+            Record record;
+            record.level = messageLevel;
+
+            if (numBytes > maxMessageBytes)
+            {
+                // Cut on a character boundary, and say that we did.
+                numBytes = maxMessageBytes - truncationMarkBytes;
+
+                while (numBytes > 0 && (static_cast<juce::uint8>(utf8[numBytes]) & 0xc0) == 0x80)
+                    --numBytes;
+
+                std::memcpy(record.text, utf8, numBytes);
+                std::memcpy(record.text + numBytes, truncationMark, truncationMarkBytes);
+                numBytes += truncationMarkBytes;
+            }
+            else
+            {
+                std::memcpy(record.text, utf8, numBytes);
+            }
+
+            record.numBytes = static_cast<juce::uint32>(numBytes);
+            records.push(record);
+        }
+
+        //==============================================================================
+        /** Installs `console` in the given context, logging to this logger. */
+        void install (duk_context* ctx)
+        {
+            duk_push_global_stash(ctx);
+            duk_push_pointer(ctx, this);
+            duk_put_prop_string(ctx, -2, stashKey);
+            duk_pop(ctx);
+
+            duk_push_object(ctx);
+
+            // Objects are formatted as JX, or failing that as strings; scripts
+            // may replace console.format with their own.
+            duk_eval_string(ctx,
+                "(function (E) {"
+                "  return function format(v) {"
+                "    try { return E('jx', v); } catch (e) { return String(v); }"
+                "  };"
+                "})(Duktape.enc)");
+            duk_put_prop_string(ctx, -2, "format");
+
+            addMethod(ctx, "log", Info, Plain);
+            addMethod(ctx, "info", Info, Plain);
+            addMethod(ctx, "dir", Info, Plain);
+            addMethod(ctx, "debug", Debug, Plain);
+            addMethod(ctx, "trace", Debug, Trace);
+            addMethod(ctx, "warn", Warn, Plain);
+            addMethod(ctx, "error", Error, Failure);
+            addMethod(ctx, "exception", Error, Failure);
+            addMethod(ctx, "assert", Error, Assertion);
+
+            duk_put_global_string(ctx, "console");
+        }
+
+    private:
+        //==============================================================================
+        /** What a console method adds to its message. */
+        enum Kind
+        {
+            Plain = 0,
+            Trace,
+            Failure,
+            Assertion,
+        };
+
+        static constexpr size_t queueCapacity = 512;
+        static constexpr size_t maxMessageBytes = 504;
+        static constexpr const char* truncationMark = " [...]";
+        static constexpr size_t truncationMarkBytes = 6;
+        static constexpr int pollIntervalMs = 20;
+        static constexpr const char* stashKey = "consoleLogger";
+        static constexpr bool compiledIn = BLUEPRINT_CONSOLE_LOGGING != 0;
+
+        struct Record
+        {
+            Level level = Off;
+            juce::uint32 numBytes = 0;
+            char text[maxMessageBytes];
+        };
+
+        //==============================================================================
+        static void addMethod (duk_context* ctx, const char* name, Level methodLevel, Kind kind)
+        {
+            duk_push_c_function(ctx, logFromScript, DUK_VARARGS);
+            duk_push_string(ctx, "name");
+            duk_push_string(ctx, name);
+            duk_def_prop(ctx, -3, DUK_DEFPROP_HAVE_VALUE | DUK_DEFPROP_FORCE);
+            duk_set_magic(ctx, -1, static_cast<duk_int_t>(methodLevel | (kind << 4)));
+            duk_put_prop_string(ctx, -2, name);
+        }
+
+        /** Every console method, its level and kind in its magic. Formats the
+            arguments as Duktape's console extra does: objects by console.format,
+            all joined by spaces, with a stack trace for traces, errors and failed
+            assertions.
+         */
+        static duk_ret_t logFromScript (duk_context* ctx)
+        {
+            const auto magic = duk_get_current_magic(ctx);
+            const auto messageLevel = static_cast<Level>(magic & 0x0f);
+            const auto kind = static_cast<Kind>(magic >> 4);
+
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, stashKey);
+            auto* logger = static_cast<ConsoleLogger*>(duk_get_pointer(ctx, -1));
+            duk_pop_2(ctx);
+
+            if (logger == nullptr || !logger->isEnabled(messageLevel))
+                return 0;
+
+            if (kind == Assertion)
+            {
+                if (duk_to_boolean(ctx, 0))
+                    return 0;
+
+                duk_remove(ctx, 0);
+            }
+
+            const duk_idx_t numArgs = duk_get_top(ctx);
+
+            duk_get_global_string(ctx, "console");
+            duk_get_prop_string(ctx, -1, "format");
+
+            for (duk_idx_t i = 0; i < numArgs; ++i)
+            {
+                if (duk_check_type_mask(ctx, i, DUK_TYPE_MASK_OBJECT))
+                {
+                    duk_dup(ctx, -1);
+                    duk_dup(ctx, i);
+                    duk_call(ctx, 1);
+                    duk_replace(ctx, i);
+                }
+            }
+
+            duk_pop_2(ctx);
+
+            duk_push_string(ctx, " ");
+            duk_insert(ctx, 0);
+            duk_join(ctx, numArgs);
+
+            if (kind != Plain)
+            {
+                static const char* const errorNames[] = { "", "Trace", "Error", "AssertionError" };
+
+                duk_push_error_object(ctx, DUK_ERR_ERROR, "%s", duk_require_string(ctx, -1));
+                duk_push_string(ctx, "name");
+                duk_push_string(ctx, errorNames[kind]);
+                duk_def_prop(ctx, -3, DUK_DEFPROP_FORCE | DUK_DEFPROP_HAVE_VALUE);
+                duk_get_prop_string(ctx, -1, "stack");
+            }
+
+            duk_size_t numBytes = 0;
+            const char* utf8 = duk_safe_to_lstring(ctx, -1, &numBytes);
+            logger->log(messageLevel, utf8, numBytes);
+
+            return 0;
+        }
+
+        //==============================================================================
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                writeQueued();
+                wait(pollIntervalMs);
+            }
+        }
+
+        /** Writes out everything queued, flushing once at the end. */
+        void writeQueued()
+        {
+            Record record;
+            bool wroteOut = false;
+            bool wroteErr = false;
+
+            while (records.pop(record))
+            {
+                const bool isProblem = record.level <= Warn;
+                auto* stream = isProblem ? stderr : stdout;
+
+                std::fwrite(record.text, 1, record.numBytes, stream);
+                std::fputc('\n', stream);
+
+                (isProblem ? wroteErr : wroteOut) = true;
+            }
+
+            if (const auto numDropped = records.getAndResetNumDropped())
+            {
+                std::fprintf(stderr, "(%d console messages dropped)\n", (int) numDropped);
+                wroteErr = true;
+            }
+
+            if (wroteOut)
+                std::fflush(stdout);
+
+            if (wroteErr)
+                std::fflush(stderr);
+        }
+
+        //==============================================================================
+        RealtimeEventQueue<Record> records;
+
+#if JUCE_DEBUG
+        std::atomic<Level> level { Debug };
+#else
+        std::atomic<Level> level { Warn };
+#endif
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConsoleLogger)
+    };
+
+}
@@ -0,0 +1,388 @@
+/*
+  ==============================================================================
+
+    blueprint_DrawableCache.h
+    Created: 15 Oct 2026 6:07:40am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "blueprint_CacheManager.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The DrawableCache is a process-wide store of the drawables decoded from
+        ImageView sources.
+
+        Any one icon tends to be used by many views, across every root in the
+        process, and decoding it, whether parsing SVG or decompressing a PNG, is
+        by far the most expensive part of setting an ImageView's source. The
+        cache hands out shared, immutable drawables keyed by a hash of the source
+        data, so that each distinct source is decoded once.
+
+        Drawables no view is holding stay cached, least recently used first out,
+        for as long as the cache is within its byte budget. Drawables in use are
+        never evicted, and don't count against the budget. The CacheManager sets
+        the budget as "drawables", as well as setBudget.
+
+        A source is usually the image data itself. It can also name where the
+        data is, so that the data never has to cross the bridge as a string:
+
+        - `file:///path/to/image.svg` reads a file.
+        - `binary:icon_svg` reads a named resource from the resource provider,
+          for instance `BinaryData::getNamedResource`.
+
+        Large sources, and all files, are best decoded on the cache's thread
+        pool with `getDrawableAsync`, ahead of being painted.
+
+        Hold the cache through a juce::SharedResourcePointer<DrawableCache>;
+        lookups are safe to make from any thread.
+     */
+    class DrawableCache : private CacheManager::Cache
+    {
+    public:
+        //==============================================================================
+        using DrawableHandle = std::shared_ptr<const juce::Drawable>;
+
+        /** Called on the message thread with a decoded drawable, or nullptr. */
+        using Callback = std::function<void (DrawableHandle)>;
+
+        /** Looks up a named resource, with the same signature as the
+            `BinaryData::getNamedResource` the Projucer generates.
+         */
+        using ResourceProvider = std::function<const char* (const char* resourceName, int& dataSizeInBytes)>;
+
+        DrawableCache() = default;
+
+        ~DrawableCache()
+        {
+            // The decoders use the cache, so they stop first.
+            pool.removeAllJobs(true, -1);
+        }
+
+        //==============================================================================
+        /** Returns the shared drawable decoded from the given source, decoding it if
+            needed, or nullptr if the source isn't an image.
+         */
+        DrawableHandle getDrawable (const juce::String& source)
+        {
+            bool cached = false;
+            auto drawable = findDrawable(source, cached);
+
+            if (cached)
+                return drawable;
+
+            return add(source, decode(source));
+        }
+
+        /** Returns the shared drawable for the given source if it's already been
+            decoded, or nullptr.
+         */
+        DrawableHandle getCachedDrawable (const juce::String& source)
+        {
+            bool cached = false;
+            return findDrawable(source, cached);
+        }
+
+        /** Decodes the given source on the cache's thread pool, then calls back on
+            the message thread. Requests for a source already being decoded join
+            the decode in progress.
+         */
+        void getDrawableAsync (const juce::String& source, Callback callback)
+        {
+            const auto hash = source.hashCode64();
+
+            {
+                const juce::ScopedLock sl (lock);
+                auto it = pending.find(hash);
+
+                if (it != pending.end() && it->second.source == source)
+                {
+                    it->second.callbacks.push_back(std::move(callback));
+                    return;
+                }
+
+                if (it == pending.end())
+                {
+                    pending[hash] = { source, {} };
+                    pending[hash].callbacks.push_back(std::move(callback));
+                    callback = nullptr;
+                }
+            }
+
+            pool.addJob([this, source, hash, callback]() {
+                auto drawable = add(source, decode(source));
+                std::vector<Callback> callbacks;
+
+                if (callback)
+                {
+                    callbacks.push_back(callback);
+                }
+                else
+                {
+                    const juce::ScopedLock sl (lock);
+                    auto it = pending.find(hash);
+
+                    if (it != pending.end())
+                    {
+                        callbacks = std::move(it->second.callbacks);
+                        pending.erase(it);
+                    }
+                }
+
+                juce::MessageManager::callAsync([callbacks, drawable]() {
+                    for (auto& cb : callbacks)
+                        cb(drawable);
+                });
+            });
+        }
+
+        /** Returns true if the given source is better decoded asynchronously: all
+            files, and any other source with a lot of data.
+         */
+        bool shouldDecodeAsync (const juce::String& source)
+        {
+            if (source.startsWith(fileScheme))
+                return true;
+
+            if (source.startsWith(binaryScheme))
+            {
+                int size = 0;
+                return getNamedResource(source, size) != nullptr && size >= asyncThresholdBytes;
+            }
+
+            return source.length() >= asyncThresholdBytes;
+        }
+
+        //==============================================================================
+        /** Sets where `binary:` sources come from, for instance
+            `cache->setResourceProvider(BinaryData::getNamedResource)`.
+         */
+        void setResourceProvider (ResourceProvider provider)
+        {
+            const juce::ScopedLock sl (lock);
+            resourceProvider = std::move(provider);
+        }
+
+        //==============================================================================
+        /** Sets how many bytes of drawables no view is holding the cache may keep. */
+        void setBudget (size_t numBytes)
+        {
+            const juce::ScopedLock sl (lock);
+
+            budgetBytes = numBytes;
+            purge(budgetBytes);
+        }
+
+        /** Drops every cached drawable that no view is currently holding. */
+        void purgeUnusedDrawables()
+        {
+            const juce::ScopedLock sl (lock);
+            purge(0);
+        }
+
+    private:
+        //==============================================================================
+        struct Entry
+        {
+            juce::int64 hash;
+
+            // juce::String shares its text, so this costs no second copy of the
+            // source the view was given.
+            juce::String source;
+
+            DrawableHandle drawable;
+            size_t numBytes;
+
+            bool isUnused() const { return drawable.use_count() == 1; }
+        };
+
+        struct PendingDecode
+        {
+            juce::String source;
+            std::vector<Callback> callbacks;
+        };
+
+        /** Looks the source up, setting `cached` if it's in the cache. */
+        DrawableHandle findDrawable (const juce::String& source, bool& cached)
+        {
+            const auto hash = source.hashCode64();
+            const juce::ScopedLock sl (lock);
+
+            auto it = entries.find(hash);
+
+            // A hash collision we treat as a miss, and don't cache.
+            if (it == entries.end() || it->second->source != source)
+                return nullptr;
+
+            lru.splice(lru.begin(), lru, it->second);
+            cached = true;
+            return it->second->drawable;
+        }
+
+        /** Adds a freshly decoded drawable, returning the one to use: another
+            thread may have decoded the same source in the meantime.
+         */
+        DrawableHandle add (const juce::String& source, DrawableHandle drawable)
+        {
+            if (drawable == nullptr)
+                return nullptr;
+
+            const auto hash = source.hashCode64();
+            const juce::ScopedLock sl (lock);
+
+            auto it = entries.find(hash);
+
+            if (it != entries.end())
+                return it->second->source == source ? it->second->drawable : drawable;
+
+            lru.push_front({ hash, source, drawable, estimateBytes(source, *drawable) });
+            entries.emplace(hash, lru.begin());
+
+            purge(budgetBytes);
+            return drawable;
+        }
+
+        const char* getNamedResource (const juce::String& source, int& size)
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (!resourceProvider)
+                return nullptr;
+
+            return resourceProvider(source.substring(static_cast<int>(std::strlen(binaryScheme))).toRawUTF8(), size);
+        }
+
+        DrawableHandle decode (const juce::String& source)
+        {
+            if (source.startsWith(fileScheme))
+            {
+                const juce::File file (juce::URL(source).getLocalFile());
+                DrawableHandle drawable (juce::Drawable::createFromImageFile(file));
+
+                if (drawable == nullptr)
+                    DBG("Failed to load image: " << file.getFullPathName());
+
+                return drawable;
+            }
+
+            if (source.startsWith(binaryScheme))
+            {
+                int size = 0;
+                const char* data = getNamedResource(source, size);
+
+                if (data == nullptr)
+                {
+                    DBG("Unknown image resource: " << source);
+                    return nullptr;
+                }
+
+                return DrawableHandle(juce::Drawable::createFromImageData(data, static_cast<size_t>(size)));
+            }
+
+            return DrawableHandle(juce::Drawable::createFromImageData(source.toRawUTF8(), source.getNumBytesAsUTF8()));
+        }
+
+        /** A rough size for a drawable: the pixels of a raster image, or the source
+            of anything else, whose parsed form grows with it.
+         */
+        static size_t estimateBytes (const juce::String& source, const juce::Drawable& drawable)
+        {
+            // For a file or resource, the drawable's size is all we have.
+            size_t numBytes = source.getNumBytesAsUTF8();
+
+            if (auto* image = dynamic_cast<const juce::DrawableImage*>(&drawable))
+            {
+                const auto& im = image->getImage();
+                numBytes = juce::jmax(numBytes, static_cast<size_t>(im.getWidth()) * static_cast<size_t>(im.getHeight()) * 4);
+            }
+
+            return numBytes;
+        }
+
+        //==============================================================================
+        CacheManager::Stats getCacheStats() override
+        {
+            const juce::ScopedLock sl (lock);
+            CacheManager::Stats stats;
+
+            for (const auto& entry : lru)
+                stats.add(entry);
+
+            stats.budgetBytes = budgetBytes;
+            return stats;
+        }
+
+        void setCacheBudget (size_t numBytes) override
+        {
+            setBudget(numBytes);
+        }
+
+        void trimCache (size_t maxUnusedBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+            purge(maxUnusedBytes);
+        }
+
+        /** Evicts drawables no view holds, least recently used first, until those
+            left add up to no more than the given number of bytes.
+         */
+        void purge (size_t maxBytes)
+        {
+            size_t unusedBytes = 0;
+
+            for (auto& entry : lru)
+                if (entry.drawable.use_count() == 1)
+                    unusedBytes += entry.numBytes;
+
+            for (auto it = lru.end(); unusedBytes > maxBytes && it != lru.begin();)
+            {
+                --it;
+
+                if (it->drawable.use_count() != 1)
+                    continue;
+
+                unusedBytes -= it->numBytes;
+                entries.erase(it->hash);
+                it = lru.erase(it);
+            }
+        }
+
+        //==============================================================================
+        // Plenty for the icons of a large interface.
+        static constexpr size_t defaultBudgetBytes = 32 * 1024 * 1024;
+
+        // Icons decode in well under a millisecond; beyond this we'd rather not
+        // hold up a commit.
+        static constexpr int asyncThresholdBytes = 16 * 1024;
+
+        static constexpr const char* fileScheme = "file://";
+        static constexpr const char* binaryScheme = "binary:";
+
+        juce::CriticalSection lock;
+        std::list<Entry> lru;
+        std::unordered_map<juce::int64, std::list<Entry>::iterator> entries;
+        std::unordered_map<juce::int64, PendingDecode> pending;
+        size_t budgetBytes = defaultBudgetBytes;
+        ResourceProvider resourceProvider;
+
+        juce::ThreadPool pool { 2 };
+
+        CacheManager::Registration registration { "drawables", *this };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DrawableCache)
+    };
+
+}
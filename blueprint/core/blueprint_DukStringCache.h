@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    blueprint_DukStringCache.h
+    Created: 15 Oct 2026 7:02:16pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Remembers the engine's copies of the strings we push most, so that pushing
+        the same juce::String again pushes a reference to the engine's string
+        instead of converting it to UTF-8 and hashing it into the string table.
+
+        Strings are known by identity, the address of their text, which suits the
+        parameter ids, event payload keys and other strings native code holds onto
+        and pushes over and over. Each entry keeps a reference to its juce::String,
+        so the text can't be freed and its address reused while the entry lives,
+        and the engine's copy is held in the global stash.
+
+        The cache is direct-mapped: a string displaces whichever string held its
+        slot before, so it never grows and one-off strings cost no more than a
+        slot. Use it on the engine's thread only.
+     */
+    class DukStringCache
+    {
+    public:
+        //==============================================================================
+        DukStringCache() = default;
+
+        //==============================================================================
+        /** Pushes the given string to the stack. */
+        void push (duk_context* ctx, const juce::String& s)
+        {
+            const auto* text = s.getCharPointer().getAddress();
+            const auto numBytes = s.getNumBytesAsUTF8();
+
+            // Long strings would pin a lot of memory for little gain.
+            if (numBytes == 0 || numBytes > maxCachedBytes)
+                return (void) duk_push_lstring(ctx, text, numBytes);
+
+            const auto slot = (reinterpret_cast<juce::pointer_sized_uint>(text) >> 4) % numSlots;
+            auto& entry = entries[slot];
+
+            if (entry.heapPtr != nullptr && entry.string.getCharPointer().getAddress() == text)
+                return (void) duk_push_heapptr(ctx, entry.heapPtr);
+
+            duk_push_lstring(ctx, text, numBytes);
+
+            // Strings can't carry properties, so the stash holds the references
+            // which keep our cached strings alive, one per slot.
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, stashKey);
+
+            if (!duk_is_array(ctx, -1))
+            {
+                duk_pop(ctx);
+                duk_push_array(ctx);
+                duk_dup_top(ctx);
+                duk_put_prop_string(ctx, -3, stashKey);
+            }
+
+            duk_dup(ctx, -3);
+            duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(slot));
+            duk_pop_2(ctx);
+
+            entry.string = s;
+            entry.heapPtr = duk_get_heapptr(ctx, -1);
+        }
+
+        /** Forgets every string, as when the engine they were pushed to is
+            reset.
+         */
+        void clear()
+        {
+            for (auto& entry : entries)
+                entry = {};
+        }
+
+    private:
+        //==============================================================================
+        struct Entry
+        {
+            juce::String string;
+            void* heapPtr = nullptr;
+        };
+
+        static constexpr size_t numSlots = 512;
+        static constexpr size_t maxCachedBytes = 256;
+        static constexpr const char* stashKey = "stringCache";
+
+        std::array<Entry, numSlots> entries;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DukStringCache)
+    };
+
+}
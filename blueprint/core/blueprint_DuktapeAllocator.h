@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+    blueprint_DuktapeAllocator.h
+    Created: 15 Oct 2026 4:08:26am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A pooled allocator for a Duktape heap, after Duktape's alloc-hybrid example.
+
+        React churns through a great many small, short lived objects, and with the
+        default heap each of those is a trip through the system malloc. Here, small
+        allocations come from a few fixed size pools carved out of one region up
+        front, each with its own free list, so allocating and freeing them is a
+        couple of pointer moves. Allocations too large for any pool, or made while
+        the pools are exhausted, fall back on the system allocator.
+
+        A limit on the bytes taken from the system allocator puts a hard bound on
+        the memory a root's JavaScript can use, the pools included: once it's
+        reached, Duktape collects garbage and, failing that, throws.
+
+        An allocator serves a single heap at a time, and must outlive it.
+     */
+    class DuktapeAllocator
+    {
+    public:
+        //==============================================================================
+        struct Pool
+        {
+            size_t blockSize;
+            size_t numBlocks;
+        };
+
+        struct Options
+        {
+            /** The pools, in ascending order of block size. Block sizes must be
+                multiples of 8, so that every block is suitably aligned.
+             */
+            std::vector<Pool> pools {
+                { 32, 1024 },
+                { 48, 2048 },
+                { 64, 2048 },
+                { 128, 2048 },
+                { 256, 512 },
+                { 1024, 64 },
+                { 2048, 32 },
+            };
+
+            /** The most memory, in bytes, to take from the system allocator on top
+                of the pools. Duktape allocates its heap structures this way, so
+                allow at least a few hundred kilobytes.
+             */
+            size_t systemAllocationLimit = std::numeric_limits<size_t>::max();
+        };
+
+        //==============================================================================
+        DuktapeAllocator() : DuktapeAllocator(Options()) {}
+
+        explicit DuktapeAllocator (const Options& _options)
+            : options(_options)
+        {
+            size_t regionSize = 0;
+
+            for (auto& p : options.pools)
+            {
+                // If you hit this, a block size isn't a multiple of 8, or the pools
+                // aren't in ascending order of block size.
+                jassert (p.blockSize >= sizeof(FreeBlock) && p.blockSize % 8 == 0);
+                jassert (&p == &options.pools.front() || p.blockSize > (&p - 1)->blockSize);
+
+                regionSize += p.blockSize * p.numBlocks;
+            }
+
+            region = static_cast<char*>(std::malloc(juce::jmax(regionSize, (size_t) 1)));
+            regionEnd = region + regionSize;
+
+            // Duktape frees everything with its heap, so the pools start out full
+            // and are full again whenever no heap is using them.
+            char* start = region;
+
+            for (auto& p : options.pools)
+            {
+                PoolState pool { p.blockSize, start, start + p.blockSize * p.numBlocks, nullptr };
+
+                for (size_t i = p.numBlocks; i > 0; --i)
+                {
+                    auto* block = reinterpret_cast<FreeBlock*>(start + (i - 1) * p.blockSize);
+                    block->next = pool.freeList;
+                    pool.freeList = block;
+                }
+
+                pools.push_back(pool);
+                start = pool.end;
+            }
+        }
+
+        ~DuktapeAllocator()
+        {
+            // If you hit this, the heap using this allocator is still alive.
+            jassert (numBlocksInUse == 0 && systemBytesInUse == 0);
+            std::free(region);
+        }
+
+        //==============================================================================
+        /** Creates a Duktape heap allocating from this allocator. */
+        duk_context* createHeap (duk_fatal_function fatalHandler = nullptr)
+        {
+            return duk_create_heap(allocate, reallocate, release, this, fatalHandler);
+        }
+
+        /** Returns the number of pool blocks currently allocated. */
+        size_t getNumBlocksInUse() const { return numBlocksInUse; }
+
+        /** Returns the bytes currently allocated from the system allocator. */
+        size_t getSystemBytesInUse() const { return systemBytesInUse; }
+
+        /** Returns the total size of the pools, in bytes. */
+        size_t getPoolBytes() const { return static_cast<size_t>(regionEnd - region); }
+
+        //==============================================================================
+        /** Allocates a block of at least the given size, as Duktape would through
+            the heap, for allocators wrapping this one. Returns nullptr on failure.
+         */
+        void* allocateBlock (size_t size)
+        {
+            // Like Duktape's pool allocator, we borrow from the next size up when a
+            // pool runs dry.
+            for (auto& p : pools)
+            {
+                if (size <= p.blockSize && p.freeList != nullptr)
+                {
+                    auto* block = p.freeList;
+                    p.freeList = block->next;
+                    ++numBlocksInUse;
+                    return block;
+                }
+            }
+
+            return allocateSystemBlock(size);
+        }
+
+        /** Resizes a block, as Duktape would through the heap. */
+        void* reallocateBlock (void* ptr, size_t size)
+        {
+            if (ptr == nullptr)
+                return allocateBlock(size);
+
+            if (size == 0)
+            {
+                releaseBlock(ptr);
+                return nullptr;
+            }
+
+            auto* pool = findPool(ptr);
+
+            // Blocks from the system stay with the system.
+            if (pool == nullptr)
+                return reallocateSystemBlock(ptr, size);
+
+            if (size <= pool->blockSize)
+                return ptr;
+
+            void* newPtr = allocateBlock(size);
+
+            if (newPtr != nullptr)
+            {
+                std::memcpy(newPtr, ptr, pool->blockSize);
+                releaseBlock(ptr);
+            }
+
+            return newPtr;
+        }
+
+        /** Returns a block to the allocator, as Duktape would through the heap. */
+        void releaseBlock (void* ptr)
+        {
+            if (ptr == nullptr)
+                return;
+
+            if (auto* pool = findPool(ptr))
+            {
+                auto* block = static_cast<FreeBlock*>(ptr);
+                block->next = pool->freeList;
+                pool->freeList = block;
+                --numBlocksInUse;
+                return;
+            }
+
+            systemBytesInUse -= getSystemBlockSize(ptr);
+            std::free(static_cast<char*>(ptr) - systemHeaderSize);
+        }
+
+        /** Returns the usable size of a block from this allocator. */
+        size_t getBlockSize (void* ptr)
+        {
+            if (auto* pool = findPool(ptr))
+                return pool->blockSize;
+
+            return getSystemBlockSize(ptr);
+        }
+
+    private:
+        //==============================================================================
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct PoolState
+        {
+            size_t blockSize;
+            char* start;
+            char* end;
+            FreeBlock* freeList;
+        };
+
+        //==============================================================================
+        // System blocks carry their size in front of them, so that we can keep
+        // count of the bytes they hold.
+        static constexpr size_t systemHeaderSize = 16;
+
+        static size_t& getSystemBlockSize (void* ptr)
+        {
+            return *reinterpret_cast<size_t*>(static_cast<char*>(ptr) - systemHeaderSize);
+        }
+
+        void* allocateSystemBlock (size_t size)
+        {
+            if (size > options.systemAllocationLimit - systemBytesInUse)
+                return nullptr;
+
+            auto* raw = static_cast<char*>(std::malloc(size + systemHeaderSize));
+
+            if (raw == nullptr)
+                return nullptr;
+
+            systemBytesInUse += size;
+            *reinterpret_cast<size_t*>(raw) = size;
+            return raw + systemHeaderSize;
+        }
+
+        void* reallocateSystemBlock (void* ptr, size_t size)
+        {
+            const size_t oldSize = getSystemBlockSize(ptr);
+
+            if (size > oldSize && size - oldSize > options.systemAllocationLimit - systemBytesInUse)
+                return nullptr;
+
+            auto* raw = static_cast<char*>(std::realloc(static_cast<char*>(ptr) - systemHeaderSize, size + systemHeaderSize));
+
+            if (raw == nullptr)
+                return nullptr;
+
+            systemBytesInUse = systemBytesInUse - oldSize + size;
+            *reinterpret_cast<size_t*>(raw) = size;
+            return raw + systemHeaderSize;
+        }
+
+        PoolState* findPool (void* ptr)
+        {
+            auto* p = static_cast<char*>(ptr);
+
+            if (p < region || p >= regionEnd)
+                return nullptr;
+
+            for (auto& pool : pools)
+                if (p < pool.end)
+                    return &pool;
+
+            return nullptr;
+        }
+
+        //==============================================================================
+        static void* allocate (void* udata, duk_size_t size)
+        {
+            return size == 0 ? nullptr : static_cast<DuktapeAllocator*>(udata)->allocateBlock(size);
+        }
+
+        static void* reallocate (void* udata, void* ptr, duk_size_t size)
+        {
+            return static_cast<DuktapeAllocator*>(udata)->reallocateBlock(ptr, size);
+        }
+
+        static void release (void* udata, void* ptr)
+        {
+            static_cast<DuktapeAllocator*>(udata)->releaseBlock(ptr);
+        }
+
+        //==============================================================================
+        const Options options;
+        std::vector<PoolState> pools;
+
+        char* region = nullptr;
+        char* regionEnd = nullptr;
+
+        size_t numBlocksInUse = 0;
+        size_t systemBytesInUse = 0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DuktapeAllocator)
+    };
+
+}
@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+    blueprint_EditableDrawable.h
+    Created: 15 Oct 2026 8:14:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A view's own copy of a shared drawable, whose elements it can change in
+        place by the `id` they had in the SVG.
+
+        The component of a meter or a knob which rebuilds its SVG for each new
+        value has every update parse the XML again and build a new drawable
+        tree. An ImageView instead takes properties named for an element and an
+        attribute, such as `#fill.width`, `#arc.d` or `#needle.transform`, and
+        sets just that attribute on its copy, with no parsing beyond the value.
+
+        The attributes understood are:
+
+        - `d`, the path of a path
+        - `x`, `y`, `width` and `height`, the geometry of a rectangle
+        - `transform`, an SVG transform list, applied over the element's own
+        - `fill`, `stroke` and `stroke-width`, of any shape
+        - `opacity`, and `visibility` or `display` to hide the element
+        - `text`, the text of a text element
+
+        Each element is looked up once, and remembered for the next change.
+     */
+    class EditableDrawable
+    {
+    public:
+        //==============================================================================
+        explicit EditableDrawable (const juce::Drawable& source)
+            : drawable(source.createCopy())
+        {
+        }
+
+        /** Returns true if the given property names an element's attribute. */
+        static bool isAttributeProperty (const juce::Identifier& name)
+        {
+            return name.getCharPointer()[0] == '#';
+        }
+
+        /** Sets the attribute the given property names to the given value,
+            returning false if there's no such element or attribute.
+         */
+        bool setAttribute (const juce::Identifier& name, const juce::var& value)
+        {
+            const auto s = name.toString();
+            const int dot = s.lastIndexOfChar('.');
+
+            if (!isAttributeProperty(name) || dot < 2)
+                return false;
+
+            auto* element = findElement(s.substring(1, dot));
+
+            if (element == nullptr)
+                return false;
+
+            return setAttribute(*element, s.substring(dot + 1), value);
+        }
+
+        /** Returns the copy, with every attribute set so far. */
+        const juce::Drawable& getDrawable() const { return *drawable; }
+
+        //==============================================================================
+        /** Parses an SVG transform list, e.g. `rotate(30 50 50) translate(4, 0)`. */
+        static juce::AffineTransform parseTransform (const juce::String& text)
+        {
+            juce::AffineTransform result;
+            auto remaining = text;
+
+            while (remaining.containsChar('('))
+            {
+                const auto function = remaining.upToFirstOccurrenceOf("(", false, false).trim();
+                const auto args = juce::StringArray::fromTokens(remaining.fromFirstOccurrenceOf("(", false, false)
+                                                                         .upToFirstOccurrenceOf(")", false, false), ", ", "");
+                remaining = remaining.fromFirstOccurrenceOf(")", false, false);
+
+                auto arg = [&args](int i, float fallback) { return i < args.size() ? args[i].getFloatValue() : fallback; };
+                juce::AffineTransform t;
+
+                if (function == "translate")
+                    t = juce::AffineTransform::translation(arg(0, 0.0f), arg(1, 0.0f));
+                else if (function == "scale")
+                    t = juce::AffineTransform::scale(arg(0, 1.0f), arg(1, arg(0, 1.0f)));
+                else if (function == "rotate")
+                    t = juce::AffineTransform::rotation(juce::degreesToRadians(arg(0, 0.0f)), arg(1, 0.0f), arg(2, 0.0f));
+                else if (function == "skewX")
+                    t = juce::AffineTransform::shear(std::tan(juce::degreesToRadians(arg(0, 0.0f))), 0.0f);
+                else if (function == "skewY")
+                    t = juce::AffineTransform::shear(0.0f, std::tan(juce::degreesToRadians(arg(0, 0.0f))));
+                else if (function == "matrix")
+                    t = { arg(0, 1.0f), arg(2, 0.0f), arg(4, 0.0f), arg(1, 0.0f), arg(3, 1.0f), arg(5, 0.0f) };
+
+                // The rightmost transform of the list applies first.
+                result = t.followedBy(result);
+            }
+
+            return result;
+        }
+
+        /** Parses an SVG colour: `#rgb`, `#rrggbb`, `none`, or a colour name. */
+        static juce::Colour parseColour (const juce::String& text)
+        {
+            const auto s = text.trim();
+
+            if (s.startsWithChar('#'))
+            {
+                auto hex = s.substring(1);
+
+                if (hex.length() == 3)
+                    hex = juce::String::charToString(hex[0]) + hex[0] + hex[1] + hex[1] + hex[2] + hex[2];
+
+                return juce::Colour((juce::uint32) (hex.length() == 6 ? 0xff000000 | (juce::uint32) hex.getHexValue32()
+                                                                      : (juce::uint32) hex.getHexValue32()));
+            }
+
+            if (s == "none")
+                return juce::Colours::transparentBlack;
+
+            return juce::Colours::findColourForName(s, juce::Colour::fromString(s));
+        }
+
+    private:
+        //==============================================================================
+        juce::Drawable* findElement (const juce::String& id)
+        {
+            auto it = elements.find(id);
+
+            if (it != elements.end())
+                return it->second;
+
+            auto* element = findElement(*drawable, id);
+            elements[id] = element;
+            return element;
+        }
+
+        static juce::Drawable* findElement (juce::Drawable& parent, const juce::String& id)
+        {
+            if (parent.getComponentID() == id)
+                return &parent;
+
+            for (auto* child : parent.getChildren())
+                if (auto* d = dynamic_cast<juce::Drawable*>(child))
+                    if (auto* found = findElement(*d, id))
+                        return found;
+
+            return nullptr;
+        }
+
+        bool setAttribute (juce::Drawable& element, const juce::String& attribute, const juce::var& value)
+        {
+            if (attribute == "transform")
+            {
+                element.setTransform(parseTransform(value.toString()));
+                return true;
+            }
+
+            if (attribute == "opacity")
+            {
+                element.setAlpha(juce::jlimit(0.0f, 1.0f, (float) value));
+                return true;
+            }
+
+            if (attribute == "visibility" || attribute == "display")
+            {
+                const auto s = value.toString();
+                element.setVisible(s != "hidden" && s != "none");
+                return true;
+            }
+
+            if (auto* text = dynamic_cast<juce::DrawableText*>(&element))
+            {
+                if (attribute == "text")
+                {
+                    text->setText(value.toString());
+                    return true;
+                }
+
+                if (attribute == "fill")
+                {
+                    text->setColour(parseColour(value.toString()));
+                    return true;
+                }
+
+                return false;
+            }
+
+            auto* shape = dynamic_cast<juce::DrawableShape*>(&element);
+
+            if (shape == nullptr)
+                return false;
+
+            if (attribute == "fill")
+                shape->setFill(parseColour(value.toString()));
+            else if (attribute == "stroke")
+                shape->setStrokeFill(parseColour(value.toString()));
+            else if (attribute == "stroke-width")
+                shape->setStrokeThickness((float) value);
+            else if (auto* path = dynamic_cast<juce::DrawablePath*>(&element))
+                return setPathAttribute(*path, attribute, value);
+            else
+                return false;
+
+            return true;
+        }
+
+        /** Sets a path's data, or the geometry of a rectangle, which the SVG parser
+            gives us as a path too.
+         */
+        static bool setPathAttribute (juce::DrawablePath& path, const juce::String& attribute, const juce::var& value)
+        {
+            if (attribute == "d")
+            {
+                path.setPath(juce::Drawable::parseSVGPath(value.toString()));
+                return true;
+            }
+
+            auto rect = path.getPath().getBounds();
+            const float v = (float) value;
+
+            if (attribute == "x")               rect.setX(v);
+            else if (attribute == "y")          rect.setY(v);
+            else if (attribute == "width")      rect.setWidth(v);
+            else if (attribute == "height")     rect.setHeight(v);
+            else                                return false;
+
+            juce::Path p;
+            p.addRectangle(rect);
+            path.setPath(p);
+            return true;
+        }
+
+        //==============================================================================
+        std::unique_ptr<juce::Drawable> drawable;
+        std::map<juce::String, juce::Drawable*> elements;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EditableDrawable)
+    };
+
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    blueprint_FilmstripView.cpp
+    Created: 15 Oct 2026 8:09:46pm
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    void FilmstripView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        SliderView::setProperty(name, v);
+
+        if (name == IDs::source)
+        {
+            setSource(v.toString());
+        }
+        else if (name == IDs::frameCount)
+        {
+            frameCount = juce::jmax(1, (int) v);
+            intrinsicSizeChanged();
+            repaint();
+        }
+    }
+
+    juce::Rectangle<float> FilmstripView::getNaturalBounds() const
+    {
+        if (!strip.isValid())
+            return {};
+
+        return getFrameArea().withZeroOrigin().toFloat();
+    }
+
+    //==============================================================================
+    void FilmstripView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("FilmstripView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "FilmstripView");
+
+        View::paint(g);
+
+        if (!strip.isValid())
+            return;
+
+        const auto frame = getFrameArea();
+
+        if (frame.isEmpty())
+            return;
+
+        g.drawImage(strip, 0, 0, getWidth(), getHeight(),
+                    frame.getX(), frame.getY(), frame.getWidth(), frame.getHeight());
+    }
+
+    //==============================================================================
+    void FilmstripView::setSource (const juce::String& source)
+    {
+        // Any decode still running for a previous source is now stale.
+        const auto generation = ++sourceGeneration;
+
+        auto d = drawableCache->getCachedDrawable(source);
+
+        if (d == nullptr && drawableCache->shouldDecodeAsync(source))
+        {
+            setStrip(nullptr);
+
+            juce::Component::SafePointer<FilmstripView> safeThis (this);
+
+            drawableCache->getDrawableAsync(source, [safeThis, generation](DrawableCache::DrawableHandle decoded) {
+                if (safeThis != nullptr && safeThis->sourceGeneration == generation)
+                    safeThis->setStrip(std::move(decoded));
+            });
+
+            return;
+        }
+
+        if (d == nullptr)
+            d = drawableCache->getDrawable(source);
+
+        setStrip(std::move(d));
+    }
+
+    void FilmstripView::setStrip (DrawableCache::DrawableHandle d)
+    {
+        drawable = std::move(d);
+
+        // A filmstrip is a raster image; an SVG has no frames to blit.
+        auto* image = dynamic_cast<const juce::DrawableImage*>(drawable.get());
+        jassert (drawable == nullptr || image != nullptr);
+
+        strip = image != nullptr ? image->getImage() : juce::Image();
+
+        intrinsicSizeChanged();
+        repaint();
+    }
+
+    juce::Rectangle<int> FilmstripView::getFrameArea() const
+    {
+        const int frame = juce::jlimit(0, frameCount - 1, juce::roundToInt(getValue() * (frameCount - 1)));
+
+        if (strip.getWidth() > strip.getHeight())
+        {
+            const int frameWidth = strip.getWidth() / frameCount;
+            return { frame * frameWidth, 0, frameWidth, strip.getHeight() };
+        }
+
+        const int frameHeight = strip.getHeight() / frameCount;
+        return { 0, frame * frameHeight, strip.getWidth(), frameHeight };
+    }
+
+}
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    blueprint_FilmstripView.h
+    Created: 15 Oct 2026 8:09:46pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_DrawableCache.h"
+#include "blueprint_SliderView.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The FilmstripView class is a knob or slider skinned with a filmstrip: one
+        pre-rendered image of `frame-count` frames, stacked top to bottom or, for
+        a strip wider than it's tall, left to right.
+
+        It takes its gestures, `value`, `parameter-id` and `onValueChange` from
+        the SliderView, and paints the frame for the value instead of an arc. The
+        strip comes from the shared DrawableCache, so it's decoded once however
+        many knobs show it, and each repaint blits one frame of it, scaled to the
+        view, with nothing to parse or render in between. A `value` bound to a
+        native source with `propertyBindings` moves the knob without JavaScript.
+
+        Left to size itself, the view takes the size of one frame.
+     */
+    class FilmstripView : public SliderView
+    {
+    public:
+        //==============================================================================
+        FilmstripView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        /** Returns the bounds of one frame, or empty ones until the strip loads. */
+        juce::Rectangle<float> getNaturalBounds() const;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+    private:
+        //==============================================================================
+        void setSource (const juce::String& source);
+
+        /** Takes the image of a decoded strip, which must be a raster image. */
+        void setStrip (DrawableCache::DrawableHandle d);
+
+        /** Returns the area of the strip holding the frame for the value. */
+        juce::Rectangle<int> getFrameArea() const;
+
+        //==============================================================================
+        juce::SharedResourcePointer<DrawableCache> drawableCache;
+        DrawableCache::DrawableHandle drawable;
+        juce::Image strip;
+        juce::uint32 sourceGeneration = 0;
+        int frameCount = 1;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilmstripView)
+    };
+
+}
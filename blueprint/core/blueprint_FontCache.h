@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+    blueprint_FontCache.h
+    Created: 14 Oct 2026 2:41:08pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "blueprint_CacheManager.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The FontCache is a process-wide store of the fonts requested by TextViews.
+
+        Constructing a juce::Font from a family name resolves its typeface, which
+        is needlessly expensive to repeat on each measure and paint. The cache hands
+        out shared, immutable fonts keyed by family, size, style and kerning so that
+        every TextView in the process, across every ReactApplicationRoot, shares
+        one instance per distinct font.
+
+        Fonts no view is holding stay cached, within the "fonts" budget of the
+        CacheManager.
+
+        Typefaces which aren't installed, such as a brand font in BinaryData, are
+        registered once per process under a family name with registerTypeface,
+        and serve that family's fonts in every root from then on.
+
+        Hold the cache through a juce::SharedResourcePointer<FontCache>; lookups are
+        safe to make from any thread.
+     */
+    class FontCache : private CacheManager::Cache
+    {
+    public:
+        //==============================================================================
+        using FontHandle = std::shared_ptr<const juce::Font>;
+
+        FontCache() = default;
+
+        //==============================================================================
+        /** Returns the shared font matching the given attributes, creating it if needed.
+
+            An empty family name gives the default sans-serif typeface.
+         */
+        FontHandle getFont (const juce::String& family, float height, int styleFlags, float kerningFactor)
+        {
+            const Key key { family, height, styleFlags, kerningFactor };
+            const juce::ScopedLock sl (lock);
+
+            auto it = fonts.find(key);
+
+            if (it != fonts.end())
+            {
+                it->second.lastUse = ++useCounter;
+                return it->second.font;
+            }
+
+            auto typeface = findRegisteredTypeface(family, styleFlags);
+
+            juce::Font f = typeface != nullptr ? juce::Font (typeface)
+                         : family.isEmpty()    ? juce::Font (height, styleFlags)
+                                               : juce::Font (family, height, styleFlags);
+
+            if (typeface != nullptr)
+                f.setHeight(height);
+
+            f.setExtraKerningFactor(kerningFactor);
+
+            auto handle = std::make_shared<const juce::Font>(f);
+            fonts.emplace(key, Entry { handle, approxFontBytes, ++useCounter });
+
+            if (budget.added(approxFontBytes))
+                trim(budget.budgetBytes);
+
+            return handle;
+        }
+
+        //==============================================================================
+        /** Registers a typeface made from font file data, such as a TTF or OTF in
+            BinaryData, under the given family name and style flags, so that
+            fonts of that family and style use it, in every root. Returns false
+            if the data isn't a font JUCE can load.
+
+            The typeface is made once per process: registering the same family
+            and style again keeps the first. A style with no typeface of its own
+            falls back to the family's regular one, if registered. The data is
+            copied, so needn't outlive the call.
+         */
+        bool registerTypeface (const juce::String& family, const void* data, size_t numBytes, int styleFlags = juce::Font::plain)
+        {
+            jassert (family.isNotEmpty());
+
+            {
+                const juce::ScopedLock sl (lock);
+
+                if (typefaces.count({ family, styleFlags }) > 0)
+                    return true;
+            }
+
+            auto typeface = juce::Typeface::createSystemTypefaceFor(data, numBytes);
+
+            if (typeface == nullptr)
+                return false;
+
+            const juce::ScopedLock sl (lock);
+
+            if (!typefaces.emplace(std::make_pair(family, styleFlags), typeface).second)
+                return true;
+
+            // Fonts of the family made before now resolved it by name; views
+            // still holding them keep them until they next ask.
+            for (auto it = fonts.begin(); it != fonts.end();)
+            {
+                if (it->first.family == family)
+                    it = fonts.erase(it);
+                else
+                    ++it;
+            }
+
+            return true;
+        }
+
+        /** Returns true if a typeface has been registered for the given family. */
+        bool hasRegisteredTypeface (const juce::String& family)
+        {
+            const juce::ScopedLock sl (lock);
+            const auto it = typefaces.lower_bound({ family, 0 });
+
+            return it != typefaces.end() && it->first.first == family;
+        }
+
+        /** Lays out and renders the printable ASCII characters of the given family
+            and style at each of the given sizes, so that the typeface's glyph
+            outlines and the renderer's glyph cache are already warm when text
+            of it first paints. It takes a few milliseconds a size, so is best
+            done off the message thread, as the AssetPreloader does.
+         */
+        void warmGlyphs (const juce::String& family, int styleFlags, const std::vector<float>& sizes)
+        {
+            juce::String ascii;
+
+            for (juce::juce_wchar c = 0x20; c < 0x7f; ++c)
+                ascii += juce::String::charToString(c);
+
+            for (const auto size : sizes)
+            {
+                auto font = getFont(family, size, styleFlags, 0.0f);
+
+                juce::Image scratch (juce::Image::SingleChannel, juce::roundToInt(font->getStringWidthFloat(ascii)) + 4,
+                                     juce::roundToInt(font->getHeight()) + 4, true, juce::SoftwareImageType());
+                juce::Graphics g (scratch);
+                g.setFont(*font);
+                g.drawSingleLineText(ascii, 2, juce::roundToInt(font->getAscent()) + 2);
+            }
+        }
+
+        /** Drops every cached font that no TextView is currently holding. */
+        void purgeUnusedFonts()
+        {
+            const juce::ScopedLock sl (lock);
+            trim(0);
+        }
+
+    private:
+        //==============================================================================
+        struct Key
+        {
+            juce::String family;
+            float height;
+            int styleFlags;
+            float kerningFactor;
+
+            bool operator== (const Key& other) const noexcept
+            {
+                return height == other.height
+                    && styleFlags == other.styleFlags
+                    && kerningFactor == other.kerningFactor
+                    && family == other.family;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator() (const Key& k) const noexcept
+            {
+                size_t h = static_cast<size_t>(k.family.hashCode64());
+
+                h = h * 31 + std::hash<float>()(k.height);
+                h = h * 31 + std::hash<int>()(k.styleFlags);
+                h = h * 31 + std::hash<float>()(k.kerningFactor);
+
+                return h;
+            }
+        };
+
+        struct Entry
+        {
+            FontHandle font;
+            size_t numBytes;
+            juce::uint64 lastUse;
+
+            bool isUnused() const { return font.use_count() == 1; }
+        };
+
+        /** Returns the typeface registered for the family in the given style, or
+            in its regular style, or nullptr. Called with the lock held.
+         */
+        juce::Typeface::Ptr findRegisteredTypeface (const juce::String& family, int styleFlags) const
+        {
+            if (typefaces.empty() || family.isEmpty())
+                return nullptr;
+
+            auto it = typefaces.find({ family, styleFlags });
+
+            if (it == typefaces.end())
+                it = typefaces.find({ family, juce::Font::plain });
+
+            return it != typefaces.end() ? it->second : nullptr;
+        }
+
+        //==============================================================================
+        CacheManager::Stats getCacheStats() override
+        {
+            const juce::ScopedLock sl (lock);
+            CacheManager::Stats stats;
+
+            for (const auto& f : fonts)
+                stats.add(f.second);
+
+            stats.budgetBytes = budget.budgetBytes;
+            return stats;
+        }
+
+        void setCacheBudget (size_t numBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+
+            budget.budgetBytes = numBytes;
+            trim(numBytes);
+        }
+
+        void trimCache (size_t maxUnusedBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+            trim(maxUnusedBytes);
+        }
+
+        void trim (size_t maxUnusedBytes)
+        {
+            CacheManager::LruEviction eviction;
+            eviction.add(fonts);
+            eviction.evictTo(maxUnusedBytes);
+            budget.trimmed();
+        }
+
+        //==============================================================================
+        // A font is small, and its typeface is JUCE's to cache; what we bound is
+        // really the number of fonts left over from animating sizes.
+        static constexpr size_t approxFontBytes = 1024;
+
+        // Enough for any reasonable interface.
+        static constexpr size_t defaultBudgetBytes = 256 * approxFontBytes;
+
+        juce::CriticalSection lock;
+        std::unordered_map<Key, Entry, KeyHash> fonts;
+        std::map<std::pair<juce::String, int>, juce::Typeface::Ptr> typefaces;
+        CacheManager::Budget budget { defaultBudgetBytes };
+        juce::uint64 useCounter = 0;
+
+        CacheManager::Registration registration { "fonts", *this };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FontCache)
+    };
+
+}
@@ -0,0 +1,364 @@
+/*
+  ==============================================================================
+
+    blueprint_FrameScheduler.h
+    Created: 14 Oct 2026 6:03:27pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+
+// juce::VBlankAttachment arrived with JUCE 7; before that we fall back to a timer.
+#ifndef BLUEPRINT_USE_VBLANK_ATTACHMENT
+ #define BLUEPRINT_USE_VBLANK_ATTACHMENT (JUCE_VERSION >= 0x70000)
+#endif
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The FrameScheduler wakes its owner to run JavaScript work, and otherwise
+        sleeps.
+
+        Rather than polling on a fixed interval, the owner asks to be called back
+        after a given delay, and the scheduler sleeps until then. Where JUCE offers
+        a juce::VBlankAttachment, and the component is on screen, callbacks due
+        within the next frame are delivered on the display's vertical blank so that
+        React work lines up with the refresh. Longer sleeps, or an off-screen
+        component, wait on a clock shared by every scheduler in the process.
+
+        The shared clock runs a single juce::Timer for the earliest deadline of
+        all its schedulers, and calls back every scheduler due at each tick in
+        turn, starting one further along each time. Once a tick has spent its
+        budget, the rest wait for the next, a moment later, so that many roots
+        never hold up the message thread together. A scheduler whose component
+        isn't showing is paused: its callback waits until the component shows
+        again, which the clock checks for a few times a second.
+
+        Only the earliest requested wake-up is kept; the owner simply asks again
+        from its callback if there's more work outstanding.
+     */
+    class FrameScheduler
+    {
+    public:
+        //==============================================================================
+        FrameScheduler (juce::Component& _component, std::function<void()> _callback)
+            : component(_component), callback(std::move(_callback))
+        {
+            clock->add(this);
+        }
+
+        ~FrameScheduler()
+        {
+            cancel();
+            clock->remove(this);
+        }
+
+        //==============================================================================
+        /** Requests a callback no sooner than the given delay in milliseconds. */
+        void scheduleAfter (double delayMs)
+        {
+            const double target = now() + juce::jmax(0.0, delayMs);
+
+            if (deadline < 0.0 || target < deadline)
+            {
+                deadline = target;
+                arm();
+            }
+        }
+
+        /** Requests a callback at the next display frame.
+
+            On the vertical blank where we have one, otherwise at the next tick of
+            a nominal 60Hz frame clock. Under a frame rate limit, the callback
+            waits for the first frame a whole interval after the last.
+         */
+        void scheduleFrame()
+        {
+            if (minFrameIntervalMs > 0.0)
+                return scheduleAfter(lastFrameTime + minFrameIntervalMs - now());
+
+#if BLUEPRINT_USE_VBLANK_ATTACHMENT
+            if (component.isShowing())
+                return scheduleAfter(0.0);
+#endif
+
+            scheduleAfter(lastFrameTime + frameIntervalMs - now());
+        }
+
+        /** Limits frame callbacks to the given rate in Hz, or 0 for the display's
+            own rate. Delayed callbacks, such as timers, aren't limited.
+         */
+        void setMaxFrameRate (double hz)
+        {
+            minFrameIntervalMs = hz > 0.0 ? 1000.0 / hz : 0.0;
+        }
+
+        /** Returns the frame rate limit in Hz, or 0 if there's none. */
+        double getMaxFrameRate() const
+        {
+            return minFrameIntervalMs > 0.0 ? 1000.0 / minFrameIntervalMs : 0.0;
+        }
+
+        /** Cancels any pending callback. */
+        void cancel()
+        {
+            deadline = -1.0;
+            stopTimer();
+
+#if BLUEPRINT_USE_VBLANK_ATTACHMENT
+            vblank.reset();
+#endif
+        }
+
+        /** Returns true if a callback is pending. */
+        bool isScheduled() const { return deadline >= 0.0; }
+
+        //==============================================================================
+        /** Sets a function for the shared clock to call at the frame rate, while
+            the component is showing, or nullptr for none. Cheaper than a timer of
+            the owner's own for checking on work which can't wake the scheduler,
+            such as that queued by realtime code.
+         */
+        void setPoll (std::function<void()> newPoll)
+        {
+            poll = std::move(newPoll);
+            clock->update();
+        }
+
+        /** Sets whether callbacks wait while the component isn't showing, which
+            they do by default.
+         */
+        void setPausedWhileHidden (bool shouldPause)
+        {
+            pausedWhileHidden = shouldPause;
+            clock->update();
+        }
+
+        /** Returns true if callbacks are waiting for the component to show, which
+            takes in a minimised window.
+         */
+        bool isPaused() const
+        {
+            return pausedWhileHidden && !component.isShowing();
+        }
+
+    private:
+        //==============================================================================
+        /** The one timer behind every scheduler in the process. */
+        class Clock : private juce::Timer
+        {
+        public:
+            Clock() = default;
+            ~Clock() override { stopTimer(); }
+
+            void add (FrameScheduler* scheduler)
+            {
+                schedulers.push_back(scheduler);
+            }
+
+            void remove (FrameScheduler* scheduler)
+            {
+                const auto it = std::find(schedulers.begin(), schedulers.end(), scheduler);
+
+                if (it != schedulers.end())
+                    schedulers.erase(it);
+
+                update();
+            }
+
+            /** Re-arms the timer for the earliest deadline, or the next poll. */
+            void update()
+            {
+                // Deferred while the tick runs, as it re-arms once it's done.
+                if (isTicking)
+                    return;
+
+                const double current = now();
+                double next = -1.0;
+
+                const auto consider = [&next](double time) {
+                    if (next < 0.0 || time < next)
+                        next = time;
+                };
+
+                for (auto* scheduler : schedulers)
+                {
+                    const bool isWaiting = scheduler->timerDeadline >= 0.0 || scheduler->poll != nullptr;
+
+                    if (isWaiting && scheduler->isPaused())
+                        consider(current + hiddenCheckIntervalMs);
+                    else if (scheduler->timerDeadline >= 0.0)
+                        consider(scheduler->timerDeadline);
+
+                    if (scheduler->poll != nullptr && !scheduler->isPaused())
+                        consider(lastPollTime + frameIntervalMs);
+                }
+
+                if (next < 0.0)
+                    return stopTimer();
+
+                startTimer(juce::jmax(1, (int) std::ceil(next - current)));
+            }
+
+        private:
+            void timerCallback() override
+            {
+                stopTimer();
+                isTicking = true;
+
+                const double start = now();
+                const bool isPollDue = start >= lastPollTime + frameIntervalMs - 1.0;
+
+                if (isPollDue)
+                    lastPollTime = start;
+
+                // A callback may add or remove schedulers, including itself, so we
+                // work from a copy and skip any removed along the way.
+                const auto current = schedulers;
+                const size_t count = current.size();
+                const size_t first = count > 0 ? nextIndex % count : 0;
+                nextIndex = first + 1;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (now() - start >= tickBudgetMs)
+                    {
+                        nextIndex = first + i;
+                        break;
+                    }
+
+                    auto* scheduler = current[(first + i) % count];
+
+                    if (std::find(schedulers.begin(), schedulers.end(), scheduler) == schedulers.end()
+                        || scheduler->isPaused())
+                        continue;
+
+                    if (isPollDue && scheduler->poll != nullptr)
+                        scheduler->poll();
+
+                    if (scheduler->timerDeadline >= 0.0 && scheduler->timerDeadline <= now())
+                        scheduler->timerFired();
+                }
+
+                isTicking = false;
+                update();
+            }
+
+            // Roughly half a frame, leaving the rest to painting.
+            static constexpr double tickBudgetMs = 8.0;
+            static constexpr double hiddenCheckIntervalMs = 250.0;
+
+            std::vector<FrameScheduler*> schedulers;
+            size_t nextIndex = 0;
+            double lastPollTime = 0.0;
+            bool isTicking = false;
+        };
+
+        //==============================================================================
+        static double now() { return juce::Time::getMillisecondCounterHiRes(); }
+
+        // We don't know the display's actual refresh rate here, so we assume 60Hz
+        // when deciding whether a deadline falls within the next frame.
+        static constexpr double frameIntervalMs = 1000.0 / 60.0;
+
+        void startTimer (int delayMs)
+        {
+            timerDeadline = now() + delayMs;
+            clock->update();
+        }
+
+        void stopTimer()
+        {
+            if (timerDeadline < 0.0)
+                return;
+
+            timerDeadline = -1.0;
+            clock->update();
+        }
+
+        void arm()
+        {
+            const double delay = deadline - now();
+
+#if BLUEPRINT_USE_VBLANK_ATTACHMENT
+            if (component.isShowing())
+            {
+                if (delay <= frameIntervalMs)
+                {
+                    stopTimer();
+
+                    if (vblank == nullptr)
+                        vblank = std::make_unique<juce::VBlankAttachment>(&component, [this]() { vblankCallback(); });
+
+                    return;
+                }
+
+                // Sleep until just before the frame in which the deadline falls,
+                // then re-arm onto the vertical blank.
+                vblank.reset();
+                startTimer(juce::jmax(1, (int) (delay - frameIntervalMs)));
+                return;
+            }
+
+            vblank.reset();
+#endif
+
+            startTimer(juce::jmax(1, (int) std::ceil(delay)));
+        }
+
+        void timerFired()
+        {
+            timerDeadline = -1.0;
+
+#if BLUEPRINT_USE_VBLANK_ATTACHMENT
+            if (component.isShowing() && deadline - now() > 0.0)
+                return arm();
+#endif
+
+            fire();
+        }
+
+#if BLUEPRINT_USE_VBLANK_ATTACHMENT
+        void vblankCallback()
+        {
+            if (now() >= deadline - 1.0)
+                fire();
+        }
+#endif
+
+        void fire()
+        {
+            cancel();
+            lastFrameTime = now();
+            callback();
+        }
+
+        //==============================================================================
+        juce::SharedResourcePointer<Clock> clock;
+
+        juce::Component& component;
+        std::function<void()> callback;
+        std::function<void()> poll;
+        double deadline = -1.0;
+        double timerDeadline = -1.0;
+        double lastFrameTime = 0.0;
+        double minFrameIntervalMs = 0.0;
+        bool pausedWhileHidden = true;
+
+#if BLUEPRINT_USE_VBLANK_ATTACHMENT
+        std::unique_ptr<juce::VBlankAttachment> vblank;
+#endif
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrameScheduler)
+    };
+
+}
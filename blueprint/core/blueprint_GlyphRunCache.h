@@ -0,0 +1,352 @@
+/*
+  ==============================================================================
+
+    blueprint_GlyphRunCache.h
+    Created: 15 Oct 2026 8:47:52am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+#include "blueprint_FontCache.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The GlyphRunCache is a process-wide store of the glyphs of single lines of
+        text, shaped and positioned, for TextViews to paint without laying their
+        text out again.
+
+        Labels showing a live value cycle through a small set of strings, and
+        each new string would otherwise be shaped afresh by a TextLayout. Runs
+        are keyed by the text and the shared font from the FontCache, and
+        handed out as shared, immutable GlyphArrangements.
+
+        For text drawn often enough that rasterizing its glyphs shows up too,
+        the cache also renders glyph atlases: every printable ASCII character of
+        a font, rendered once at a given display scale, so that a run of those
+        characters paints as a blit per glyph.
+
+        Runs and atlases no view is holding stay cached, within the "glyphs"
+        budget of the CacheManager.
+
+        Hold the cache through a juce::SharedResourcePointer<GlyphRunCache>;
+        lookups are safe to make from any thread.
+     */
+    class GlyphRunCache : private CacheManager::Cache
+    {
+    public:
+        //==============================================================================
+        /** A line of text, shaped with its baseline at the font's ascent, so that
+            the run fills the box from the origin to its width and height.
+         */
+        struct GlyphRun
+        {
+            juce::GlyphArrangement glyphs;
+            float width = 0.0f;
+            float height = 0.0f;
+
+            // True if every visible glyph is in a glyph atlas.
+            bool atlasCharactersOnly = false;
+        };
+
+        /** A font's printable ASCII characters, rendered at a given scale into a
+            single channel image.
+         */
+        struct GlyphAtlas
+        {
+            struct Cell
+            {
+                // A clip of the atlas image, sharing its pixels.
+                juce::Image image;
+
+                // From the cell's top left to the glyph's origin on its
+                // baseline, in physical pixels.
+                juce::Point<float> origin;
+            };
+
+            const Cell& getCell (juce::juce_wchar c) const { return cells[static_cast<size_t>(c - firstCharacter)]; }
+
+            juce::Image image;
+            float scale = 1.0f;
+            std::array<Cell, 0x7f - 0x20> cells;
+        };
+
+        using GlyphRunHandle = std::shared_ptr<const GlyphRun>;
+        using GlyphAtlasHandle = std::shared_ptr<const GlyphAtlas>;
+
+        GlyphRunCache() = default;
+
+        //==============================================================================
+        /** Returns the shared glyph run of the given line of text in the given font,
+            shaping it if needed.
+         */
+        GlyphRunHandle getGlyphRun (const juce::String& text, const FontCache::FontHandle& font)
+        {
+            jassert (font != nullptr);
+
+            const RunKey key { text, font.get() };
+            const juce::ScopedLock sl (lock);
+
+            auto it = runs.find(key);
+
+            if (it != runs.end())
+            {
+                it->second.lastUse = ++useCounter;
+                return it->second.run;
+            }
+
+            auto run = std::make_shared<GlyphRun>();
+            run->glyphs.addLineOfText(*font, text, 0.0f, font->getAscent());
+            run->width = run->glyphs.getBoundingBox(0, -1, true).getRight();
+            run->height = font->getHeight();
+            run->atlasCharactersOnly = true;
+
+            for (auto& glyph : run->glyphs)
+                if (!glyph.isWhitespace() && !isAtlasCharacter(glyph.getCharacter()))
+                    run->atlasCharactersOnly = false;
+
+            const size_t numBytes = sizeof(GlyphRun) + static_cast<size_t>(run->glyphs.getNumGlyphs()) * sizeof(juce::PositionedGlyph);
+            GlyphRunHandle handle (std::move(run));
+
+            // The entry holds the font too, so that its address can't be reused
+            // for another font while we key on it.
+            runs.emplace(key, RunEntry { font, handle, numBytes, ++useCounter });
+
+            if (budget.added(numBytes))
+                trim(budget.budgetBytes);
+
+            return handle;
+        }
+
+        /** Returns the shared glyph atlas of the given font at the given scale,
+            rendering it if needed.
+         */
+        GlyphAtlasHandle getGlyphAtlas (const FontCache::FontHandle& font, float scale)
+        {
+            jassert (font != nullptr && scale > 0.0f);
+
+            const AtlasKey key { font.get(), scale };
+            const juce::ScopedLock sl (lock);
+
+            auto it = atlases.find(key);
+
+            if (it != atlases.end())
+            {
+                it->second.lastUse = ++useCounter;
+                return it->second.atlas;
+            }
+
+            GlyphAtlasHandle handle (renderAtlas(*font, scale));
+            const size_t numBytes = sizeof(GlyphAtlas) + static_cast<size_t>(handle->image.getWidth() * handle->image.getHeight());
+            atlases.emplace(key, AtlasEntry { font, handle, numBytes, ++useCounter });
+
+            if (budget.added(numBytes))
+                trim(budget.budgetBytes);
+
+            return handle;
+        }
+
+        /** Returns true if the font has a glyph atlas at some other scale, but
+            none yet at the given one, as after a change of display scale.
+         */
+        bool needsGlyphAtlasAtNewScale (const FontCache::FontHandle& font, float scale)
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (atlases.count(AtlasKey { font.get(), scale }) > 0)
+                return false;
+
+            for (const auto& a : atlases)
+                if (a.first.font == font.get())
+                    return true;
+
+            return false;
+        }
+
+        /** Returns true if glyph atlases hold the given character. */
+        static bool isAtlasCharacter (juce::juce_wchar c)
+        {
+            return c >= firstCharacter && c < endCharacter;
+        }
+
+        /** Drops every cached run and atlas that no TextView is currently holding. */
+        void purgeUnused()
+        {
+            const juce::ScopedLock sl (lock);
+            trim(0);
+        }
+
+    private:
+        //==============================================================================
+        struct RunKey
+        {
+            juce::String text;
+            const juce::Font* font;
+
+            bool operator== (const RunKey& other) const noexcept
+            {
+                return font == other.font && text == other.text;
+            }
+        };
+
+        struct AtlasKey
+        {
+            const juce::Font* font;
+            float scale;
+
+            bool operator== (const AtlasKey& other) const noexcept
+            {
+                return font == other.font && scale == other.scale;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator() (const RunKey& k) const noexcept
+            {
+                return static_cast<size_t>(k.text.hashCode64()) * 31 + std::hash<const void*>()(k.font);
+            }
+
+            size_t operator() (const AtlasKey& k) const noexcept
+            {
+                return std::hash<const void*>()(k.font) * 31 + std::hash<float>()(k.scale);
+            }
+        };
+
+        struct RunEntry
+        {
+            FontCache::FontHandle font;
+            GlyphRunHandle run;
+            size_t numBytes;
+            juce::uint64 lastUse;
+
+            bool isUnused() const { return run.use_count() == 1; }
+        };
+
+        struct AtlasEntry
+        {
+            FontCache::FontHandle font;
+            GlyphAtlasHandle atlas;
+            size_t numBytes;
+            juce::uint64 lastUse;
+
+            bool isUnused() const { return atlas.use_count() == 1; }
+        };
+
+        //==============================================================================
+        CacheManager::Stats getCacheStats() override
+        {
+            const juce::ScopedLock sl (lock);
+            CacheManager::Stats stats;
+
+            for (const auto& r : runs)
+                stats.add(r.second);
+
+            for (const auto& a : atlases)
+                stats.add(a.second);
+
+            stats.budgetBytes = budget.budgetBytes;
+            return stats;
+        }
+
+        void setCacheBudget (size_t numBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+
+            budget.budgetBytes = numBytes;
+            trim(numBytes);
+        }
+
+        void trimCache (size_t maxUnusedBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+            trim(maxUnusedBytes);
+        }
+
+        /** Evicts the least recently used runs and atlases, together. */
+        void trim (size_t maxUnusedBytes)
+        {
+            CacheManager::LruEviction eviction;
+            eviction.add(runs);
+            eviction.add(atlases);
+            eviction.evictTo(maxUnusedBytes);
+            budget.trimmed();
+        }
+
+        static std::shared_ptr<GlyphAtlas> renderAtlas (const juce::Font& font, float scale)
+        {
+            auto atlas = std::make_shared<GlyphAtlas>();
+            atlas->scale = scale;
+
+            // Every cell is as big as the widest glyph, ink overhang included,
+            // with a pixel or two of room around it for the antialiasing.
+            float minLeft = 0.0f;
+            float maxRight = 0.0f;
+
+            for (juce::juce_wchar c = firstCharacter; c < endCharacter; ++c)
+            {
+                juce::GlyphArrangement glyph;
+                glyph.addLineOfText(font, juce::String::charToString(c), 0.0f, 0.0f);
+
+                const auto bounds = glyph.getBoundingBox(0, -1, true);
+                minLeft = juce::jmin(minLeft, bounds.getX());
+                maxRight = juce::jmax(maxRight, bounds.getRight());
+            }
+
+            const int padding = 2;
+            const int cellWidth = (int) std::ceil((maxRight - minLeft) * scale) + padding * 2;
+            const int cellHeight = (int) std::ceil(font.getHeight() * scale) + padding * 2;
+            const int columns = 16;
+            const int rows = ((int) atlas->cells.size() + columns - 1) / columns;
+
+            atlas->image = juce::Image(juce::Image::SingleChannel, cellWidth * columns, cellHeight * rows, true);
+
+            juce::Graphics g (atlas->image);
+            g.setColour(juce::Colours::white);
+            g.setFont(font);
+
+            for (size_t i = 0; i < atlas->cells.size(); ++i)
+            {
+                const juce::Rectangle<int> cellArea ((int) (i % columns) * cellWidth, (int) (i / columns) * cellHeight, cellWidth, cellHeight);
+                const juce::Point<float> origin (padding - minLeft * scale, padding + font.getAscent() * scale);
+
+                juce::Graphics::ScopedSaveState state (g);
+                g.reduceClipRegion(cellArea);
+                g.addTransform(juce::AffineTransform::scale(scale).translated(cellArea.getPosition().toFloat() + origin));
+                g.drawSingleLineText(juce::String::charToString(firstCharacter + (juce::juce_wchar) i), 0, 0);
+
+                atlas->cells[i] = { atlas->image.getClippedImage(cellArea), origin };
+            }
+
+            return atlas;
+        }
+
+        //==============================================================================
+        static constexpr juce::juce_wchar firstCharacter = 0x20;
+        static constexpr juce::juce_wchar endCharacter = 0x7f;
+
+        // A few thousand strings covers the readouts of a busy interface, with
+        // an atlas for each font and display scale in use.
+        static constexpr size_t defaultBudgetBytes = 8 * 1024 * 1024;
+
+        juce::CriticalSection lock;
+        std::unordered_map<RunKey, RunEntry, KeyHash> runs;
+        std::unordered_map<AtlasKey, AtlasEntry, KeyHash> atlases;
+        CacheManager::Budget budget { defaultBudgetBytes };
+        juce::uint64 useCounter = 0;
+
+        CacheManager::Registration registration { "glyphs", *this };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphRunCache)
+    };
+
+}
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    blueprint_HeapCensus.h
+    Created: 15 Oct 2026 10:27:45pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A count of what a Duktape heap holds, grouped by kind: objects by their
+        constructor's name, as "FiberNode" or "ParameterStore", or failing that by
+        their class, as "Object" or "Array", and then functions, environment
+        records, buffers and strings each as a group of their own.
+
+        Each group has the number of its members and their approximate size, the
+        allocations Duktape makes for each, its header and property table or
+        data, as duk_inspect_value counts them. Two censuses, taken before and
+        after opening a few editors, say, compare with `compareTo` to show which
+        groups grew. The HeapMeter says how big the heap is; this says what of.
+
+        Take one with `takeHeapCensus`, or from JavaScript with
+        `__BlueprintNative__.getHeapCensus()`.
+     */
+    class HeapCensus
+    {
+    public:
+        //==============================================================================
+        struct Group
+        {
+            juce::int64 count = 0;
+            juce::int64 bytes = 0;
+        };
+
+        //==============================================================================
+        HeapCensus() = default;
+
+        /** Counts a member of the named group. */
+        void add (const juce::String& name, size_t numBytes)
+        {
+            auto& group = groups[name];
+            group.count++;
+            group.bytes += static_cast<juce::int64>(numBytes);
+        }
+
+        //==============================================================================
+        /** Returns the groups, by name. */
+        const std::map<juce::String, Group>& getGroups() const { return groups; }
+
+        /** Returns the counts and bytes of every group added up. */
+        Group getTotal() const
+        {
+            Group total;
+
+            for (const auto& g : groups)
+            {
+                total.count += g.second.count;
+                total.bytes += g.second.bytes;
+            }
+
+            return total;
+        }
+
+        /** Returns how each group changed since the given earlier census, leaving
+            out those which didn't. Counts and bytes are negative for groups
+            which shrank.
+         */
+        HeapCensus compareTo (const HeapCensus& earlier) const
+        {
+            HeapCensus difference;
+
+            for (const auto& g : groups)
+                difference.groups[g.first] = g.second;
+
+            for (const auto& g : earlier.groups)
+            {
+                auto& d = difference.groups[g.first];
+                d.count -= g.second.count;
+                d.bytes -= g.second.bytes;
+            }
+
+            for (auto it = difference.groups.begin(); it != difference.groups.end();)
+            {
+                if (it->second.count == 0 && it->second.bytes == 0)
+                    it = difference.groups.erase(it);
+                else
+                    ++it;
+            }
+
+            return difference;
+        }
+
+        //==============================================================================
+        /** Returns the census as an object of { count, bytes } by group name. */
+        juce::var toVar() const
+        {
+            auto* result = new juce::DynamicObject();
+
+            for (const auto& g : groups)
+            {
+                auto* group = new juce::DynamicObject();
+                group->setProperty("count", g.second.count);
+                group->setProperty("bytes", g.second.bytes);
+                result->setProperty(juce::Identifier(g.first), juce::var(group));
+            }
+
+            return juce::var(result);
+        }
+
+        /** Returns a table of the largest groups, by bytes, for logging. */
+        juce::String toString (int maxGroups = 30) const
+        {
+            std::vector<std::pair<juce::String, Group>> sorted (groups.begin(), groups.end());
+
+            std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+                return std::abs(a.second.bytes) > std::abs(b.second.bytes);
+            });
+
+            juce::String s;
+
+            for (int i = 0; i < juce::jmin(maxGroups, (int) sorted.size()); ++i)
+            {
+                const auto& g = sorted[static_cast<size_t>(i)];
+                s << juce::String(g.second.bytes).paddedLeft(' ', 12) << " bytes "
+                  << juce::String(g.second.count).paddedLeft(' ', 8) << "  " << g.first << juce::newLine;
+            }
+
+            return s;
+        }
+
+    private:
+        //==============================================================================
+        std::map<juce::String, Group> groups;
+    };
+
+    /** Takes a census of the given heap. It allocates nothing in the heap, so no
+        collection runs meanwhile. Call on the thread the engine runs on, or
+        while it's idle.
+     */
+    HeapCensus takeHeapCensus (duk_context* ctx);
+
+}
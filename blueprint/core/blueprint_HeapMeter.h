@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+    blueprint_HeapMeter.h
+    Created: 15 Oct 2026 3:47:13pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+
+#include "blueprint_DuktapeAllocator.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Counts what a Duktape heap holds, so that a host with many roots can see
+        and budget each one's memory.
+
+        The meter sits between the heap and its allocator, a DuktapeAllocator or
+        else the system allocator, and keeps count of the bytes the heap holds,
+        their peak, and the allocations made. With a limit set, an allocation
+        which would take the heap past it fails: Duktape then collects garbage
+        and tries again and, failing that, throws a RangeError from the script.
+        A warning threshold below the limit gives the host a chance to act
+        before that happens.
+
+        A meter serves a single heap at a time, and must outlive it. Its figures
+        may be read from any thread.
+     */
+    class HeapMeter
+    {
+    public:
+        //==============================================================================
+        struct Stats
+        {
+            size_t liveBytes = 0;
+            size_t peakBytes = 0;
+            juce::uint64 numAllocations = 0;
+
+            // Allocations refused for the limit.
+            juce::uint64 numRefusals = 0;
+        };
+
+        /** Called when the heap crosses the warning threshold, and whenever an
+            allocation is refused for the limit. It runs inside the allocator, on
+            the engine's thread, so it mustn't call back into the root or the
+            Duktape context.
+         */
+        typedef std::function<void (const Stats&)> WarningCallback;
+
+        struct Options
+        {
+            /** The most bytes the heap may hold. */
+            size_t limitBytes = std::numeric_limits<size_t>::max();
+
+            /** The bytes past which the warning callback is called, once each time
+                the heap grows past them.
+             */
+            size_t warningBytes = std::numeric_limits<size_t>::max();
+
+            WarningCallback onWarning;
+        };
+
+        //==============================================================================
+        HeapMeter() = default;
+
+        ~HeapMeter()
+        {
+            // If you hit this, the heap using this meter is still alive.
+            jassert (liveBytes == 0);
+        }
+
+        //==============================================================================
+        /** Creates a Duktape heap counted by this meter, which allocates from the
+            given allocator, or from the system allocator if none is given.
+         */
+        duk_context* createHeap (DuktapeAllocator* allocator = nullptr, duk_fatal_function fatalHandler = nullptr)
+        {
+            jassert (liveBytes == 0);
+
+            inner = allocator;
+            peakBytes = 0;
+            numAllocations = 0;
+            numRefusals = 0;
+            warned = false;
+
+            return duk_create_heap(allocate, reallocate, release, this, fatalHandler);
+        }
+
+        /** Sets the limit and the warning threshold. Call on the thread the
+            engine runs on, or while it's idle.
+         */
+        void setOptions (const Options& newOptions) { options = newOptions; }
+        const Options& getOptions() const { return options; }
+
+        /** Returns the heap's figures so far. */
+        Stats getStats() const
+        {
+            Stats stats;
+            stats.liveBytes = liveBytes.load(std::memory_order_relaxed);
+            stats.peakBytes = peakBytes.load(std::memory_order_relaxed);
+            stats.numAllocations = numAllocations.load(std::memory_order_relaxed);
+            stats.numRefusals = numRefusals.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        //==============================================================================
+        // Blocks from the system allocator carry their size in front of them, as
+        // with the DuktapeAllocator's own.
+        static constexpr size_t systemHeaderSize = 16;
+
+        size_t getBlockSize (void* ptr) const
+        {
+            if (inner != nullptr)
+                return inner->getBlockSize(ptr);
+
+            return *reinterpret_cast<size_t*>(static_cast<char*>(ptr) - systemHeaderSize);
+        }
+
+        /** Returns true if the heap may grow by the given number of bytes. */
+        bool mayGrowBy (size_t numBytes)
+        {
+            if (numBytes <= options.limitBytes - juce::jmin(options.limitBytes, liveBytes.load(std::memory_order_relaxed)))
+                return true;
+
+            numRefusals++;
+
+            if (options.onWarning)
+                options.onWarning(getStats());
+
+            return false;
+        }
+
+        void added (size_t numBytes)
+        {
+            const auto live = liveBytes.load(std::memory_order_relaxed) + numBytes;
+            liveBytes.store(live, std::memory_order_relaxed);
+
+            if (live > peakBytes.load(std::memory_order_relaxed))
+                peakBytes.store(live, std::memory_order_relaxed);
+
+            if (live > options.warningBytes && !warned)
+            {
+                warned = true;
+
+                if (options.onWarning)
+                    options.onWarning(getStats());
+            }
+        }
+
+        void removed (size_t numBytes)
+        {
+            const auto live = liveBytes.load(std::memory_order_relaxed) - numBytes;
+            liveBytes.store(live, std::memory_order_relaxed);
+
+            // Warn again only once the heap has come back down by a margin, so as
+            // not to warn at every allocation around the threshold.
+            if (warned && live < options.warningBytes - options.warningBytes / 8)
+                warned = false;
+        }
+
+        //==============================================================================
+        void* allocateBlock (size_t size)
+        {
+            if (!mayGrowBy(size))
+                return nullptr;
+
+            void* ptr = nullptr;
+
+            if (inner != nullptr)
+            {
+                ptr = inner->allocateBlock(size);
+            }
+            else if (auto* raw = static_cast<char*>(std::malloc(size + systemHeaderSize)))
+            {
+                *reinterpret_cast<size_t*>(raw) = size;
+                ptr = raw + systemHeaderSize;
+            }
+
+            if (ptr != nullptr)
+            {
+                numAllocations++;
+                added(getBlockSize(ptr));
+            }
+
+            return ptr;
+        }
+
+        void* reallocateBlock (void* ptr, size_t size)
+        {
+            if (ptr == nullptr)
+                return allocateBlock(size);
+
+            if (size == 0)
+            {
+                releaseBlock(ptr);
+                return nullptr;
+            }
+
+            const size_t oldSize = getBlockSize(ptr);
+
+            if (size > oldSize && !mayGrowBy(size - oldSize))
+                return nullptr;
+
+            void* newPtr = nullptr;
+
+            if (inner != nullptr)
+            {
+                newPtr = inner->reallocateBlock(ptr, size);
+            }
+            else if (auto* raw = static_cast<char*>(std::realloc(static_cast<char*>(ptr) - systemHeaderSize, size + systemHeaderSize)))
+            {
+                *reinterpret_cast<size_t*>(raw) = size;
+                newPtr = raw + systemHeaderSize;
+            }
+
+            if (newPtr != nullptr)
+            {
+                numAllocations++;
+                removed(oldSize);
+                added(getBlockSize(newPtr));
+            }
+
+            return newPtr;
+        }
+
+        void releaseBlock (void* ptr)
+        {
+            if (ptr == nullptr)
+                return;
+
+            removed(getBlockSize(ptr));
+
+            if (inner != nullptr)
+                inner->releaseBlock(ptr);
+            else
+                std::free(static_cast<char*>(ptr) - systemHeaderSize);
+        }
+
+        //==============================================================================
+        static void* allocate (void* udata, duk_size_t size)
+        {
+            return size == 0 ? nullptr : static_cast<HeapMeter*>(udata)->allocateBlock(size);
+        }
+
+        static void* reallocate (void* udata, void* ptr, duk_size_t size)
+        {
+            return static_cast<HeapMeter*>(udata)->reallocateBlock(ptr, size);
+        }
+
+        static void release (void* udata, void* ptr)
+        {
+            static_cast<HeapMeter*>(udata)->releaseBlock(ptr);
+        }
+
+        //==============================================================================
+        Options options;
+        DuktapeAllocator* inner = nullptr;
+
+        // Written only by the engine's thread.
+        std::atomic<size_t> liveBytes { 0 };
+        std::atomic<size_t> peakBytes { 0 };
+        std::atomic<juce::uint64> numAllocations { 0 };
+        std::atomic<juce::uint64> numRefusals { 0 };
+        bool warned = false;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HeapMeter)
+    };
+
+}
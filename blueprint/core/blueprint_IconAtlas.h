@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+    blueprint_IconAtlas.h
+    Created: 15 Oct 2026 7:58:04pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "blueprint_DrawableCache.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The IconAtlas is a process-wide store of small drawables rendered once, at
+        the display's scale, into a few large shared images.
+
+        An interface with a couple of hundred icons would otherwise keep a
+        rendered image per ImageView, each its own allocation and, through an
+        OpenGL context, its own texture. The atlas instead packs every icon, at
+        the pixel size and placement it's shown at, onto shelves of a page
+        image, so that icons painted together read from the same memory and
+        draw with the same texture.
+
+        Icons are keyed by the shared drawable from the DrawableCache, their
+        pixel size and placement, so views showing the same icon at the same
+        size share a slot. A slot lives for as long as a view holds it; a page
+        whose icons are all released is cleared for reuse, and anything bigger
+        than `maxIconPixels` on a side isn't packed at all. Pages kept for reuse
+        are bounded by the "icons" budget of the CacheManager; they hold nothing
+        worth keeping, so which go first doesn't matter.
+
+        Hold the atlas through a juce::SharedResourcePointer<IconAtlas>; lookups
+        are safe to make from any thread.
+     */
+    class IconAtlas : private CacheManager::Cache
+    {
+    public:
+        //==============================================================================
+        /** An icon's slot: where it sits in which page image. */
+        struct Icon
+        {
+            // The whole page, so that every icon on it shares one texture.
+            juce::Image page;
+            juce::Rectangle<int> area;
+            float scale = 1.0f;
+
+            // Held so that the drawable's address, which keys the slot, can't
+            // be reused for another drawable while the slot is alive.
+            DrawableCache::DrawableHandle drawable;
+        };
+
+        using IconHandle = std::shared_ptr<const Icon>;
+
+        /** Renders an icon's content, at full opacity, into the given graphics,
+            already scaled to the display so that its coordinates are the view's.
+         */
+        using PaintFn = std::function<void (juce::Graphics&)>;
+
+        IconAtlas() = default;
+
+        //==============================================================================
+        /** Returns the shared slot for the given drawable, shown in an area of the
+            given size at the given scale and placement, rendering it with
+            `paintContent` the first time. Returns nullptr for an icon too big to
+            pack, which the caller should paint itself.
+         */
+        IconHandle getIcon (const DrawableCache::DrawableHandle& drawable,
+                            juce::Rectangle<int> area,
+                            float scale,
+                            int placementFlags,
+                            const PaintFn& paintContent)
+        {
+            jassert (drawable != nullptr && scale > 0.0f);
+
+            const int width = juce::roundToInt(area.getWidth() * scale);
+            const int height = juce::roundToInt(area.getHeight() * scale);
+
+            if (width <= 0 || height <= 0 || width > maxIconPixels || height > maxIconPixels)
+                return nullptr;
+
+            const Key key { drawable.get(), width, height, placementFlags };
+            const juce::ScopedLock sl (lock);
+
+            auto it = icons.find(key);
+
+            if (it != icons.end())
+            {
+                if (auto icon = it->second.lock())
+                    return icon;
+
+                icons.erase(it);
+            }
+
+            auto icon = std::make_shared<Icon>();
+            icon->scale = scale;
+            icon->drawable = drawable;
+
+            if (!allocate(width, height, *icon))
+                return nullptr;
+
+            // The slot may have held an icon since released.
+            icon->page.clear(icon->area);
+
+            {
+                juce::Graphics g (icon->page);
+                g.reduceClipRegion(icon->area);
+                g.setOrigin(icon->area.getPosition());
+                g.addTransform(juce::AffineTransform::scale(scale));
+                paintContent(g);
+            }
+
+            IconHandle handle (std::move(icon));
+            icons[key] = handle;
+            return handle;
+        }
+
+        /** Paints an icon into the given area of the view at the given opacity. */
+        static void draw (juce::Graphics& g, const Icon& icon, juce::Rectangle<int> area, float opacity)
+        {
+            juce::Graphics::ScopedSaveState state (g);
+
+            // Drawing a clip of the page image, rather than a subsection of it,
+            // keeps it one texture for an OpenGL context.
+            g.reduceClipRegion(area);
+            g.setOpacity(opacity);
+            g.drawImageTransformed(icon.page, juce::AffineTransform::translation((float) -icon.area.getX(), (float) -icon.area.getY())
+                                                  .scaled(1.0f / icon.scale)
+                                                  .translated((float) area.getX(), (float) area.getY()));
+        }
+
+        /** Returns the number of pages, and the bytes their pixels take. */
+        size_t getNumPages (size_t* totalBytes = nullptr)
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (totalBytes != nullptr)
+                *totalBytes = pages.size() * pageBytes;
+
+            return pages.size();
+        }
+
+    private:
+        //==============================================================================
+        struct Key
+        {
+            const juce::Drawable* drawable;
+            int width;
+            int height;
+            int placement;
+
+            bool operator== (const Key& other) const noexcept
+            {
+                return drawable == other.drawable && width == other.width
+                    && height == other.height && placement == other.placement;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator() (const Key& k) const noexcept
+            {
+                return ((std::hash<const void*>()(k.drawable) * 31 + static_cast<size_t>(k.width)) * 31
+                            + static_cast<size_t>(k.height)) * 31 + static_cast<size_t>(k.placement);
+            }
+        };
+
+        /** A row of a page, as tall as its tallest icon, filled left to right. */
+        struct Shelf
+        {
+            int y;
+            int height;
+            int nextX;
+        };
+
+        struct Page
+        {
+            juce::Image image;
+            float scale;
+            std::vector<Shelf> shelves;
+            int nextY = 0;
+        };
+
+        //==============================================================================
+        /** Finds room for an icon of the given size on a page of its scale, making
+            a new page, or clearing one nobody uses, if there isn't any.
+         */
+        bool allocate (int width, int height, Icon& icon)
+        {
+            const int paddedWidth = width + padding;
+            const int paddedHeight = height + padding;
+
+            for (auto& page : pages)
+                if (page.scale == icon.scale && allocateOnPage(page, paddedWidth, paddedHeight, icon))
+                    return true;
+
+            if (auto* unused = findUnusedPage())
+            {
+                unused->image.clear(unused->image.getBounds());
+                unused->scale = icon.scale;
+                unused->shelves.clear();
+                unused->nextY = 0;
+
+                return allocateOnPage(*unused, paddedWidth, paddedHeight, icon);
+            }
+
+            if (pages.size() >= maxPages)
+                return false;
+
+            pages.push_back({ juce::Image(juce::Image::ARGB, pageSize, pageSize, true), icon.scale, {}, 0 });
+            return allocateOnPage(pages.back(), paddedWidth, paddedHeight, icon);
+        }
+
+        static bool allocateOnPage (Page& page, int width, int height, Icon& icon)
+        {
+            // The shortest shelf the icon fits on wastes the least space.
+            Shelf* best = nullptr;
+
+            for (auto& shelf : page.shelves)
+                if (shelf.height >= height && pageSize - shelf.nextX >= width && (best == nullptr || shelf.height < best->height))
+                    best = &shelf;
+
+            if (best == nullptr)
+            {
+                if (pageSize - page.nextY < height)
+                    return false;
+
+                page.shelves.push_back({ page.nextY, height, 0 });
+                page.nextY += height;
+                best = &page.shelves.back();
+            }
+
+            icon.page = page.image;
+            icon.area = { best->nextX, best->y, width - padding, height - padding };
+            best->nextX += width;
+
+            return true;
+        }
+
+        /** Returns a page none of whose icons is still held, dropping their entries. */
+        Page* findUnusedPage()
+        {
+            const auto inUse = findPagesInUse();
+
+            for (auto& page : pages)
+                if (inUse.count(page.image.getPixelData()) == 0)
+                    return &page;
+
+            return nullptr;
+        }
+
+        /** Returns the pixels of the pages with icons still held, dropping the
+            entries of those released.
+         */
+        std::unordered_map<const juce::ImagePixelData*, size_t> findPagesInUse()
+        {
+            std::unordered_map<const juce::ImagePixelData*, size_t> inUse;
+
+            for (auto it = icons.begin(); it != icons.end();)
+            {
+                if (auto icon = it->second.lock())
+                {
+                    ++inUse[icon->page.getPixelData()];
+                    ++it;
+                }
+                else
+                {
+                    it = icons.erase(it);
+                }
+            }
+
+            return inUse;
+        }
+
+        //==============================================================================
+        CacheManager::Stats getCacheStats() override
+        {
+            const juce::ScopedLock sl (lock);
+            const auto inUse = findPagesInUse();
+            CacheManager::Stats stats;
+
+            for (auto& page : pages)
+            {
+                const auto it = inUse.find(page.image.getPixelData());
+
+                stats.numEntries += it != inUse.end() ? it->second : 0;
+                stats.numBytes += pageBytes;
+                stats.unusedBytes += it != inUse.end() ? 0 : pageBytes;
+            }
+
+            stats.budgetBytes = budgetBytes;
+            return stats;
+        }
+
+        void setCacheBudget (size_t numBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+
+            budgetBytes = numBytes;
+            trim(numBytes);
+        }
+
+        void trimCache (size_t maxUnusedBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+            trim(maxUnusedBytes);
+        }
+
+        /** Frees unused pages until those left take no more than the given bytes. */
+        void trim (size_t maxUnusedBytes)
+        {
+            const auto inUse = findPagesInUse();
+            size_t unusedBytes = 0;
+
+            for (auto& page : pages)
+                if (inUse.count(page.image.getPixelData()) == 0)
+                    unusedBytes += pageBytes;
+
+            for (auto it = pages.end(); unusedBytes > maxUnusedBytes && it != pages.begin();)
+            {
+                --it;
+
+                if (inUse.count(it->image.getPixelData()) != 0)
+                    continue;
+
+                unusedBytes -= pageBytes;
+                it = pages.erase(it);
+            }
+        }
+
+        //==============================================================================
+        // A 1024 pixel page holds a couple of hundred 48 pixel icons at 2x.
+        static constexpr int pageSize = 1024;
+        static constexpr int maxIconPixels = 256;
+        static constexpr size_t maxPages = 16;
+        static constexpr size_t pageBytes = static_cast<size_t>(pageSize * pageSize * 4);
+
+        // Room to reuse on a page or two, rather than allocate one, as editors
+        // come and go.
+        static constexpr size_t defaultBudgetBytes = 2 * pageBytes;
+
+        // A pixel between icons, so that filtering at a fractional position
+        // never bleeds a neighbour in.
+        static constexpr int padding = 1;
+
+        juce::CriticalSection lock;
+        std::vector<Page> pages;
+        std::unordered_map<Key, std::weak_ptr<const Icon>, KeyHash> icons;
+        size_t budgetBytes = defaultBudgetBytes;
+
+        CacheManager::Registration registration { "icons", *this };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IconAtlas)
+    };
+
+}
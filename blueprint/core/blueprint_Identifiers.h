@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+
+    blueprint_Identifiers.h
+    Created: 14 Oct 2026 9:12:40am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A hash function for juce::Identifier so that identifiers can key the standard
+        unordered containers.
+
+        Identifiers are pooled, so two equal identifiers always share the same string
+        storage. That means we can hash the address of that storage rather than the
+        characters themselves, which matches the pointer comparison that
+        juce::Identifier uses for equality.
+     */
+    struct IdentifierHash
+    {
+        size_t operator() (const juce::Identifier& id) const noexcept
+        {
+            return std::hash<const void*>()(id.getCharPointer().getAddress());
+        }
+    };
+
+    //==============================================================================
+    /** Pre-interned identifiers for the properties read by the core views.
+
+        Constructing a juce::Identifier from a string literal means a lookup in the
+        global string pool, under a lock, every time. Each property name we compare
+        against on a hot path is therefore interned exactly once, here.
+     */
+    namespace IDs
+    {
+        // View
+        inline const juce::Identifier interceptClickEvents  ("interceptClickEvents");
+        inline const juce::Identifier opacity               ("opacity");
+        inline const juce::Identifier refId                 ("refId");
+        inline const juce::Identifier styleId               ("styleId");
+        inline const juce::Identifier focusable             ("focusable");
+        inline const juce::Identifier propertyBindings      ("propertyBindings");
+        inline const juce::Identifier transformRotate       ("transform-rotate");
+        inline const juce::Identifier transformScale        ("transform-scale");
+        inline const juce::Identifier transformScaleX       ("transform-scale-x");
+        inline const juce::Identifier transformScaleY       ("transform-scale-y");
+        inline const juce::Identifier transformSkewX        ("transform-skew-x");
+        inline const juce::Identifier transformSkewY        ("transform-skew-y");
+        inline const juce::Identifier transformTranslateX   ("transform-translate-x");
+        inline const juce::Identifier transformTranslateY   ("transform-translate-y");
+        inline const juce::Identifier borderPath            ("border-path");
+        inline const juce::Identifier borderColor           ("border-color");
+        inline const juce::Identifier borderWidth           ("border-width");
+        inline const juce::Identifier borderRadius          ("border-radius");
+        inline const juce::Identifier backgroundColor       ("background-color");
+        inline const juce::Identifier backgroundGradient    ("background-gradient");
+        inline const juce::Identifier boxShadow             ("box-shadow");
+        inline const juce::Identifier debug                 ("debug");
+        inline const juce::Identifier display               ("display");
+        inline const juce::Identifier visibility            ("visibility");
+        inline const juce::Identifier layoutTransition      ("layout-transition");
+        inline const juce::Identifier layoutBoundary        ("layout-boundary");
+        inline const juce::Identifier rasterize             ("rasterize");
+        inline const juce::Identifier cacheAsLayer          ("cache-as-layer");
+
+        // ReactApplicationRoot
+        inline const juce::Identifier performanceOverlay    ("performance-overlay");
+        inline const juce::Identifier children              ("children");
+
+        // TextView
+        inline const juce::Identifier color                 ("color");
+        inline const juce::Identifier fontSize              ("font-size");
+        inline const juce::Identifier fontStyle             ("font-style");
+        inline const juce::Identifier fontFamily            ("font-family");
+        inline const juce::Identifier kerningFactor         ("kerning-factor");
+        inline const juce::Identifier lineSpacing           ("line-spacing");
+        inline const juce::Identifier justification         ("justification");
+        inline const juce::Identifier wordWrap              ("word-wrap");
+        inline const juce::Identifier glyphAtlas            ("glyph-atlas");
+
+        // ImageView
+        inline const juce::Identifier source                ("source");
+        inline const juce::Identifier placement             ("placement");
+        inline const juce::Identifier iconAtlas             ("icon-atlas");
+
+        // ScrollView
+        inline const juce::Identifier scrollbarThumbColor   ("scrollbar-thumb-color");
+        inline const juce::Identifier smoothScroll          ("smooth-scroll");
+        inline const juce::Identifier scrollOnDrag          ("scroll-on-drag");
+
+        // CanvasView
+        inline const juce::Identifier drawing               ("drawing");
+        inline const juce::Identifier commands              ("commands");
+        inline const juce::Identifier strings               ("strings");
+
+        // ScopeView
+        inline const juce::Identifier windowSize            ("window-size");
+        inline const juce::Identifier trigger               ("trigger");
+        inline const juce::Identifier gain                  ("gain");
+        inline const juce::Identifier lineColor             ("line-color");
+        inline const juce::Identifier lineWidth             ("line-width");
+
+        // SpectrumView
+        inline const juce::Identifier fftSize               ("fft-size");
+        inline const juce::Identifier smoothing             ("smoothing");
+        inline const juce::Identifier minFrequency          ("min-frequency");
+        inline const juce::Identifier maxFrequency          ("max-frequency");
+        inline const juce::Identifier minDecibels           ("min-decibels");
+        inline const juce::Identifier maxDecibels           ("max-decibels");
+
+        // SliderView
+        inline const juce::Identifier parameterId           ("parameter-id");
+        inline const juce::Identifier value                 ("value");
+        inline const juce::Identifier defaultValue          ("default-value");
+        inline const juce::Identifier dragMode              ("drag-mode");
+        inline const juce::Identifier dragSensitivity       ("drag-sensitivity");
+        inline const juce::Identifier trackColor            ("track-color");
+        inline const juce::Identifier fillColor             ("fill-color");
+        inline const juce::Identifier trackWidth            ("track-width");
+
+        // FilmstripView
+        inline const juce::Identifier frameCount            ("frame-count");
+
+        // MeterView
+        inline const juce::Identifier channel               ("channel");
+        inline const juce::Identifier channelCount          ("channel-count");
+        inline const juce::Identifier orientation           ("orientation");
+        inline const juce::Identifier attack                ("attack");
+        inline const juce::Identifier release               ("release");
+        inline const juce::Identifier peakHold              ("peak-hold");
+        inline const juce::Identifier peakFall              ("peak-fall");
+        inline const juce::Identifier clipLevel             ("clip-level");
+        inline const juce::Identifier clipHold              ("clip-hold");
+        inline const juce::Identifier peakColor             ("peak-color");
+        inline const juce::Identifier clipColor             ("clip-color");
+        inline const juce::Identifier barSpacing            ("bar-spacing");
+
+        // KeyboardView
+        inline const juce::Identifier lowestNote            ("lowest-note");
+        inline const juce::Identifier highestNote           ("highest-note");
+        inline const juce::Identifier blackKeyWidth         ("black-key-width");
+        inline const juce::Identifier blackKeyHeight        ("black-key-height");
+        inline const juce::Identifier activeNotes           ("active-notes");
+        inline const juce::Identifier whiteKeyColor         ("white-key-color");
+        inline const juce::Identifier blackKeyColor         ("black-key-color");
+        inline const juce::Identifier keyLineColor          ("key-line-color");
+        inline const juce::Identifier highlightColor        ("highlight-color");
+
+        // NoteGridView
+        inline const juce::Identifier model                 ("model");
+        inline const juce::Identifier scrollBeat            ("scroll-beat");
+        inline const juce::Identifier topPitch              ("top-pitch");
+        inline const juce::Identifier beatWidth             ("beat-width");
+        inline const juce::Identifier rowHeight             ("row-height");
+        inline const juce::Identifier snap                  ("snap");
+        inline const juce::Identifier defaultLength         ("default-length");
+        inline const juce::Identifier beatsPerBar           ("beats-per-bar");
+        inline const juce::Identifier editable              ("editable");
+        inline const juce::Identifier blackKeyRowColor      ("black-key-row-color");
+        inline const juce::Identifier gridLineColor         ("grid-line-color");
+        inline const juce::Identifier barLineColor          ("bar-line-color");
+        inline const juce::Identifier noteColor             ("note-color");
+        inline const juce::Identifier selectedNoteColor     ("selected-note-color");
+        inline const juce::Identifier noteLineColor         ("note-line-color");
+
+        // TextInputView
+        inline const juce::Identifier placeholder           ("placeholder");
+        inline const juce::Identifier multiline             ("multiline");
+        inline const juce::Identifier maxLength             ("max-length");
+        inline const juce::Identifier changeDelay           ("change-delay");
+
+        // WaveformView
+        inline const juce::Identifier viewStart             ("view-start");
+        inline const juce::Identifier viewDuration          ("view-duration");
+
+        // VirtualListView
+        inline const juce::Identifier itemCount             ("item-count");
+        inline const juce::Identifier itemHeight            ("item-height");
+        inline const juce::Identifier overscan              ("overscan");
+
+        // View event handler props
+        inline const juce::Identifier onMeasure             ("onMeasure");
+        inline const juce::Identifier onMouseDown           ("onMouseDown");
+        inline const juce::Identifier onMouseUp             ("onMouseUp");
+        inline const juce::Identifier onMouseDrag           ("onMouseDrag");
+        inline const juce::Identifier onMouseDoubleClick    ("onMouseDoubleClick");
+        inline const juce::Identifier onMouseMove           ("onMouseMove");
+        inline const juce::Identifier onMouseEnter          ("onMouseEnter");
+        inline const juce::Identifier onMouseExit           ("onMouseExit");
+        inline const juce::Identifier onMouseWheel          ("onMouseWheel");
+        inline const juce::Identifier onLoad                ("onLoad");
+        inline const juce::Identifier onVisibleRangeChange  ("onVisibleRangeChange");
+        inline const juce::Identifier onScroll              ("onScroll");
+        inline const juce::Identifier onValueChange         ("onValueChange");
+        inline const juce::Identifier onChange              ("onChange");
+        inline const juce::Identifier onSubmit              ("onSubmit");
+        inline const juce::Identifier onKeyDown             ("onKeyDown");
+        inline const juce::Identifier onFocus               ("onFocus");
+        inline const juce::Identifier onBlur                ("onBlur");
+        inline const juce::Identifier onNoteChange          ("onNoteChange");
+
+        // View events
+        inline const juce::Identifier Measure               ("Measure");
+        inline const juce::Identifier MouseDown             ("MouseDown");
+        inline const juce::Identifier MouseUp               ("MouseUp");
+        inline const juce::Identifier MouseDrag             ("MouseDrag");
+        inline const juce::Identifier MouseDoubleClick      ("MouseDoubleClick");
+        inline const juce::Identifier MouseMove             ("MouseMove");
+        inline const juce::Identifier MouseEnter            ("MouseEnter");
+        inline const juce::Identifier MouseExit             ("MouseExit");
+        inline const juce::Identifier MouseWheel            ("MouseWheel");
+        inline const juce::Identifier Load                  ("Load");
+        inline const juce::Identifier VisibleRangeChange    ("VisibleRangeChange");
+        inline const juce::Identifier Scroll                ("Scroll");
+        inline const juce::Identifier ValueChange           ("ValueChange");
+        inline const juce::Identifier Change                ("Change");
+        inline const juce::Identifier Submit                ("Submit");
+        inline const juce::Identifier KeyDown               ("KeyDown");
+        inline const juce::Identifier Focus                 ("Focus");
+        inline const juce::Identifier Blur                  ("Blur");
+        inline const juce::Identifier NoteChange            ("NoteChange");
+
+        // Root events
+        inline const juce::Identifier animationEnd          ("animationEnd");
+        inline const juce::Identifier listModelChange       ("listModelChange");
+        inline const juce::Identifier valueTreeChange       ("valueTreeChange");
+        inline const juce::Identifier noteGridChange        ("noteGridChange");
+        inline const juce::Identifier workerMessage         ("workerMessage");
+        inline const juce::Identifier workerError           ("workerError");
+
+        // ListModel rows
+        inline const juce::Identifier index                 ("index");
+
+        // NoteChange events, and NoteGridModel notes
+        inline const juce::Identifier note                  ("note");
+        inline const juce::Identifier velocity              ("velocity");
+        inline const juce::Identifier id                    ("id");
+        inline const juce::Identifier pitch                 ("pitch");
+        inline const juce::Identifier start                 ("start");
+        inline const juce::Identifier length                ("length");
+        inline const juce::Identifier reset                 ("reset");
+        inline const juce::Identifier added                 ("added");
+        inline const juce::Identifier changed               ("changed");
+        inline const juce::Identifier removed               ("removed");
+
+        // Invalidation causes, besides property names
+        inline const juce::Identifier text                  ("text");
+        inline const juce::Identifier addChild              ("addChild");
+        inline const juce::Identifier removeChild           ("removeChild");
+    }
+
+}
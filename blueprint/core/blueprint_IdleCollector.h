@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    blueprint_IdleCollector.h
+    Created: 15 Oct 2026 4:51:13am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Decides when a root should run Duktape's mark-and-sweep itself, so that the
+        collector runs while nothing is happening rather than whenever the heap's
+        own triggers land, which may be in the middle of a drag.
+
+        Refcounting frees most garbage as it goes; mark-and-sweep is only needed
+        for cycles, and is also what the heap falls back on under memory pressure.
+        So a collection is due once JavaScript has run since the last one, the
+        root has been idle for a while, and it's been long enough since the last
+        collection. Collections never run while they're suppressed, such as for
+        the length of a gesture.
+
+        The collector also keeps count of its collections and their pause times.
+        Collections Duktape triggers itself aren't visible to us, and not counted.
+
+        After a burst of allocation, such as the first mount of the tree, a
+        compacting collection can be requested, which runs in the next idle slot
+        regardless of the least interval, and shrinks what survives it too.
+     */
+    class IdleCollector
+    {
+    public:
+        //==============================================================================
+        struct Options
+        {
+            /** Whether to collect in idle time at all. */
+            bool enabled = true;
+
+            /** How long the root has to have been idle before we collect. */
+            double idleDelayMs = 250.0;
+
+            /** The least time between two collections. */
+            double minIntervalMs = 2000.0;
+
+            /** We don't start a collection if a timer falls due sooner than this. */
+            double timerHeadroomMs = 50.0;
+        };
+
+        struct Stats
+        {
+            int numCollections = 0;
+            double lastPauseMs = 0.0;
+            double maxPauseMs = 0.0;
+            double totalPauseMs = 0.0;
+        };
+
+        //==============================================================================
+        IdleCollector() = default;
+
+        //==============================================================================
+        void setOptions (const Options& newOptions) { options = newOptions; }
+        const Options& getOptions() const { return options; }
+
+        /** Stops collections until the matching call to `resume`. Calls nest. */
+        void suppress() { ++suppressionCount; }
+
+        /** Undoes one call to `suppress`. */
+        void resume()
+        {
+            jassert (suppressionCount > 0);
+            suppressionCount = juce::jmax(0, suppressionCount - 1);
+        }
+
+        bool isSuppressed() const { return suppressionCount > 0; }
+
+        //==============================================================================
+        /** Notes that the root did work, which may have left garbage behind. */
+        void markBusy (double timeNowMs)
+        {
+            lastBusyTime = timeNowMs;
+            hasGarbage = true;
+        }
+
+        /** Asks for the next collection to compact the heap too, as soon as the
+            root has been idle for the idle delay.
+         */
+        void requestCompaction (double timeNowMs)
+        {
+            markBusy(timeNowMs);
+            compactionPending = true;
+        }
+
+        /** Returns the time at which a collection next falls due, or -1 if none
+            does until there's more work.
+         */
+        double getNextCollectionTime() const
+        {
+            if (!options.enabled || !hasGarbage || isSuppressed())
+                return -1.0;
+
+            if (compactionPending)
+                return lastBusyTime + options.idleDelayMs;
+
+            return juce::jmax(lastBusyTime + options.idleDelayMs, lastCollectionTime + options.minIntervalMs);
+        }
+
+        /** Runs a collection if one is due and the next timer is far enough off,
+            returning true if it did.
+         */
+        bool collectIfDue (duk_context* ctx, double timeNowMs, double nextTimerDeadline)
+        {
+            const double due = getNextCollectionTime();
+
+            if (due < 0.0 || timeNowMs < due)
+                return false;
+
+            if (nextTimerDeadline >= 0.0 && nextTimerDeadline - timeNowMs < options.timerHeadroomMs)
+                return false;
+
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            duk_gc(ctx, compactionPending ? DUK_GC_COMPACT : 0);
+            const double end = juce::Time::getMillisecondCounterHiRes();
+
+            stats.numCollections++;
+            stats.lastPauseMs = end - start;
+            stats.maxPauseMs = juce::jmax(stats.maxPauseMs, stats.lastPauseMs);
+            stats.totalPauseMs += stats.lastPauseMs;
+
+            lastCollectionTime = end;
+            hasGarbage = false;
+            compactionPending = false;
+            return true;
+        }
+
+        /** Returns the collections run so far, and their pause times. */
+        const Stats& getStats() const { return stats; }
+
+    private:
+        //==============================================================================
+        Options options;
+        Stats stats;
+
+        int suppressionCount = 0;
+        bool hasGarbage = false;
+        bool compactionPending = false;
+        double lastBusyTime = 0.0;
+        double lastCollectionTime = 0.0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IdleCollector)
+    };
+
+}
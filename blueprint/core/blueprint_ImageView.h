@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include "blueprint_DrawableCache.h"
+#include "blueprint_EditableDrawable.h"
+#include "blueprint_IconAtlas.h"
+#include "blueprint_MipmapCache.h"
 #include "blueprint_View.h"
 
 
@@ -18,6 +22,35 @@ namespace blueprint
     //==============================================================================
     /** The ImageView class is a core view for drawing images within Blueprint's
         layout system.
+
+        Its drawable comes from the shared DrawableCache, so views showing the
+        same source, in any root, share one decoded copy of it. Sources which are
+        slow to decode, files and large images, decode on the cache's thread pool
+        instead of holding up the commit; the view paints nothing but its
+        background until the image is ready.
+
+        Once the image is ready, the view sends an `onLoad` event with its
+        natural width and height. A view whose style leaves its width or height
+        open takes them from the image too, keeping its aspect ratio, without
+        waiting on JavaScript to size it.
+
+        With `rasterize`, the drawable is rendered once to an image at the
+        display's scale, and repaints blit that until the source, the view's
+        size or the scale changes. With `icon-atlas`, it's rendered into a slot
+        of the shared IconAtlas instead, which suits small icons shown in
+        their hundreds: views showing the same icon at the same size share the
+        slot, and every icon on a page of the atlas paints from the same image.
+        Views too big for the atlas paint as they would without it.
+
+        A bitmap source drawn with a `placement` is drawn from the nearest of
+        its mip levels in the shared MipmapCache, so that a large skin image
+        shown small is neither slow to paint nor shimmering.
+
+        Properties named `#<id>.<attribute>`, e.g. `#needle.transform`, change
+        an attribute of the element with that `id` in place, without parsing
+        the SVG again; see EditableDrawable for the attributes understood. The
+        first such property gives the view its own copy of the drawable, which
+        it paints instead of the shared one, and never from the icon atlas.
      */
     class ImageView : public View
     {
@@ -30,40 +63,239 @@ namespace blueprint
         {
             View::setProperty(name, value);
 
-            if (name == juce::Identifier("source"))
-            {
-                juce::String source = value.toString();
-
-                drawable = std::unique_ptr<juce::Drawable>(
-                    juce::Drawable::createFromImageData(
-                        source.toRawUTF8(),
-                        source.getNumBytesAsUTF8()
-                    )
-                );
-            }
+            if (name == IDs::source)
+                setSource(value.toString());
+
+            if (name == IDs::iconAtlas)
+                useIconAtlas = (bool) value;
+
+            if (EditableDrawable::isAttributeProperty(name))
+                return setElementAttribute(name, value);
+
+            if (name == IDs::source || name == IDs::placement || name == IDs::rasterize || name == IDs::iconAtlas)
+                invalidateRaster();
+        }
+
+        /** Drops the drawable, and ignores any decode still running for it. */
+        void resetForReuse() override
+        {
+            View::resetForReuse();
+
+            ++sourceGeneration;
+            drawable = nullptr;
+            mipmaps = nullptr;
+            editable = nullptr;
+            useIconAtlas = false;
+            invalidateRaster();
+        }
+
+        /** Returns the drawable's natural bounds, or empty ones until it's loaded. */
+        juce::Rectangle<float> getNaturalBounds() const
+        {
+            return drawable != nullptr ? drawable->getDrawableBounds() : juce::Rectangle<float>();
         }
 
         //==============================================================================
         void paint (juce::Graphics& g) override
         {
+            BLUEPRINT_TRACE_SCOPE("ImageView::paint", getViewId());
+            const ScopedPaintTimer paintTimer (*this, "ImageView");
+
             View::paint(g);
 
-            float opacity = props.getWithDefault("opacity", 1.0f);
+            if (drawable == nullptr)
+                return;
+
+            if (useIconAtlas && editable == nullptr && paintFromIconAtlas(g))
+                return;
+
+            if (style.rasterize)
+            {
+                return raster.draw(g, getLocalBounds(), style.opacity, [this](juce::Graphics& target) {
+                    paintDrawable(target, 1.0f);
+                });
+            }
+
+            paintDrawable(g, style.opacity);
+        }
+
+        /** Drawables paint through components of their own, which are shared
+            with every other view of the same source.
+         */
+        bool canPaintConcurrently() const override { return false; }
+
+    private:
+        //==============================================================================
+        void setSource (const juce::String& source)
+        {
+            // Any decode still running for a previous source is now stale.
+            const auto generation = ++sourceGeneration;
+
+            editable = nullptr;
+            drawable = drawableCache->getCachedDrawable(source);
+
+            if (drawable == nullptr && drawableCache->shouldDecodeAsync(source))
+            {
+                juce::Component::SafePointer<ImageView> safeThis (this);
+
+                drawableCache->getDrawableAsync(source, [safeThis, generation](DrawableCache::DrawableHandle d) {
+                    if (safeThis == nullptr || safeThis->sourceGeneration != generation || d == nullptr)
+                        return;
+
+                    safeThis->drawable = std::move(d);
+                    safeThis->applyElementAttributes();
+                    safeThis->invalidateRaster();
+                    safeThis->intrinsicSizeChanged();
+                    safeThis->loaded();
+                    safeThis->repaint();
+                });
+
+                return intrinsicSizeChanged();
+            }
+
+            if (drawable == nullptr)
+                drawable = drawableCache->getDrawable(source);
+
+            applyElementAttributes();
+            intrinsicSizeChanged();
+
+            if (drawable != nullptr)
+                loaded();
+        }
+
+        /** Sets an element's attribute on our own copy of the drawable, making
+            the copy first if need be. Before the drawable loads, the value waits
+            in our props for `applyElementAttributes`.
+         */
+        void setElementAttribute (const juce::Identifier& name, const juce::var& value)
+        {
+            if (drawable == nullptr)
+                return;
+
+            if (editable == nullptr)
+                editable = std::make_unique<EditableDrawable>(*drawable);
+
+            if (!editable->setAttribute(name, value))
+                DBG("ImageView: no element or attribute for " << name.toString());
+
+            invalidateRaster();
+        }
+
+        /** Copies a newly loaded drawable, if the view has any element attributes,
+            and sets each of them on the copy.
+         */
+        void applyElementAttributes()
+        {
+            editable = nullptr;
+
+            for (const auto& prop : props)
+                if (EditableDrawable::isAttributeProperty(prop.name))
+                    setElementAttribute(prop.name, prop.value);
+        }
+
+        void paintDrawable (juce::Graphics& g, float opacity)
+        {
+            const auto& d = editable != nullptr ? editable->getDrawable() : *drawable;
 
             // Without a specified placement, we just draw the drawable.
-            if (!props.contains("placement"))
-                return drawable->draw(g, opacity);
+            if (!style.hasPlacement)
+                return d.draw(g, opacity);
 
             // Otherwise we map placement strings to the appropriate flags
-            int flags = props["placement"];
-            juce::RectanglePlacement placement (flags);
+            juce::RectanglePlacement placement (style.placement);
+            const auto transform = placement.getTransformToFit(d.getDrawableBounds(), getLocalBounds().toFloat());
+
+            if (editable == nullptr && paintFromMipmaps(g, d, transform, opacity))
+                return;
 
-            drawable->drawWithin(g, getLocalBounds().toFloat(), placement, opacity);
+            d.draw(g, opacity, transform);
+        }
+
+        /** Paints a bitmap drawable from its mip levels, returning false if it
+            isn't one which has them.
+         */
+        bool paintFromMipmaps (juce::Graphics& g, const juce::Drawable& d, const juce::AffineTransform& transform, float opacity)
+        {
+            if (mipmaps == nullptr || !mipmaps->isFor(d))
+                mipmaps = mipmapCache->getChain(drawable);
+
+            if (mipmaps == nullptr)
+                return false;
+
+            mipmaps->draw(g, transform, opacity);
+            return true;
+        }
+
+        /** Paints the drawable from its slot in the icon atlas, returning false if
+            it's too big to have one.
+         */
+        bool paintFromIconAtlas (juce::Graphics& g)
+        {
+            const auto area = getLocalBounds();
+            const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+            // An icon whose scale alone has changed is drawn scaled until the
+            // budget allows another.
+            const bool rescaling = icon != nullptr && icon->scale != scale
+                                   && icon->area.getWidth() == juce::roundToInt(area.getWidth() * icon->scale)
+                                   && icon->area.getHeight() == juce::roundToInt(area.getHeight() * icon->scale);
+
+            if (icon == nullptr || icon->area.getWidth() != juce::roundToInt(area.getWidth() * scale)
+                                || icon->area.getHeight() != juce::roundToInt(area.getHeight() * scale)
+                                || icon->scale != scale)
+            {
+                if (rescaling && !RescaleBudget::mayRerender())
+                {
+                    IconAtlas::draw(g, *icon, area, style.opacity);
+                    return true;
+                }
+
+                const auto start = juce::Time::getMillisecondCounterHiRes();
+
+                // Without a placement the drawable draws at its own coordinates,
+                // which no placement's flags would give.
+                const int placementFlags = style.hasPlacement ? style.placement : -1;
+
+                icon = iconAtlas->getIcon(drawable, area, scale, placementFlags, [this](juce::Graphics& target) {
+                    paintDrawable(target, 1.0f);
+                });
+
+                if (rescaling)
+                    RescaleBudget::addRerenderTime(juce::Time::getMillisecondCounterHiRes() - start);
+            }
+
+            if (icon == nullptr)
+                return false;
+
+            IconAtlas::draw(g, *icon, area, style.opacity);
+            return true;
+        }
+
+        void invalidateRaster()
+        {
+            raster.invalidate();
+            icon = nullptr;
+        }
+
+        void loaded()
+        {
+            const auto bounds = drawable->getDrawableBounds();
+            queueLoadEvent(bounds.getWidth(), bounds.getHeight());
         }
 
-    private:
         //==============================================================================
-        std::unique_ptr<juce::Drawable> drawable;
+        juce::SharedResourcePointer<DrawableCache> drawableCache;
+        DrawableCache::DrawableHandle drawable;
+        std::unique_ptr<EditableDrawable> editable;
+        juce::uint32 sourceGeneration = 0;
+        RasterCache raster;
+
+        juce::SharedResourcePointer<MipmapCache> mipmapCache;
+        MipmapCache::ChainHandle mipmaps;
+
+        juce::SharedResourcePointer<IconAtlas> iconAtlas;
+        IconAtlas::IconHandle icon;
+        bool useIconAtlas = false;
 
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImageView)
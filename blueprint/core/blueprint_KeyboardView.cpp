@@ -0,0 +1,338 @@
+/*
+  ==============================================================================
+
+    blueprint_KeyboardView.cpp
+    Created: 15 Oct 2026 11:44:19pm
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    void KeyboardView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+        getPropertyTable().apply(*this, name, v);
+    }
+
+    const ViewPropertyTable<KeyboardView>& KeyboardView::getPropertyTable()
+    {
+        typedef ViewPropertyTable<KeyboardView> Table;
+
+        static constexpr Table::Entry entries[] = {
+            { "source", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                k.sourceName = v.toString();
+                k.channelVelocities.fill(0.0f);
+                k.repaint();
+
+                if (k.sourceName.isNotEmpty())
+                    k.scheduler.scheduleFrame();
+                else
+                    k.scheduler.cancel();
+            }},
+            { "lowest-note", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                const int note = juce::jlimit(0, numMidiNotes - 1, (int) v);
+                k.lowestNote = isBlackKey(note) ? note - 1 : note;
+                k.repaint();
+            }},
+            { "highest-note", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                const int note = juce::jlimit(0, numMidiNotes - 1, (int) v);
+                k.highestNote = isBlackKey(note) ? note + 1 : note;
+                k.repaint();
+            }},
+            { "black-key-width", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                k.blackKeyWidth = juce::jlimit(0.1f, 1.0f, (float) v);
+                k.repaint();
+            }},
+            { "black-key-height", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                k.blackKeyHeight = juce::jlimit(0.1f, 1.0f, (float) v);
+                k.repaint();
+            }},
+            { "active-notes", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                std::array<bool, numMidiNotes> notes {};
+
+                if (auto* array = v.getArray())
+                    for (const auto& note : *array)
+                        if (juce::isPositiveAndBelow((int) note, numMidiNotes))
+                            notes[static_cast<size_t>((int) note)] = true;
+
+                for (int note = 0; note < numMidiNotes; ++note)
+                    if (notes[static_cast<size_t>(note)] != k.activeNotes[static_cast<size_t>(note)])
+                        k.repaintKey(note);
+
+                k.activeNotes = notes;
+            }},
+            { "white-key-color", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                k.whiteKeyColour = parseColourValue(v);
+                k.repaint();
+            }},
+            { "black-key-color", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                k.blackKeyColour = parseColourValue(v);
+                k.repaint();
+            }},
+            { "key-line-color", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                k.keyLineColour = parseColourValue(v);
+                k.repaint();
+            }},
+            { "highlight-color", Table::ConsumedByView, [](KeyboardView& k, const juce::var& v) {
+                k.highlightColour = parseColourValue(v);
+                k.repaint();
+            }},
+        };
+
+        static const Table table (entries);
+        return table;
+    }
+
+    void KeyboardView::resetForReuse()
+    {
+        View::resetForReuse();
+
+        sourceName = {};
+        scheduler.cancel();
+
+        channelVelocities.fill(0.0f);
+        activeNotes.fill(false);
+        mouseNote = -1;
+    }
+
+    //==============================================================================
+    void KeyboardView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("KeyboardView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "KeyboardView");
+
+        View::paint(g);
+
+        const float whiteWidth = getWhiteKeyWidth();
+
+        if (whiteWidth <= 0.0f)
+            return;
+
+        // Only the keys in the clip, as a key's change repaints that key alone.
+        const auto clip = g.getClipBounds().toFloat();
+        const int firstWhite = getWhiteKeyIndex(lowestNote);
+        const int numWhite = getWhiteKeyIndex(highestNote) - firstWhite + 1;
+        const int begin = juce::jmax(0, (int) std::floor(clip.getX() / whiteWidth) - 1);
+        const int end = juce::jmin(numWhite, (int) std::ceil(clip.getRight() / whiteWidth) + 1);
+
+        for (int i = begin; i < end; ++i)
+        {
+            const int note = getWhiteKeyNote(firstWhite + i);
+            const auto area = getKeyBounds(note);
+
+            g.setColour(isSounding(note) ? highlightColour : whiteKeyColour);
+            g.fillRect(area);
+
+            if (i > 0)
+            {
+                g.setColour(keyLineColour);
+                g.fillRect(area.withWidth(1.0f));
+            }
+        }
+
+        // The black keys either side of each white key, over the white keys.
+        for (int i = begin; i <= end; ++i)
+        {
+            const int note = getWhiteKeyNote(firstWhite + i) - 1;
+
+            if (note < lowestNote || note > highestNote || !isBlackKey(note))
+                continue;
+
+            g.setColour(isSounding(note) ? highlightColour : blackKeyColour);
+            g.fillRect(getKeyBounds(note));
+        }
+    }
+
+    //==============================================================================
+    void KeyboardView::mouseDown (const juce::MouseEvent& e)
+    {
+        View::mouseDown(e);
+
+        const int note = getNoteAt(e.position);
+        const float keyLength = (float) getHeight() * (isBlackKey(juce::jmax(0, note)) ? blackKeyHeight : 1.0f);
+
+        setMouseNote(note, keyLength > 0.0f ? juce::jlimit(0.1f, 1.0f, e.position.y / keyLength) : 1.0f);
+    }
+
+    void KeyboardView::mouseDrag (const juce::MouseEvent& e)
+    {
+        View::mouseDrag(e);
+
+        const int note = getNoteAt(e.position);
+
+        // Gliding across the keys plays each at the velocity of the first.
+        if (note != mouseNote)
+            setMouseNote(note, lastMouseVelocity);
+    }
+
+    void KeyboardView::mouseUp (const juce::MouseEvent& e)
+    {
+        View::mouseUp(e);
+        setMouseNote(-1, 0.0f);
+    }
+
+    //==============================================================================
+   #if JUCE_MODULE_AVAILABLE_juce_audio_basics
+    void KeyboardView::writeMidi (ValueChannel& channel, const juce::MidiBuffer& midi)
+    {
+        // If you hit this, the channel is too small to hold every note.
+        jassert (channel.getNumValues() >= numMidiNotes);
+
+        const int numNotes = juce::jmin(numMidiNotes, channel.getNumValues());
+
+        for (const auto metadata : midi)
+        {
+            const auto message = metadata.getMessage();
+
+            if (message.isNoteOnOrOff())
+            {
+                const int note = message.getNoteNumber();
+                const float velocity = message.isNoteOn() ? message.getFloatVelocity() : 0.0f;
+
+                if (note < numNotes && channel.getLiveValue(note) != velocity)
+                    channel.setValue(note, velocity);
+            }
+            else if (message.isAllNotesOff() || message.isAllSoundOff())
+            {
+                for (int note = 0; note < numNotes; ++note)
+                    if (channel.getLiveValue(note) != 0.0f)
+                        channel.setValue(note, 0.0f);
+            }
+        }
+    }
+   #endif
+
+    //==============================================================================
+    void KeyboardView::frameCallback()
+    {
+        if (sourceName.isEmpty())
+            return;
+
+        ReactApplicationRoot* root = getOwningRoot();
+
+        if (auto* channel = root != nullptr ? root->getValueChannel(sourceName) : nullptr)
+        {
+            // Live values, as ValueChannel::getLiveValue explains.
+            const int numNotes = juce::jmin(numMidiNotes, channel->getNumValues());
+
+            for (int note = 0; note < numNotes; ++note)
+            {
+                auto& shown = channelVelocities[static_cast<size_t>(note)];
+                const float velocity = channel->getLiveValue(note);
+
+                if (velocity == shown)
+                    continue;
+
+                const bool wasSounding = isSounding(note);
+                shown = velocity;
+
+                if (isSounding(note) != wasSounding)
+                    repaintKey(note);
+            }
+        }
+
+        scheduler.scheduleFrame();
+    }
+
+    int KeyboardView::getNoteAt (juce::Point<float> position) const
+    {
+        const float whiteWidth = getWhiteKeyWidth();
+
+        if (whiteWidth <= 0.0f || !getLocalBounds().toFloat().contains(position))
+            return -1;
+
+        const int firstWhite = getWhiteKeyIndex(lowestNote);
+        const int numWhite = getWhiteKeyIndex(highestNote) - firstWhite + 1;
+
+        // A black key sits across the line between two white keys, so it's the
+        // nearest line's, if the position is over its half of that line.
+        if (position.y < (float) getHeight() * blackKeyHeight)
+        {
+            const int line = juce::roundToInt(position.x / whiteWidth);
+            const int note = getWhiteKeyNote(firstWhite + line) - 1;
+
+            if (line > 0 && line < numWhite && isBlackKey(note)
+                && std::abs(position.x - (float) line * whiteWidth) < whiteWidth * blackKeyWidth * 0.5f)
+                return note;
+        }
+
+        return getWhiteKeyNote(firstWhite + juce::jlimit(0, numWhite - 1, (int) (position.x / whiteWidth)));
+    }
+
+    juce::Rectangle<float> KeyboardView::getKeyBounds (int note) const
+    {
+        const float whiteWidth = getWhiteKeyWidth();
+
+        if (note < lowestNote || note > highestNote || whiteWidth <= 0.0f)
+            return {};
+
+        const float x = (float) (getWhiteKeyIndex(note) - getWhiteKeyIndex(lowestNote)) * whiteWidth;
+
+        if (!isBlackKey(note))
+            return { x, 0.0f, whiteWidth, (float) getHeight() };
+
+        const float width = whiteWidth * blackKeyWidth;
+        return { x - width * 0.5f, 0.0f, width, (float) getHeight() * blackKeyHeight };
+    }
+
+    float KeyboardView::getWhiteKeyWidth() const
+    {
+        if (highestNote < lowestNote)
+            return 0.0f;
+
+        const int numWhite = getWhiteKeyIndex(highestNote) - getWhiteKeyIndex(lowestNote) + 1;
+        return (float) getWidth() / (float) numWhite;
+    }
+
+    void KeyboardView::setMouseNote (int note, float velocity)
+    {
+        if (note == mouseNote)
+            return;
+
+        if (mouseNote >= 0)
+        {
+            const int released = mouseNote;
+            mouseNote = -1;
+
+            repaintKey(released);
+            queueNoteEvent(released, 0.0f);
+        }
+
+        if (note >= 0)
+        {
+            mouseNote = note;
+            lastMouseVelocity = velocity;
+
+            repaintKey(note);
+            queueNoteEvent(note, velocity);
+        }
+    }
+
+    void KeyboardView::queueNoteEvent (int note, float velocity)
+    {
+        if (!hasEventHandler(NoteChangeEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->queueNoteChangeEvent(getViewId(), note, velocity);
+    }
+
+    void KeyboardView::repaintKey (int note)
+    {
+        const auto area = getKeyBounds(note);
+
+        if (!area.isEmpty())
+            repaint(area.getSmallestIntegerContainer());
+    }
+
+    bool KeyboardView::isSounding (int note) const
+    {
+        const auto i = static_cast<size_t>(note);
+        return note == mouseNote || channelVelocities[i] > 0.0f || activeNotes[i];
+    }
+
+}
@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    blueprint_KeyboardView.h
+    Created: 15 Oct 2026 11:44:19pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+
+#include "blueprint_FrameScheduler.h"
+#include "blueprint_View.h"
+#include "blueprint_ViewPropertyTable.h"
+
+
+namespace blueprint
+{
+
+    class ValueChannel;
+
+    //==============================================================================
+    /** The KeyboardView class is a core view which draws an on-screen piano
+        keyboard, every key in the one component, and plays it with the mouse.
+
+        The keys run from `lowest-note` (21, the piano's A0, by default) to
+        `highest-note` (108), white keys sharing the width equally and black
+        keys drawn over them, `black-key-width` of a white key wide and
+        `black-key-height` of the view tall. Which key is under the mouse is
+        worked out arithmetically from the position, rather than by a component
+        or a path per key.
+
+        `source` names a ValueChannel of 128 values registered with the root,
+        the velocity of each sounding note, or 0, written on the audio thread by
+        `writeMidi` as the processor's processBlock sees its MIDI. Once a display
+        frame the view reads the live velocities, and repaints only the keys
+        whose state has changed. `active-notes`, an array of note numbers, lights
+        keys from JavaScript as well.
+
+        Clicking a key plays it, with a velocity from how far down the key it
+        was clicked, and dragging across the keys plays each in turn as the
+        previous releases. With an `onNoteChange` handler, the notes played go
+        to JavaScript as an array of `{ note, velocity }`, a velocity of 0 for a
+        release, in order and at most once a frame for all of them.
+
+        Keys draw in `white-key-color` and `black-key-color`, with lines of
+        `key-line-color` between the white keys, and those sounding in
+        `highlight-color`.
+     */
+    class KeyboardView : public View
+    {
+    public:
+        //==============================================================================
+        KeyboardView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        /** The keyboard's own properties, and how it applies them. */
+        static const ViewPropertyTable<KeyboardView>& getPropertyTable();
+
+        /** Forgets the source, and releases any note held by the mouse. */
+        void resetForReuse() override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+        void mouseDown (const juce::MouseEvent& e) override;
+        void mouseDrag (const juce::MouseEvent& e) override;
+        void mouseUp (const juce::MouseEvent& e) override;
+
+       #if JUCE_MODULE_AVAILABLE_juce_audio_basics
+        //==============================================================================
+        /** Writes the note ons and offs in a block of MIDI into a keyboard's
+            channel, of 128 values, as velocities from 0 to 1. Call it from the
+            processor's processBlock: it never waits, locks or allocates, and
+            only writes a note whose state has changed.
+
+            Notes on any MIDI channel light the same key. All notes off, and all
+            sound off, release every key.
+         */
+        static void writeMidi (ValueChannel& channel, const juce::MidiBuffer& midi);
+       #endif
+
+        /** Returns true if the given MIDI note is a black key. */
+        static bool isBlackKey (int note) { return ((1 << (note % 12)) & 0x54a) != 0; }
+
+        static constexpr int numMidiNotes = 128;
+
+    private:
+        //==============================================================================
+        /** Reads the latest velocities, repainting the keys which have changed,
+            and waits for the next frame.
+         */
+        void frameCallback();
+
+        /** Returns the note of the key at the given position, or -1 for none. */
+        int getNoteAt (juce::Point<float> position) const;
+
+        /** Returns the area a note's key takes up, or an empty area for a note
+            not on the keyboard.
+         */
+        juce::Rectangle<float> getKeyBounds (int note) const;
+
+        /** Returns the width of one white key. */
+        float getWhiteKeyWidth() const;
+
+        /** Presses a note with the mouse, releasing the one it held before. */
+        void setMouseNote (int note, float velocity);
+
+        /** Tells JavaScript a note was played or released. */
+        void queueNoteEvent (int note, float velocity);
+
+        void repaintKey (int note);
+
+        bool isSounding (int note) const;
+
+        /** Returns the number of white keys below the given note. */
+        static int getWhiteKeyIndex (int note) { return (note / 12) * 7 + whiteKeysBelowInOctave[note % 12]; }
+
+        /** Returns the note of the white key with the given index. */
+        static int getWhiteKeyNote (int index) { return (index / 7) * 12 + whiteNotesInOctave[index % 7]; }
+
+        //==============================================================================
+        static constexpr int whiteKeysBelowInOctave[12] = { 0, 1, 1, 2, 2, 3, 4, 4, 5, 5, 6, 6 };
+        static constexpr int whiteNotesInOctave[7] = { 0, 2, 4, 5, 7, 9, 11 };
+
+        juce::String sourceName;
+
+        // Always white keys: a black key at either end takes in the white key
+        // beside it.
+        int lowestNote = 21;
+        int highestNote = 108;
+        float blackKeyWidth = 0.6f;
+        float blackKeyHeight = 0.62f;
+
+        // Each note as last shown: its velocity from the channel, and whether
+        // JavaScript lights it.
+        std::array<float, numMidiNotes> channelVelocities {};
+        std::array<bool, numMidiNotes> activeNotes {};
+
+        int mouseNote = -1;
+        float lastMouseVelocity = 0.0f;
+
+        FrameScheduler scheduler { *this, [this]() { frameCallback(); } };
+
+        juce::Colour whiteKeyColour { 0xfff2f2f2 };
+        juce::Colour blackKeyColour { 0xff1e1e1e };
+        juce::Colour keyLineColour { 0xff626262 };
+        juce::Colour highlightColour { 0xff66fdcf };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KeyboardView)
+    };
+
+}
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+    blueprint_LayoutAnimator.h
+    Created: 15 Oct 2026 2:04:37am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+
+#include "blueprint_AnimatedValue.h"
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Tweens view bounds between layouts, for views with a `layout-transition`.
+
+        When a layout pass moves such a view, the shadow tree hands its old and new
+        bounds to the animator rather than snapping the view into place. The
+        animator then moves the view's component bounds towards the new layout
+        once every frame, without running Yoga again, so a panel expanding or
+        collapsing costs one layout pass however long it animates for.
+
+        Only the transitioning view tweens; its children are laid out against its
+        final size straight away, and move with it as a normal child would.
+     */
+    class LayoutAnimator
+    {
+    public:
+        //==============================================================================
+        LayoutAnimator() = default;
+
+        /** Sets the clock transitions run by, in milliseconds; by default the
+            system's high resolution counter. Times passed to `advance` should
+            come from the same clock.
+         */
+        void setClock (std::function<double()> newClock)
+        {
+            clock = std::move(newClock);
+        }
+
+        //==============================================================================
+        /** Parses a `layout-transition` value into an animation config, returning
+            false if the value disables transitions. A number is a duration in
+            milliseconds; an object is an animation config as for `startAnimation`.
+         */
+        static bool parseTransition (const juce::var& value, AnimatedValue::Config& config)
+        {
+            if (value.isDouble() || value.isInt() || value.isInt64())
+            {
+                config = AnimatedValue::Config();
+                config.durationMs = juce::jmax(0.0, (double) value);
+                return config.durationMs > 0.0;
+            }
+
+            if (value.isObject())
+            {
+                config = AnimatedValue::parseConfig(value);
+                return true;
+            }
+
+            return false;
+        }
+
+        //==============================================================================
+        /** Moves the view from its current bounds to the target bounds along the
+            given curve. A view already in transition sets off from wherever it is
+            now, so a transition interrupted by a new layout never jumps.
+         */
+        void animate (View& view, const juce::Rectangle<float>& target, const AnimatedValue::Config& config)
+        {
+            cancel(view.getViewId());
+
+            transitions.push_back({
+                view.getViewId(),
+                view.getFloatBounds(),
+                target,
+                AnimatedValue(0.0, 1.0, config),
+                clock()
+            });
+        }
+
+        /** Returns true if the view is already on its way to the given bounds. */
+        bool isTransitioningTo (ViewId viewId, const juce::Rectangle<float>& target) const
+        {
+            for (auto& t : transitions)
+                if (t.viewId == viewId)
+                    return t.to == target;
+
+            return false;
+        }
+
+        /** Stops the view's transition, if any, leaving the view where it is. */
+        void cancel (ViewId viewId)
+        {
+            transitions.erase(std::remove_if(transitions.begin(), transitions.end(), [=](const Transition& t) {
+                return t.viewId == viewId;
+            }), transitions.end());
+        }
+
+        /** Stops every transition. */
+        void clear() { transitions.clear(); }
+
+        /** Returns true if any view is in transition. */
+        bool isAnimating() const { return !transitions.empty(); }
+
+        //==============================================================================
+        /** Moves every view in transition to its bounds for the given time, using
+            the callback to look up each view by id. Transitions of views which
+            have gone, and those which have finished, are dropped.
+         */
+        template <typename ViewLookup>
+        void advance (double timeNowMs, ViewLookup&& findView)
+        {
+            for (auto it = transitions.begin(); it != transitions.end();)
+            {
+                auto& t = *it;
+                View* view = findView(t.viewId);
+
+                if (view == nullptr)
+                {
+                    it = transitions.erase(it);
+                    continue;
+                }
+
+                const double p = t.progress.advance(timeNowMs - t.startTime);
+                const auto bounds = t.progress.isFinished() ? t.to : interpolate(t.from, t.to, (float) p);
+
+                if (bounds != view->getFloatBounds())
+                    view->setFloatBounds(bounds);
+
+                if (t.progress.isFinished())
+                {
+                    it = transitions.erase(it);
+                    continue;
+                }
+
+                ++it;
+            }
+        }
+
+    private:
+        //==============================================================================
+        static juce::Rectangle<float> interpolate (const juce::Rectangle<float>& a, const juce::Rectangle<float>& b, float p)
+        {
+            // A spring may overshoot, but never into a negative size.
+            return {
+                a.getX() + (b.getX() - a.getX()) * p,
+                a.getY() + (b.getY() - a.getY()) * p,
+                juce::jmax(0.0f, a.getWidth() + (b.getWidth() - a.getWidth()) * p),
+                juce::jmax(0.0f, a.getHeight() + (b.getHeight() - a.getHeight()) * p)
+            };
+        }
+
+        struct Transition
+        {
+            ViewId viewId;
+            juce::Rectangle<float> from;
+            juce::Rectangle<float> to;
+            AnimatedValue progress;
+            double startTime;
+        };
+
+        std::vector<Transition> transitions;
+        std::function<double()> clock = []() { return juce::Time::getMillisecondCounterHiRes(); };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LayoutAnimator)
+    };
+
+}
@@ -0,0 +1,408 @@
+/*
+  ==============================================================================
+
+    blueprint_LayoutSnapshot.h
+    Created: 15 Oct 2026 12:52:08pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "blueprint_LayoutAnimator.h"
+#include "blueprint_MeasuredShadowView.h"
+#include "blueprint_ShadowView.h"
+#include "blueprint_TextShadowView.h"
+#include "blueprint_TextView.h"
+#include "blueprint_TraceRecorder.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A copy of a shadow tree's flex layout, which can be laid out on any thread
+        while the tree itself carries on changing on the message thread.
+
+        The snapshot is taken on the message thread, and copies the style of every
+        node into a Yoga tree of its own, along with the text each text node
+        measures and the natural bounds of each image, or other measured node.
+        Nothing in it refers back to the shadow tree, so `calculate`
+        may run on a worker. Back on the message thread, `apply` moves each view
+        still in the tree to its computed bounds; views added since the snapshot
+        was taken wait for the next one.
+
+        Given a PaneCache, the snapshot also splits off the tree's panes:
+        subtrees whose root is absolutely positioned, or neither grows nor
+        shrinks, at a fixed width and height. Nothing outside a pane can change
+        the layout within it, so each is laid out as a tree of its own, in
+        parallel with the rest given a thread pool, while the main tree only
+        sees a leaf of the pane's size in its place. A pane which hasn't
+        changed since the cached layout isn't copied or laid out at all.
+     */
+    class LayoutSnapshot
+    {
+    public:
+        //==============================================================================
+        /** The layout within a pane, as of the pane's layout revision. */
+        struct PaneLayout
+        {
+            juce::uint64 revision = 0;
+            YGDirection direction = YGDirectionLTR;
+            std::vector<std::pair<ViewId, juce::Rectangle<float>>> bounds;
+        };
+
+        /** The latest layout of each pane, by the view id of the pane's root. */
+        typedef std::unordered_map<ViewId, PaneLayout> PaneCache;
+
+        //==============================================================================
+        /** Copies the tree under the given shadow view, to be laid out at the given
+            size, splitting off its panes if given a cache of their layouts. Call
+            on the message thread.
+         */
+        LayoutSnapshot (ShadowView& root, float width, float height, const PaneCache* cache = nullptr)
+            : paneCache(cache)
+        {
+            trees.push_back(std::make_unique<Tree>());
+            trees[0]->width = width;
+            trees[0]->height = height;
+            trees[0]->rootNode = copyNode(root, *trees[0], YGDirectionLTR, true);
+        }
+
+        //==============================================================================
+        /** Computes the layout of the copy and records the bounds of each view.
+            Call on any one thread at a time.
+
+            Given a thread pool, the panes are laid out on its threads while this
+            one lays out the main tree, and then helps with whatever panes are
+            left. Each tree is a Yoga tree of its own, so they never touch.
+         */
+        void calculate (juce::ThreadPool* pool = nullptr)
+        {
+            BLUEPRINT_TRACE_SCOPE("calculateLayout");
+
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            auto work = std::make_shared<PaneWork>();
+
+            for (size_t i = 1; i < trees.size(); ++i)
+                if (trees[i]->rootNode != nullptr)
+                    work->panes.push_back(trees[i].get());
+
+            if (pool != nullptr && !work->panes.empty())
+            {
+                // Jobs which start too late to find a pane left only touch the
+                // shared work, which they keep alive.
+                const auto numJobs = juce::jmin(work->panes.size(), (size_t) pool->getNumThreads());
+
+                for (size_t i = 0; i < numJobs; ++i)
+                    pool->addJob([work]() { work->run(); });
+            }
+
+            trees[0]->calculate();
+            work->run();
+
+            if (!work->panes.empty())
+                work->finished.wait(-1);
+
+            size_t numBounds = 0;
+
+            for (const auto& tree : trees)
+                numBounds += tree->bounds.size();
+
+            bounds.reserve(numBounds);
+
+            for (const auto& tree : trees)
+                for (const auto& [viewId, rect] : tree->bounds)
+                    bounds[viewId] = rect;
+
+            calculationMs = juce::Time::getMillisecondCounterHiRes() - start;
+        }
+
+        /** Returns how long `calculate` took, in milliseconds. */
+        double getCalculationMs() const { return calculationMs; }
+
+        /** Returns the number of times `calculate` measured text. */
+        int getNumTextMeasures() const
+        {
+            int numMeasures = 0;
+
+            for (const auto& text : texts)
+                numMeasures += text->numMeasures;
+
+            return numMeasures;
+        }
+
+        /** Moves the views under the given shadow view to their computed bounds,
+            returning the number of views moved. Call on the message thread, once
+            `calculate` has returned.
+         */
+        int apply (ShadowView& shadowView, LayoutAnimator* animator) const
+        {
+            // A hidden subtree keeps its views' last bounds.
+            if (!shadowView.isDisplayed())
+                return 0;
+
+            int numApplied = 0;
+            const auto it = bounds.find(shadowView.getAssociatedView()->getViewId());
+
+            if (it != bounds.end())
+            {
+                shadowView.applyComputedLayout(it->second, animator);
+                ++numApplied;
+            }
+
+            for (auto* child : shadowView.getChildren())
+                numApplied += apply(*child, animator);
+
+            return numApplied;
+        }
+
+        /** Replaces the contents of the given cache with the layout of every pane
+            in the snapshot. Call on the message thread, once `calculate` has
+            returned.
+         */
+        void updatePaneCache (PaneCache& cache) const
+        {
+            PaneCache updated;
+
+            for (size_t i = 1; i < trees.size(); ++i)
+            {
+                auto& layout = updated[trees[i]->viewId];
+                layout.revision = trees[i]->revision;
+                layout.direction = trees[i]->direction;
+                layout.bounds = trees[i]->bounds;
+            }
+
+            cache.swap(updated);
+        }
+
+    private:
+        //==============================================================================
+        /** The text of a text node, which the copy measures in place of the view. */
+        struct MeasuredText
+        {
+            juce::AttributedString text;
+            juce::TextLayout layout;
+            float layoutWidth = -1.0f;
+            int numMeasures = 0;
+        };
+
+        /** One of the Yoga trees the snapshot lays out: the main tree, or a pane.
+            A pane's root takes its bounds from its leaf in the main tree, so it
+            only records those of the views within it.
+         */
+        struct Tree
+        {
+            ~Tree()
+            {
+                if (rootNode != nullptr)
+                    YGNodeFreeRecursive(rootNode);
+            }
+
+            void calculate()
+            {
+                BLUEPRINT_TRACE_SCOPE("YGNodeCalculateLayout", viewId);
+                YGNodeCalculateLayout(rootNode, width, height, direction);
+
+                for (const auto& [viewId, node] : nodes)
+                {
+                    bounds.emplace_back(viewId, juce::Rectangle<float> {
+                        YGNodeLayoutGetLeft(node),
+                        YGNodeLayoutGetTop(node),
+                        YGNodeLayoutGetWidth(node),
+                        YGNodeLayoutGetHeight(node)
+                    });
+                }
+            }
+
+            ViewId viewId = 0;
+            juce::uint64 revision = 0;
+            YGDirection direction = YGDirectionInherit;
+
+            // A pane sizes itself from its own style.
+            float width = YGUndefined;
+            float height = YGUndefined;
+
+            // Null for a pane whose cached layout is still good.
+            YGNodeRef rootNode = nullptr;
+            std::vector<std::pair<ViewId, YGNodeRef>> nodes;
+            std::vector<std::pair<ViewId, juce::Rectangle<float>>> bounds;
+        };
+
+        /** The panes left to lay out, shared by every thread laying them out. */
+        struct PaneWork
+        {
+            void run()
+            {
+                for (size_t i = next++; i < panes.size(); i = next++)
+                {
+                    panes[i]->calculate();
+
+                    if (++numFinished == panes.size())
+                        finished.signal();
+                }
+            }
+
+            std::vector<Tree*> panes;
+            std::atomic<size_t> next { 0 };
+            std::atomic<size_t> numFinished { 0 };
+            juce::WaitableEvent finished;
+        };
+
+        /** Returns true if nothing outside the subtree under the given node can
+            change the layout within it: the node is absolutely positioned, or
+            neither grows nor shrinks, and its size resolves to the same points
+            wherever it sits.
+         */
+        static bool isPaneRoot (YGNodeRef node, const ShadowView& shadowView)
+        {
+            if (shadowView.getChildren().empty())
+                return false;
+
+            if (YGNodeStyleGetWidth(node).unit != YGUnitPoint || YGNodeStyleGetHeight(node).unit != YGUnitPoint)
+                return false;
+
+            for (const auto value : { YGNodeStyleGetMinWidth(node), YGNodeStyleGetMinHeight(node),
+                                      YGNodeStyleGetMaxWidth(node), YGNodeStyleGetMaxHeight(node) })
+                if (value.unit == YGUnitPercent)
+                    return false;
+
+            // Percentage padding resolves against the parent's width.
+            for (int edge = YGEdgeLeft; edge <= YGEdgeAll; ++edge)
+                if (YGNodeStyleGetPadding(node, static_cast<YGEdge>(edge)).unit == YGUnitPercent)
+                    return false;
+
+            if (YGNodeStyleGetPositionType(node) == YGPositionTypeAbsolute)
+                return true;
+
+            return YGFloatIsUndefined(YGNodeStyleGetFlex(node))
+                && YGNodeStyleGetFlexGrow(node) == 0.0f
+                && YGNodeStyleGetFlexShrink(node) == 0.0f;
+        }
+
+        /** Copies the subtree under the given shadow view into the given tree,
+            with the direction it inherits. A tree's root doesn't record its own
+            bounds unless it's the main tree's.
+         */
+        YGNodeRef copyNode (ShadowView& shadowView, Tree& tree, YGDirection direction, bool isTreeRoot = false)
+        {
+            auto node = YGNodeNewWithConfig(ShadowView::getConfigForNewNodes());
+            YGNodeCopyStyle(node, shadowView.getYogaNode());
+
+            const auto viewId = shadowView.getAssociatedView()->getViewId();
+            const bool isMainTree = &tree == trees[0].get();
+
+            if (!isTreeRoot || isMainTree)
+                tree.nodes.emplace_back(viewId, node);
+
+            // The main tree sees a pane as a leaf of the same style.
+            if (paneCache != nullptr && isMainTree && !isTreeRoot && isPaneRoot(node, shadowView))
+            {
+                splitPane(shadowView, viewId, direction);
+                return node;
+            }
+
+            if (YGNodeStyleGetDirection(node) != YGDirectionInherit)
+                direction = YGNodeStyleGetDirection(node);
+
+            if (shadowViewCast<TextShadowView>(&shadowView) != nullptr)
+            {
+                if (auto* textView = viewCast<TextView>(shadowView.getAssociatedView()))
+                {
+                    texts.push_back(std::make_unique<MeasuredText>());
+                    texts.back()->text = textView->createAttributedString();
+
+                    YGNodeSetContext(node, texts.back().get());
+                    YGNodeSetMeasureFunc(node, measureCopiedText);
+                }
+
+                return node;
+            }
+
+            if (auto* measured = shadowViewCast<MeasuredShadowView>(&shadowView))
+            {
+                naturalBounds.push_back(std::make_unique<juce::Rectangle<float>>(measured->getNaturalBounds()));
+
+                YGNodeSetContext(node, naturalBounds.back().get());
+                YGNodeSetMeasureFunc(node, measureCopiedIntrinsicSize);
+
+                return node;
+            }
+
+            const auto& children = shadowView.getChildren();
+
+            for (size_t i = 0; i < children.size(); ++i)
+                YGNodeInsertChild(node, copyNode(*children[i], tree, direction), static_cast<uint32_t>(i));
+
+            return node;
+        }
+
+        /** Adds a tree for the pane under the given shadow view, copied unless
+            its cached layout is still good.
+         */
+        void splitPane (ShadowView& shadowView, ViewId viewId, YGDirection direction)
+        {
+            trees.push_back(std::make_unique<Tree>());
+            auto& pane = *trees.back();
+
+            pane.viewId = viewId;
+            pane.revision = shadowView.getLayoutRevision();
+            pane.direction = direction;
+
+            const auto it = paneCache->find(viewId);
+
+            if (it != paneCache->end() && it->second.revision == pane.revision && it->second.direction == direction)
+            {
+                pane.bounds = it->second.bounds;
+                return;
+            }
+
+            pane.rootNode = copyNode(shadowView, pane, direction, true);
+        }
+
+        static YGSize measureCopiedText (YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+        {
+            if (widthMode == YGMeasureModeExactly && heightMode == YGMeasureModeExactly)
+                return { width, height };
+
+            auto* measured = static_cast<MeasuredText*>(YGNodeGetContext(node));
+            measured->numMeasures++;
+
+            return measureTextLayout([measured](float layoutWidth) -> const juce::TextLayout& {
+                if (measured->layoutWidth != layoutWidth)
+                {
+                    measured->layout.createLayout(measured->text, layoutWidth);
+                    measured->layoutWidth = layoutWidth;
+                }
+
+                return measured->layout;
+            }, width, widthMode, height, heightMode);
+        }
+
+        static YGSize measureCopiedIntrinsicSize (YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+        {
+            const auto* natural = static_cast<const juce::Rectangle<float>*>(YGNodeGetContext(node));
+            return measureIntrinsicSize(*natural, width, widthMode, height, heightMode);
+        }
+
+        //==============================================================================
+        const PaneCache* paneCache;
+
+        // The main tree first, then the panes.
+        std::vector<std::unique_ptr<Tree>> trees;
+        std::vector<std::unique_ptr<MeasuredText>> texts;
+        std::vector<std::unique_ptr<juce::Rectangle<float>>> naturalBounds;
+
+        std::unordered_map<ViewId, juce::Rectangle<float>> bounds;
+        double calculationMs = 0.0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LayoutSnapshot)
+    };
+
+}
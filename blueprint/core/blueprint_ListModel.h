@@ -0,0 +1,363 @@
+/*
+  ==============================================================================
+
+    blueprint_ListModel.h
+    Created: 15 Oct 2026 8:33:10pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A large list, such as a preset browser's, held natively and searched and
+        sorted off the message thread, of which JavaScript only ever sees the
+        window it's showing.
+
+        Each item is a row of strings, one per column. Setting the items builds
+        a search index, on the model's own thread: every item's searchable
+        columns, lowercased, and a trigram index over them, along with each
+        column's order for sorting.
+
+        A query is a search text and a column to sort by. The text's words must
+        each appear in an item for it to match: a word of three or more
+        characters anywhere, found through the trigrams of the word, and a
+        shorter one at the start of any word of the item. Items match in the
+        column's order, or their own without one. The query runs on the model's
+        thread; a new query stops one still running, and only the latest query's
+        results ever show.
+
+        Register the model with a root through `registerListModel`, and JavaScript
+        gets at it through `getListModel(name)`, which queries it and reads slices
+        of the results, such as the rows a VirtualList has in view. Results are
+        read from any thread, and the root hears of new ones on the message
+        thread, through the callback it sets.
+     */
+    class ListModel
+    {
+    public:
+        //==============================================================================
+        /** One item: a string for each of the model's columns. */
+        using Item = std::vector<juce::String>;
+
+        /** The results of the latest query, along with the items they index. */
+        struct Results
+        {
+            std::shared_ptr<const std::vector<Item>> items;
+            std::vector<juce::uint32> matches;
+        };
+
+        /** Called on the message thread once new results are in. */
+        using ResultsCallback = std::function<void()>;
+
+        /** Creates a model of the given columns, searching those given, or all of
+            them if none are.
+         */
+        explicit ListModel (juce::StringArray _columns, juce::StringArray searchColumns = {})
+            : columns(std::move(_columns))
+        {
+            for (int i = 0; i < columns.size(); ++i)
+                if (searchColumns.isEmpty() || searchColumns.contains(columns[i]))
+                    searchedColumns.push_back(i);
+        }
+
+        //==============================================================================
+        /** Replaces the items, from any thread, then rebuilds the index and runs
+            the latest query again on the model's thread.
+         */
+        void setItems (std::vector<Item> newItems)
+        {
+            auto items = std::make_shared<const std::vector<Item>>(std::move(newItems));
+            const auto generation = ++latestGeneration;
+
+            pool.addJob([this, items, generation]() {
+                auto index = buildIndex(items);
+
+                {
+                    const juce::ScopedLock sl (lock);
+                    currentIndex = std::move(index);
+                }
+
+                runQuery(generation);
+            });
+        }
+
+        /** Sets the query, from any thread: a search text, and the column to sort
+            by, if any, in either direction.
+         */
+        void setQuery (const juce::String& text, const juce::String& sortColumn = {}, bool descending = false)
+        {
+            {
+                const juce::ScopedLock sl (lock);
+                query = { text.toLowerCase().trim(), columns.indexOf(sortColumn), descending };
+            }
+
+            const auto generation = ++latestGeneration;
+            pool.addJob([this, generation]() { runQuery(generation); });
+        }
+
+        /** Sets the callback told of new results, on the message thread. */
+        void setResultsCallback (ResultsCallback callback)
+        {
+            const juce::ScopedLock sl (lock);
+            resultsCallback = std::move(callback);
+        }
+
+        //==============================================================================
+        /** Returns the latest results. */
+        std::shared_ptr<const Results> getResults() const
+        {
+            const juce::ScopedLock sl (lock);
+            return results;
+        }
+
+        /** Returns the number of items matching the latest query. */
+        int getNumResults() const
+        {
+            auto r = getResults();
+            return r != nullptr ? static_cast<int>(r->matches.size()) : 0;
+        }
+
+        /** Returns the model's columns. */
+        const juce::StringArray& getColumns() const { return columns; }
+
+    private:
+        //==============================================================================
+        struct Index
+        {
+            std::shared_ptr<const std::vector<Item>> items;
+            std::vector<juce::String> text;
+            std::unordered_map<juce::uint64, std::vector<juce::uint32>> trigrams;
+            std::vector<std::vector<juce::uint32>> orders;
+        };
+
+        struct Query
+        {
+            juce::String text;
+            int sortColumn = -1;
+            bool descending = false;
+        };
+
+        //==============================================================================
+        static juce::uint64 trigramKey (juce::juce_wchar a, juce::juce_wchar b, juce::juce_wchar c)
+        {
+            // Code points take 21 bits.
+            return ((juce::uint64) a << 42) | ((juce::uint64) b << 21) | (juce::uint64) c;
+        }
+
+        std::shared_ptr<const Index> buildIndex (std::shared_ptr<const std::vector<Item>> items) const
+        {
+            auto index = std::make_shared<Index>();
+            const auto numItems = static_cast<juce::uint32>(items->size());
+
+            index->text.reserve(numItems);
+
+            for (juce::uint32 i = 0; i < numItems; ++i)
+            {
+                const auto& item = (*items)[i];
+                juce::String text;
+
+                for (auto column : searchedColumns)
+                    if (column < (int) item.size())
+                        text << item[static_cast<size_t>(column)].toLowerCase() << '\n';
+
+                const auto chars = juce::Array<juce::juce_wchar>(text.toUTF32().getAddress(), text.length());
+
+                for (int c = 0; c + 2 < chars.size(); ++c)
+                {
+                    auto& postings = index->trigrams[trigramKey(chars[c], chars[c + 1], chars[c + 2])];
+
+                    // An item repeating a trigram is listed once.
+                    if (postings.empty() || postings.back() != i)
+                        postings.push_back(i);
+                }
+
+                index->text.push_back(std::move(text));
+            }
+
+            index->orders.resize(static_cast<size_t>(columns.size()));
+
+            for (size_t column = 0; column < index->orders.size(); ++column)
+            {
+                auto& order = index->orders[column];
+                order.resize(numItems);
+
+                for (juce::uint32 i = 0; i < numItems; ++i)
+                    order[i] = i;
+
+                const juce::String none;
+
+                auto key = [&items, &none, column](juce::uint32 i) -> const juce::String& {
+                    const auto& item = (*items)[i];
+                    return column < item.size() ? item[column] : none;
+                };
+
+                std::stable_sort(order.begin(), order.end(), [&key](juce::uint32 a, juce::uint32 b) {
+                    return key(a).compareNatural(key(b)) < 0;
+                });
+            }
+
+            index->items = std::move(items);
+            return index;
+        }
+
+        /** Runs the latest query against the latest index, giving up as soon as
+            another generation supersedes this one.
+         */
+        void runQuery (juce::uint32 generation)
+        {
+            std::shared_ptr<const Index> index;
+            Query q;
+
+            {
+                const juce::ScopedLock sl (lock);
+                index = currentIndex;
+                q = query;
+            }
+
+            if (index == nullptr)
+                return;
+
+            const auto words = juce::StringArray::fromTokens(q.text, " \t", "");
+            const auto numItems = static_cast<juce::uint32>(index->text.size());
+
+            // Candidates come from the trigrams of the longest word; each is then
+            // checked against every word.
+            const juce::String* longest = nullptr;
+
+            for (auto& w : words)
+                if (w.length() >= 3 && (longest == nullptr || w.length() > longest->length()))
+                    longest = &w;
+
+            std::vector<juce::uint32> candidates;
+
+            if (longest != nullptr)
+                candidates = getTrigramCandidates(*index, *longest);
+            else
+                for (juce::uint32 i = 0; i < numItems; ++i)
+                    candidates.push_back(i);
+
+            std::vector<bool> matched (numItems, false);
+
+            for (size_t n = 0; n < candidates.size(); ++n)
+            {
+                if ((n & 1023) == 0 && latestGeneration.load() != generation)
+                    return;
+
+                const auto& text = index->text[candidates[n]];
+                bool matches = true;
+
+                for (auto& w : words)
+                    if (!(w.length() >= 3 ? text.contains(w) : containsWordPrefix(text, w)))
+                        matches = false;
+
+                matched[candidates[n]] = matches;
+            }
+
+            auto r = std::make_shared<Results>();
+            r->items = index->items;
+
+            if (juce::isPositiveAndBelow(q.sortColumn, (int) index->orders.size()))
+            {
+                for (auto i : index->orders[static_cast<size_t>(q.sortColumn)])
+                    if (matched[i])
+                        r->matches.push_back(i);
+
+                if (q.descending)
+                    std::reverse(r->matches.begin(), r->matches.end());
+            }
+            else
+            {
+                for (juce::uint32 i = 0; i < numItems; ++i)
+                    if (matched[i])
+                        r->matches.push_back(i);
+            }
+
+            ResultsCallback callback;
+
+            {
+                const juce::ScopedLock sl (lock);
+
+                if (latestGeneration.load() != generation)
+                    return;
+
+                results = std::move(r);
+                callback = resultsCallback;
+            }
+
+            if (callback != nullptr)
+                juce::MessageManager::callAsync(std::move(callback));
+        }
+
+        /** Returns the items holding every trigram of the given word, in order. */
+        static std::vector<juce::uint32> getTrigramCandidates (const Index& index, const juce::String& word)
+        {
+            const auto chars = juce::Array<juce::juce_wchar>(word.toUTF32().getAddress(), word.length());
+            std::vector<const std::vector<juce::uint32>*> lists;
+
+            for (int c = 0; c + 2 < chars.size(); ++c)
+            {
+                auto it = index.trigrams.find(trigramKey(chars[c], chars[c + 1], chars[c + 2]));
+
+                if (it == index.trigrams.end())
+                    return {};
+
+                lists.push_back(&it->second);
+            }
+
+            // Intersecting from the shortest list keeps every step small.
+            std::sort(lists.begin(), lists.end(), [](auto* a, auto* b) { return a->size() < b->size(); });
+
+            std::vector<juce::uint32> result (*lists.front());
+            std::vector<juce::uint32> next;
+
+            for (size_t l = 1; l < lists.size() && !result.empty(); ++l)
+            {
+                next.clear();
+                std::set_intersection(result.begin(), result.end(), lists[l]->begin(), lists[l]->end(), std::back_inserter(next));
+                result.swap(next);
+            }
+
+            return result;
+        }
+
+        static bool containsWordPrefix (const juce::String& text, const juce::String& word)
+        {
+            for (int pos = text.indexOf(word); pos >= 0; pos = text.indexOf(pos + 1, word))
+                if (pos == 0 || !juce::CharacterFunctions::isLetterOrDigit(text[pos - 1]))
+                    return true;
+
+            return false;
+        }
+
+        //==============================================================================
+        const juce::StringArray columns;
+        std::vector<int> searchedColumns;
+
+        juce::CriticalSection lock;
+        std::shared_ptr<const Index> currentIndex;
+        std::shared_ptr<const Results> results;
+        Query query;
+        ResultsCallback resultsCallback;
+        std::atomic<juce::uint32> latestGeneration { 0 };
+
+        // Last, so that it stops, finishing any job, before the rest goes.
+        juce::ThreadPool pool { 1 };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ListModel)
+    };
+
+}
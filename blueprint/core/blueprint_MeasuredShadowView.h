@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    blueprint_MeasuredShadowView.h
+    Created: 15 Oct 2026 8:03:27pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+
+#include "blueprint_ShadowView.h"
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Fits content of the given natural size to Yoga's measure constraints,
+        keeping its aspect ratio wherever the constraints leave it free to.
+
+        A dimension given exactly is taken as it is, and the other follows it
+        in proportion; otherwise the content takes its natural size, scaled
+        down as a whole to fit within any `AtMost` bounds.
+     */
+    inline YGSize measureIntrinsicSize (juce::Rectangle<float> natural, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+    {
+        const bool exactWidth = widthMode == YGMeasureModeExactly;
+        const bool exactHeight = heightMode == YGMeasureModeExactly;
+
+        if (exactWidth && exactHeight)
+            return { width, height };
+
+        const float w0 = natural.getWidth();
+        const float h0 = natural.getHeight();
+
+        if (w0 <= 0.0f || h0 <= 0.0f)
+            return { exactWidth ? width : 0.0f, exactHeight ? height : 0.0f };
+
+        YGSize result;
+
+        if (exactWidth)
+        {
+            result.width = width;
+            result.height = width * h0 / w0;
+        }
+        else if (exactHeight)
+        {
+            result.width = height * w0 / h0;
+            result.height = height;
+        }
+        else
+        {
+            float scale = 1.0f;
+
+            if (widthMode == YGMeasureModeAtMost && w0 > width)
+                scale = width / w0;
+
+            if (heightMode == YGMeasureModeAtMost && h0 * scale > height)
+                scale = height / h0;
+
+            return { w0 * scale, h0 * scale };
+        }
+
+        // The dimension following the exact one still keeps to its own bounds.
+        if (widthMode == YGMeasureModeAtMost)
+            result.width = std::min(result.width, width);
+
+        if (heightMode == YGMeasureModeAtMost)
+            result.height = std::min(result.height, height);
+
+        return result;
+    }
+
+    //==============================================================================
+    /** The MeasuredShadowView class gives a leaf of the layout, such as an image,
+        an intrinsic size: where its style leaves its width or height to its
+        content, Yoga sizes it from the natural bounds its measure function
+        returns, keeping their aspect ratio.
+
+        The core ImageView measures by its drawable. A custom view type gets the
+        same by returning a MeasuredShadowView from its registered factory:
+
+            `auto shadowView = std::make_unique<MeasuredShadowView>(view.get(), [v = view.get()]() { return v->getNaturalBounds(); });`
+
+        The measure function runs on the message thread, during layout; when
+        what it returns changes, the view calls `intrinsicSizeChanged` so that
+        the root measures it again.
+     */
+    class MeasuredShadowView : public ShadowView
+    {
+    public:
+        //==============================================================================
+        /** Returns the content's natural bounds, or empty ones for no content. */
+        using MeasureFn = std::function<juce::Rectangle<float> ()>;
+
+        static constexpr Kind shadowViewKind = Kind::Measured;
+
+        MeasuredShadowView (View* _view, MeasureFn fn)
+            : ShadowView(_view, shadowViewKind), measureFn(std::move(fn))
+        {
+            jassert (measureFn != nullptr);
+            installMeasureFunc();
+        }
+
+        //==============================================================================
+        /** Resets the node, which also clears our measure function. */
+        void resetForReuse() override
+        {
+            ShadowView::resetForReuse();
+            installMeasureFunc();
+        }
+
+        /** A measured node is a leaf; Yoga can't measure a node with children. */
+        void addChild (ShadowView* childView, int index = -1) override
+        {
+            if (childView != nullptr)
+                throw std::logic_error("MeasuredShadowView cannot take children.");
+        }
+
+        //==============================================================================
+        /** Returns the content's natural bounds, from the measure function. */
+        juce::Rectangle<float> getNaturalBounds() const { return measureFn(); }
+
+        /** Returns true if the node's width and height are both given in points,
+            so that Yoga never measures it.
+         */
+        bool hasFixedSize() const
+        {
+            return YGNodeStyleGetWidth(yogaNode).unit == YGUnitPoint
+                && YGNodeStyleGetHeight(yogaNode).unit == YGUnitPoint;
+        }
+
+        /** Tells Yoga to measure the node again at the next layout. */
+        void markDirty()
+        {
+            YGNodeMarkDirty(yogaNode);
+            markLayoutChanged();
+        }
+
+    private:
+        //==============================================================================
+        void installMeasureFunc()
+        {
+            YGNodeSetContext(yogaNode, this);
+            YGNodeSetMeasureFunc(yogaNode, measureNode);
+        }
+
+        static YGSize measureNode (YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+        {
+            auto* shadowView = static_cast<MeasuredShadowView*>(YGNodeGetContext(node));
+            return measureIntrinsicSize(shadowView->getNaturalBounds(), width, widthMode, height, heightMode);
+        }
+
+        //==============================================================================
+        MeasureFn measureFn;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeasuredShadowView)
+    };
+
+}
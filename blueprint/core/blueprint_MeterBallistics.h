@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    blueprint_MeterBallistics.h
+    Created: 15 Oct 2026 8:21:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The ballistics of one meter channel: a level which rises with an attack
+        time and falls with a release time, a peak which holds before falling at
+        a steady rate, and a clip indicator.
+
+        Feed it the latest raw level, a linear gain as realtime code would write
+        to a ValueChannel, once a display frame with the time since the last
+        frame; the motion then follows the frame rate rather than how often
+        the audio side happens to write. Everything runs on the one thread that
+        processes and reads it, typically the message thread.
+     */
+    class MeterBallistics
+    {
+    public:
+        //==============================================================================
+        struct Settings
+        {
+            /** Time constants of the level's rise and fall, in milliseconds; an
+                attack of 0 follows a rising input at once.
+             */
+            float attackMs = 0.0f;
+            float releaseMs = 300.0f;
+
+            /** How long a peak holds, in milliseconds, before falling at the
+                given rate in decibels per second.
+             */
+            float peakHoldMs = 1000.0f;
+            float peakFallDecibelsPerSecond = 20.0f;
+
+            /** The linear level counted as a clip, and how long the indicator
+                stays lit after one, in milliseconds; 0 latches it until reset.
+             */
+            float clipLevel = 1.0f;
+            float clipHoldMs = 0.0f;
+        };
+
+        MeterBallistics() = default;
+
+        //==============================================================================
+        void setSettings (const Settings& newSettings) { settings = newSettings; }
+        const Settings& getSettings() const { return settings; }
+
+        /** Moves the meter on by the given time towards the given raw level.
+            Returns true if anything shown by the meter changed.
+         */
+        bool process (float input, double elapsedMs)
+        {
+            input = std::isfinite(input) ? std::abs(input) : 0.0f;
+
+            const auto dt = (float) juce::jlimit(0.0, maxStepMs, elapsedMs);
+            const float previousLevel = level;
+            const float previousPeak = peak;
+            const bool previousClip = clipped;
+
+            // Level: a one pole follower, with its time constant picked by the
+            // direction it's going.
+            const float timeMs = input > level ? settings.attackMs : settings.releaseMs;
+
+            if (timeMs <= 0.0f)
+                level = input;
+            else
+                level += (input - level) * (1.0f - std::exp(-dt / timeMs));
+
+            if (level < silence)
+                level = 0.0f;
+
+            // Peak: held for a while, then falling in decibels.
+            if (input >= peak)
+            {
+                peak = input;
+                peakHoldRemainingMs = settings.peakHoldMs;
+            }
+            else if (peakHoldRemainingMs > 0.0f)
+            {
+                peakHoldRemainingMs -= dt;
+            }
+            else if (peak > 0.0f)
+            {
+                peak *= juce::Decibels::decibelsToGain(-settings.peakFallDecibelsPerSecond * dt / 1000.0f);
+
+                if (peak < silence)
+                    peak = 0.0f;
+            }
+
+            // Clip: lit by any input at the clip level.
+            if (input >= settings.clipLevel)
+            {
+                clipped = true;
+                clipHoldRemainingMs = settings.clipHoldMs;
+            }
+            else if (clipped && settings.clipHoldMs > 0.0f)
+            {
+                clipHoldRemainingMs -= dt;
+                clipped = clipHoldRemainingMs > 0.0f;
+            }
+
+            return !juce::approximatelyEqual(level, previousLevel)
+                || !juce::approximatelyEqual(peak, previousPeak)
+                || clipped != previousClip;
+        }
+
+        /** Puts out the clip indicator. */
+        void resetClip() { clipped = false; }
+
+        /** Returns the meter to silence. */
+        void reset()
+        {
+            level = peak = 0.0f;
+            peakHoldRemainingMs = clipHoldRemainingMs = 0.0f;
+            clipped = false;
+        }
+
+        //==============================================================================
+        float getLevel() const { return level; }
+        float getPeak() const { return peak; }
+        bool isClipped() const { return clipped; }
+
+    private:
+        //==============================================================================
+        // A gap of frames, e.g. while the window was hidden, resumes from where
+        // the meter was rather than jumping all the way to the new level.
+        static constexpr double maxStepMs = 100.0;
+
+        // Roughly -140dB; below this the meter has gone quiet.
+        static constexpr float silence = 1.0e-7f;
+
+        Settings settings;
+        float level = 0.0f;
+        float peak = 0.0f;
+        float peakHoldRemainingMs = 0.0f;
+        float clipHoldRemainingMs = 0.0f;
+        bool clipped = false;
+    };
+
+}
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    blueprint_MeterView.cpp
+    Created: 15 Oct 2026 8:21:37pm
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    void MeterView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+        getPropertyTable().apply(*this, name, v);
+    }
+
+    const ViewPropertyTable<MeterView>& MeterView::getPropertyTable()
+    {
+        typedef ViewPropertyTable<MeterView> Table;
+
+        static constexpr Table::Entry entries[] = {
+            { "source", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.sourceName = v.toString();
+                m.lastFrameTime = 0.0;
+
+                if (m.sourceName.isNotEmpty())
+                    m.scheduler.scheduleFrame();
+                else
+                    m.scheduler.cancel();
+            }},
+            { "channel", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.firstChannel = juce::jmax(0, (int) v);
+            }},
+            { "channel-count", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.bars.resize(static_cast<size_t>(juce::jlimit(1, 64, (int) v)));
+                m.updateSettings();
+            }},
+            { "min-decibels", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.minDecibels = (float) v;
+            }},
+            { "max-decibels", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.maxDecibels = (float) v;
+            }},
+            { "orientation", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.horizontal = v.toString() == "horizontal";
+            }},
+            { "attack", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.settings.attackMs = juce::jmax(0.0f, (float) v);
+                m.updateSettings();
+            }},
+            { "release", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.settings.releaseMs = juce::jmax(0.0f, (float) v);
+                m.updateSettings();
+            }},
+            { "peak-hold", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.settings.peakHoldMs = juce::jmax(0.0f, (float) v);
+                m.updateSettings();
+            }},
+            { "peak-fall", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.settings.peakFallDecibelsPerSecond = juce::jmax(0.0f, (float) v);
+                m.updateSettings();
+            }},
+            { "clip-level", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.settings.clipLevel = juce::Decibels::decibelsToGain((float) v);
+                m.updateSettings();
+            }},
+            { "clip-hold", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.settings.clipHoldMs = juce::jmax(0.0f, (float) v);
+                m.updateSettings();
+            }},
+            { "bar-spacing", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.barSpacing = juce::jmax(0.0f, (float) v);
+            }},
+            { "track-color", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.trackColour = parseColourValue(v);
+            }},
+            { "fill-color", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.fillColour = parseColourValue(v);
+            }},
+            { "peak-color", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.peakColour = parseColourValue(v);
+            }},
+            { "clip-color", Table::ConsumedByView, [](MeterView& m, const juce::var& v) {
+                m.clipColour = parseColourValue(v);
+            }},
+        };
+
+        static const Table table (entries);
+        return table;
+    }
+
+    void MeterView::resetForReuse()
+    {
+        View::resetForReuse();
+
+        sourceName = {};
+        scheduler.cancel();
+
+        for (auto& bar : bars)
+            bar.reset();
+    }
+
+    //==============================================================================
+    void MeterView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("MeterView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "MeterView");
+
+        View::paint(g);
+
+        for (int i = 0; i < (int) bars.size(); ++i)
+        {
+            const auto& bar = bars[static_cast<size_t>(i)];
+            auto area = getBarBounds(i);
+
+            if (area.isEmpty())
+                continue;
+
+            // The clip indicator takes the far end of the bar.
+            const float clipLength = juce::jmin(4.0f, (horizontal ? area.getWidth() : area.getHeight()) * 0.1f);
+            const auto clipArea = horizontal ? area.removeFromRight(clipLength) : area.removeFromTop(clipLength);
+
+            g.setColour(bar.isClipped() ? clipColour : trackColour);
+            g.fillRect(clipArea);
+
+            g.setColour(trackColour);
+            g.fillRect(area);
+
+            const float levelLength = levelToProportion(bar.getLevel()) * (horizontal ? area.getWidth() : area.getHeight());
+
+            g.setColour(fillColour);
+            g.fillRect(horizontal ? area.withWidth(levelLength)
+                                  : area.withTop(area.getBottom() - levelLength));
+
+            if (bar.getPeak() > 0.0f)
+            {
+                const float peakProportion = levelToProportion(bar.getPeak());
+
+                g.setColour(peakColour);
+
+                if (horizontal)
+                    g.fillRect(juce::Rectangle<float>(area.getX() + peakProportion * area.getWidth() - 1.0f, area.getY(), 1.0f, area.getHeight()));
+                else
+                    g.fillRect(juce::Rectangle<float>(area.getX(), area.getBottom() - peakProportion * area.getHeight(), area.getWidth(), 1.0f));
+            }
+        }
+    }
+
+    void MeterView::mouseDown (const juce::MouseEvent& e)
+    {
+        View::mouseDown(e);
+
+        for (auto& bar : bars)
+            bar.resetClip();
+
+        repaint();
+    }
+
+    //==============================================================================
+    void MeterView::frameCallback()
+    {
+        if (sourceName.isEmpty())
+            return;
+
+        const double now = juce::Time::getMillisecondCounterHiRes();
+        const double elapsedMs = lastFrameTime > 0.0 ? now - lastFrameTime : 0.0;
+        lastFrameTime = now;
+
+        ReactApplicationRoot* root = getOwningRoot();
+
+        if (auto* channel = root != nullptr ? root->getValueChannel(sourceName) : nullptr)
+        {
+            bool changed = false;
+
+            // Live values, as ValueChannel::getLiveValue explains.
+            for (int i = 0; i < (int) bars.size(); ++i)
+            {
+                const int index = firstChannel + i;
+                const float input = index < channel->getNumValues() ? channel->getLiveValue(index) : 0.0f;
+
+                changed = bars[static_cast<size_t>(i)].process(input, elapsedMs) || changed;
+            }
+
+            if (changed)
+                repaint();
+        }
+
+        scheduler.scheduleFrame();
+    }
+
+    juce::Rectangle<float> MeterView::getBarBounds (int bar) const
+    {
+        const auto bounds = getLocalBounds().toFloat();
+        const int numBars = (int) bars.size();
+        const float total = horizontal ? bounds.getHeight() : bounds.getWidth();
+        const float thickness = (total - barSpacing * (float) (numBars - 1)) / (float) numBars;
+
+        if (thickness <= 0.0f)
+            return {};
+
+        const float offset = (float) bar * (thickness + barSpacing);
+
+        return horizontal ? bounds.withY(bounds.getY() + offset).withHeight(thickness)
+                          : bounds.withX(bounds.getX() + offset).withWidth(thickness);
+    }
+
+    float MeterView::levelToProportion (float gain) const
+    {
+        if (maxDecibels <= minDecibels)
+            return 0.0f;
+
+        const float db = juce::Decibels::gainToDecibels(gain, minDecibels);
+        return juce::jlimit(0.0f, 1.0f, (db - minDecibels) / (maxDecibels - minDecibels));
+    }
+
+    void MeterView::updateSettings()
+    {
+        for (auto& bar : bars)
+            bar.setSettings(settings);
+    }
+
+}
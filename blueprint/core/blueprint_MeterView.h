@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    blueprint_MeterView.h
+    Created: 15 Oct 2026 8:21:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "blueprint_FrameScheduler.h"
+#include "blueprint_MeterBallistics.h"
+#include "blueprint_View.h"
+#include "blueprint_ViewPropertyTable.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The MeterView class is a core view which draws level meters from the
+        values of a ValueChannel, with their ballistics applied natively.
+
+        `source` names a channel registered with the root, whose values are
+        linear levels written by the audio thread. The view shows `channel-count`
+        bars (1 by default) from the value at index `channel` on, side by side
+        and `bar-spacing` pixels apart. Once a display frame it reads the latest
+        values, moves each bar's MeterBallistics on by the time since the last
+        frame, and repaints only when a bar has moved. Neither the values nor
+        the motion go through JavaScript, which only configures the meter.
+
+        Levels from `min-decibels` (-60 by default) to `max-decibels` (0) map
+        along each bar, bottom to top, or left to right with a `horizontal`
+        `orientation`. The level rises over `attack` and falls over `release`
+        milliseconds, and the peak holds for `peak-hold` milliseconds before
+        falling at `peak-fall` decibels a second. A level at or over `clip-level`
+        decibels lights the bar's clip indicator for `clip-hold` milliseconds, or
+        with a `clip-hold` of 0, until the meter is clicked.
+
+        Bars draw with `track-color` under `fill-color`, the peak as a line of
+        `peak-color`, and the clip indicator, at the bar's far end, in
+        `clip-color`.
+     */
+    class MeterView : public View
+    {
+    public:
+        //==============================================================================
+        MeterView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        /** The meter's own properties, and how it applies them. */
+        static const ViewPropertyTable<MeterView>& getPropertyTable();
+
+        /** Forgets the source and puts every bar back to silence. */
+        void resetForReuse() override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+        /** Clicking the meter puts out its clip indicators. */
+        void mouseDown (const juce::MouseEvent& e) override;
+
+    private:
+        //==============================================================================
+        /** Reads the latest values into the bars, and waits for the next frame. */
+        void frameCallback();
+
+        /** Returns the given bar's share of the view. */
+        juce::Rectangle<float> getBarBounds (int bar) const;
+
+        /** Returns the proportion along a bar at which the given level shows. */
+        float levelToProportion (float gain) const;
+
+        void updateSettings();
+
+        //==============================================================================
+        juce::String sourceName;
+        int firstChannel = 0;
+        std::vector<MeterBallistics> bars { 1 };
+
+        MeterBallistics::Settings settings;
+        double lastFrameTime = 0.0;
+
+        FrameScheduler scheduler { *this, [this]() { frameCallback(); } };
+
+        float minDecibels = -60.0f;
+        float maxDecibels = 0.0f;
+        bool horizontal = false;
+        float barSpacing = 2.0f;
+
+        juce::Colour trackColour { 0xff626262 };
+        juce::Colour fillColour { 0xff66fdcf };
+        juce::Colour peakColour { 0xffffffff };
+        juce::Colour clipColour { 0xffff4b4b };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeterView)
+    };
+
+}
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    blueprint_MipmapCache.h
+    Created: 15 Oct 2026 9:26:51pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "blueprint_DrawableCache.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The MipmapCache holds pre-filtered, smaller copies of the bitmaps decoded
+        for ImageViews, for drawing a large image small.
+
+        Drawn straight from the full image, a skin's bitmap shown at a fraction
+        of its size is resampled from every source pixel on each paint, which is
+        slow, and aliases, since JUCE's resampling only ever reads the nearest
+        few. Each mip level is half the size of the one above it, made from it
+        with a box filter, and an image is drawn from the smallest level at
+        least as big as it's drawn, so that the resampling reads only about as
+        many pixels as it writes, each of which already averages those it
+        stands for.
+
+        Views showing the same drawable share its levels, which are each made
+        the first time one is needed, and freed with the last view to hold them,
+        so the cache keeps nothing unused for its "mipmaps" budget in the
+        CacheManager to bound; it reports their size there all the same.
+
+        Hold the cache through a juce::SharedResourcePointer<MipmapCache>, and
+        use it and its chains on the message thread.
+     */
+    class MipmapCache : private CacheManager::Cache
+    {
+    public:
+        //==============================================================================
+        /** The mip levels of one bitmap. */
+        class Chain
+        {
+        public:
+            //==============================================================================
+            Chain (DrawableCache::DrawableHandle _drawable, const juce::DrawableImage& drawableImage)
+                : drawable(std::move(_drawable)), imageOpacity(drawableImage.getOpacity())
+            {
+                levels.push_back(drawableImage.getImage());
+            }
+
+            /** Returns true if these are the levels of the given drawable. */
+            bool isFor (const juce::Drawable& d) const { return drawable.get() == &d; }
+
+            /** Returns the bytes of the levels made so far, below the full image,
+                which belongs to the drawable. Safe to call from any thread.
+             */
+            size_t getNumBytes() const { return numBytes; }
+
+            /** Draws the bitmap with the given transform from its drawable's
+                coordinates, from the level which best suits the size it's drawn.
+             */
+            void draw (juce::Graphics& g, const juce::AffineTransform& transform, float opacity)
+            {
+                const auto& full = levels.front();
+
+                // Physical pixels drawn per pixel of the full image.
+                const float scale = std::sqrt(std::abs(transform.getDeterminant()))
+                                        * g.getInternalContext().getPhysicalPixelScaleFactor();
+
+                const int level = scale > 0.0f ? juce::jmax(0, (int) std::floor(std::log2(1.0f / scale))) : 0;
+                const auto& image = getLevel(level);
+
+                juce::Graphics::ScopedSaveState state (g);
+                g.setOpacity(opacity * imageOpacity);
+                g.drawImageTransformed(image, juce::AffineTransform::scale((float) full.getWidth() / (float) image.getWidth(),
+                                                                           (float) full.getHeight() / (float) image.getHeight())
+                                                  .followedBy(transform));
+            }
+
+        private:
+            //==============================================================================
+            /** Returns the given level, or the smallest there is, making those down
+                to it first if need be.
+             */
+            const juce::Image& getLevel (int level)
+            {
+                while ((int) levels.size() <= level)
+                {
+                    const auto& above = levels.back();
+
+                    if (above.getWidth() <= 1 && above.getHeight() <= 1)
+                        break;
+
+                    // Halving with bilinear resampling averages each 2x2 block.
+                    levels.push_back(above.rescaled(juce::jmax(1, (above.getWidth() + 1) / 2),
+                                                    juce::jmax(1, (above.getHeight() + 1) / 2),
+                                                    juce::Graphics::highResamplingQuality));
+
+                    numBytes += static_cast<size_t>(levels.back().getWidth() * levels.back().getHeight()) * 4;
+                }
+
+                return levels[static_cast<size_t>(juce::jmin(level, (int) levels.size() - 1))];
+            }
+
+            //==============================================================================
+            // Holding the drawable keeps it out of the DrawableCache's reach, and
+            // its address from being reused by another.
+            const DrawableCache::DrawableHandle drawable;
+            const float imageOpacity;
+            std::vector<juce::Image> levels;
+            std::atomic<size_t> numBytes { 0 };
+
+            //==============================================================================
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Chain)
+        };
+
+        using ChainHandle = std::shared_ptr<Chain>;
+
+        //==============================================================================
+        MipmapCache() = default;
+
+        //==============================================================================
+        /** Returns the shared mip levels of the given drawable, or nullptr if it
+            isn't a plain bitmap, drawn as it is with nothing over it.
+         */
+        ChainHandle getChain (const DrawableCache::DrawableHandle& drawable)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            auto* image = dynamic_cast<const juce::DrawableImage*>(drawable.get());
+
+            if (image == nullptr || !image->getImage().isValid() || image->isTransformed()
+                || !image->getOverlayColour().isTransparent()
+                || image->getBoundingBox() != juce::Parallelogram<float>(image->getImage().getBounds().toFloat()))
+                return nullptr;
+
+            const juce::ScopedLock sl (lock);
+            auto& entry = chains[image];
+
+            if (auto chain = entry.lock())
+                return chain;
+
+            purgeExpiredChains();
+
+            auto chain = std::make_shared<Chain>(drawable, *image);
+            chains[image] = chain;
+
+            return chain;
+        }
+
+    private:
+        //==============================================================================
+        CacheManager::Stats getCacheStats() override
+        {
+            const juce::ScopedLock sl (lock);
+            CacheManager::Stats stats;
+
+            for (const auto& c : chains)
+            {
+                if (auto chain = c.second.lock())
+                {
+                    ++stats.numEntries;
+                    stats.numBytes += chain->getNumBytes();
+                }
+            }
+
+            stats.budgetBytes = budgetBytes;
+            return stats;
+        }
+
+        void setCacheBudget (size_t numBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+            budgetBytes = numBytes;
+        }
+
+        void trimCache (size_t) override
+        {
+            const juce::ScopedLock sl (lock);
+            purgeExpiredChains();
+        }
+
+        void purgeExpiredChains()
+        {
+            for (auto it = chains.begin(); it != chains.end();)
+            {
+                if (it->second.expired())
+                    it = chains.erase(it);
+                else
+                    ++it;
+            }
+        }
+
+        //==============================================================================
+        juce::CriticalSection lock;
+        std::unordered_map<const juce::Drawable*, std::weak_ptr<Chain>> chains;
+        size_t budgetBytes = 0;
+
+        CacheManager::Registration registration { "mipmaps", *this };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MipmapCache)
+    };
+
+}
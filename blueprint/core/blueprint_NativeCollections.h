@@ -0,0 +1,806 @@
+/*
+  ==============================================================================
+
+    blueprint_NativeCollections.h
+    Created: 15 Oct 2026 4:12:37am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Native Map and Set constructors for Duktape, which has neither, and whose
+        core-js polyfills are a large part of React's commit time.
+
+        A collection keeps its keys in a hash table of our own, in insertion
+        order, and its JavaScript keys and values in a hidden array on the
+        instance, where the garbage collector can see them. Keys compare by
+        SameValueZero: numbers by value, with -0 and +0 alike and all NaNs alike,
+        and strings, which Duktape interns, objects and buffers by heap pointer.
+
+        Deleting an entry leaves a hole, and the holes are compacted away once
+        they make up half the table, but never while the collection is being
+        iterated. So forEach and iterators see entries added along the way and
+        skip those deleted, as the spec requires.
+
+        core-js still loads after us for the iterator protocol. It finds these
+        constructors complete and keeps their methods.
+     */
+    class NativeCollections
+    {
+    public:
+        //==============================================================================
+        /** Installs the Map and Set constructors into the global object. */
+        static void install (duk_context* ctx)
+        {
+            duk_push_global_object(ctx);
+
+            const duk_function_list_entry mapFuncs[] = {
+                { "get", mapGet, 1 },
+                { "set", mapSet, 2 },
+                { "has", has, 1 },
+                { "delete", remove, 1 },
+                { "clear", clear, 0 },
+                { "forEach", forEach, 2 },
+                { NULL, NULL, 0 }
+            };
+
+            const duk_function_list_entry setFuncs[] = {
+                { "add", setAdd, 1 },
+                { "has", has, 1 },
+                { "delete", remove, 1 },
+                { "clear", clear, 0 },
+                { "forEach", forEach, 2 },
+                { NULL, NULL, 0 }
+            };
+
+            installConstructor(ctx, "Map", 2, mapFuncs);
+            installConstructor(ctx, "Set", 1, setFuncs);
+
+            duk_pop(ctx);
+        }
+
+    private:
+        //==============================================================================
+        /** The keys of one collection, in insertion order, chained from a bucket
+            array by hash.
+         */
+        class OrderedHashTable
+        {
+        public:
+            //==============================================================================
+            enum KeyType
+            {
+                Deleted = 0,
+                Undefined,
+                Null,
+                Boolean,
+                Number,
+                Pointer,
+                LightFunc,
+                HeapValue,
+            };
+
+            struct Key
+            {
+                int type;
+                juce::uint64 bits;
+
+                bool operator== (const Key& other) const { return type == other.type && bits == other.bits; }
+            };
+
+            //==============================================================================
+            explicit OrderedHashTable (int _stride)
+                : stride(_stride), buckets(minBuckets, -1)
+            {
+            }
+
+            /** Returns the entry index of the given key, or -1. */
+            int find (const Key& key) const
+            {
+                for (int i = buckets[bucketFor(key)]; i >= 0; i = entries[static_cast<size_t>(i)].next)
+                    if (entries[static_cast<size_t>(i)].key == key)
+                        return i;
+
+                return -1;
+            }
+
+            /** Appends a key which isn't in the table, returning its entry index. */
+            int insert (const Key& key)
+            {
+                if (entries.size() >= buckets.size())
+                    rebuildBuckets(buckets.size() * 2);
+
+                const int index = static_cast<int>(entries.size());
+                const size_t b = bucketFor(key);
+
+                entries.push_back({ key, buckets[b] });
+                buckets[b] = index;
+                ++numLive;
+
+                return index;
+            }
+
+            /** Marks an entry deleted. It stays on its chain until the next compaction. */
+            void remove (int index)
+            {
+                entries[static_cast<size_t>(index)].key.type = Deleted;
+                --numLive;
+            }
+
+            /** Empties the table. */
+            void clear()
+            {
+                entries.clear();
+                buckets.assign(minBuckets, -1);
+                numLive = 0;
+            }
+
+            /** Returns true if enough entries are deleted to be worth compacting,
+                and nothing is iterating over the table.
+             */
+            bool shouldCompact() const
+            {
+                const auto numDeleted = static_cast<int>(entries.size()) - numLive;
+                return numIterations == 0 && numDeleted >= minBuckets && numDeleted * 2 >= static_cast<int>(entries.size());
+            }
+
+            /** Drops the deleted entries, keeping the others in order. */
+            void compact()
+            {
+                jassert (numIterations == 0);
+
+                entries.erase(std::remove_if(entries.begin(), entries.end(), [](const Entry& e) {
+                    return e.key.type == Deleted;
+                }), entries.end());
+
+                auto size = static_cast<size_t>(minBuckets);
+
+                while (size < entries.size())
+                    size *= 2;
+
+                rebuildBuckets(size);
+            }
+
+            //==============================================================================
+            int size() const { return numLive; }
+            int getNumEntries() const { return static_cast<int>(entries.size()); }
+            bool isLive (int index) const { return entries[static_cast<size_t>(index)].key.type != Deleted; }
+
+            bool isIterating() const { return numIterations > 0; }
+            void beginIteration() { ++numIterations; }
+            void endIteration() { jassert (numIterations > 0); --numIterations; }
+
+            /** The number of array slots per entry: key and value for a Map, key for a Set. */
+            const int stride;
+
+        private:
+            //==============================================================================
+            struct Entry
+            {
+                Key key;
+                int next;
+            };
+
+            static constexpr int minBuckets = 8;
+
+            size_t bucketFor (const Key& key) const
+            {
+                // splitmix64's finaliser, which spreads both pointers and small
+                // integers' bit patterns over the whole word.
+                auto h = key.bits + static_cast<juce::uint64>(key.type);
+                h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+                h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+                h = h ^ (h >> 31);
+
+                return static_cast<size_t>(h) & (buckets.size() - 1);
+            }
+
+            void rebuildBuckets (size_t size)
+            {
+                buckets.assign(size, -1);
+
+                for (size_t i = 0; i < entries.size(); ++i)
+                {
+                    if (entries[i].key.type == Deleted)
+                        continue;
+
+                    const size_t b = bucketFor(entries[i].key);
+                    entries[i].next = buckets[b];
+                    buckets[b] = static_cast<int>(i);
+                }
+            }
+
+            std::vector<Entry> entries;
+            std::vector<int> buckets;
+            int numLive = 0;
+            int numIterations = 0;
+
+            //==============================================================================
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OrderedHashTable)
+        };
+
+        //==============================================================================
+        enum IteratorKind
+        {
+            Keys,
+            Values,
+            Entries,
+        };
+
+        /** Reads the value at the given index as a key of the table. */
+        static OrderedHashTable::Key readKey (duk_context* ctx, duk_idx_t idx)
+        {
+            switch (duk_get_type(ctx, idx))
+            {
+                case DUK_TYPE_UNDEFINED:
+                    return { OrderedHashTable::Undefined, 0 };
+                case DUK_TYPE_NULL:
+                    return { OrderedHashTable::Null, 0 };
+                case DUK_TYPE_BOOLEAN:
+                    return { OrderedHashTable::Boolean, duk_get_boolean(ctx, idx) ? 1ull : 0ull };
+                case DUK_TYPE_NUMBER:
+                {
+                    double d = duk_get_number(ctx, idx);
+
+                    if (d == 0.0)
+                        d = 0.0;
+                    else if (d != d)
+                        d = std::numeric_limits<double>::quiet_NaN();
+
+                    juce::uint64 bits;
+                    std::memcpy(&bits, &d, sizeof(bits));
+                    return { OrderedHashTable::Number, bits };
+                }
+                case DUK_TYPE_POINTER:
+                    return { OrderedHashTable::Pointer, static_cast<juce::uint64>(reinterpret_cast<juce::pointer_sized_uint>(duk_get_pointer(ctx, idx))) };
+                case DUK_TYPE_LIGHTFUNC:
+                    return { OrderedHashTable::LightFunc, static_cast<juce::uint64>(reinterpret_cast<juce::pointer_sized_uint>(duk_get_c_function(ctx, idx))) };
+                default:
+                    return { OrderedHashTable::HeapValue, static_cast<juce::uint64>(reinterpret_cast<juce::pointer_sized_uint>(duk_get_heapptr(ctx, idx))) };
+            }
+        }
+
+        /** Pushes the entries array of `this`, returning its table, and throws if
+            `this` isn't a collection.
+         */
+        static OrderedHashTable* pushThis (duk_context* ctx)
+        {
+            duk_push_this(ctx);
+            duk_get_prop_literal(ctx, -1, DUK_HIDDEN_SYMBOL("table"));
+            auto* table = static_cast<OrderedHashTable*>(duk_get_pointer(ctx, -1));
+            duk_pop(ctx);
+
+            if (table == nullptr)
+                (void) duk_type_error(ctx, "not a Map or Set");
+
+            duk_get_prop_literal(ctx, -1, DUK_HIDDEN_SYMBOL("entries"));
+            duk_remove(ctx, -2);
+
+            return table;
+        }
+
+        /** Pushes the key at idx, storing -0 as +0 as the spec asks. */
+        static void pushNormalisedKey (duk_context* ctx, duk_idx_t idx)
+        {
+            if (duk_is_number(ctx, idx) && duk_get_number(ctx, idx) == 0.0)
+                duk_push_int(ctx, 0);
+            else
+                duk_dup(ctx, idx);
+        }
+
+        /** Compacts the table and the entries array at the stack top together. */
+        static void compact (duk_context* ctx, OrderedHashTable& table)
+        {
+            const auto stride = static_cast<duk_uarridx_t>(table.stride);
+            duk_uarridx_t to = 0;
+
+            for (int i = 0; i < table.getNumEntries(); ++i)
+            {
+                if (!table.isLive(i))
+                    continue;
+
+                const auto from = static_cast<duk_uarridx_t>(i) * stride;
+
+                if (from != to)
+                {
+                    for (duk_uarridx_t s = 0; s < stride; ++s)
+                    {
+                        duk_get_prop_index(ctx, -1, from + s);
+                        duk_put_prop_index(ctx, -2, to + s);
+                    }
+                }
+
+                to += stride;
+            }
+
+            duk_set_length(ctx, -1, to);
+            table.compact();
+        }
+
+        /** Adds or updates the entry for the key at index 0, with the value at
+            index 1 for a Map, where the entries array is at the stack top.
+         */
+        static void put (duk_context* ctx, OrderedHashTable& table)
+        {
+            const auto key = readKey(ctx, 0);
+            int index = table.find(key);
+
+            if (index < 0)
+            {
+                if (table.shouldCompact())
+                    compact(ctx, table);
+
+                index = table.insert(key);
+
+                pushNormalisedKey(ctx, 0);
+                duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(index * table.stride));
+            }
+
+            if (table.stride > 1)
+            {
+                duk_dup(ctx, 1);
+                duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(index * table.stride + 1));
+            }
+        }
+
+        //==============================================================================
+        static void installConstructor (duk_context* ctx, const char* name, int stride, const duk_function_list_entry* funcs)
+        {
+            // [ global ]
+            duk_push_c_function(ctx, stride > 1 ? constructMap : constructSet, 1);
+            duk_push_object(ctx);
+            duk_put_function_list(ctx, -1, funcs);
+
+            duk_push_c_function(ctx, finalizeCollection, 2);
+            duk_set_finalizer(ctx, -2);
+
+            // size is a getter on the prototype
+            duk_push_string(ctx, "size");
+            duk_push_c_function(ctx, getSize, 0);
+            duk_def_prop(ctx, -3, DUK_DEFPROP_HAVE_GETTER | DUK_DEFPROP_SET_CONFIGURABLE);
+
+            // The default iterator is entries() for a Map and values() for a Set,
+            // and a Set's keys() is its values(), as in the spec.
+            duk_push_c_function(ctx, createIterator, 0);
+            duk_set_magic(ctx, -1, Entries);
+            duk_dup_top(ctx);
+            duk_put_prop_string(ctx, -3, "entries");
+
+            duk_push_c_function(ctx, createIterator, 0);
+            duk_set_magic(ctx, -1, Values);
+            duk_dup_top(ctx);
+            duk_put_prop_string(ctx, -4, "values");
+
+            duk_push_c_function(ctx, createIterator, 0);
+            duk_set_magic(ctx, -1, stride > 1 ? Keys : Values);
+            duk_put_prop_string(ctx, -4, "keys");
+
+            // [ global ctor proto entries values ]
+            if (stride > 1)
+                duk_pop(ctx);
+            else
+                duk_remove(ctx, -2);
+
+            pushWellKnownSymbol(ctx, "iterator");
+            duk_swap_top(ctx, -2);
+            duk_put_prop(ctx, -3);
+
+            pushWellKnownSymbol(ctx, "toStringTag");
+            duk_push_string(ctx, name);
+            duk_def_prop(ctx, -3, DUK_DEFPROP_HAVE_VALUE | DUK_DEFPROP_SET_CONFIGURABLE);
+
+            // Each constructor has its own iterator prototype, kept on its
+            // prototype under a hidden key.
+            duk_push_object(ctx);
+            duk_push_c_function(ctx, iteratorNext, 0);
+            duk_put_prop_string(ctx, -2, "next");
+            pushWellKnownSymbol(ctx, "iterator");
+            duk_push_c_function(ctx, returnThis, 0);
+            duk_put_prop(ctx, -3);
+            pushWellKnownSymbol(ctx, "toStringTag");
+            duk_push_sprintf(ctx, "%s Iterator", name);
+            duk_def_prop(ctx, -3, DUK_DEFPROP_HAVE_VALUE | DUK_DEFPROP_SET_CONFIGURABLE);
+            duk_push_c_function(ctx, finalizeIterator, 2);
+            duk_set_finalizer(ctx, -2);
+            duk_put_prop_literal(ctx, -2, DUK_HIDDEN_SYMBOL("iteratorPrototype"));
+
+            // [ global ctor proto ]
+            duk_dup(ctx, -2);
+            duk_put_prop_string(ctx, -2, "constructor");
+            duk_put_prop_string(ctx, -2, "prototype");
+            duk_put_prop_string(ctx, -2, name);
+        }
+
+        /** Pushes a well-known symbol in Duktape's own representation, which
+            works whether or not the Symbol built-in is compiled in.
+         */
+        static void pushWellKnownSymbol (duk_context* ctx, const char* name)
+        {
+            duk_push_sprintf(ctx, "\x81Symbol.%s\xff", name);
+        }
+
+        //==============================================================================
+        static duk_ret_t construct (duk_context* ctx, int stride)
+        {
+            if (!duk_is_constructor_call(ctx))
+                return duk_type_error(ctx, "constructor requires 'new'");
+
+            duk_push_this(ctx);
+            duk_push_pointer(ctx, new OrderedHashTable(stride));
+            duk_put_prop_literal(ctx, -2, DUK_HIDDEN_SYMBOL("table"));
+            duk_push_array(ctx);
+            duk_put_prop_literal(ctx, -2, DUK_HIDDEN_SYMBOL("entries"));
+
+            if (duk_is_null_or_undefined(ctx, 0))
+                return 0;
+
+            // Arrays we read directly; any other iterable we walk with the
+            // iterator protocol. Either way each item goes in through the
+            // instance's own set() or add(), as the spec describes.
+            duk_get_prop_string(ctx, 1, stride > 1 ? "set" : "add");
+            duk_require_callable(ctx, 2);
+
+            // [ iterable this adder ... item ]
+            auto addItem = [ctx, stride]()
+            {
+                duk_dup(ctx, 2);
+                duk_dup(ctx, 1);
+
+                if (stride > 1)
+                {
+                    if (!duk_is_object(ctx, -3))
+                        (void) duk_type_error(ctx, "iterator value is not an entry object");
+
+                    duk_get_prop_index(ctx, -3, 0);
+                    duk_get_prop_index(ctx, -4, 1);
+                    duk_call_method(ctx, 2);
+                }
+                else
+                {
+                    duk_dup(ctx, -3);
+                    duk_call_method(ctx, 1);
+                }
+
+                duk_pop_2(ctx);
+            };
+
+            if (duk_is_array(ctx, 0))
+            {
+                const auto length = duk_get_length(ctx, 0);
+
+                for (duk_size_t i = 0; i < length; ++i)
+                {
+                    duk_get_prop_index(ctx, 0, static_cast<duk_uarridx_t>(i));
+                    addItem();
+                }
+
+                return 0;
+            }
+
+            pushWellKnownSymbol(ctx, "iterator");
+            duk_get_prop(ctx, 0);
+            duk_require_callable(ctx, -1);
+            duk_dup(ctx, 0);
+            duk_call_method(ctx, 0);
+
+            // [ iterable this adder iterator ]
+            for (;;)
+            {
+                duk_get_prop_string(ctx, 3, "next");
+                duk_dup(ctx, 3);
+                duk_call_method(ctx, 0);
+
+                duk_get_prop_string(ctx, -1, "done");
+                const bool done = duk_to_boolean(ctx, -1) != 0;
+                duk_pop(ctx);
+
+                if (done)
+                    break;
+
+                duk_get_prop_string(ctx, -1, "value");
+                duk_remove(ctx, -2);
+                addItem();
+            }
+
+            return 0;
+        }
+
+        static duk_ret_t constructMap (duk_context* ctx) { return construct(ctx, 2); }
+        static duk_ret_t constructSet (duk_context* ctx) { return construct(ctx, 1); }
+
+        static duk_ret_t finalizeCollection (duk_context* ctx)
+        {
+            // An iterator finalised after its collection in the same sweep finds the
+            // pointer gone, rather than dangling.
+            duk_get_prop_literal(ctx, 0, DUK_HIDDEN_SYMBOL("table"));
+            delete static_cast<OrderedHashTable*>(duk_get_pointer(ctx, -1));
+            duk_pop(ctx);
+
+            duk_push_pointer(ctx, nullptr);
+            duk_put_prop_literal(ctx, 0, DUK_HIDDEN_SYMBOL("table"));
+            return 0;
+        }
+
+        //==============================================================================
+        static duk_ret_t mapGet (duk_context* ctx)
+        {
+            auto* table = pushThis(ctx);
+            const int index = table->find(readKey(ctx, 0));
+
+            if (index < 0)
+                return 0;
+
+            duk_get_prop_index(ctx, -1, static_cast<duk_uarridx_t>(index * 2 + 1));
+            return 1;
+        }
+
+        static duk_ret_t mapSet (duk_context* ctx)
+        {
+            put(ctx, *pushThis(ctx));
+            duk_push_this(ctx);
+            return 1;
+        }
+
+        static duk_ret_t setAdd (duk_context* ctx)
+        {
+            put(ctx, *pushThis(ctx));
+            duk_push_this(ctx);
+            return 1;
+        }
+
+        static duk_ret_t has (duk_context* ctx)
+        {
+            auto* table = pushThis(ctx);
+            duk_push_boolean(ctx, table->find(readKey(ctx, 0)) >= 0);
+            return 1;
+        }
+
+        static duk_ret_t remove (duk_context* ctx)
+        {
+            auto* table = pushThis(ctx);
+            const int index = table->find(readKey(ctx, 0));
+
+            if (index < 0)
+            {
+                duk_push_false(ctx);
+                return 1;
+            }
+
+            // We let go of the key and value straight away, so that they can be
+            // collected before the hole is compacted.
+            table->remove(index);
+
+            for (int s = 0; s < table->stride; ++s)
+            {
+                duk_push_undefined(ctx);
+                duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(index * table->stride + s));
+            }
+
+            duk_push_true(ctx);
+            return 1;
+        }
+
+        static duk_ret_t clear (duk_context* ctx)
+        {
+            auto* table = pushThis(ctx);
+
+            // An iteration carries on with whatever's added after a clear, so
+            // while there is one we delete the entries in place instead.
+            if (table->isIterating())
+            {
+                for (int i = 0; i < table->getNumEntries(); ++i)
+                {
+                    if (!table->isLive(i))
+                        continue;
+
+                    table->remove(i);
+
+                    for (int s = 0; s < table->stride; ++s)
+                    {
+                        duk_push_undefined(ctx);
+                        duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i * table->stride + s));
+                    }
+                }
+
+                return 0;
+            }
+
+            table->clear();
+            duk_set_length(ctx, -1, 0);
+            return 0;
+        }
+
+        static duk_ret_t getSize (duk_context* ctx)
+        {
+            duk_push_int(ctx, pushThis(ctx)->size());
+            return 1;
+        }
+
+        static duk_ret_t forEach (duk_context* ctx)
+        {
+            duk_require_callable(ctx, 0);
+
+            auto* table = pushThis(ctx);
+            duk_push_this(ctx);
+
+            // [ callback thisArg entries this ]
+            // The table can't be compacted while we walk it, so entry indices
+            // stay put, and the length is read afresh each time round in case
+            // the callback adds entries.
+            table->beginIteration();
+
+            for (int i = 0; i < table->getNumEntries(); ++i)
+            {
+                if (!table->isLive(i))
+                    continue;
+
+                const auto base = static_cast<duk_uarridx_t>(i * table->stride);
+
+                duk_dup(ctx, 0);
+                duk_dup(ctx, 1);
+                duk_get_prop_index(ctx, 2, base + static_cast<duk_uarridx_t>(table->stride - 1));
+                duk_get_prop_index(ctx, 2, base);
+                duk_dup(ctx, 3);
+
+                // The callback may throw, and we must end the iteration first.
+                if (duk_pcall_method(ctx, 3) != DUK_EXEC_SUCCESS)
+                {
+                    table->endIteration();
+                    return duk_throw(ctx);
+                }
+
+                duk_pop(ctx);
+            }
+
+            table->endIteration();
+            return 0;
+        }
+
+        //==============================================================================
+        static duk_ret_t createIterator (duk_context* ctx)
+        {
+            auto* table = pushThis(ctx);
+            duk_pop(ctx);
+
+            duk_push_object(ctx);
+            duk_push_this(ctx);
+            duk_get_prototype(ctx, -1);
+            duk_get_prop_literal(ctx, -1, DUK_HIDDEN_SYMBOL("iteratorPrototype"));
+            duk_set_prototype(ctx, -4);
+            duk_pop(ctx);
+
+            // [ iterator this ]
+            duk_put_prop_literal(ctx, -2, DUK_HIDDEN_SYMBOL("collection"));
+            duk_push_int(ctx, 0);
+            duk_put_prop_literal(ctx, -2, DUK_HIDDEN_SYMBOL("index"));
+            duk_push_int(ctx, duk_get_current_magic(ctx));
+            duk_put_prop_literal(ctx, -2, DUK_HIDDEN_SYMBOL("kind"));
+
+            // An iterator holds off compaction until it's exhausted or collected.
+            table->beginIteration();
+            return 1;
+        }
+
+        /** Returns the table of the collection at the stack top, if it's still alive. */
+        static OrderedHashTable* getTable (duk_context* ctx)
+        {
+            duk_get_prop_literal(ctx, -1, DUK_HIDDEN_SYMBOL("table"));
+            auto* table = static_cast<OrderedHashTable*>(duk_get_pointer(ctx, -1));
+            duk_pop(ctx);
+            return table;
+        }
+
+        /** Detaches an iterator, at the given index, from its collection, ending
+            its hold on the collection's table.
+         */
+        static void detachIterator (duk_context* ctx, duk_idx_t idx)
+        {
+            idx = duk_normalize_index(ctx, idx);
+
+            duk_get_prop_literal(ctx, idx, DUK_HIDDEN_SYMBOL("collection"));
+
+            if (duk_is_undefined(ctx, -1))
+            {
+                duk_pop(ctx);
+                return;
+            }
+
+            if (auto* table = getTable(ctx))
+                table->endIteration();
+
+            duk_pop(ctx);
+            duk_push_undefined(ctx);
+            duk_put_prop_literal(ctx, idx, DUK_HIDDEN_SYMBOL("collection"));
+        }
+
+        static duk_ret_t iteratorNext (duk_context* ctx)
+        {
+            duk_push_this(ctx);
+            duk_push_object(ctx);
+
+            // [ iterator result collection ]
+            duk_get_prop_literal(ctx, -2, DUK_HIDDEN_SYMBOL("collection"));
+            auto* table = duk_is_undefined(ctx, -1) ? nullptr : getTable(ctx);
+
+            if (table == nullptr)
+            {
+                duk_pop(ctx);
+                duk_push_true(ctx);
+                duk_put_prop_string(ctx, -2, "done");
+                return 1;
+            }
+
+            duk_get_prop_literal(ctx, -3, DUK_HIDDEN_SYMBOL("index"));
+            int index = duk_get_int(ctx, -1);
+            duk_pop(ctx);
+
+            while (index < table->getNumEntries() && !table->isLive(index))
+                ++index;
+
+            if (index >= table->getNumEntries())
+            {
+                duk_pop(ctx);
+                detachIterator(ctx, -2);
+                duk_push_true(ctx);
+                duk_put_prop_string(ctx, -2, "done");
+                return 1;
+            }
+
+            duk_push_int(ctx, index + 1);
+            duk_put_prop_literal(ctx, -4, DUK_HIDDEN_SYMBOL("index"));
+
+            duk_get_prop_literal(ctx, -3, DUK_HIDDEN_SYMBOL("kind"));
+            const int kind = duk_get_int(ctx, -1);
+            duk_pop(ctx);
+
+            duk_get_prop_literal(ctx, -1, DUK_HIDDEN_SYMBOL("entries"));
+            duk_remove(ctx, -2);
+
+            // [ iterator result entries ]
+            const auto base = static_cast<duk_uarridx_t>(index * table->stride);
+
+            if (kind == Entries)
+            {
+                duk_push_array(ctx);
+                duk_get_prop_index(ctx, -2, base);
+                duk_put_prop_index(ctx, -2, 0);
+                duk_get_prop_index(ctx, -2, base + static_cast<duk_uarridx_t>(table->stride - 1));
+                duk_put_prop_index(ctx, -2, 1);
+            }
+            else
+            {
+                duk_get_prop_index(ctx, -1, kind == Keys ? base : base + static_cast<duk_uarridx_t>(table->stride - 1));
+            }
+
+            duk_put_prop_string(ctx, -3, "value");
+            duk_pop(ctx);
+            duk_push_false(ctx);
+            duk_put_prop_string(ctx, -2, "done");
+            return 1;
+        }
+
+        static duk_ret_t returnThis (duk_context* ctx)
+        {
+            duk_push_this(ctx);
+            return 1;
+        }
+
+        static duk_ret_t finalizeIterator (duk_context* ctx)
+        {
+            detachIterator(ctx, 0);
+            return 0;
+        }
+    };
+
+}
@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+    blueprint_NativeFunction.h
+    Created: 15 Oct 2026 6:14:05pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Moves a C++ value of a given type on and off the Duktape stack, straight
+        from the engine's own values: `check` tells whether the value at an index
+        will read as the type, `read` reads it and `push` pushes one.
+
+        Numbers, bools and strings, std::vector of any of these, binary data as a
+        juce::MemoryBlock or, for arguments only, a BufferView of the engine's own
+        bytes, and juce::var, which takes any value, objects and arrays included,
+        are supported.
+     */
+    template <typename T, typename = void>
+    struct DukValue;
+
+    template <>
+    struct DukValue<bool>
+    {
+        static bool check (duk_context* ctx, duk_idx_t idx) { return duk_is_boolean(ctx, idx); }
+        static bool read (duk_context* ctx, duk_idx_t idx)  { return duk_get_boolean(ctx, idx); }
+        static void push (duk_context* ctx, bool v)         { duk_push_boolean(ctx, v); }
+    };
+
+    template <typename T>
+    struct DukValue<T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>>
+    {
+        static bool check (duk_context* ctx, duk_idx_t idx) { return duk_is_number(ctx, idx); }
+        static T read (duk_context* ctx, duk_idx_t idx)     { return static_cast<T>(duk_get_number(ctx, idx)); }
+        static void push (duk_context* ctx, T v)            { duk_push_number(ctx, static_cast<duk_double_t>(v)); }
+    };
+
+    template <>
+    struct DukValue<juce::String>
+    {
+        static bool check (duk_context* ctx, duk_idx_t idx) { return duk_is_string(ctx, idx); }
+
+        static juce::String read (duk_context* ctx, duk_idx_t idx)
+        {
+            duk_size_t length = 0;
+            const char* utf8 = duk_get_lstring(ctx, idx, &length);
+
+            return juce::String::fromUTF8(utf8, static_cast<int>(length));
+        }
+
+        static void push (duk_context* ctx, const juce::String& v)
+        {
+            duk_push_lstring(ctx, v.toRawUTF8(), v.getNumBytesAsUTF8());
+        }
+    };
+
+    template <>
+    struct DukValue<std::string>
+    {
+        static bool check (duk_context* ctx, duk_idx_t idx) { return duk_is_string(ctx, idx); }
+
+        static std::string read (duk_context* ctx, duk_idx_t idx)
+        {
+            duk_size_t length = 0;
+            const char* utf8 = duk_get_lstring(ctx, idx, &length);
+
+            return std::string(utf8, length);
+        }
+
+        static void push (duk_context* ctx, const std::string& v) { duk_push_lstring(ctx, v.data(), v.size()); }
+    };
+
+    template <>
+    struct DukValue<juce::MemoryBlock>
+    {
+        // Plain buffers, ArrayBuffers and typed arrays alike; we read the bytes
+        // a typed array views.
+        static bool check (duk_context* ctx, duk_idx_t idx) { return duk_is_buffer_data(ctx, idx); }
+
+        static juce::MemoryBlock read (duk_context* ctx, duk_idx_t idx)
+        {
+            duk_size_t size = 0;
+            const void* data = duk_get_buffer_data(ctx, idx, &size);
+
+            return juce::MemoryBlock(data, size);
+        }
+
+        /** Pushes an ArrayBuffer holding a copy of the bytes. */
+        static void push (duk_context* ctx, const juce::MemoryBlock& v)
+        {
+            if (v.getSize() > 0)
+                std::memcpy(duk_push_fixed_buffer(ctx, v.getSize()), v.getData(), v.getSize());
+            else
+                duk_push_fixed_buffer(ctx, 0);
+
+            duk_push_buffer_object(ctx, -1, 0, v.getSize(), DUK_BUFOBJ_ARRAYBUFFER);
+            duk_remove(ctx, -2);
+        }
+    };
+
+    //==============================================================================
+    /** The bytes of a buffer argument, read in place rather than copied: a plain
+        buffer, an ArrayBuffer, or just the part of one a typed array views.
+
+        The view belongs to the engine and is only valid for the duration of the
+        call, so copy out whatever needs to outlive it. The bytes may be written,
+        which is how C++ can fill a buffer which JavaScript allocated and passed
+        in, with no copy either way. A view can't be returned to JavaScript.
+     */
+    struct BufferView
+    {
+        void* data = nullptr;
+        size_t size = 0;
+
+        /** Returns the bytes as an array of the given type, e.g. the floats of
+            a Float32Array.
+         */
+        template <typename T>
+        T* getDataAs() const                { return static_cast<T*>(data); }
+
+        /** Returns the number of whole values of the given type in the bytes. */
+        template <typename T>
+        size_t getNumElements() const       { return size / sizeof(T); }
+    };
+
+    template <>
+    struct DukValue<BufferView>
+    {
+        static bool check (duk_context* ctx, duk_idx_t idx) { return duk_is_buffer_data(ctx, idx); }
+
+        static BufferView read (duk_context* ctx, duk_idx_t idx)
+        {
+            BufferView view;
+            view.data = duk_get_buffer_data(ctx, idx, &view.size);
+
+            // A detached ArrayBuffer has no data at all.
+            if (view.data == nullptr)
+                view.size = 0;
+
+            return view;
+        }
+    };
+
+    template <typename T>
+    struct DukValue<std::vector<T>>
+    {
+        static bool check (duk_context* ctx, duk_idx_t idx)
+        {
+            if (!duk_is_array(ctx, idx))
+                return false;
+
+            idx = duk_normalize_index(ctx, idx);
+            const auto length = duk_get_length(ctx, idx);
+
+            for (duk_size_t i = 0; i < length; ++i)
+            {
+                duk_get_prop_index(ctx, idx, static_cast<duk_uarridx_t>(i));
+                const bool ok = DukValue<T>::check(ctx, -1);
+                duk_pop(ctx);
+
+                if (!ok)
+                    return false;
+            }
+
+            return true;
+        }
+
+        static std::vector<T> read (duk_context* ctx, duk_idx_t idx)
+        {
+            idx = duk_normalize_index(ctx, idx);
+            const auto length = duk_get_length(ctx, idx);
+
+            std::vector<T> values;
+            values.reserve(length);
+
+            for (duk_size_t i = 0; i < length; ++i)
+            {
+                duk_get_prop_index(ctx, idx, static_cast<duk_uarridx_t>(i));
+                values.push_back(DukValue<T>::read(ctx, -1));
+                duk_pop(ctx);
+            }
+
+            return values;
+        }
+
+        static void push (duk_context* ctx, const std::vector<T>& values)
+        {
+            const auto arrayIdx = duk_push_array(ctx);
+
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                DukValue<T>::push(ctx, values[i]);
+                duk_put_prop_index(ctx, arrayIdx, static_cast<duk_uarridx_t>(i));
+            }
+        }
+    };
+
+    /** Any value at all, converted as for view properties. Defined along with
+        the root, whose conversions these are.
+     */
+    template <>
+    struct DukValue<juce::var>
+    {
+        static bool check (duk_context*, duk_idx_t) { return true; }
+        static juce::var read (duk_context* ctx, duk_idx_t idx);
+        static void push (duk_context* ctx, const juce::var& v);
+    };
+
+    //==============================================================================
+    /** A C++ callable bound to the Duktape calling convention, arguments read
+        from the stack by position and any result pushed in return, with no
+        juce::var in between unless the callable asks for one.
+     */
+    struct NativeFunction
+    {
+        /** Returns the index of the first argument which doesn't read as its
+            type, or -1 if they all do.
+         */
+        std::function<int(duk_context*)> checkArguments;
+
+        /** Reads the arguments, calls the callable and pushes what it returns,
+            returning the number of values pushed. Call once the arguments check.
+         */
+        std::function<duk_ret_t(duk_context*)> call;
+
+        //==============================================================================
+        /** Binds a lambda, function object or function pointer, its argument
+            and return types deduced.
+         */
+        template <typename Fn>
+        static NativeFunction create (Fn fn)
+        {
+            return createFromSignature(std::move(fn), static_cast<typename Signature<Fn>::Type*>(nullptr));
+        }
+
+    private:
+        //==============================================================================
+        template <typename Fn>
+        struct Signature : Signature<decltype(&std::decay_t<Fn>::operator())> {};
+
+        template <typename R, typename... Args>
+        struct Signature<R (*)(Args...)> { typedef R Type(Args...); };
+
+        template <typename R, typename C, typename... Args>
+        struct Signature<R (C::*)(Args...)> { typedef R Type(Args...); };
+
+        template <typename R, typename C, typename... Args>
+        struct Signature<R (C::*)(Args...) const> { typedef R Type(Args...); };
+
+        template <typename T>
+        using Value = DukValue<std::decay_t<T>>;
+
+        template <typename Fn, typename R, typename... Args>
+        static NativeFunction createFromSignature (Fn fn, R (*)(Args...))
+        {
+            NativeFunction f;
+
+            f.checkArguments = [](duk_context* ctx) -> int {
+                return check<Args...>(ctx, std::index_sequence_for<Args...>());
+            };
+
+            f.call = [fn](duk_context* ctx) -> duk_ret_t {
+                return invoke<R, Args...>(fn, ctx, std::index_sequence_for<Args...>());
+            };
+
+            return f;
+        }
+
+        template <typename... Args, size_t... I>
+        static int check (duk_context* ctx, std::index_sequence<I...>)
+        {
+            // The leading entry keeps the array non-empty for a function of no arguments.
+            const bool ok[] = { true, Value<Args>::check(ctx, static_cast<duk_idx_t>(I))... };
+            (void) ctx;
+
+            for (int i = 0; i < static_cast<int>(sizeof...(Args)); ++i)
+                if (!ok[i + 1])
+                    return i;
+
+            return -1;
+        }
+
+        template <typename R, typename... Args, typename Fn, size_t... I>
+        static duk_ret_t invoke (const Fn& fn, duk_context* ctx, std::index_sequence<I...>)
+        {
+            (void) ctx;
+
+            if constexpr (std::is_void<R>::value)
+            {
+                fn(Value<Args>::read(ctx, static_cast<duk_idx_t>(I))...);
+                return 0;
+            }
+            else
+            {
+                Value<R>::push(ctx, fn(Value<Args>::read(ctx, static_cast<duk_idx_t>(I))...));
+                return 1;
+            }
+        }
+    };
+
+}
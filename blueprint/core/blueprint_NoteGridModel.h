@@ -0,0 +1,372 @@
+/*
+  ==============================================================================
+
+    blueprint_NoteGridModel.h
+    Created: 15 Oct 2026 11:51:06pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The notes of a clip, such as a sequencer's, held natively with a spatial
+        index, for NoteGridViews to draw and edit without a component, or a
+        layout, per note.
+
+        The index buckets each note by its pitch and by the spans of
+        `beatsPerBucket` beats it overlaps, so that finding the notes in an area
+        of the grid, to paint it or to hit-test a point, only visits the
+        buckets which the area covers. The cost of a paint or a click is then in
+        the notes nearby, however many the clip holds.
+
+        Every edit, made by a view, by JavaScript or by the processor, is
+        gathered into a diff of the notes added, changed and removed since the
+        last one was taken, a note edited several times in between showing only
+        as it ends up. Register the model with a root through
+        `registerNoteGrid`, and the root takes the diff once a frame and sends
+        it to JavaScript in a "noteGridChange" event with the model's name.
+
+        The model is only ever used on the message thread. A processor playing
+        the notes should take a copy with `getNotes` as they change.
+     */
+    class NoteGridModel
+    {
+    public:
+        //==============================================================================
+        using NoteId = int;
+
+        struct Note
+        {
+            NoteId id = 0;
+            int pitch = 0;
+            double start = 0.0;
+            double length = 0.0;
+            float velocity = 0.8f;
+
+            double getEnd() const { return start + length; }
+        };
+
+        /** The edits made since the last diff was taken. With `reset` set, the
+            notes were all replaced, and `added` holds them all.
+         */
+        struct Diff
+        {
+            bool reset = false;
+            std::vector<Note> added;
+            std::vector<Note> changed;
+            std::vector<NoteId> removed;
+
+            bool isEmpty() const { return !reset && added.empty() && changed.empty() && removed.empty(); }
+        };
+
+        /** Hears of each change to the notes, with the area of the grid it took
+            in, on the message thread.
+         */
+        struct Listener
+        {
+            virtual ~Listener() = default;
+
+            /** Called with the lowest and highest pitch, and the first and last
+                beat, which the change covered, before and after.
+             */
+            virtual void noteGridChanged (NoteGridModel& model, int lowestPitch, int highestPitch,
+                                          double startBeat, double endBeat) = 0;
+        };
+
+        //==============================================================================
+        NoteGridModel() = default;
+
+        //==============================================================================
+        /** Replaces every note, giving each a new id. */
+        void setNotes (const std::vector<Note>& newNotes)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            notes.clear();
+            buckets.clear();
+            pendingEdits.clear();
+            pendingReset = true;
+
+            for (auto note : newNotes)
+            {
+                note.id = nextId++;
+                note.pitch = juce::jlimit(0, 127, note.pitch);
+                note.length = juce::jmax(0.0, note.length);
+                notes[note.id] = note;
+                index(note);
+            }
+
+            changed(0, 127, std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max());
+        }
+
+        /** Adds a note, returning its id. */
+        NoteId addNote (int pitch, double start, double length, float velocity)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            Note note { nextId++, juce::jlimit(0, 127, pitch), start, juce::jmax(0.0, length), velocity };
+            notes[note.id] = note;
+            index(note);
+
+            noteEdit(note.id, Added);
+            changed(note.pitch, note.pitch, note.start, note.getEnd());
+            return note.id;
+        }
+
+        /** Moves, resizes or changes the velocity of a note, returning false if
+            there's no note of its id.
+         */
+        bool updateNote (const Note& updated)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            auto it = notes.find(updated.id);
+
+            if (it == notes.end())
+                return false;
+
+            const auto before = it->second;
+            unindex(before);
+
+            it->second = updated;
+            it->second.pitch = juce::jlimit(0, 127, updated.pitch);
+            it->second.length = juce::jmax(0.0, updated.length);
+            index(it->second);
+
+            noteEdit(updated.id, Changed);
+            changed(juce::jmin(before.pitch, it->second.pitch), juce::jmax(before.pitch, it->second.pitch),
+                    juce::jmin(before.start, updated.start), juce::jmax(before.getEnd(), it->second.getEnd()));
+            return true;
+        }
+
+        /** Removes a note, returning false if there's no note of that id. */
+        bool removeNote (NoteId id)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            auto it = notes.find(id);
+
+            if (it == notes.end())
+                return false;
+
+            const auto note = it->second;
+            unindex(note);
+            notes.erase(it);
+
+            noteEdit(id, Removed);
+            changed(note.pitch, note.pitch, note.start, note.getEnd());
+            return true;
+        }
+
+        //==============================================================================
+        /** Returns the note of the given id, or nullptr if there's none. */
+        const Note* getNote (NoteId id) const
+        {
+            auto it = notes.find(id);
+            return it != notes.end() ? &it->second : nullptr;
+        }
+
+        /** Returns every note, in no particular order. */
+        std::vector<Note> getNotes() const
+        {
+            std::vector<Note> result;
+            result.reserve(notes.size());
+
+            for (const auto& [id, note] : notes)
+                result.push_back(note);
+
+            return result;
+        }
+
+        /** Returns the number of notes. */
+        int getNumNotes() const { return (int) notes.size(); }
+
+        /** Calls back once with each note which overlaps the given pitches, both
+            inclusive, and span of beats.
+         */
+        template <typename Callback>
+        void forEachNoteIn (int lowestPitch, int highestPitch, double startBeat, double endBeat, Callback&& callback) const
+        {
+            const auto firstBucket = getBucket(startBeat);
+            const auto lastBucket = getBucket(endBeat);
+
+            for (int pitch = juce::jmax(0, lowestPitch); pitch <= juce::jmin(127, highestPitch); ++pitch)
+            {
+                for (auto bucket = firstBucket; bucket <= lastBucket; ++bucket)
+                {
+                    auto it = buckets.find(getKey(pitch, bucket));
+
+                    if (it == buckets.end())
+                        continue;
+
+                    for (const auto id : it->second)
+                    {
+                        const auto& note = notes.at(id);
+
+                        // A long note is in each bucket it spans, so only the
+                        // first bucket of the area visits it.
+                        if (juce::jmax(getBucket(note.start), firstBucket) != bucket)
+                            continue;
+
+                        if (note.start <= endBeat && note.getEnd() >= startBeat)
+                            callback(note);
+                    }
+                }
+            }
+        }
+
+        /** Returns the id of the note at the given pitch and beat, or 0 for
+            none. Of overlapping notes, the latest to start is taken.
+         */
+        NoteId getNoteAt (int pitch, double beat) const
+        {
+            const Note* found = nullptr;
+
+            forEachNoteIn(pitch, pitch, beat, beat, [&found, beat](const Note& note) {
+                if (beat < note.getEnd() && (found == nullptr || note.start > found->start))
+                    found = &note;
+            });
+
+            return found != nullptr ? found->id : 0;
+        }
+
+        //==============================================================================
+        /** Returns the edits since the last call, then forgets them. */
+        Diff takeDiff()
+        {
+            Diff diff;
+            diff.reset = pendingReset;
+
+            if (pendingReset)
+                diff.added = getNotes();
+
+            for (const auto& [id, edit] : pendingEdits)
+            {
+                if (edit == Removed)
+                    diff.removed.push_back(id);
+                else if (auto* note = getNote(id))
+                    (edit == Added ? diff.added : diff.changed).push_back(*note);
+            }
+
+            pendingReset = false;
+            pendingEdits.clear();
+            diffPending = false;
+            return diff;
+        }
+
+        /** Sends every note in the next diff, in place of the edits pending, for
+            a mirror which is starting over, such as a reloaded bundle's.
+         */
+        void resync()
+        {
+            const bool hadDiff = diffPending;
+
+            pendingEdits.clear();
+            pendingReset = true;
+            diffPending = true;
+
+            if (diffCallback != nullptr && !hadDiff)
+                diffCallback();
+        }
+
+        /** Sets the function called when there's a diff to take, once for each
+            diff, on the message thread.
+         */
+        void setDiffCallback (std::function<void()> callback) { diffCallback = std::move(callback); }
+
+        void addListener (Listener* listener)       { listeners.add(listener); }
+        void removeListener (Listener* listener)    { listeners.remove(listener); }
+
+        //==============================================================================
+        static constexpr double beatsPerBucket = 4.0;
+
+    private:
+        //==============================================================================
+        enum Edit { Added, Changed, Removed };
+
+        static juce::int64 getBucket (double beat) { return (juce::int64) std::floor(beat / beatsPerBucket); }
+
+        static juce::int64 getKey (int pitch, juce::int64 bucket) { return bucket * 128 + pitch; }
+
+        void index (const Note& note)
+        {
+            for (auto bucket = getBucket(note.start); bucket <= getBucket(note.getEnd()); ++bucket)
+                buckets[getKey(note.pitch, bucket)].push_back(note.id);
+        }
+
+        void unindex (const Note& note)
+        {
+            for (auto bucket = getBucket(note.start); bucket <= getBucket(note.getEnd()); ++bucket)
+            {
+                auto it = buckets.find(getKey(note.pitch, bucket));
+
+                if (it == buckets.end())
+                    continue;
+
+                auto& ids = it->second;
+                ids.erase(std::remove(ids.begin(), ids.end(), note.id), ids.end());
+
+                if (ids.empty())
+                    buckets.erase(it);
+            }
+        }
+
+        /** Folds an edit into the one pending for the note: a note added then
+            changed is still added, and one added then removed never was.
+         */
+        void noteEdit (NoteId id, Edit edit)
+        {
+            // After a reset, the diff sends every note as it is.
+            if (pendingReset)
+                return;
+
+            auto it = pendingEdits.find(id);
+
+            if (it == pendingEdits.end())
+                pendingEdits[id] = edit;
+            else if (it->second == Added && edit == Removed)
+                pendingEdits.erase(it);
+            else if (it->second != Added)
+                it->second = edit;
+        }
+
+        void changed (int lowestPitch, int highestPitch, double startBeat, double endBeat)
+        {
+            const bool hadDiff = diffPending;
+            diffPending = pendingReset || !pendingEdits.empty();
+
+            listeners.call([&](Listener& l) { l.noteGridChanged(*this, lowestPitch, highestPitch, startBeat, endBeat); });
+
+            if (diffCallback != nullptr && diffPending && !hadDiff)
+                diffCallback();
+        }
+
+        //==============================================================================
+        std::unordered_map<NoteId, Note> notes;
+        std::unordered_map<juce::int64, std::vector<NoteId>> buckets;
+        NoteId nextId = 1;
+
+        std::unordered_map<NoteId, Edit> pendingEdits;
+        bool pendingReset = false;
+        bool diffPending = false;
+
+        std::function<void()> diffCallback;
+        juce::ListenerList<Listener> listeners;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NoteGridModel)
+    };
+
+}
@@ -0,0 +1,364 @@
+/*
+  ==============================================================================
+
+    blueprint_NoteGridView.cpp
+    Created: 15 Oct 2026 11:51:06pm
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    NoteGridView::~NoteGridView()
+    {
+        if (model != nullptr)
+            model->removeListener(this);
+    }
+
+    //==============================================================================
+    void NoteGridView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+        getPropertyTable().apply(*this, name, v);
+    }
+
+    const ViewPropertyTable<NoteGridView>& NoteGridView::getPropertyTable()
+    {
+        typedef ViewPropertyTable<NoteGridView> Table;
+
+        static constexpr Table::Entry entries[] = {
+            { "model", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.setModel(v.toString());
+            }},
+            { "scroll-beat", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.scrollBeat = (double) v;
+                n.repaint();
+            }},
+            { "top-pitch", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.topPitch = juce::jlimit(0.0, 127.0, (double) v);
+                n.repaint();
+            }},
+            { "beat-width", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.beatWidth = juce::jmax(1.0, (double) v);
+                n.repaint();
+            }},
+            { "row-height", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.rowHeight = juce::jmax(1.0, (double) v);
+                n.repaint();
+            }},
+            { "snap", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.snap = juce::jmax(0.0, (double) v);
+                n.repaint();
+            }},
+            { "default-length", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.defaultLength = juce::jmax(0.0, (double) v);
+            }},
+            { "beats-per-bar", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.beatsPerBar = juce::jmax(1, (int) v);
+                n.repaint();
+            }},
+            { "editable", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.editable = (bool) v;
+                n.drag = Drag::None;
+            }},
+            { "black-key-row-color", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.blackKeyRowColour = parseColourValue(v);
+                n.repaint();
+            }},
+            { "grid-line-color", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.gridLineColour = parseColourValue(v);
+                n.repaint();
+            }},
+            { "bar-line-color", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.barLineColour = parseColourValue(v);
+                n.repaint();
+            }},
+            { "note-color", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.noteColour = parseColourValue(v);
+                n.repaint();
+            }},
+            { "selected-note-color", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.selectedNoteColour = parseColourValue(v);
+                n.repaint();
+            }},
+            { "note-line-color", Table::ConsumedByView, [](NoteGridView& n, const juce::var& v) {
+                n.noteLineColour = parseColourValue(v);
+                n.repaint();
+            }},
+        };
+
+        static const Table table (entries);
+        return table;
+    }
+
+    void NoteGridView::resetForReuse()
+    {
+        View::resetForReuse();
+
+        setModel({});
+
+        scrollBeat = 0.0;
+        topPitch = 84.0;
+        beatWidth = 48.0;
+        rowHeight = 12.0;
+        selectedNote = 0;
+        drag = Drag::None;
+    }
+
+    //==============================================================================
+    void NoteGridView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("NoteGridView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "NoteGridView");
+
+        View::paint(g);
+
+        const auto clip = g.getClipBounds().toFloat().getIntersection(getLocalBounds().toFloat());
+
+        if (clip.isEmpty())
+            return;
+
+        // Only the rows and beats in the clip, however long the clip of notes.
+        const int lowestPitch = juce::jmax(0, getPitchAt(clip.getBottom()));
+        const int highestPitch = juce::jmin(127, getPitchAt(clip.getY()));
+        const double startBeat = getBeatAt(clip.getX());
+        const double endBeat = getBeatAt(clip.getRight());
+
+        for (int pitch = lowestPitch; pitch <= highestPitch; ++pitch)
+        {
+            const float top = getRowTop(pitch);
+
+            if (KeyboardView::isBlackKey(pitch))
+            {
+                g.setColour(blackKeyRowColour);
+                g.fillRect(clip.getX(), top, clip.getWidth(), (float) rowHeight);
+            }
+
+            g.setColour(gridLineColour);
+            g.fillRect(clip.getX(), top + (float) rowHeight - 1.0f, clip.getWidth(), 1.0f);
+        }
+
+        const double step = getLineStep();
+
+        for (double beat = std::floor(startBeat / step) * step; beat <= endBeat; beat += step)
+        {
+            const double bar = beat / (double) beatsPerBar;
+            const bool isBarLine = std::abs(bar - std::round(bar)) < 1.0e-6;
+
+            g.setColour(isBarLine ? barLineColour : gridLineColour);
+            g.fillRect(getX(beat), clip.getY(), 1.0f, clip.getHeight());
+        }
+
+        if (auto* notes = getModel())
+        {
+            notes->forEachNoteIn(lowestPitch, highestPitch, startBeat, endBeat, [&](const NoteGridModel::Note& note) {
+                const auto area = getNoteBounds(note);
+                const auto colour = note.id == selectedNote ? selectedNoteColour : noteColour;
+
+                g.setColour(colour.withMultipliedAlpha(0.4f + 0.6f * juce::jlimit(0.0f, 1.0f, note.velocity)));
+                g.fillRect(area);
+
+                g.setColour(noteLineColour);
+                g.drawRect(area, 1.0f);
+            });
+        }
+    }
+
+    //==============================================================================
+    void NoteGridView::mouseDown (const juce::MouseEvent& e)
+    {
+        View::mouseDown(e);
+
+        auto* notes = getModel();
+
+        if (!editable || notes == nullptr)
+            return;
+
+        const int pitch = getPitchAt(e.position.y);
+        const double beat = getBeatAt(e.position.x);
+
+        if (!juce::isPositiveAndBelow(pitch, 128))
+            return;
+
+        auto id = notes->getNoteAt(pitch, beat);
+
+        if (e.mods.isPopupMenu())
+        {
+            if (id != 0)
+                notes->removeNote(id);
+
+            return;
+        }
+
+        if (id == 0)
+        {
+            const double start = snap > 0.0 ? std::floor(beat / snap) * snap : beat;
+            const double length = defaultLength > 0.0 ? defaultLength : (snap > 0.0 ? snap : 1.0);
+
+            id = notes->addNote(pitch, start, length, 0.8f);
+        }
+
+        setSelectedNote(id);
+
+        if (auto* note = notes->getNote(id))
+        {
+            dragOrigin = *note;
+
+            // A few pixels in from its right edge, a note resizes rather than moves.
+            const auto area = getNoteBounds(*note);
+            const float edge = juce::jmin(4.0f, area.getWidth() * 0.25f);
+
+            drag = e.position.x >= area.getRight() - edge ? Drag::Resize : Drag::Move;
+        }
+    }
+
+    void NoteGridView::mouseDrag (const juce::MouseEvent& e)
+    {
+        View::mouseDrag(e);
+
+        auto* notes = getModel();
+
+        if (drag == Drag::None || notes == nullptr)
+            return;
+
+        auto note = dragOrigin;
+        const double beats = (double) e.getDistanceFromDragStartX() / beatWidth;
+
+        if (drag == Drag::Move)
+        {
+            note.start = snapBeat(dragOrigin.start + beats);
+            note.pitch = juce::jlimit(0, 127, dragOrigin.pitch - juce::roundToInt((double) e.getDistanceFromDragStartY() / rowHeight));
+        }
+        else
+        {
+            const double minLength = snap > 0.0 ? snap : 1.0 / beatWidth;
+            note.length = juce::jmax(minLength, snapBeat(dragOrigin.getEnd() + beats) - note.start);
+        }
+
+        // A drag reports far more often than the note moves a grid step.
+        if (auto* current = notes->getNote(note.id))
+            if (current->pitch != note.pitch || current->start != note.start || current->length != note.length)
+                notes->updateNote(note);
+    }
+
+    void NoteGridView::mouseUp (const juce::MouseEvent& e)
+    {
+        View::mouseUp(e);
+        drag = Drag::None;
+    }
+
+    void NoteGridView::mouseDoubleClick (const juce::MouseEvent& e)
+    {
+        View::mouseDoubleClick(e);
+
+        auto* notes = getModel();
+
+        if (!editable || notes == nullptr)
+            return;
+
+        // The first click of the two found the note, or added it.
+        if (selectedNote != 0)
+            notes->removeNote(selectedNote);
+
+        drag = Drag::None;
+    }
+
+    void NoteGridView::mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+    {
+        // The grid scrolls itself, so the wheel goes no further, to an
+        // enclosing scroll view or to JavaScript.
+        if (e.mods.isCommandDown())
+        {
+            // Zooms around the beat under the mouse, which stays put.
+            const double beat = getBeatAt(e.position.x);
+
+            beatWidth = juce::jlimit(1.0, 4096.0, beatWidth * std::pow(2.0, (double) wheel.deltaY * 2.0));
+            scrollBeat = beat - (double) e.position.x / beatWidth;
+        }
+        else
+        {
+            const auto horizontal = e.mods.isShiftDown() ? wheel.deltaY : wheel.deltaX;
+            const auto vertical = e.mods.isShiftDown() ? 0.0f : wheel.deltaY;
+
+            // A wheel notch is about 0.1, so it moves about ten pixels a notch.
+            scrollBeat -= (double) horizontal * 100.0 / beatWidth;
+            topPitch = juce::jlimit(0.0, 127.0, topPitch + (double) vertical * 100.0 / rowHeight);
+        }
+
+        repaint();
+    }
+
+    //==============================================================================
+    void NoteGridView::noteGridChanged (NoteGridModel&, int lowestPitch, int highestPitch, double startBeat, double endBeat)
+    {
+        // Whole beats and rows either side, clamped, as a reset spans every beat.
+        const auto bounds = getLocalBounds().toFloat();
+        const float left = juce::jlimit(bounds.getX(), bounds.getRight(), getX(startBeat) - 1.0f);
+        const float right = juce::jlimit(bounds.getX(), bounds.getRight(), getX(endBeat) + 1.0f);
+        const float top = juce::jlimit(bounds.getY(), bounds.getBottom(), getRowTop(highestPitch) - 1.0f);
+        const float bottom = juce::jlimit(bounds.getY(), bounds.getBottom(), getRowTop(lowestPitch) + (float) rowHeight + 1.0f);
+
+        if (right > left && bottom > top)
+            repaint(juce::Rectangle<float>::leftTopRightBottom(left, top, right, bottom).getSmallestIntegerContainer());
+    }
+
+    void NoteGridView::setModel (const juce::String& name)
+    {
+        if (model != nullptr)
+            model->removeListener(this);
+
+        modelName = name;
+        model = nullptr;
+        selectedNote = 0;
+        drag = Drag::None;
+
+        getModel();
+        repaint();
+    }
+
+    NoteGridModel* NoteGridView::getModel()
+    {
+        if (model == nullptr && modelName.isNotEmpty())
+        {
+            if (ReactApplicationRoot* root = getOwningRoot())
+                model = root->getNoteGrid(modelName);
+
+            if (model != nullptr)
+                model->addListener(this);
+        }
+
+        return model;
+    }
+
+    juce::Rectangle<float> NoteGridView::getNoteBounds (const NoteGridModel::Note& note) const
+    {
+        const float left = getX(note.start);
+        return { left, getRowTop(note.pitch), juce::jmax(1.0f, getX(note.getEnd()) - left), (float) rowHeight };
+    }
+
+    double NoteGridView::getLineStep() const
+    {
+        double step = snap > 0.0 ? snap : 1.0;
+
+        while (step * beatWidth < 4.0)
+            step *= 2.0;
+
+        return step;
+    }
+
+    void NoteGridView::setSelectedNote (NoteGridModel::NoteId id)
+    {
+        if (id == selectedNote)
+            return;
+
+        for (const auto noteId : { selectedNote, id })
+            if (auto* note = model != nullptr ? model->getNote(noteId) : nullptr)
+                repaint(getNoteBounds(*note).expanded(1.0f).getSmallestIntegerContainer());
+
+        selectedNote = id;
+    }
+
+}
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    blueprint_NoteGridView.h
+    Created: 15 Oct 2026 11:51:06pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_KeyboardView.h"
+#include "blueprint_NoteGridModel.h"
+#include "blueprint_View.h"
+#include "blueprint_ViewPropertyTable.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The NoteGridView class is a core view which draws and edits the notes of
+        a NoteGridModel as a piano roll, every note in the one component.
+
+        `model` names a model registered with the root. Time runs left to right,
+        `beat-width` pixels to a beat from `scroll-beat` at the left edge, and
+        pitch bottom to top, rows `row-height` pixels tall with `top-pitch` at
+        the top. The mouse wheel scrolls the grid natively, and with the command
+        key, zooms it around the mouse. A paint draws only the rows and the
+        beats in its clip, asking the model's index for the notes there, and a
+        change to the model repaints only the area it touched, so neither
+        scrolling, zooming nor an edit costs more for a larger clip.
+
+        While `editable`, as it is by default, clicking an empty cell adds a
+        note of `default-length` beats there, or a grid step if that's 0, and
+        dragging a note moves it, or by its right edge, resizes it. Times snap
+        to `snap` beats, a sixteenth by default, or not at all with a `snap` of
+        0. A double click, or a right click, removes a note. Each edit goes
+        straight to the model, which sends JavaScript its edits as a diff once a
+        frame.
+
+        Rows of the black keys draw in `black-key-row-color` over the view's
+        background, with lines of `grid-line-color` between the rows and at
+        each grid step, and of `bar-line-color` every `beats-per-bar` beats.
+        Notes draw in `note-color`, the one last clicked in
+        `selected-note-color`, edged in `note-line-color`, more opaque the
+        greater their velocity.
+     */
+    class NoteGridView : public View, private NoteGridModel::Listener
+    {
+    public:
+        //==============================================================================
+        NoteGridView() = default;
+        ~NoteGridView() override;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        /** The grid's own properties, and how it applies them. */
+        static const ViewPropertyTable<NoteGridView>& getPropertyTable();
+
+        /** Lets go of the model, and puts the grid back to its default view. */
+        void resetForReuse() override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+        void mouseDown (const juce::MouseEvent& e) override;
+        void mouseDrag (const juce::MouseEvent& e) override;
+        void mouseUp (const juce::MouseEvent& e) override;
+        void mouseDoubleClick (const juce::MouseEvent& e) override;
+        void mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+
+    private:
+        //==============================================================================
+        void noteGridChanged (NoteGridModel& model, int lowestPitch, int highestPitch,
+                              double startBeat, double endBeat) override;
+
+        /** Follows the model of the given name, once the view has a root. */
+        void setModel (const juce::String& name);
+
+        /** Returns the model followed, looking it up by name the first time the
+            view has a root to ask.
+         */
+        NoteGridModel* getModel();
+
+        //==============================================================================
+        double getBeatAt (float x) const { return scrollBeat + (double) x / beatWidth; }
+        int getPitchAt (float y) const { return (int) std::ceil(topPitch - (double) y / rowHeight); }
+
+        float getX (double beat) const { return (float) ((beat - scrollBeat) * beatWidth); }
+        float getRowTop (int pitch) const { return (float) ((topPitch - pitch) * rowHeight); }
+
+        /** Returns the area of the view a note takes up. */
+        juce::Rectangle<float> getNoteBounds (const NoteGridModel::Note& note) const;
+
+        /** Returns the given beat, snapped to the grid. */
+        double snapBeat (double beat) const { return snap > 0.0 ? std::round(beat / snap) * snap : beat; }
+
+        /** Returns the grid step lines are drawn at, coarsened as the grid zooms
+            out until the lines are a few pixels apart.
+         */
+        double getLineStep() const;
+
+        void setSelectedNote (NoteGridModel::NoteId id);
+
+        //==============================================================================
+        enum class Drag
+        {
+            None,
+            Move,
+            Resize,
+        };
+
+        juce::String modelName;
+        NoteGridModel* model = nullptr;
+
+        double scrollBeat = 0.0;
+        double topPitch = 84.0;
+        double beatWidth = 48.0;
+        double rowHeight = 12.0;
+
+        double snap = 0.25;
+        double defaultLength = 0.0;
+        int beatsPerBar = 4;
+        bool editable = true;
+
+        NoteGridModel::NoteId selectedNote = 0;
+        NoteGridModel::Note dragOrigin;
+        Drag drag = Drag::None;
+
+        juce::Colour blackKeyRowColour { 0x18000000 };
+        juce::Colour gridLineColour { 0x30ffffff };
+        juce::Colour barLineColour { 0x60ffffff };
+        juce::Colour noteColour { 0xff66fdcf };
+        juce::Colour selectedNoteColour { 0xffffffff };
+        juce::Colour noteLineColour { 0xff1e1e1e };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NoteGridView)
+    };
+
+}
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    blueprint_ObjectCensus.h
+    Created: 15 Oct 2026 11:38:02pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Counts the live instances of its owner class, process-wide, as a member
+        of it: one increment on construction and one decrement on destruction,
+        always on, in release builds as in debug, unlike JUCE's leak detector.
+     */
+    template <typename Owner>
+    class LiveObjectCounter
+    {
+    public:
+        LiveObjectCounter() noexcept { count.fetch_add(1, std::memory_order_relaxed); }
+        LiveObjectCounter (const LiveObjectCounter&) noexcept : LiveObjectCounter() {}
+        ~LiveObjectCounter() { count.fetch_sub(1, std::memory_order_relaxed); }
+
+        LiveObjectCounter& operator= (const LiveObjectCounter&) noexcept { return *this; }
+
+        /** Returns the number of live instances of the owner class. */
+        static int getNumLive() noexcept { return count.load(std::memory_order_relaxed); }
+
+    private:
+        inline static std::atomic<int> count { 0 };
+    };
+
+    //==============================================================================
+    /** Samples, once a second or so, how many views, shadow views, Yoga nodes and
+        raw text views are alive, together with the size of the root's view table
+        and of JavaScript's view registry, to catch slow growth over a long
+        session: a table entry never removed, or a registry entry never
+        released, shows as a line which climbs while the interface stays the
+        same.
+
+        The instance counts are process-wide, from LiveObjectCounters and Yoga's
+        own count; the rest are the root's. Counting is always on and costs an
+        atomic increment per object; sampling, a few loads, as the root runs its
+        scheduled work.
+
+        Read the samples with the root's `getObjectCensus`, or from JavaScript
+        with `__BlueprintNative__.getObjectCensus()`, which also counts the
+        root's views by type.
+     */
+    class ObjectCensus
+    {
+    public:
+        //==============================================================================
+        struct Sample
+        {
+            double time = 0.0;
+
+            // Process-wide.
+            int numViews = 0;
+            int numShadowViews = 0;
+            int numYogaNodes = 0;
+            int numRawTextViews = 0;
+
+            // The root's own: its table, the removed views it has yet to
+            // destroy, the views it keeps for reuse, and JavaScript's registry
+            // of view instances.
+            int numTableEntries = 0;
+            int numBuriedViews = 0;
+            int numPooledViews = 0;
+            int scriptViewRegistrySize = 0;
+        };
+
+        //==============================================================================
+        ObjectCensus() = default;
+
+        /** Returns true if it's time for the next sample. */
+        bool isSampleDue (double now) const { return now - lastSampleTime >= sampleIntervalMs; }
+
+        /** Keeps a sample, with the root's views counted by type, dropping the
+            oldest sample once the ring is full.
+         */
+        void addSample (const Sample& sample, std::map<juce::String, int> viewTypeCounts)
+        {
+            lastSampleTime = sample.time;
+
+            const juce::SpinLock::ScopedLockType sl (lock);
+            latestViewTypeCounts = std::move(viewTypeCounts);
+            ring[nextIndex] = sample;
+            nextIndex = (nextIndex + 1) % ring.size();
+            numSamples = juce::jmin(numSamples + 1, ring.size());
+        }
+
+        /** Returns the samples kept, oldest first. */
+        std::vector<Sample> getSamples() const
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+
+            std::vector<Sample> samples;
+            samples.reserve(numSamples);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                samples.push_back(ring[(nextIndex + ring.size() - numSamples + i) % ring.size()]);
+
+            return samples;
+        }
+
+        /** Returns the root's views counted by type, as of the latest sample. */
+        std::map<juce::String, int> getViewTypeCounts() const
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+            return latestViewTypeCounts;
+        }
+
+        /** Notes the size of JavaScript's view registry, as JavaScript reports it
+            after each commit. Safe to call from any thread.
+         */
+        void setScriptViewRegistrySize (int size) { scriptViewRegistrySize.store(size, std::memory_order_relaxed); }
+
+        /** Returns the size JavaScript last reported for its view registry. */
+        int getScriptViewRegistrySize() const { return scriptViewRegistrySize.load(std::memory_order_relaxed); }
+
+        //==============================================================================
+        static constexpr double sampleIntervalMs = 1000.0;
+
+        // Ten minutes' worth, at one a second.
+        static constexpr size_t numSamplesKept = 600;
+
+    private:
+        //==============================================================================
+        mutable juce::SpinLock lock;
+        std::array<Sample, numSamplesKept> ring;
+        size_t nextIndex = 0;
+        size_t numSamples = 0;
+        std::map<juce::String, int> latestViewTypeCounts;
+
+        double lastSampleTime = 0.0;
+        std::atomic<int> scriptViewRegistrySize { 0 };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ObjectCensus)
+    };
+
+}
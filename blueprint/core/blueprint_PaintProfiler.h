@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    blueprint_PaintProfiler.h
+    Created: 15 Oct 2026 11:31:44pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#include "blueprint_Identifiers.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Times each view's paint, while a root is profiling, to show which views
+        are expensive to draw: where a layer cache or a native widget would pay.
+
+        A view's own `paint` is timed, not its children's, through
+        View::ScopedPaintTimer. The times are summed by view type and refId,
+        for each paint of the root and since profiling began, and each view's
+        own cost per paint is kept for the performance overlay's heatmap. A
+        view painted in several tiles, or several times in one paint, counts
+        each of them.
+
+        Views may paint on the tiled rasterizer's threads, so the figures are
+        kept under a lock; profiling is off by default, and costs a clock read
+        and a flag test per paint otherwise.
+     */
+    class PaintProfiler
+    {
+    public:
+        //==============================================================================
+        /** What the paints of one view type and refId cost. Times are in
+            milliseconds.
+         */
+        struct Entry
+        {
+            const char* viewType = nullptr;
+            juce::Identifier refId;
+            double totalMs = 0.0;
+            double maxMs = 0.0;
+            int numPaints = 0;
+        };
+
+        /** What one view costs per paint, lately. */
+        struct ViewCost
+        {
+            int viewId = 0;
+            double ms = 0.0;
+        };
+
+        //==============================================================================
+        PaintProfiler() = default;
+
+        /** Starts or stops profiling. Stopping forgets every figure. */
+        void setEnabled (bool shouldBeEnabled)
+        {
+            if (shouldBeEnabled == isEnabled())
+                return;
+
+            enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+
+            if (!shouldBeEnabled)
+                reset();
+        }
+
+        /** Returns true while profiling. */
+        bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+        /** Forgets every figure. */
+        void reset()
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+            current.clear();
+            totals.clear();
+            latest.clear();
+            viewCosts.clear();
+        }
+
+        //==============================================================================
+        /** Adds one paint of a view. The view type must outlive the profiler, as
+            string literals do.
+         */
+        void record (int viewId, const juce::Identifier& refId, const char* viewType, double ms)
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+
+            const Key key { viewType, refId };
+            add(current[key], key, ms);
+            add(totals[key], key, ms);
+
+            // The cost of one paint, smoothed a little, as a view's paints vary.
+            auto it = viewCosts.find(viewId);
+
+            if (it == viewCosts.end())
+                viewCosts.emplace(viewId, ms);
+            else
+                it->second += (ms - it->second) * viewCostSmoothing;
+        }
+
+        /** Closes the root's paint in progress, making its figures the latest.
+            A paint in which no view was timed leaves the latest as they were.
+         */
+        void closePaint()
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+
+            if (current.empty())
+                return;
+
+            latest = toSortedEntries(current);
+            current.clear();
+        }
+
+        /** Forgets a view which has gone, such as one JavaScript removed. */
+        void forgetView (int viewId)
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+            viewCosts.erase(viewId);
+        }
+
+        //==============================================================================
+        /** Returns the figures of the latest paint, the costliest first. */
+        std::vector<Entry> getLatestPaint() const
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+            return latest;
+        }
+
+        /** Returns the figures since profiling began, the costliest first. */
+        std::vector<Entry> getTotals() const
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+            return toSortedEntries(totals);
+        }
+
+        /** Returns what each view painted since profiling began costs per paint. */
+        std::vector<ViewCost> getViewCosts() const
+        {
+            const juce::SpinLock::ScopedLockType sl (lock);
+
+            std::vector<ViewCost> costs;
+            costs.reserve(viewCosts.size());
+
+            for (const auto& [viewId, ms] : viewCosts)
+                costs.push_back({ viewId, ms });
+
+            return costs;
+        }
+
+    private:
+        //==============================================================================
+        struct Key
+        {
+            const char* viewType;
+            juce::Identifier refId;
+
+            bool operator== (const Key& other) const { return viewType == other.viewType && refId == other.refId; }
+        };
+
+        struct KeyHash
+        {
+            size_t operator() (const Key& key) const noexcept
+            {
+                return std::hash<const void*>()(key.viewType) * 31 + IdentifierHash()(key.refId);
+            }
+        };
+
+        typedef std::unordered_map<Key, Entry, KeyHash> EntryMap;
+
+        static void add (Entry& entry, const Key& key, double ms)
+        {
+            entry.viewType = key.viewType;
+            entry.refId = key.refId;
+            entry.totalMs += ms;
+            entry.maxMs = juce::jmax(entry.maxMs, ms);
+            entry.numPaints++;
+        }
+
+        static std::vector<Entry> toSortedEntries (const EntryMap& map)
+        {
+            std::vector<Entry> entries;
+            entries.reserve(map.size());
+
+            for (const auto& [key, entry] : map)
+                entries.push_back(entry);
+
+            std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.totalMs > b.totalMs; });
+            return entries;
+        }
+
+        //==============================================================================
+        static constexpr double viewCostSmoothing = 0.25;
+
+        std::atomic<bool> enabled { false };
+
+        mutable juce::SpinLock lock;
+        EntryMap current;
+        EntryMap totals;
+        std::vector<Entry> latest;
+        std::unordered_map<int, double> viewCosts;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PaintProfiler)
+    };
+
+}
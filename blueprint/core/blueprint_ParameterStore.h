@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    blueprint_ParameterStore.h
+    Created: 15 Oct 2026 9:58:14pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_ReactApplicationRoot.h"
+
+
+namespace blueprint
+{
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_processors
+
+    //==============================================================================
+    /** Mirrors the values of an AudioProcessor's parameters into the ParameterStore
+        of juce-blueprint, for plugins which would otherwise each keep a store of
+        their own on top of parameter events.
+
+        Changes may come from the audio thread, and under automation far more
+        often than we render, so the store only records each one in a coalesced
+        channel in the root, without locking or allocating. Once a frame, the
+        root sends JavaScript a single "parameterValuesChange" event holding an
+        entry for each parameter that changed since, with its latest value:
+
+            { parameterIndex, parameterId, defaultValue, currentValue, stringValue }
+
+        The store sends every parameter's value when it's made, so that a root
+        taken over from a parked one, which missed the changes made while it was
+        away, catches up at the next frame. The channel lives with the root, and
+        its entries refer to the processor, which must outlive the root; the
+        store itself needn't, so an editor can hold one as long as it shows the
+        root. Make and destroy it on the message thread.
+     */
+    class ParameterStore : private juce::AudioProcessorParameter::Listener
+    {
+    public:
+        //==============================================================================
+        ParameterStore (juce::AudioProcessor& _processor, ReactApplicationRoot& root)
+            : processor(_processor)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            const auto& parameters = processor.getParameters();
+            channel = root.getCoalescedEventChannel(eventType);
+
+            if (channel == nullptr)
+                channel = &root.registerCoalescedEventType(eventType, parameters.size(), makeFormatter(processor));
+
+            // A processor's parameters are fixed once it's made.
+            jassert (channel->getNumKeys() == parameters.size());
+
+            for (auto* p : parameters)
+            {
+                p->addListener(this);
+                channel->set(p->getParameterIndex(), p->getValue());
+            }
+        }
+
+        ~ParameterStore() override
+        {
+            for (auto* p : processor.getParameters())
+                p->removeListener(this);
+        }
+
+        //==============================================================================
+        /** The event the store's changes are dispatched as. */
+        static inline const juce::Identifier eventType { "parameterValuesChange" };
+
+    private:
+        //==============================================================================
+        void parameterValueChanged (int parameterIndex, float newValue) override
+        {
+            // This may well be the audio thread, so we only record the change.
+            channel->set(parameterIndex, newValue);
+        }
+
+        void parameterGestureChanged (int, bool) override {}
+
+        /** Fills in the rest of each change, on the message thread, as it goes out. */
+        static ReactApplicationRoot::CoalescedEventFormatter makeFormatter (juce::AudioProcessor& processor)
+        {
+            return [&processor](int parameterIndex, double value) -> juce::var {
+                const auto* p = processor.getParameters()[parameterIndex];
+                const float newValue = static_cast<float>(value);
+                juce::String id = p->getName(100);
+
+                if (auto* x = dynamic_cast<const juce::AudioProcessorParameterWithID*>(p))
+                    id = x->paramID;
+
+                auto* change = new juce::DynamicObject();
+                change->setProperty("parameterIndex", parameterIndex);
+                change->setProperty("parameterId", id);
+                change->setProperty("defaultValue", p->getDefaultValue());
+                change->setProperty("currentValue", newValue);
+                change->setProperty("stringValue", p->getText(newValue, 0));
+
+                return juce::var(change);
+            };
+        }
+
+        //==============================================================================
+        juce::AudioProcessor& processor;
+        CoalescedEventChannel* channel = nullptr;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterStore)
+    };
+
+#endif
+
+}
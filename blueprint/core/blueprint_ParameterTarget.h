@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    blueprint_ParameterTarget.h
+    Created: 15 Oct 2026 9:21:14am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A native value which views can drive directly, such as a plugin parameter
+        a SliderView writes as it's dragged, without a round trip through React.
+
+        The value is normalised to [0, 1]. Every function is called on the
+        message thread.
+     */
+    struct ParameterTarget
+    {
+        /** Reads the current value. */
+        std::function<double()> getValue;
+
+        /** Writes a new value, telling whoever needs to know, e.g. the host. */
+        std::function<void(double)> setValue;
+
+        /** Brackets a run of writes made by one gesture, e.g. a drag. Either may
+            be left empty.
+         */
+        std::function<void()> beginGesture;
+        std::function<void()> endGesture;
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_processors
+        //==============================================================================
+        /** A target writing a plugin parameter, notifying the host. */
+        static ParameterTarget fromParameter (juce::AudioProcessorParameter& parameter)
+        {
+            ParameterTarget target;
+
+            target.getValue = [&parameter]() -> double { return parameter.getValue(); };
+            target.setValue = [&parameter](double v) { parameter.setValueNotifyingHost(static_cast<float>(v)); };
+            target.beginGesture = [&parameter]() { parameter.beginChangeGesture(); };
+            target.endGesture = [&parameter]() { parameter.endChangeGesture(); };
+
+            return target;
+        }
+#endif
+    };
+
+}
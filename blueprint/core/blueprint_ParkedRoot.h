@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    blueprint_ParkedRoot.h
+    Created: 15 Oct 2026 2:06:18pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <memory>
+
+#include "blueprint_ReactApplicationRoot.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Keeps a ReactApplicationRoot between one editor and the next, so that an
+        editor reopened by the host picks up where the last left off, with the
+        bundle evaluated and the view tree mounted, rather than starting over.
+
+        The processor owns one of these. An editor closing parks its root here,
+        and the next editor takes it back, falling back to building a root of
+        its own if there's nothing parked. A root whose heap exceeds the memory
+        budget, once compacted, is torn down rather than parked, as is any root
+        still parked when the holder is destroyed.
+
+        Whatever the root calls back into must outlive the editor which set it
+        up, so native methods should capture the processor rather than the
+        editor. The editor taking over a root registers only what it needs of
+        its own, e.g. parameter listeners, and looks up channels with
+        `getCoalescedEventChannel`. Use on the message thread.
+     */
+    class ParkedRoot
+    {
+    public:
+        //==============================================================================
+        /** Creates a holder for roots whose heap fits within the given budget, in
+            bytes.
+         */
+        explicit ParkedRoot (size_t _memoryBudget = 32 * 1024 * 1024)
+            : memoryBudget(_memoryBudget) {}
+
+        //==============================================================================
+        /** Parks the given root, in place of any already parked, unless its heap
+            is over budget, in which case it's destroyed.
+         */
+        void park (std::unique_ptr<ReactApplicationRoot> root)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            parked = nullptr;
+
+            if (root == nullptr)
+                return;
+
+            root->prepareToPark(true);
+
+            // A script thread's heap is out of reach until it's idle, so we take
+            // it as it comes.
+            if (!root->isScriptThreadEnabled() && root->getHeapSize() > memoryBudget)
+                return;
+
+            parked = std::move(root);
+        }
+
+        /** Returns the parked root, leaving none parked, or nullptr if there's
+            nothing parked.
+         */
+        std::unique_ptr<ReactApplicationRoot> take()
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+            return std::move(parked);
+        }
+
+        /** Destroys the parked root, if there is one. */
+        void clear()
+        {
+            parked = nullptr;
+        }
+
+        /** Returns true if a root is parked. */
+        bool hasParkedRoot() const { return parked != nullptr; }
+
+        //==============================================================================
+        /** Sets the most heap, in bytes, a root may keep while parked. */
+        void setMemoryBudget (size_t newBudget) { memoryBudget = newBudget; }
+
+        /** Returns the most heap, in bytes, a root may keep while parked. */
+        size_t getMemoryBudget() const { return memoryBudget; }
+
+    private:
+        //==============================================================================
+        size_t memoryBudget;
+        std::unique_ptr<ReactApplicationRoot> parked;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParkedRoot)
+    };
+
+}
@@ -0,0 +1,239 @@
+/*
+  ==============================================================================
+
+    blueprint_PerformanceOverlay.h
+    Created: 15 Oct 2026 5:52:40pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "blueprint_HeapMeter.h"
+#include "blueprint_PerformanceStats.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Draws a root's performance figures over its interface, for developers to
+        keep an eye on while they work.
+
+        A panel in the corner graphs the cost of the latest frames, script and
+        layout stacked, against the budget of a 60Hz frame, and lists the last
+        frame's bridge calls, layout and repaints together with the size of the
+        JavaScript heap. Each area the root repaints flashes briefly, so that a
+        repaint larger than the change that caused it stands out. While the root
+        profiles its paints, each view is tinted by what it costs to paint, from
+        clear to red at `heatmapFullScaleMs`.
+
+        The root owns the overlay and paints it over its children. Everything
+        happens on the message thread.
+     */
+    class PerformanceOverlay
+    {
+    public:
+        //==============================================================================
+        explicit PerformanceOverlay (juce::Component& _owner)
+            : owner(_owner)
+        {
+            owner.repaint(getPanelBounds());
+        }
+
+        ~PerformanceOverlay()
+        {
+            owner.repaint(getPanelBounds());
+
+            for (const auto& f : flashes)
+                owner.repaint(f.area.expanded(1));
+        }
+
+        //==============================================================================
+        /** Flashes an area repainted, in the owner's coordinates. */
+        void addRepaint (const juce::Rectangle<int>& area, double now)
+        {
+            if (area.isEmpty())
+                return;
+
+            if (flashes.size() >= maxFlashes)
+                flashes.erase(flashes.begin());
+
+            flashes.push_back({ area, now });
+        }
+
+        /** Repaints the panel for the frame just completed, and the flashes still
+            fading. Returns true while a flash is showing, for the owner to wake
+            at the next frame.
+         */
+        bool update (double now)
+        {
+            owner.repaint(getPanelBounds());
+
+            flashes.erase(std::remove_if(flashes.begin(), flashes.end(), [&](const Flash& f) {
+                const bool done = now - f.time >= flashDurationMs;
+
+                // One last repaint clears it away.
+                owner.repaint(f.area.expanded(1));
+                return done;
+            }), flashes.end());
+
+            return !flashes.empty();
+        }
+
+        //==============================================================================
+        /** Paints the flashes and the panel, over whatever the owner painted. */
+        void paint (juce::Graphics& g, const PerformanceStats& stats, const HeapMeter::Stats& heap, double now) const
+        {
+            for (const auto& f : flashes)
+            {
+                const float alpha = juce::jlimit(0.0f, 1.0f, 1.0f - (float) ((now - f.time) / flashDurationMs));
+
+                g.setColour(flashColour.withMultipliedAlpha(alpha * 0.25f));
+                g.fillRect(f.area);
+                g.setColour(flashColour.withMultipliedAlpha(alpha));
+                g.drawRect(f.area);
+            }
+
+            const auto bounds = getPanelBounds();
+
+            if (!g.clipRegionIntersects(bounds))
+                return;
+
+            g.setColour(juce::Colour(0xd0101418));
+            g.fillRect(bounds);
+
+            const auto frames = stats.getFrames();
+            auto area = bounds.reduced(padding);
+            paintGraph(g, area.removeFromTop(graphHeight), frames);
+
+            if (frames.empty())
+                return;
+
+            const auto& last = frames.back();
+            double scriptMs = 0.0;
+            int numBridgeCalls = 0;
+
+            for (auto ms : last.scriptMs)
+                scriptMs += ms;
+
+            for (auto n : last.numBridgeCalls)
+                numBridgeCalls += n;
+
+            juce::StringArray lines;
+            lines.add("script " + juce::String(scriptMs, 2) + "ms, layout " + juce::String(last.layoutMs, 2)
+                      + "ms (" + juce::String(last.numViewsLaidOut) + " views)");
+            lines.add("bridge " + juce::String(numBridgeCalls) + " calls: "
+                      + juce::String(last.numBridgeCalls[PerformanceStats::CreateViewCall]) + " create, "
+                      + juce::String(last.numBridgeCalls[PerformanceStats::SetPropertyCall]
+                                     + last.numBridgeCalls[PerformanceStats::SetPropertiesCall]) + " set, "
+                      + juce::String(last.numBridgeCalls[PerformanceStats::AddChildCall]
+                                     + last.numBridgeCalls[PerformanceStats::RemoveChildCall]
+                                     + last.numBridgeCalls[PerformanceStats::MoveChildCall]) + " tree");
+            lines.add("repaints " + juce::String(last.numRepaints) + ", text measures " + juce::String(last.numTextMeasures));
+            lines.add("heap " + juce::File::descriptionOfSizeInBytes((juce::int64) heap.liveBytes)
+                      + " (peak " + juce::File::descriptionOfSizeInBytes((juce::int64) heap.peakBytes) + ")");
+
+            g.setColour(juce::Colours::white);
+            g.setFont(juce::Font(11.0f));
+
+            for (const auto& line : lines)
+                g.drawText(line, area.removeFromTop(lineHeight), juce::Justification::centredLeft, true);
+        }
+
+        /** What one view costs to paint, over its area in the owner. */
+        struct PaintCost
+        {
+            juce::Rectangle<int> area;
+            double ms;
+        };
+
+        /** Tints each view by its paint cost, under the flashes and the panel. */
+        void paintHeatmap (juce::Graphics& g, const std::vector<PaintCost>& costs) const
+        {
+            for (const auto& c : costs)
+            {
+                if (!g.clipRegionIntersects(c.area))
+                    continue;
+
+                const float heat = juce::jlimit(0.0f, 1.0f, (float) (c.ms / heatmapFullScaleMs));
+
+                g.setColour(heatColour.withAlpha(heat * 0.5f));
+                g.fillRect(c.area);
+            }
+        }
+
+        // A view which takes a tenth of a 60Hz frame to paint shows at full heat.
+        static constexpr double heatmapFullScaleMs = 1000.0 / 600.0;
+
+    private:
+        //==============================================================================
+        struct Flash
+        {
+            juce::Rectangle<int> area;
+            double time;
+        };
+
+        juce::Rectangle<int> getPanelBounds() const
+        {
+            const int height = padding * 2 + graphHeight + numLines * lineHeight;
+            return { owner.getWidth() - panelWidth - padding, padding, panelWidth, height };
+        }
+
+        /** A bar for each frame, script under layout, scaled to two frames' worth. */
+        static void paintGraph (juce::Graphics& g, juce::Rectangle<int> area, const std::vector<PerformanceStats::Frame>& frames)
+        {
+            const double scaleMs = 2.0 * budgetMs;
+            const float barWidth = (float) area.getWidth() / (float) PerformanceStats::numFramesKept;
+            const auto bottom = (float) area.getBottom();
+            const auto toHeight = [&](double ms) { return (float) (juce::jmin(ms, scaleMs) / scaleMs) * (float) area.getHeight(); };
+
+            for (size_t i = 0; i < frames.size(); ++i)
+            {
+                double scriptMs = 0.0;
+
+                for (auto ms : frames[i].scriptMs)
+                    scriptMs += ms;
+
+                const bool overBudget = scriptMs + frames[i].layoutMs > budgetMs;
+                const float x = (float) area.getX() + barWidth * (float) (PerformanceStats::numFramesKept - frames.size() + i);
+                const float scriptHeight = toHeight(scriptMs);
+                const float layoutHeight = toHeight(scriptMs + frames[i].layoutMs) - scriptHeight;
+
+                g.setColour(overBudget ? juce::Colour(0xffe04848) : juce::Colour(0xff48c878));
+                g.fillRect(x, bottom - scriptHeight, juce::jmax(1.0f, barWidth - 1.0f), scriptHeight);
+                g.setColour(juce::Colour(0xff4890e0));
+                g.fillRect(x, bottom - scriptHeight - layoutHeight, juce::jmax(1.0f, barWidth - 1.0f), layoutHeight);
+            }
+
+            // The budget line, halfway up.
+            g.setColour(juce::Colours::white.withAlpha(0.5f));
+            g.drawHorizontalLine(area.getCentreY(), (float) area.getX(), (float) area.getRight());
+        }
+
+        //==============================================================================
+        // A 60Hz frame.
+        static constexpr double budgetMs = 1000.0 / 60.0;
+        static constexpr double flashDurationMs = 300.0;
+        static constexpr size_t maxFlashes = 64;
+
+        static constexpr int panelWidth = 260;
+        static constexpr int padding = 6;
+        static constexpr int graphHeight = 48;
+        static constexpr int lineHeight = 14;
+        static constexpr int numLines = 4;
+
+        const juce::Colour flashColour { 0xffff40c0 };
+        const juce::Colour heatColour { 0xffff3020 };
+
+        juce::Component& owner;
+        std::vector<Flash> flashes;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PerformanceOverlay)
+    };
+
+}
@@ -0,0 +1,602 @@
+/*
+  ==============================================================================
+
+    blueprint_PerformanceStats.h
+    Created: 15 Oct 2026 2:31:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Counts where the time of each of a root's frames goes, for profiling and
+        for in-app overlays.
+
+        A frame runs from one of the root's scheduler callbacks to the next, and
+        takes in everything the root does in between, such as events delivered
+        by the host. Each frame's figures are added up as it goes, then kept in
+        a ring of the latest frames once the next begins.
+
+        Alongside the frames, the stats keep a histogram of input latency: the
+        time from the OS's timestamp on a mouse event JavaScript handles to the
+        first paint after the commit which responded to it. Each input gets an
+        id as it arrives, the root notes the latest id JavaScript had seen as it
+        closes each commit, and the next paint settles every input up to that.
+
+        The stats also break down how long the root took to open, from the
+        creation of its engine to the first paint of the tree the bundle built,
+        into the phases of `StartupPhase`. Each phase is timed from when it first
+        began, relative to the engine's creation; those which may run more than
+        once before the first paint, as when an editor evaluates a script of its
+        own ahead of the bundle, add up their durations. The first commit runs
+        within the evaluation, and the first layout within the first commit, so
+        the phases overlap rather than add up to the whole.
+
+        Figures are recorded on the message thread, apart from the startup
+        phases, which the script thread may record too. The ring of completed
+        frames, the figures of the registered native methods, the input latency
+        and the startup phases may be read from any thread.
+     */
+    class PerformanceStats
+    {
+    public:
+        //==============================================================================
+        /** The kinds of call into JavaScript we time. */
+        enum ScriptCallType
+        {
+            TimerCall,
+            EventCall,
+            AnimationFrameCall,
+            EvaluationCall,
+            MicrotaskCall,
+            IdleCall,
+            numScriptCallTypes
+        };
+
+        /** The kinds of tree operation JavaScript asks of us, whether directly or
+            in a command buffer.
+         */
+        enum BridgeCallType
+        {
+            CreateViewCall,
+            CreateTextViewCall,
+            SetPropertyCall,
+            SetPropertiesCall,
+            SetTextCall,
+            AddChildCall,
+            RemoveChildCall,
+            MoveChildCall,
+            FlushCommandsCall,
+            StartAnimationCall,
+            StopAnimationCall,
+            numBridgeCallTypes
+        };
+
+        /** The phases of opening a root. */
+        enum StartupPhase
+        {
+            HeapCreationPhase,
+            BundleReadPhase,
+            CompilePhase,
+            EvaluationPhase,
+            FirstCommitPhase,
+            FirstLayoutPhase,
+            FirstPaintPhase,
+            numStartupPhases
+        };
+
+        /** A change JavaScript made to a view which called for a layout or a
+            repaint: a property set, by name, or the view's text or children.
+         */
+        struct Invalidation
+        {
+            int viewId = 0;
+            juce::Identifier refId;
+            juce::Identifier cause;
+            bool affectsLayout = false;
+            bool affectsPaint = false;
+        };
+
+        /** What one frame cost. Times are in milliseconds. */
+        struct Frame
+        {
+            double startTime = 0.0;
+            double durationMs = 0.0;
+
+            std::array<double, numScriptCallTypes> scriptMs {};
+            std::array<int, numScriptCallTypes> numScriptCalls {};
+            std::array<int, numBridgeCallTypes> numBridgeCalls {};
+
+            double layoutMs = 0.0;
+            int numLayouts = 0;
+            int numViewsLaidOut = 0;
+            int numTextMeasures = 0;
+            int numRepaints = 0;
+
+            // Calls to methods registered with `registerNativeMethod`.
+            double nativeMethodMs = 0.0;
+            int numNativeMethodCalls = 0;
+
+            // What caused the frame's layouts and repaints, while invalidations
+            // are tracked, up to maxInvalidationsPerFrame of them; the count
+            // includes those past the limit.
+            std::vector<Invalidation> invalidations;
+            int numInvalidations = 0;
+        };
+
+        /** What the calls to one method registered with `registerNativeMethod`
+            have cost since it was registered. Times are in milliseconds.
+         */
+        struct NativeMethod
+        {
+            juce::Identifier name;
+            juce::uint64 numCalls = 0;
+            double totalMs = 0.0;
+            double maxMs = 0.0;
+        };
+
+        /** The histogram of input latency. Times are in milliseconds. */
+        struct InputLatency
+        {
+            // Each bucket counts the inputs up to its limit, and over the last
+            // bucket's; the last count is of the rest.
+            static constexpr int numBuckets = 9;
+            static constexpr std::array<double, numBuckets - 1> bucketLimitsMs { { 4.0, 8.0, 16.0, 24.0, 33.0, 50.0, 100.0, 200.0 } };
+
+            std::array<juce::uint64, numBuckets> counts {};
+            juce::uint64 numInputs = 0;
+            double totalMs = 0.0;
+            double maxMs = 0.0;
+
+            /** Returns the bucket limit under which the given proportion of inputs
+                fell, or the longest latency for those over the last limit.
+             */
+            double getPercentile (double proportion) const
+            {
+                const auto target = static_cast<juce::uint64>(std::ceil(proportion * (double) numInputs));
+                juce::uint64 seen = 0;
+
+                for (size_t i = 0; i < bucketLimitsMs.size(); ++i)
+                    if ((seen += counts[i]) >= target && target > 0)
+                        return bucketLimitsMs[i];
+
+                return maxMs;
+            }
+        };
+
+        /** When each startup phase began, after the engine's creation, and how
+            long it took. Times are in milliseconds, and -1 for phases not reached.
+         */
+        struct Startup
+        {
+            Startup()
+            {
+                startMs.fill(-1.0);
+                durationMs.fill(-1.0);
+            }
+
+            /** Returns the time from the engine's creation to the end of the first
+                paint, or -1 if the root hasn't painted yet.
+             */
+            double getTotalMs() const
+            {
+                return durationMs[FirstPaintPhase] >= 0.0 ? startMs[FirstPaintPhase] + durationMs[FirstPaintPhase] : -1.0;
+            }
+
+            std::array<double, numStartupPhases> startMs;
+            std::array<double, numStartupPhases> durationMs;
+        };
+
+        //==============================================================================
+        /** Times a call into JavaScript, given stats to add it to, or else nothing. */
+        class ScopedScriptCall
+        {
+        public:
+            ScopedScriptCall (PerformanceStats* _stats, ScriptCallType _type)
+                : stats(_stats), type(_type), start(_stats != nullptr ? now() : 0.0) {}
+
+            ~ScopedScriptCall()
+            {
+                if (stats == nullptr)
+                    return;
+
+                stats->current.scriptMs[type] += now() - start;
+                stats->current.numScriptCalls[type]++;
+            }
+
+        private:
+            PerformanceStats* stats;
+            ScriptCallType type;
+            double start;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedScriptCall)
+        };
+
+        /** Times a layout pass. */
+        class ScopedLayout
+        {
+        public:
+            explicit ScopedLayout (PerformanceStats& _stats) : stats(_stats), start(now()) {}
+
+            ~ScopedLayout()
+            {
+                stats.current.layoutMs += now() - start;
+                stats.current.numLayouts++;
+            }
+
+        private:
+            PerformanceStats& stats;
+            double start;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedLayout)
+        };
+
+        /** Times a startup phase, given stats to add it to, or else nothing. */
+        class ScopedStartupPhase
+        {
+        public:
+            ScopedStartupPhase (PerformanceStats* _stats, StartupPhase _phase)
+                : stats(_stats), phase(_phase)
+            {
+                if (stats != nullptr)
+                    stats->beginStartupPhase(phase);
+            }
+
+            ~ScopedStartupPhase()
+            {
+                if (stats != nullptr)
+                    stats->endStartupPhase(phase);
+            }
+
+        private:
+            PerformanceStats* stats;
+            StartupPhase phase;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedStartupPhase)
+        };
+
+        /** Times a call to a registered native method, given its index. */
+        class ScopedNativeMethodCall
+        {
+        public:
+            ScopedNativeMethodCall (PerformanceStats& _stats, int _index)
+                : stats(_stats), index(_index), start(now()) {}
+
+            ~ScopedNativeMethodCall()
+            {
+                const double ms = now() - start;
+
+                stats.current.nativeMethodMs += ms;
+                stats.current.numNativeMethodCalls++;
+
+                const juce::SpinLock::ScopedLockType sl (stats.ringLock);
+                auto& method = stats.nativeMethods[static_cast<size_t>(index)];
+                method.numCalls++;
+                method.totalMs += ms;
+                method.maxMs = juce::jmax(method.maxMs, ms);
+            }
+
+        private:
+            PerformanceStats& stats;
+            int index;
+            double start;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedNativeMethodCall)
+        };
+
+        //==============================================================================
+        PerformanceStats()
+        {
+            startupPhaseBegan.fill(-1.0);
+        }
+
+        //==============================================================================
+        /** Closes the frame in progress, keeping it in the ring, and opens the next. */
+        void beginFrame()
+        {
+            const double time = now();
+
+            if (current.startTime > 0.0)
+            {
+                current.durationMs = time - current.startTime;
+
+                const juce::SpinLock::ScopedLockType sl (ringLock);
+                ring[nextRingIndex] = std::move(current);
+                nextRingIndex = (nextRingIndex + 1) % ring.size();
+                numFrames = juce::jmin(numFrames + 1, ring.size());
+            }
+
+            current = {};
+            current.startTime = time;
+        }
+
+        /** Returns the frame in progress, for adding figures to. */
+        Frame& getCurrentFrame() { return current; }
+
+        /** Returns the frame in progress. */
+        const Frame& getCurrentFrame() const { return current; }
+
+        /** Returns the latest completed frames, oldest first. */
+        std::vector<Frame> getFrames() const
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            std::vector<Frame> frames;
+            frames.reserve(numFrames);
+
+            for (size_t i = 0; i < numFrames; ++i)
+                frames.push_back(ring[(nextRingIndex + ring.size() - numFrames + i) % ring.size()]);
+
+            return frames;
+        }
+
+        /** Starts counting the calls to a native method, returning the index to
+            time them by. A name registered before keeps its index and figures.
+         */
+        int addNativeMethod (const juce::Identifier& name)
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+
+            for (size_t i = 0; i < nativeMethods.size(); ++i)
+                if (nativeMethods[i].name == name)
+                    return static_cast<int>(i);
+
+            nativeMethods.push_back({ name });
+            return static_cast<int>(nativeMethods.size() - 1);
+        }
+
+        //==============================================================================
+        /** Starts or stops noting, in each frame, which changes to which views
+            caused its layouts and repaints. It costs an entry per change, so
+            it's off by default. Safe to call from any thread.
+         */
+        void setInvalidationTracking (bool shouldTrack) { trackingInvalidations.store(shouldTrack, std::memory_order_relaxed); }
+
+        /** Returns true while invalidations are tracked. */
+        bool isTrackingInvalidations() const { return trackingInvalidations.load(std::memory_order_relaxed); }
+
+        /** Notes an invalidation in the frame in progress. */
+        void addInvalidation (Invalidation invalidation)
+        {
+            if (current.invalidations.size() < maxInvalidationsPerFrame)
+                current.invalidations.push_back(std::move(invalidation));
+
+            current.numInvalidations++;
+        }
+
+        /** Returns the figures of every registered native method, in the order
+            they were registered.
+         */
+        std::vector<NativeMethod> getNativeMethods() const
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            return nativeMethods;
+        }
+
+        //==============================================================================
+        /** Notes an input JavaScript will hear of, which the OS timestamped the
+            given time ago, and returns its id.
+         */
+        juce::uint32 beginInput (double ageMs)
+        {
+            const double time = now();
+
+            // Inputs nothing responded to are forgotten, rather than counted
+            // against whatever paints next.
+            while (!pendingInputs.empty() && (pendingInputs.size() >= maxPendingInputs
+                                              || time - pendingInputs.front().time > maxInputLatencyMs))
+                pendingInputs.pop_front();
+
+            pendingInputs.push_back({ ++latestInputId, time - juce::jmax(0.0, ageMs) });
+            return latestInputId;
+        }
+
+        /** Returns the id of the latest input. */
+        juce::uint32 getLatestInputId() const { return latestInputId; }
+
+        /** Notes that a commit has responded to every input up to the given id,
+            which the next paint then shows.
+         */
+        void didRespondToInput (juce::uint32 inputId)
+        {
+            respondedInputId = juce::jmax(respondedInputId, inputId);
+        }
+
+        /** Settles every input responded to, as of a paint now. */
+        void didPaint()
+        {
+            if (pendingInputs.empty() || pendingInputs.front().id > respondedInputId)
+                return;
+
+            const double time = now();
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+
+            while (!pendingInputs.empty() && pendingInputs.front().id <= respondedInputId)
+            {
+                const double ms = time - pendingInputs.front().time;
+                pendingInputs.pop_front();
+
+                if (ms > maxInputLatencyMs)
+                    continue;
+
+                const auto limit = std::lower_bound(InputLatency::bucketLimitsMs.begin(), InputLatency::bucketLimitsMs.end(), ms);
+                inputLatency.counts[static_cast<size_t>(std::distance(InputLatency::bucketLimitsMs.begin(), limit))]++;
+                inputLatency.numInputs++;
+                inputLatency.totalMs += ms;
+                inputLatency.maxMs = juce::jmax(inputLatency.maxMs, ms);
+            }
+        }
+
+        /** Returns the histogram of input latency. */
+        InputLatency getInputLatency() const
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            return inputLatency;
+        }
+
+        /** Empties the histogram of input latency. */
+        void resetInputLatency()
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            inputLatency = {};
+        }
+
+        //==============================================================================
+        /** Forgets any startup phases, timing those to come from now, as the
+            root creates its engine.
+         */
+        void beginStartup()
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            startup = {};
+            startupOrigin = now();
+            startupPhaseBegan.fill(-1.0);
+        }
+
+        /** Notes that a startup phase has begun, unless the root has already
+            painted.
+         */
+        void beginStartupPhase (StartupPhase phase)
+        {
+            const double time = now();
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+
+            if (startup.durationMs[FirstPaintPhase] >= 0.0)
+                return;
+
+            if (startup.startMs[phase] < 0.0)
+                startup.startMs[phase] = time - startupOrigin;
+
+            startupPhaseBegan[phase] = time;
+        }
+
+        /** Notes that a startup phase begun with `beginStartupPhase` has ended. */
+        void endStartupPhase (StartupPhase phase)
+        {
+            const double time = now();
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+
+            if (startupPhaseBegan[phase] < 0.0)
+                return;
+
+            startup.durationMs[phase] = juce::jmax(0.0, startup.durationMs[phase]) + (time - startupPhaseBegan[phase]);
+            startupPhaseBegan[phase] = -1.0;
+        }
+
+        /** Returns true if the given startup phase has begun since the engine's
+            creation.
+         */
+        bool hasBegunStartupPhase (StartupPhase phase) const
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            return startup.startMs[phase] >= 0.0;
+        }
+
+        /** Returns true if the given startup phase has ended at least once since
+            the engine's creation.
+         */
+        bool hasEndedStartupPhase (StartupPhase phase) const
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            return startup.durationMs[phase] >= 0.0;
+        }
+
+        /** Returns true until the root first paints what its bundle built. */
+        bool isStartingUp() const
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            return startup.durationMs[FirstPaintPhase] < 0.0;
+        }
+
+        /** Returns the startup phases. */
+        Startup getStartup() const
+        {
+            const juce::SpinLock::ScopedLockType sl (ringLock);
+            return startup;
+        }
+
+        //==============================================================================
+        /** Returns the JavaScript name of a script call type. */
+        static const char* getScriptCallName (int type)
+        {
+            static const char* const names[] = { "timer", "event", "animationFrame", "evaluation", "microtask", "idle" };
+            static_assert (sizeof(names) / sizeof(names[0]) == numScriptCallTypes, "A script call type has no name");
+
+            return names[type];
+        }
+
+        /** Returns the JavaScript name of a bridge call type. */
+        static const char* getBridgeCallName (int type)
+        {
+            static const char* const names[] = { "createViewInstance", "createTextViewInstance", "setViewProperty",
+                                                 "setViewProperties", "setRawTextValue", "addChild", "removeChild", "moveChild",
+                                                 "flushCommands", "startAnimation", "stopAnimation" };
+            static_assert (sizeof(names) / sizeof(names[0]) == numBridgeCallTypes, "A bridge call type has no name");
+
+            return names[type];
+        }
+
+        /** Returns the JavaScript name of a startup phase. */
+        static const char* getStartupPhaseName (int phase)
+        {
+            static const char* const names[] = { "heapCreation", "bundleRead", "compile", "evaluation",
+                                                 "firstCommit", "firstLayout", "firstPaint" };
+            static_assert (sizeof(names) / sizeof(names[0]) == numStartupPhases, "A startup phase has no name");
+
+            return names[phase];
+        }
+
+        // Two seconds' worth at 60Hz.
+        static constexpr size_t numFramesKept = 120;
+
+        // An input not on screen by then is taken to have had no response.
+        static constexpr double maxInputLatencyMs = 1000.0;
+        static constexpr size_t maxPendingInputs = 256;
+
+        // Enough to show what a frame's heaviest changes were.
+        static constexpr size_t maxInvalidationsPerFrame = 64;
+
+    private:
+        //==============================================================================
+        static double now() { return juce::Time::getMillisecondCounterHiRes(); }
+
+        Frame current;
+
+        juce::SpinLock ringLock;
+        std::array<Frame, numFramesKept> ring;
+        size_t nextRingIndex = 0;
+        size_t numFrames = 0;
+        std::vector<NativeMethod> nativeMethods;
+        std::atomic<bool> trackingInvalidations { false };
+
+        struct PendingInput
+        {
+            juce::uint32 id;
+            double time;
+        };
+
+        std::deque<PendingInput> pendingInputs;
+        juce::uint32 latestInputId = 0;
+        juce::uint32 respondedInputId = 0;
+        InputLatency inputLatency;
+
+        Startup startup;
+        double startupOrigin = 0.0;
+        std::array<double, numStartupPhases> startupPhaseBegan;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PerformanceStats)
+    };
+
+}
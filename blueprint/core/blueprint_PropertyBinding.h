@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    blueprint_PropertyBinding.h
+    Created: 15 Oct 2026 12:34:51am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+
+#include "blueprint_ValueChannel.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The pieces of a native property binding, which drives a view property
+        straight from a native value, such as a meter's fill width from a level or
+        a knob's rotation from a parameter, without a round trip through React.
+
+        A binding reads its source once a frame on the message thread, and only
+        when the value has moved does it map the value to a property value and
+        apply it to the view.
+     */
+    struct PropertyBinding
+    {
+        /** Reads the current value of the binding's source, on the message thread. */
+        typedef std::function<double()> Source;
+
+        /** Maps a source value to the value of the bound property. */
+        typedef std::function<juce::var(double)> Mapping;
+
+        //==============================================================================
+        /** A source reading one value of a value channel, as JavaScript would. */
+        static Source fromValueChannel (ValueChannel& channel, int index)
+        {
+            jassert (juce::isPositiveAndBelow(index, channel.getNumValues()));
+
+            return [&channel, index]() -> double {
+                return channel.getSnapshotData()[index];
+            };
+        }
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_processors
+        /** A source reading a parameter's normalised value. */
+        static Source fromParameter (juce::AudioProcessorParameter& parameter)
+        {
+            return [&parameter]() -> double {
+                return parameter.getValue();
+            };
+        }
+#endif
+
+        /** A mapping taking [inStart, inEnd] linearly onto [outStart, outEnd]. */
+        static Mapping linear (double outStart, double outEnd, double inStart = 0.0, double inEnd = 1.0)
+        {
+            return [=](double v) -> juce::var {
+                return juce::jmap(v, inStart, inEnd, outStart, outEnd);
+            };
+        }
+    };
+
+}
@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    blueprint_RasterCache.h
+    Created: 15 Oct 2026 6:41:17am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Spreads the re-rendering of cached images over several frames when the
+        display scale changes, as when an editor moves between a Retina and a
+        non-Retina monitor, rather than rendering every one of them again in the
+        first paint at the new scale.
+
+        A cache which has an image, for the same area but the old scale, asks
+        `mayRerender` before rendering it again. Within the frame's budget it
+        renders, and adds what that took with `addRerenderTime`; past it, it
+        draws the old image scaled, and the next paint renders it. Roots take
+        `takeDeferred` after each paint, and while anything waits repaint
+        themselves over idle frames, until nothing does.
+
+        The budget is process-wide, since every root paints on the message
+        thread, and a cache may ask from any thread.
+     */
+    struct RescaleBudget
+    {
+        /** Returns true if a cache whose scale alone has changed may render its
+            image again now, or otherwise notes that one is waiting.
+         */
+        static bool mayRerender()
+        {
+            const auto now = juce::Time::getMillisecondCounterHiRes();
+
+            // Each frame's worth of time starts a fresh budget.
+            if (now - windowStart.load(std::memory_order_relaxed) >= frameMs)
+            {
+                windowStart.store(now, std::memory_order_relaxed);
+                spentMs.store(0.0, std::memory_order_relaxed);
+            }
+
+            if (spentMs.load(std::memory_order_relaxed) < budgetMs)
+                return true;
+
+            deferred.store(true, std::memory_order_relaxed);
+            return false;
+        }
+
+        /** Adds the time a re-render took to the frame's budget. */
+        static void addRerenderTime (double ms)
+        {
+            auto spent = spentMs.load(std::memory_order_relaxed);
+            while (!spentMs.compare_exchange_weak(spent, spent + ms, std::memory_order_relaxed)) {}
+        }
+
+        /** Returns true if any cache has drawn its old image since the last
+            call, and so waits for another paint.
+         */
+        static bool takeDeferred() { return deferred.exchange(false, std::memory_order_relaxed); }
+
+        // Re-renders take up to a quarter of a 60Hz frame.
+        static constexpr double frameMs = 1000.0 / 60.0;
+        static constexpr double budgetMs = frameMs / 4.0;
+
+    private:
+        inline static std::atomic<double> windowStart { 0.0 };
+        inline static std::atomic<double> spentMs { 0.0 };
+        inline static std::atomic<bool> deferred { false };
+    };
+
+    //==============================================================================
+    /** A RasterCache holds some vector content rendered once to an image, at the
+        physical pixel scale of the context it's painted into, so that repaints
+        blit the image rather than render the paths again.
+
+        The image is rendered again whenever the area or the scale changes, or
+        the owner invalidates it because the content itself changed. A change of
+        scale alone re-renders within the RescaleBudget, drawing the old image
+        scaled until then.
+
+        Painted through an OpenGL context, the image is rendered on the GPU and
+        kept there, so that each repaint is a texture draw.
+
+        A view may be painted into several tiles at once by the TiledRasterizer,
+        so the image is rendered under a lock, and each tile blits its own
+        reference to it.
+     */
+    class RasterCache
+    {
+    public:
+        //==============================================================================
+        RasterCache() = default;
+
+        //==============================================================================
+        /** Paints the cached content into the given area at the given opacity,
+            first rendering it with `paintContent (juce::Graphics&)` if needed.
+            The content is rendered at full opacity, with the area's top left as
+            its origin.
+         */
+        template <typename PaintFn>
+        void draw (juce::Graphics& g, juce::Rectangle<int> area, float opacity, PaintFn&& paintContent)
+        {
+            if (area.isEmpty())
+                return;
+
+            const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+            const int width = juce::roundToInt(area.getWidth() * scale);
+            const int height = juce::roundToInt(area.getHeight() * scale);
+
+            // Past this size a cached image costs more memory than the paths are
+            // worth rendering again.
+            if (width * (juce::int64) height > maxPixels || width <= 0 || height <= 0)
+            {
+                invalidate();
+
+                juce::Graphics::ScopedSaveState state (g);
+                g.setOrigin(area.getPosition());
+                g.beginTransparencyLayer(opacity);
+                paintContent(g);
+                g.endTransparencyLayer();
+                return;
+            }
+
+            void* context = getOpenGLContext(g);
+            juce::Image rendered;
+            float renderedScale = scale;
+
+            {
+                const juce::ScopedLock sl (lock);
+
+                if (!image.isValid() || area != cachedArea || scale != cachedScale || context != cachedContext)
+                {
+                    const bool rescaling = image.isValid() && area == cachedArea && context == cachedContext;
+
+                    if (!rescaling || RescaleBudget::mayRerender())
+                    {
+                        const auto start = juce::Time::getMillisecondCounterHiRes();
+
+                        image = createImage(width, height, context);
+                        cachedArea = area;
+                        cachedScale = scale;
+                        cachedContext = context;
+
+                        juce::Graphics ig (image);
+                        ig.addTransform(juce::AffineTransform::scale(scale));
+                        paintContent(ig);
+
+                        if (rescaling)
+                            RescaleBudget::addRerenderTime(juce::Time::getMillisecondCounterHiRes() - start);
+                    }
+                }
+
+                rendered = image;
+                renderedScale = cachedScale;
+            }
+
+            juce::Graphics::ScopedSaveState state (g);
+            g.setOpacity(opacity);
+            g.drawImageTransformed(rendered, juce::AffineTransform::scale(1.0f / renderedScale)
+                                              .translated((float) area.getX(), (float) area.getY()));
+        }
+
+        /** Drops the cached image, so that the next draw renders the content again. */
+        void invalidate()
+        {
+            const juce::ScopedLock sl (lock);
+            image = {};
+        }
+
+    private:
+        //==============================================================================
+        /** Returns the OpenGL context the given graphics renders through, if any. */
+        static void* getOpenGLContext (juce::Graphics& g)
+        {
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+            // A software context on the render thread is painting a cached
+            // layer, which would have to read a GPU image back.
+            if (dynamic_cast<juce::LowLevelGraphicsSoftwareRenderer*>(&g.getInternalContext()) == nullptr)
+                return juce::OpenGLContext::getCurrentContext();
+#else
+            juce::ignoreUnused(g);
+#endif
+            return nullptr;
+        }
+
+        static juce::Image createImage (int width, int height, void* context)
+        {
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+            if (context != nullptr)
+                return juce::Image(juce::Image::ARGB, width, height, true, juce::OpenGLImageType());
+#else
+            juce::ignoreUnused(context);
+#endif
+            return juce::Image(juce::Image::ARGB, width, height, true);
+        }
+
+        //==============================================================================
+        // A 4096 pixel square, some 16.8 megapixels, or twice a 4K display's 8.3.
+        static constexpr juce::int64 maxPixels = 4096 * 4096;
+
+        juce::Image image;
+        juce::Rectangle<int> cachedArea;
+        float cachedScale = 0.0f;
+        void* cachedContext = nullptr;
+        juce::CriticalSection lock;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RasterCache)
+    };
+
+}
@@ -31,7 +31,9 @@ namespace blueprint
     {
     public:
         //==============================================================================
-        RawTextView(const juce::String& text) : _text(text) {}
+        static constexpr Kind viewKind = Kind::RawText;
+
+        RawTextView(const juce::String& text) : View(viewKind), _text(text) {}
 
         //==============================================================================
         void setProperty (const juce::Identifier& name, const juce::var& newValue) override
@@ -39,6 +41,12 @@ namespace blueprint
             throw std::logic_error("A RawTextView can't receive properties.");
         }
 
+        void resetForReuse() override
+        {
+            View::resetForReuse();
+            _text = {};
+        }
+
         //==============================================================================
         void setText (const juce::String& text) {
             _text = text;
@@ -52,6 +60,7 @@ namespace blueprint
     private:
         //==============================================================================
         juce::String _text;
+        LiveObjectCounter<RawTextView> liveCounter;
 
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RawTextView)
@@ -13,8 +13,106 @@
 namespace blueprint
 {
 
+    namespace
+    {
+
+        //==============================================================================
+        /** The opcodes of the command buffer bridge. These must match the Opcodes
+            in CommandBuffer.js.
+         */
+        enum CommandOpcode
+        {
+            CreateView = 1,
+            CreateTextView = 2,
+            SetProperty = 3,
+            SetProperties = 4,
+            AddChild = 5,
+            RemoveChild = 6,
+            SetText = 7,
+            MoveChild = 8,
+        };
+
+        /** Returns the length in words, opcode included, of the given command. */
+        int getCommandLength (juce::int32 opcode)
+        {
+            switch (opcode)
+            {
+                case SetProperty:
+                case AddChild:
+                case MoveChild:
+                    return 4;
+                case CreateView:
+                case CreateTextView:
+                case SetProperties:
+                case RemoveChild:
+                case SetText:
+                    return 3;
+                default:
+                    return 0;
+            }
+        }
+
+        /** Returns the number of view ids, or handles, leading the operands of
+            the given command.
+         */
+        int getNumViewOperands (juce::int32 opcode)
+        {
+            switch (opcode)
+            {
+                case AddChild:
+                case RemoveChild:
+                case MoveChild:
+                    return 2;
+                case SetProperty:
+                case SetProperties:
+                case SetText:
+                    return 1;
+                default:
+                    return 0;
+            }
+        }
+
+        /** Reads the props object at the given stack index into a NamedValueSet.
+
+            We enumerate the object once; the stack top during iteration is
+            [ ... enum key value ]. The `children` prop is skipped, as React uses
+            it for the element tree which we handle through addChild instead.
+         */
+        void readPropertiesFromDukStack (duk_context* ctx, duk_idx_t idx, juce::NamedValueSet& properties)
+        {
+            duk_enum(ctx, idx, DUK_ENUM_OWN_PROPERTIES_ONLY);
+
+            while (duk_next(ctx, -1, 1))
+            {
+                const auto key = ReactApplicationRoot::internDukKey(ctx, -2);
+
+                if (key.isValid() && key != IDs::children)
+                    properties.set(key, ReactApplicationRoot::readVarFromDukStack(ctx, -1));
+
+                duk_pop_2(ctx);
+            }
+
+            duk_pop(ctx);
+        }
+
+    }
+
+    //==============================================================================
+    juce::var DukValue<juce::var>::read (duk_context* ctx, duk_idx_t idx)
+    {
+        return ReactApplicationRoot::readVarFromDukStack(ctx, idx);
+    }
+
+    void DukValue<juce::var>::push (duk_context* ctx, const juce::var& v)
+    {
+        ReactApplicationRoot::pushVarToDukStack(ctx, v);
+    }
+
+    //==============================================================================
     duk_ret_t BlueprintNative::createViewInstance (duk_context *ctx)
     {
+        BLUEPRINT_TRACE_SCOPE("createViewInstance");
+
         // Retrieve the root instance pointer
         duk_push_global_stash(ctx);
         duk_get_prop_string(ctx, -1, "rootInstance");
@@ -33,6 +131,8 @@ namespace blueprint
 
     duk_ret_t BlueprintNative::createTextViewInstance (duk_context *ctx)
     {
+        BLUEPRINT_TRACE_SCOPE("createTextViewInstance");
+
         // Retrieve the root instance pointer
         duk_push_global_stash(ctx);
         duk_get_prop_string(ctx, -1, "rootInstance");
@@ -51,6 +151,8 @@ namespace blueprint
 
     duk_ret_t BlueprintNative::setViewProperty (duk_context *ctx)
     {
+        BLUEPRINT_TRACE_SCOPE("setViewProperty", duk_get_int(ctx, 0));
+
         // Retrieve the root instance pointer
         duk_push_global_stash(ctx);
         duk_get_prop_string(ctx, -1, "rootInstance");
@@ -68,8 +170,91 @@ namespace blueprint
         return 0;
     };
 
+    duk_ret_t BlueprintNative::setViewProperties (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("setViewProperties", duk_get_int(ctx, 0));
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_number(ctx, 0) && duk_is_object(ctx, 1));
+
+        ViewId viewId = duk_get_int(ctx, 0);
+        juce::NamedValueSet properties;
+
+        readPropertiesFromDukStack(ctx, 1, properties);
+        root->setViewProperties(viewId, properties);
+        return 0;
+    };
+
+    duk_ret_t BlueprintNative::registerStyleSheet (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("registerStyleSheet");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_object(ctx, 0));
+
+        juce::NamedValueSet properties;
+
+        readPropertiesFromDukStack(ctx, 0, properties);
+        duk_push_int(ctx, root->registerStyleSheet(properties));
+        return 1;
+    };
+
+    duk_ret_t BlueprintNative::getPropertyId (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getPropertyId");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_string(ctx, 0));
+
+        juce::Identifier propertyName (duk_get_string(ctx, 0));
+
+        duk_push_int(ctx, root->getPropertyId(propertyName));
+        return 1;
+    };
+
+    duk_ret_t BlueprintNative::setViewPropertyById (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("setViewPropertyById", duk_get_int(ctx, 0));
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_number(ctx, 0) && duk_is_number(ctx, 1));
+
+        ViewId viewId = duk_get_int(ctx, 0);
+        int propertyId = duk_get_int(ctx, 1);
+        juce::var propertyValue = ReactApplicationRoot::readVarFromDukStack(ctx, 2);
+
+        root->setViewPropertyById(viewId, propertyId, propertyValue);
+        return 0;
+    };
+
     duk_ret_t BlueprintNative::setRawTextValue (duk_context *ctx)
     {
+        BLUEPRINT_TRACE_SCOPE("setRawTextValue", duk_get_int(ctx, 0));
+
         // Retrieve the root instance pointer
         duk_push_global_stash(ctx);
         duk_get_prop_string(ctx, -1, "rootInstance");
@@ -88,6 +273,8 @@ namespace blueprint
 
     duk_ret_t BlueprintNative::addChild (duk_context *ctx)
     {
+        BLUEPRINT_TRACE_SCOPE("addChild", duk_get_int(ctx, 0));
+
         // Retrieve the root instance pointer
         duk_push_global_stash(ctx);
         duk_get_prop_string(ctx, -1, "rootInstance");
@@ -108,8 +295,27 @@ namespace blueprint
         return 0;
     };
 
+    duk_ret_t BlueprintNative::moveChild (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("moveChild", duk_get_int(ctx, 0));
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_number(ctx, 0) && duk_is_number(ctx, 1) && duk_is_number(ctx, 2));
+
+        root->moveChild(duk_get_int(ctx, 0), duk_get_int(ctx, 1), duk_get_int(ctx, 2));
+        return 0;
+    }
+
     duk_ret_t BlueprintNative::removeChild (duk_context *ctx)
     {
+        BLUEPRINT_TRACE_SCOPE("removeChild", duk_get_int(ctx, 0));
+
         // Retrieve the root instance pointer
         duk_push_global_stash(ctx);
         duk_get_prop_string(ctx, -1, "rootInstance");
@@ -128,6 +334,8 @@ namespace blueprint
 
     duk_ret_t BlueprintNative::getRootInstanceId (duk_context *ctx)
     {
+        BLUEPRINT_TRACE_SCOPE("getRootInstanceId");
+
         // Retrieve the root instance pointer
         duk_push_global_stash(ctx);
         duk_get_prop_string(ctx, -1, "rootInstance");
@@ -141,33 +349,1600 @@ namespace blueprint
         return 1;
     }
 
-    duk_context* initializeDuktapeContext()
+    duk_ret_t BlueprintNative::getSurfaceInstanceId (duk_context *ctx)
     {
-        // Allocate a new js heap
-        duk_context* ctx = duk_create_heap_default();
+        BLUEPRINT_TRACE_SCOPE("getSurfaceInstanceId");
 
-        // Add console.log support
-        duk_console_init(ctx, DUK_CONSOLE_FLUSH);
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
 
-        // Register react render backend functions
-        const duk_function_list_entry blueprintNativeFuncs[] = {
-            { "createViewInstance", BlueprintNative::createViewInstance, 1},
-            { "createTextViewInstance", BlueprintNative::createTextViewInstance, 1},
-            { "setViewProperty", BlueprintNative::setViewProperty, 3},
-            { "setRawTextValue", BlueprintNative::setRawTextValue, 2},
-            { "addChild", BlueprintNative::addChild, 3},
-            { "removeChild", BlueprintNative::removeChild, 2},
-            { "getRootInstanceId", BlueprintNative::getRootInstanceId, 0},
-            { NULL, NULL, 0 }
+        jassert (root != nullptr);
+        jassert (duk_is_string(ctx, 0));
+
+        duk_push_int(ctx, root->getSurfaceViewId(juce::String::fromUTF8(duk_get_string(ctx, 0))));
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getOverlayInstanceId (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getOverlayInstanceId");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_string(ctx, 0));
+
+        duk_push_int(ctx, root->getOverlayViewId(juce::String::fromUTF8(duk_get_string(ctx, 0))));
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::beginCommit (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("beginCommit");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->beginCommit();
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::endCommit (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("endCommit");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->endCommit();
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::flushCommands (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("flushCommands");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_buffer_data(ctx, 0) && duk_is_array(ctx, 1));
+
+        duk_size_t numBytes = 0;
+        auto* words = static_cast<juce::int32*>(duk_require_buffer_data(ctx, 0, &numBytes));
+        const int numWords = static_cast<int>(numBytes / sizeof(juce::int32));
+
+        // Views created earlier in the same buffer are referenced by a negative
+        // handle, -(k + 1), where k is the offset at which we wrote the new view id.
+        auto resolveViewId = [words](juce::int32 ref) -> ViewId {
+            return ref >= 0 ? ref : words[-(ref + 1)];
         };
 
-        duk_push_global_object(ctx);
-        duk_push_object(ctx);
-        duk_put_function_list(ctx, -1, blueprintNativeFuncs);
-        duk_put_prop_string(ctx, -2, "__BlueprintNative__");
-        duk_pop(ctx);
+        // A handle is only good if it points before the command using it, at
+        // the id a create has written there, and never at another handle.
+        auto isValidViewRef = [words](juce::int32 ref, int commandOffset) {
+            if (ref >= 0)
+                return true;
 
-        return ctx;
+            const auto offset = -(static_cast<juce::int64>(ref) + 1);
+
+            return offset > 0 && offset < commandOffset
+                && (words[offset - 1] == CreateView || words[offset - 1] == CreateTextView)
+                && words[offset] > 0;
+        };
+
+        auto readValueString = [ctx](juce::int32 valueIndex) -> juce::String {
+            duk_get_prop_index(ctx, 1, static_cast<duk_uarridx_t>(valueIndex));
+            juce::String value (juce::CharPointer_UTF8(duk_safe_to_string(ctx, -1)));
+            duk_pop(ctx);
+            return value;
+        };
+
+        root->recordBridgeCall(PerformanceStats::FlushCommandsCall);
+        root->beginCommit();
+
+        for (int i = 0; i < numWords;)
+        {
+            const int length = getCommandLength(words[i]);
+
+            // If you hit this, the buffer is malformed or was written by a version of
+            // CommandBuffer.js that doesn't match this native implementation.
+            if (length == 0 || i + length > numWords)
+            {
+                jassertfalse;
+                break;
+            }
+
+            const juce::int32* args = words + i + 1;
+            bool hasValidViewRefs = true;
+
+            for (int operand = 0; operand < getNumViewOperands(words[i]); ++operand)
+                hasValidViewRefs = hasValidViewRefs && isValidViewRef(args[operand], i);
+
+            // If you hit this, a command refers to a view by a handle which no
+            // earlier command in the buffer created.
+            if (!hasValidViewRefs)
+            {
+                jassertfalse;
+                break;
+            }
+
+            switch (words[i])
+            {
+                case CreateView:
+                    words[i + 1] = root->createViewInstance(readValueString(args[1]));
+                    break;
+                case CreateTextView:
+                    words[i + 1] = root->createTextViewInstance(readValueString(args[1]));
+                    break;
+                case SetProperty:
+                    duk_get_prop_index(ctx, 1, static_cast<duk_uarridx_t>(args[2]));
+                    root->setViewPropertyById(resolveViewId(args[0]), args[1], ReactApplicationRoot::readVarFromDukStack(ctx, -1));
+                    duk_pop(ctx);
+                    break;
+                case SetProperties:
+                {
+                    juce::NamedValueSet properties;
+
+                    duk_get_prop_index(ctx, 1, static_cast<duk_uarridx_t>(args[1]));
+                    readPropertiesFromDukStack(ctx, -1, properties);
+                    duk_pop(ctx);
+
+                    root->setViewProperties(resolveViewId(args[0]), properties);
+                    break;
+                }
+                case AddChild:
+                    root->addChild(resolveViewId(args[0]), resolveViewId(args[1]), args[2]);
+                    break;
+                case RemoveChild:
+                    root->removeChild(resolveViewId(args[0]), resolveViewId(args[1]));
+                    break;
+                case SetText:
+                    root->setRawTextValue(resolveViewId(args[0]), readValueString(args[1]));
+                    break;
+                case MoveChild:
+                    root->moveChild(resolveViewId(args[0]), resolveViewId(args[1]), args[2]);
+                    break;
+                default:
+                    break;
+            }
+
+            i += length;
+        }
+
+        root->endCommit();
+        return 0;
+    }
+
+    namespace
+    {
+        /** Shared implementation of setTimeout and setInterval. */
+        duk_ret_t addTimer (duk_context* ctx, bool repeating)
+        {
+            // Retrieve the root instance pointer
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, "rootInstance");
+            ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+            duk_pop_2(ctx);
+
+            jassert (root != nullptr);
+
+            const duk_idx_t nargs = duk_get_top(ctx);
+            duk_require_function(ctx, 0);
+
+            const auto id = root->addTimer(duk_get_number_default(ctx, 1, 0.0), repeating);
+
+            // Hold the callback and any trailing arguments in the stash as
+            // [callback, ...args], where the timer queue can't see them.
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, "timerCallbacks");
+            duk_push_array(ctx);
+
+            duk_dup(ctx, 0);
+            duk_put_prop_index(ctx, -2, 0);
+
+            for (duk_idx_t i = 2; i < nargs; ++i)
+            {
+                duk_dup(ctx, i);
+                duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i - 1));
+            }
+
+            duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(id));
+            duk_pop_2(ctx);
+
+            duk_push_int(ctx, id);
+            return 1;
+        }
+    }
+
+    duk_ret_t BlueprintNative::setTimeout (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("setTimeout");
+
+        return addTimer(ctx, false);
+    }
+
+    duk_ret_t BlueprintNative::setInterval (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("setInterval");
+
+        return addTimer(ctx, true);
+    }
+
+    duk_ret_t BlueprintNative::clearTimeout (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("clearTimeout");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        // As in the browser, clearing an unknown or expired id does nothing.
+        if (!duk_is_number(ctx, 0))
+            return 0;
+
+        const auto id = static_cast<TimerQueue::TimerId>(duk_get_int(ctx, 0));
+
+        if (id <= 0)
+            return 0;
+
+        root->cancelTimer(id);
+
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "timerCallbacks");
+        duk_del_prop_index(ctx, -1, static_cast<duk_uarridx_t>(id));
+        duk_pop_2(ctx);
+
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::requestAnimationFrame (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("requestAnimationFrame");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        duk_require_function(ctx, 0);
+        const int id = root->addAnimationFrame();
+
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "animationFrameCallbacks");
+        duk_dup(ctx, 0);
+        duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(id));
+        duk_pop_2(ctx);
+
+        duk_push_int(ctx, id);
+        return 1;
     }
 
+    duk_ret_t BlueprintNative::cancelAnimationFrame (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("cancelAnimationFrame");
+
+        // Dropping the callback is enough; the root skips ids it can't find.
+        if (!duk_is_number(ctx, 0) || duk_get_int(ctx, 0) <= 0)
+            return 0;
+
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "animationFrameCallbacks");
+        duk_del_prop_index(ctx, -1, static_cast<duk_uarridx_t>(duk_get_int(ctx, 0)));
+        duk_pop_2(ctx);
+
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::requestIdleCallback (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("requestIdleCallback");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        duk_require_function(ctx, 0);
+        const int id = root->addIdleCallback();
+
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "idleCallbacks");
+        duk_dup(ctx, 0);
+        duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(id));
+        duk_pop_2(ctx);
+
+        duk_push_int(ctx, id);
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::cancelIdleCallback (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("cancelIdleCallback");
+
+        // As for animation frames, the root skips ids it can't find.
+        if (!duk_is_number(ctx, 0) || duk_get_int(ctx, 0) <= 0)
+            return 0;
+
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "idleCallbacks");
+        duk_del_prop_index(ctx, -1, static_cast<duk_uarridx_t>(duk_get_int(ctx, 0)));
+        duk_pop_2(ctx);
+
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::queueMicrotask (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("queueMicrotask");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        duk_require_function(ctx, 0);
+
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "microtasks");
+        duk_dup(ctx, 0);
+        duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(duk_get_length(ctx, -2)));
+        duk_pop_2(ctx);
+
+        root->didQueueMicrotask();
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::shouldYield (duk_context *ctx)
+    {
+        // Called between every unit of a concurrent render, so no tracing here.
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        duk_push_boolean(ctx, root->getFrameTimeRemaining() <= 0.0);
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getFrameTimeRemaining (duk_context *ctx)
+    {
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        duk_push_number(ctx, root->getFrameTimeRemaining());
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::performanceNow (duk_context *ctx)
+    {
+        // Called for every timer check React's scheduler makes, so no tracing here.
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        duk_push_number(ctx, root->getClockTime());
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::performanceMark (duk_context *ctx)
+    {
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->addUserTimingMark(juce::String(juce::CharPointer_UTF8(duk_safe_to_string(ctx, 0))));
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::performanceMeasure (duk_context *ctx)
+    {
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        const juce::String name (juce::CharPointer_UTF8(duk_safe_to_string(ctx, 0)));
+        juce::String startMark, endMark;
+
+        // Either the start and end marks' names, or an object of them.
+        if (duk_is_object(ctx, 1))
+        {
+            if (duk_get_prop_string(ctx, 1, "start") && duk_is_string(ctx, -1))
+                startMark = juce::CharPointer_UTF8(duk_get_string(ctx, -1));
+
+            if (duk_get_prop_string(ctx, 1, "end") && duk_is_string(ctx, -1))
+                endMark = juce::CharPointer_UTF8(duk_get_string(ctx, -1));
+
+            duk_pop_2(ctx);
+        }
+        else
+        {
+            if (duk_is_string(ctx, 1))
+                startMark = juce::CharPointer_UTF8(duk_get_string(ctx, 1));
+
+            if (duk_is_string(ctx, 2))
+                endMark = juce::CharPointer_UTF8(duk_get_string(ctx, 2));
+        }
+
+        double duration = 0.0;
+
+        if (!root->measureUserTiming(name, startMark, endMark, duration))
+            return duk_error(ctx, DUK_ERR_SYNTAX_ERROR, "no such mark for measure %s", name.toRawUTF8());
+
+        duk_push_object(ctx);
+        duk_push_string(ctx, name.toRawUTF8());
+        duk_put_prop_string(ctx, -2, "name");
+        duk_push_string(ctx, "measure");
+        duk_put_prop_string(ctx, -2, "entryType");
+        duk_push_number(ctx, duration);
+        duk_put_prop_string(ctx, -2, "duration");
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::performanceClearMarks (duk_context *ctx)
+    {
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->clearUserTimingMarks(duk_is_string(ctx, 0) ? juce::String(juce::CharPointer_UTF8(duk_get_string(ctx, 0)))
+                                                          : juce::String());
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::getValueChannel (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getValueChannel");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop(ctx);
+
+        jassert (root != nullptr);
+
+        const char* name = duk_require_string(ctx, 0);
+        ValueChannel* channel = root->getValueChannel(name);
+
+        if (channel == nullptr)
+        {
+            duk_pop(ctx);
+            return 0;
+        }
+
+        // Each channel's Float32Array is made once per context, and then handed
+        // out again from the stash.
+        duk_get_prop_string(ctx, -1, "valueChannels");
+
+        if (!duk_get_prop_string(ctx, -1, name))
+        {
+            duk_pop(ctx);
+
+            // An external buffer sits on the channel's own snapshot memory, so
+            // JavaScript reads the values in place.
+            const auto numBytes = static_cast<duk_size_t>(channel->getNumValues()) * sizeof(float);
+
+            duk_push_external_buffer(ctx);
+            duk_config_buffer(ctx, -1, channel->getSnapshotData(), numBytes);
+            duk_push_buffer_object(ctx, -1, 0, numBytes, DUK_BUFOBJ_FLOAT32ARRAY);
+            duk_remove(ctx, -2);
+
+            duk_dup_top(ctx);
+            duk_put_prop_string(ctx, -3, name);
+        }
+
+        // Outside of an animation frame this is the first we've heard of a read,
+        // so bring the values up to date.
+        channel->updateSnapshot();
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::createWorker (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("createWorker");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        duk_push_int(ctx, root->createWorker(juce::String::fromUTF8(duk_require_string(ctx, 0))));
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::postWorkerMessage (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("postWorkerMessage");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        // Encoded here, on the engine's thread, and decoded on the worker's.
+        const int id = duk_require_int(ctx, 0);
+        root->postWorkerMessage(id, ScriptWorker::Message::encode(ctx, 1));
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::terminateWorker (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("terminateWorker");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->terminateWorker(duk_require_int(ctx, 0));
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::startAnimation (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("startAnimation", duk_get_int(ctx, 0));
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_number(ctx, 0) && duk_is_string(ctx, 1) && duk_is_object(ctx, 2));
+
+        ViewId viewId = duk_get_int(ctx, 0);
+        juce::String property = duk_get_string(ctx, 1);
+        juce::var config = ReactApplicationRoot::readVarFromDukStack(ctx, 2);
+
+        duk_push_int(ctx, root->startAnimation(viewId, property, config));
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::stopAnimation (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("stopAnimation", duk_get_int(ctx, 0));
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        if (duk_is_number(ctx, 0))
+            root->stopAnimation(duk_get_int(ctx, 0));
+
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::getStats (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getStats");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        const auto frames = root->getPerformanceStats().getFrames();
+        duk_push_array(ctx);
+
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            const auto& frame = frames[i];
+            duk_push_object(ctx);
+
+            duk_push_number(ctx, frame.startTime);
+            duk_put_prop_string(ctx, -2, "startTime");
+            duk_push_number(ctx, frame.durationMs);
+            duk_put_prop_string(ctx, -2, "durationMs");
+
+            duk_push_object(ctx);
+            duk_push_object(ctx);
+
+            for (int type = 0; type < PerformanceStats::numScriptCallTypes; ++type)
+            {
+                duk_push_number(ctx, frame.scriptMs[type]);
+                duk_put_prop_string(ctx, -3, PerformanceStats::getScriptCallName(type));
+                duk_push_int(ctx, frame.numScriptCalls[type]);
+                duk_put_prop_string(ctx, -2, PerformanceStats::getScriptCallName(type));
+            }
+
+            duk_put_prop_string(ctx, -3, "scriptCalls");
+            duk_put_prop_string(ctx, -2, "scriptMs");
+
+            duk_push_object(ctx);
+
+            for (int type = 0; type < PerformanceStats::numBridgeCallTypes; ++type)
+            {
+                duk_push_int(ctx, frame.numBridgeCalls[type]);
+                duk_put_prop_string(ctx, -2, PerformanceStats::getBridgeCallName(type));
+            }
+
+            duk_put_prop_string(ctx, -2, "bridgeCalls");
+
+            duk_push_number(ctx, frame.layoutMs);
+            duk_put_prop_string(ctx, -2, "layoutMs");
+            duk_push_int(ctx, frame.numLayouts);
+            duk_put_prop_string(ctx, -2, "numLayouts");
+            duk_push_int(ctx, frame.numViewsLaidOut);
+            duk_put_prop_string(ctx, -2, "numViewsLaidOut");
+            duk_push_int(ctx, frame.numTextMeasures);
+            duk_put_prop_string(ctx, -2, "numTextMeasures");
+            duk_push_int(ctx, frame.numRepaints);
+            duk_put_prop_string(ctx, -2, "numRepaints");
+            duk_push_number(ctx, frame.nativeMethodMs);
+            duk_put_prop_string(ctx, -2, "nativeMethodMs");
+            duk_push_int(ctx, frame.numNativeMethodCalls);
+            duk_put_prop_string(ctx, -2, "numNativeMethodCalls");
+            duk_push_int(ctx, frame.numInvalidations);
+            duk_put_prop_string(ctx, -2, "numInvalidations");
+
+            duk_push_array(ctx);
+
+            for (size_t j = 0; j < frame.invalidations.size(); ++j)
+            {
+                const auto& invalidation = frame.invalidations[j];
+                duk_push_object(ctx);
+
+                duk_push_int(ctx, invalidation.viewId);
+                duk_put_prop_string(ctx, -2, "viewId");
+
+                if (invalidation.refId.isValid())
+                    duk_push_string(ctx, invalidation.refId.getCharPointer().getAddress());
+                else
+                    duk_push_null(ctx);
+
+                duk_put_prop_string(ctx, -2, "refId");
+                duk_push_string(ctx, invalidation.cause.getCharPointer().getAddress());
+                duk_put_prop_string(ctx, -2, "cause");
+                duk_push_boolean(ctx, invalidation.affectsLayout);
+                duk_put_prop_string(ctx, -2, "layout");
+                duk_push_boolean(ctx, invalidation.affectsPaint);
+                duk_put_prop_string(ctx, -2, "repaint");
+
+                duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(j));
+            }
+
+            duk_put_prop_string(ctx, -2, "invalidations");
+
+            duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i));
+        }
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::setInvalidationTracking (duk_context *ctx)
+    {
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->setInvalidationTrackingEnabled(duk_to_boolean(ctx, 0) != 0);
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::setPaintProfiling (duk_context *ctx)
+    {
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->setPaintProfilingEnabled(duk_to_boolean(ctx, 0) != 0);
+        return 0;
+    }
+
+    namespace
+    {
+        /** Pushes an array of paint profiler entries, one object each. */
+        void pushPaintEntries (duk_context* ctx, const std::vector<PaintProfiler::Entry>& entries)
+        {
+            duk_push_array(ctx);
+
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                const auto& entry = entries[i];
+                duk_push_object(ctx);
+
+                duk_push_string(ctx, entry.viewType);
+                duk_put_prop_string(ctx, -2, "viewType");
+
+                if (entry.refId.isValid())
+                    duk_push_string(ctx, entry.refId.getCharPointer().getAddress());
+                else
+                    duk_push_null(ctx);
+
+                duk_put_prop_string(ctx, -2, "refId");
+                duk_push_number(ctx, entry.totalMs);
+                duk_put_prop_string(ctx, -2, "totalMs");
+                duk_push_number(ctx, entry.maxMs);
+                duk_put_prop_string(ctx, -2, "maxMs");
+                duk_push_int(ctx, entry.numPaints);
+                duk_put_prop_string(ctx, -2, "numPaints");
+
+                duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i));
+            }
+        }
+    }
+
+    duk_ret_t BlueprintNative::getPaintStats (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getPaintStats");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        const auto& profiler = root->getPaintProfiler();
+        duk_push_object(ctx);
+
+        duk_push_boolean(ctx, profiler.isEnabled());
+        duk_put_prop_string(ctx, -2, "enabled");
+        pushPaintEntries(ctx, profiler.getLatestPaint());
+        duk_put_prop_string(ctx, -2, "lastPaint");
+        pushPaintEntries(ctx, profiler.getTotals());
+        duk_put_prop_string(ctx, -2, "totals");
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getObjectCensus (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getObjectCensus");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        const auto& census = root->getObjectCensus();
+        const auto samples = census.getSamples();
+
+        duk_push_object(ctx);
+        duk_push_array(ctx);
+
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            const auto& sample = samples[i];
+            duk_push_object(ctx);
+
+            duk_push_number(ctx, sample.time);
+            duk_put_prop_string(ctx, -2, "time");
+            duk_push_int(ctx, sample.numViews);
+            duk_put_prop_string(ctx, -2, "views");
+            duk_push_int(ctx, sample.numShadowViews);
+            duk_put_prop_string(ctx, -2, "shadowViews");
+            duk_push_int(ctx, sample.numYogaNodes);
+            duk_put_prop_string(ctx, -2, "yogaNodes");
+            duk_push_int(ctx, sample.numRawTextViews);
+            duk_put_prop_string(ctx, -2, "rawTextViews");
+            duk_push_int(ctx, sample.numTableEntries);
+            duk_put_prop_string(ctx, -2, "tableEntries");
+            duk_push_int(ctx, sample.numBuriedViews);
+            duk_put_prop_string(ctx, -2, "buriedViews");
+            duk_push_int(ctx, sample.numPooledViews);
+            duk_put_prop_string(ctx, -2, "pooledViews");
+            duk_push_int(ctx, sample.scriptViewRegistrySize);
+            duk_put_prop_string(ctx, -2, "viewRegistry");
+
+            duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i));
+        }
+
+        duk_put_prop_string(ctx, -2, "samples");
+        duk_push_object(ctx);
+
+        for (const auto& [type, count] : census.getViewTypeCounts())
+        {
+            duk_push_int(ctx, count);
+            duk_put_prop_string(ctx, -2, type.toRawUTF8());
+        }
+
+        duk_put_prop_string(ctx, -2, "viewTypes");
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::reportViewRegistrySize (duk_context *ctx)
+    {
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->setScriptViewRegistrySize(duk_get_int(ctx, 0));
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::getHeapStats (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getHeapStats");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        const auto stats = root->getHeapStats();
+        duk_push_object(ctx);
+
+        duk_push_number(ctx, static_cast<duk_double_t>(stats.liveBytes));
+        duk_put_prop_string(ctx, -2, "liveBytes");
+        duk_push_number(ctx, static_cast<duk_double_t>(stats.peakBytes));
+        duk_put_prop_string(ctx, -2, "peakBytes");
+        duk_push_number(ctx, static_cast<duk_double_t>(stats.numAllocations));
+        duk_put_prop_string(ctx, -2, "numAllocations");
+        duk_push_number(ctx, static_cast<duk_double_t>(stats.numRefusals));
+        duk_put_prop_string(ctx, -2, "numRefusals");
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getHeapCensus (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getHeapCensus");
+
+        // The census walks the heap it's called from, which is the root's.
+        DukValue<juce::var>::push(ctx, takeHeapCensus(ctx).toVar());
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getNativeMethodStats (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getNativeMethodStats");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        // An object keyed by method name
+        duk_push_object(ctx);
+
+        for (const auto& method : root->getPerformanceStats().getNativeMethods())
+        {
+            duk_push_object(ctx);
+
+            duk_push_number(ctx, static_cast<duk_double_t>(method.numCalls));
+            duk_put_prop_string(ctx, -2, "numCalls");
+            duk_push_number(ctx, method.totalMs);
+            duk_put_prop_string(ctx, -2, "totalMs");
+            duk_push_number(ctx, method.maxMs);
+            duk_put_prop_string(ctx, -2, "maxMs");
+
+            duk_put_prop_string(ctx, -2, method.name.toString().toRawUTF8());
+        }
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getInputLatencyStats (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getInputLatencyStats");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        const auto latency = root->getPerformanceStats().getInputLatency();
+        using InputLatency = PerformanceStats::InputLatency;
+
+        duk_push_object(ctx);
+
+        duk_push_number(ctx, static_cast<duk_double_t>(latency.numInputs));
+        duk_put_prop_string(ctx, -2, "numInputs");
+        duk_push_number(ctx, latency.numInputs > 0 ? latency.totalMs / (double) latency.numInputs : 0.0);
+        duk_put_prop_string(ctx, -2, "meanMs");
+        duk_push_number(ctx, latency.maxMs);
+        duk_put_prop_string(ctx, -2, "maxMs");
+        duk_push_number(ctx, latency.getPercentile(0.5));
+        duk_put_prop_string(ctx, -2, "p50Ms");
+        duk_push_number(ctx, latency.getPercentile(0.95));
+        duk_put_prop_string(ctx, -2, "p95Ms");
+
+        // An array of [upToMs, count], the last bucket's limit null.
+        duk_push_array(ctx);
+
+        for (int i = 0; i < InputLatency::numBuckets; ++i)
+        {
+            duk_push_array(ctx);
+
+            if (i < InputLatency::numBuckets - 1)
+                duk_push_number(ctx, InputLatency::bucketLimitsMs[static_cast<size_t>(i)]);
+            else
+                duk_push_null(ctx);
+
+            duk_put_prop_index(ctx, -2, 0);
+            duk_push_number(ctx, static_cast<duk_double_t>(latency.counts[static_cast<size_t>(i)]));
+            duk_put_prop_index(ctx, -2, 1);
+
+            duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i));
+        }
+
+        duk_put_prop_string(ctx, -2, "histogram");
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getStartupStats (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getStartupStats");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        const auto startup = root->getPerformanceStats().getStartup();
+
+        // An object of { startMs, durationMs } by phase name, each -1 for a
+        // phase not yet reached, and the total to the first paint.
+        duk_push_object(ctx);
+
+        for (int i = 0; i < PerformanceStats::numStartupPhases; ++i)
+        {
+            duk_push_object(ctx);
+            duk_push_number(ctx, startup.startMs[static_cast<size_t>(i)]);
+            duk_put_prop_string(ctx, -2, "startMs");
+            duk_push_number(ctx, startup.durationMs[static_cast<size_t>(i)]);
+            duk_put_prop_string(ctx, -2, "durationMs");
+            duk_put_prop_string(ctx, -2, PerformanceStats::getStartupPhaseName(i));
+        }
+
+        duk_push_number(ctx, startup.getTotalMs());
+        duk_put_prop_string(ctx, -2, "totalMs");
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getCacheStats (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("getCacheStats");
+
+        // An object keyed by cache name; the caches are shared by every root
+        juce::SharedResourcePointer<CacheManager> cacheManager;
+        duk_push_object(ctx);
+
+        for (const auto& cache : cacheManager->getStats())
+        {
+            duk_push_object(ctx);
+
+            duk_push_number(ctx, static_cast<duk_double_t>(cache.second.numEntries));
+            duk_put_prop_string(ctx, -2, "numEntries");
+            duk_push_number(ctx, static_cast<duk_double_t>(cache.second.numBytes));
+            duk_put_prop_string(ctx, -2, "numBytes");
+            duk_push_number(ctx, static_cast<duk_double_t>(cache.second.unusedBytes));
+            duk_put_prop_string(ctx, -2, "unusedBytes");
+            duk_push_number(ctx, static_cast<duk_double_t>(cache.second.budgetBytes));
+            duk_put_prop_string(ctx, -2, "budgetBytes");
+
+            duk_put_prop_string(ctx, -2, cache.first.toRawUTF8());
+        }
+
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::getParameterIndex (duk_context *ctx)
+    {
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        duk_push_int(ctx, root->getParameterTargetIndex(juce::String::fromUTF8(duk_require_string(ctx, 0))));
+        return 1;
+    }
+
+    duk_ret_t BlueprintNative::setParameterValues (duk_context *ctx)
+    {
+        BLUEPRINT_TRACE_SCOPE("setParameterValues");
+
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        // A flat array of target, value, target, value..., each target an index
+        // from getParameterIndex, or else a name.
+        const auto length = static_cast<duk_uarridx_t>(duk_get_length(ctx, 0));
+        std::vector<std::pair<int, double>> values;
+        values.reserve(length / 2);
+
+        for (duk_uarridx_t i = 0; i + 1 < length; i += 2)
+        {
+            duk_get_prop_index(ctx, 0, i);
+            const int index = duk_is_string(ctx, -1) ? root->getParameterTargetIndex(juce::String::fromUTF8(duk_get_string(ctx, -1)))
+                                                     : duk_to_int(ctx, -1);
+
+            duk_get_prop_index(ctx, 0, i + 1);
+            values.emplace_back(index, duk_to_number(ctx, -1));
+            duk_pop_2(ctx);
+        }
+
+        auto gesture = ReactApplicationRoot::ParameterGesture::none;
+
+        if (duk_is_string(ctx, 1))
+        {
+            const juce::String phase (duk_get_string(ctx, 1));
+
+            if (phase == "begin")
+                gesture = ReactApplicationRoot::ParameterGesture::begin;
+            else if (phase == "end")
+                gesture = ReactApplicationRoot::ParameterGesture::end;
+        }
+
+        root->setParameterValues(values, gesture);
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::beginAllocationBurst (duk_context *ctx)
+    {
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->beginAllocationBurst();
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::endAllocationBurst (duk_context *ctx)
+    {
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+
+        root->endAllocationBurst();
+        return 0;
+    }
+
+    duk_ret_t BlueprintNative::resolveModule (duk_context *ctx)
+    {
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_string(ctx, 0) && duk_is_string(ctx, 1));
+
+        // Called by module-node with [ requestedId parentId ]. Anything thrown is
+        // thrown once we're out of scope of our C++ objects.
+        {
+            BLUEPRINT_TRACE_SCOPE("resolveModule");
+
+            const auto id = root->resolveModule(juce::String::fromUTF8(duk_get_string(ctx, 0)),
+                                                juce::String::fromUTF8(duk_get_string(ctx, 1)));
+
+            if (id.isEmpty())
+                duk_push_error_object(ctx, DUK_ERR_ERROR, "cannot find module '%s'", duk_get_string(ctx, 0));
+            else
+                duk_push_string(ctx, id.toRawUTF8());
+        }
+
+        return duk_is_error(ctx, -1) ? duk_throw(ctx) : 1;
+    }
+
+    duk_ret_t BlueprintNative::loadModule (duk_context *ctx)
+    {
+        // Retrieve the root instance pointer
+        duk_push_global_stash(ctx);
+        duk_get_prop_string(ctx, -1, "rootInstance");
+        ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+        duk_pop_2(ctx);
+
+        jassert (root != nullptr);
+        jassert (duk_is_string(ctx, 0));
+
+        // Called by module-node with [ resolvedId exports module ]. The root holds
+        // the bytecode, so it outlives the scope in which we fetch it.
+        const void* bytecode = nullptr;
+        size_t bytecodeSize = 0;
+
+        {
+            BLUEPRINT_TRACE_SCOPE("loadModule");
+
+            juce::String error;
+            const auto bundle = root->getModuleBytecode(juce::String::fromUTF8(duk_get_string(ctx, 0)), error);
+
+            if (bundle == nullptr || !BytecodeBundle::getBytecode(bundle->getData(), bundle->getSize(), bytecode, bytecodeSize, error))
+                duk_push_error_object(ctx, DUK_ERR_ERROR, "failed to load module '%s': %s", duk_get_string(ctx, 0), error.toRawUTF8());
+        }
+
+        if (bytecode == nullptr)
+            return duk_throw(ctx);
+
+        // The module's program evaluates to its module function...
+        duk_push_external_buffer(ctx);
+        duk_config_buffer(ctx, -1, const_cast<void*>(bytecode), bytecodeSize);
+        duk_load_function(ctx);
+        duk_call(ctx, 0);
+
+        // ...which we call as module-node would, with the module's exports,
+        // require, module, filename and directory.
+        const char* id = duk_get_string(ctx, 0);
+        const char* slash = std::strrchr(id, '/');
+
+        duk_dup(ctx, 1);
+        duk_get_prop_string(ctx, 2, "require");
+        duk_dup(ctx, 2);
+        duk_dup(ctx, 0);
+        duk_push_lstring(ctx, id, slash != nullptr ? static_cast<duk_size_t>(slash - id) : 0);
+        duk_call(ctx, 5);
+        duk_pop(ctx);
+
+        duk_push_true(ctx);
+        duk_put_prop_string(ctx, 2, "loaded");
+
+        // Returning undefined tells module-node that module.exports is ready.
+        return 0;
+    }
+
+    duk_context* initializeDuktapeContext (DuktapeAllocator* allocator, HeapMeter* meter, ConsoleLogger* logger)
+    {
+        // Allocate a new js heap
+        duk_context* ctx = meter != nullptr ? meter->createHeap(allocator)
+                         : allocator != nullptr ? allocator->createHeap()
+                         : duk_create_heap_default();
+
+        // If you hit this, the allocator's system allocation limit is too small
+        // for even an empty heap.
+        jassert (ctx != nullptr);
+
+        // Add console.log support
+        if (logger != nullptr)
+            logger->install(ctx);
+        else
+            duk_console_init(ctx, DUK_CONSOLE_FLUSH);
+
+        // Add native Map and Set, which the bundle's polyfills then build on
+        NativeCollections::install(ctx);
+
+        // Register react render backend functions
+        const duk_function_list_entry blueprintNativeFuncs[] = {
+            { "createViewInstance", BlueprintNative::createViewInstance, 1},
+            { "createTextViewInstance", BlueprintNative::createTextViewInstance, 1},
+            { "setViewProperty", BlueprintNative::setViewProperty, 3},
+            { "getPropertyId", BlueprintNative::getPropertyId, 1},
+            { "setViewPropertyById", BlueprintNative::setViewPropertyById, 3},
+            { "setViewProperties", BlueprintNative::setViewProperties, 2},
+            { "registerStyleSheet", BlueprintNative::registerStyleSheet, 1},
+            { "setRawTextValue", BlueprintNative::setRawTextValue, 2},
+            { "addChild", BlueprintNative::addChild, 3},
+            { "removeChild", BlueprintNative::removeChild, 2},
+            { "moveChild", BlueprintNative::moveChild, 3},
+            { "getRootInstanceId", BlueprintNative::getRootInstanceId, 0},
+            { "getSurfaceInstanceId", BlueprintNative::getSurfaceInstanceId, 1},
+            { "getOverlayInstanceId", BlueprintNative::getOverlayInstanceId, 1},
+            { "beginCommit", BlueprintNative::beginCommit, 0},
+            { "endCommit", BlueprintNative::endCommit, 0},
+            { "flushCommands", BlueprintNative::flushCommands, 2},
+            { "getValueChannel", BlueprintNative::getValueChannel, 1},
+            { "shouldYield", BlueprintNative::shouldYield, 0},
+            { "getFrameTimeRemaining", BlueprintNative::getFrameTimeRemaining, 0},
+            { "createWorker", BlueprintNative::createWorker, 1},
+            { "postWorkerMessage", BlueprintNative::postWorkerMessage, 2},
+            { "terminateWorker", BlueprintNative::terminateWorker, 1},
+            { "startAnimation", BlueprintNative::startAnimation, 3},
+            { "stopAnimation", BlueprintNative::stopAnimation, 1},
+            { "getStats", BlueprintNative::getStats, 0},
+            { "setInvalidationTracking", BlueprintNative::setInvalidationTracking, 1},
+            { "setPaintProfiling", BlueprintNative::setPaintProfiling, 1},
+            { "getPaintStats", BlueprintNative::getPaintStats, 0},
+            { "getObjectCensus", BlueprintNative::getObjectCensus, 0},
+            { "reportViewRegistrySize", BlueprintNative::reportViewRegistrySize, 1},
+            { "getHeapStats", BlueprintNative::getHeapStats, 0},
+            { "getHeapCensus", BlueprintNative::getHeapCensus, 0},
+            { "getNativeMethodStats", BlueprintNative::getNativeMethodStats, 0},
+            { "getInputLatencyStats", BlueprintNative::getInputLatencyStats, 0},
+            { "getStartupStats", BlueprintNative::getStartupStats, 0},
+            { "getCacheStats", BlueprintNative::getCacheStats, 0},
+            { "getParameterIndex", BlueprintNative::getParameterIndex, 1},
+            { "setParameterValues", BlueprintNative::setParameterValues, 2},
+            { "beginAllocationBurst", BlueprintNative::beginAllocationBurst, 0},
+            { "endAllocationBurst", BlueprintNative::endAllocationBurst, 0},
+            { NULL, NULL, 0 }
+        };
+
+        duk_push_global_object(ctx);
+        duk_push_object(ctx);
+        duk_put_function_list(ctx, -1, blueprintNativeFuncs);
+        duk_put_prop_string(ctx, -2, "__BlueprintNative__");
+        duk_pop(ctx);
+
+        // Install require, resolving and loading modules by way of the root,
+        // which finds them in its module directory and compiles them to bytecode
+        // shared through the AssetStore.
+        duk_push_object(ctx);
+        duk_push_c_function(ctx, BlueprintNative::resolveModule, 2);
+        duk_put_prop_string(ctx, -2, "resolve");
+        duk_push_c_function(ctx, BlueprintNative::loadModule, 3);
+        duk_put_prop_string(ctx, -2, "load");
+        duk_module_node_init(ctx);
+
+        // Install the timer functions, backed by the root's native timer queue. The
+        // callbacks themselves are held in the stash, keyed by timer id.
+        const duk_function_list_entry timerFuncs[] = {
+            { "setTimeout", BlueprintNative::setTimeout, DUK_VARARGS},
+            { "setInterval", BlueprintNative::setInterval, DUK_VARARGS},
+            { "clearTimeout", BlueprintNative::clearTimeout, 1},
+            { "clearInterval", BlueprintNative::clearTimeout, 1},
+            { "requestAnimationFrame", BlueprintNative::requestAnimationFrame, 1},
+            { "cancelAnimationFrame", BlueprintNative::cancelAnimationFrame, 1},
+            { "requestIdleCallback", BlueprintNative::requestIdleCallback, DUK_VARARGS},
+            { "cancelIdleCallback", BlueprintNative::cancelIdleCallback, 1},
+            { "queueMicrotask", BlueprintNative::queueMicrotask, 1},
+            { NULL, NULL, 0 }
+        };
+
+        duk_push_global_object(ctx);
+        duk_put_function_list(ctx, -1, timerFuncs);
+        duk_pop(ctx);
+
+        // Install performance, on the clock the timers and animation frames
+        // keep, with User Timing marks and measures which go into the trace.
+        const duk_function_list_entry performanceFuncs[] = {
+            { "now", BlueprintNative::performanceNow, 0},
+            { "mark", BlueprintNative::performanceMark, 1},
+            { "measure", BlueprintNative::performanceMeasure, 3},
+            { "clearMarks", BlueprintNative::performanceClearMarks, 1},
+            { NULL, NULL, 0 }
+        };
+
+        duk_push_global_object(ctx);
+        duk_push_object(ctx);
+        duk_put_function_list(ctx, -1, performanceFuncs);
+        duk_put_prop_string(ctx, -2, "performance");
+        duk_pop(ctx);
+
+        duk_push_global_stash(ctx);
+        duk_push_object(ctx);
+        duk_put_prop_string(ctx, -2, "timerCallbacks");
+        duk_push_object(ctx);
+        duk_put_prop_string(ctx, -2, "animationFrameCallbacks");
+        duk_push_object(ctx);
+        duk_put_prop_string(ctx, -2, "idleCallbacks");
+        duk_push_object(ctx);
+        duk_put_prop_string(ctx, -2, "asyncCalls");
+        duk_push_object(ctx);
+        duk_put_prop_string(ctx, -2, "valueChannels");
+        duk_push_array(ctx);
+        duk_put_prop_string(ctx, -2, "microtasks");
+
+        // Animation frame callbacks are run as a batch by this helper, so that a
+        // whole frame costs one call into the engine. Every callback runs even if
+        // an earlier one throws; the first error is then rethrown for logging.
+        duk_push_string(ctx,
+            "function (callbacks, timestamp) {"
+            "  var error = null;"
+            "  for (var i = 0; i < callbacks.length; ++i) {"
+            "    try { callbacks[i](timestamp); } catch (e) { if (error === null) error = e; }"
+            "  }"
+            "  if (error !== null) throw error;"
+            "}");
+        duk_push_string(ctx, "runAnimationFrames");
+        duk_compile(ctx, DUK_COMPILE_FUNCTION);
+        duk_put_prop_string(ctx, -2, "runAnimationFrames");
+
+        // Idle callbacks likewise, each given a deadline, as the web's are, of
+        // the clock time by which the idle slot ends.
+        duk_push_string(ctx,
+            "function (callbacks, end) {"
+            "  var error = null;"
+            "  var deadline = { didTimeout: false, timeRemaining: function () { return Math.max(0, end - performance.now()); } };"
+            "  for (var i = 0; i < callbacks.length; ++i) {"
+            "    try { callbacks[i](deadline); } catch (e) { if (error === null) error = e; }"
+            "  }"
+            "  if (error !== null) throw error;"
+            "}");
+        duk_push_string(ctx, "runIdleCallbacks");
+        duk_compile(ctx, DUK_COMPILE_FUNCTION);
+        duk_put_prop_string(ctx, -2, "runIdleCallbacks");
+
+        // Each async native method call hands back a Promise, whose resolve
+        // and reject wait in asyncCalls, by call id, until the call completes.
+        duk_push_string(ctx,
+            "function (calls, id) {"
+            "  return new Promise(function (resolve, reject) { calls[id] = { resolve: resolve, reject: reject }; });"
+            "}");
+        duk_push_string(ctx, "createAsyncCall");
+        duk_compile(ctx, DUK_COMPILE_FUNCTION);
+        duk_put_prop_string(ctx, -2, "createAsyncCall");
+
+        duk_push_string(ctx,
+            "function (calls, id, succeeded, result) {"
+            "  var call = calls[id];"
+            "  if (call === undefined) return;"
+            "  delete calls[id];"
+            "  if (succeeded) call.resolve(result); else call.reject(new Error(result));"
+            "}");
+        duk_push_string(ctx, "settleAsyncCall");
+        duk_compile(ctx, DUK_COMPILE_FUNCTION);
+        duk_put_prop_string(ctx, -2, "settleAsyncCall");
+
+        // Microtasks run by the same rule, including those queued as they run.
+        duk_push_string(ctx,
+            "function (queue) {"
+            "  var error = null;"
+            "  for (var i = 0; i < queue.length; ++i) {"
+            "    try { queue[i](); } catch (e) { if (error === null) error = e; }"
+            "  }"
+            "  queue.length = 0;"
+            "  if (error !== null) throw error;"
+            "}");
+        duk_push_string(ctx, "runMicrotasks");
+        duk_compile(ctx, DUK_COMPILE_FUNCTION);
+        duk_put_prop_string(ctx, -2, "runMicrotasks");
+        duk_pop(ctx);
+
+        return ctx;
+    }
+
+    // The heap's internals are visible here, from duktape.c, where they aren't
+    // in the header.
+    duk_int_t suspendVoluntaryCollection (duk_context* ctx)
+    {
+#if defined (DUK_USE_VOLUNTARY_GC)
+        // Each allocation counts the trigger down, and a collection runs when it
+        // goes below zero, so that from here one never does.
+        const duk_int_t saved = ctx->heap->ms_trigger_counter;
+        ctx->heap->ms_trigger_counter = DUK_INT_MAX;
+        return saved;
+#else
+        juce::ignoreUnused(ctx);
+        return 0;
+#endif
+    }
+
+    void resumeVoluntaryCollection (duk_context* ctx, duk_int_t savedTrigger)
+    {
+#if defined (DUK_USE_VOLUNTARY_GC)
+        // A collection in the meantime set the trigger afresh for the heap it
+        // left, which we keep; no burst allocates anywhere near half the range.
+        if (ctx->heap->ms_trigger_counter > DUK_INT_MAX / 2)
+            ctx->heap->ms_trigger_counter = savedTrigger;
+#else
+        juce::ignoreUnused(ctx, savedTrigger);
+#endif
+    }
+
+    namespace
+    {
+        /** Returns the name of the given object's constructor, as its prototype
+            has it, or an empty string if it has none of its own to read without
+            calling a getter.
+         */
+        juce::String getConstructorName (duk_heap* heap, duk_hobject* obj)
+        {
+            auto* proto = DUK_HOBJECT_GET_PROTOTYPE(heap, obj);
+
+            if (proto == nullptr)
+                return {};
+
+            auto* ctor = duk_hobject_find_existing_entry_tval_ptr(heap, proto, DUK_HEAP_STRING_CONSTRUCTOR(heap));
+
+            if (ctor == nullptr || !DUK_TVAL_IS_OBJECT(ctor))
+                return {};
+
+            auto* name = duk_hobject_find_existing_entry_tval_ptr(heap, DUK_TVAL_GET_OBJECT(ctor), DUK_HEAP_STRING_NAME(heap));
+
+            if (name == nullptr || !DUK_TVAL_IS_STRING(name))
+                return {};
+
+            auto* s = DUK_TVAL_GET_STRING(name);
+            return juce::String::fromUTF8(reinterpret_cast<const char*>(DUK_HSTRING_GET_DATA(s)), (int) DUK_HSTRING_GET_BYTELEN(s));
+        }
+
+        /** Returns the group of an object which isn't an instance of a named
+            constructor, by its class.
+         */
+        const char* getClassGroupName (duk_hobject* obj)
+        {
+            static const char* const names[] = {
+                "(none)", "Object", "Array", "Function", "Arguments", "Boolean", "Date", "Error", "JSON", "Math",
+                "Number", "RegExp", "String", "global", "Symbol", "(object environment)", "(declarative environment)",
+                "Pointer", "Thread", "ArrayBuffer", "DataView", "Int8Array", "Uint8Array", "Uint8ClampedArray",
+                "Int16Array", "Uint16Array", "Int32Array", "Uint32Array", "Float32Array", "Float64Array",
+            };
+
+            const auto classNumber = (size_t) DUK_HOBJECT_GET_CLASS_NUMBER(obj);
+            return classNumber < juce::numElementsInArray(names) ? names[classNumber] : "(unknown)";
+        }
+
+        size_t getObjectBytes (duk_hobject* obj)
+        {
+            size_t header = sizeof(duk_hobject);
+
+            if (DUK_HOBJECT_IS_ARRAY(obj))
+                header = sizeof(duk_harray);
+            else if (DUK_HOBJECT_IS_COMPFUNC(obj))
+                header = sizeof(duk_hcompfunc);
+            else if (DUK_HOBJECT_IS_NATFUNC(obj))
+                header = sizeof(duk_hnatfunc);
+            else if (DUK_HOBJECT_IS_THREAD(obj))
+                header = sizeof(duk_hthread);
+#if defined (DUK_USE_BUFFEROBJECT_SUPPORT)
+            else if (DUK_HOBJECT_IS_BUFOBJ(obj))
+                header = sizeof(duk_hbufobj);
+#endif
+
+            return header + (size_t) DUK_HOBJECT_P_ALLOC_SIZE(obj);
+        }
+
+        size_t getBufferBytes (duk_hbuffer* buffer)
+        {
+            if (!DUK_HBUFFER_HAS_DYNAMIC(buffer))
+                return sizeof(duk_hbuffer_fixed) + (size_t) DUK_HBUFFER_GET_SIZE(buffer);
+
+            // An external buffer's data isn't the heap's.
+            if (DUK_HBUFFER_HAS_EXTERNAL(buffer))
+                return sizeof(duk_hbuffer_external);
+
+            return sizeof(duk_hbuffer_dynamic) + (size_t) DUK_HBUFFER_GET_SIZE(buffer);
+        }
+    }
+
+    HeapCensus takeHeapCensus (duk_context* ctx)
+    {
+        HeapCensus census;
+        auto* heap = ctx->heap;
+
+        // Everything but strings, which are in the string table.
+        for (auto* h = heap->heap_allocated; h != nullptr; h = DUK_HEAPHDR_GET_NEXT(heap, h))
+        {
+            switch (DUK_HEAPHDR_GET_TYPE(h))
+            {
+                case DUK_HTYPE_OBJECT:
+                {
+                    auto* obj = reinterpret_cast<duk_hobject*>(h);
+                    const auto classNumber = DUK_HOBJECT_GET_CLASS_NUMBER(obj);
+
+                    // Functions and scopes are grouped apart, whatever their
+                    // prototypes, so that closures show as what they cost.
+                    juce::String name;
+
+                    if (classNumber == DUK_HOBJECT_CLASS_OBJECT || classNumber == DUK_HOBJECT_CLASS_ERROR)
+                        name = getConstructorName(heap, obj);
+
+                    census.add(name.isNotEmpty() ? name : juce::String(getClassGroupName(obj)), getObjectBytes(obj));
+                    break;
+                }
+
+                case DUK_HTYPE_BUFFER:
+                    census.add("(buffer)", getBufferBytes(reinterpret_cast<duk_hbuffer*>(h)));
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+#if !defined (DUK_USE_STRTAB_PTRCOMP)
+        for (duk_uint32_t i = 0; i < heap->st_size; ++i)
+            for (auto* s = heap->strtable[i]; s != nullptr; s = s->hdr.h_next)
+                census.add("(string)", sizeof(duk_hstring) + (size_t) DUK_HSTRING_GET_BYTELEN(s) + 1);
+#endif
+
+        return census;
+    }
+
+}
+
+#if BLUEPRINT_SCRIPT_WATCHDOG
+/** Duktape's execution timeout check; see duk_config_blueprint.h. */
+extern "C" duk_bool_t blueprint_exec_timeout_check (void*)
+{
+    return blueprint::ScriptWatchdog::shouldAbortCurrentCall() ? 1 : 0;
 }
+#endif
@@ -9,16 +9,69 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <map>
+#include <set>
+#include <typeinfo>
 
+#include "blueprint_CanvasView.h"
+#include "blueprint_ConsoleLogger.h"
+#include "blueprint_FilmstripView.h"
 #include "blueprint_ImageView.h"
+#include "blueprint_MeasuredShadowView.h"
+#include "blueprint_MeterView.h"
 #include "blueprint_RawTextView.h"
+#include "blueprint_ScopeView.h"
 #include "blueprint_ScrollView.h"
 #include "blueprint_ScrollViewContentShadowView.h"
 #include "blueprint_ShadowView.h"
+#include "blueprint_SliderView.h"
+#include "blueprint_SpectrumView.h"
+#include "blueprint_TextInputView.h"
 #include "blueprint_TextShadowView.h"
+#include "blueprint_TextSpanView.h"
 #include "blueprint_TextView.h"
 #include "blueprint_View.h"
+#include "blueprint_VirtualListView.h"
+#include "blueprint_WaveformView.h"
+#include "blueprint_AnimatedValue.h"
+#include "blueprint_AssetPreloader.h"
+#include "blueprint_AssetStore.h"
+#include "blueprint_BridgeRecording.h"
+#include "blueprint_BytecodeBundle.h"
+#include "blueprint_CacheManager.h"
+#include "blueprint_CborPayload.h"
+#include "blueprint_CoalescedEventChannel.h"
+#include "blueprint_DukStringCache.h"
+#include "blueprint_DuktapeAllocator.h"
+#include "blueprint_FrameScheduler.h"
+#include "blueprint_HeapCensus.h"
+#include "blueprint_HeapMeter.h"
+#include "blueprint_IdleCollector.h"
+#include "blueprint_LayoutAnimator.h"
+#include "blueprint_LayoutSnapshot.h"
+#include "blueprint_ListModel.h"
+#include "blueprint_NativeCollections.h"
+#include "blueprint_NativeFunction.h"
+#include "blueprint_NoteGridModel.h"
+#include "blueprint_ObjectCensus.h"
+#include "blueprint_PaintProfiler.h"
+#include "blueprint_PerformanceOverlay.h"
+#include "blueprint_PerformanceStats.h"
+#include "blueprint_PropertyBinding.h"
+#include "blueprint_RealtimeEventQueue.h"
+#include "blueprint_SampleRingBuffer.h"
+#include "blueprint_ScriptProfiler.h"
+#include "blueprint_ScriptThread.h"
+#include "blueprint_ScriptWatchdog.h"
+#include "blueprint_ScriptWorker.h"
+#include "blueprint_TiledRasterizer.h"
+#include "blueprint_TimerQueue.h"
+#include "blueprint_TraceRecorder.h"
+#include "blueprint_ValueChannel.h"
+#include "blueprint_ViewPropertyTable.h"
+#include "blueprint_ViewTable.h"
 
 
 namespace blueprint
@@ -32,672 +85,7953 @@ namespace blueprint
         static duk_ret_t createViewInstance (duk_context *ctx);
         static duk_ret_t createTextViewInstance (duk_context *ctx);
         static duk_ret_t setViewProperty (duk_context *ctx);
+        static duk_ret_t getPropertyId (duk_context *ctx);
+        static duk_ret_t setViewPropertyById (duk_context *ctx);
+        static duk_ret_t setViewProperties (duk_context *ctx);
+        static duk_ret_t registerStyleSheet (duk_context *ctx);
         static duk_ret_t setRawTextValue (duk_context *ctx);
         static duk_ret_t addChild (duk_context *ctx);
         static duk_ret_t removeChild (duk_context *ctx);
+        static duk_ret_t moveChild (duk_context *ctx);
+        static duk_ret_t getSurfaceInstanceId (duk_context *ctx);
+        static duk_ret_t getOverlayInstanceId (duk_context *ctx);
         static duk_ret_t getRootInstanceId (duk_context *ctx);
+        static duk_ret_t beginCommit (duk_context *ctx);
+        static duk_ret_t endCommit (duk_context *ctx);
+        static duk_ret_t flushCommands (duk_context *ctx);
+        static duk_ret_t setTimeout (duk_context *ctx);
+        static duk_ret_t setInterval (duk_context *ctx);
+        static duk_ret_t clearTimeout (duk_context *ctx);
+        static duk_ret_t requestAnimationFrame (duk_context *ctx);
+        static duk_ret_t cancelAnimationFrame (duk_context *ctx);
+        static duk_ret_t requestIdleCallback (duk_context *ctx);
+        static duk_ret_t cancelIdleCallback (duk_context *ctx);
+        static duk_ret_t queueMicrotask (duk_context *ctx);
+        static duk_ret_t shouldYield (duk_context *ctx);
+        static duk_ret_t getFrameTimeRemaining (duk_context *ctx);
+        static duk_ret_t performanceNow (duk_context *ctx);
+        static duk_ret_t performanceMark (duk_context *ctx);
+        static duk_ret_t performanceMeasure (duk_context *ctx);
+        static duk_ret_t performanceClearMarks (duk_context *ctx);
+        static duk_ret_t getValueChannel (duk_context *ctx);
+        static duk_ret_t createWorker (duk_context *ctx);
+        static duk_ret_t postWorkerMessage (duk_context *ctx);
+        static duk_ret_t terminateWorker (duk_context *ctx);
+        static duk_ret_t startAnimation (duk_context *ctx);
+        static duk_ret_t stopAnimation (duk_context *ctx);
+        static duk_ret_t getStats (duk_context *ctx);
+        static duk_ret_t setInvalidationTracking (duk_context *ctx);
+        static duk_ret_t setPaintProfiling (duk_context *ctx);
+        static duk_ret_t getPaintStats (duk_context *ctx);
+        static duk_ret_t getObjectCensus (duk_context *ctx);
+        static duk_ret_t reportViewRegistrySize (duk_context *ctx);
+        static duk_ret_t getHeapStats (duk_context *ctx);
+        static duk_ret_t getHeapCensus (duk_context *ctx);
+        static duk_ret_t getNativeMethodStats (duk_context *ctx);
+        static duk_ret_t getInputLatencyStats (duk_context *ctx);
+        static duk_ret_t getStartupStats (duk_context *ctx);
+        static duk_ret_t getCacheStats (duk_context *ctx);
+        static duk_ret_t getParameterIndex (duk_context *ctx);
+        static duk_ret_t setParameterValues (duk_context *ctx);
+        static duk_ret_t beginAllocationBurst (duk_context *ctx);
+        static duk_ret_t endAllocationBurst (duk_context *ctx);
+        static duk_ret_t resolveModule (duk_context *ctx);
+        static duk_ret_t loadModule (duk_context *ctx);
     };
 
-    /** Allocates a new Duktape heap and initializes the BlueprintNative API therein. */
-    duk_context* initializeDuktapeContext();
+    /** Allocates a new Duktape heap, from the given allocator if there is one and
+        counted by the given meter if there is one, and initializes the
+        BlueprintNative API therein. The console logs through the given logger,
+        or if there isn't one straight to stdout.
+     */
+    duk_context* initializeDuktapeContext (DuktapeAllocator* allocator = nullptr, HeapMeter* meter = nullptr,
+                                           ConsoleLogger* logger = nullptr);
+
+    /** Holds off the mark-and-sweep collections Duktape runs by itself as the
+        heap allocates, returning the heap's trigger count for
+        `resumeVoluntaryCollection` to put back. Collections asked for with
+        duk_gc, and those the heap runs when an allocation fails, still go ahead.
+     */
+    duk_int_t suspendVoluntaryCollection (duk_context* ctx);
+
+    /** Undoes `suspendVoluntaryCollection`, given what it returned. */
+    void resumeVoluntaryCollection (duk_context* ctx, duk_int_t savedTrigger);
+
+    //==============================================================================
+    /** A view type registered with a root: how to create its views, and, if the
+        type recycles its views, how to reset them and the pool of those reset.
+     */
+    struct ViewType : public ViewPropertyConsumers
+    {
+        typedef std::pair<std::unique_ptr<View>, std::unique_ptr<ShadowView>> ViewPair;
+        typedef std::function<ViewPair()> Factory;
+
+        // Resets whatever state of a removed view the view's own resetForReuse
+        // doesn't, before the root reuses the view for a new one of its type.
+        typedef std::function<void(View&, ShadowView*)> Resetter;
+
+        /** Returns who consumes the given property, absent a declaration from the
+            type: the shadow view alone for flex properties, `debug` and
+            `layout-transition`, and the view alone for everything else.
+         */
+        static int getDefaultPropertyConsumers (const juce::Identifier& name)
+        {
+            // The shadow view takes `display: none` out of the layout, and the
+            // view stops painting.
+            if (name == IDs::display)
+                return ConsumedByBoth;
+
+            if (ShadowView::isLayoutProperty(name) || name == IDs::debug || name == IDs::layoutTransition
+                || name == IDs::layoutBoundary)
+                return ConsumedByShadow;
+
+            return ConsumedByView;
+        }
+
+        /** Returns who consumes the given property for views of this type. */
+        int getPropertyConsumers (const juce::Identifier& name) const
+        {
+            const auto it = propertyConsumers.find(name);
+            return it != propertyConsumers.end() ? it->second : getDefaultPropertyConsumers(name);
+        }
+
+        Factory factory;
+        Resetter resetter;
+        std::vector<ViewPair> pool;
+
+        // The type's own declarations, overriding the defaults.
+        std::unordered_map<juce::Identifier, int, IdentifierHash> propertyConsumers;
+    };
 
     //==============================================================================
     /** The ReactApplicationRoot class prepares and maintains a Duktape evaluation
         context with the relevant hooks for supporting the Blueprint render
         backend.
      */
-    class ReactApplicationRoot : public View, public juce::Timer
+    class ReactApplicationRoot : public View, private juce::AsyncUpdater
     {
     public:
         //==============================================================================
         // We allow registering arbitrary view types with the React context by way of
         // a "ViewFactory" here which is a user-defined function that produces a View
         // and a corresponding ShadowView.
-        typedef std::pair<std::unique_ptr<View>, std::unique_ptr<ShadowView>> ViewPair;
-        typedef std::function<ViewPair()> ViewFactory;
+        typedef ViewType::ViewPair ViewPair;
+        typedef ViewType::Factory ViewFactory;
+        typedef ViewType::Resetter ViewResetter;
+
+        // Turns a realtime event into the arguments handed to JavaScript, on the
+        // message thread; by default the event's numbers are passed as they are.
+        typedef std::function<void(const RealtimeEvent&, juce::Array<juce::var>&)> RealtimeEventFormatter;
+
+        // Turns a key's latest value into its entry in a coalesced event.
+        typedef std::function<juce::var(int key, double value)> CoalescedEventFormatter;
 
         //==============================================================================
-        ReactApplicationRoot()
+        /** Creates a root whose Duktape heap allocates from the given allocator, or
+            from the system allocator if none is given.
+         */
+        explicit ReactApplicationRoot (std::unique_ptr<DuktapeAllocator> allocator = nullptr)
+            : scheduler(*this, [this]() { if (!isHeadless()) runScheduledWork(); }),
+              realtimeEvents(realtimeEventQueueCapacity),
+              realtimeEventWatcher(*this),
+              heapAllocator(std::move(allocator))
         {
             jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
 
-            // Create a duktape context
-            ctx = initializeDuktapeContext();
+            // The root view's id is reserved by the view table
+            setViewId(ViewTable::rootViewId);
+            setOwningRoot(this);
 
-            // Push a pointer to this root instance
-            duk_push_global_stash(ctx);
-            duk_push_pointer(ctx, (void *) this);
-            duk_put_prop_string(ctx, -2, "rootInstance");
+            // Create a duktape context
+            createContext();
 
             // Assign our root level shadow view
+            const ShadowView::ScopedConfig scopedConfig (yogaConfig.config);
             _shadowView = std::make_unique<ShadowView>(this);
 
             // And install view types
             installNativeViewTypes();
+
+            // The profiler reads whichever context is current when it samples.
+            watchdog.setInterruptCallback([this]() { scriptProfiler.sample(ctx); });
+
+            // Layout transitions keep our time, which a headless root sets.
+            layoutAnimator.setClock([this]() { return getClockTime(); });
         }
 
         ~ReactApplicationRoot()
         {
-            stopTimer();
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+            // The context paints us from its own thread until it's detached.
+            setOpenGLRenderingEnabled(false);
+#endif
+
+            // The engine may be mid-call on its own thread.
+            scriptThread.reset();
+
+            // What the user saw last is what they see first next time. We render
+            // it only now that nothing else paints or changes the views.
+            saveStartupSnapshot();
+
+            // A drag cut short by the editor closing still ends its gesture.
+            setParameterValues({}, ParameterGesture::end);
+
+            // Async methods finish what they're doing before we go.
+            asyncMethodPool.reset();
+
+            bundleLoader.reset();
+            scheduler.cancel();
+            cancelPendingUpdate();
             duk_destroy_heap(ctx);
+
+            // Our views let go of their cache entries as they go, so once they
+            // have, the caches trim back to their budgets.
+            juce::MessageManager::callAsync([]() { juce::SharedResourcePointer<CacheManager>()->trimToBudgets(); });
         }
 
         //==============================================================================
         /** Override the default View behavior. */
         void resized() override
         {
-            performShadowTreeLayout();
-        }
-
-        /** Implement the timer callback; only to be initiated after the bundle has
-            been evaluated.
-         */
-        void timerCallback() override
-        {
-            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+            if (loadingPlaceholder != nullptr)
+                loadingPlaceholder->setBounds(getLocalBounds());
 
-            // Push the schedulerInterrupt function to the top of the stack and call it.
-            duk_get_global_string(ctx, "__schedulerInterrupt__");
-            [[maybe_unused]] const duk_int_t rc = duk_pcall(ctx, 0);
+            if (liveResizeCover != nullptr)
+                liveResizeCover->setBounds(getLocalBounds());
 
-            if (rc != DUK_EXEC_SUCCESS)
-                DBG("Duktape scheduler interrupt error: " << duk_safe_to_string(ctx, -1));
+            if (overlayLayer != nullptr)
+                overlayLayer->setBounds(getLocalBounds());
 
-            duk_pop(ctx);
-        }
+            // Until the tree first commits, the snapshot is whichever matches
+            // the size we're at.
+            if (startupSnapshotDirectory != juce::File() && !hasCommitted)
+                showStartupSnapshot();
 
-        //==============================================================================
-        /** Reads a JavaScript bundle from file and evaluates it in the Duktape context. */
-        void evalScript (const juce::String& script)
-        {
-            duk_push_string(ctx, script.toRawUTF8());
+            noteResizeStep();
 
-            if (duk_peval(ctx) != 0) {
-                printf("Script evaluation failed: %s\n", duk_safe_to_string(ctx, -1));
+            // While the window is dragging, we lay out at most once a frame.
+            if (isLiveResizing())
+            {
+                liveResizeLayoutPending = true;
+                scheduler.scheduleFrame();
+                return;
             }
 
-            duk_pop(ctx);
+            performShadowTreeLayout();
+        }
+
+        /** Notes the first paint after the first commit, for the startup stats. */
+        void paint (juce::Graphics& g) override
+        {
+            if (isStartingUp(PerformanceStats::FirstPaintPhase) && performanceStats.hasEndedStartupPhase(PerformanceStats::FirstCommitPhase))
+                performanceStats.beginStartupPhase(PerformanceStats::FirstPaintPhase);
 
-            // Schedule the timer...
-            startTimer(4);
+            View::paint(g);
         }
 
-        /** Enables keyboard focus on this component, expecting keypress events to reload
-            the javascript bundle.
+        /** Draws the performance overlay, if it's showing, over everything else,
+            and settles the input latency of whatever this paint shows.
          */
-        void enableHotkeyReloading()
+        void paintOverChildren (juce::Graphics& g) override
         {
-            setWantsKeyboardFocus(true);
+            // A tiled paint paints this once, over all of its tiles.
+            if (!TiledRasterizer::isPaintingTile())
+                paintOverViews(g);
         }
 
-        /** Rebuilds a new Duktape context, reads and executes the sourceFile. */
-        bool keyPressed (const juce::KeyPress& key) override
+        /** Takes the root's own properties, as well as a View's. */
+        void setProperty (const juce::Identifier& name, const juce::var& value) override
         {
-            bool cmd = key.getModifiers().isCommandDown();
-            auto r = key.isKeyCode(82);
-
-            if (cmd && r)
-            {
-                duk_destroy_heap(ctx);
-                removeAllChildren();
-                viewTable.clear();
-                shadowViewTable.clear();
-                ctx = initializeDuktapeContext();
-                _shadowView = std::make_unique<ShadowView>(this);
-                // TODO: Disabling this for now; need to rethink the
-                // interface and whether or not this kind of functionality
-                // belongs within the ReactApplicationRoot class.
-                // runScript(sourceFile);
-            }
+            View::setProperty(name, value);
 
-            return true;
+            if (name == IDs::performanceOverlay)
+                setPerformanceOverlayVisible(value);
         }
 
-        /** A simple accessor for the underlying Duktape context. */
-        duk_context* getDuktapeContext()
+        /** Adds a JavaScript timer, returning its id. The callback and its arguments
+            are held in the Duktape stash by the caller, under that id.
+         */
+        TimerQueue::TimerId addTimer (double delayMs, bool repeating)
         {
-            return ctx;
-        }
+            const auto id = timerQueue.add(getClockTime(), delayMs, repeating);
+            scheduleTimers();
 
-        //==============================================================================
-        // VIEW MANAGER STUFF: SPLIT OUT?
+            return id;
+        }
 
-        /** Registers a new dynamic view type and its associated factory. */
-        void registerViewType(const juce::String& typeId, ViewFactory f)
+        /** Cancels a JavaScript timer. */
+        void cancelTimer (TimerQueue::TimerId id)
         {
-            // If you hit this jassert, you're trying to register a type which
-            // has already been registered!
-            jassert (viewFactories.find(typeId) == viewFactories.end());
-            viewFactories[typeId] = f;
+            timerQueue.cancel(id);
         }
 
-        /** Creates a new view instance and registers it with the view table. */
-        ViewId createViewInstance(const juce::String& viewType)
+        /** Notes that a microtask has been queued, for the call into script now
+            running to run it on the way out. The callback itself is held in the
+            Duktape stash by the caller.
+         */
+        void didQueueMicrotask()
         {
-            // We can't create a view instance of a type that hasn't been registered.
-            jassert (viewFactories.find(viewType) != viewFactories.end());
+            microtasksPending = true;
+        }
 
-            auto [view, shadowView] = viewFactories[viewType]();
-            ViewId vid = view->getViewId();
+        //==============================================================================
+        /** Sets how long each call into JavaScript may run before `shouldYield`
+            tells React's concurrent rendering to hand the rest of its work to
+            the next frame. The default leaves half a 60Hz frame for layout and
+            painting.
+         */
+        void setYieldBudget (double ms)
+        {
+            yieldBudgetMs = juce::jmax(0.0, ms);
+        }
 
-            viewTable[vid] = std::move(view);
-            shadowViewTable[vid] = std::move(shadowView);
+        /** Returns the time left, in milliseconds, of the yield budget of the
+            call into JavaScript in progress, which may be negative once it's
+            spent. Outside of a call there's a whole budget left.
+         */
+        double getFrameTimeRemaining() const
+        {
+            if (!watchdog.isInCall())
+                return yieldBudgetMs;
 
-            return vid;
+            return watchdog.getCallStartTime() + yieldBudgetMs - juce::Time::getMillisecondCounterHiRes();
         }
 
-        /** Creates a new text view instance and registers it with the view table. */
-        ViewId createTextViewInstance(const juce::String& value)
+        //==============================================================================
+        /** Records a User Timing mark, as JavaScript's `performance.mark` does, at
+            the clock time `performance.now` reads. Where the trace recorder is
+            recording, the mark goes on its timeline too.
+         */
+        void addUserTimingMark (const juce::String& name)
         {
-            std::unique_ptr<View> view = std::make_unique<RawTextView>(value);
-            ViewId id = view->getViewId();
+            userTimingMarks[name] = { getClockTime(), juce::Time::getHighResolutionTicks() };
 
-            viewTable[id] = std::move(view);
-            return id;
+           #if BLUEPRINT_TRACING
+            auto& recorder = TraceRecorder::getInstance();
+
+            if (recorder.isRecording())
+                recorder.recordInstant(recorder.intern(name, "performance.mark"), "user_timing");
+           #endif
         }
 
-        void setViewProperty (ViewId viewId, const juce::Identifier& name, const juce::var& value)
+        /** Measures between two marks, as `performance.measure` does, returning
+            false if either isn't known. With no start mark, the span starts
+            when the engine did, and with no end mark, it ends now. Where the
+            trace recorder is recording, the span goes on its timeline.
+         */
+        bool measureUserTiming (const juce::String& name, const juce::String& startMark,
+                                const juce::String& endMark, double& durationMs)
         {
-            const auto& [view, shadow] = getViewHandle(viewId);
+            UserTimingMark start = userTimingOrigin;
+            UserTimingMark end { getClockTime(), juce::Time::getHighResolutionTicks() };
 
-            view->setProperty(name, value);
-            shadow->setProperty(name, value);
+            if (startMark.isNotEmpty() && !findUserTimingMark(startMark, start))
+                return false;
 
-            // For now, we just assume that any new property update means we
-            // need to redraw or lay out our tree again. This is an easy future
-            // optimization.
-            performShadowTreeLayout();
-            view->repaint();
+            if (endMark.isNotEmpty() && !findUserTimingMark(endMark, end))
+                return false;
+
+            durationMs = end.time - start.time;
+
+           #if BLUEPRINT_TRACING
+            auto& recorder = TraceRecorder::getInstance();
+
+            if (recorder.isRecording())
+                recorder.recordSpan(recorder.intern(name, "performance.measure"), "user_timing", start.ticks, end.ticks);
+           #else
+            juce::ignoreUnused(name);
+           #endif
+
+            return true;
         }
 
-        void setRawTextValue (ViewId viewId, const juce::String& value)
+        /** Forgets the given User Timing mark, or every one if no name is given. */
+        void clearUserTimingMarks (const juce::String& name = {})
         {
-            View* view = getViewHandle(viewId).first;
-
-            if (auto* rawTextView = dynamic_cast<RawTextView*>(view))
-            {
-                // Update text
-                rawTextView->setText(value);
+            if (name.isEmpty())
+                userTimingMarks.clear();
+            else
+                userTimingMarks.erase(name);
+        }
 
-                if (auto* parent = dynamic_cast<TextView*>(rawTextView->getParentComponent()))
-                {
-                    // If we have a parent already, find the parent's shadow node and
-                    // mark it dirty, then we'll issue a new layout call
-                    ShadowView* parentShadowView = getViewHandle(parent->getViewId()).second;
+        /** Queues an idle callback, for `requestIdleCallback`, returning its id.
+            Idle callbacks run in the scheduled work's idle slot, once a pass has
+            run everything else with time to spare, or with a script thread, once
+            the thread has nothing else to do. The callback itself is held in the
+            Duktape stash by the caller.
+         */
+        int addIdleCallback()
+        {
+            const int id = nextIdleCallbackId++;
+            pendingIdleCallbacks.push_back(id);
 
-                    if (auto* textShadowView = dynamic_cast<TextShadowView*>(parentShadowView))
-                    {
-                        textShadowView->markDirty();
-                        performShadowTreeLayout();
-                    }
+            // The script thread runs its idle work as its queue empties.
+            if (!isOnScriptThread())
+                scheduler.scheduleFrame();
 
-                    // Then we need to paint, but the RawTextView has no idea how to paint its text,
-                    // we need to tell the parent to repaint its children.
-                    parent->repaint();
-                }
-            }
+            return id;
         }
 
-        void addChild (ViewId parentId, ViewId childId, int index = -1)
+        /** Queues an animation frame callback for the next display frame, returning
+            its id. The callback itself is held in the Duktape stash by the caller.
+         */
+        int addAnimationFrame()
         {
-            const auto& [parentView, parentShadowView] = getViewHandle(parentId);
-            const auto& [childView, childShadowView] = getViewHandle(childId);
+            const int id = nextAnimationFrameId++;
+            pendingAnimationFrames.push_back(id);
 
-            if (auto* textView = dynamic_cast<TextView*>(parentView))
+            if (nextAnimationFrameTime < 0.0)
             {
-                // If we're trying to append a child to a text view, it will be raw text
-                // with no accompanying shadow view, and we'll need to mark the parent
-                // TextShadowView dirty before the subsequent layout pass.
-                jassert (dynamic_cast<RawTextView*>(childView) != nullptr);
-                jassert (childShadowView == nullptr);
+                nextAnimationFrameTime = getClockTime();
 
-                parentView->addChild(childView, index);
-                dynamic_cast<TextShadowView*>(parentShadowView)->markDirty();
-            }
-            else
-            {
-                parentView->addChild(childView, index);
-                parentShadowView->addChild(childShadowView, index);
+                // From the script thread, the message thread learns of the frame
+                // with the rest of the commit.
+                if (isOnScriptThread())
+                    runOnMessageThread([this]() { scriptAnimationFramePending = true; scheduler.scheduleFrame(); });
+                else
+                    scheduler.scheduleFrame();
             }
 
-            performShadowTreeLayout();
+            return id;
         }
 
-        void removeChild (ViewId parentId, ViewId childId)
+        /** Runs the scheduled work in priority lanes, then sleeps until there's
+            more to do.
+
+            Input goes first, in full: pointer and realtime events. Then the
+            display frame's work: bindings, animations, transitions and, at a
+            frame, the pending animation frame callbacks. Timers follow, for as
+            long as `timerLaneBudgetMs` allows, with any still due left for the
+            next pass, which takes input first again. Idle work, the garbage
+            collector and the destruction of buried views, takes whatever's left
+            of `scheduledWorkBudgetMs`, and otherwise waits.
+         */
+        void runScheduledWork()
         {
-            const auto& [parentView, parentShadowView] = getViewHandle(parentId);
-            const auto& [childView, childShadowView] = getViewHandle(childId);
+            const double passStart = juce::Time::getMillisecondCounterHiRes();
 
-            // TODO: Set a View::removeChild method and call into that here. Make
-            // that method virtual so that, e.g., the scroll view can override to
-            // remove the child from its viewport
-            parentView->removeChildComponent(childView);
+            performanceStats.beginFrame();
+            updatePerformanceOverlay();
+            sampleObjectCensus();
+            dispatchEventsHeldWhileHidden();
+            runLiveResize();
 
-            // Here we have to clear the view table of all children of this view.
-            // React may clear a whole subtree from the interface by removing a
-            // single component at the root of the tree. Because the view table
-            // is a flat map of viewId to View, if we only remove that root view
-            // from the table we leave all of its children dangling, which confuses
-            // subsequent functionality like `getViewHandle` or `getViewByRefId`
-            std::vector<ViewId> childIds;
-            enumerateChildViewIds(childIds, childView);
+            if (scriptThread != nullptr)
+                return runScheduledWorkAlongsideScript();
 
-            for (auto& id : childIds)
-                viewTable.erase(id);
+            if (hasScheduledWork())
+                idleCollector.markBusy(passStart);
 
-            // We might be dealing with a text view, in which case we expect a null
-            // shadow view.
-            if (parentShadowView && childShadowView)
+            // Input. There's nobody to hear events until the bundle is running.
+            if (!isLoadingBundle())
+                flushRealtimeEvents();
+
+            flushPointerEvents();
+
+            // The frame.
+            flushParameterWrites();
+            updatePropertyBindings();
+            runAnimations();
+            runLayoutTransitions();
+            runStartupSnapshotFade();
+
+            if (!pendingAnimationFrames.empty())
             {
-                parentShadowView->removeChild(childShadowView);
+                // A timer may wake us between frames, in which case the animation
+                // frame waits for the frame proper.
+                if (getClockTime() >= nextAnimationFrameTime)
+                    runAnimationFrames();
+                else
+                    scheduler.scheduleFrame();
+            }
 
-                // Then here, since we now know we have a child shadow view,
-                // we try also to remove its children from the shadowViewTable to
-                // prevent dangling children like in the viewTable above.
-                for (auto& id : childIds)
-                    shadowViewTable.erase(id);
+            // Timers.
+            runTimers(timerLaneBudgetMs);
+
+            // Idle work, only with time to spare.
+            if (juce::Time::getMillisecondCounterHiRes() - passStart >= scheduledWorkBudgetMs)
+            {
+                if (!buriedViews.empty())
+                    scheduler.scheduleAfter(burialDelayMs);
+
+                if (!pendingIdleCallbacks.empty() || rescalePending)
+                    scheduler.scheduleFrame();
+
+                return;
             }
 
-            performShadowTreeLayout();
+            collectGarbageIfIdle();
+            destroyBuriedViews();
+            continueRescale();
+            runIdleCallbacksIfIdle(passStart);
         }
 
-        void enumerateChildViewIds (std::vector<ViewId>& ids, View* v)
+        //==============================================================================
+        /** Tunes when the root runs Duktape's garbage collector in idle time. */
+        void setIdleCollectionOptions (const IdleCollector::Options& options)
         {
-            for (auto* child : v->getChildren())
-            {
-                // Some view elements may mount a plain juce::Component, such as the
-                // ScrollView mounting a juce::Viewport which is a juce::Component but
-                // not a juce::View. Such elements aren't in our table and can be skipped
-                if (auto* childView = dynamic_cast<View*>(child))
-                {
-                    enumerateChildViewIds(ids, childView);
-                }
-            }
+            idleCollector.setOptions(options);
+        }
 
-            ids.push_back(v->getViewId());
+        /** Holds off idle time garbage collection, say for the length of a gesture
+            the mouse doesn't know about, until the matching call to
+            `resumeGarbageCollection`. Calls nest. Collections are held off while
+            a mouse button is down in any case.
+         */
+        void suppressGarbageCollection()
+        {
+            idleCollector.suppress();
         }
 
-        /** Returns a pointer pair to the view associated to the given id. */
-        std::pair<View*, ShadowView*> getViewHandle (ViewId viewId)
+        //==============================================================================
+        /** How the root behaves while its window is being drag-resized. */
+        struct LiveResizeOptions
         {
-            if (viewId == getViewId())
-                return {this, _shadowView.get()};
+            /** Whether a burst of resizes starts a live resize by itself, for
+                hosts which can't call `beginLiveResize` and `endLiveResize`.
+             */
+            bool detectAutomatically = true;
 
-            if (viewTable.find(viewId) != viewTable.end())
-                return {viewTable[viewId].get(), shadowViewTable[viewId].get()};
+            /** How long after the last resize an automatic live resize ends. */
+            double settleMs = 150.0;
 
-            // If we land here, you asked for a view that we don't have.
-            jassertfalse;
-            return {nullptr, nullptr};
+            /** Whether to stretch a snapshot of the interface over the window
+                while it drags, rather than lay the tree out at all.
+             */
+            bool scaleSnapshot = false;
+
+            /** Fills whatever a snapshot leaves transparent. */
+            juce::Colour snapshotBackground = juce::Colours::black;
+        };
+
+        /** Sets how the root behaves while its window is being drag-resized. */
+        void setLiveResizeOptions (const LiveResizeOptions& options)
+        {
+            liveResizeOptions = options;
         }
 
-        /** Walks the view table, returning the first view with a `refId`
-         *  whose value equals the provided id.
+        /** Starts a live resize, say from a ComponentBoundsConstrainer's
+            `resizeStart`. Until the matching `endLiveResize`, the tree is laid
+            out at most once a frame, or not at all if the options ask for a
+            scaled snapshot, and Measure events are held back, so that React
+            doesn't render for every step of the drag.
          */
-        View* getViewByRefId (const juce::Identifier& refId)
+        void beginLiveResize()
         {
-            if (refId == getRefId())
-                return this;
+            if (liveResizing)
+                return;
 
-            for (auto& pair : viewTable)
+            liveResizing = true;
+
+            if (liveResizeOptions.scaleSnapshot && !getLocalBounds().isEmpty())
             {
-                auto* view = pair.second.get();
+                const float scale = juce::Component::getApproximateScaleFactorForComponent(this);
+                liveResizeCover = std::make_unique<LiveResizeCover>(renderToImage(scale), liveResizeOptions.snapshotBackground);
 
-                if (refId == view->getRefId())
-                    return view;
+                addAndMakeVisible(liveResizeCover.get());
+                liveResizeCover->setBounds(getLocalBounds());
             }
-
-            return nullptr;
         }
 
-        /** Register a native method to be called from the script engine. */
-        void registerNativeMethod(const std::string& name, std::function<void(const juce::var::NativeFunctionArgs&)> fn) {
-            // Push the function into the registry and hang onto its index
-            size_t fnIndex = methodRegistry.size();
-            methodRegistry.push_back(fn);
-
-            // Pull __BlueprintNative__ onto the stack
-            duk_push_global_object(ctx);
-            duk_get_prop_string(ctx, -1, "__BlueprintNative__");
-            duk_require_object(ctx, -1);
-
-            // Push a lightfunc that can retrieve the registry index via its magic.
-            // We want the registered method to be able to capture and carry a closure,
-            // but those functions can't be converted to a standard c function pointer. We
-            // therefore hold those functions in a local registry and push a wrapper function
-            // into the script engine, where the wrapper knows which registry index to call back
-            // to via duktape's lightfunc "magic" feature.
-            duk_push_c_lightfunc(ctx, [](duk_context* ctx) -> duk_ret_t {
-                // Retrieve the root instance pointer
-                duk_push_global_stash(ctx);
-                duk_get_prop_string(ctx, -1, "rootInstance");
-                ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
-                duk_pop_2(ctx);
+        /** Ends a live resize, laying the tree out precisely at the final size
+            and sending the Measure events held back since it began.
+         */
+        void endLiveResize()
+        {
+            if (!liveResizing)
+                return;
 
-                jassert (root != nullptr);
+            liveResizing = false;
+            liveResizeDetected = false;
+            liveResizeLayoutPending = false;
 
-                unsigned int fnIndex = ((unsigned int) duk_get_current_magic(ctx)) & 0xffffU;
-                std::vector<juce::var> args;
+            if (liveResizeCover != nullptr)
+            {
+                removeChildComponent(liveResizeCover.get());
+                liveResizeCover.reset();
+            }
 
-                // Build up the arguments vector
-                int nargs = duk_get_top(ctx);
+            performShadowTreeLayout();
+            repaint();
 
-                for (int i = 0; i < nargs; ++i)
-                {
-                    switch (duk_get_type(ctx, i))
-                    {
-                        case DUK_TYPE_STRING:
-                            args.emplace_back(duk_get_string(ctx, i));
-                            break;
-                        case DUK_TYPE_NUMBER:
-                            args.emplace_back(duk_get_number(ctx, i));
-                            break;
-                        case DUK_TYPE_BOOLEAN:
-                            args.emplace_back((bool) duk_get_boolean(ctx, i));
-                            break;
-                        default:
-                            jassertfalse;
-                    }
-                }
+            if (!pendingMeasureEvents.empty())
+                triggerAsyncUpdate();
+        }
 
-                // Dispatch to the method registry
-                root->methodRegistry[fnIndex](
-                    juce::var::NativeFunctionArgs(
-                        juce::var(),
-                        args.data(),
-                        static_cast<int>(args.size())
-                    )
-                );
+        /** Returns true while the window is being drag-resized. */
+        bool isLiveResizing() const { return liveResizing; }
 
-                return 0;
-            }, DUK_VARARGS, 0, static_cast<unsigned int>(fnIndex));
+        /** Undoes a call to `suppressGarbageCollection`. */
+        void resumeGarbageCollection()
+        {
+            idleCollector.resume();
 
-            // Assign it to __BlueprintNative__
-            duk_put_prop_string(ctx, -2, name.c_str());
+            if (!idleCollector.isSuppressed())
+                collectGarbageIfIdle();
         }
 
-        /** Dispatches an event to the React internal view registry.
+        /** Holds off the collections Duktape runs by itself as the heap grows,
+            until the matching call to `endAllocationBurst`, for work which makes
+            a great many short-lived objects at once, such as mounting the tree
+            or a large commit. Mid-burst, each of those collections would mark
+            the whole heap only to find most of it still in use. Calls nest.
 
-            If the view given by the `viewId` has a handler for the given event, it
-            will be called with the given arguments.
+            Once the outermost burst ends, the root runs one compacting collection
+            in its next idle slot. Evaluating a bundle is a burst by itself. Call
+            on the thread the engine runs on; JavaScript does so through
+            `__BlueprintNative__.beginAllocationBurst()`.
          */
-        template <typename... T>
-        void dispatchViewEvent (ViewId viewId, const juce::String& eventType, T... args)
+        void beginAllocationBurst()
         {
-            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
-            std::vector<juce::var> vargs { args... };
+            if (allocationBurstDepth++ == 0)
+                savedCollectionTrigger = suspendVoluntaryCollection(ctx);
+        }
 
-            // Push the dispatchViewEvent function to the top of the stack
-            duk_push_global_object(ctx);
-            duk_push_string(ctx, "__BlueprintNative__");
-            duk_get_prop(ctx, -2);
-            duk_push_string(ctx, "dispatchViewEvent");
-            duk_get_prop(ctx, -2);
+        /** Ends a burst begun with `beginAllocationBurst`. */
+        void endAllocationBurst()
+        {
+            // If you hit this, you've ended a burst that was never begun.
+            jassert (allocationBurstDepth > 0);
 
-            // Now push the arguments
-            int numArgs = 2 + static_cast<int>(vargs.size());
-            duk_require_stack_top(ctx, numArgs);
-            duk_push_int(ctx, viewId);
-            duk_push_string(ctx, eventType.toRawUTF8());
+            if (allocationBurstDepth == 0 || --allocationBurstDepth > 0)
+                return;
 
-            for (auto& p : vargs)
-                pushVarToDukStack(p);
+            resumeVoluntaryCollection(ctx, savedCollectionTrigger);
 
-            // Then issue the call and clear the stack
-            if (duk_pcall(ctx, numArgs) != DUK_EXEC_SUCCESS) {
-                // If we have an error object at the top of the stack, we'll print the
-                // stack property.
-                if (duk_is_error(ctx, -1))
-                {
-                    // Accessing .stack might cause an error to be thrown, so wrap this
-                    // access in a duk_safe_call() if it matters.
-                    duk_get_prop_string(ctx, -1, "stack");
-                    DBG("Duktape call error: " << duk_safe_to_string(ctx, -1));
-                    duk_pop(ctx);
-                }
-                else
-                {
-                    // If it's not an error object we'll just coerce to string
-                    DBG("Duktape call error: " << duk_safe_to_string(ctx, -1));
-                }
+            // A script thread's engine collects as it goes, off the message thread.
+            if (scriptThread == nullptr)
+            {
+                idleCollector.requestCompaction(juce::Time::getMillisecondCounterHiRes());
+                collectGarbageIfIdle();
             }
-
-            duk_pop_n(ctx, 3);
         }
 
-        /** Dispatches an event through the JavaScript EventBridge. */
-        template <typename... T>
-        void dispatchEvent (const juce::String& eventType, T... args)
+        //==============================================================================
+        /** Limits the root's frames to the given rate in Hz, say 30 or 15, or 0 to
+            follow the display. Everything the root does once a frame goes at this
+            rate: animations, layout transitions, animation frame callbacks, the
+            draining of realtime events, coalesced channels and value channels,
+            and the repaints they cause.
+         */
+        void setMaxFrameRate (double hz)
         {
-            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
-            std::vector<juce::var> vargs { args... };
+            maxFrameRate = juce::jmax(0.0, hz);
+            updateFrameRate();
+        }
+
+        /** Returns the frame rate limit set by `setMaxFrameRate`, or 0 for none. */
+        double getMaxFrameRate() const { return maxFrameRate; }
+
+        /** Sets low power mode, for hosts to switch on when running on battery or
+            with many editors open. It limits the root to `lowPowerFrameRate`
+            frames a second, or the frame rate limit if that's lower.
+         */
+        void setLowPowerMode (bool shouldUseLowPower)
+        {
+            lowPowerMode = shouldUseLowPower;
+            updateFrameRate();
+        }
+
+        /** Returns true if the root is in low power mode. */
+        bool isLowPowerMode() const { return lowPowerMode; }
+
+        /** Returns the rate the root's frames actually run at most, in Hz, or 0 if
+            they follow the display.
+         */
+        double getEffectiveFrameRate() const { return scheduler.getMaxFrameRate(); }
+
+        /** Returns the number of idle time collections so far, and their pauses. */
+        const IdleCollector::Stats& getGarbageCollectionStats() const
+        {
+            return idleCollector.getStats();
+        }
+
+        //==============================================================================
+        /** Returns the root's frame timing: the time spent in JavaScript, by kind of
+            call, and in layout, along with counts of tree operations, views laid
+            out, text measures and repaints, for each of the latest frames. The
+            same figures reach JavaScript through `__BlueprintNative__.getStats()`.
+
+            With a script thread, JavaScript's own time and calls go unrecorded,
+            but the tree operations it asks for are counted as they're applied.
+         */
+        const PerformanceStats& getPerformanceStats() const
+        {
+            return performanceStats;
+        }
+
+        /** Counts a tree operation asked of us by JavaScript in the current frame. */
+        void recordBridgeCall (PerformanceStats::BridgeCallType type)
+        {
+            if (!isOnScriptThread())
+                performanceStats.getCurrentFrame().numBridgeCalls[type]++;
+        }
+
+        /** Starts or stops noting which views, and which of their properties,
+            cause each frame's layouts and repaints, in the frames of
+            `getPerformanceStats` and `__BlueprintNative__.getStats()`. The same
+            changes are marked on the trace, as instants, while tracing.
+         */
+        void setInvalidationTrackingEnabled (bool shouldTrack)
+        {
+            performanceStats.setInvalidationTracking(shouldTrack);
+        }
+
+        /** Returns the physical pixel scale the root last painted at, which
+            follows the display it's on. When it changes, the rasterized caches
+            render again progressively, as RescaleBudget describes.
+         */
+        float getDisplayScale() const { return lastPaintScale; }
+
+        /** Returns the samples of how many views, shadow views, Yoga nodes and
+            raw text views are alive, and how big our view table and JavaScript's
+            view registry are, over the last few minutes. See ObjectCensus.
+         */
+        const ObjectCensus& getObjectCensus() const { return objectCensus; }
+
+        /** Notes the size of JavaScript's view registry, which it reports after
+            each commit.
+         */
+        void setScriptViewRegistrySize (int size) { objectCensus.setScriptViewRegistrySize(size); }
+
+        /** Starts or stops timing each view's paint, by view type and refId, as
+            PaintProfiler describes. While the performance overlay shows, it
+            tints each view by its cost. JavaScript can profile too, with
+            `__BlueprintNative__.setPaintProfiling`, and read the figures with
+            `__BlueprintNative__.getPaintStats()`.
+         */
+        void setPaintProfilingEnabled (bool shouldProfile)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, shouldProfile]() { setPaintProfilingEnabled(shouldProfile); });
+
+            paintProfiler.setEnabled(shouldProfile);
+            repaint();
+        }
+
+        /** Returns the figures of the paint profiler. */
+        const PaintProfiler& getPaintProfiler() const { return paintProfiler; }
+
+        /** Returns the paint profiler while it's profiling, or nullptr, for the
+            views as they paint.
+         */
+        PaintProfiler* getActivePaintProfiler() { return paintProfiler.isEnabled() ? &paintProfiler : nullptr; }
+
+        /** Notes a change JavaScript made to the given view which calls for a
+            layout or a repaint, for the stats and the trace.
+         */
+        void noteInvalidation (ViewId viewId, View* view, const juce::Identifier& cause, int effect)
+        {
+            if (effect == PropertyEffect::None)
+                return;
+
+            BLUEPRINT_TRACE_INSTANT("invalidate", viewId, cause.getCharPointer().getAddress());
+
+            if (performanceStats.isTrackingInvalidations())
+                performanceStats.addInvalidation({ viewId, view != nullptr ? view->getRefId() : juce::Identifier(), cause,
+                                                   (effect & PropertyEffect::AffectsLayout) != 0, (effect & PropertyEffect::AffectsPaint) != 0 });
+        }
+
+        /** Notes a mouse event about to go to JavaScript, for the input latency
+            stats, from the time the OS stamped it with.
+         */
+        void noteInputEvent (const juce::MouseEvent& e)
+        {
+            const auto age = juce::Time::getCurrentTime() - e.eventTime;
+            performanceStats.beginInput((double) age.inMilliseconds());
+        }
+
+        /** Counts a text measure made in the current frame's layout. */
+        void recordTextMeasures (int numMeasures)
+        {
+            performanceStats.getCurrentFrame().numTextMeasures += numMeasures;
+        }
+
+        //==============================================================================
+        /** Sets the time budget on each call into JavaScript, and what to do about
+            a call which overruns it. See ScriptWatchdog.
+         */
+        void setScriptWatchdogOptions (const ScriptWatchdog::Options& options)
+        {
+            watchdog.setOptions(options);
+        }
+
+        /** Returns the number of calls into JavaScript the watchdog has aborted. */
+        int getNumAbortedScriptCalls() const
+        {
+            return watchdog.getNumAborts();
+        }
+
+        //==============================================================================
+        /** Starts sampling the JavaScript call stack, discarding any earlier
+            samples. See ScriptProfiler.
+         */
+        void startScriptProfiling (double sampleIntervalMs = 1.0)
+        {
+            scriptProfiler.start(sampleIntervalMs);
+        }
+
+        /** Stops sampling the JavaScript call stack, keeping the samples. */
+        void stopScriptProfiling()
+        {
+            scriptProfiler.stop();
+        }
+
+        /** Returns the root's profiler, for reading its samples. */
+        const ScriptProfiler& getScriptProfiler() const
+        {
+            return scriptProfiler;
+        }
+
+        //==============================================================================
+        /** Computes the flex layout of the view tree on a worker thread of the
+            root's own, rather than on the message thread within each mutation.
+
+            Each layout then copies the shadow tree into a LayoutSnapshot, which
+            the worker lays out while the message thread carries on, and the
+            resulting bounds are applied in one pass when it's done. Layouts
+            requested in the meantime coalesce into one more, once the current
+            one lands, so that the views catch up with the latest tree a frame
+            or so after it changes. Worth it for large trees whose layout takes
+            longer than the host can spare; small trees lay out quicker in place.
+         */
+        void setAsyncLayoutEnabled (bool shouldBeEnabled)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            if (shouldBeEnabled == isAsyncLayoutEnabled())
+                return;
+
+            if (shouldBeEnabled)
+            {
+                layoutThreadPool = std::make_unique<juce::ThreadPool>(1);
+            }
+            else
+            {
+                // Waits for any layout in progress, whose result we then drop.
+                layoutThreadPool = nullptr;
+                ++asyncLayoutGeneration;
+                asyncLayoutInFlight = false;
+                asyncLayoutPending = false;
+            }
+
+            performShadowTreeLayout();
+        }
+
+        /** Returns true if the view tree is laid out on a worker thread. */
+        bool isAsyncLayoutEnabled() const
+        {
+            return layoutThreadPool != nullptr;
+        }
+
+        /** Lays out the panes of the view tree in parallel with one another, on a
+            pool of worker threads, and skips those which haven't changed.
+
+            A pane is a subtree whose root has a fixed width and height, and is
+            either absolutely positioned or set to neither grow nor shrink, so
+            that nothing outside it can move what's inside: the panes of a multi
+            pane editor, for example. Each layout then copies the tree into a
+            LayoutSnapshot, which lays out the panes alongside the rest of the
+            tree and reuses the previous layout of any pane which hasn't changed
+            since. Combines with `setAsyncLayoutEnabled`, which moves the whole
+            of it off the message thread.
+         */
+        void setParallelLayoutEnabled (bool shouldBeEnabled)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            if (shouldBeEnabled == isParallelLayoutEnabled())
+                return;
+
+            // A layout in flight keeps the pool it started with.
+            if (shouldBeEnabled)
+                paneLayoutPool = std::make_shared<juce::ThreadPool>(juce::jmax(1, juce::SystemStats::getNumCpus() - 1));
+            else
+                paneLayoutPool = nullptr;
+
+            paneLayoutCache.clear();
+            performShadowTreeLayout();
+        }
+
+        /** Returns true if the panes of the view tree are laid out in parallel. */
+        bool isParallelLayoutEnabled() const
+        {
+            return paneLayoutPool != nullptr;
+        }
+
+        //==============================================================================
+        /** Sets whether the root's scheduled work, from timers and animation frames
+            to realtime events, waits while the root isn't showing, as it does by
+            default. Every root in the process shares one frame clock, which then
+            lets a hidden editor cost nothing but a check a few times a second.
+            Turn it off for a root which must run while off screen, e.g. one
+            rendered to an image.
+
+            The same goes for the events dispatched to a hidden root through
+            `dispatchEvent`, of which only the latest of each type is kept. The
+            root then catches up in one commit when it shows again.
+         */
+        void setPausedWhileHidden (bool shouldPause)
+        {
+            scheduler.setPausedWhileHidden(shouldPause);
+        }
+
+        //==============================================================================
+        /** Sets whether the root runs headless: without a window, and on a clock
+            of its own which only moves when `advanceClock` is called.
+
+            A headless root does no work of its own accord. Its timers, animation
+            frames, animations and layout transitions run by its clock, from the
+            given start time in milliseconds, so every run of a bundle sees the
+            same frames at the same times, whatever the machine. Together with
+            `renderToImage`, that makes it fit for benchmarks and image tests on
+            machines without a display.
+
+            Leaving headless mode goes back to the system's clock, with the
+            root's scheduled work once again waiting while it's hidden. Only for
+            a root whose engine runs on the message thread.
+         */
+        void setHeadless (bool shouldBeHeadless, double startTimeMs = 0.0)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+            jassert (scriptThread == nullptr);
+
+            manualClockTime = shouldBeHeadless ? juce::jmax(0.0, startTimeMs) : -1.0;
+            scheduler.setPausedWhileHidden(!shouldBeHeadless);
+
+            // Marks by the other clock would measure nonsense against this one.
+            userTimingMarks.clear();
+            userTimingOrigin = { getClockTime(), juce::Time::getHighResolutionTicks() };
+
+            if (shouldBeHeadless)
+                return scheduler.cancel();
+
+            // Whatever fell due in the meantime runs at the next frame.
+            nextAnimationFrameTime = pendingAnimationFrames.empty() ? -1.0 : getClockTime();
+            scheduler.scheduleAfter(0.0);
+        }
+
+        /** Returns true if the root runs on its own clock. See `setHeadless`. */
+        bool isHeadless() const { return manualClockTime >= 0.0; }
+
+        /** Moves a headless root's clock on by the given number of milliseconds,
+            a frame at a time, doing at each frame the work then due, as the
+            scheduler would have.
+         */
+        void advanceClock (double deltaMs)
+        {
+            jassert (isHeadless());
+
+            for (double remaining = deltaMs; remaining > 0.0; remaining -= headlessFrameIntervalMs)
+            {
+                manualClockTime = manualClockTime + juce::jmin(remaining, headlessFrameIntervalMs);
+                runScheduledWork();
+            }
+        }
+
+        /** Returns the time the root's timers and animations run by, in
+            milliseconds: the system's high resolution counter or, headless, the
+            root's own clock.
+         */
+        double getClockTime() const
+        {
+            return isHeadless() ? manualClockTime : juce::Time::getMillisecondCounterHiRes();
+        }
+
+        /** Paints the whole root, at its current layout, into a new ARGB image at
+            the given scale, as it would appear on screen. Works for a root which
+            has no window.
+         */
+        juce::Image renderToImage (float scale = 1.0f)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            return createComponentSnapshot(getLocalBounds(), true, scale);
+        }
+
+        //==============================================================================
+        /** Starts recording the root's bridge traffic into the given stream, such
+            as a FileOutputStream, until `stopBridgeRecording`: the tree
+            operations JavaScript asks for, the commits they come in, the events
+            dispatched to JavaScript and the calls to native methods. See
+            BridgeRecording.
+
+            Event arguments which aren't values, such as worker messages, are
+            recorded as undefined.
+         */
+        void startBridgeRecording (std::unique_ptr<juce::OutputStream> stream)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+            bridgeRecorder = std::make_unique<BridgeRecorder>(std::move(stream), getClockTime());
+        }
+
+        /** Stops a recording, flushing its stream. */
+        void stopBridgeRecording()
+        {
+            bridgeRecorder.reset();
+        }
+
+        /** Returns true while the root is recording its bridge traffic. */
+        bool isRecordingBridge() const { return bridgeRecorder != nullptr; }
+
+        /** Replays a recording on this root, which must be headless, moving its
+            clock on to each record's time on the way, so that frames, timers
+            and animations run between records as they did. Returns the number of
+            records replayed.
+
+            Replaying the tree operations needs a root with no bundle; the views
+            are created afresh, under ids of their own, and native methods are
+            called as they were. Replaying the events needs a root already
+            running the bundle the recording was made with, which then builds its
+            tree as it did, view ids and all, so the events find their views.
+         */
+        int replayBridgeRecording (const BridgeRecording& recording, BridgeRecording::ReplayMode mode)
+        {
+            jassert (isHeadless());
+
+            if (recording.records.empty())
+                return 0;
+
+            std::unordered_map<ViewId, ViewId> ids { { getViewId(), getViewId() } };
+
+            auto find = [&ids](ViewId recordedId) {
+                const auto it = ids.find(recordedId);
+                return it != ids.end() ? it->second : 0;
+            };
+
+            const double recordingStart = recording.records.front().timeMs;
+            const double replayStart = getClockTime();
+            int numReplayed = 0;
+
+            for (const auto& r : recording.records)
+            {
+                const double due = replayStart + (r.timeMs - recordingStart);
+
+                if (due > getClockTime())
+                    advanceClock(due - getClockTime());
+
+                if (mode == BridgeRecording::ReplayMode::Events)
+                {
+                    if (r.type == BridgeRecording::Event || r.type == BridgeRecording::ViewEvent)
+                    {
+                        dispatchRecordedEvent(r);
+                        ++numReplayed;
+                    }
+
+                    continue;
+                }
+
+                const ViewId viewId = find(r.viewId);
+                const ViewId childId = find(r.childId);
+                const bool hasView = viewId != 0;
+                const bool hasChild = hasView && childId != 0;
+
+                switch (r.type)
+                {
+                    case BridgeRecording::CreateView:
+                        if (viewTypes.count(r.name.toString()) == 0)
+                            continue;
+
+                        ids[r.viewId] = createViewInstance(r.name.toString());
+                        break;
+
+                    case BridgeRecording::CreateTextView:
+                        ids[r.viewId] = createTextViewInstance(r.value.toString());
+                        break;
+
+                    case BridgeRecording::SetProperty:
+                        if (!hasView)
+                            continue;
+
+                        setViewProperty(viewId, r.name, r.value);
+                        break;
+
+                    case BridgeRecording::SetProperties:
+                        if (!hasView || r.value.getDynamicObject() == nullptr)
+                            continue;
+
+                        setViewProperties(viewId, r.value.getDynamicObject()->getProperties());
+                        break;
+
+                    case BridgeRecording::SetText:
+                        if (!hasView)
+                            continue;
+
+                        setRawTextValue(viewId, r.value.toString());
+                        break;
+
+                    case BridgeRecording::AddChild:
+                        if (!hasChild)
+                            continue;
+
+                        addChild(viewId, childId, r.index);
+                        break;
+
+                    case BridgeRecording::RemoveChild:
+                        if (!hasChild)
+                            continue;
+
+                        removeChild(viewId, childId);
+                        break;
+
+                    case BridgeRecording::MoveChild:
+                        if (!hasChild)
+                            continue;
+
+                        moveChild(viewId, childId, r.index);
+                        break;
+
+                    case BridgeRecording::BeginCommit:
+                        beginCommit();
+                        break;
+
+                    case BridgeRecording::EndCommit:
+                        endCommit();
+                        break;
+
+                    case BridgeRecording::NativeMethod:
+                        if (!callRecordedNativeMethod(r))
+                            continue;
+
+                        break;
+
+                    case BridgeRecording::DefineName:
+                    case BridgeRecording::Event:
+                    case BridgeRecording::ViewEvent:
+                    case BridgeRecording::numRecordTypes:
+                        continue;
+                }
+
+                ++numReplayed;
+            }
+
+            return numReplayed;
+        }
+
+        //==============================================================================
+        /** Readies the root to outlive the component it's in, so that the next
+            editor can take it over whole, engine, view tree and all, rather than
+            build its own. See ParkedRoot.
+
+            The root comes off its parent, after which it isn't showing and its
+            scheduled work waits, and, if asked, its engine runs a compacting
+            collection so that the heap it keeps is as small as it can be.
+         */
+        void prepareToPark (bool compactHeap = true)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            // Nothing can run while we're away unless our scheduler waits.
+            scheduler.setPausedWhileHidden(true);
+
+            if (auto* parent = getParentComponent())
+                parent->removeChildComponent(this);
+
+            if (!compactHeap)
+                return;
+
+            if (scriptThread != nullptr)
+                callIntoScript([this]() { duk_gc(ctx, DUK_GC_COMPACT); });
+            else
+                duk_gc(ctx, DUK_GC_COMPACT);
+        }
+
+        /** Returns the memory held by the engine's heap, in bytes: with a
+            DuktapeAllocator, its pools and whatever it has taken from the system,
+            or else the bytes the heap holds. Call on the thread the engine runs
+            on, or while it's idle.
+         */
+        size_t getHeapSize() const
+        {
+            if (heapAllocator == nullptr)
+                return heapMeter.getStats().liveBytes;
+
+            return heapAllocator->getPoolBytes() + heapAllocator->getSystemBytesInUse();
+        }
+
+        /** Returns the bytes the engine's heap holds, their peak and the number of
+            allocations made since the heap was created. The same figures reach
+            JavaScript through `__BlueprintNative__.getHeapStats()`. Safe to call
+            from any thread.
+         */
+        HeapMeter::Stats getHeapStats() const
+        {
+            return heapMeter.getStats();
+        }
+
+        /** Returns a census of the engine's heap, of what it holds by constructor
+            and kind. The same reaches JavaScript through
+            `__BlueprintNative__.getHeapCensus()`. Call on the thread the engine
+            runs on, or while it's idle.
+         */
+        HeapCensus takeHeapCensus()
+        {
+            return blueprint::takeHeapCensus(ctx);
+        }
+
+        /** Puts a limit on the bytes the engine's heap may hold, and a threshold
+            at which to warn of it. See HeapMeter.
+         */
+        void setHeapLimits (const HeapMeter::Options& options)
+        {
+            if (scriptThread != nullptr)
+                callIntoScript([this, options]() { heapMeter.setOptions(options); });
+            else
+                heapMeter.setOptions(options);
+        }
+
+        //==============================================================================
+        /** Paints large dirty areas in tiles across a pool of threads, through a
+            TiledRasterizer, for big editors rendered in software. Views which
+            can't paint concurrently, such as text, are still painted on the
+            message thread, in their own areas.
+
+            While OpenGL rendering is enabled, or the root is buffered to an
+            image, the root paints as before.
+         */
+        void setTiledRasterizationEnabled (bool shouldBeEnabled)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            tiledRasterizationEnabled = shouldBeEnabled;
+            updateTiledRasterizer();
+            repaint();
+        }
+
+        /** Returns true if the root paints large dirty areas in tiles. */
+        bool isTiledRasterizationEnabled() const { return tiledRasterizationEnabled; }
+
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+        //==============================================================================
+        /** Renders the root and every view within it through an OpenGL context,
+            rather than JUCE's software renderer. The views paint exactly as
+            before, into an OpenGL framebuffer, and only the areas invalidated
+            since the last frame are painted again.
+
+            Images are uploaded as textures once, and drawn from the texture
+            until they change, so that rasterized views and cached layers cost a
+            texture draw at any size. Rasterized views render their content to
+            images on the GPU in the first place. Paths and text are still filled
+            through edge tables on the CPU, so large animated vector content is
+            best rasterized.
+         */
+        void setOpenGLRenderingEnabled (bool shouldBeEnabled)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            if (shouldBeEnabled == isOpenGLRenderingEnabled())
+                return;
+
+            if (shouldBeEnabled)
+            {
+                openGLContext = std::make_unique<juce::OpenGLContext>();
+                openGLContext->setComponentPaintingEnabled(true);
+                openGLContext->setContinuousRepainting(false);
+                openGLContext->attachTo(*this);
+            }
+            else
+            {
+                openGLContext->detach();
+                openGLContext = nullptr;
+                updateTiledRasterizer();
+            }
+
+            repaint();
+        }
+
+        /** Returns true if the root renders through an OpenGL context. */
+        bool isOpenGLRenderingEnabled() const { return openGLContext != nullptr; }
+#endif
+
+        /** Invokes the JavaScript timers that are due, for up to the given budget,
+            then sleeps until the next.
+         */
+        void runTimers (double budgetMs)
+        {
+            jassert (isOnEngineThread());
+
+            const double now = getClockTime();
+            const double sliceEnd = juce::Time::getMillisecondCounterHiRes() + budgetMs;
+            TimerQueue::TimerId id;
+            bool repeating;
+
+            timerQueue.mark();
+
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, "timerCallbacks");
+
+            const duk_idx_t callbacksIdx = duk_normalize_index(ctx, -1);
+
+            while (timerQueue.popDue(now, id, repeating))
+            {
+                // Each entry is an array of [callback, ...args]
+                if (!duk_get_prop_index(ctx, callbacksIdx, static_cast<duk_uarridx_t>(id)))
+                {
+                    duk_pop(ctx);
+                    continue;
+                }
+
+                if (!repeating)
+                    duk_del_prop_index(ctx, callbacksIdx, static_cast<duk_uarridx_t>(id));
+
+                const duk_idx_t entryIdx = duk_normalize_index(ctx, -1);
+                const auto length = static_cast<duk_idx_t>(duk_get_length(ctx, entryIdx));
+
+                duk_require_stack(ctx, length);
+
+                for (duk_idx_t i = 0; i < length; ++i)
+                    duk_get_prop_index(ctx, entryIdx, static_cast<duk_uarridx_t>(i));
+
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::TimerCall);
+
+                if (duk_pcall(ctx, length - 1) != DUK_EXEC_SUCCESS)
+                    DBG("Duktape timer callback error: " << duk_safe_to_string(ctx, -1));
+
+                duk_pop_2(ctx);
+                runMicrotasks();
+
+                // Whatever's still due waits for the next pass, behind any input
+                // that's come in since.
+                if (juce::Time::getMillisecondCounterHiRes() >= sliceEnd
+                    || (isOnScriptThread() && scriptThread->hasPendingTasks()))
+                    break;
+            }
+
+            duk_pop_2(ctx);
+            scheduleTimers();
+        }
+
+        //==============================================================================
+        /** Reads a JavaScript bundle from file and evaluates it in the Duktape context. */
+        void evalScript (const juce::String& script)
+        {
+            evalScript(script.toRawUTF8(), script.getNumBytesAsUTF8());
+        }
+
+        /** Evaluates a bundle straight from memory, such as BinaryData, which
+            Duktape compiles in place rather than first copying into a string.
+         */
+        void evalScript (const char* utf8, size_t numBytes)
+        {
+            // The caller's memory needn't outlive the call, so the script thread
+            // gets a copy of its own.
+            if (scriptThread != nullptr && !isOnScriptThread())
+            {
+                juce::MemoryBlock copy (utf8, numBytes);
+
+                return callIntoScript([this, copy]() {
+                    evalScript(static_cast<const char*>(copy.getData()), copy.getSize());
+                });
+            }
+
+            beginAllocationBurst();
+
+            // This is duk_peval_lstring in two steps, so that startup can tell
+            // compiling the bundle from running it.
+            bool compiled = false;
+
+            {
+                const PerformanceStats::ScopedStartupPhase startupPhase (getStartupStats(), PerformanceStats::CompilePhase);
+                compiled = duk_pcompile_lstring(ctx, DUK_COMPILE_EVAL, utf8, numBytes) == 0;
+            }
+
+            if (compiled)
+            {
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::EvaluationCall);
+                const PerformanceStats::ScopedStartupPhase startupPhase (getStartupStats(), PerformanceStats::EvaluationPhase);
+
+                duk_push_global_object(ctx);
+
+                if (duk_pcall_method(ctx, 0) != DUK_EXEC_SUCCESS) {
+                    printf("Script evaluation failed: %s\n", duk_safe_to_string(ctx, -1));
+                }
+            }
+            else
+            {
+                printf("Script compilation failed: %s\n", duk_safe_to_string(ctx, -1));
+            }
+
+            duk_pop(ctx);
+            runMicrotasks();
+            endAllocationBurst();
+            didEvaluateBundle();
+        }
+
+        /** Starts decoding the images and resolving the typefaces the manifest
+            names, on the AssetPreloader's threads, so that they're ready by the
+            time the views using them mount. The root holds them until its first
+            paint, by when the views hold what they use.
+
+            Bundles loaded from file do this with any manifest shipped alongside
+            them, as `main.assets.json` for `main.js`; see AssetPreloader.
+         */
+        void preloadAssets (const AssetPreloader::Manifest& manifest)
+        {
+            if (manifest.isEmpty())
+                return;
+
+            preloadedAssets = assetPreloader->preload(manifest);
+        }
+
+        /** Evaluates a bundle from file, mapping the file into memory rather than
+            reading it into a string, so the bundle is never held twice.
+         */
+        void evalScript (const juce::File& bundle)
+        {
+            std::unique_ptr<juce::MemoryMappedFile> source;
+            sourceFile = bundle;
+            sourceCacheDirectory = juce::File();
+            bool mapped = false;
+
+            preloadBundleAssets(bundle);
+
+            {
+                const PerformanceStats::ScopedStartupPhase startupPhase (getStartupStats(), PerformanceStats::BundleReadPhase);
+                mapped = BytecodeBundle::mapBundle(bundle, source);
+            }
+
+            if (!mapped)
+            {
+                printf("Failed to read bundle: %s\n", bundle.getFullPathName().toRawUTF8());
+                return;
+            }
+
+            evalScript(static_cast<const char*>(source->getData()), source->getSize());
+        }
+
+        /** Evaluates a bytecode bundle made by `BytecodeBundle::compile`, such as
+            one embedded with BinaryData, returning false if the bundle came from
+            a different Duktape build and so can't be loaded.
+         */
+        bool evalBytecode (const void* data, size_t size)
+        {
+            const void* bytecode = nullptr;
+            size_t bytecodeSize = 0;
+            juce::String error;
+
+            if (!BytecodeBundle::getBytecode(data, size, bytecode, bytecodeSize, error))
+            {
+                DBG("Bytecode bundle rejected: " << error);
+                return false;
+            }
+
+            if (scriptThread != nullptr && !isOnScriptThread())
+            {
+                juce::MemoryBlock copy (bytecode, bytecodeSize);
+
+                callIntoScript([this, copy]() { runBytecode(copy.getData(), copy.getSize()); });
+                return true;
+            }
+
+            runBytecode(bytecode, bytecodeSize);
+            return true;
+        }
+
+        /** Evaluates a JavaScript bundle from file by way of a bytecode cache in the
+            given directory, so that the bundle is only compiled the first time it
+            is loaded, and again whenever its contents change.
+
+            The bytecode is shared through the AssetStore with every other root in
+            the process running the same bundle, so that a session with many
+            instances compiles or reads it once, and holds it once.
+         */
+        void loadBundle (const juce::File& bundle, const juce::File& cacheDirectory)
+        {
+            juce::String error;
+            sourceFile = bundle;
+            sourceCacheDirectory = cacheDirectory;
+
+            preloadBundleAssets(bundle);
+
+            if (auto bytecode = getSharedBytecode(*assetStore, bundle, cacheDirectory, error, getStartupStats()))
+                evalSharedBytecode(std::move(bytecode));
+            else
+                printf("Script evaluation failed: %s\n", error.toRawUTF8());
+        }
+
+        /** Like `loadBundle`, but reads and compiles the bundle on a background
+            thread, in a Duktape heap of its own, so that opening an editor never
+            blocks the message thread on the compiler. Once the bytecode is ready,
+            it's evaluated on the message thread and the callback, if any, is
+            called with whether the bundle ran.
+
+            Until then, the placeholder, if given, covers the root, and events
+            dispatched to JavaScript wait for the bundle to be running.
+         */
+        void loadBundleAsync (const juce::File& bundle, const juce::File& cacheDirectory,
+                              std::function<void(bool)> onComplete = nullptr,
+                              std::unique_ptr<juce::Component> placeholder = nullptr)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            // If you hit this, a previous asynchronous load is still in flight; it's
+            // superseded by this one.
+            jassert (bundleLoader == nullptr);
+
+            bundleLoader.reset();
+            loadingPlaceholder = std::move(placeholder);
+            sourceFile = bundle;
+            sourceCacheDirectory = cacheDirectory;
+
+            preloadBundleAssets(bundle);
+
+            if (loadingPlaceholder != nullptr)
+            {
+                addAndMakeVisible(loadingPlaceholder.get());
+                loadingPlaceholder->setBounds(getLocalBounds());
+            }
+
+            bundleLoader = std::make_unique<BundleLoader>(*this, nextBundleLoadId++, bundle, cacheDirectory, std::move(onComplete));
+            bundleLoader->startThread();
+        }
+
+        /** Returns true while a bundle is loading in the background. */
+        bool isLoadingBundle() const { return bundleLoader != nullptr; }
+
+        //==============================================================================
+        /** Keeps snapshots of the root's interface in the given directory, one for
+            each size and display scale, for an instant first paint.
+
+            When the root closes, it saves an image of what it last showed. When
+            it next opens at the same size and scale, it shows that image at
+            once, over the placeholder if there is one, while the bundle loads
+            and React mounts. The image crossfades into the real tree over
+            `startupSnapshotFadeMs` once the first commit lands. Call before
+            loading the bundle; an empty File turns snapshots off.
+         */
+        void setStartupSnapshotDirectory (const juce::File& directory)
+        {
+            startupSnapshotDirectory = directory;
+
+            if (directory != juce::File() && !hasCommitted && !getLocalBounds().isEmpty())
+                showStartupSnapshot();
+        }
+
+        /** Saves a snapshot of the interface as it is now for the next startup,
+            as the root does when it closes, if it keeps snapshots and its tree
+            has committed.
+         */
+        void saveStartupSnapshot()
+        {
+            if (startupSnapshotDirectory == juce::File() || !hasCommitted || isHeadless() || getLocalBounds().isEmpty())
+                return;
+
+            const auto file = getStartupSnapshotFile(lastPaintScale);
+            const auto image = renderToImage(lastPaintScale);
+
+            if (!startupSnapshotDirectory.createDirectory())
+                return;
+
+            // Written in full before it replaces the last, so that a crash mid-way
+            // doesn't leave half an image for the next startup.
+            juce::TemporaryFile temp (file);
+
+            if (auto out = temp.getFile().createOutputStream())
+            {
+                juce::PNGImageFormat png;
+
+                if (png.writeImageToStream(image, *out))
+                {
+                    out.reset();
+                    temp.overwriteTargetFileWithTemporary();
+                }
+            }
+        }
+
+        /** Enables keyboard focus on this component, expecting keypress events to reload
+            the javascript bundle.
+         */
+        void enableHotkeyReloading()
+        {
+            setWantsKeyboardFocus(true);
+        }
+
+        /** Watches the given bundle, reloading it with `reload` whenever it changes
+            on disk, by way of a bytecode cache in the given directory if there is
+            one. A write is only picked up once the file has stopped changing, so
+            a bundler's partial writes are never evaluated.
+         */
+        void enableHotReload (const juce::File& bundle, const juce::File& cacheDirectory = {}, int pollIntervalMs = 500)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            sourceFile = bundle;
+            sourceCacheDirectory = cacheDirectory;
+            bundleWatcher = std::make_unique<BundleWatcher>(bundle, pollIntervalMs, [this]() { reload(); });
+        }
+
+        /** Stops watching the bundle for changes. */
+        void disableHotReload()
+        {
+            bundleWatcher.reset();
+        }
+
+        /** Reloads the bundle last loaded from file into a fresh engine.
+
+            The native views are kept for the new bundle's mount to reuse, so that
+            iterating on a large interface doesn't rebuild every component from
+            scratch each time. See `resetEngine`.
+         */
+        void reload()
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            // An earlier load still in flight would only be replaced.
+            bundleLoader.reset();
+
+            resetEngine();
+
+            if (sourceFile.existsAsFile())
+                loadBundle(sourceFile, sourceCacheDirectory);
+        }
+
+        //==============================================================================
+        /** Sets the directory from which the bundle's `require` loads modules. By
+            default it's the directory of the bundle last loaded from file.
+
+            A bundle split into chunks, as webpack does for `import()` with a
+            `target` of "node", need only evaluate the chunks for the first screen
+            when the editor opens, requiring the rest as they're needed. Each chunk
+            is compiled once and cached alongside the bundle's bytecode, then
+            shared through the AssetStore like the bundle itself.
+         */
+        void setModuleDirectory (const juce::File& directory)
+        {
+            moduleDirectory = directory;
+        }
+
+        /** Returns the directory from which the bundle's `require` loads modules. */
+        juce::File getModuleDirectory() const
+        {
+            return moduleDirectory != juce::File() ? moduleDirectory : sourceFile.getParentDirectory();
+        }
+
+        /** Resolves a module id, as passed to `require` from the module with the
+            given id, to the path of its file relative to the module directory,
+            which is then the module's own id. Ids starting "./" or "../" are
+            relative to the requiring module, and any other to the module
+            directory, and ".js" may be left off. Returns an empty string if
+            there's no such file.
+         */
+        juce::String resolveModule (const juce::String& requestedId, const juce::String& parentId) const
+        {
+            const auto directory = getModuleDirectory();
+            const bool isRelative = requestedId.startsWith("./") || requestedId.startsWith("../");
+            const auto base = isRelative && parentId.isNotEmpty() ? directory.getChildFile(parentId).getParentDirectory()
+                                                                  : directory;
+
+            auto file = base.getChildFile(requestedId);
+
+            if (!file.existsAsFile())
+                file = base.getChildFile(requestedId + ".js");
+
+            if (!file.existsAsFile())
+                return {};
+
+            return file.getRelativePathFrom(directory).replaceCharacter('\\', '/');
+        }
+
+        /** Returns the bytecode for the module with the given id, as resolved by
+            `resolveModule`, held for as long as the engine runs. Each module's
+            source is compiled wrapped in the CommonJS module function, so the
+            bytecode evaluates to that function. Called from the engine's thread.
+         */
+        AssetStore::Asset getModuleBytecode (const juce::String& id, juce::String& error)
+        {
+            auto bytecode = getSharedModuleBytecode(*assetStore, getModuleDirectory().getChildFile(id),
+                                                    sourceCacheDirectory, error);
+
+            if (bytecode != nullptr)
+                moduleBytecode.push_back(bytecode);
+
+            return bytecode;
+        }
+
+        /** Enables keyboard focus on this component, expecting Cmd+Shift+P to start
+            the script profiler and, pressed again, to stop it and write the
+            collapsed stacks to the given file.
+         */
+        void enableHotkeyProfiling (const juce::File& outputFile)
+        {
+            setWantsKeyboardFocus(true);
+            profileOutputFile = outputFile;
+        }
+
+        /** Enables keyboard focus on this component, expecting Cmd+Shift+O to show
+            and hide the performance overlay.
+         */
+        void enableHotkeyPerformanceOverlay()
+        {
+            setWantsKeyboardFocus(true);
+            performanceOverlayHotkeyEnabled = true;
+        }
+
+        /** Shows or hides the performance overlay, which draws the latest frames'
+            cost, bridge calls, layout and heap size over the interface, and
+            flashes each area the root repaints. See PerformanceOverlay.
+            JavaScript can show it too, with the root's `performance-overlay`
+            property.
+         */
+        void setPerformanceOverlayVisible (bool shouldBeVisible)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            if (shouldBeVisible == isPerformanceOverlayVisible())
+                return;
+
+            if (shouldBeVisible)
+                performanceOverlay = std::make_unique<PerformanceOverlay>(*this);
+            else
+                performanceOverlay.reset();
+        }
+
+        /** Returns true if the performance overlay is showing. */
+        bool isPerformanceOverlayVisible() const { return performanceOverlay != nullptr; }
+
+        /** Moves the root's JavaScript engine onto a thread of its own, so that a
+            heavy render or handler never holds up the host's interface.
+
+            Every call into the engine, from bundle evaluation to events, timers
+            and animation frames, is then queued for the script thread, which
+            runs them in order. What the script asks of the native tree in the
+            meantime is recorded rather than applied, and each reconciler commit
+            is applied on the message thread in one go once it's complete, so
+            the interface only ever paints whole commits. The engine's view ids
+            are its own, and are translated at the boundary.
+
+            Native methods registered with `registerNativeMethod` still run on
+            the message thread, in order with the commit they were called from.
+            Methods and functions registered once the script thread is running
+            are installed on it, in order with the calls already queued. Value
+            channels are refreshed for JavaScript on the script thread, before
+            each animation frame, so property bindings should read their sources
+            directly. The engine
+            collects its own garbage as it goes, off the message thread, rather
+            than waiting for idle time.
+
+            Call this on the message thread, before evaluating anything.
+         */
+        void enableScriptThread()
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            // If you hit this, the engine has already made views on the message
+            // thread, whose ids it can't now trade for the script thread's own.
+            jassert (viewTable.size() == 0);
+
+            if (scriptThread == nullptr)
+                startScriptThread();
+        }
+
+        /** Returns true if the JavaScript engine runs on a thread of its own. */
+        bool isScriptThreadEnabled() const { return scriptThread != nullptr; }
+
+        /** Handles the hotkeys, Cmd+R reloading the bundle last loaded from file,
+            and otherwise dispatches the key to the root's own keyDown handlers,
+            if it has any. Keys nobody handles return false, and go on to the
+            host, so that we don't starve it of its shortcuts.
+         */
+        bool keyPressed (const juce::KeyPress& key) override
+        {
+            bool cmd = key.getModifiers().isCommandDown();
+            auto r = key.isKeyCode(82);
+
+            if (cmd && key.getModifiers().isShiftDown() && key.isKeyCode(79) && performanceOverlayHotkeyEnabled)
+            {
+                setPerformanceOverlayVisible(!isPerformanceOverlayVisible());
+                return true;
+            }
+
+            if (cmd && key.getModifiers().isShiftDown() && key.isKeyCode(80) && profileOutputFile != juce::File())
+            {
+                if (!scriptProfiler.isRunning())
+                {
+                    DBG("Starting the script profiler.");
+                    startScriptProfiling();
+                    return true;
+                }
+
+                stopScriptProfiling();
+                profileOutputFile.replaceWithText(scriptProfiler.getCollapsedStacks());
+
+                DBG("Wrote " << scriptProfiler.getNumSamples() << " script profiler samples to " << profileOutputFile.getFullPathName());
+                return true;
+            }
+
+            if (cmd && r)
+            {
+                reload();
+                return true;
+            }
+
+            return View::keyPressed(key);
+        }
+
+        /** A simple accessor for the underlying Duktape context. */
+        duk_context* getDuktapeContext()
+        {
+            return ctx;
+        }
+
+        //==============================================================================
+        // VIEW MANAGER STUFF: SPLIT OUT?
+
+        /** Registers a new dynamic view type and its associated factory.
+
+            A factory whose leaf views have an intrinsic size, as an image does,
+            pairs them with a MeasuredShadowView and its measure function.
+         */
+        void registerViewType(const juce::String& typeId, ViewFactory f)
+        {
+            registerViewType(typeId, std::move(f), nullptr);
+        }
+
+        /** Registers a new dynamic view type whose removed views are recycled.
+
+            Rather than destroy a removed view, the root resets it, with the view
+            and shadow view's resetForReuse and then the given resetter, and keeps
+            it in a pool from which createViewInstance takes views of the type
+            before calling the factory. Only opt in types whose state is entirely
+            reset by those.
+         */
+        void registerViewType(const juce::String& typeId, ViewFactory f, ViewResetter resetter)
+        {
+            // If you hit this jassert, you're trying to register a type which
+            // has already been registered!
+            jassert (viewTypes.find(typeId) == viewTypes.end());
+
+            auto& type = viewTypes[typeId];
+            type.factory = std::move(f);
+            type.resetter = std::move(resetter);
+        }
+
+        /** Registers a view type whose views are a ViewClass, and their shadow
+            views a ShadowClass made with the view, or none if it's void.
+
+            If the view class declares a ViewPropertyTable with a static
+            getPropertyTable(), the table's consumers are declared for the type
+            along with it. Given a resetter, the type's views are recycled as
+            with the factory form.
+         */
+        template <typename ViewClass, typename ShadowClass = ShadowView>
+        void registerViewType (const juce::String& typeId, ViewResetter resetter = nullptr)
+        {
+            static_assert (std::is_base_of<View, ViewClass>::value, "Views must derive from blueprint::View.");
+
+            registerViewType(typeId, []() -> ViewPair {
+                auto view = std::make_unique<ViewClass>();
+
+                if constexpr (std::is_void<ShadowClass>::value)
+                {
+                    return {std::move(view), nullptr};
+                }
+                else
+                {
+                    auto shadowView = std::make_unique<ShadowClass>(view.get());
+                    return {std::move(view), std::move(shadowView)};
+                }
+            }, std::move(resetter));
+
+            if constexpr (HasViewPropertyTable<ViewClass>::value)
+            {
+                ViewClass::getPropertyTable().forEachProperty([this, &typeId](const juce::Identifier& name, int consumers) {
+                    declareViewTypeProperty(typeId, name, consumers);
+                });
+            }
+        }
+
+        /** Declares which of a registered type's view and shadow view consume the
+            given property, a combination of ViewType::PropertyConsumer flags.
+            Types registered with a property table declare theirs from it.
+
+            By default flex properties, `debug` and `layout-transition` go to the
+            shadow view alone, and everything else to the view alone; a custom
+            shadow view which measures by a style property, say, declares that
+            property for both. Either way the value is stored once, by the view.
+         */
+        void declareViewTypeProperty (const juce::String& typeId, const juce::Identifier& name, int consumers)
+        {
+            auto it = viewTypes.find(typeId);
+
+            // If you hit this, register the type before declaring its properties.
+            jassert (it != viewTypes.end());
+
+            if (it != viewTypes.end())
+                it->second.propertyConsumers[name] = consumers;
+        }
+
+        //==============================================================================
+        /** A component hosting one of the root's surfaces: a second tree, mounted
+            into the root's own heap by its own React root, for a window of its
+            own such as a detached mixer or a floating keyboard.
+
+            Each window gets a surface rather than a root of its own, so that one
+            heap and one bundle run every window and they share their stores
+            directly. JavaScript renders into a surface by name:
+            @code
+            Blueprint.render(<Mixer />, Blueprint.getSurfaceContainer('mixer'));
+            @endcode
+
+            and native code shows it by putting a Surface of the same name in a
+            window, before or after the render. The surface's tree is laid out to
+            the Surface's size along with the root's own, and its views dispatch
+            their events through the root like any other. Deleting the Surface
+            takes the tree off screen, but the tree stays until JavaScript
+            unmounts it.
+
+            Create and delete surfaces on the message thread, and only while
+            their root is alive.
+         */
+        class Surface : public juce::Component
+        {
+        public:
+            Surface (ReactApplicationRoot& _root, const juce::String& _surfaceName)
+                : root(&_root), surfaceName(_surfaceName)
+            {
+                _root.attachSurface(surfaceName, *this);
+            }
+
+            ~Surface() override
+            {
+                if (auto* r = root.getComponent())
+                    r->detachSurface(surfaceName, *this);
+            }
+
+            void resized() override
+            {
+                if (auto* r = root.getComponent())
+                    r->performShadowTreeLayout();
+            }
+
+            /** Returns the name JavaScript renders into this surface by. */
+            const juce::String& getSurfaceName() const noexcept { return surfaceName; }
+
+        private:
+            juce::Component::SafePointer<ReactApplicationRoot> root;
+            const juce::String surfaceName;
+
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Surface)
+        };
+
+        /** Returns the id of the view at the top of the named surface's tree,
+            creating the view if the surface hasn't been asked for before.
+         */
+        ViewId getSurfaceViewId (const juce::String& name)
+        {
+            if (isOnScriptThread())
+            {
+                auto it = scriptSurfaceIds.find(name);
+
+                if (it != scriptSurfaceIds.end())
+                    return it->second;
+
+                const ViewId scriptId = nextScriptViewId++;
+                scriptSurfaceIds[name] = scriptId;
+                runOnMessageThread([this, name, scriptId]() { mapScriptViewId(scriptId, getSurfaceViewId(name)); });
+                return scriptId;
+            }
+
+            auto& surface = surfaces[name];
+
+            if (surface.viewId != 0 && viewTable.find(surface.viewId) != nullptr)
+                return surface.viewId;
+
+            surface.viewId = createViewInstance("View");
+
+            if (auto* entry = viewTable.find(surface.viewId))
+            {
+#if BLUEPRINT_FLATTEN_LAYOUT_VIEWS
+                // The top of a surface is a component whatever its properties,
+                // for the host to hold.
+                entry->view->setLayoutOnly(false);
+#endif
+
+                if (surface.host != nullptr)
+                    surface.host->addAndMakeVisible(entry->view.get());
+            }
+
+            return surface.viewId;
+        }
+
+        /** Returns the id of the view at the top of the named overlay's tree,
+            creating the overlay if it hasn't been asked for before.
+
+            An overlay holds popups, menus and tooltips above the root's own
+            views, and JavaScript renders into it through a portal:
+            @code
+            Blueprint.createPortal(<Tooltip />, Blueprint.getOverlayContainer('tooltips'));
+            @endcode
+
+            Like a surface's, the overlay's tree is a shadow root of its own, laid
+            out to the root's size apart from the root's tree, so that opening a
+            tooltip lays out the tooltip and nothing else. The top view fills the
+            root but lets clicks through to the views beneath; only what's
+            rendered into it takes them. Overlays created later sit above those
+            created earlier.
+         */
+        ViewId getOverlayViewId (const juce::String& name)
+        {
+            if (isOnScriptThread())
+            {
+                auto it = scriptOverlayIds.find(name);
+
+                if (it != scriptOverlayIds.end())
+                    return it->second;
+
+                const ViewId scriptId = nextScriptViewId++;
+                scriptOverlayIds[name] = scriptId;
+                runOnMessageThread([this, name, scriptId]() { mapScriptViewId(scriptId, getOverlayViewId(name)); });
+                return scriptId;
+            }
+
+            auto& overlay = overlays[name];
+
+            if (overlay.viewId != 0 && viewTable.find(overlay.viewId) != nullptr)
+                return overlay.viewId;
+
+            if (overlayLayer == nullptr)
+            {
+                overlayLayer = std::make_unique<OverlayLayer>();
+                addAndMakeVisible(overlayLayer.get());
+                overlayLayer->setBounds(getLocalBounds());
+            }
+
+            overlay.host = overlayLayer.get();
+            overlay.viewId = createViewInstance("View");
+
+            if (auto* entry = viewTable.find(overlay.viewId))
+            {
+#if BLUEPRINT_FLATTEN_LAYOUT_VIEWS
+                // The top of an overlay is a component too, for the layer to hold.
+                entry->view->setLayoutOnly(false);
+#endif
+
+                entry->view->setInterceptsMouseClicks(false, true);
+                overlayLayer->addAndMakeVisible(entry->view.get());
+            }
+
+            return overlay.viewId;
+        }
+
+        /** Creates a new view instance and registers it with the view table. */
+        ViewId createViewInstance(const juce::String& viewType)
+        {
+            if (isOnScriptThread())
+            {
+                const ViewId scriptId = nextScriptViewId++;
+                runOnMessageThread([this, viewType, scriptId]() { mapScriptViewId(scriptId, createViewInstance(viewType)); });
+                return scriptId;
+            }
+
+            recordBridgeCall(PerformanceStats::CreateViewCall);
+
+            auto it = viewTypes.find(viewType);
+
+            // We can't create a view instance of a type that hasn't been registered.
+            jassert (it != viewTypes.end());
+
+            const ShadowView::ScopedConfig scopedConfig (yogaConfig.config);
+            auto [view, shadowView] = takeOrCreateView(it->second);
+            view->setOwningRoot(this);
+
+#if BLUEPRINT_FLATTEN_LAYOUT_VIEWS
+            // Every View starts out layout-only, until it's given a property
+            // which isn't a layout property.
+            view->setLayoutOnly(viewType == "View");
+#endif
+
+            const ViewId viewId = viewTable.add(std::move(view), std::move(shadowView), &it->second);
+
+            if (bridgeRecorder != nullptr)
+                bridgeRecorder->recordCreateView(getClockTime(), viewId, viewType);
+
+            return viewId;
+        }
+
+        /** Creates a new text view instance and registers it with the view table. */
+        ViewId createTextViewInstance(const juce::String& value)
+        {
+            if (isOnScriptThread())
+            {
+                const ViewId scriptId = nextScriptViewId++;
+                runOnMessageThread([this, value, scriptId]() { mapScriptViewId(scriptId, createTextViewInstance(value)); });
+                return scriptId;
+            }
+
+            recordBridgeCall(PerformanceStats::CreateTextViewCall);
+
+            std::unique_ptr<View> view;
+
+            if (rawTextViewType.pool.empty())
+            {
+                view = std::make_unique<RawTextView>(value);
+            }
+            else
+            {
+                view = std::move(rawTextViewType.pool.back().first);
+                rawTextViewType.pool.pop_back();
+                static_cast<RawTextView*>(view.get())->setText(value);
+            }
+
+            view->setOwningRoot(this);
+
+            const ViewId viewId = viewTable.add(std::move(view), nullptr, &rawTextViewType);
+
+            if (bridgeRecorder != nullptr)
+                bridgeRecorder->recordValue(BridgeRecording::CreateTextView, getClockTime(), viewId, value);
+
+            return viewId;
+        }
+
+        void setViewProperty (ViewId viewId, const juce::Identifier& name, const juce::var& value)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, viewId, name, value]() { setViewProperty(fromScriptViewId(viewId), name, value); });
+
+            recordBridgeCall(PerformanceStats::SetPropertyCall);
+
+            if (bridgeRecorder != nullptr)
+                bridgeRecorder->recordSetProperty(getClockTime(), viewId, name, value);
+
+            const auto& [view, shadow] = getViewHandle(viewId);
+
+            // React resends equal values it has built afresh, such as inline
+            // style objects; those change nothing, so we go no further.
+            if (view->hasPropertyValue(name, value))
+                return;
+
+            if (name == IDs::styleId)
+                return applyStyleSheet(viewId, view, shadow, value);
+
+            const int effect = getPropertyEffect(name);
+            noteInvalidation(viewId, view, name, effect);
+
+            // A new border colour, on a border which already had one, repaints
+            // only the border.
+            const bool borderOnly = name == IDs::borderColor && view->getStyle().hasBorderColour;
+
+            // A span's properties are its text view's to lay out and paint.
+            if (auto* span = viewCast<TextSpanView>(view))
+                return setTextSpanProperties(*span, { { name, value } }, effect);
+
+            applyViewProperty(view, shadow, name, value);
+
+            if (borderOnly && effect == PropertyEffect::AffectsPaint)
+                requestRepaint(viewId, view->getBorderArea());
+            else
+                requestPropertyUpdate(viewId, effect);
+        }
+
+        /** Sets a whole batch of properties on the given view, as on initial mount,
+            performing at most one layout and one repaint for the lot.
+         */
+        void setViewProperties (ViewId viewId, const juce::NamedValueSet& properties)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, viewId, properties]() { setViewProperties(fromScriptViewId(viewId), properties); });
+
+            recordBridgeCall(PerformanceStats::SetPropertiesCall);
+
+            if (bridgeRecorder != nullptr)
+            {
+                auto* object = new juce::DynamicObject();
+                object->getProperties() = properties;
+                bridgeRecorder->recordValue(BridgeRecording::SetProperties, getClockTime(), viewId, juce::var(object));
+            }
+
+            const auto& [view, shadow] = getViewHandle(viewId);
+
+            // Only the values which have changed are applied; on a mount that's
+            // all of them, and the set goes through as it is.
+            juce::NamedValueSet changedOnly;
+            int effect = PropertyEffect::None;
+            int numUnchanged = 0;
+
+            for (const auto& p : properties)
+            {
+                if (view->hasPropertyValue(p.name, p.value))
+                {
+                    ++numUnchanged;
+                }
+                else
+                {
+                    const int propertyEffect = getPropertyEffect(p.name);
+                    noteInvalidation(viewId, view, p.name, propertyEffect);
+                    effect |= propertyEffect;
+                }
+            }
+
+            if (numUnchanged == properties.size())
+                return;
+
+            if (numUnchanged > 0)
+                for (const auto& p : properties)
+                    if (!view->hasPropertyValue(p.name, p.value))
+                        changedOnly.set(p.name, p.value);
+
+            const auto& changed = numUnchanged > 0 ? changedOnly : properties;
+
+            // The sheet goes first, whatever the order, so that the view's own
+            // properties override it.
+            if (const auto* styleId = changed.getVarPointer(IDs::styleId))
+                applyStyleSheet(viewId, view, shadow, *styleId);
+
+            if (auto* span = viewCast<TextSpanView>(view))
+                return setTextSpanProperties(*span, changed, effect);
+
+            for (const auto& p : changed)
+                if (p.name != IDs::styleId)
+                    applyViewProperty(view, shadow, p.name, p.value);
+
+            requestPropertyUpdate(viewId, effect);
+        }
+
+        /** Returns a compact integer id for the given property name, registering
+            the name on first use.
+
+            The JavaScript side asks for the id of each property name once and
+            then sets properties by id, which saves marshalling and interning the
+            name string on every property update.
+         */
+        int getPropertyId (const juce::Identifier& name)
+        {
+            auto it = propertyIdMap.find(name);
+
+            if (it != propertyIdMap.end())
+                return it->second;
+
+            const int propertyId = static_cast<int>(propertyNames.size());
+
+            propertyNames.push_back(name);
+            propertyIdMap[name] = propertyId;
+
+            return propertyId;
+        }
+
+        /** Registers a style sheet, a set of properties which any number of views
+            may then take by setting only its id as their `styleId`, returning the
+            id. Safe to call from any thread.
+
+            The sheet holds its names and values once, for every view which uses
+            it, and what setting them affects is worked out once, here. A view
+            takes the sheet's properties as though they were set one by one, ahead
+            of its own, which override them. A view moved to another sheet keeps
+            the properties the new one doesn't set, just as a property left out
+            of a later render is left as it was.
+
+            The sheet's flex properties are parsed once, into a template node,
+            whose whole Yoga style a fresh node copies as its view takes the
+            sheet. Properties set on the node after that change only its own copy.
+         */
+        int registerStyleSheet (const juce::NamedValueSet& properties)
+        {
+            auto sheet = std::make_shared<StyleSheet>();
+            sheet->properties = properties;
+            sheet->properties.remove(IDs::styleId);
+
+            for (const auto& p : sheet->properties)
+            {
+                sheet->effect |= getPropertyEffect(p.name);
+                sheet->hasLayoutProperties |= ShadowView::isLayoutProperty(p.name);
+            }
+
+            const juce::SpinLock::ScopedLockType sl (styleSheetLock);
+            styleSheets.push_back(std::move(sheet));
+
+            // Ids start at 1, so that no view takes a sheet by default.
+            return static_cast<int>(styleSheets.size());
+        }
+
+        /** Sets a property on the given view, where the property is given by an id
+            previously handed out by `getPropertyId`.
+         */
+        void setViewPropertyById (ViewId viewId, int propertyId, const juce::var& value)
+        {
+            // If you hit this, you're setting a property by an id that was never
+            // registered through getPropertyId.
+            jassert (juce::isPositiveAndBelow(propertyId, static_cast<int>(propertyNames.size())));
+
+            if (juce::isPositiveAndBelow(propertyId, static_cast<int>(propertyNames.size())))
+                setViewProperty(viewId, propertyNames[static_cast<size_t>(propertyId)], value);
+        }
+
+        void setRawTextValue (ViewId viewId, const juce::String& value)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, viewId, value]() { setRawTextValue(fromScriptViewId(viewId), value); });
+
+            recordBridgeCall(PerformanceStats::SetTextCall);
+
+            if (bridgeRecorder != nullptr)
+                bridgeRecorder->recordValue(BridgeRecording::SetText, getClockTime(), viewId, value);
+
+            View* view = getViewHandle(viewId).first;
+
+            if (auto* rawTextView = viewCast<RawTextView>(view))
+            {
+                if (rawTextView->getText() == value)
+                    return;
+
+                // The raw text may be within spans, or not yet in a text view at all.
+                auto* parent = findEnclosingTextView(rawTextView);
+
+                // The old text needs painting over wherever the new text won't be.
+                const auto oldTextArea = parent != nullptr ? parent->getTextArea() : juce::Rectangle<int>();
+
+                // Update text
+                rawTextView->setText(value);
+                noteInvalidation(viewId, rawTextView, IDs::text, PropertyEffect::AffectsLayout | PropertyEffect::AffectsPaint);
+
+                if (parent != nullptr)
+                    textContentChanged(*parent, oldTextArea);
+            }
+        }
+
+        void addChild (ViewId parentId, ViewId childId, int index = -1)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, parentId, childId, index]() { addChild(fromScriptViewId(parentId), fromScriptViewId(childId), index); });
+
+            recordBridgeCall(PerformanceStats::AddChildCall);
+
+            if (bridgeRecorder != nullptr)
+                bridgeRecorder->recordChild(BridgeRecording::AddChild, getClockTime(), parentId, childId, index);
+
+            const auto& [parentView, parentShadowView] = getViewHandle(parentId);
+            const auto& [childView, childShadowView] = getViewHandle(childId);
+
+            noteInvalidation(parentId, parentView, IDs::addChild, PropertyEffect::AffectsLayout);
+
+            if (isTextContainer(parentView))
+            {
+                // If we're trying to append a child to a text view or a span, it will
+                // be raw text or a span with no accompanying shadow view, and we'll
+                // need to mark the enclosing TextShadowView dirty before the
+                // subsequent layout pass.
+                jassert (viewCast<RawTextView>(childView) != nullptr || viewCast<TextSpanView>(childView) != nullptr);
+                jassert (childShadowView == nullptr);
+
+                auto* textView = findEnclosingTextView(parentView);
+                const auto oldTextArea = textView != nullptr ? textView->getTextArea() : juce::Rectangle<int>();
+
+                parentView->addChild(childView, index);
+
+                if (textView != nullptr)
+                    textContentChanged(*textView, oldTextArea);
+            }
+            else
+            {
+                parentShadowView->addChild(childShadowView, index);
+                mountChild(parentView, parentShadowView, childView, childShadowView, index);
+            }
+
+            requestShadowTreeLayout();
+        }
+
+        void removeChild (ViewId parentId, ViewId childId)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, parentId, childId]() { removeChild(fromScriptViewId(parentId), fromScriptViewId(childId)); });
+
+            recordBridgeCall(PerformanceStats::RemoveChildCall);
+
+            if (bridgeRecorder != nullptr)
+                bridgeRecorder->recordChild(BridgeRecording::RemoveChild, getClockTime(), parentId, childId);
+
+            insertAllPendingChildComponents();
+
+            const auto& [parentView, parentShadowView] = getViewHandle(parentId);
+            const auto& [childView, childShadowView] = getViewHandle(childId);
+
+            noteInvalidation(parentId, parentView, IDs::removeChild, PropertyEffect::AffectsLayout);
+
+            auto* textView = isTextContainer(parentView) ? findEnclosingTextView(parentView) : nullptr;
+            const auto oldTextArea = textView != nullptr ? textView->getTextArea() : juce::Rectangle<int>();
+
+            // TODO: Set a View::removeChild method and call into that here. Make
+            // that method virtual so that, e.g., the scroll view can override to
+            // remove the child from its viewport
+            parentView->removeChildComponent(childView);
+
+            // We might be dealing with a text view or a span, in which case we
+            // expect a null shadow view. Note that we detach the shadow view before
+            // destroying anything below.
+            if (parentShadowView && childShadowView)
+                parentShadowView->removeChild(childShadowView);
+            else if (textView != nullptr)
+                textContentChanged(*textView, oldTextArea);
+
+            // Here we have to clear the view table of all children of this view.
+            // React may clear a whole subtree from the interface by removing a
+            // single component at the root of the tree. Because the view table
+            // is flat, if we only remove that root view from the table we leave
+            // all of its children dangling, which confuses subsequent functionality
+            // like `getViewHandle` or `getViewByRefId`. Each table entry holds both
+            // the view and its shadow view, so this clears out both.
+            //
+            // Rather than destroy a large subtree in the middle of a commit, we
+            // bury it, and destroy it once the root is idle. Each buried view
+            // comes off its parent component first: a flattened layout-only
+            // child mounts its descendants straight on a live ancestor, so
+            // detaching the child alone would leave them painted and clickable.
+            std::vector<ViewId> childIds;
+            enumerateChildViewIds(childIds, childView, childShadowView);
+
+            for (auto& id : childIds)
+            {
+                if (auto* entry = viewTable.find(id))
+                {
+                    if (auto* parent = entry->view->getParentComponent())
+                        parent->removeChildComponent(entry->view.get());
+
+                    removeFromRefIdIndex(entry->view.get());
+
+                    // Without a root, a buried view has nowhere to send events.
+                    entry->view->setOwningRoot(nullptr);
+                }
+
+                // JavaScript drops its instances of these at the end of the commit.
+                if (const auto scriptId = toScriptViewId(id))
+                    releasedScriptViewIds.push_back(scriptId);
+
+                pendingRepaints.erase(id);
+                paintProfiler.forgetView(id);
+                forgetScriptViewId(id);
+                buriedViews.push_back(viewTable.release(id));
+            }
+
+            scheduler.scheduleAfter(burialDelayMs);
+            requestShadowTreeLayout();
+
+            if (commitDepth == 0)
+                releaseViewsInScript();
+        }
+
+        /** Moves a child its parent already has to the given index among the
+            parent's children, in the shadow tree and among the mounted
+            components, as when a keyed list is reordered. The child stays
+            attached throughout, so nothing in its subtree is unmounted,
+            re-enumerated or laid out afresh.
+         */
+        void moveChild (ViewId parentId, ViewId childId, int index)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, parentId, childId, index]() { moveChild(fromScriptViewId(parentId), fromScriptViewId(childId), index); });
+
+            recordBridgeCall(PerformanceStats::MoveChildCall);
+
+            if (bridgeRecorder != nullptr)
+                bridgeRecorder->recordChild(BridgeRecording::MoveChild, getClockTime(), parentId, childId, index);
+
+            insertAllPendingChildComponents();
+
+            const auto& [parentView, parentShadowView] = getViewHandle(parentId);
+            const auto& [childView, childShadowView] = getViewHandle(childId);
+
+            if (isTextContainer(parentView))
+            {
+                // Raw text and spans have no shadow views; their order is the
+                // components'.
+                auto* textView = findEnclosingTextView(parentView);
+                const auto oldTextArea = textView != nullptr ? textView->getTextArea() : juce::Rectangle<int>();
+                std::vector<juce::Component*> siblings;
+
+                for (auto* c : parentView->getChildren())
+                    if (c != childView)
+                        siblings.push_back(c);
+
+                moveMountedComponent(*childView, juce::isPositiveAndBelow(index, static_cast<int>(siblings.size())) ? siblings[(size_t) index] : nullptr);
+
+                if (textView != nullptr)
+                    textContentChanged(*textView, oldTextArea);
+            }
+            else
+            {
+                // If you hit this, the child isn't the parent's to move.
+                jassert (childShadowView != nullptr && childShadowView->getParent() == parentShadowView);
+
+                if (childShadowView == nullptr || childShadowView->getParent() != parentShadowView)
+                    return;
+
+                parentShadowView->moveChild(childShadowView, index);
+
+                if (!parentView->isLayoutOnly() && !childView->isLayoutOnly() && !hasLayoutOnlyChildren(*parentShadowView))
+                {
+                    const auto& children = parentShadowView->getChildren();
+                    const auto next = static_cast<size_t>(index) + 1;
+
+                    moveMountedComponent(*childView, next < children.size() ? children[next]->getAssociatedView() : nullptr);
+                }
+                else if (auto* host = findMountingAncestor(parentShadowView))
+                {
+                    requestRemount(host->getAssociatedView()->getViewId());
+                }
+            }
+
+            requestShadowTreeLayout();
+        }
+
+        void enumerateChildViewIds (std::vector<ViewId>& ids, View* v, ShadowView* s)
+        {
+            // The shadow tree has every child, including those a layout-only view
+            // mounts on its ancestor, but for the raw text and spans within a text
+            // view, which have no shadow views. These are then the text view's
+            // only children, and a span's.
+            if (s != nullptr)
+            {
+                for (auto* child : s->getChildren())
+                    enumerateChildViewIds(ids, child->getAssociatedView(), child);
+
+                if (s->getChildren().empty() && v->getNumChildComponents() > 0)
+                    if (shadowViewCast<TextShadowView>(s) != nullptr)
+                        for (auto* child : v->getChildren())
+                            enumerateChildViewIds(ids, static_cast<View*>(child), nullptr);
+            }
+            else if (viewCast<TextSpanView>(v) != nullptr)
+            {
+                for (auto* child : v->getChildren())
+                    enumerateChildViewIds(ids, static_cast<View*>(child), nullptr);
+            }
+
+            ids.push_back(v->getViewId());
+        }
+
+        //==============================================================================
+        /** Returns the number of views in the table, attached or not, but for the
+            root itself.
+         */
+        size_t getNumViews() const { return viewTable.size(); }
+
+        /** Checks the view table against the view and shadow trees, returning a
+            description of the first inconsistency found: every view in the
+            table once, with its own id, its shadow view and this root; every
+            node of the shadow tree, and every raw text view, in the table; each
+            real view mounted within its nearest real ancestor; and the refId
+            index holding only live views under their refIds.
+
+            Walks everything, so it's for tests and stress harnesses rather than
+            for every frame. Call on the engine's thread, between commits.
+         */
+        juce::Result verifyViewTree()
+        {
+            jassert (isOnEngineThread());
+            jassert (scriptThread == nullptr);
+
+            std::set<ViewId> reached;
+            juce::String error;
+
+            const auto fail = [&error](const juce::String& message) {
+                if (error.isEmpty())
+                    error = message;
+            };
+
+            std::function<void(View&)> walkText;
+
+            std::function<void(ShadowView&, bool)> walk = [&](ShadowView& shadow, bool isAttached) {
+                View* view = shadow.getAssociatedView();
+                const ViewId id = view->getViewId();
+
+                if (&shadow != _shadowView.get())
+                {
+                    auto* entry = viewTable.find(id);
+
+                    if (entry == nullptr)
+                        return fail("View " + juce::String(id) + " is in the shadow tree but not in the table");
+
+                    if (entry->view.get() != view || entry->shadowView.get() != &shadow)
+                        return fail("View " + juce::String(id) + " has a table entry for another view");
+
+                    if (!reached.insert(id).second)
+                        return fail("View " + juce::String(id) + " is reached twice");
+
+                    // Once the commit's remounts are done, a real view sits within
+                    // the nearest real view above it.
+                    if (isAttached && pendingRemounts.empty() && !view->isLayoutOnly())
+                        if (auto* host = findMountingAncestor(shadow.getParent()))
+                            if (!host->getAssociatedView()->isParentOf(view))
+                                return fail("View " + juce::String(id) + " isn't mounted within " + juce::String(host->getAssociatedView()->getViewId()));
+                }
+
+                for (auto* child : shadow.getChildren())
+                {
+                    if (child->getParent() != &shadow)
+                        return fail("View " + juce::String(child->getAssociatedView()->getViewId()) + " has the wrong shadow parent");
+
+                    walk(*child, isAttached);
+                }
+
+                // Raw text has no shadow views; it hangs off its text view alone,
+                // or off the spans within it.
+                if (shadow.getChildren().empty() && shadowViewCast<TextShadowView>(&shadow) != nullptr)
+                    walkText(*view);
+            };
+
+            walkText = [&](View& container) {
+                for (auto* child : container.getChildren())
+                {
+                    const ViewId childId = static_cast<View*>(child)->getViewId();
+                    auto* entry = viewTable.find(childId);
+
+                    if (entry == nullptr || entry->view.get() != child || entry->shadowView != nullptr)
+                        return fail("Raw text view " + juce::String(childId) + " isn't in the table as one");
+
+                    if (!reached.insert(childId).second)
+                        return fail("Raw text view " + juce::String(childId) + " is reached twice");
+
+                    if (auto* span = viewCast<TextSpanView>(static_cast<View*>(child)))
+                        walkText(*span);
+                }
+            };
+
+            walk(*_shadowView, true);
+
+            // Views created and not yet added, with any children of their own.
+            viewTable.forEach([&](ViewId id, ViewTable::Entry& entry) {
+                if (entry.view->getViewId() != id)
+                    fail("View " + juce::String(id) + " has the id " + juce::String(entry.view->getViewId()));
+
+                if (entry.view->getOwningRoot() != this)
+                    fail("View " + juce::String(id) + " belongs to another root");
+
+                if (entry.shadowView != nullptr && entry.shadowView->getAssociatedView() != entry.view.get())
+                    fail("View " + juce::String(id) + " has another view's shadow view");
+
+                if (entry.shadowView != nullptr && entry.shadowView->getParent() == nullptr && reached.count(id) == 0)
+                    walk(*entry.shadowView, false);
+
+                // As is a span, with its text.
+                if (entry.shadowView == nullptr && entry.view->getParentComponent() == nullptr)
+                    if (auto* span = viewCast<TextSpanView>(entry.view.get()))
+                        walkText(*span);
+            });
+
+            viewTable.forEach([&](ViewId id, ViewTable::Entry& entry) {
+                // A raw text view or span not yet in a text view is on its own.
+                if (reached.count(id) == 0 && (entry.shadowView != nullptr || entry.view->getParentComponent() != nullptr))
+                    fail("View " + juce::String(id) + " is in the table but not in any tree");
+            });
+
+            for (const auto& [refId, views] : refIdIndex)
+            {
+                for (auto* view : views)
+                {
+                    auto* entry = viewTable.find(view->getViewId());
+
+                    if ((entry == nullptr || entry->view.get() != view) && view != this)
+                        fail("The refId index holds a dead view under " + refId.toString());
+                    else if (view->getRefId() != refId)
+                        fail("The refId index holds view " + juce::String(view->getViewId()) + " under " + refId.toString());
+                }
+            }
+
+            return error.isEmpty() ? juce::Result::ok() : juce::Result::fail(error);
+        }
+
+        /** Destroys views removed from the tree, a short slice at a time, after
+            the rest of the root's scheduled work.
+
+            We don't wait for the root to be entirely idle, since an interface
+            animating every frame never is.
+         */
+        void destroyBuriedViews()
+        {
+            if (buriedViews.empty())
+                return;
+
+            // Children were buried before their parents, so they go first.
+            const double deadline = juce::Time::getMillisecondCounterHiRes() + burialSliceMs;
+
+            while (!buriedViews.empty())
+            {
+                recycleOrDestroy(std::move(buriedViews.front()));
+                buriedViews.pop_front();
+
+                if (juce::Time::getMillisecondCounterHiRes() >= deadline)
+                    break;
+            }
+
+            if (!buriedViews.empty())
+                scheduler.scheduleAfter(burialDelayMs);
+        }
+
+        /** Repaints the root, in an idle frame, while any of its cached images
+            is still drawn at an old display scale. Each repaint renders as many
+            again as the RescaleBudget allows.
+         */
+        void continueRescale()
+        {
+            if (!rescalePending)
+                return;
+
+            rescalePending = false;
+            repaint();
+        }
+
+        /** Returns a pooled view of the given type, or a new one. */
+        static ViewPair takeOrCreateView (ViewType& type)
+        {
+            if (type.pool.empty())
+            {
+                auto pair = type.factory();
+
+                // Only plain Views mount their children as their own components;
+                // a ScrollView, say, mounts them in its viewport. We ask once
+                // here, so that mounting never needs to.
+                pair.first->setMountsChildComponents(typeid(*pair.first) == typeid(View));
+                return pair;
+            }
+
+            auto pair = std::move(type.pool.back());
+            type.pool.pop_back();
+
+            return pair;
+        }
+
+        /** Replaces the engine with a fresh one, ready for a bundle.
+
+            The native views are recycled rather than destroyed: each view whose
+            type recycles goes back to its type's pool, so the next bundle's mount
+            takes views already made, with their images and text caches warm,
+            instead of constructing a tree from scratch. Registered native
+            methods and functions carry over to the new engine.
+         */
+        void resetEngine()
+        {
+            // The next engine starts from scratch on a fresh script thread.
+            const bool hadScriptThread = scriptThread != nullptr;
+            scriptThread.reset();
+            resetScriptThreadState();
+
+            scheduler.cancel();
+            timerQueue.clear();
+            pendingAnimationFrames.clear();
+            pendingIdleCallbacks.clear();
+            nextAnimationFrameTime = -1.0;
+            microtasksPending = false;
+            duk_destroy_heap(ctx);
+            workers.clear();
+            moduleBytecode.clear();
+            resetDispatchCache();
+
+            // Insertions left by a commit the bundle never closed name views
+            // which are about to be pooled or destroyed.
+            pendingInsertions.clear();
+            recycleAllViews();
+            refIdIndex.clear();
+
+            {
+                const juce::SpinLock::ScopedLockType sl (styleSheetLock);
+                styleSheets.clear();
+            }
+
+            commitDepth = 0;
+            layoutPending = false;
+            laidOutRevision = 0;
+            ++asyncLayoutGeneration;
+            asyncLayoutInFlight = false;
+            asyncLayoutPending = false;
+            paneLayoutCache.clear();
+            pendingRepaints.clear();
+            pendingRemounts.clear();
+            pendingMeasureEvents.clear();
+            heldMeasureEvents.clear();
+            pendingLoadEvents.clear();
+            pendingVisibleRangeEvents.clear();
+            pendingValueChangeEvents.clear();
+            pendingNoteChangeEvents.clear();
+            pendingPointerEvents.clear();
+
+            // The next engine's mirrors ask for every note afresh.
+            for (const auto& name : pendingNoteGridDiffs)
+                if (auto* model = getNoteGrid(name))
+                    model->takeDiff();
+
+            pendingNoteGridDiffs.clear();
+            eventsHeldWhileHidden.clear();
+            animations.clear();
+            layoutAnimator.clear();
+            createContext();
+            const ShadowView::ScopedConfig scopedConfig (yogaConfig.config);
+            _shadowView = std::make_unique<ShadowView>(this);
+
+            // The hosts stay, for the next engine's trees to mount into.
+            for (auto& [name, surface] : surfaces)
+                surface.viewId = 0;
+
+            for (auto& [name, overlay] : overlays)
+                overlay.viewId = 0;
+
+            installNativeMethods();
+
+            if (hadScriptThread)
+                startScriptThread();
+        }
+
+        /** Creates the Duktape context, and lets its natives find us. */
+        void createContext()
+        {
+            performanceStats.beginStartup();
+
+            {
+                const PerformanceStats::ScopedStartupPhase startupPhase (&performanceStats, PerformanceStats::HeapCreationPhase);
+                ctx = initializeDuktapeContext(heapAllocator.get(), &heapMeter, consoleLogger);
+            }
+
+            userTimingMarks.clear();
+            userTimingOrigin = { getClockTime(), juce::Time::getHighResolutionTicks() };
+
+            // Push a pointer to this root instance
+            duk_push_global_stash(ctx);
+            duk_push_pointer(ctx, (void *) this);
+            duk_put_prop_string(ctx, -2, "rootInstance");
+            duk_pop(ctx);
+        }
+
+        /** Moves every view into its type's pool, or destroys it if the type
+            doesn't recycle.
+         */
+        void recycleAllViews()
+        {
+            // Unlinking every shadow view from its parent first means no view
+            // can be left holding on to one recycled or destroyed before it.
+            viewTable.forEach([](ViewId, ViewTable::Entry& entry) {
+                if (auto* shadowView = entry.shadowView.get())
+                    if (auto* parentShadowView = shadowView->getParent())
+                        parentShadowView->removeChild(shadowView);
+            });
+
+            std::vector<ViewId> ids;
+            ids.reserve(viewTable.size());
+            viewTable.forEach([&ids](ViewId id, ViewTable::Entry&) { ids.push_back(id); });
+
+            for (auto id : ids)
+                recycleOrDestroy(viewTable.release(id));
+
+            while (!buriedViews.empty())
+            {
+                recycleOrDestroy(std::move(buriedViews.front()));
+                buriedViews.pop_front();
+            }
+
+            removeAllChildren();
+            viewTable.clear();
+        }
+
+        /** Resets a buried view into its type's pool, if the type recycles and
+            the pool has room, or else destroys it.
+         */
+        void recycleOrDestroy (ViewTable::Entry entry)
+        {
+            auto* type = entry.type;
+
+            // The view's children are already gone, but its parent may still be
+            // waiting its turn, and mustn't be left holding this shadow view.
+            if (auto* shadowView = entry.shadowView.get())
+                if (auto* parentShadowView = shadowView->getParent())
+                    parentShadowView->removeChild(shadowView);
+
+            if (type == nullptr || !type->resetter || type->pool.size() >= maxPooledViewsPerType)
+                return;
+
+            if (auto* parentComponent = entry.view->getParentComponent())
+                parentComponent->removeChildComponent(entry.view.get());
+
+            if (entry.shadowView != nullptr)
+                entry.shadowView->resetForReuse();
+
+            entry.view->resetForReuse();
+            type->resetter(*entry.view, entry.shadowView.get());
+
+            type->pool.emplace_back(std::move(entry.view), std::move(entry.shadowView));
+        }
+
+        /** Returns a pointer pair to the view associated to the given id. */
+        std::pair<View*, ShadowView*> getViewHandle (ViewId viewId)
+        {
+            if (viewId == getViewId())
+                return {this, _shadowView.get()};
+
+            if (auto* entry = viewTable.find(viewId))
+                return {entry->view.get(), entry->shadowView.get()};
+
+            // If we land here, you asked for a view that we don't have.
+            jassertfalse;
+            return {nullptr, nullptr};
+        }
+
+        /** Returns the first view with a `refId` whose value equals the provided
+         *  id, or nullptr if there is no such view.
+         */
+        View* getViewByRefId (const juce::Identifier& refId)
+        {
+            if (refId == getRefId())
+                return this;
+
+            auto it = refIdIndex.find(refId);
+
+            if (it != refIdIndex.end() && !it->second.empty())
+                return it->second.front();
+
+            return nullptr;
+        }
+
+        /** Register a native method to be called from the script engine.
+
+            Arguments arrive as they would as view properties, objects, arrays
+            and binary data included. The method runs on the message thread, in
+            order with the commit it was called from, and returns nothing to the
+            caller; see `registerNativeFunction` for a method that can.
+         */
+        void registerNativeMethod(const std::string& name, std::function<void(const juce::var::NativeFunctionArgs&)> fn) {
+            const juce::Identifier methodName (name);
+            const int statsIndex = performanceStats.addNativeMethod(methodName);
+
+            changeMethodRegistry([this, fn = std::move(fn), methodName, statsIndex]() {
+                // Push the function into the registry and hang onto its index
+                size_t fnIndex = methodRegistry.size();
+                methodRegistry.push_back({ fn, methodName, statsIndex });
+
+                installNativeMethod(fnIndex);
+            });
+        }
+
+        /** Register a native function to be called from the script engine, with
+            its argument and return types deduced from the callable.
+
+            Each argument is read straight from the engine by its declared type,
+            and what the function returns is pushed straight back to the caller,
+            with no juce::var in between unless the function takes or returns one:
+            @code
+            root.registerNativeFunction("getParameter", [this](int index) -> double {
+                return processor.getParameters()[index]->getValue();
+            });
+            @endcode
+
+            Numbers, bools, juce::String and std::string, std::vector of these,
+            juce::MemoryBlock for binary data and juce::var for anything else are
+            understood. A BufferView argument reads an ArrayBuffer or typed array
+            in place, for the duration of the call, for the likes of a preset blob
+            or an envelope's points without a copy or a per-element conversion.
+            A call with an argument of the wrong type throws a TypeError in
+            JavaScript.
+
+            Unlike `registerNativeMethod` the function is called synchronously,
+            on the thread running the engine: the script thread, when there is
+            one, so it must not touch the interface there.
+         */
+        template <typename Fn>
+        void registerNativeFunction (const std::string& name, Fn fn)
+        {
+            const juce::Identifier functionName (name);
+            const int statsIndex = performanceStats.addNativeMethod(functionName);
+
+            changeMethodRegistry([this, f = NativeFunction::create(std::move(fn)), functionName, statsIndex]() {
+                // Full native functions carry a 16 bit magic, where a lightfunc's
+                // is 8 bits.
+                jassert (nativeFunctionRegistry.size() < 0x8000);
+
+                const auto fnIndex = nativeFunctionRegistry.size();
+                nativeFunctionRegistry.push_back({ f, functionName, statsIndex });
+
+                installNativeFunction(fnIndex);
+            });
+        }
+
+        /** Register a native method which runs on a thread pool of the root's,
+            off the message thread, and returns a Promise to the caller.
+
+            Arguments arrive as they do for `registerNativeMethod`. What the
+            method returns resolves the Promise, marshalled as a view property
+            value would be, on the thread running the engine, at the root's next
+            update. A method which throws a std::exception rejects the Promise
+            with an Error of the exception's message instead. This is the place
+            for slow host work, such as reading a preset or scanning a folder of
+            samples, which would otherwise hold up the interface:
+            @code
+            root.registerAsyncNativeMethod("readPreset", [](const juce::var::NativeFunctionArgs& args) -> juce::var {
+                return juce::File(args.arguments[0].toString()).loadFileAsString();
+            });
+            @endcode
+
+            The method must be safe to call from any thread, and from several at
+            once. The root waits for calls still running when it's destroyed;
+            calls made before a reload settle nothing in the new engine.
+         */
+        void registerAsyncNativeMethod (const std::string& name, std::function<juce::var(const juce::var::NativeFunctionArgs&)> fn)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            if (asyncMethodPool == nullptr)
+                asyncMethodPool = std::make_unique<juce::ThreadPool>(asyncMethodPoolSize);
+
+            changeMethodRegistry([this, fn = std::move(fn), methodName = juce::Identifier(name)]() {
+                jassert (asyncMethodRegistry.size() < 0x8000);
+
+                const auto fnIndex = asyncMethodRegistry.size();
+                asyncMethodRegistry.push_back({ fn, methodName });
+
+                installAsyncNativeMethod(fnIndex);
+            });
+        }
+
+        /** Dispatches an event to the React internal view registry.
+
+            If the view given by the `viewId` has a handler for the given event, it
+            will be called with the given arguments.
+         */
+        template <typename... T>
+        void dispatchViewEvent (ViewId viewId, const juce::Identifier& eventType, T... args)
+        {
+            dispatchViewEventAlongPath(&viewId, 1, eventType, args...);
+        }
+
+        /** Dispatches an event which propagates through the view hierarchy.
+
+            We walk up from the target, natively, collecting the target and each
+            ancestor with a handler for the event, and hand the whole path to
+            JavaScript in a single call. The JavaScript side then runs the capture
+            handlers from the outermost view inwards, and the bubble handlers from
+            the target outwards, until one of them stops propagation.
+         */
+        template <typename... T>
+        void dispatchBubblingViewEvent (View& target, View::EventFlags event, const juce::Identifier& eventType, T... args)
+        {
+            // Handlers may dispatch events of their own, so each dispatch gets its
+            // own path; the vector just saves reallocating it every time.
+            std::vector<ViewId> path;
+            path.swap(propagationPathStorage);
+            path.clear();
+
+            for (auto* c = static_cast<juce::Component*>(&target); c != nullptr; c = c->getParentComponent())
+            {
+                if (auto* v = dynamic_cast<View*>(c))
+                    if (v == &target || v->hasEventHandler(event) || v->hasCaptureHandler(event))
+                        path.push_back(v->getViewId());
+
+                if (c == this)
+                    break;
+            }
+
+            dispatchViewEventAlongPath(path.data(), path.size(), eventType, args...);
+            path.swap(propagationPathStorage);
+        }
+
+        /** Dispatches an event to the React internal view registry along the given
+            propagation path, target first.
+         */
+        template <typename... T>
+        void dispatchViewEventAlongPath (const ViewId* path, size_t pathLength, const juce::Identifier& eventType, T... args)
+        {
+            if (bridgeRecorder != nullptr && !isOnScriptThread())
+            {
+                const std::array<juce::var, sizeof...(args)> values { { toRecordedValue(args)... } };
+                bridgeRecorder->recordViewEvent(getClockTime(), path, pathLength, eventType, values.data(), (int) values.size());
+            }
+
+            if (scriptThread != nullptr && !isOnScriptThread())
+            {
+                std::vector<ViewId> scriptPath;
+                scriptPath.reserve(pathLength);
+
+                for (size_t i = 0; i < pathLength; ++i)
+                    scriptPath.push_back(toScriptViewId(path[i]));
+
+                // The input goes with the event, and comes back with the commit.
+                const auto inputId = performanceStats.getLatestInputId();
+
+                return callIntoScript([this, scriptPath = std::move(scriptPath), eventType, inputId, args...]() {
+                    scriptSeenInputId = juce::jmax(scriptSeenInputId, inputId);
+                    dispatchViewEventAlongPath(scriptPath.data(), scriptPath.size(), eventType, args...);
+                });
+            }
+
+            jassert (isOnEngineThread());
+
+            if (!isOnScriptThread())
+                seenInputId = performanceStats.getLatestInputId();
+
+            BLUEPRINT_TRACE_SCOPE("dispatchViewEvent", pathLength > 0 ? path[0] : -1, eventType);
+
+            if (!pushDispatchFunction(dispatchViewEventFn, "dispatchViewEvent"))
+                return;
+
+            // Now fill in the event's record, whose arguments array is left on
+            // the stack above it.
+            duk_require_stack(ctx, 4);
+            const duk_idx_t recordIdx = pushViewEventRecord(eventType, path, pathLength);
+            duk_get_prop_literal(ctx, recordIdx, "args");
+
+            duk_uarridx_t numArgs = 0;
+            ((pushArgToDukStack(args), duk_put_prop_index(ctx, -2, numArgs++)), ...);
+            setArrayLength(-1, numArgs);
+            duk_pop(ctx);
+
+            callViewEventDispatch();
+            runMicrotasks();
+        }
+
+        /** Dispatches an event through the JavaScript EventBridge. */
+        template <typename... T>
+        void dispatchEvent (const juce::Identifier& eventType, T... args)
+        {
+            // While we're hidden, only the latest event of each type waits for us
+            // to show again.
+            if (!isOnScriptThread() && scheduler.isPaused())
+                return holdEventWhileHidden(eventType, [this, eventType, args...]() { dispatchEvent(eventType, args...); });
+
+            if (bridgeRecorder != nullptr && !isOnScriptThread())
+            {
+                const std::array<juce::var, sizeof...(args)> values { { toRecordedValue(args)... } };
+                bridgeRecorder->recordCall(BridgeRecording::Event, getClockTime(), eventType, values.data(), (int) values.size());
+            }
+
+            if (scriptThread != nullptr && !isOnScriptThread())
+                return callIntoScript([this, eventType, args...]() { dispatchEvent(eventType, args...); });
+
+            jassert (isOnEngineThread());
+            BLUEPRINT_TRACE_SCOPE("dispatchEvent", -1, eventType);
+
+            if (!pushDispatchFunction(dispatchEventFn, "dispatchEvent"))
+                return;
+
+            // Now push the arguments
+            constexpr int numArgs = 1 + static_cast<int>(sizeof...(args));
+            duk_require_stack(ctx, numArgs);
+            pushEventType(eventType);
+            (pushArgToDukStack(args), ...);
+
+            // Then issue the call and clear the stack
+            {
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::EventCall);
+
+                if (duk_pcall(ctx, numArgs) != DUK_EXEC_SUCCESS)
+                    logCallError();
+
+                duk_pop(ctx);
+            }
+
+            runMicrotasks();
+        }
+
+        //==============================================================================
+        /** Registers an event type which realtime code may dispatch through
+            `dispatchRealtimeEvent`, returning the id to dispatch it by.
+
+            Call this on the message thread, before anything dispatches the type.
+            The optional formatter turns each event into its JavaScript arguments,
+            for instance to replace a parameter index with the parameter's id.
+         */
+        int registerRealtimeEventType (const juce::Identifier& eventType, RealtimeEventFormatter formatter = nullptr)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            realtimeEventTypes.push_back({ eventType, std::move(formatter) });
+            realtimeEventWatcher.watch();
+
+            return static_cast<int>(realtimeEventTypes.size()) - 1;
+        }
+
+        /** Stops delivering a realtime event type, e.g. once whatever dispatched
+            it has gone. Events of the type still queued, or dispatched later, are
+            dropped. Once the root has no realtime or coalesced event types left,
+            it stops checking for them at the frame rate.
+
+            Call this on the message thread. The id isn't reused.
+         */
+        void unregisterRealtimeEventType (int eventTypeId)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            if (!juce::isPositiveAndBelow(eventTypeId, static_cast<int>(realtimeEventTypes.size())))
+                return;
+
+            auto& type = realtimeEventTypes[static_cast<size_t>(eventTypeId)];
+
+            if (type.name.isNull())
+                return;
+
+            type = {};
+            realtimeEventWatcher.unwatch();
+        }
+
+        /** Queues an event for JavaScript from any thread, including the audio thread.
+
+            This never locks, allocates or posts a message. Queued events are
+            delivered in order at the next display frame, all of them in a single
+            call into the script engine, where the EventBridge emits each in turn.
+            Returns false if the queue is full, in which case the event is dropped.
+         */
+        bool dispatchRealtimeEvent (int eventTypeId, std::initializer_list<double> args)
+        {
+            // If you hit this, you're passing more numbers than an event can hold.
+            jassert (args.size() <= static_cast<size_t>(RealtimeEvent::maxArgs));
+
+            RealtimeEvent e;
+            e.type = eventTypeId;
+
+            for (auto v : args)
+                if (e.numArgs < RealtimeEvent::maxArgs)
+                    e.args[e.numArgs++] = v;
+
+            return dispatchRealtimeEvent(e);
+        }
+
+        bool dispatchRealtimeEvent (const RealtimeEvent& e)
+        {
+            if (!realtimeEvents.push(e))
+                return false;
+
+            realtimeEventsPending.store(true, std::memory_order_release);
+            return true;
+        }
+
+        /** Registers a coalesced event type for keys in the range [0, numKeys),
+            returning the channel through which to set the keys' values.
+
+            Any thread may set a key's value on the returned channel, as often as it
+            likes. Once a frame, the keys changed since the last frame go out to
+            JavaScript as a single event whose one argument is an array with an
+            entry for each of those keys, holding only its latest value. Entries are
+            [key, value] pairs, unless the optional formatter makes them otherwise.
+
+            Given a throttle window, each key goes out at most once per window: the
+            first change of a burst at the next frame, and the final value once the
+            window has passed, for which the root wakes itself as needed.
+
+            Call this on the message thread. The channel lives as long as the root.
+         */
+        CoalescedEventChannel& registerCoalescedEventType (const juce::Identifier& eventType, int numKeys,
+                                                           CoalescedEventFormatter formatter = nullptr,
+                                                           double throttleWindowMs = 0.0)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            coalescedEventChannels.push_back({
+                std::make_unique<CoalescedEventChannel>(eventType, numKeys, realtimeEventsPending, throttleWindowMs),
+                std::move(formatter)
+            });
+
+            realtimeEventWatcher.watch();
+            return *coalescedEventChannels.back().channel;
+        }
+
+        /** Stops delivering a coalesced event type, as `unregisterRealtimeEventType`
+            does a realtime one. The channel lives on with the root, so that code
+            still holding it may go on setting values, but they're discarded.
+
+            Call this on the message thread.
+         */
+        void unregisterCoalescedEventType (CoalescedEventChannel& channel)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            for (auto& c : coalescedEventChannels)
+            {
+                if (c.channel.get() == &channel && c.isWatched)
+                {
+                    c.isWatched = false;
+                    c.formatter = nullptr;
+                    realtimeEventWatcher.unwatch();
+                }
+            }
+        }
+
+        /** Returns the channel registered for the given event type, or nullptr if
+            there's none, e.g. for an editor taking over a parked root.
+         */
+        CoalescedEventChannel* getCoalescedEventChannel (const juce::Identifier& eventType)
+        {
+            for (auto& c : coalescedEventChannels)
+                if (c.isWatched && c.channel->getEventType() == eventType)
+                    return c.channel.get();
+
+            return nullptr;
+        }
+
+        /** Dispatches every queued realtime event and coalesced change in a single
+            call to JavaScript.
+         */
+        void flushRealtimeEvents()
+        {
+            jassert (isOnEngineThread());
+
+            const double now = getClockTime();
+            const bool throttledValuesDue = (throttledEventDeadline >= 0.0 && now >= throttledEventDeadline);
+
+            if (!realtimeEventsPending.exchange(false, std::memory_order_acquire) && !throttledValuesDue)
+                return;
+
+            if (const auto numDropped = realtimeEvents.getAndResetNumDropped())
+                DBG("Dropped " << (int) numDropped << " realtime events; the queue was full.");
+
+            // Each event goes into the batch as [type, ...args].
+            const duk_idx_t batchIdx = duk_push_array(ctx);
+            duk_uarridx_t numEvents = 0;
+
+            // We stop at a queue's worth, so that a producer pushing as fast as we
+            // pop can't keep us here; the rest go out with the next frame.
+            RealtimeEvent e;
+            juce::Array<juce::var> args;
+
+            for (size_t i = 0; i < realtimeEvents.getCapacity() && realtimeEvents.pop(e); ++i)
+            {
+                if (!juce::isPositiveAndBelow(e.type, static_cast<int>(realtimeEventTypes.size())))
+                {
+                    // An event type which was never registered.
+                    jassertfalse;
+                    continue;
+                }
+
+                const auto& type = realtimeEventTypes[static_cast<size_t>(e.type)];
+
+                // An event type since unregistered.
+                if (type.name.isNull())
+                    continue;
+
+                const duk_idx_t eventIdx = duk_push_array(ctx);
+                duk_uarridx_t numValues = 0;
+
+                pushEventType(type.name);
+                duk_put_prop_index(ctx, eventIdx, numValues++);
+
+                if (type.formatter != nullptr)
+                {
+                    args.clearQuick();
+                    type.formatter(e, args);
+
+                    for (const auto& v : args)
+                    {
+                        pushVarToDukStack(v);
+                        duk_put_prop_index(ctx, eventIdx, numValues++);
+                    }
+                }
+                else
+                {
+                    for (int j = 0; j < e.numArgs; ++j)
+                    {
+                        duk_push_number(ctx, e.args[j]);
+                        duk_put_prop_index(ctx, eventIdx, numValues++);
+                    }
+                }
+
+                duk_put_prop_index(ctx, batchIdx, numEvents++);
+            }
+
+            // Then one event per coalesced channel with changes, as [type, changes].
+            throttledEventDeadline = -1.0;
+
+            for (auto& c : coalescedEventChannels)
+            {
+                // An unregistered channel's changes are only cleared away.
+                if (!c.isWatched)
+                {
+                    c.channel->drain(now, [](int, double) {});
+                    continue;
+                }
+
+                duk_push_array(ctx);
+                const duk_idx_t changesIdx = duk_push_array(ctx);
+                duk_uarridx_t numChanges = 0;
+
+                const double deadline = c.channel->drain(now, [&](int key, double value) {
+                    if (c.formatter != nullptr)
+                    {
+                        pushVarToDukStack(c.formatter(key, value));
+                    }
+                    else
+                    {
+                        duk_push_array(ctx);
+                        duk_push_int(ctx, key);
+                        duk_put_prop_index(ctx, -2, 0);
+                        duk_push_number(ctx, value);
+                        duk_put_prop_index(ctx, -2, 1);
+                    }
+
+                    duk_put_prop_index(ctx, changesIdx, numChanges++);
+                });
+
+                if (deadline >= 0.0 && (throttledEventDeadline < 0.0 || deadline < throttledEventDeadline))
+                    throttledEventDeadline = deadline;
+
+                if (numChanges == 0)
+                {
+                    duk_pop_2(ctx);
+                    continue;
+                }
+
+                duk_put_prop_index(ctx, changesIdx - 1, 1);
+                pushEventType(c.channel->getEventType());
+                duk_put_prop_index(ctx, -2, 0);
+                duk_put_prop_index(ctx, batchIdx, numEvents++);
+            }
+
+            if (numEvents > 0)
+                dispatchEventBatch(batchIdx);
+
+            duk_pop(ctx);
+            runMicrotasks();
+
+            // Anything we left behind waits for the next frame, and throttled
+            // values for their window to pass.
+            const bool morePending = realtimeEventsPending.load(std::memory_order_acquire);
+            const double deadline = throttledEventDeadline;
+
+            if (morePending || deadline >= 0.0)
+            {
+                runOnMessageThread([this, morePending, deadline]() {
+                    if (morePending)
+                        scheduler.scheduleFrame();
+
+                    if (deadline >= 0.0)
+                        scheduler.scheduleAfter(deadline - getClockTime());
+                });
+            }
+        }
+
+        //==============================================================================
+        /** Creates a value channel of the given size, which JavaScript reads as a
+            Float32Array from `__BlueprintNative__.getValueChannel(name)`.
+
+            Call this on the message thread. The channel lives as long as the root.
+         */
+        ValueChannel& registerValueChannel (const juce::String& name, int numValues)
+        {
+            ownedValueChannels.push_back(std::make_unique<ValueChannel>(numValues));
+            registerValueChannel(name, *ownedValueChannels.back());
+
+            return *ownedValueChannels.back();
+        }
+
+        /** Exposes a value channel owned elsewhere, e.g. by the audio processor, to
+            JavaScript under the given name. The channel must outlive the root.
+         */
+        void registerValueChannel (const juce::String& name, ValueChannel& channel)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            // If you hit this, there's already a channel by that name.
+            jassert (valueChannels.find(name) == valueChannels.end());
+
+            valueChannels[name] = &channel;
+        }
+
+        /** Returns the named value channel, or nullptr if there's no such channel. */
+        ValueChannel* getValueChannel (const juce::String& name)
+        {
+            auto it = valueChannels.find(name);
+            return it != valueChannels.end() ? it->second : nullptr;
+        }
+
+        /** Refreshes what JavaScript sees of every value channel. */
+        void updateValueChannels()
+        {
+            for (auto& [name, channel] : valueChannels)
+                channel->updateSnapshot();
+        }
+
+        /** Exposes a sample buffer, e.g. written by the audio processor, to Scope
+            views under the given name. The buffer must outlive the root.
+         */
+        void registerSampleBuffer (const juce::String& name, SampleRingBuffer& buffer)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            // If you hit this, there's already a buffer by that name.
+            jassert (sampleBuffers.find(name) == sampleBuffers.end());
+
+            sampleBuffers[name] = &buffer;
+        }
+
+        /** Returns the named sample buffer, or nullptr if there's no such buffer. */
+        SampleRingBuffer* getSampleBuffer (const juce::String& name)
+        {
+            auto it = sampleBuffers.find(name);
+            return it != sampleBuffers.end() ? it->second : nullptr;
+        }
+
+        /** Exposes a list model, e.g. of the processor's presets, to JavaScript
+            through `getListModel(name)`, which queries it and reads slices of its
+            results. JavaScript hears of new results in a `listModelChange` event
+            with the model's name.
+
+            The model must outlive the root, and tells only the root which
+            registered it last of its results.
+         */
+        void registerListModel (const juce::String& name, ListModel& model)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            // If you hit this, there's already a model by that name.
+            jassert (listModels.find(name) == listModels.end());
+
+            listModels[name] = &model;
+
+            juce::Component::SafePointer<ReactApplicationRoot> safeThis (this);
+
+            model.setResultsCallback([safeThis, name]() {
+                if (safeThis != nullptr)
+                    safeThis->dispatchEvent(IDs::listModelChange, name);
+            });
+
+            if (!listModelFunctionsRegistered)
+                registerListModelFunctions();
+        }
+
+        /** Returns the named list model, or nullptr if there's no such model. */
+        ListModel* getListModel (const juce::String& name)
+        {
+            auto it = listModels.find(name);
+            return it != listModels.end() ? it->second : nullptr;
+        }
+
+        /** Exposes a note grid model, e.g. of the processor's clip, to
+            NoteGridViews naming it as their `model`, and to JavaScript through
+            `getNoteGrid(name)`, which edits it and mirrors its notes. The model's
+            edits go to JavaScript as a diff once a frame, in a `noteGridChange`
+            event with the model's name.
+
+            The model must outlive the root, and sends its diffs only to the root
+            which registered it last.
+         */
+        void registerNoteGrid (const juce::String& name, NoteGridModel& model)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            // If you hit this, there's already a model by that name.
+            jassert (noteGrids.find(name) == noteGrids.end());
+
+            noteGrids[name] = &model;
+
+            juce::Component::SafePointer<ReactApplicationRoot> safeThis (this);
+
+            model.setDiffCallback([safeThis, name]() {
+                if (safeThis != nullptr)
+                {
+                    safeThis->pendingNoteGridDiffs.insert(name);
+                    safeThis->triggerAsyncUpdate();
+                }
+            });
+
+            if (!noteGridFunctionsRegistered)
+                registerNoteGridFunctions();
+        }
+
+        /** Returns the named note grid model, or nullptr if there's no such model. */
+        NoteGridModel* getNoteGrid (const juce::String& name)
+        {
+            auto it = noteGrids.find(name);
+            return it != noteGrids.end() ? it->second : nullptr;
+        }
+
+        //==============================================================================
+        /** Starts a ScriptWorker running the bundle at the given path, relative to
+            the module directory, returning its id, or 0 if there's no such file.
+            Call this on the engine's thread, as JavaScript's `new Worker(path)` does.
+
+            What the worker posts arrives in `workerMessage` events, and its
+            uncaught errors in `workerError` events, each with the worker's id.
+            Workers stop with the engine.
+         */
+        int createWorker (const juce::String& path)
+        {
+            jassert (isOnEngineThread());
+
+            const auto file = getModuleDirectory().getChildFile(path);
+
+            if (!file.existsAsFile())
+                return 0;
+
+            const int id = nextWorkerId++;
+            juce::Component::SafePointer<ReactApplicationRoot> safeThis (this);
+
+            // Both arrive on the worker's thread, and go on to the engine by way of
+            // the message thread.
+            auto onMessage = [safeThis, id](ScriptWorker::Message message) {
+                juce::MessageManager::callAsync([safeThis, id, message = std::move(message)]() {
+                    if (safeThis != nullptr)
+                        safeThis->dispatchEvent(IDs::workerMessage, id, message);
+                });
+            };
+
+            auto onError = [safeThis, id](juce::String error) {
+                juce::MessageManager::callAsync([safeThis, id, error]() {
+                    if (safeThis != nullptr)
+                        safeThis->dispatchEvent(IDs::workerError, id, error);
+                });
+            };
+
+            workers[id] = std::make_unique<ScriptWorker>(file.loadFileAsString(), file.getFullPathName(),
+                                                         std::move(onMessage), std::move(onError));
+            return id;
+        }
+
+        /** Sends a message to the worker's `onmessage`, if it's still running. */
+        void postWorkerMessage (int id, ScriptWorker::Message message)
+        {
+            jassert (isOnEngineThread());
+
+            auto it = workers.find(id);
+
+            if (it != workers.end())
+                it->second->postMessage(std::move(message));
+        }
+
+        /** Stops a worker, aborting whatever it's running. */
+        void terminateWorker (int id)
+        {
+            jassert (isOnEngineThread());
+            workers.erase(id);
+        }
+
+        //==============================================================================
+        /** Registers a named source which views can bind their properties to from
+            JavaScript, with a `propertyBindings` prop mapping property names to
+            source names, e.g. `{'transform-rotate': 'gainKnob'}`.
+
+            The optional mapping turns source values into property values; without
+            one, the source value is used as is.
+         */
+        void registerBindingSource (const juce::String& name, PropertyBinding::Source source,
+                                    PropertyBinding::Mapping mapping = nullptr)
+        {
+            bindingSources[name] = { std::move(source), std::move(mapping) };
+        }
+
+        /** Registers a native value which views can drive by name, such as a
+            plugin parameter for a Slider's `parameter-id`.
+         */
+        void registerParameterTarget (const juce::String& name, ParameterTarget target)
+        {
+            auto& slot = parameterTargets[name];
+            slot = std::move(target);
+
+            if (parameterTargetIndices.count(name) == 0)
+            {
+                parameterTargetIndices[name] = (int) parameterWrites.size();
+                parameterWrites.push_back({ &slot });
+            }
+        }
+
+        /** Returns the index of the target registered under the given name, for
+            setParameterValues, or -1 if there's none. A target keeps its index
+            for as long as the root lives, even if registered again.
+
+            JavaScript looks targets up with `__BlueprintNative__.getParameterIndex`.
+         */
+        int getParameterTargetIndex (const juce::String& name) const
+        {
+            auto it = parameterTargetIndices.find(name);
+            return it != parameterTargetIndices.end() ? it->second : -1;
+        }
+
+        /** Where a batch of parameter writes falls in a gesture. */
+        enum class ParameterGesture
+        {
+            none,
+
+            /** The first writes of a gesture, e.g. a drag: each target not
+                already in one begins a gesture before its value is written.
+             */
+            begin,
+
+            /** The last: after these, and any still coalescing, are written,
+                every target in a gesture ends it.
+             */
+            end
+        };
+
+        /** Writes a batch of parameter targets, each given by index with its
+            normalised value, as JavaScript does with one call to
+            `__BlueprintNative__.setParameterValues`, for a macro control moving
+            many parameters at once.
+
+            Writes coalesce: each target takes only the latest of the values it's
+            given before the next frame, when they're written, so that a host sees
+            at most one change per target per frame, however fast the mouse moves.
+            Beginning a gesture is never delayed, and ending one writes what's
+            pending first. The targets belong to the message thread, so writes
+            from the script thread go over with its commit.
+         */
+        void setParameterValues (const std::vector<std::pair<int, double>>& values, ParameterGesture gesture)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, values, gesture]() { setParameterValues(values, gesture); });
+
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            for (const auto& v : values)
+            {
+                if (!juce::isPositiveAndBelow(v.first, (int) parameterWrites.size()))
+                    continue;
+
+                auto& write = parameterWrites[static_cast<size_t>(v.first)];
+
+                if (gesture == ParameterGesture::begin && !write.inGesture)
+                {
+                    write.inGesture = true;
+
+                    if (write.target->beginGesture)
+                        write.target->beginGesture();
+                }
+
+                write.value = v.second;
+
+                if (!write.pending)
+                {
+                    write.pending = true;
+                    pendingParameterWrites.push_back(v.first);
+                }
+            }
+
+            if (gesture != ParameterGesture::end)
+                return scheduler.scheduleFrame();
+
+            flushParameterWrites();
+
+            for (auto& write : parameterWrites)
+            {
+                if (write.inGesture)
+                {
+                    write.inGesture = false;
+
+                    if (write.target->endGesture)
+                        write.target->endGesture();
+                }
+            }
+        }
+
+        /** Returns the target registered under the given name, or nullptr. */
+        const ParameterTarget* getParameterTarget (const juce::String& name) const
+        {
+            auto it = parameterTargets.find(name);
+            return it != parameterTargets.end() ? &it->second : nullptr;
+        }
+
+        /** Binds a property of the view with the given refId to a native source.
+
+            Once a frame, whenever the source value has moved, the view's property
+            is set to the mapped value, natively, with whatever layout and repaint
+            the property needs and without entering the script engine. The binding
+            follows the refId, so it applies to whichever view holds it.
+         */
+        void bindProperty (const juce::Identifier& viewRefId, const juce::Identifier& property,
+                           PropertyBinding::Source source, PropertyBinding::Mapping mapping = nullptr)
+        {
+            unbindProperty(viewRefId, property);
+            propertyBindings.push_back({ viewRefId, 0, property, std::move(source), std::move(mapping) });
+            scheduler.scheduleFrame();
+        }
+
+        /** Removes a binding made with `bindProperty`. */
+        void unbindProperty (const juce::Identifier& viewRefId, const juce::Identifier& property)
+        {
+            propertyBindings.erase(std::remove_if(propertyBindings.begin(), propertyBindings.end(), [&](const ActiveBinding& b) {
+                return b.refId == viewRefId && b.property == property;
+            }), propertyBindings.end());
+        }
+
+        /** Applies every bound property whose source has moved since the last frame. */
+        void updatePropertyBindings()
+        {
+            if (propertyBindings.empty())
+                return;
+
+            // Bound sources may read value channels, which are then as of now,
+            // unless the script thread is the one reading them.
+            if (scriptThread == nullptr)
+                updateValueChannels();
+
+            beginCommit();
+
+            for (auto it = propertyBindings.begin(); it != propertyBindings.end();)
+            {
+                auto& b = *it;
+                ViewId viewId = b.viewId;
+
+                if (b.refId.isValid())
+                {
+                    auto* view = getViewByRefId(b.refId);
+
+                    // Nothing holds the refId just now, but something may later.
+                    if (view == nullptr)
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    // A different view having taken the refId needs the value too.
+                    if (view->getViewId() != b.lastViewId)
+                        b.hasValue = false;
+
+                    viewId = view->getViewId();
+                }
+                else if (viewId != getViewId() && viewTable.find(viewId) == nullptr)
+                {
+                    // The view which declared the binding has gone.
+                    it = propertyBindings.erase(it);
+                    continue;
+                }
+
+                const double value = b.source();
+
+                if (!b.hasValue || value != b.lastValue)
+                {
+                    b.hasValue = true;
+                    b.lastValue = value;
+                    b.lastViewId = viewId;
+
+                    setViewProperty(viewId, b.property, b.mapping != nullptr ? b.mapping(value) : juce::var(value));
+                }
+
+                ++it;
+            }
+
+            endCommit();
+
+            // Sources give no notice of changes, so we look again next frame.
+            if (!propertyBindings.empty())
+                scheduler.scheduleFrame();
+        }
+
+        //==============================================================================
+        /** Starts animating a property of the given view natively, returning the
+            animation's id.
+
+            The config object gives the curve `type` ('timing', 'spring' or
+            'decay'), its parameters (see AnimatedValue), the target value `to` and
+            optionally the starting value `from`, which is otherwise the property's
+            current value. Colour properties animate between colours given as
+            strings, as they're set. Each frame the root advances the animation and
+            sets the property, so a view is only repainted as its property needs,
+            and an animation needs nothing of the script engine until it ends, at
+            which point an `animationEnd` event goes out with its id.
+
+            Starting an animation of a property which is already animating stops
+            the earlier animation where it is.
+         */
+        int startAnimation (ViewId viewId, const juce::Identifier& property, const juce::var& config, int animationId = 0)
+        {
+            // The script thread numbers its animations itself, so that it has the
+            // id before the animation starts.
+            if (isOnScriptThread())
+            {
+                const int id = nextAnimationId++;
+                runOnMessageThread([this, viewId, property, config, id]() { startAnimation(fromScriptViewId(viewId), property, config, id); });
+                return id;
+            }
+
+            recordBridgeCall(PerformanceStats::StartAnimationCall);
+
+            auto* view = getViewHandle(viewId).first;
+
+            if (view == nullptr)
+                return 0;
+
+            stopAnimations(viewId, property);
+
+            const bool isColour = (property == IDs::backgroundColor
+                                   || property == IDs::borderColor
+                                   || property == IDs::color);
+
+            const auto animationConfig = AnimatedValue::parseConfig(config);
+            auto animation = std::make_unique<RunningAnimation>(viewId, property,
+                isColour ? AnimatedValue(0.0, 1.0, animationConfig)
+                         : AnimatedValue(config.getProperty("from", getAnimatableValue(*view, property)),
+                                         config.getProperty("to", 0.0),
+                                         animationConfig));
+
+            if (isColour)
+            {
+                // Colours animate by the fraction of the way from one to the other.
+                animation->isColour = true;
+                animation->toColour = parseColourValue(config.getProperty("to", ""));
+                animation->fromColour = config.hasProperty("from")
+                    ? parseColourValue(config.getProperty("from", ""))
+                    : getAnimatableColour(*view, property);
+            }
+
+            animation->id = animationId > 0 ? animationId : nextAnimationId++;
+            animation->startTime = getClockTime();
+
+            const int id = animation->id;
+            animations.push_back(std::move(animation));
+            scheduler.scheduleFrame();
+
+            return id;
+        }
+
+        /** Stops an animation where it is. Its `animationEnd` event is not sent. */
+        void stopAnimation (int animationId)
+        {
+            if (isOnScriptThread())
+                return runOnMessageThread([this, animationId]() { stopAnimation(animationId); });
+
+            recordBridgeCall(PerformanceStats::StopAnimationCall);
+
+            animations.erase(std::remove_if(animations.begin(), animations.end(), [=](const auto& a) {
+                return a->id == animationId;
+            }), animations.end());
+        }
+
+        /** Advances every running animation to the current time. */
+        void runAnimations()
+        {
+            if (animations.empty())
+                return;
+
+            const double now = getClockTime();
+            std::vector<int> finished;
+
+            beginCommit();
+
+            for (auto it = animations.begin(); it != animations.end();)
+            {
+                auto& a = **it;
+
+                if (a.viewId != getViewId() && viewTable.find(a.viewId) == nullptr)
+                {
+                    // The view has gone, and its animations with it.
+                    it = animations.erase(it);
+                    continue;
+                }
+
+                const double value = a.value.advance(now - a.startTime);
+
+                // Colours go as packed ARGB, which the view reads without parsing.
+                if (a.isColour)
+                    setViewProperty(a.viewId, a.property, (juce::int64) a.fromColour.interpolatedWith(a.toColour, (float) juce::jlimit(0.0, 1.0, value)).getARGB());
+                else
+                    setViewProperty(a.viewId, a.property, value);
+
+                if (a.value.isFinished())
+                {
+                    finished.push_back(a.id);
+                    it = animations.erase(it);
+                    continue;
+                }
+
+                ++it;
+            }
+
+            endCommit();
+
+            if (!animations.empty())
+                scheduler.scheduleFrame();
+
+            for (auto id : finished)
+                dispatchEvent(IDs::animationEnd, id);
+        }
+
+        /** Moves every view in a layout transition on to its bounds for this frame. */
+        void runLayoutTransitions()
+        {
+            if (!layoutAnimator.isAnimating())
+                return;
+
+            layoutAnimator.advance(getClockTime(), [this](ViewId viewId) -> View* {
+                if (viewId == getViewId())
+                    return this;
+
+                auto* entry = viewTable.find(viewId);
+                return entry != nullptr ? entry->view.get() : nullptr;
+            });
+
+            if (layoutAnimator.isAnimating())
+                scheduler.scheduleFrame();
+        }
+
+        //==============================================================================
+        /** Returns an event argument as a BridgeRecorder records it. */
+        template <typename V>
+        static juce::var toRecordedValue (const V& v)
+        {
+            if constexpr (std::is_constructible<juce::var, const V&>::value)
+                return juce::var(v);
+            else
+                return {};
+        }
+
+        /** Dispatches a recorded event, on replay, as it was first dispatched. */
+        void dispatchRecordedEvent (const BridgeRecording::Record& r)
+        {
+            jassert (isOnEngineThread());
+
+            if (r.type == BridgeRecording::ViewEvent)
+            {
+                if (!pushDispatchFunction(dispatchViewEventFn, "dispatchViewEvent"))
+                    return;
+
+                duk_require_stack(ctx, 4);
+                const duk_idx_t recordIdx = pushViewEventRecord(r.name, r.path.data(), r.path.size());
+                duk_get_prop_literal(ctx, recordIdx, "args");
+
+                for (int i = 0; i < r.args.size(); ++i)
+                {
+                    pushVarToDukStack(r.args.getReference(i));
+                    duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i));
+                }
+
+                setArrayLength(-1, static_cast<duk_uarridx_t>(r.args.size()));
+                duk_pop(ctx);
+
+                callViewEventDispatch();
+                runMicrotasks();
+                return;
+            }
+
+            if (!pushDispatchFunction(dispatchEventFn, "dispatchEvent"))
+                return;
+
+            const int numArgs = 1 + r.args.size();
+            duk_require_stack(ctx, numArgs);
+
+            pushEventType(r.name);
+
+            for (const auto& arg : r.args)
+                pushVarToDukStack(arg);
+
+            {
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::EventCall);
+
+                if (duk_pcall(ctx, numArgs) != DUK_EXEC_SUCCESS)
+                    logCallError();
+
+                duk_pop(ctx);
+            }
+
+            runMicrotasks();
+        }
+
+        /** Calls the native method a record names, on replay, returning false if
+            there's no such method.
+         */
+        bool callRecordedNativeMethod (const BridgeRecording::Record& r)
+        {
+            for (auto& method : methodRegistry)
+            {
+                if (method.name != r.name)
+                    continue;
+
+                const PerformanceStats::ScopedNativeMethodCall timer (performanceStats, method.statsIndex);
+                method.fn(juce::var::NativeFunctionArgs(juce::var(), r.args.begin(), r.args.size()));
+
+                return true;
+            }
+
+            return false;
+        }
+
+        //==============================================================================
+        /** Pushes an event argument without the detour through a juce::var where
+            we can avoid it.
+         */
+        void pushArgToDukStack (int v)                  { duk_push_int(ctx, v); }
+        void pushArgToDukStack (float v)                { duk_push_number(ctx, (double) v); }
+        void pushArgToDukStack (double v)               { duk_push_number(ctx, v); }
+        void pushArgToDukStack (bool v)                 { duk_push_boolean(ctx, v); }
+        void pushArgToDukStack (const char* v)          { duk_push_string(ctx, v); }
+        void pushArgToDukStack (const juce::String& v)  { stringCache.push(ctx, v); }
+        void pushArgToDukStack (const juce::var& v)     { pushVarToDukStack(v); }
+        void pushArgToDukStack (const CborPayload& v)   { CborPayload::push(ctx, v.value); }
+        void pushArgToDukStack (const ScriptWorker::Message& v) { v.push(ctx); }
+
+        template <typename V>
+        void pushArgToDukStack (const V& v)             { pushVarToDukStack(juce::var(v)); }
+
+        void pushVarToDukStack (const juce::var& v)     { pushVarToDukStack(ctx, v, &stringCache); }
+
+        /** Pushes a var, its strings and object keys through the given cache if
+            there is one.
+         */
+        static void pushVarToDukStack (duk_context* ctx, const juce::var& v, DukStringCache* strings = nullptr)
+        {
+            const auto pushString = [ctx, strings](const juce::String& s) {
+                if (strings != nullptr)
+                    strings->push(ctx, s);
+                else
+                    duk_push_lstring(ctx, s.toRawUTF8(), s.getNumBytesAsUTF8());
+            };
+
+            if (v.isBool())
+                return duk_push_boolean(ctx, (bool) v);
+            if (v.isInt())
+                return duk_push_int(ctx, (int) v);
+            // Beyond 32 bits, a double still holds integers exactly to 2^53.
+            if (v.isInt64())
+                return duk_push_number(ctx, (double) (juce::int64) v);
+            if (v.isDouble())
+                return duk_push_number(ctx, (double) v);
+            if (v.isString())
+                return pushString(v.toString());
+            if (v.isArray())
+            {
+                duk_idx_t arr_idx = duk_push_array(ctx);
+                int i = 0;
+
+                for (auto& e : *(v.getArray()))
+                {
+                    pushVarToDukStack(ctx, e, strings);
+                    duk_put_prop_index(ctx, arr_idx, i++);
+                }
+
+                return;
+            }
+            // Binary data goes back the way it came, as an ArrayBuffer.
+            if (auto* block = v.getBinaryData())
+                return DukValue<juce::MemoryBlock>::push(ctx, *block);
+            if (v.isObject())
+            {
+                if (auto* o = v.getDynamicObject())
+                {
+                    duk_idx_t obj_idx = duk_push_object(ctx);
+
+                    for (auto& e : o->getProperties())
+                    {
+                        // Keys are pooled, so they make the best of the cache.
+                        pushString(e.name.toString());
+                        pushVarToDukStack(ctx, e.value, strings);
+                        duk_put_prop(ctx, obj_idx);
+                    }
+                }
+
+                return;
+            }
+        }
+
+        /** Returns the Identifier for the property key at the given stack index,
+            or a null Identifier for the empty key.
+
+            Object payloads repeat the same few keys over and over, so we keep
+            the latest Identifier for each string the engine holds, found by the
+            string's address and confirmed by its contents, rather than going to
+            the global string pool, and its lock, for every key.
+         */
+        static juce::Identifier internDukKey (duk_context* ctx, duk_idx_t idx)
+        {
+            const char* key = duk_to_string(ctx, idx);
+
+            if (key[0] == 0)
+                return {};
+
+            struct Entry
+            {
+                const void* heapPtr = nullptr;
+                juce::Identifier id;
+            };
+
+            static constexpr size_t cacheSize = 256;
+            thread_local Entry cache[cacheSize];
+
+            // The engine interns its strings, so a key's address is as good as a
+            // hash. An address reused by a later string just fails the compare.
+            const void* heapPtr = duk_get_heapptr(ctx, idx);
+            auto& entry = cache[(reinterpret_cast<juce::pointer_sized_uint>(heapPtr) >> 4) % cacheSize];
+
+            if (entry.heapPtr != heapPtr || std::strcmp(entry.id.getCharPointer().getAddress(), key) != 0)
+            {
+                entry.heapPtr = heapPtr;
+                entry.id = juce::Identifier(key);
+            }
+
+            return entry.id;
+        }
+
+        static juce::var readVarFromDukStack (duk_context* ctx, duk_idx_t idx)
+        {
+            juce::var value;
+
+            // Plain buffers and typed arrays, e.g. a Canvas's drawing commands,
+            // arrive as binary data: a copy of just the bytes the array views.
+            if (duk_is_buffer_data(ctx, idx))
+            {
+                duk_size_t size = 0;
+                void* data = duk_get_buffer_data(ctx, idx, &size);
+
+                return juce::MemoryBlock(data, size);
+            }
+
+            switch (duk_get_type(ctx, idx))
+            {
+                case DUK_TYPE_NULL:
+                    // It looks like juce::var doesn't have an explicit null value,
+                    // so we're just using the default empty constructor value.
+                    break;
+                case DUK_TYPE_UNDEFINED:
+                    value = juce::var::undefined();
+                    break;
+                case DUK_TYPE_BOOLEAN:
+                    value = (bool) duk_get_boolean(ctx, idx);
+                    break;
+                case DUK_TYPE_NUMBER:
+                    value = duk_get_number(ctx, idx);
+                    break;
+                case DUK_TYPE_STRING:
+                    value = duk_get_string(ctx, idx);
+                    break;
+                case DUK_TYPE_OBJECT:
+                {
+                    // Functions, e.g. event handler props, can't cross into native
+                    // code. We pass `true` in their place so that native code can
+                    // still tell a handler is present.
+                    if (duk_is_function(ctx, idx))
+                    {
+                        value = true;
+                        break;
+                    }
+
+                    if (duk_is_array(ctx, idx))
+                    {
+                        duk_size_t len = duk_get_length(ctx, idx);
+                        juce::Array<juce::var> els;
+                        els.ensureStorageAllocated(static_cast<int>(len));
+
+                        for (duk_size_t i = 0; i < len; ++i)
+                        {
+                            duk_get_prop_index(ctx, idx, i);
+                            els.add(readVarFromDukStack(ctx, -1));
+                            duk_pop(ctx);
+                        }
+
+                        value = std::move(els);
+                        break;
+                    }
+                    else
+                    {
+                        // Built where it will live, rather than on the stack and
+                        // then cloned.
+                        juce::DynamicObject::Ptr obj (new juce::DynamicObject());
+
+                        // Generic object enumeration; `duk_enum` pushes an enumerator
+                        // object to the top of the stack
+                        duk_enum(ctx, idx, DUK_ENUM_OWN_PROPERTIES_ONLY);
+
+                        while (duk_next(ctx, -1, 1))
+                        {
+                            // For each found key/value pair, `duk_enum` pushes the
+                            // values to the top of the stack. So here the stack top
+                            // is [ ... enum key value]. Enum is at -3, key at -2,
+                            // value at -1 from the stack top.
+                            // Note here that all keys in an ECMAScript object are of
+                            // type string, even arrays, e.g. `myArr[0]` has an implicit
+                            // conversion from number to string. Thus here, while constructing
+                            // the DynamicObject, we take the `toString()` value for the key
+                            // always.
+                            const auto key = internDukKey(ctx, -2);
+
+                            if (key.isValid())
+                                obj->setProperty(key, readVarFromDukStack(ctx, -1));
+
+                            // Clear the key/value pair from the stack
+                            duk_pop_2(ctx);
+                        }
+
+                        // Pop the enumerator from the stack
+                        duk_pop(ctx);
+
+                        value = juce::var(obj.get());
+                        break;
+                    }
+                }
+                case DUK_TYPE_NONE:
+                default:
+                    jassertfalse;
+            }
+
+            return value;
+        }
+
+        /** Recursively computes the shadow tree layout, then traverses the tree
+            flushing new layout bounds to the associated view components.
+         */
+        void performShadowTreeLayout()
+        {
+            BLUEPRINT_TRACE_SCOPE("layout");
+
+            // Layouts before the first commit, of a tree still empty, don't count.
+            const bool isFirstLayout = isStartingUp(PerformanceStats::FirstLayoutPhase)
+                                       && performanceStats.hasBegunStartupPhase(PerformanceStats::FirstCommitPhase);
+
+            const PerformanceStats::ScopedStartupPhase startupPhase (isFirstLayout ? &performanceStats : nullptr,
+                                                                     PerformanceStats::FirstLayoutPhase);
+
+            // Surface trees are small beside the root's, and laid out here
+            // whichever way the root's own tree goes.
+            layoutSurfaces();
+
+            juce::Rectangle<float> bounds = getLocalBounds().toFloat();
+            const float width = bounds.getWidth();
+            const float height = bounds.getHeight();
+
+            // The snapshots lay out copies, leaving our own nodes without a
+            // layout for a boundary to start from.
+            if (isAsyncLayoutEnabled() || isParallelLayoutEnabled())
+                laidOutRevision = 0;
+
+            if (isAsyncLayoutEnabled())
+                return startAsyncLayout(width, height);
+
+            if (isParallelLayoutEnabled())
+            {
+                const ShadowView::ScopedConfig scopedConfig (yogaConfig.config);
+                LayoutSnapshot snapshot (*_shadowView, width, height, &paneLayoutCache);
+
+                snapshot.calculate(paneLayoutPool.get());
+                return applyLayoutSnapshot(snapshot);
+            }
+
+            // If every change since the last layout lies within a layout boundary,
+            // only those boundaries are laid out again; if there's been none at
+            // all, as when only an overlay or surface changed, nothing is.
+            std::vector<ShadowView*> boundaries;
+            const bool withinBoundaries = laidOutRevision != 0 && bounds.getWidth() == laidOutWidth && bounds.getHeight() == laidOutHeight
+                                          && _shadowView->collectDirtyLayoutBoundaries(laidOutRevision, boundaries);
+
+            laidOutRevision = ShadowView::getLatestLayoutRevision();
+            laidOutWidth = width;
+            laidOutHeight = height;
+
+            if (withinBoundaries)
+            {
+                const PerformanceStats::ScopedLayout statsLayout (performanceStats);
+                BLUEPRINT_TRACE_SCOPE("layoutWithinBoundaries");
+
+                for (auto* boundary : boundaries)
+                    performanceStats.getCurrentFrame().numViewsLaidOut += boundary->layoutWithinBoundary(&layoutAnimator);
+            }
+            else
+            {
+                {
+                    const PerformanceStats::ScopedLayout statsLayout (performanceStats);
+                    _shadowView->computeViewLayout(width, height);
+                }
+
+                {
+                    BLUEPRINT_TRACE_SCOPE("flushViewLayout");
+                    performanceStats.getCurrentFrame().numViewsLaidOut += _shadowView->flushViewLayout(&layoutAnimator);
+                }
+            }
+
+            if (layoutAnimator.isAnimating())
+                scheduler.scheduleFrame();
+        }
+
+        //==============================================================================
+        /** Applies the frame rate limit and low power mode to the scheduler. */
+        void updateFrameRate()
+        {
+            double hz = maxFrameRate;
+
+            if (lowPowerMode)
+                hz = hz > 0.0 ? juce::jmin(hz, lowPowerFrameRate) : lowPowerFrameRate;
+
+            scheduler.setMaxFrameRate(hz);
+        }
+
+        //==============================================================================
+        /** Starts an automatic live resize on the second of two resizes close
+            together, and keeps it going while they keep coming.
+         */
+        void noteResizeStep()
+        {
+            if (!liveResizeOptions.detectAutomatically || isHeadless() || !isShowing())
+                return;
+
+            const double now = juce::Time::getMillisecondCounterHiRes();
+            const bool isBurst = now - lastResizeTime < liveResizeOptions.settleMs;
+            lastResizeTime = now;
+
+            if (isBurst && !liveResizing)
+            {
+                beginLiveResize();
+                liveResizeDetected = true;
+            }
+
+            if (liveResizeDetected)
+                scheduler.scheduleAfter(liveResizeOptions.settleMs);
+        }
+
+        /** Lays out at the latest size of a live resize, and ends an automatic
+            one once the resizes have settled.
+         */
+        void runLiveResize()
+        {
+            if (!liveResizing)
+                return;
+
+            if (liveResizeDetected)
+            {
+                const double sinceLastResize = juce::Time::getMillisecondCounterHiRes() - lastResizeTime;
+
+                if (sinceLastResize >= liveResizeOptions.settleMs)
+                    return endLiveResize();
+
+                scheduler.scheduleAfter(liveResizeOptions.settleMs - sinceLastResize);
+            }
+
+            // A scaled snapshot stands in for the whole tree until the end.
+            if (liveResizeLayoutPending && liveResizeCover == nullptr)
+            {
+                liveResizeLayoutPending = false;
+                performShadowTreeLayout();
+            }
+        }
+
+        /** Hands a snapshot of the shadow tree to the layout thread or, if it's
+            busy with an earlier one, marks another layout pending for when it's
+            done.
+         */
+        void startAsyncLayout (float width, float height)
+        {
+            if (asyncLayoutInFlight)
+            {
+                asyncLayoutPending = true;
+                return;
+            }
+
+            const ShadowView::ScopedConfig scopedConfig (yogaConfig.config);
+            auto snapshot = std::make_shared<LayoutSnapshot>(*_shadowView, width, height,
+                                                             isParallelLayoutEnabled() ? &paneLayoutCache : nullptr);
+
+            juce::Component::SafePointer<ReactApplicationRoot> safeThis (this);
+            const auto generation = asyncLayoutGeneration;
+            asyncLayoutInFlight = true;
+
+            layoutThreadPool->addJob([snapshot, safeThis, generation, pool = paneLayoutPool]() mutable {
+                snapshot->calculate(pool.get());
+
+                // The snapshot goes with the callback, so that its nodes are
+                // freed on the message thread, as they were made.
+                juce::MessageManager::callAsync([snapshot = std::move(snapshot), safeThis, generation]() {
+                    if (auto* root = safeThis.getComponent())
+                        if (generation == root->asyncLayoutGeneration)
+                            root->applyAsyncLayout(*snapshot);
+                });
+            });
+        }
+
+        /** Applies a layout computed on the layout thread, then starts the next if
+            the tree has changed since.
+         */
+        void applyAsyncLayout (const LayoutSnapshot& snapshot)
+        {
+            asyncLayoutInFlight = false;
+            applyLayoutSnapshot(snapshot);
+
+            if (asyncLayoutPending)
+            {
+                asyncLayoutPending = false;
+                performShadowTreeLayout();
+            }
+        }
+
+        /** Moves the views to the bounds computed by a snapshot, and keeps the
+            layout of its panes for the next.
+         */
+        void applyLayoutSnapshot (const LayoutSnapshot& snapshot)
+        {
+            BLUEPRINT_TRACE_SCOPE("applyLayoutSnapshot");
+
+            auto& frame = performanceStats.getCurrentFrame();
+            frame.layoutMs += snapshot.getCalculationMs();
+            frame.numLayouts++;
+            frame.numTextMeasures += snapshot.getNumTextMeasures();
+            frame.numViewsLaidOut += snapshot.apply(*_shadowView, &layoutAnimator);
+
+            if (isParallelLayoutEnabled())
+                snapshot.updatePaneCache(paneLayoutCache);
+
+            if (layoutAnimator.isAnimating())
+                scheduler.scheduleFrame();
+        }
+
+        //==============================================================================
+        /** Opens a reconciler commit. Until the matching call to `endCommit`, any
+            layout or repaint requested by tree mutations is deferred, and then
+            performed exactly once when the outermost commit closes.
+         */
+        void beginCommit()
+        {
+            if (isOnScriptThread())
+                return (void) ++scriptCommitDepth;
+
+            if (commitDepth++ > 0)
+                return;
+
+            if (isStartingUp(PerformanceStats::FirstCommitPhase))
+                performanceStats.beginStartupPhase(PerformanceStats::FirstCommitPhase);
+
+            if (bridgeRecorder != nullptr)
+                bridgeRecorder->recordCommit(true, getClockTime());
+        }
+
+        /** Closes a reconciler commit, flushing any deferred layout and repaints. */
+        void endCommit()
+        {
+            if (isOnScriptThread())
+            {
+                jassert (scriptCommitDepth > 0);
+
+                if (scriptCommitDepth > 0 && --scriptCommitDepth == 0)
+                    closeScriptCommit();
+
+                return;
+            }
+
+            // If you hit this, you've closed a commit that was never opened.
+            jassert (commitDepth > 0);
+
+            if (commitDepth > 0 && --commitDepth == 0)
+            {
+                flushPendingCommitWork();
+
+                performanceStats.endStartupPhase(PerformanceStats::FirstCommitPhase);
+
+                if (!hasCommitted)
+                {
+                    hasCommitted = true;
+
+                    if (startupSnapshotCover != nullptr)
+                        startStartupSnapshotFade();
+                }
+
+                if (bridgeRecorder != nullptr)
+                    bridgeRecorder->recordCommit(false, getClockTime());
+            }
+        }
+
+        /** Performs the shadow tree layout immediately or, if we're inside of a
+            commit, marks the layout pending for the end of the commit.
+         */
+        void requestShadowTreeLayout()
+        {
+            if (commitDepth > 0)
+                layoutPending = true;
+            else
+                performShadowTreeLayout();
+        }
+
+        /** Repaints the given view immediately or, if we're inside of a commit,
+            defers the repaint to the end of the commit.
+         */
+        void requestRepaint (ViewId viewId)
+        {
+            if (auto* view = getViewHandle(viewId).first)
+                requestRepaint(viewId, juce::RectangleList<int>(view->getLocalBounds()));
+        }
+
+        /** Repaints the given area of a view, in its own coordinates, immediately
+            or, if we're inside of a commit, at the end of the commit along with
+            every other area invalidated in the meantime.
+         */
+        void requestRepaint (ViewId viewId, const juce::RectangleList<int>& area)
+        {
+            if (commitDepth > 0)
+            {
+                pendingRepaints[viewId].area.add(area);
+            }
+            else if (auto* view = getViewHandle(viewId).first)
+            {
+                for (const auto& r : area)
+                {
+                    view->repaint(r);
+                    flashRepaint(*view, r);
+                }
+
+                performanceStats.getCurrentFrame().numRepaints += area.getNumRectangles();
+            }
+        }
+
+        /** Returns true if the given view holds text for a TextView to lay out:
+            the text view itself, or a span within one.
+         */
+        static bool isTextContainer (View* view)
+        {
+            const auto kind = view->getKind();
+            return kind == Kind::Text || kind == Kind::TextSpan;
+        }
+
+        /** Returns the TextView whose text the given view is part of, however
+            deeply nested within spans, or the view itself if it's a TextView.
+            Returns nullptr for raw text and spans not yet within a TextView.
+         */
+        static TextView* findEnclosingTextView (View* v)
+        {
+            // Raw text and spans are only ever children of text views and spans,
+            // so every parent we step to here is a view.
+            while (v != nullptr && (v->getKind() == Kind::RawText || v->getKind() == Kind::TextSpan))
+                v = static_cast<View*>(v->getParentComponent());
+
+            return viewCast<TextView>(v);
+        }
+
+        /** Measures, lays out and repaints a TextView again after a change to the
+            raw text or spans within it, which covered the given area before, or
+            only repaints it if its size doesn't depend on its text.
+         */
+        void textContentChanged (TextView& textView, juce::Rectangle<int> oldTextArea)
+        {
+            textView.invalidateTextLayout();
+
+            // A text view sized by its own properties is never measured, so new
+            // text can't move anything, and it need only repaint; a readout in a
+            // fixed box then costs no layout at all. Its measurements are of the
+            // old text all the same, and go whatever its size, in case a later
+            // style stops the size being fixed.
+            if (auto* textShadowView = shadowViewCast<TextShadowView>(getViewHandle(textView.getViewId()).second))
+            {
+                if (textShadowView->hasFixedSize())
+                {
+                    textShadowView->clearMemoizedMeasures();
+                }
+                else
+                {
+                    textShadowView->markDirty();
+                    requestShadowTreeLayout();
+                }
+            }
+
+            // The raw text and spans have no idea how to paint their text, so
+            // the text view repaints: just where the text was and where it is
+            // after the layout.
+            requestTextRepaint(textView, oldTextArea);
+        }
+
+        /** A set of properties registered with `registerStyleSheet`. */
+        struct StyleSheet
+        {
+            juce::NamedValueSet properties;
+            int effect = PropertyEffect::None;
+            bool hasLayoutProperties = false;
+
+            // A node holding the sheet's flex style, for views taking the sheet
+            // to copy whole. It's made on the message thread, as a view first
+            // takes the sheet, and never changed after.
+            mutable std::unique_ptr<ShadowView> layoutTemplate;
+        };
+
+        /** Returns the style sheet with the given id, or nullptr if it has none. */
+        std::shared_ptr<const StyleSheet> getStyleSheet (int styleId) const
+        {
+            const juce::SpinLock::ScopedLockType sl (styleSheetLock);
+
+            if (styleId < 1 || styleId > static_cast<int>(styleSheets.size()))
+                return nullptr;
+
+            return styleSheets[static_cast<size_t>(styleId - 1)];
+        }
+
+        /** Gives a view the properties of the style sheet with the given id,
+            skipping those it already has.
+         */
+        void applyStyleSheet (ViewId viewId, View* view, ShadowView* shadow, const juce::var& styleId)
+        {
+            view->storePropertyValue(IDs::styleId, styleId);
+            const auto sheet = getStyleSheet(static_cast<int>(styleId));
+
+            // If you hit this, the id didn't come from StyleSheet.create, or
+            // came from an engine since reloaded.
+            jassert (sheet != nullptr || styleId.isVoid());
+
+            if (sheet == nullptr)
+                return;
+
+            if (auto* span = viewCast<TextSpanView>(view))
+                return setTextSpanProperties(*span, sheet->properties, sheet->effect);
+
+            // A node with no flex style of its own yet, as on mount, copies the
+            // sheet's whole, in place of parsing each of its flex properties.
+            const bool copiedLayout = shadow != nullptr && sheet->hasLayoutProperties
+                                      && shadow->copyStyleFrom(getLayoutTemplate(*sheet));
+
+            for (const auto& p : sheet->properties)
+            {
+                if (view->hasPropertyValue(p.name, p.value))
+                    continue;
+
+                if (!copiedLayout || !ShadowView::isLayoutProperty(p.name))
+                {
+                    applyViewProperty(view, shadow, p.name, p.value);
+                    continue;
+                }
+
+                // The node has this one already; the view takes it as it would
+                // from applyViewProperty.
+                if (view->isLayoutOnly() && p.name == IDs::display)
+                    promoteLayoutOnlyView(view, shadow);
+
+                if ((getPropertyConsumers(*view, p.name) & ViewType::ConsumedByView) != 0)
+                    view->setProperty(p.name, p.value);
+                else
+                    view->storePropertyValue(p.name, p.value);
+            }
+
+            requestPropertyUpdate(viewId, sheet->effect);
+        }
+
+        /** Returns the node holding the given sheet's flex style, making it the
+            first time it's asked for.
+         */
+        const ShadowView& getLayoutTemplate (const StyleSheet& sheet)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            if (sheet.layoutTemplate == nullptr)
+            {
+                // Made with our config, so that the template's defaults are those
+                // of the nodes which copy it.
+                const ShadowView::ScopedConfig scopedConfig (yogaConfig.config);
+                auto templateNode = std::make_unique<ShadowView>(nullptr);
+
+                for (const auto& p : sheet.properties)
+                    if (ShadowView::isLayoutProperty(p.name))
+                        templateNode->setProperty(p.name, p.value);
+
+                sheet.layoutTemplate = std::move(templateNode);
+            }
+
+            return *sheet.layoutTemplate;
+        }
+
+        /** Sets properties on a span, which has no shadow view and paints nothing
+            itself, so that what they affect is its text view's measure and paint.
+         */
+        void setTextSpanProperties (TextSpanView& span, const juce::NamedValueSet& properties, int effect)
+        {
+            auto* textView = effect != PropertyEffect::None ? findEnclosingTextView(&span) : nullptr;
+            const auto oldTextArea = textView != nullptr ? textView->getTextArea() : juce::Rectangle<int>();
+
+            for (const auto& p : properties)
+                applyViewProperty(&span, nullptr, p.name, p.value);
+
+            if (textView != nullptr)
+                textContentChanged(*textView, oldTextArea);
+        }
+
+        /** Repaints the text of a TextView whose text has just changed: the given
+            area its old text covered, and wherever its new text lands once it's
+            laid out.
+         */
+        void requestTextRepaint (TextView& view, juce::Rectangle<int> oldTextArea)
+        {
+            if (commitDepth > 0)
+            {
+                auto& pending = pendingRepaints[view.getViewId()];
+                pending.area.add(oldTextArea);
+                pending.textArea = true;
+            }
+            else
+            {
+                // Outside of a commit, the layout has already happened.
+                view.repaint(oldTextArea.getUnion(view.getTextArea()));
+                flashRepaint(view, oldTextArea.getUnion(view.getTextArea()));
+                performanceStats.getCurrentFrame().numRepaints++;
+            }
+        }
+
+        /** Remounts the children of the given view immediately or, if we're
+            inside of a commit, defers the remount to the end of the commit.
+         */
+        void requestRemount (ViewId viewId)
+        {
+            if (commitDepth > 0)
+                pendingRemounts.insert(viewId);
+            else
+                remountChildren(*getViewHandle(viewId).second);
+        }
+
+        /** Queues a Measure event for the given view.
+
+            Resizing the window can lay the tree out several times before we get
+            back to the message loop, and each Measure event may trigger a new
+            render. So rather than dispatching straight away, we collect them and
+            dispatch only the latest size for each view, once, asynchronously.
+         */
+        void queueMeasureEvent (ViewId viewId, float width, float height)
+        {
+            heldMeasureEvents.erase(viewId);
+            pendingMeasureEvents[viewId] = { width, height };
+            triggerAsyncUpdate();
+        }
+
+        /** Holds back a Measure event for a view scrolled out of sight, until
+            `releaseHeldMeasureEvents` finds it back in view.
+         */
+        void holdMeasureEvent (ViewId viewId, float width, float height)
+        {
+            pendingMeasureEvents.erase(viewId);
+            heldMeasureEvents[viewId] = { width, height };
+        }
+
+        /** Queues the held Measure events of the views which have since come into
+            view; called as scrolled content moves.
+         */
+        void releaseHeldMeasureEvents()
+        {
+            for (auto it = heldMeasureEvents.begin(); it != heldMeasureEvents.end();)
+            {
+                auto* entry = viewTable.find(it->first);
+
+                if (entry != nullptr && entry->view->isScrolledOutOfView())
+                {
+                    ++it;
+                    continue;
+                }
+
+                if (entry != nullptr)
+                    pendingMeasureEvents[it->first] = it->second;
+
+                it = heldMeasureEvents.erase(it);
+            }
+
+            if (!pendingMeasureEvents.empty())
+                triggerAsyncUpdate();
+        }
+
+        /** Queues a Load event for the given view, with the natural size of what
+            it loaded.
+
+            Views load mostly while a commit sets their props, when we mustn't call
+            back into JavaScript, so these go out asynchronously too.
+         */
+        void queueLoadEvent (ViewId viewId, float width, float height)
+        {
+            pendingLoadEvents[viewId] = { width, height };
+            triggerAsyncUpdate();
+        }
+
+        /** Measures a view with an intrinsic size again, and lays out the tree
+            around it, unless its style fixes its size anyway.
+         */
+        void intrinsicSizeChanged (ViewId viewId)
+        {
+            if (auto* measured = shadowViewCast<MeasuredShadowView>(getViewHandle(viewId).second))
+            {
+                if (!measured->hasFixedSize())
+                {
+                    measured->markDirty();
+                    requestShadowTreeLayout();
+                }
+            }
+        }
+
+        /** Queues a VisibleRangeChange event for the given list view, giving the
+            first item index it wants mounted and one past the last.
+
+            A range can change with a layout, inside a commit, as well as with a
+            scroll, so these go out asynchronously too, the latest for each view.
+         */
+        void queueVisibleRangeEvent (ViewId viewId, int first, int last)
+        {
+            pendingVisibleRangeEvents[viewId] = { first, last };
+            triggerAsyncUpdate();
+        }
+
+        /** Queues a ValueChange event for the given slider. A slider dragged
+            faster than we dispatch sends only its latest value.
+         */
+        void queueValueChangeEvent (ViewId viewId, double value)
+        {
+            pendingValueChangeEvents[viewId] = value;
+            triggerAsyncUpdate();
+        }
+
+        /** Queues a note for the given keyboard's next NoteChange event, a
+            velocity of 0 for a release. A keyboard's notes go out together, in
+            the order played, so a note pressed and released within a frame
+            still shows as both; only a repeat of the same change is dropped.
+         */
+        void queueNoteChangeEvent (ViewId viewId, int note, float velocity)
+        {
+            auto& changes = pendingNoteChangeEvents[viewId];
+
+            for (auto it = changes.rbegin(); it != changes.rend(); ++it)
+            {
+                if (it->first != note)
+                    continue;
+
+                if (it->second == velocity)
+                    return;
+
+                break;
+            }
+
+            changes.emplace_back(note, velocity);
+            triggerAsyncUpdate();
+        }
+
+        /** Queues a pointer event for dispatch at the next frame.
+
+            Drag, move, wheel and scroll events for a view merge with any such event
+            already queued for it this frame, keeping the latest position and
+            accumulating the deltas, so a view sees at most one of each per frame
+            however fast the mouse reports. Enter and exit events are kept as they
+            are, in order.
+         */
+        void queuePointerEvent (ViewId viewId, PointerEventType type, juce::Point<float> position,
+                                juce::Point<float> mouseDownPosition, juce::Point<float> delta)
+        {
+            const bool coalesces = (type == PointerEventType::Drag
+                                    || type == PointerEventType::Move
+                                    || type == PointerEventType::Wheel
+                                    || type == PointerEventType::Scroll);
+
+            if (coalesces)
+            {
+                for (auto& pending : pendingPointerEvents)
+                {
+                    if (pending.viewId == viewId && pending.type == type)
+                    {
+                        pending.position = position;
+                        pending.mouseDownPosition = mouseDownPosition;
+                        pending.delta += delta;
+                        return;
+                    }
+                }
+            }
+
+            pendingPointerEvents.push_back({ viewId, type, position, mouseDownPosition, delta });
+            scheduler.scheduleFrame();
+        }
+
+        /** Dispatches every queued pointer event. */
+        void flushPointerEvents()
+        {
+            if (pendingPointerEvents.empty())
+                return;
+
+            auto events = std::move(pendingPointerEvents);
+            pendingPointerEvents.clear();
+
+            for (const auto& e : events)
+            {
+                // The view may have gone in the meantime.
+                View* view = this;
+
+                if (e.viewId != getViewId())
+                {
+                    auto* entry = viewTable.find(e.viewId);
+
+                    if (entry == nullptr)
+                        continue;
+
+                    view = entry->view.get();
+                }
+
+                const float x = e.position.x;
+                const float y = e.position.y;
+
+                switch (e.type)
+                {
+                    case PointerEventType::Drag:
+                        dispatchBubblingViewEvent(*view, View::MouseDragEvent, IDs::MouseDrag, x, y, e.mouseDownPosition.x, e.mouseDownPosition.y, e.delta.x, e.delta.y);
+                        break;
+                    case PointerEventType::Move:
+                        dispatchBubblingViewEvent(*view, View::MouseMoveEvent, IDs::MouseMove, x, y, e.delta.x, e.delta.y);
+                        break;
+                    case PointerEventType::Enter:
+                        dispatchViewEvent(e.viewId, IDs::MouseEnter, x, y);
+                        break;
+                    case PointerEventType::Exit:
+                        dispatchViewEvent(e.viewId, IDs::MouseExit, x, y);
+                        break;
+                    case PointerEventType::Wheel:
+                        dispatchBubblingViewEvent(*view, View::MouseWheelEvent, IDs::MouseWheel, x, y, e.delta.x, e.delta.y);
+                        break;
+                    case PointerEventType::Scroll:
+                        dispatchViewEvent(e.viewId, IDs::Scroll, x, y);
+                        break;
+                }
+            }
+        }
+
+        //==============================================================================
+        struct RegisteredMethod
+        {
+            std::function<void(const juce::var::NativeFunctionArgs&)> fn;
+            juce::Identifier name;
+            int statsIndex;
+        };
+
+        // A deque, as a call queued for the message thread holds on to its
+        // method while the script thread may be registering more.
+        std::deque<RegisteredMethod> methodRegistry;
+
+        struct RegisteredFunction
+        {
+            NativeFunction fn;
+            juce::Identifier name;
+            int statsIndex;
+        };
+
+        std::vector<RegisteredFunction> nativeFunctionRegistry;
+
+        struct RegisteredAsyncMethod
+        {
+            std::function<juce::var(const juce::var::NativeFunctionArgs&)> fn;
+            juce::Identifier name;
+        };
+
+        std::vector<RegisteredAsyncMethod> asyncMethodRegistry;
+
+        /** What an async method call came to, waiting to settle its Promise. */
+        struct CompletedAsyncCall
+        {
+            int callId;
+            bool succeeded;
+            juce::var result;
+        };
+
+        /** Grows the method registries, and installs what's added into the
+            engine, on the engine's thread: here and now, or queued for the
+            script thread while there is one. The script thread reads the
+            registries as JavaScript calls into them, so they change on no other
+            thread while it runs.
+         */
+        void changeMethodRegistry (std::function<void()> change)
+        {
+            if (scriptThread != nullptr && !isOnScriptThread())
+                callIntoScript(std::move(change));
+            else
+                change();
+        }
+
+        /** Puts a registered native method on __BlueprintNative__. */
+        void installNativeMethod (size_t fnIndex)
+        {
+            // Pull __BlueprintNative__ onto the stack
+            duk_push_global_object(ctx);
+            duk_get_prop_string(ctx, -1, "__BlueprintNative__");
+            duk_require_object(ctx, -1);
+
+            // Push a lightfunc that can retrieve the registry index via its magic.
+            // We want the registered method to be able to capture and carry a closure,
+            // but those functions can't be converted to a standard c function pointer. We
+            // therefore hold those functions in a local registry and push a wrapper function
+            // into the script engine, where the wrapper knows which registry index to call back
+            // to via duktape's lightfunc "magic" feature.
+            duk_push_c_lightfunc(ctx, [](duk_context* ctx) -> duk_ret_t {
+                // Retrieve the root instance pointer
+                duk_push_global_stash(ctx);
+                duk_get_prop_string(ctx, -1, "rootInstance");
+                ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+                duk_pop_2(ctx);
+
+                jassert (root != nullptr);
+
+                unsigned int fnIndex = ((unsigned int) duk_get_current_magic(ctx)) & 0xffffU;
+                std::vector<juce::var> args;
+
+                // Build up the arguments vector
+                int nargs = duk_get_top(ctx);
+
+                // Objects, arrays and binary data arrive as they would as view
+                // properties.
+                for (int i = 0; i < nargs; ++i)
+                    args.push_back(readVarFromDukStack(ctx, i));
+
+                // The registry belongs to the engine's thread, so the method is
+                // looked up here; the deque keeps it where it is as it grows.
+                const RegisteredMethod* method = &root->methodRegistry[fnIndex];
+
+                // Dispatch to the method registry, on the message thread
+                root->runOnMessageThread([root, method, args]() {
+                    // Every method goes through this one trampoline, so we note
+                    // which it was.
+                    BLUEPRINT_TRACE_SCOPE("nativeMethod", -1, method->name);
+                    const PerformanceStats::ScopedNativeMethodCall timer (root->performanceStats, method->statsIndex);
+
+                    if (root->bridgeRecorder != nullptr)
+                        root->bridgeRecorder->recordCall(BridgeRecording::NativeMethod, root->getClockTime(), method->name,
+                                                         args.data(), static_cast<int>(args.size()));
+
+                    method->fn(
+                        juce::var::NativeFunctionArgs(
+                            juce::var(),
+                            args.data(),
+                            static_cast<int>(args.size())
+                        )
+                    );
+                });
+
+                return 0;
+            }, DUK_VARARGS, 0, static_cast<unsigned int>(fnIndex));
+
+            // Assign it to __BlueprintNative__
+            duk_put_prop_string(ctx, -2, methodRegistry[fnIndex].name.toString().toRawUTF8());
+            duk_pop_2(ctx);
+
+        }
+
+        /** Registers the functions behind JavaScript's `getListModel`, which run
+            on the engine's thread; the models are safe to use from any.
+         */
+        void registerListModelFunctions()
+        {
+            listModelFunctionsRegistered = true;
+
+            registerNativeFunction("listModelSetQuery", [this](juce::String name, juce::String text, juce::String sortColumn, bool descending) {
+                if (auto* model = getListModel(name))
+                    model->setQuery(text, sortColumn, descending);
+            });
+
+            registerNativeFunction("listModelGetCount", [this](juce::String name) -> int {
+                auto* model = getListModel(name);
+                return model != nullptr ? model->getNumResults() : 0;
+            });
+
+            // Each row of a slice is an object of the item's columns, along with
+            // its `index` among the model's items, which stays put across queries.
+            registerNativeFunction("listModelGetSlice", [this](juce::String name, int start, int count) -> juce::var {
+                juce::Array<juce::var> rows;
+                auto* model = getListModel(name);
+                auto results = model != nullptr ? model->getResults() : nullptr;
+
+                if (results == nullptr)
+                    return rows;
+
+                const auto& columns = model->getColumns();
+                const int end = juce::jmin((int) results->matches.size(), start + juce::jmax(0, count));
+
+                for (int i = juce::jmax(0, start); i < end; ++i)
+                {
+                    const auto itemIndex = results->matches[static_cast<size_t>(i)];
+                    const auto& item = (*results->items)[itemIndex];
+                    auto* row = new juce::DynamicObject();
+
+                    row->setProperty(IDs::index, (int) itemIndex);
+
+                    for (int c = 0; c < columns.size() && c < (int) item.size(); ++c)
+                        row->setProperty(columns[c], item[static_cast<size_t>(c)]);
+
+                    rows.add(juce::var(row));
+                }
+
+                return rows;
+            });
+        }
+
+        /** Registers the functions behind JavaScript's `getNoteGrid`. The models
+            belong to the message thread, so edits from the script thread go over
+            with its commit, and JavaScript reads the notes only from the diffs.
+         */
+        void registerNoteGridFunctions()
+        {
+            noteGridFunctionsRegistered = true;
+
+            registerNativeFunction("noteGridResync", [this](juce::String name) {
+                runOnMessageThread([this, name]() {
+                    if (auto* model = getNoteGrid(name))
+                        model->resync();
+                });
+            });
+
+            registerNativeFunction("noteGridSetNotes", [this](juce::String name, juce::var notes) {
+                runOnMessageThread([this, name, notes]() {
+                    if (auto* model = getNoteGrid(name))
+                    {
+                        std::vector<NoteGridModel::Note> newNotes;
+
+                        if (auto* array = notes.getArray())
+                            for (const auto& note : *array)
+                                newNotes.push_back(noteFromVar(note));
+
+                        model->setNotes(newNotes);
+                    }
+                });
+            });
+
+            registerNativeFunction("noteGridAddNote", [this](juce::String name, int pitch, double start, double length, double velocity) {
+                runOnMessageThread([this, name, pitch, start, length, velocity]() {
+                    if (auto* model = getNoteGrid(name))
+                        model->addNote(pitch, start, length, (float) velocity);
+                });
+            });
+
+            // Any of the note's properties left out keep their values.
+            registerNativeFunction("noteGridUpdateNote", [this](juce::String name, juce::var note) {
+                runOnMessageThread([this, name, note]() {
+                    auto* model = getNoteGrid(name);
+                    auto* current = model != nullptr ? model->getNote((int) note[IDs::id]) : nullptr;
+
+                    if (current != nullptr)
+                        model->updateNote(noteFromVar(note, *current));
+                });
+            });
+
+            registerNativeFunction("noteGridRemoveNote", [this](juce::String name, int id) {
+                runOnMessageThread([this, name, id]() {
+                    if (auto* model = getNoteGrid(name))
+                        model->removeNote(id);
+                });
+            });
+        }
+
+        /** Reads a note from JavaScript, taking what it leaves out from the
+            given note.
+         */
+        static NoteGridModel::Note noteFromVar (const juce::var& v, NoteGridModel::Note note = {})
+        {
+            if (v.hasProperty(IDs::id))         note.id = (int) v[IDs::id];
+            if (v.hasProperty(IDs::pitch))      note.pitch = (int) v[IDs::pitch];
+            if (v.hasProperty(IDs::start))      note.start = (double) v[IDs::start];
+            if (v.hasProperty(IDs::length))     note.length = (double) v[IDs::length];
+            if (v.hasProperty(IDs::velocity))   note.velocity = (float) v[IDs::velocity];
+
+            return note;
+        }
+
+        static juce::var noteToVar (const NoteGridModel::Note& note)
+        {
+            auto* object = new juce::DynamicObject();
+            object->setProperty(IDs::id, note.id);
+            object->setProperty(IDs::pitch, note.pitch);
+            object->setProperty(IDs::start, note.start);
+            object->setProperty(IDs::length, note.length);
+            object->setProperty(IDs::velocity, note.velocity);
+
+            return juce::var(object);
+        }
+
+        /** Sends the diffs of the note grids edited since the last update. */
+        void dispatchNoteGridDiffs()
+        {
+            auto names = std::move(pendingNoteGridDiffs);
+            pendingNoteGridDiffs.clear();
+
+            for (const auto& name : names)
+            {
+                auto* model = getNoteGrid(name);
+
+                if (model == nullptr)
+                    continue;
+
+                const auto diff = model->takeDiff();
+
+                if (diff.isEmpty())
+                    continue;
+
+                juce::Array<juce::var> added, changed, removed;
+
+                for (const auto& note : diff.added)
+                    added.add(noteToVar(note));
+
+                for (const auto& note : diff.changed)
+                    changed.add(noteToVar(note));
+
+                for (const auto id : diff.removed)
+                    removed.add(id);
+
+                auto* object = new juce::DynamicObject();
+                object->setProperty(IDs::reset, diff.reset);
+                object->setProperty(IDs::added, added);
+                object->setProperty(IDs::changed, changed);
+                object->setProperty(IDs::removed, removed);
+
+                dispatchEvent(IDs::noteGridChange, name, juce::var(object));
+            }
+        }
+
+        /** Puts a registered native function on __BlueprintNative__. */
+        void installNativeFunction (size_t fnIndex)
+        {
+            duk_push_global_object(ctx);
+            duk_get_prop_string(ctx, -1, "__BlueprintNative__");
+            duk_require_object(ctx, -1);
+
+            duk_push_c_function(ctx, [](duk_context* ctx) -> duk_ret_t {
+                duk_push_global_stash(ctx);
+                duk_get_prop_string(ctx, -1, "rootInstance");
+                ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+                duk_pop_2(ctx);
+
+                jassert (root != nullptr);
+
+                const auto fnIndex = static_cast<size_t>(duk_get_current_magic(ctx));
+                const int badArg = root->nativeFunctionRegistry[fnIndex].fn.checkArguments(ctx);
+
+                // Thrown from here, where a longjmp leaves nothing to destroy.
+                if (badArg >= 0)
+                    return duk_type_error(ctx, "argument %d of %s has the wrong type", badArg,
+                                          root->nativeFunctionRegistry[fnIndex].name.getCharPointer().getAddress());
+
+                // Stats are kept on the message thread only.
+                if (root->isOnScriptThread())
+                    return root->nativeFunctionRegistry[fnIndex].fn.call(ctx);
+
+                BLUEPRINT_TRACE_SCOPE("nativeFunction", -1, root->nativeFunctionRegistry[fnIndex].name);
+                const PerformanceStats::ScopedNativeMethodCall timer (root->performanceStats, root->nativeFunctionRegistry[fnIndex].statsIndex);
+
+                return root->nativeFunctionRegistry[fnIndex].fn.call(ctx);
+            }, DUK_VARARGS);
+
+            duk_set_magic(ctx, -1, static_cast<duk_int_t>(fnIndex));
+            duk_put_prop_string(ctx, -2, nativeFunctionRegistry[fnIndex].name.toString().toRawUTF8());
+            duk_pop_2(ctx);
+        }
+
+        /** Puts a registered async native method on __BlueprintNative__. */
+        void installAsyncNativeMethod (size_t fnIndex)
+        {
+            duk_push_global_object(ctx);
+            duk_get_prop_string(ctx, -1, "__BlueprintNative__");
+            duk_require_object(ctx, -1);
+
+            duk_push_c_function(ctx, [](duk_context* ctx) -> duk_ret_t {
+                duk_push_global_stash(ctx);
+                duk_get_prop_string(ctx, -1, "rootInstance");
+                ReactApplicationRoot* root = reinterpret_cast<ReactApplicationRoot*>(duk_get_pointer(ctx, -1));
+                duk_pop_2(ctx);
+
+                jassert (root != nullptr);
+
+                const auto fnIndex = static_cast<size_t>(duk_get_current_magic(ctx));
+                std::vector<juce::var> args;
+                const int nargs = duk_get_top(ctx);
+
+                for (int i = 0; i < nargs; ++i)
+                    args.push_back(readVarFromDukStack(ctx, i));
+
+                const int callId = root->nextAsyncCallId++;
+                root->pushAsyncCallPromise(callId);
+
+                // The job takes its own copy of the method, as the registry may
+                // grow while it runs.
+                root->asyncMethodPool->addJob([root, callId, fn = root->asyncMethodRegistry[fnIndex].fn, args]() {
+                    root->runAsyncMethod(fn, callId, args);
+                });
+
+                return 1;
+            }, DUK_VARARGS);
+
+            duk_set_magic(ctx, -1, static_cast<duk_int_t>(fnIndex));
+            duk_put_prop_string(ctx, -2, asyncMethodRegistry[fnIndex].name.toString().toRawUTF8());
+            duk_pop_2(ctx);
+        }
+
+        /** Pushes a new Promise for the given async call, which settleAsyncCalls
+            later settles, or undefined if the engine has no Promise.
+         */
+        void pushAsyncCallPromise (int callId)
+        {
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, "createAsyncCall");
+            duk_get_prop_string(ctx, -2, "asyncCalls");
+            duk_push_int(ctx, callId);
+
+            if (duk_pcall(ctx, 2) != DUK_EXEC_SUCCESS)
+            {
+                logCallError();
+                duk_pop(ctx);
+                duk_push_undefined(ctx);
+            }
+
+            duk_remove(ctx, -2);
+        }
+
+        /** Runs an async method call, on the pool, and queues its result for
+            the next update.
+         */
+        void runAsyncMethod (const std::function<juce::var(const juce::var::NativeFunctionArgs&)>& fn, int callId, const std::vector<juce::var>& args)
+        {
+            CompletedAsyncCall call { callId, true, {} };
+
+            try
+            {
+                call.result = fn(juce::var::NativeFunctionArgs(juce::var(), args.data(), static_cast<int>(args.size())));
+            }
+            catch (const std::exception& e)
+            {
+                call.succeeded = false;
+                call.result = juce::String(e.what());
+            }
+
+            {
+                const juce::ScopedLock sl (completedAsyncCallsLock);
+                completedAsyncCalls.push_back(std::move(call));
+            }
+
+            triggerAsyncUpdate();
+        }
+
+        /** Settles the Promises of the async calls which have completed, on the
+            thread running the engine.
+         */
+        void settleCompletedAsyncCalls()
+        {
+            std::vector<CompletedAsyncCall> calls;
+
+            {
+                const juce::ScopedLock sl (completedAsyncCallsLock);
+                calls.swap(completedAsyncCalls);
+            }
+
+            if (calls.empty())
+                return;
+
+            if (scriptThread != nullptr)
+                return callIntoScript([this, calls]() { settleAsyncCalls(calls); });
+
+            settleAsyncCalls(calls);
+        }
+
+        void settleAsyncCalls (const std::vector<CompletedAsyncCall>& calls)
+        {
+            jassert (isOnEngineThread());
+
+            duk_push_global_stash(ctx);
+
+            for (const auto& call : calls)
+            {
+                duk_require_stack(ctx, 4);
+                duk_get_prop_string(ctx, -1, "settleAsyncCall");
+                duk_get_prop_string(ctx, -2, "asyncCalls");
+                duk_push_int(ctx, call.callId);
+                duk_push_boolean(ctx, call.succeeded);
+                pushVarToDukStack(call.result);
+
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::EventCall);
+
+                if (duk_pcall(ctx, 4) != DUK_EXEC_SUCCESS)
+                    logCallError();
+
+                duk_pop(ctx);
+            }
+
+            duk_pop(ctx);
+
+            // The Promise jobs run now, as an event's would.
+            runMicrotasks();
+        }
+
+        /** Puts every registered method and function on the __BlueprintNative__
+            of a fresh engine.
+         */
+        void installNativeMethods()
+        {
+            for (size_t i = 0; i < methodRegistry.size(); ++i)
+                installNativeMethod(i);
+
+            for (size_t i = 0; i < nativeFunctionRegistry.size(); ++i)
+                installNativeFunction(i);
+
+            for (size_t i = 0; i < asyncMethodRegistry.size(); ++i)
+                installAsyncNativeMethod(i);
+        }
+
+    private:
+        //==============================================================================
+        /** Pushes the named dispatch function of __BlueprintNative__, returning false
+            and leaving the stack untouched if it isn't there.
+
+            The function is looked up once and then pushed directly from its heap
+            pointer; a reference in the stash keeps it alive in the meantime. The
+            cache is dropped whenever a script is evaluated, in case the script
+            installed a new dispatcher.
+         */
+        bool pushDispatchFunction (void*& cachedFn, const char* name)
+        {
+            if (cachedFn == nullptr)
+            {
+                duk_push_global_object(ctx);
+                duk_get_prop_string(ctx, -1, "__BlueprintNative__");
+                duk_get_prop_string(ctx, -1, name);
+
+                if (!duk_is_function(ctx, -1))
+                {
+                    duk_pop_3(ctx);
+                    return false;
+                }
+
+                duk_push_global_stash(ctx);
+                duk_dup(ctx, -2);
+                duk_put_prop_string(ctx, -2, name);
+                duk_pop(ctx);
+
+                cachedFn = duk_get_heapptr(ctx, -1);
+                duk_pop_3(ctx);
+            }
+
+            duk_push_heapptr(ctx, cachedFn);
+            return true;
+        }
+
+        /** Pushes the record a view event goes to JavaScript in, its path filled
+            in, returning its index on the stack.
+
+            A record is an object of the event's `type`, its `path` of view ids,
+            target first, and its `args`. Each event type has one, kept in the
+            stash and filled in afresh for every dispatch, its arrays reused at
+            their new lengths, so that a drag, say, makes no garbage however many
+            events it sends. JavaScript keeps its event object on the record in
+            the same way. An event dispatched from within another's handlers
+            gets a record of its own, as the outer one is still in use.
+         */
+        duk_idx_t pushViewEventRecord (const juce::Identifier& eventType, const ViewId* path, size_t pathLength)
+        {
+            const auto it = viewEventDispatchDepth == 0 ? viewEventRecords.find(eventType) : viewEventRecords.end();
+
+            if (it != viewEventRecords.end())
+            {
+                duk_push_heapptr(ctx, it->second);
+            }
+            else
+            {
+                duk_push_object(ctx);
+                pushEventType(eventType);
+                duk_put_prop_literal(ctx, -2, "type");
+                duk_push_array(ctx);
+                duk_put_prop_literal(ctx, -2, "path");
+                duk_push_array(ctx);
+                duk_put_prop_literal(ctx, -2, "args");
+
+                if (viewEventDispatchDepth == 0)
+                {
+                    // The stash holds our reference, as it does for event types.
+                    duk_push_global_stash(ctx);
+                    duk_get_prop_literal(ctx, -1, "viewEventRecords");
+
+                    if (!duk_is_array(ctx, -1))
+                    {
+                        duk_pop(ctx);
+                        duk_push_array(ctx);
+                        duk_dup_top(ctx);
+                        duk_put_prop_literal(ctx, -3, "viewEventRecords");
+                    }
+
+                    duk_dup(ctx, -3);
+                    duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(duk_get_length(ctx, -2)));
+                    duk_pop_2(ctx);
+
+                    viewEventRecords[eventType] = duk_get_heapptr(ctx, -1);
+                }
+            }
+
+            const duk_idx_t recordIdx = duk_get_top_index(ctx);
+            duk_get_prop_literal(ctx, recordIdx, "path");
+
+            for (size_t i = 0; i < pathLength; ++i)
+            {
+                duk_push_int(ctx, path[i]);
+                duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(i));
+            }
+
+            setArrayLength(-1, static_cast<duk_uarridx_t>(pathLength));
+            duk_pop(ctx);
+
+            return recordIdx;
+        }
+
+        /** Sets the length of the array at the given index, dropping any
+            elements past it.
+         */
+        void setArrayLength (duk_idx_t arrayIdx, duk_uarridx_t length)
+        {
+            arrayIdx = duk_normalize_index(ctx, arrayIdx);
+            duk_push_uint(ctx, length);
+            duk_put_prop_literal(ctx, arrayIdx, "length");
+        }
+
+        /** Calls the dispatch function with the record above it on the stack,
+            and clears the stack.
+         */
+        void callViewEventDispatch()
+        {
+            const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+            const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::EventCall);
+
+            ++viewEventDispatchDepth;
+
+            if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                logCallError();
+
+            --viewEventDispatchDepth;
+            duk_pop(ctx);
+        }
+
+        /** Pushes an event type string, interning it in the engine on first use. */
+        void pushEventType (const juce::Identifier& eventType)
+        {
+            auto it = eventTypeStrings.find(eventType);
+
+            if (it != eventTypeStrings.end())
+                return duk_push_heapptr(ctx, it->second);
+
+            const auto s = eventType.toString();
+            duk_push_lstring(ctx, s.toRawUTF8(), s.getNumBytesAsUTF8());
+
+            // Strings can't carry properties, so the stash holds the references
+            // which keep our interned strings alive.
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, "eventTypes");
+
+            if (!duk_is_array(ctx, -1))
+            {
+                duk_pop(ctx);
+                duk_push_array(ctx);
+                duk_dup_top(ctx);
+                duk_put_prop_string(ctx, -3, "eventTypes");
+            }
+
+            duk_dup(ctx, -3);
+            duk_put_prop_index(ctx, -2, static_cast<duk_uarridx_t>(duk_get_length(ctx, -2)));
+            duk_pop_2(ctx);
+
+            eventTypeStrings[eventType] = duk_get_heapptr(ctx, -1);
+        }
+
+        /** Prints the error at the top of the stack after a failed call. */
+        void logCallError()
+        {
+            // If we have an error object at the top of the stack, we'll print the
+            // stack property.
+            if (duk_is_error(ctx, -1))
+            {
+                // Accessing .stack might cause an error to be thrown, so wrap this
+                // access in a duk_safe_call() if it matters.
+                duk_get_prop_string(ctx, -1, "stack");
+                DBG("Duktape call error: " << duk_safe_to_string(ctx, -1));
+                duk_pop(ctx);
+            }
+            else
+            {
+                // If it's not an error object we'll just coerce to string
+                DBG("Duktape call error: " << duk_safe_to_string(ctx, -1));
+            }
+        }
+
+        /** Hands a batch of [type, ...args] events, at the given stack index, to
+            the EventBridge in one call.
+         */
+        void dispatchEventBatch (duk_idx_t batchIdx)
+        {
+            const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+            const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::EventCall);
+
+            if (pushDispatchFunction(dispatchEventBatchFn, "dispatchEventBatch"))
+            {
+                duk_dup(ctx, batchIdx);
+
+                if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                    logCallError();
+
+                duk_pop(ctx);
+                return;
+            }
+
+            // A bundle built against an older EventBridge has no batch dispatcher,
+            // so we fall back to one dispatchEvent call per event.
+            const auto numEvents = static_cast<duk_uarridx_t>(duk_get_length(ctx, batchIdx));
+
+            for (duk_uarridx_t i = 0; i < numEvents; ++i)
+            {
+                if (!pushDispatchFunction(dispatchEventFn, "dispatchEvent"))
+                    return;
+
+                duk_get_prop_index(ctx, batchIdx, i);
+                const auto numArgs = static_cast<duk_idx_t>(duk_get_length(ctx, -1));
+                duk_require_stack(ctx, numArgs);
+
+                for (duk_idx_t j = 0; j < numArgs; ++j)
+                    duk_get_prop_index(ctx, -1 - j, static_cast<duk_uarridx_t>(j));
+
+                duk_remove(ctx, -1 - numArgs);
+
+                if (duk_pcall(ctx, numArgs) != DUK_EXEC_SUCCESS)
+                    logCallError();
+
+                duk_pop(ctx);
+            }
+        }
+
+        /** Runs the microtasks queued during the call into script just returned,
+            and any they queue in turn, so that Promise jobs and queueMicrotask
+            callbacks finish before we move on rather than waiting on a timer.
+            Microtasks only run once the script stack is empty, so within a
+            nested call this leaves them to the outermost.
+         */
+        void runMicrotasks()
+        {
+            if (!microtasksPending || watchdog.isInCall())
+                return;
+
+            microtasksPending = false;
+
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, "runMicrotasks");
+            duk_get_prop_string(ctx, -2, "microtasks");
+
+            {
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::MicrotaskCall);
+
+                if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                    logCallError();
+            }
+
+            // An aborted run leaves the rest of the queue behind, which we drop
+            // rather than run next time.
+            duk_get_prop_string(ctx, -2, "microtasks");
+            duk_push_uint(ctx, 0);
+            duk_put_prop_string(ctx, -2, "length");
+            duk_pop_3(ctx);
+        }
+
+        /** Tells JavaScript, in one call, of every view removed since the last
+            time, so that it can drop its instances of them and the handlers
+            they hold.
+         */
+        void releaseViewsInScript()
+        {
+            if (releasedScriptViewIds.empty())
+                return;
+
+            auto ids = std::move(releasedScriptViewIds);
+            releasedScriptViewIds.clear();
+
+            if (scriptThread != nullptr && !isOnScriptThread())
+                return callIntoScript([this, ids = std::move(ids)]() { releaseViews(ids); });
+
+            releaseViews(ids);
+        }
+
+        void releaseViews (const std::vector<ViewId>& ids)
+        {
+            jassert (isOnEngineThread());
+            BLUEPRINT_TRACE_SCOPE("releaseViews");
+
+            if (!pushDispatchFunction(releaseViewsFn, "releaseViews"))
+                return;
+
+            const duk_idx_t idsIdx = duk_push_array(ctx);
+
+            for (size_t i = 0; i < ids.size(); ++i)
+            {
+                duk_push_int(ctx, ids[i]);
+                duk_put_prop_index(ctx, idsIdx, static_cast<duk_uarridx_t>(i));
+            }
+
+            const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+
+            if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                logCallError();
+
+            duk_pop(ctx);
+        }
+
+        /** Drops the cached dispatch functions, event type strings and pushed strings. */
+        void resetDispatchCache()
+        {
+            dispatchViewEventFn = nullptr;
+            releaseViewsFn = nullptr;
+            dispatchEventFn = nullptr;
+            dispatchEventBatchFn = nullptr;
+            eventTypeStrings.clear();
+            viewEventRecords.clear();
+            stringCache.clear();
+        }
+
+        //==============================================================================
+        /** What a change to a given property requires of the root. */
+        enum PropertyEffect
+        {
+            None            = 0,
+            AffectsPaint    = 1 << 0,
+            AffectsLayout   = 1 << 1,
+        };
+
+        /** Classifies a property by whether changing it requires a new layout, a
+            repaint, both or neither.
+         */
+        static int getPropertyEffect (const juce::Identifier& name)
+        {
+            // A style sheet's own properties have their effects worked out once,
+            // as it's registered.
+            if (name == IDs::styleId)
+                return None;
+
+            // Flex properties only move things around; any view whose bounds
+            // change is repainted by its own setBounds.
+            if (ShadowView::isLayoutProperty(name))
+                return AffectsLayout;
+
+            // Text measurement depends on these, as does the painted text.
+            if (TextShadowView::isMeasureProperty(name))
+                return AffectsLayout | AffectsPaint;
+
+            // Opacity and transforms repaint themselves when applied.
+            if (name == IDs::opacity || ViewStyle::isTransformProperty(name))
+                return None;
+
+            if (ViewStyle::isStyleProperty(name))
+                return AffectsPaint;
+
+            // A new drawing changes what a Canvas paints, never its size.
+            if (name == IDs::drawing)
+                return AffectsPaint;
+
+            if (name == IDs::refId || name == IDs::interceptClickEvents || name == IDs::propertyBindings || name == IDs::focusable)
+                return None;
+
+            // Takes effect at the next layout, whatever prompts it.
+            if (name == IDs::layoutTransition)
+                return None;
+
+            // Showing or hiding a view repaints it through setVisible.
+            if (name == IDs::visibility)
+                return None;
+
+            // A state style repaints its view, if it's showing, as it's set.
+            if (View::isStateStyleProperty(name))
+                return None;
+
+            // An image element's attribute changes what's drawn, never the box.
+            if (EditableDrawable::isAttributeProperty(name))
+                return AffectsPaint;
+
+            // Event handler props, e.g. `onMouseDown`, live on the JavaScript side.
+            const auto s = name.getCharPointer();
+
+            if (s[0] == 'o' && s[1] == 'n' && juce::CharacterFunctions::isUpperCase(s[2]))
+                return None;
+
+            // We can't know what a custom view does with its own properties.
+            return AffectsLayout | AffectsPaint;
+        }
+
+        /** Requests whatever layout and repaint the given property effects require. */
+        void requestPropertyUpdate (ViewId viewId, int effect)
+        {
+            if ((effect & AffectsLayout) != 0)
+                requestShadowTreeLayout();
+            if ((effect & AffectsPaint) != 0)
+                requestRepaint(viewId);
+        }
+
+        //==============================================================================
+        /** Applies a single property to a view and its shadow view. */
+        void applyViewProperty (View* view, ShadowView* shadow, const juce::Identifier& name, const juce::var& value)
+        {
+            // A layout-only view has no component of its own to hide.
+            if (view->isLayoutOnly() && (!ShadowView::isLayoutProperty(name) || name == IDs::display))
+                promoteLayoutOnlyView(view, shadow);
+
+            // A view without a shadow view, such as a span, takes everything.
+            const int consumers = shadow != nullptr ? getPropertyConsumers(*view, name) : ViewType::ConsumedByView;
+
+            if ((consumers & ViewType::ConsumedByShadow) != 0)
+                shadow->setProperty(name, value);
+
+            if ((consumers & ViewType::ConsumedByView) == 0)
+                return view->storePropertyValue(name, value);
+
+            if (name == IDs::propertyBindings)
+                setDeclaredPropertyBindings(view->getViewId(), value);
+
+            if (name == IDs::refId)
+            {
+                // Keep the refId index current; the view drops out of the index for
+                // its old refId and joins it for its new one.
+                removeFromRefIdIndex(view);
+                view->setProperty(name, value);
+
+                if (view->getRefId().isValid())
+                    refIdIndex[view->getRefId()].push_back(view);
+            }
+            else
+            {
+                view->setProperty(name, value);
+            }
+        }
+
+        /** Returns who consumes the given property of the given view, by way of
+            the view's registered type.
+         */
+        int getPropertyConsumers (View& view, const juce::Identifier& name)
+        {
+            if (auto* entry = viewTable.find(view.getViewId()))
+                if (entry->type != nullptr)
+                    return entry->type->getPropertyConsumers(name);
+
+            return ViewType::getDefaultPropertyConsumers(name);
+        }
+
+        /** Returns true if the scheduler has work to do right now. */
+        bool hasScheduledWork()
+        {
+            const double timerDeadline = timerQueue.getNextDeadline();
+
+            return realtimeEventsPending.load(std::memory_order_acquire)
+                || !pendingPointerEvents.empty()
+                || !pendingAnimationFrames.empty()
+                || !animations.empty()
+                || layoutAnimator.isAnimating()
+                || (timerDeadline >= 0.0 && timerDeadline <= getClockTime());
+        }
+
+        /** Runs a garbage collection if the root has been idle long enough, or
+            comes back for one when it will have been.
+         */
+        void collectGarbageIfIdle()
+        {
+            // A script thread's engine collects as it goes, off the message thread.
+            if (scriptThread != nullptr || hasScheduledWork())
+                return;
+
+            const double now = juce::Time::getMillisecondCounterHiRes();
+
+            // A button held down is as good as a gesture in progress; we look
+            // again once it might have been let go.
+            if (juce::ModifierKeys::currentModifiers.isAnyMouseButtonDown())
+            {
+                if (idleCollector.getNextCollectionTime() >= 0.0)
+                    scheduler.scheduleAfter(idleCollector.getOptions().idleDelayMs);
+
+                return;
+            }
+
+            if (idleCollector.collectIfDue(ctx, now, timerQueue.getNextDeadline()))
+            {
+                DBG("Idle garbage collection took " << idleCollector.getStats().lastPauseMs << "ms");
+                return;
+            }
+
+            const double due = idleCollector.getNextCollectionTime();
+
+            if (due >= 0.0)
+                scheduler.scheduleAfter(juce::jmax(due - now, idleCollector.getOptions().timerHeadroomMs));
+        }
+
+        /** Runs a bytecode bundle already checked by `evalBytecode`. */
+        void runBytecode (const void* bytecode, size_t bytecodeSize)
+        {
+            beginAllocationBurst();
+
+            // Duktape only reads from the buffer while it loads the function, so
+            // we can point it at the caller's memory rather than copy it.
+            {
+                const PerformanceStats::ScopedStartupPhase startupPhase (getStartupStats(), PerformanceStats::CompilePhase);
+
+                duk_push_external_buffer(ctx);
+                duk_config_buffer(ctx, -1, const_cast<void*>(bytecode), bytecodeSize);
+                duk_load_function(ctx);
+            }
+
+            {
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::EvaluationCall);
+                const PerformanceStats::ScopedStartupPhase startupPhase (getStartupStats(), PerformanceStats::EvaluationPhase);
+
+                if (duk_pcall(ctx, 0) != DUK_EXEC_SUCCESS) {
+                    printf("Script evaluation failed: %s\n", duk_safe_to_string(ctx, -1));
+                }
+            }
+
+            duk_pop(ctx);
+            runMicrotasks();
+            endAllocationBurst();
+            didEvaluateBundle();
+        }
+
+        /** Catches up with a freshly evaluated bundle. */
+        void didEvaluateBundle()
+        {
+            if (scriptThread == nullptr)
+                idleCollector.markBusy(juce::Time::getMillisecondCounterHiRes());
+
+            resetDispatchCache();
+
+            // Any timers the bundle queued have already scheduled the first wake-up;
+            // from there the timers wake us as needed.
+            scheduleTimers();
+        }
+
+        /** Stops any animation of the given view's property. */
+        void stopAnimations (ViewId viewId, const juce::Identifier& property)
+        {
+            animations.erase(std::remove_if(animations.begin(), animations.end(), [&](const auto& a) {
+                return a->viewId == viewId && a->property == property;
+            }), animations.end());
+        }
+
+        /** Returns the current value of a numeric property, for the start of an
+            animation.
+         */
+        static double getAnimatableValue (View& view, const juce::Identifier& property)
+        {
+            const auto& style = view.getStyle();
+
+            if (property == IDs::opacity)               return style.opacity;
+            if (property == IDs::transformRotate)       return style.rotation;
+            if (property == IDs::transformScale)        return style.scale;
+            if (property == IDs::transformScaleX)       return style.scaleX;
+            if (property == IDs::transformScaleY)       return style.scaleY;
+            if (property == IDs::transformSkewX)        return style.skewX;
+            if (property == IDs::transformSkewY)        return style.skewY;
+            if (property == IDs::transformTranslateX)   return style.translateX;
+            if (property == IDs::transformTranslateY)   return style.translateY;
+
+            return 0.0;
+        }
+
+        /** Returns the current value of a colour property, for the start of an
+            animation.
+         */
+        static juce::Colour getAnimatableColour (View& view, const juce::Identifier& property)
+        {
+            const auto& style = view.getStyle();
+
+            if (property == IDs::backgroundColor)   return style.backgroundColour;
+            if (property == IDs::borderColor)       return style.borderColour;
+
+            return style.textColour;
+        }
+
+        /** Replaces the bindings declared by a view's `propertyBindings` prop. */
+        void setDeclaredPropertyBindings (ViewId viewId, const juce::var& bindings)
+        {
+            propertyBindings.erase(std::remove_if(propertyBindings.begin(), propertyBindings.end(), [&](const ActiveBinding& b) {
+                return !b.refId.isValid() && b.viewId == viewId;
+            }), propertyBindings.end());
+
+            if (auto* o = bindings.getDynamicObject())
+            {
+                for (const auto& p : o->getProperties())
+                {
+                    auto source = bindingSources.find(p.value.toString());
+
+                    // If you hit this, the view binds to a source that was never
+                    // registered through registerBindingSource.
+                    jassert (source != bindingSources.end());
+
+                    if (source != bindingSources.end())
+                        propertyBindings.push_back({ {}, viewId, p.name, source->second.source, source->second.mapping });
+                }
+            }
+
+            if (!propertyBindings.empty())
+                scheduler.scheduleFrame();
+        }
+
+        /** Removes the given view from the refId index, if it's in there. */
+        void removeFromRefIdIndex (View* view)
+        {
+            const auto refId = view->getRefId();
+
+            if (!refId.isValid())
+                return;
+
+            auto it = refIdIndex.find(refId);
+
+            if (it != refIdIndex.end())
+            {
+                auto& views = it->second;
+                views.erase(std::remove(views.begin(), views.end(), view), views.end());
+
+                if (views.empty())
+                    refIdIndex.erase(it);
+            }
+        }
+
+        //==============================================================================
+        /** Pushes the stash, the named helper from it, and an array of the
+            callbacks of the given ids from the named store, skipping those
+            which have been cancelled. The store is swapped for a fresh one, for
+            the callbacks queued while these run.
+         */
+        void pushQueuedCallbacks (const char* helperName, const char* storeName, const std::vector<int>& ids)
+        {
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, helperName);
+            duk_get_prop_string(ctx, -2, storeName);
+
+            duk_push_object(ctx);
+            duk_put_prop_string(ctx, -4, storeName);
+
+            // Collect the callbacks which haven't been cancelled
+            const duk_idx_t callbacksIdx = duk_normalize_index(ctx, -1);
+            const duk_idx_t arrIdx = duk_push_array(ctx);
+            duk_uarridx_t numCallbacks = 0;
+
+            for (auto id : ids)
+            {
+                if (duk_get_prop_index(ctx, callbacksIdx, static_cast<duk_uarridx_t>(id)))
+                    duk_put_prop_index(ctx, arrIdx, numCallbacks++);
+                else
+                    duk_pop(ctx);
+            }
+
+            duk_remove(ctx, callbacksIdx);
+        }
+
+        /** Runs the idle callbacks queued so far, given the clock time by which
+            they should be done, each in turn within one call into the engine and
+            one commit. Callbacks requested from within a callback wait for the
+            next idle slot, so one which does a slice of work at a time and asks
+            again spreads its work over as many slots as it takes.
+         */
+        void runIdleCallbacks (double deadline)
+        {
+            if (pendingIdleCallbacks.empty())
+                return;
+
+            auto ids = std::move(pendingIdleCallbacks);
+            pendingIdleCallbacks.clear();
+
+            pushQueuedCallbacks("runIdleCallbacks", "idleCallbacks", ids);
+            duk_push_number(ctx, deadline);
+
+            beginCommit();
+
+            {
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::IdleCall);
+
+                if (duk_pcall(ctx, 2) != DUK_EXEC_SUCCESS)
+                    DBG("Duktape idle callback error: " << duk_safe_to_string(ctx, -1));
+            }
+
+            runMicrotasks();
+            endCommit();
+
+            duk_pop_2(ctx);
+        }
+
+        /** Runs the idle callbacks in what's left of the pass's budget, if the
+            root has nothing else to do, or comes back for them at the next frame.
+         */
+        void runIdleCallbacksIfIdle (double passStart)
+        {
+            if (pendingIdleCallbacks.empty())
+                return;
+
+            const double remainingMs = scheduledWorkBudgetMs - (juce::Time::getMillisecondCounterHiRes() - passStart);
+
+            if (remainingMs > 0.0 && !hasScheduledWork() && !isLoadingBundle())
+            {
+                runIdleCallbacks(getClockTime() + remainingMs);
+                idleCollector.markBusy(juce::Time::getMillisecondCounterHiRes());
+            }
+
+            if (!pendingIdleCallbacks.empty())
+                scheduler.scheduleFrame();
+        }
+
+        //==============================================================================
+        /** Runs this frame's animation frame callbacks.
+
+            Callbacks are run in the order they were requested, all within one call
+            into the script engine and one commit, so that everything they change
+            is laid out and painted once. Callbacks requested from within a
+            callback run at the following frame.
+         */
+        void runAnimationFrames()
+        {
+            auto ids = std::move(pendingAnimationFrames);
+            pendingAnimationFrames.clear();
+            nextAnimationFrameTime = -1.0;
+
+            const double timestamp = getClockTime();
+
+            pushQueuedCallbacks("runAnimationFrames", "animationFrameCallbacks", ids);
+            duk_push_number(ctx, timestamp);
+
+            // Values read from a value channel within the frame are as of now.
+            updateValueChannels();
+
+            beginCommit();
+
+            {
+                const ScriptWatchdog::ScopedCall watchdogCall (watchdog);
+                const PerformanceStats::ScopedScriptCall statsCall (getScriptCallStats(), PerformanceStats::AnimationFrameCall);
+
+                if (duk_pcall(ctx, 2) != DUK_EXEC_SUCCESS)
+                    DBG("Duktape animation frame error: " << duk_safe_to_string(ctx, -1));
+            }
+
+            // Promise jobs the frame started commit with it.
+            runMicrotasks();
+            endCommit();
+
+            duk_pop_2(ctx);
+
+            // A callback may have requested the next frame, in which case it has
+            // already been scheduled.
+        }
+
+        //==============================================================================
+        /** Keeps an event dispatched while we're hidden, in place of any earlier one
+            of the same type, and asks for a callback for when we show again.
+            A worker's messages each carry something of their own, so those all
+            wait, in order.
+         */
+        void holdEventWhileHidden (const juce::Identifier& eventType, std::function<void()> dispatch)
+        {
+            // Tree changes and note grid diffs are patches on the ones before, so
+            // none can be dropped.
+            const bool keepsEach = eventType == IDs::workerMessage || eventType == IDs::workerError
+                                || eventType == IDs::valueTreeChange || eventType == IDs::noteGridChange;
+
+            for (auto& [type, heldDispatch] : eventsHeldWhileHidden)
+            {
+                if (type == eventType && !keepsEach)
+                {
+                    heldDispatch = std::move(dispatch);
+                    return;
+                }
+            }
+
+            eventsHeldWhileHidden.emplace_back(eventType, std::move(dispatch));
+            scheduler.scheduleFrame();
+        }
+
+        /** Dispatches the events held while we were hidden, in one commit. */
+        void dispatchEventsHeldWhileHidden()
+        {
+            if (eventsHeldWhileHidden.empty() || isLoadingBundle())
+                return;
+
+            auto held = std::move(eventsHeldWhileHidden);
+            eventsHeldWhileHidden.clear();
+
+            const auto dispatchAll = [this, held = std::move(held)]() {
+                beginCommit();
+
+                for (auto& [type, dispatch] : held)
+                    dispatch();
+
+                endCommit();
+            };
+
+            if (scriptThread != nullptr)
+                callIntoScript(dispatchAll);
+            else
+                dispatchAll();
+        }
+
+        //==============================================================================
+        /** Returns the stats to time calls into JavaScript against, or nullptr
+            when the engine has a thread of its own, whose calls we don't time.
+         */
+        PerformanceStats* getScriptCallStats()
+        {
+            return scriptThread == nullptr ? &performanceStats : nullptr;
+        }
+
+        /** Returns the stats to time startup phases against, or nullptr once the
+            root has painted what its bundle built. Safe to call from any thread.
+         */
+        PerformanceStats* getStartupStats()
+        {
+            return performanceStats.isStartingUp() ? &performanceStats : nullptr;
+        }
+
+        /** Returns true while the root is starting up, if the given phase has yet
+            to begin.
+         */
+        bool isStartingUp (PerformanceStats::StartupPhase phase) const
+        {
+            return performanceStats.isStartingUp() && !performanceStats.hasBegunStartupPhase(phase);
+        }
+
+        //==============================================================================
+        /** Returns true if called on the root's script thread. */
+        bool isOnScriptThread() const
+        {
+            return scriptThread != nullptr && scriptThread->isCurrentThread();
+        }
+
+        /** Returns true if called on the thread the engine runs on: the script
+            thread if there is one, or else the message thread.
+         */
+        bool isOnEngineThread() const
+        {
+            return scriptThread != nullptr ? scriptThread->isCurrentThread()
+                                           : juce::MessageManager::getInstance()->isThisTheMessageThread();
+        }
+
+        /** Starts a script thread, which runs the timers while it's idle. */
+        void startScriptThread()
+        {
+            scriptThread = std::make_unique<ScriptThread>([this]() { return runScriptIdleWork(); });
+        }
+
+        /** Forgets everything in flight between the message and script threads,
+            once the script thread has stopped.
+         */
+        void resetScriptThreadState()
+        {
+            scriptCommit.clear();
+            scriptCommitDepth = 0;
+            scriptSeenInputId = 0;
+            scriptCommittedInputId = 0;
+
+            {
+                const juce::ScopedLock sl (completedCommitsLock);
+                completedCommits.clear();
+            }
+
+            viewIdsFromScript.clear();
+            viewIdsToScript.clear();
+            scriptSurfaceIds.clear();
+            scriptOverlayIds.clear();
+            scriptAnimationFramePending = false;
+            realtimeFlushPosted = false;
+        }
+
+        /** Queues a call into the engine on the script thread. Whatever the call
+            asks of the message thread follows as a commit once it returns.
+         */
+        void callIntoScript (std::function<void()> call)
+        {
+            jassert (scriptThread != nullptr);
+
+            scriptThread->post([this, call = std::move(call)]() {
+                call();
+                closeScriptCommit();
+            });
+        }
+
+        /** Runs the given work on the message thread: right away, or, from the
+            script thread, as part of the commit the script is building.
+         */
+        void runOnMessageThread (std::function<void()> work)
+        {
+            if (isOnScriptThread())
+                scriptCommit.push_back(std::move(work));
+            else
+                work();
+        }
+
+        /** Hands the script thread's commit to the message thread, unless a
+            reconciler commit is still open.
+         */
+        void closeScriptCommit()
+        {
+            if (scriptCommitDepth > 0 || scriptCommit.empty())
+                return;
+
+            if (scriptSeenInputId != scriptCommittedInputId)
+            {
+                scriptCommittedInputId = scriptSeenInputId;
+                scriptCommit.push_back([this, inputId = scriptSeenInputId]() { seenInputId = juce::jmax(seenInputId, inputId); });
+            }
+
+            {
+                const juce::ScopedLock sl (completedCommitsLock);
+                completedCommits.push_back(std::move(scriptCommit));
+            }
+
+            scriptCommit.clear();
+            triggerAsyncUpdate();
+        }
+
+        /** Applies every commit the script thread has completed, each as a single
+            commit of our own, so that nothing paints a commit half applied.
+         */
+        void applyCompletedCommits()
+        {
+            std::vector<std::vector<std::function<void()>>> commits;
+
+            {
+                const juce::ScopedLock sl (completedCommitsLock);
+                commits.swap(completedCommits);
+            }
+
+            for (auto& commit : commits)
+            {
+                beginCommit();
+
+                for (auto& work : commit)
+                    work();
+
+                endCommit();
+            }
+        }
+
+        /** Runs the due timers on the script thread, returning the time until the
+            next is due, or -1 if there are none.
+         */
+        int runScriptIdleWork()
+        {
+            const double deadline = timerQueue.getNextDeadline();
+
+            // Tasks, events among them, run ahead of the thread's idle work, and
+            // the timers stop early for any that arrive.
+            if (deadline >= 0.0 && deadline <= getClockTime())
+            {
+                runTimers(timerLaneBudgetMs);
+                closeScriptCommit();
+            }
+
+            // Idle callbacks have the thread whenever the timers leave it free.
+            if (!pendingIdleCallbacks.empty() && !isLoadingBundle())
+            {
+                runIdleCallbacks(getClockTime() + scheduledWorkBudgetMs);
+                closeScriptCommit();
+
+                // More queued from within one wait a frame, as those on the
+                // message thread do, so they never busy the thread outright.
+                if (!pendingIdleCallbacks.empty())
+                    return scriptIdleCallbackIntervalMs;
+            }
+
+            const double next = timerQueue.getNextDeadline();
+
+            if (next < 0.0)
+                return -1;
+
+            return juce::jmax(1, (int) std::ceil(next - getClockTime()));
+        }
+
+        /** The message thread's share of the scheduled work with a script thread,
+            to which the engine's share goes.
+         */
+        void runScheduledWorkAlongsideScript()
+        {
+            // Realtime events are formatted straight into the engine, so the
+            // script thread drains their queue; one flush in flight is plenty.
+            if (!isLoadingBundle() && !realtimeFlushPosted.exchange(true))
+            {
+                callIntoScript([this]() {
+                    realtimeFlushPosted = false;
+                    flushRealtimeEvents();
+                });
+            }
+
+            flushPointerEvents();
+            flushParameterWrites();
+            updatePropertyBindings();
+            runAnimations();
+            runLayoutTransitions();
+            runStartupSnapshotFade();
+
+            if (scriptAnimationFramePending)
+            {
+                scriptAnimationFramePending = false;
+                callIntoScript([this]() { runAnimationFrames(); });
+            }
+
+            destroyBuriedViews();
+            continueRescale();
+        }
+
+        /** Returns the view id the engine knows a view by, or 0 if the engine
+            doesn't know it.
+         */
+        ViewId toScriptViewId (ViewId viewId) const
+        {
+            if (scriptThread == nullptr || viewId == getViewId())
+                return viewId;
+
+            const auto it = viewIdsToScript.find(viewId);
+            return it != viewIdsToScript.end() ? it->second : 0;
+        }
+
+        /** Returns the view the engine knows by the given id, or 0 if there's no
+            such view.
+         */
+        ViewId fromScriptViewId (ViewId scriptId) const
+        {
+            if (scriptThread == nullptr || scriptId == getViewId())
+                return scriptId;
+
+            const auto it = viewIdsFromScript.find(scriptId);
+            return it != viewIdsFromScript.end() ? it->second : 0;
+        }
+
+        void mapScriptViewId (ViewId scriptId, ViewId viewId)
+        {
+            viewIdsFromScript[scriptId] = viewId;
+            viewIdsToScript[viewId] = scriptId;
+        }
+
+        void forgetScriptViewId (ViewId viewId)
+        {
+            const auto it = viewIdsToScript.find(viewId);
+
+            if (it == viewIdsToScript.end())
+                return;
+
+            viewIdsFromScript.erase(it->second);
+            viewIdsToScript.erase(it);
+        }
+
+        //==============================================================================
+        /** Asks the scheduler to wake us when the next timer is due. */
+        void scheduleTimers()
+        {
+            // The script thread keeps its own time.
+            if (scriptThread != nullptr)
+                return scriptThread->wake();
+
+            const double deadline = timerQueue.getNextDeadline();
+
+            if (deadline >= 0.0)
+                scheduler.scheduleAfter(deadline - getClockTime());
+        }
+
+        //==============================================================================
+        /** Dispatches the coalesced Measure events. */
+        void handleAsyncUpdate() override
+        {
+            if (scriptThread != nullptr)
+                applyCompletedCommits();
+
+            settleCompletedAsyncCalls();
+
+            // Handlers may well cause new layouts and so new Measure events, which
+            // then go out in the next update. Those of a live resize wait for
+            // its end, and go out for the final size alone.
+            std::map<ViewId, std::pair<float, float>> events;
+
+            if (!liveResizing)
+            {
+                events = std::move(pendingMeasureEvents);
+                pendingMeasureEvents.clear();
+            }
+
+            auto loadEvents = std::move(pendingLoadEvents);
+            pendingLoadEvents.clear();
+
+            auto rangeEvents = std::move(pendingVisibleRangeEvents);
+            pendingVisibleRangeEvents.clear();
+
+            auto valueEvents = std::move(pendingValueChangeEvents);
+            pendingValueChangeEvents.clear();
+
+            auto noteEvents = std::move(pendingNoteChangeEvents);
+            pendingNoteChangeEvents.clear();
+
+            for (const auto& [viewId, size] : events)
+                if (viewTable.find(viewId) != nullptr)
+                    dispatchViewEvent(viewId, IDs::Measure, size.first, size.second);
+
+            for (const auto& [viewId, size] : loadEvents)
+                if (viewTable.find(viewId) != nullptr)
+                    dispatchViewEvent(viewId, IDs::Load, size.first, size.second);
+
+            for (const auto& [viewId, range] : rangeEvents)
+                if (viewTable.find(viewId) != nullptr)
+                    dispatchViewEvent(viewId, IDs::VisibleRangeChange, range.first, range.second);
+
+            for (const auto& [viewId, value] : valueEvents)
+                if (viewTable.find(viewId) != nullptr)
+                    dispatchViewEvent(viewId, IDs::ValueChange, value);
+
+            for (const auto& [viewId, changes] : noteEvents)
+            {
+                if (viewTable.find(viewId) == nullptr)
+                    continue;
+
+                juce::Array<juce::var> notes;
+
+                for (const auto& [note, velocity] : changes)
+                {
+                    auto* change = new juce::DynamicObject();
+                    change->setProperty(IDs::note, note);
+                    change->setProperty(IDs::velocity, velocity);
+                    notes.add(juce::var(change));
+                }
+
+                dispatchViewEvent(viewId, IDs::NoteChange, juce::var(notes));
+            }
+
+            dispatchNoteGridDiffs();
+        }
+
+        //==============================================================================
+        /** Runs the layout and repaints deferred during a commit. */
+        void flushPendingCommitWork()
+        {
+            performanceStats.didRespondToInput(seenInputId);
+            insertAllPendingChildComponents();
+
+            for (auto id : pendingRemounts)
+            {
+                if (id == getViewId())
+                    remountChildren(*_shadowView);
+                else if (auto* entry = viewTable.find(id))
+                    remountChildren(*entry->shadowView);
+            }
+
+            pendingRemounts.clear();
+
+            if (layoutPending)
+            {
+                layoutPending = false;
+                performShadowTreeLayout();
+            }
+
+            // We hold view ids rather than pointers here because a view may have been
+            // removed and destroyed in the same commit that requested its repaint.
+            // The areas are merged in our own coordinates, so that the commit asks
+            // for one consolidated region, however many views it touched.
+            juce::RectangleList<int> dirtyArea;
+
+            for (auto& [id, pending] : pendingRepaints)
+            {
+                View* view = this;
+
+                if (id != getViewId())
+                {
+                    auto* entry = viewTable.find(id);
+
+                    if (entry == nullptr)
+                        continue;
+
+                    view = entry->view.get();
+                }
+
+                if (pending.textArea)
+                    if (auto* textView = viewCast<TextView>(view))
+                        pending.area.add(textView->getTextArea());
+
+                addDirtyArea(dirtyArea, *view, pending.area);
+            }
+
+            pendingRepaints.clear();
+            releaseViewsInScript();
+
+            dirtyArea.consolidate();
+
+            for (const auto& r : dirtyArea)
+            {
+                repaint(r);
+                flashRepaint(*this, r);
+            }
+
+            performanceStats.getCurrentFrame().numRepaints += dirtyArea.getNumRectangles();
+        }
+
+        /** Flashes an area of the given component, just repainted, on the
+            performance overlay.
+         */
+        void flashRepaint (juce::Component& c, const juce::Rectangle<int>& area)
+        {
+            // Surfaces have no overlay of their own.
+            if (performanceOverlay == nullptr || !isParentOf(&c))
+                return;
+
+            performanceOverlay->addRepaint(getLocalArea(&c, area), getClockTime());
+            scheduler.scheduleFrame();
+        }
+
+        /** Takes the next object census sample, when it's due. */
+        void sampleObjectCensus()
+        {
+            const double now = juce::Time::getMillisecondCounterHiRes();
+
+            if (!objectCensus.isSampleDue(now))
+                return;
+
+            BLUEPRINT_TRACE_SCOPE("sampleObjectCensus");
+
+            ObjectCensus::Sample sample;
+            sample.time = now;
+            sample.numViews = LiveObjectCounter<View>::getNumLive();
+            sample.numShadowViews = LiveObjectCounter<ShadowView>::getNumLive();
+            sample.numYogaNodes = static_cast<int>(YGNodeGetInstanceCount());
+            sample.numRawTextViews = LiveObjectCounter<RawTextView>::getNumLive();
+            sample.numTableEntries = static_cast<int>(viewTable.size());
+            sample.numBuriedViews = static_cast<int>(buriedViews.size());
+            sample.numPooledViews = static_cast<int>(rawTextViewType.pool.size());
+            sample.scriptViewRegistrySize = objectCensus.getScriptViewRegistrySize();
+
+            std::unordered_map<const ViewType*, juce::String> typeNames { { &rawTextViewType, "RawText" } };
+
+            for (const auto& [name, type] : viewTypes)
+            {
+                typeNames[&type] = name;
+                sample.numPooledViews += static_cast<int>(type.pool.size());
+            }
+
+            std::map<juce::String, int> typeCounts;
+
+            viewTable.forEach([&](ViewId, const ViewTable::Entry& entry) {
+                auto it = typeNames.find(entry.type);
+                typeCounts[it != typeNames.end() ? it->second : juce::String("Other")]++;
+            });
+
+            objectCensus.addSample(sample, std::move(typeCounts));
+        }
+
+        /** Repaints the performance overlay for the frame just completed, coming
+            back next frame while its flashes fade.
+         */
+        void updatePerformanceOverlay()
+        {
+            if (performanceOverlay != nullptr && performanceOverlay->update(getClockTime()))
+                scheduler.scheduleFrame();
+        }
+
+        /** Adds an area of the given view to the dirty area of the commit, in our
+            own coordinates.
+
+            A view painted from a cached image, or inside of one, has to be told
+            itself, because only its own repaint invalidates the image.
+         */
+        void addDirtyArea (juce::RectangleList<int>& dirtyArea, View& view, juce::RectangleList<int>& area)
+        {
+            if (&view != this && !view.isShowing())
+                return;
+
+            area.clipTo(view.getLocalBounds());
+
+            for (auto* c = static_cast<juce::Component*>(&view); c != this; c = c->getParentComponent())
+            {
+                // Reaching the top without finding us, the view is in a surface's
+                // window, and repaints there.
+                if (c == nullptr || c->getCachedComponentImage() != nullptr)
+                {
+                    for (const auto& r : area)
+                    {
+                        view.repaint(r);
+                        flashRepaint(view, r);
+                    }
+
+                    performanceStats.getCurrentFrame().numRepaints += area.getNumRectangles();
+
+                    return;
+                }
+            }
+
+            for (const auto& r : area)
+                dirtyArea.add(getLocalArea(&view, r));
+        }
+
+        //==============================================================================
+        /** Mounts a child just added to the given parent in the shadow tree.
+
+            Children of a real view go straight into it, unless the parent has
+            layout-only children, whose own children are interleaved with theirs,
+            and we're inserting rather than appending. Everything else goes through
+            the remount of the nearest real ancestor. A parent still waiting to be
+            added to the tree has no such ancestor yet, and its children are
+            mounted when it is added.
+         */
+        void mountChild (View* parentView, ShadowView* parentShadow, View* childView, ShadowView* childShadow, int index)
+        {
+            if (childView->isLayoutOnly() && !parentView->isLayoutOnly() && !canMountLayoutOnlyChildren(parentView))
+                promoteLayoutOnlyView(childView, childShadow);
+
+            if (!parentView->isLayoutOnly() && !childView->isLayoutOnly() && (index == -1 || !hasLayoutOnlyChildren(*parentShadow)))
+                return insertChildComponent(parentView, childView, index);
+
+            if (auto* host = findMountingAncestor(parentShadow))
+                requestRemount(host->getAssociatedView()->getViewId());
+        }
+
+        /** Adds a child's component to its parent's, or, within a commit and with
+            the parent off screen, defers that to the end of the commit.
+
+            React builds a new subtree from the leaves up, each parent taking its
+            children before it has a parent of its own, and each component added
+            tells every component below it that its hierarchy changed. Deferred,
+            the subtree's components are added from the top down, each while it
+            has nothing below it yet, and when the subtree is placed on screen
+            its components are added before it is, so that the components on
+            screen hear of the whole subtree once.
+         */
+        void insertChildComponent (View* parentView, View* childView, int index)
+        {
+            if (commitDepth > 0 && parentView->getPeer() == nullptr)
+                return pendingInsertions[parentView].push_back({ childView, index });
+
+            insertPendingChildComponents(childView);
+            parentView->addChild(childView, index);
+        }
+
+        /** Adds the deferred children of the given view, and then theirs, in the
+            order they were added.
+         */
+        void insertPendingChildComponents (View* view)
+        {
+            auto it = pendingInsertions.find(view);
+
+            if (it == pendingInsertions.end())
+                return;
+
+            const auto children = std::move(it->second);
+            pendingInsertions.erase(it);
+
+            for (const auto& child : children)
+                view->addChild(child.first, child.second);
+
+            for (const auto& child : children)
+                insertPendingChildComponents(child.first);
+        }
+
+        /** Adds every deferred child component, from the tops of the subtrees
+            down, before anything reads the component tree.
+         */
+        void insertAllPendingChildComponents()
+        {
+            if (pendingInsertions.empty())
+                return;
+
+            std::set<View*> pendingChildren;
+            std::vector<View*> tops;
+
+            for (const auto& p : pendingInsertions)
+                for (const auto& child : p.second)
+                    pendingChildren.insert(child.first);
+
+            for (const auto& p : pendingInsertions)
+                if (pendingChildren.count(p.first) == 0)
+                    tops.push_back(p.first);
+
+            for (auto* view : tops)
+                insertPendingChildComponents(view);
+
+            jassert (pendingInsertions.empty());
+        }
+
+        /** Moves a mounted component just behind the given sibling, or with no
+            sibling in front of the rest, without taking it off its parent.
+         */
+        static void moveMountedComponent (juce::Component& child, juce::Component* nextSibling)
+        {
+            if (child.getParentComponent() == nullptr)
+                return;
+
+            if (nextSibling != nullptr)
+                child.toBehind(nextSibling);
+            else
+                child.toFront(false);
+        }
+
+        /** Makes a layout-only view a real one, mounting it in place of its
+            children.
+         */
+        void promoteLayoutOnlyView (View* view, ShadowView* shadow)
+        {
+            view->setLayoutOnly(false);
+
+            // A parent which can't mount layout-only children, such as a ScrollView,
+            // promotes a child so as to mount it itself, with no remount.
+            if (auto* host = findMountingAncestor(shadow->getParent()))
+                if (canMountLayoutOnlyChildren(host->getAssociatedView()))
+                    requestRemount(host->getAssociatedView()->getViewId());
+
+            if (!shadow->getChildren().empty())
+            {
+                requestRemount(view->getViewId());
+                shadow->updateChildOffsets();
+            }
+        }
+
+        /** Brings the components mounted on the given real view in line with the
+            shadow tree: its children, with each layout-only child replaced by
+            that child's own children, in order.
+         */
+        void remountChildren (ShadowView& shadow)
+        {
+            View* view = shadow.getAssociatedView();
+            std::vector<View*> expected, current;
+
+            jassert (canMountLayoutOnlyChildren(view));
+
+            collectMountedViews(shadow, expected);
+
+            // Everything mounted on a plain view is one of our views, so only the
+            // root, which also holds its covers and overlay layer, needs a cast.
+            for (auto* child : view->getChildren())
+            {
+                if (view != this)
+                    current.push_back(static_cast<View*>(child));
+                else if (auto* childView = dynamic_cast<View*>(child))
+                    current.push_back(childView);
+            }
+
+            if (current == expected)
+                return;
+
+            // Anything mounted here which no longer belongs, such as the children of
+            // a child just promoted, is picked up by its own view's remount.
+            for (auto* child : current)
+                view->removeChildComponent(child);
+
+            for (auto* child : expected)
+                view->addChild(child);
+        }
+
+        void collectMountedViews (ShadowView& shadow, std::vector<View*>& views)
+        {
+            for (auto* child : shadow.getChildren())
+            {
+                if (child->getAssociatedView()->isLayoutOnly())
+                    collectMountedViews(*child, views);
+                else
+                    views.push_back(child->getAssociatedView());
+            }
+        }
+
+        /** Returns the nearest node, from the given one up, whose view is real, or
+            nullptr if the node isn't yet in the tree.
+         */
+        ShadowView* findMountingAncestor (ShadowView* shadow)
+        {
+            while (shadow != nullptr && shadow->getAssociatedView()->isLayoutOnly())
+                shadow = shadow->getParent();
+
+            return shadow;
+        }
+
+        static bool hasLayoutOnlyChildren (ShadowView& shadow)
+        {
+            for (auto* child : shadow.getChildren())
+                if (child->getAssociatedView()->isLayoutOnly())
+                    return true;
+
+            return false;
+        }
+
+        /** Only plain views and the root mount their children as components of
+            their own; a ScrollView, say, mounts them in its viewport.
+         */
+        bool canMountLayoutOnlyChildren (View* view)
+        {
+            return view == this || view->mountsChildComponents();
+        }
+
+        //==============================================================================
+        /** Registers each of the natively supported view types. */
+        void installNativeViewTypes()
+        {
+            // The most numerous types recycle their views, which reset
+            // themselves entirely in resetForReuse.
+            const ViewResetter recycle = [](View&, ShadowView*) {};
+
+            registerViewType("Text", []() -> ViewPair {
+                auto view = std::make_unique<TextView>();
+                auto shadowView = std::make_unique<TextShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            }, recycle);
+
+            // Text measures by these as well as painting with them.
+            for (const auto& name : { IDs::fontSize, IDs::fontStyle, IDs::fontFamily,
+                                      IDs::kerningFactor, IDs::lineSpacing, IDs::wordWrap })
+                declareViewTypeProperty("Text", name, ViewType::ConsumedByBoth);
+
+            // A <Text> within another, whose text is its text view's to lay out.
+            registerViewType("TextSpan", []() -> ViewPair {
+                return {std::make_unique<TextSpanView>(), nullptr};
+            }, recycle);
+
+            registerViewType("View", []() -> ViewPair {
+                auto view = std::make_unique<View>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            }, recycle);
+
+            registerViewType("Image", []() -> ViewPair {
+                auto view = std::make_unique<ImageView>();
+
+                // An image left to size itself takes its drawable's natural
+                // bounds, in proportion.
+                auto shadowView = std::make_unique<MeasuredShadowView>(view.get(), [v = view.get()]() {
+                    return v->getNaturalBounds();
+                });
+
+                return {std::move(view), std::move(shadowView)};
+            }, recycle);
+
+            registerViewType("ScrollView", []() -> ViewPair {
+                auto view = std::make_unique<ScrollView>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+
+            registerViewType("Scope", []() -> ViewPair {
+                auto view = std::make_unique<ScopeView>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+
+            registerViewType("Slider", []() -> ViewPair {
+                auto view = std::make_unique<SliderView>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+
+            registerViewType("Filmstrip", []() -> ViewPair {
+                auto view = std::make_unique<FilmstripView>();
+
+                // Left to size itself, a filmstrip takes the size of a frame.
+                auto shadowView = std::make_unique<MeasuredShadowView>(view.get(), [v = view.get()]() {
+                    return v->getNaturalBounds();
+                });
+
+                return {std::move(view), std::move(shadowView)};
+            });
+
+            registerViewType<MeterView>("Meter");
+            registerViewType<KeyboardView>("Keyboard");
+            registerViewType<NoteGridView>("NoteGrid");
+
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+            registerViewType<ShaderView>("Shader");
+#endif
+
+            registerViewType("TextInput", []() -> ViewPair {
+                auto view = std::make_unique<TextInputView>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+            registerViewType("Spectrum", []() -> ViewPair {
+                auto view = std::make_unique<SpectrumView>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+#endif
+
+            registerViewType("VirtualList", []() -> ViewPair {
+                auto view = std::make_unique<VirtualListView>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_formats
+            registerViewType("Waveform", []() -> ViewPair {
+                auto view = std::make_unique<WaveformView>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+#endif
+
+            registerViewType("Canvas", []() -> ViewPair {
+                auto view = std::make_unique<CanvasView>();
+                auto shadowView = std::make_unique<ShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+
+            registerViewType("ScrollViewContentView", []() -> ViewPair {
+                auto view = std::make_unique<View>();
+                auto shadowView = std::make_unique<ScrollViewContentShadowView>(view.get());
+
+                return {std::move(view), std::move(shadowView)};
+            });
+        }
+
+        //==============================================================================
+        /** The Yoga config of all our nodes: web defaults, with layout snapped to
+            whole pixels, on which components sit. It's freed after the nodes.
+         */
+        struct YogaConfig
+        {
+            YogaConfig()
+            {
+                YGConfigSetUseWebDefaults(config, true);
+                YGConfigSetPointScaleFactor(config, 1.0f);
+            }
+
+            ~YogaConfig() { YGConfigFree(config); }
+
+            YGConfigRef config = YGConfigNew();
+        };
+
+        YogaConfig yogaConfig;
+        std::unique_ptr<ShadowView> _shadowView;
+        ViewTable viewTable;
+
+        std::unique_ptr<juce::ThreadPool> layoutThreadPool;
+        juce::uint32 asyncLayoutGeneration = 0;
+        bool asyncLayoutInFlight = false;
+        bool asyncLayoutPending = false;
+
+        std::shared_ptr<juce::ThreadPool> paneLayoutPool;
+        LayoutSnapshot::PaneCache paneLayoutCache;
+
+        // The shadow tree's revision and size as of the last layout, or zero to
+        // lay out the whole tree next time.
+        juce::uint64 laidOutRevision = 0;
+        float laidOutWidth = 0.0f;
+        float laidOutHeight = 0.0f;
+
+        // Removed subtrees, children before parents, awaiting destruction in
+        // idle time. A frame or so is enough for the commit to have painted.
+        std::deque<ViewTable::Entry> buriedViews;
+        static constexpr double burialDelayMs = 20.0;
+        static constexpr double burialSliceMs = 2.0;
+
+        // The scheduler's lane budgets: timers stop after their own, leaving the
+        // rest for the next pass, and idle work only runs while the whole pass
+        // is within its own.
+        static constexpr double timerLaneBudgetMs = 4.0;
+        static constexpr double scheduledWorkBudgetMs = 8.0;
+
+        // The script thread's pause between idle slots while callbacks keep
+        // asking for more, about a frame.
+        static constexpr int scriptIdleCallbackIntervalMs = 16;
+
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+        std::unique_ptr<juce::OpenGLContext> openGLContext;
+#endif
+
+        //==============================================================================
+        /** Paints what the root paints over its views, once per paint. */
+        void paintOverViews (juce::Graphics& g)
+        {
+            performanceStats.didPaint();
+            performanceStats.endStartupPhase(PerformanceStats::FirstPaintPhase);
+
+            // The views mounted by now hold what they use of the preloaded assets.
+            preloadedAssets = nullptr;
+
+            lastPaintScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+            // After a change of display scale, caches which drew their old
+            // images scaled wait for an idle frame to render again.
+            if (RescaleBudget::takeDeferred())
+            {
+                rescalePending = true;
+                scheduler.scheduleFrame();
+            }
+
+            paintProfiler.closePaint();
+
+            if (performanceOverlay != nullptr)
+            {
+                if (paintProfiler.isEnabled())
+                    performanceOverlay->paintHeatmap(g, getPaintCosts());
+
+                performanceOverlay->paint(g, performanceStats, getHeapStats(), getClockTime());
+            }
+        }
+
+        /** Returns what each mounted view costs to paint, over its area, for the
+            performance overlay's heatmap.
+         */
+        std::vector<PerformanceOverlay::PaintCost> getPaintCosts()
+        {
+            std::vector<PerformanceOverlay::PaintCost> costs;
+
+            for (const auto& cost : paintProfiler.getViewCosts())
+                if (auto* entry = viewTable.find(cost.viewId))
+                    if (entry->view != nullptr && entry->view->isShowing() && isParentOf(entry->view.get()))
+                        costs.push_back({ getLocalArea(entry->view.get(), entry->view->getLocalBounds()), cost.ms });
+
+            return costs;
+        }
+
+        /** Installs a TiledRasterizer, or removes it, as tiledRasterizationEnabled
+            says, leaving alone any cached image of OpenGL's or a buffered root's.
+         */
+        void updateTiledRasterizer()
+        {
+            auto* current = getCachedComponentImage();
+
+            if (tiledRasterizationEnabled && current == nullptr)
+                setCachedComponentImage(new TiledRasterizer(*this, [this](juce::Graphics& g) { paintOverViews(g); }));
+            else if (!tiledRasterizationEnabled && dynamic_cast<TiledRasterizer*>(current) != nullptr)
+                setCachedComponentImage(nullptr);
+        }
+
+        bool tiledRasterizationEnabled = false;
+
+        // More than one view may briefly share a refId, e.g. while React mounts a
+        // replacement before unmounting the original.
+        std::unordered_map<juce::Identifier, std::vector<View*>, IdentifierHash> refIdIndex;
+        std::map<juce::String, ViewType> viewTypes;
+
+        // Raw text views aren't registered by name, but recycle all the same.
+        ViewType rawTextViewType { nullptr, [](View&, ShadowView*) {}, {} };
+
+        // Enough for a large tab's worth of each type.
+        static constexpr size_t maxPooledViewsPerType = 256;
+
+        std::vector<juce::Identifier> propertyNames;
+        std::unordered_map<juce::Identifier, int, IdentifierHash> propertyIdMap;
+
+        // Never changed once registered, so views can apply them unlocked.
+        std::vector<std::shared_ptr<const StyleSheet>> styleSheets;
+        juce::SpinLock styleSheetLock;
+
+        int commitDepth = 0;
+        bool layoutPending = false;
+        /** A repaint deferred to the end of a commit. */
+        struct PendingRepaint
+        {
+            // In the view's own coordinates, as of the request.
+            juce::RectangleList<int> area;
+
+            // Whether to add the view's text area too, once the commit's layout
+            // has placed the text.
+            bool textArea = false;
+        };
+
+        std::map<ViewId, PendingRepaint> pendingRepaints;
+        std::set<ViewId> pendingRemounts;
+        std::map<View*, std::vector<std::pair<View*, int>>> pendingInsertions;
+
+        // Removed views JavaScript hasn't yet heard of, by the ids it knows.
+        std::vector<ViewId> releasedScriptViewIds;
+        std::map<ViewId, std::pair<float, float>> pendingMeasureEvents;
+        std::map<ViewId, std::pair<float, float>> heldMeasureEvents;
+        std::map<ViewId, std::pair<float, float>> pendingLoadEvents;
+        std::map<ViewId, std::pair<int, int>> pendingVisibleRangeEvents;
+        std::map<ViewId, double> pendingValueChangeEvents;
+        std::map<ViewId, std::vector<std::pair<int, float>>> pendingNoteChangeEvents;
+
+        struct PendingPointerEvent
+        {
+            ViewId viewId;
+            PointerEventType type;
+            juce::Point<float> position;
+            juce::Point<float> mouseDownPosition;
+            juce::Point<float> delta;
+        };
+
+        // In arrival order; a frame's worth rarely holds more than a few.
+        std::vector<PendingPointerEvent> pendingPointerEvents;
+
+        // The latest of each type of event dispatched while we're hidden.
+        std::vector<std::pair<juce::Identifier, std::function<void()>>> eventsHeldWhileHidden;
+
+        std::vector<ViewId> propagationPathStorage;
+
+        FrameScheduler scheduler;
+        double maxFrameRate = 0.0;
+        bool lowPowerMode = false;
+
+        // A quarter of the display's, enough for meters and a responsive feel.
+        static constexpr double lowPowerFrameRate = 15.0;
+
+        TimerQueue timerQueue;
+        IdleCollector idleCollector;
+        int allocationBurstDepth = 0;
+        duk_int_t savedCollectionTrigger = 0;
+        ScriptWatchdog watchdog;
+        ScriptProfiler scriptProfiler;
+        PerformanceStats performanceStats;
+        PaintProfiler paintProfiler;
+        ObjectCensus objectCensus;
+        std::unique_ptr<PerformanceOverlay> performanceOverlay;
+        bool performanceOverlayHotkeyEnabled = false;
+        std::unique_ptr<BridgeRecorder> bridgeRecorder;
+
+        //==============================================================================
+        /** Reads and compiles a bundle in the background, then hands the bytecode
+            back to the root on the message thread.
+         */
+        class BundleLoader : public juce::Thread
+        {
+        public:
+            BundleLoader (ReactApplicationRoot& _root, int _loadId, const juce::File& _bundle,
+                          const juce::File& _cacheDirectory, std::function<void(bool)> _onComplete)
+                : juce::Thread("Blueprint bundle loader"),
+                  loadId(_loadId),
+                  onComplete(std::move(_onComplete)),
+                  root(&_root),
+                  startupStats(_root.getStartupStats()),
+                  bundle(_bundle),
+                  cacheDirectory(_cacheDirectory)
+            {
+            }
+
+            ~BundleLoader() override
+            {
+                // A compile can't be interrupted, and killing the thread part way
+                // through one would be worse than waiting for it.
+                stopThread(-1);
+            }
+
+            void run() override
+            {
+                juce::String error;
+                auto compiled = getSharedBytecode(*assetStore, bundle, cacheDirectory, error, startupStats);
+                const bool ok = compiled != nullptr;
+
+                if (threadShouldExit())
+                    return;
+
+                // The root may be gone by the time the message thread gets to this,
+                // or may have moved on to another load, and either way this loader
+                // is gone with it.
+                auto safeRoot = root;
+                const int id = loadId;
+
+                juce::MessageManager::callAsync([safeRoot, id, compiled, ok, error]() {
+                    if (auto* r = safeRoot.getComponent())
+                        if (r->bundleLoader != nullptr && r->bundleLoader->loadId == id)
+                            r->didLoadBundle(ok, compiled, error);
+                });
+            }
+
+            const int loadId;
+            std::function<void(bool)> onComplete;
+
+        private:
+            juce::Component::SafePointer<ReactApplicationRoot> root;
+
+            // The root waits for us as it goes, so its stats outlive us.
+            PerformanceStats* const startupStats;
+
+            const juce::File bundle;
+            const juce::File cacheDirectory;
+
+            // Our own hold on the store, as the root may go while we compile.
+            juce::SharedResourcePointer<AssetStore> assetStore;
+        };
+
+        /** Evaluates a bundle loaded in the background, on the message thread. */
+        void didLoadBundle (bool compiled, AssetStore::Asset bytecode, const juce::String& error)
+        {
+            auto onComplete = std::move(bundleLoader->onComplete);
+            bundleLoader.reset();
+
+            if (loadingPlaceholder != nullptr)
+            {
+                removeChildComponent(loadingPlaceholder.get());
+                loadingPlaceholder.reset();
+            }
+
+            bool ran = false;
+
+            if (!compiled)
+                printf("Script evaluation failed: %s\n", error.toRawUTF8());
+            else
+                ran = evalSharedBytecode(std::move(bytecode));
+
+            // A bundle which didn't run won't commit, and mustn't leave the old
+            // interface showing as though it had.
+            if (!ran)
+                hideStartupSnapshot();
+
+            // Anything dispatched in the meantime goes out at the next frame.
+            if (realtimeEventsPending.load(std::memory_order_acquire) || !eventsHeldWhileHidden.empty())
+                scheduler.scheduleFrame();
+
+            if (onComplete)
+                onComplete(ran);
+        }
+
+        //==============================================================================
+        struct SurfaceEntry
+        {
+            ViewId viewId = 0;
+            juce::Component* host = nullptr;
+        };
+
+        std::map<juce::String, SurfaceEntry> surfaces;
+
+        // The overlays, all hosted by the one layer above our own views.
+        std::map<juce::String, SurfaceEntry> overlays;
+
+        // The ids handed to the script for each surface and overlay, when
+        // there's a script thread.
+        std::map<juce::String, ViewId> scriptSurfaceIds;
+        std::map<juce::String, ViewId> scriptOverlayIds;
+
+        /** The layer hosting the overlays, above every view of the root's tree,
+            which lets clicks through wherever no overlay has a view.
+         */
+        class OverlayLayer : public juce::Component
+        {
+        public:
+            OverlayLayer()
+            {
+                setAlwaysOnTop(true);
+                setInterceptsMouseClicks(false, true);
+            }
+        };
+
+        std::unique_ptr<OverlayLayer> overlayLayer;
+
+        void attachSurface (const juce::String& name, juce::Component& host)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            auto& surface = surfaces[name];
+
+            // If you hit this, two Surfaces share a name; the later one wins.
+            jassert (surface.host == nullptr);
+            surface.host = &host;
+
+            if (auto* entry = viewTable.find(surface.viewId))
+                host.addAndMakeVisible(entry->view.get());
+
+            performShadowTreeLayout();
+        }
+
+        void detachSurface (const juce::String& name, juce::Component& host)
+        {
+            auto it = surfaces.find(name);
+
+            if (it == surfaces.end() || it->second.host != &host)
+                return;
+
+            if (auto* entry = viewTable.find(it->second.viewId))
+                host.removeChildComponent(entry->view.get());
+
+            it->second.host = nullptr;
+        }
+
+        /** Lays out the tree of each surface and overlay with a host, to the
+            host's size.
+         */
+        void layoutSurfaces()
+        {
+            for (auto* trees : { &surfaces, &overlays })
+            {
+                for (auto& [name, surface] : *trees)
+                {
+                    if (surface.host == nullptr)
+                        continue;
 
-            // Push the dispatchEvent function to the top of the stack
-            duk_push_global_object(ctx);
-            duk_push_string(ctx, "__BlueprintNative__");
-            duk_get_prop(ctx, -2);
-            duk_push_string(ctx, "dispatchEvent");
-            duk_get_prop(ctx, -2);
+                    if (auto* entry = viewTable.find(surface.viewId))
+                    {
+                        if (entry->shadowView == nullptr)
+                            continue;
 
-            // Now push the arguments
-            int numArgs = 1 + static_cast<int>(vargs.size());
-            duk_require_stack_top(ctx, numArgs);
-            duk_push_string(ctx, eventType.toRawUTF8());
+                        const ShadowView::ScopedConfig scopedConfig (yogaConfig.config);
+                        entry->shadowView->computeViewLayout((float) surface.host->getWidth(), (float) surface.host->getHeight());
+                        performanceStats.getCurrentFrame().numViewsLaidOut += entry->shadowView->flushViewLayout(&layoutAnimator);
+                    }
+                }
+            }
+        }
+
+        //==============================================================================
+        /** Polls a bundle for changes, calling back once a change has settled. */
+        class BundleWatcher : private juce::Timer
+        {
+        public:
+            BundleWatcher (const juce::File& _bundle, int intervalMs, std::function<void()> _onChange)
+                : bundle(_bundle), onChange(std::move(_onChange))
+            {
+                lastSeen = read();
+                startTimer(juce::jmax(50, intervalMs));
+            }
 
-            for (auto& p : vargs)
-                pushVarToDukStack(p);
+        private:
+            struct FileState
+            {
+                juce::Time modified;
+                juce::int64 size = 0;
 
-            // Then issue the call and clear the stack
-            if (duk_pcall(ctx, numArgs) != DUK_EXEC_SUCCESS) {
-                // If we have an error object at the top of the stack, we'll print the
-                // stack property.
-                if (duk_is_error(ctx, -1))
-                {
-                    // Accessing .stack might cause an error to be thrown, so wrap this
-                    // access in a duk_safe_call() if it matters.
-                    duk_get_prop_string(ctx, -1, "stack");
-                    DBG("Duktape call error: " << duk_safe_to_string(ctx, -1));
-                    duk_pop(ctx);
+                bool operator!= (const FileState& other) const { return modified != other.modified || size != other.size; }
+            };
+
+            FileState read() const { return { bundle.getLastModificationTime(), bundle.getSize() }; }
+
+            void timerCallback() override
+            {
+                const auto state = read();
+
+                // A change counts once the file looks the same two polls running.
+                if (state != lastSeen)
+                {
+                    lastSeen = state;
+                    changePending = true;
+                    return;
                 }
-                else
+
+                if (changePending && state.size > 0)
                 {
-                    // If it's not an error object we'll just coerce to string
-                    DBG("Duktape call error: " << duk_safe_to_string(ctx, -1));
+                    changePending = false;
+                    onChange();
                 }
             }
 
-            duk_pop_n(ctx, 3);
-        }
+            const juce::File bundle;
+            std::function<void()> onChange;
+            FileState lastSeen;
+            bool changePending = false;
+        };
+
+        std::unique_ptr<BundleWatcher> bundleWatcher;
 
-        void pushVarToDukStack (const juce::var& v)
+        std::unique_ptr<BundleLoader> bundleLoader;
+        int nextBundleLoadId = 1;
+        std::unique_ptr<juce::Component> loadingPlaceholder;
+
+        //==============================================================================
+        /** Covers the root with a snapshot of it, stretched to the root's size,
+            during a live resize. Being opaque, it spares the views under it any
+            painting at all.
+         */
+        class LiveResizeCover : public juce::Component
         {
-            if (v.isBool())
-                return duk_push_boolean(ctx, (bool) v);
-            if (v.isInt() || v.isInt64())
-                return duk_push_int(ctx, (int) v);
-            if (v.isDouble())
-                return duk_push_number(ctx, (double) v);
-            if (v.isString())
-                return (void) duk_push_string(ctx, v.toString().toRawUTF8());
-            if (v.isArray())
+        public:
+            LiveResizeCover (juce::Image _snapshot, juce::Colour _background)
+                : snapshot(std::move(_snapshot)), background(_background)
             {
-                duk_idx_t arr_idx = duk_push_array(ctx);
-                int i = 0;
+                setOpaque(true);
+                setAlwaysOnTop(true);
+                setInterceptsMouseClicks(false, false);
+            }
 
-                for (auto& e : *(v.getArray()))
-                {
-                    pushVarToDukStack(e);
-                    duk_put_prop_index(ctx, arr_idx, i++);
-                }
+            void paint (juce::Graphics& g) override
+            {
+                g.fillAll(background);
+                g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality);
+                g.drawImage(snapshot, getLocalBounds().toFloat(), juce::RectanglePlacement::stretchToFit);
+            }
+
+        private:
+            const juce::Image snapshot;
+            const juce::Colour background;
+        };
+
+        LiveResizeOptions liveResizeOptions;
+        std::unique_ptr<LiveResizeCover> liveResizeCover;
+
+        //==============================================================================
+        /** Returns the snapshot file for the root's current size at the given scale. */
+        juce::File getStartupSnapshotFile (float scale) const
+        {
+            return startupSnapshotDirectory.getChildFile("startup-" + juce::String(getWidth()) + "x" + juce::String(getHeight())
+                                                         + "@" + juce::String(juce::roundToInt(scale * 100.0f)) + ".png");
+        }
+
+        /** Covers the root with the snapshot for its size and scale, if there is
+            one, or uncovers it if there isn't.
+         */
+        void showStartupSnapshot()
+        {
+            const float scale = juce::Component::getApproximateScaleFactorForComponent(this);
+            const auto file = getStartupSnapshotFile(scale);
 
+            if (startupSnapshotCover != nullptr && startupSnapshotCover->file == file)
+                return startupSnapshotCover->setBounds(getLocalBounds());
+
+            hideStartupSnapshot();
+
+            auto image = file.existsAsFile() ? juce::ImageFileFormat::loadFrom(file) : juce::Image();
+
+            if (!image.isValid())
                 return;
-            }
-            if (v.isObject())
-            {
-                if (auto* o = v.getDynamicObject())
-                {
-                    duk_idx_t obj_idx = duk_push_object(ctx);
 
-                    for (auto& e : o->getProperties())
-                    {
-                        pushVarToDukStack(e.value);
-                        duk_put_prop_string(ctx, obj_idx, e.name.toString().toRawUTF8());
-                    }
-                }
+            startupSnapshotCover = std::make_unique<StartupSnapshotCover>(file, std::move(image));
+            addAndMakeVisible(startupSnapshotCover.get());
+            startupSnapshotCover->setBounds(getLocalBounds());
+        }
+
+        void hideStartupSnapshot()
+        {
+            if (startupSnapshotCover == nullptr)
+                return;
+
+            removeChildComponent(startupSnapshotCover.get());
+            startupSnapshotCover.reset();
+        }
+
+        void startStartupSnapshotFade()
+        {
+            startupSnapshotFadeStart = getClockTime();
+            scheduler.scheduleFrame();
+        }
 
+        /** Moves the snapshot's crossfade on a frame, removing it at the end. */
+        void runStartupSnapshotFade()
+        {
+            if (startupSnapshotCover == nullptr || startupSnapshotFadeStart < 0.0)
                 return;
+
+            const double progress = (getClockTime() - startupSnapshotFadeStart) / startupSnapshotFadeMs;
+
+            if (progress >= 1.0)
+            {
+                startupSnapshotFadeStart = -1.0;
+                return hideStartupSnapshot();
             }
+
+            startupSnapshotCover->setAlpha(1.0f - (float) progress);
+            scheduler.scheduleFrame();
         }
 
-        static juce::var readVarFromDukStack (duk_context* ctx, duk_idx_t idx)
+        /** The snapshot shown while the tree first builds. */
+        class StartupSnapshotCover : public juce::Component
         {
-            juce::var value;
+        public:
+            StartupSnapshotCover (juce::File _file, juce::Image _snapshot)
+                : file(std::move(_file)), snapshot(std::move(_snapshot))
+            {
+                setAlwaysOnTop(true);
+                setInterceptsMouseClicks(false, false);
+            }
 
-            switch (duk_get_type(ctx, idx))
+            void paint (juce::Graphics& g) override
             {
-                case DUK_TYPE_NULL:
-                    // It looks like juce::var doesn't have an explicit null value,
-                    // so we're just using the default empty constructor value.
-                    break;
-                case DUK_TYPE_UNDEFINED:
-                    value = juce::var::undefined();
-                    break;
-                case DUK_TYPE_BOOLEAN:
-                    value = (bool) duk_get_boolean(ctx, idx);
-                    break;
-                case DUK_TYPE_NUMBER:
-                    value = duk_get_number(ctx, idx);
-                    break;
-                case DUK_TYPE_STRING:
-                    value = duk_get_string(ctx, idx);
-                    break;
-                case DUK_TYPE_OBJECT:
-                {
-                    if (duk_is_array(ctx, idx))
-                    {
-                        duk_size_t len = duk_get_length(ctx, idx);
-                        juce::Array<juce::var> els;
+                g.drawImage(snapshot, getLocalBounds().toFloat(), juce::RectanglePlacement::stretchToFit);
+            }
 
-                        for (duk_size_t i = 0; i < len; ++i)
-                        {
-                            duk_get_prop_index(ctx, idx, i);
-                            els.add(readVarFromDukStack(ctx, -1));
-                            duk_pop(ctx);
-                        }
+            const juce::File file;
 
-                        value = els;
-                        break;
-                    }
-                    else
-                    {
-                        juce::DynamicObject obj;
+        private:
+            const juce::Image snapshot;
+        };
 
-                        // Generic object enumeration; `duk_enum` pushes an enumerator
-                        // object to the top of the stack
-                        duk_enum(ctx, idx, DUK_ENUM_OWN_PROPERTIES_ONLY);
+        juce::File startupSnapshotDirectory;
+        std::unique_ptr<StartupSnapshotCover> startupSnapshotCover;
+        double startupSnapshotFadeStart = -1.0;
+        float lastPaintScale = 1.0f;
+        bool rescalePending = false;
+        bool hasCommitted = false;
+        static constexpr double startupSnapshotFadeMs = 200.0;
+        double lastResizeTime = 0.0;
+        bool liveResizing = false;
+        bool liveResizeDetected = false;
+        bool liveResizeLayoutPending = false;
 
-                        while (duk_next(ctx, -1, 1))
-                        {
-                            // For each found key/value pair, `duk_enum` pushes the
-                            // values to the top of the stack. So here the stack top
-                            // is [ ... enum key value]. Enum is at -3, key at -2,
-                            // value at -1 from the stack top.
-                            // Note here that all keys in an ECMAScript object are of
-                            // type string, even arrays, e.g. `myArr[0]` has an implicit
-                            // conversion from number to string. Thus here, while constructing
-                            // the DynamicObject, we take the `toString()` value for the key
-                            // always.
-                            obj.setProperty(duk_to_string(ctx, -2), readVarFromDukStack(ctx, -1));
+        /** Preloads what the manifest shipped with the bundle names, if it has
+            one, ahead of the bundle being read.
+         */
+        void preloadBundleAssets (const juce::File& bundle)
+        {
+            preloadAssets(AssetPreloader::Manifest::fromFile(AssetPreloader::getManifestFileFor(bundle)));
+        }
 
-                            // Clear the key/value pair from the stack
-                            duk_pop_2(ctx);
-                        }
+        /** Returns the bytecode for a bundle from the store, compiling it, by way
+            of the cache directory, if no other root is running it. Safe to call
+            from any thread.
+         */
+        static AssetStore::Asset getSharedBytecode (AssetStore& store, const juce::File& bundle,
+                                                    const juce::File& cacheDirectory, juce::String& error,
+                                                    PerformanceStats* startupStats = nullptr)
+        {
+            std::unique_ptr<juce::MemoryMappedFile> source;
+            bool mapped = false;
 
-                        // Pop the enumerator from the stack
-                        duk_pop(ctx);
+            {
+                const PerformanceStats::ScopedStartupPhase startupPhase (startupStats, PerformanceStats::BundleReadPhase);
+                mapped = BytecodeBundle::mapBundle(bundle, source);
+            }
 
-                        value = juce::var(obj.clone());
-                        break;
-                    }
-                }
-                case DUK_TYPE_NONE:
-                default:
-                    jassertfalse;
+            if (!mapped)
+            {
+                error = "failed to read " + bundle.getFullPathName();
+                return nullptr;
             }
 
-            return value;
+            const auto* utf8 = static_cast<const char*>(source->getData());
+            const auto numBytes = source->getSize();
+
+            return store.getOrCreate(BytecodeBundle::hashSource(utf8, numBytes), [&](juce::MemoryBlock& data, juce::String& e) {
+                const PerformanceStats::ScopedStartupPhase startupPhase (startupStats, PerformanceStats::CompilePhase);
+                return BytecodeBundle::compileWithCache(utf8, numBytes, bundle.getFileName(), cacheDirectory, data, e);
+            }, error);
         }
 
-        /** Recursively computes the shadow tree layout, then traverses the tree
-            flushing new layout bounds to the associated view components.
+        /** Evaluates bytecode from the store, holding onto it for as long as this
+            bundle runs so that roots opened later can share it too.
          */
-        void performShadowTreeLayout()
+        bool evalSharedBytecode (AssetStore::Asset bundle)
         {
-            juce::Rectangle<float> bounds = getLocalBounds().toFloat();
-            const float width = bounds.getWidth();
-            const float height = bounds.getHeight();
+            const void* bytecode = nullptr;
+            size_t bytecodeSize = 0;
+            juce::String error;
+
+            if (!BytecodeBundle::getBytecode(bundle->getData(), bundle->getSize(), bytecode, bytecodeSize, error))
+            {
+                DBG("Bytecode bundle rejected: " << error);
+                return false;
+            }
+
+            bundleBytecode = bundle;
+
+            // The shared bytecode is immutable, so the script thread can read it
+            // where it is rather than from a copy.
+            if (scriptThread != nullptr && !isOnScriptThread())
+            {
+                callIntoScript([this, bundle, bytecode, bytecodeSize]() { runBytecode(bytecode, bytecodeSize); });
+                return true;
+            }
 
-            _shadowView->computeViewLayout(width, height);
-            _shadowView->flushViewLayout();
+            runBytecode(bytecode, bytecodeSize);
+            return true;
         }
 
-        //==============================================================================
-        std::vector<std::function<void(const juce::var::NativeFunctionArgs&)>> methodRegistry;
+        /** Like `getSharedBytecode`, for a module's source wrapped in its module
+            function.
+         */
+        static AssetStore::Asset getSharedModuleBytecode (AssetStore& store, const juce::File& module,
+                                                          const juce::File& cacheDirectory, juce::String& error)
+        {
+            std::unique_ptr<juce::MemoryMappedFile> source;
+
+            if (!BytecodeBundle::mapBundle(module, source))
+            {
+                error = "failed to read " + module.getFullPathName();
+                return nullptr;
+            }
+
+            // The newline lets the module end on a // comment.
+            juce::MemoryOutputStream wrapped;
+            wrapped << "(function(exports,require,module,__filename,__dirname){";
+            wrapped.write(source->getData(), source->getSize());
+            wrapped << "\n})";
+
+            const auto* utf8 = static_cast<const char*>(wrapped.getData());
+            const auto numBytes = wrapped.getDataSize();
+
+            return store.getOrCreate(BytecodeBundle::hashSource(utf8, numBytes), [&](juce::MemoryBlock& data, juce::String& e) {
+                return BytecodeBundle::compileWithCache(utf8, numBytes, module.getFileName(), cacheDirectory, data, e);
+            }, error);
+        }
+
+        juce::SharedResourcePointer<AssetStore> assetStore;
+        AssetStore::Asset bundleBytecode;
+
+        juce::SharedResourcePointer<AssetPreloader> assetPreloader;
+        AssetPreloader::BatchHandle preloadedAssets;
+
+        juce::File moduleDirectory;
+        std::vector<AssetStore::Asset> moduleBytecode;
 
-    private:
         //==============================================================================
-        /** Registers each of the natively supported view types. */
-        void installNativeViewTypes()
+        /** Checks on the message thread, at the frame rate, for events queued by
+            realtime code, which can't safely post a message to wake us itself.
+            The checks ride on the scheduler's shared clock rather than a timer
+            of each root's own, and only while some event type is registered.
+         */
+        class RealtimeEventWatcher
         {
-            registerViewType("Text", []() -> ViewPair {
-                auto view = std::make_unique<TextView>();
-                auto shadowView = std::make_unique<TextShadowView>(view.get());
+        public:
+            explicit RealtimeEventWatcher (ReactApplicationRoot& _root) : root(_root) {}
+            ~RealtimeEventWatcher() { root.scheduler.setPoll(nullptr); }
 
-                return {std::move(view), std::move(shadowView)};
-            });
+            /** Adds an event type to watch for, starting the checks with the first. */
+            void watch()
+            {
+                if (numWatched++ > 0)
+                    return;
 
-            registerViewType("View", []() -> ViewPair {
-                auto view = std::make_unique<View>();
-                auto shadowView = std::make_unique<ShadowView>(view.get());
+                root.scheduler.setPoll([this]() {
+                    if (root.realtimeEventsPending.load(std::memory_order_acquire))
+                        root.scheduler.scheduleFrame();
+                });
+            }
 
-                return {std::move(view), std::move(shadowView)};
-            });
+            /** Removes an event type, stopping the checks once there are none. */
+            void unwatch()
+            {
+                jassert (numWatched > 0);
 
-            registerViewType("Image", []() -> ViewPair {
-                auto view = std::make_unique<ImageView>();
+                if (numWatched > 0 && --numWatched == 0)
+                    root.scheduler.setPoll(nullptr);
+            }
 
-                // ImageView does not need a specialized shadow view, unless
-                // we want to enforce at the ShadowView level that it cannot
-                // take children.
-                auto shadowView = std::make_unique<ShadowView>(view.get());
+        private:
+            ReactApplicationRoot& root;
+            int numWatched = 0;
+        };
 
-                return {std::move(view), std::move(shadowView)};
-            });
+        struct RealtimeEventType
+        {
+            juce::Identifier name;
+            RealtimeEventFormatter formatter;
+        };
 
-            registerViewType("ScrollView", []() -> ViewPair {
-                auto view = std::make_unique<ScrollView>();
-                auto shadowView = std::make_unique<ShadowView>(view.get());
+        static constexpr size_t realtimeEventQueueCapacity = 4096;
 
-                return {std::move(view), std::move(shadowView)};
-            });
+        RealtimeEventQueue<RealtimeEvent> realtimeEvents;
+        std::atomic<bool> realtimeEventsPending { false };
+        std::vector<RealtimeEventType> realtimeEventTypes;
 
-            registerViewType("ScrollViewContentView", []() -> ViewPair {
-                auto view = std::make_unique<View>();
-                auto shadowView = std::make_unique<ScrollViewContentShadowView>(view.get());
+        struct CoalescedEventType
+        {
+            std::unique_ptr<CoalescedEventChannel> channel;
+            CoalescedEventFormatter formatter;
+            bool isWatched = true;
+        };
 
-                return {std::move(view), std::move(shadowView)};
-            });
+        std::vector<CoalescedEventType> coalescedEventChannels;
+        double throttledEventDeadline = -1.0;
+        RealtimeEventWatcher realtimeEventWatcher;
+
+        void* dispatchViewEventFn = nullptr;
+        void* releaseViewsFn = nullptr;
+        void* dispatchEventFn = nullptr;
+        void* dispatchEventBatchFn = nullptr;
+        std::unordered_map<juce::Identifier, void*, IdentifierHash> eventTypeStrings;
+        std::unordered_map<juce::Identifier, void*, IdentifierHash> viewEventRecords;
+        int viewEventDispatchDepth = 0;
+        DukStringCache stringCache;
+
+        struct BindingSource
+        {
+            PropertyBinding::Source source;
+            PropertyBinding::Mapping mapping;
+        };
+
+        // A binding targets either whichever view holds a refId, when made from
+        // native code, or the view which declared it, when made through a prop.
+        struct ActiveBinding
+        {
+            juce::Identifier refId;
+            ViewId viewId;
+            juce::Identifier property;
+            PropertyBinding::Source source;
+            PropertyBinding::Mapping mapping;
+
+            bool hasValue = false;
+            double lastValue = 0.0;
+            ViewId lastViewId = 0;
+        };
+
+        std::map<juce::String, BindingSource> bindingSources;
+        std::map<juce::String, ParameterTarget> parameterTargets;
+
+        /** A target's coalesced writes; the map keeps the target where it is. */
+        struct ParameterWrite
+        {
+            ParameterTarget* target;
+            double value = 0.0;
+            bool pending = false;
+            bool inGesture = false;
+        };
+
+        /** Writes each target's latest value, once a frame. */
+        void flushParameterWrites()
+        {
+            for (const int index : pendingParameterWrites)
+            {
+                auto& write = parameterWrites[static_cast<size_t>(index)];
+                write.pending = false;
+
+                if (write.target->setValue)
+                    write.target->setValue(write.value);
+            }
+
+            pendingParameterWrites.clear();
         }
 
-        //==============================================================================
-        std::unique_ptr<ShadowView> _shadowView;
-        std::map<ViewId, std::unique_ptr<View>> viewTable;
-        std::map<ViewId, std::unique_ptr<ShadowView>> shadowViewTable;
-        std::map<juce::String, ViewFactory> viewFactories;
+        std::map<juce::String, int> parameterTargetIndices;
+        std::vector<ParameterWrite> parameterWrites;
+        std::vector<int> pendingParameterWrites;
+        std::vector<ActiveBinding> propertyBindings;
+
+        struct RunningAnimation
+        {
+            RunningAnimation (ViewId _viewId, const juce::Identifier& _property, const AnimatedValue& _value)
+                : viewId(_viewId), property(_property), value(_value) {}
+
+            int id = 0;
+            ViewId viewId;
+            juce::Identifier property;
+            AnimatedValue value;
+            double startTime = 0.0;
+
+            bool isColour = false;
+            juce::Colour fromColour;
+            juce::Colour toColour;
+        };
+
+        std::vector<std::unique_ptr<RunningAnimation>> animations;
+
+        // Taken on the script thread, for animations it starts, as well as on
+        // the message thread.
+        std::atomic<int> nextAnimationId { 1 };
+
+        LayoutAnimator layoutAnimator;
+
+        // The headless clock's time, or -1 running on the system's.
+        double manualClockTime = -1.0;
+        static constexpr double headlessFrameIntervalMs = 1000.0 / 60.0;
+
+        std::map<juce::String, ValueChannel*> valueChannels;
+        std::vector<std::unique_ptr<ValueChannel>> ownedValueChannels;
+        std::map<juce::String, SampleRingBuffer*> sampleBuffers;
+        std::map<juce::String, ListModel*> listModels;
+        bool listModelFunctionsRegistered = false;
 
+        std::map<juce::String, NoteGridModel*> noteGrids;
+        std::set<juce::String> pendingNoteGridDiffs;
+        bool noteGridFunctionsRegistered = false;
+
+        // Ids aren't reused, so that messages from a terminated worker, still on
+        // their way, find nobody listening.
+        std::map<int, std::unique_ptr<ScriptWorker>> workers;
+        int nextWorkerId = 1;
+
+        // The User Timing marks, both by the engine's clock, which JavaScript
+        // sees, and in ticks, which the trace recorder keeps.
+        struct UserTimingMark
+        {
+            double time = 0.0;
+            juce::int64 ticks = 0;
+        };
+
+        bool findUserTimingMark (const juce::String& name, UserTimingMark& mark) const
+        {
+            const auto it = userTimingMarks.find(name);
+
+            if (it == userTimingMarks.end())
+                return false;
+
+            mark = it->second;
+            return true;
+        }
+
+        std::map<juce::String, UserTimingMark> userTimingMarks;
+        UserTimingMark userTimingOrigin;
+
+        std::vector<int> pendingAnimationFrames;
+        double yieldBudgetMs = 8.0;
+        double nextAnimationFrameTime = -1.0;
+        int nextAnimationFrameId = 1;
+        std::vector<int> pendingIdleCallbacks;
+        int nextIdleCallbackId = 1;
+
+        // Async native methods run on a pool made with the first of them. Call
+        // ids run on across reloads, so that an old engine's calls settle
+        // nothing in the new one.
+        static constexpr int asyncMethodPoolSize = 2;
+        std::unique_ptr<juce::ThreadPool> asyncMethodPool;
+        int nextAsyncCallId = 1;
+        std::vector<CompletedAsyncCall> completedAsyncCalls;
+        juce::CriticalSection completedAsyncCallsLock;
+        bool microtasksPending = false;
         juce::File sourceFile;
+        juce::File sourceCacheDirectory;
+        juce::File profileOutputFile;
+        std::unique_ptr<DuktapeAllocator> heapAllocator;
+        HeapMeter heapMeter;
+        juce::SharedResourcePointer<ConsoleLogger> consoleLogger;
         duk_context* ctx;
 
+        // With a script thread, the Duktape heap, the timers, the animation frame
+        // requests and the property ids belong to the script thread, and the rest
+        // to the message thread. Script view ids never collide with the root's.
+        std::unique_ptr<ScriptThread> scriptThread;
+        std::vector<std::function<void()>> scriptCommit;
+        int scriptCommitDepth = 0;
+
+        // The latest input the engine had seen, by the message thread's reckoning
+        // and, with a script thread, by the script thread's, along with the
+        // latest to have gone back with a commit.
+        juce::uint32 seenInputId = 0;
+        juce::uint32 scriptSeenInputId = 0;
+        juce::uint32 scriptCommittedInputId = 0;
+        ViewId nextScriptViewId = ViewTable::rootViewId + 1;
+
+        juce::CriticalSection completedCommitsLock;
+        std::vector<std::vector<std::function<void()>>> completedCommits;
+
+        std::unordered_map<ViewId, ViewId> viewIdsFromScript;
+        std::unordered_map<ViewId, ViewId> viewIdsToScript;
+        bool scriptAnimationFramePending = false;
+        std::atomic<bool> realtimeFlushPosted { false };
+
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReactApplicationRoot)
     };
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    blueprint_RealtimeEventQueue.h
+    Created: 14 Oct 2026 9:12:44pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A plain event as pushed from a realtime thread: an event type id, handed
+        out by ReactApplicationRoot::registerRealtimeEventType, and a few numbers.
+     */
+    struct RealtimeEvent
+    {
+        static constexpr int maxArgs = 6;
+
+        int type = 0;
+        int numArgs = 0;
+        double args[maxArgs] = {};
+    };
+
+    //==============================================================================
+    /** A bounded, lock-free, multiple producer single consumer queue.
+
+        Any number of threads, including the audio thread, may push concurrently;
+        a single thread, normally the message thread, pops. All storage is
+        allocated up front, and neither end ever takes a lock or allocates, so
+        pushing is safe from realtime code. When the queue is full the push fails
+        rather than waiting, and the item is dropped.
+
+        Each cell carries a sequence number which tells a producer whether the cell
+        is free for the current lap of the ring, and the consumer whether it's been
+        written (after Dmitry Vyukov's bounded queue). Producers claim a cell with
+        a compare-and-swap on the write position, so a producer may retry when
+        racing another producer, but never waits on the consumer.
+     */
+    template <typename T>
+    class RealtimeEventQueue
+    {
+    public:
+        static_assert (std::is_trivially_copyable<T>::value, "Queued items must be trivially copyable");
+
+        //==============================================================================
+        /** Creates a queue holding at least the given number of items. */
+        explicit RealtimeEventQueue (size_t minCapacity)
+        {
+            size_t capacity = 2;
+
+            while (capacity < minCapacity)
+                capacity <<= 1;
+
+            cells = std::make_unique<Cell[]>(capacity);
+            mask = capacity - 1;
+
+            for (size_t i = 0; i < capacity; ++i)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        //==============================================================================
+        /** Pushes an item, returning false and dropping it if the queue is full.
+
+            Safe to call from any thread.
+         */
+        bool push (const T& item)
+        {
+            size_t pos = writePos.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                auto& cell = cells[pos & mask];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+                if (diff == 0)
+                {
+                    if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.item = item;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // The consumer hasn't yet freed this cell from the previous lap.
+                    numDropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    pos = writePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /** Pops the oldest item, returning false if the queue is empty.
+
+            Only one thread may pop.
+         */
+        bool pop (T& item)
+        {
+            auto& cell = cells[readPos & mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+            if (static_cast<std::ptrdiff_t>(sequence - (readPos + 1)) < 0)
+                return false;
+
+            item = cell.item;
+            cell.sequence.store(readPos + mask + 1, std::memory_order_release);
+            ++readPos;
+
+            return true;
+        }
+
+        /** Returns the number of items the queue can hold. */
+        size_t getCapacity() const { return mask + 1; }
+
+        /** Returns, and resets, the number of items dropped because the queue was full. */
+        size_t getAndResetNumDropped() { return numDropped.exchange(0, std::memory_order_relaxed); }
+
+    private:
+        //==============================================================================
+        struct Cell
+        {
+            std::atomic<size_t> sequence { 0 };
+            T item;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask = 0;
+
+        // The producers' and consumer's positions live on separate cache lines so
+        // that the two ends don't contend.
+        alignas(64) std::atomic<size_t> writePos { 0 };
+        alignas(64) size_t readPos = 0;
+        std::atomic<size_t> numDropped { 0 };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeEventQueue)
+    };
+
+}
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    blueprint_SampleRingBuffer.h
+    Created: 15 Oct 2026 9:58:03am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A ring of the most recent audio samples, written by realtime code and read
+        by views which draw them, such as a ScopeView.
+
+        A single writer, typically `processBlock`, appends samples and never waits,
+        locks or allocates; once the ring is full it simply overwrites the oldest
+        samples. Readers copy out the latest samples whenever they like, with no
+        notion of consuming them, and drop whatever the writer overwrote during
+        the copy rather than make the writer wait.
+     */
+    class SampleRingBuffer
+    {
+    public:
+        //==============================================================================
+        /** Creates a buffer holding at least the given number of samples. */
+        explicit SampleRingBuffer (int minCapacity)
+        {
+            size_t capacity = 2;
+
+            while (capacity < static_cast<size_t>(juce::jmax(2, minCapacity)))
+                capacity <<= 1;
+
+            samples = std::make_unique<std::atomic<float>[]>(capacity);
+            mask = capacity - 1;
+
+            for (size_t i = 0; i < capacity; ++i)
+                samples[i].store(0.0f, std::memory_order_relaxed);
+        }
+
+        //==============================================================================
+        /** Appends a run of samples. Only one thread may write to a buffer. */
+        void write (const float* data, int num)
+        {
+            const auto count = numWritten.load(std::memory_order_relaxed);
+
+            for (int i = 0; i < num; ++i)
+                samples[(count + static_cast<size_t>(i)) & mask].store(data[i], std::memory_order_relaxed);
+
+            numWritten.store(count + static_cast<size_t>(juce::jmax(0, num)), std::memory_order_release);
+        }
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_basics
+        /** Appends the mix of the given channels of an audio buffer, e.g. a stereo
+            output summed to mono. Only one thread may write to a buffer.
+         */
+        void write (const juce::AudioBuffer<float>& buffer, int startSample, int num)
+        {
+            const int numChannels = buffer.getNumChannels();
+
+            if (numChannels == 1)
+                return write(buffer.getReadPointer(0, startSample), num);
+
+            const auto count = numWritten.load(std::memory_order_relaxed);
+            const float scale = 1.0f / (float) juce::jmax(1, numChannels);
+
+            for (int i = 0; i < num; ++i)
+            {
+                float sum = 0.0f;
+
+                for (int c = 0; c < numChannels; ++c)
+                    sum += buffer.getSample(c, startSample + i);
+
+                samples[(count + static_cast<size_t>(i)) & mask].store(sum * scale, std::memory_order_relaxed);
+            }
+
+            numWritten.store(count + static_cast<size_t>(juce::jmax(0, num)), std::memory_order_release);
+        }
+#endif
+
+        //==============================================================================
+        /** Copies up to the given number of the latest samples, oldest first, and
+            returns the number copied. That's fewer than asked for until the writer
+            has written enough, or if it overwrote some of them during the copy.
+         */
+        int readLatest (float* dest, int num) const
+        {
+            const auto end = numWritten.load(std::memory_order_acquire);
+            const auto n = juce::jmin(static_cast<size_t>(juce::jmax(0, num)), end, mask + 1);
+            const auto start = end - n;
+
+            for (size_t i = 0; i < n; ++i)
+                dest[i] = samples[(start + i) & mask].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Anything the writer has since lapped may be torn, so we drop it
+            // from the front.
+            const auto endAfter = numWritten.load(std::memory_order_relaxed);
+            const auto lost = endAfter - start > mask + 1 ? endAfter - start - (mask + 1) : 0;
+
+            if (lost >= n)
+                return 0;
+
+            if (lost > 0)
+                std::memmove(dest, dest + lost, (n - lost) * sizeof(float));
+
+            return static_cast<int>(n - lost);
+        }
+
+        /** Returns the number of samples ever written, which readers can compare
+            with an earlier count to see whether anything new has arrived.
+         */
+        size_t getNumWritten() const { return numWritten.load(std::memory_order_acquire); }
+
+        /** Returns the number of samples the buffer holds. */
+        int getCapacity() const { return static_cast<int>(mask + 1); }
+
+        /** Sets the rate the samples are written at, for views which care, such as
+            a SpectrumView mapping frequency bins. Safe to call from any thread.
+         */
+        void setSampleRate (double newSampleRate) { sampleRate.store(newSampleRate, std::memory_order_relaxed); }
+
+        /** Returns the rate the samples are written at, 44.1kHz until told otherwise. */
+        double getSampleRate() const { return sampleRate.load(std::memory_order_relaxed); }
+
+    private:
+        //==============================================================================
+        std::unique_ptr<std::atomic<float>[]> samples;
+        size_t mask = 0;
+        std::atomic<size_t> numWritten { 0 };
+        std::atomic<double> sampleRate { 44100.0 };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleRingBuffer)
+    };
+
+}
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    blueprint_ScopeView.cpp
+    Created: 15 Oct 2026 9:58:03am
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    void ScopeView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+
+        if (name == IDs::source)
+        {
+            sourceName = v.toString();
+            buffer = nullptr;
+
+            if (sourceName.isNotEmpty())
+                scheduler.scheduleFrame();
+            else
+                scheduler.cancel();
+        }
+        else if (name == IDs::windowSize)
+        {
+            windowSize = juce::jlimit(2, 1 << 20, (int) v);
+        }
+        else if (name == IDs::trigger)
+        {
+            trigger = (bool) v;
+        }
+        else if (name == IDs::gain)
+        {
+            gain = (float) v;
+        }
+        else if (name == IDs::lineColor)
+        {
+            lineColour = parseColourValue(v);
+        }
+        else if (name == IDs::lineWidth)
+        {
+            lineWidth = juce::jmax(0.0f, (float) v);
+        }
+    }
+
+    //==============================================================================
+    void ScopeView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("ScopeView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "ScopeView");
+
+        View::paint(g);
+
+        auto* source = getBuffer();
+
+        if (source == nullptr)
+            return;
+
+        numWrittenAtPaint = source->getNumWritten();
+
+        const auto [offset, num] = readWindow(*source);
+        const auto bounds = getLocalBounds().toFloat();
+        const int width = getWidth();
+
+        if (num < 2 || width < 1)
+            return;
+
+        const float centreY = bounds.getCentreY();
+        const float scaleY = -gain * bounds.getHeight() * 0.5f;
+        const float* samples = scratch.data() + offset;
+
+        juce::Path path;
+
+        if (num <= width)
+        {
+            // Fewer samples than pixels; we join the samples themselves.
+            const float dx = bounds.getWidth() / (float) (num - 1);
+
+            path.startNewSubPath(0.0f, centreY + samples[0] * scaleY);
+
+            for (int i = 1; i < num; ++i)
+                path.lineTo((float) i * dx, centreY + samples[i] * scaleY);
+
+            g.setColour(lineColour);
+            g.strokePath(path, juce::PathStrokeType (lineWidth));
+            return;
+        }
+
+        // Otherwise each column covers a run of samples, and we draw the
+        // envelope of their maxima along the top and minima along the bottom.
+        columns.resize(static_cast<size_t>(width));
+
+        for (int c = 0; c < width; ++c)
+        {
+            const int begin = (int) ((juce::int64) c * num / width);
+            const int end = (int) ((juce::int64) (c + 1) * num / width);
+
+            columns[static_cast<size_t>(c)] = findMinAndMax(samples + begin, juce::jmax(1, end - begin));
+        }
+
+        path.startNewSubPath(0.5f, centreY + columns[0].getEnd() * scaleY);
+
+        for (int c = 1; c < width; ++c)
+            path.lineTo((float) c + 0.5f, centreY + columns[static_cast<size_t>(c)].getEnd() * scaleY);
+
+        for (int c = width; --c >= 0;)
+            path.lineTo((float) c + 0.5f, centreY + columns[static_cast<size_t>(c)].getStart() * scaleY);
+
+        path.closeSubPath();
+
+        g.setColour(lineColour);
+        g.fillPath(path);
+        g.strokePath(path, juce::PathStrokeType (lineWidth));
+    }
+
+    //==============================================================================
+    SampleRingBuffer* ScopeView::getBuffer()
+    {
+        if (buffer == nullptr && sourceName.isNotEmpty())
+            if (ReactApplicationRoot* root = getOwningRoot())
+                buffer = root->getSampleBuffer(sourceName);
+
+        return buffer;
+    }
+
+    void ScopeView::frameCallback()
+    {
+        if (sourceName.isEmpty())
+            return;
+
+        if (auto* source = getBuffer())
+            if (source->getNumWritten() != numWrittenAtPaint)
+                repaint();
+
+        scheduler.scheduleFrame();
+    }
+
+    std::pair<int, int> ScopeView::readWindow (SampleRingBuffer& source)
+    {
+        // With a trigger we read two windows, so that there's a whole window
+        // after any crossing in the first.
+        const int numToRead = trigger ? windowSize * 2 : windowSize;
+
+        if (scratch.size() < static_cast<size_t>(numToRead))
+            scratch.resize(static_cast<size_t>(numToRead));
+
+        const int numRead = source.readLatest(scratch.data(), numToRead);
+
+        if (!trigger || numRead <= windowSize)
+            return { 0, numRead };
+
+        // The latest rising zero crossing which leaves a whole window after it,
+        // or failing that, the latest window.
+        const int lastStart = numRead - windowSize;
+
+        for (int i = lastStart; i > 0; --i)
+            if (scratch[static_cast<size_t>(i - 1)] < 0.0f && scratch[static_cast<size_t>(i)] >= 0.0f)
+                return { i, windowSize };
+
+        return { lastStart, windowSize };
+    }
+
+    juce::Range<float> ScopeView::findMinAndMax (const float* data, int num)
+    {
+#if JUCE_MODULE_AVAILABLE_juce_audio_basics
+        return juce::FloatVectorOperations::findMinAndMax(data, num);
+#else
+        const auto [lo, hi] = std::minmax_element(data, data + num);
+        return { *lo, *hi };
+#endif
+    }
+
+}
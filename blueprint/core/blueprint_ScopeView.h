@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    blueprint_ScopeView.h
+    Created: 15 Oct 2026 9:58:03am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "blueprint_FrameScheduler.h"
+#include "blueprint_SampleRingBuffer.h"
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The ScopeView class is a core view which draws the latest samples of a
+        SampleRingBuffer, as an oscilloscope or a scrolling waveform.
+
+        `source` names a buffer registered with the root, and `window-size` sets
+        how many of its latest samples span the view (1024 by default). The view
+        looks at the buffer once a display frame and repaints only when there
+        are new samples, so the sample data never crosses the bridge; React only
+        places and styles the view.
+
+        Where there are more samples than pixels, each pixel column shows the
+        minimum and maximum of its samples, so that the outline of the signal
+        survives decimation. The envelope fills and strokes with `line-color`,
+        `line-width` thick, scaled vertically by `gain`. With `trigger` set, the
+        window starts at a rising zero crossing so that periodic signals hold
+        still.
+     */
+    class ScopeView : public View
+    {
+    public:
+        //==============================================================================
+        ScopeView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+        /** Reads its window into scratch buffers as it paints. */
+        bool canPaintConcurrently() const override { return false; }
+
+    private:
+        //==============================================================================
+        /** Returns the buffer we draw, or nullptr if there's none registered. */
+        SampleRingBuffer* getBuffer();
+
+        /** Repaints if the buffer has new samples, and waits for the next frame. */
+        void frameCallback();
+
+        /** Copies the samples to draw into the scratch buffer, returning their
+            offset and number there.
+         */
+        std::pair<int, int> readWindow (SampleRingBuffer& source);
+
+        /** Returns the range of the given samples. */
+        static juce::Range<float> findMinAndMax (const float* data, int num);
+
+        //==============================================================================
+        juce::String sourceName;
+        SampleRingBuffer* buffer = nullptr;
+        size_t numWrittenAtPaint = 0;
+
+        FrameScheduler scheduler { *this, [this]() { frameCallback(); } };
+
+        int windowSize = 1024;
+        bool trigger = false;
+        float gain = 1.0f;
+        juce::Colour lineColour { 0xff66fdcf };
+        float lineWidth = 1.0f;
+
+        std::vector<float> scratch;
+        std::vector<juce::Range<float>> columns;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScopeView)
+    };
+
+}
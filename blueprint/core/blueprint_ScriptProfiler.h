@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    blueprint_ScriptProfiler.h
+    Created: 15 Oct 2026 3:24:41pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A sampling profiler for a root's JavaScript, which shows where the time of
+        a render goes, component by component.
+
+        While it runs, Duktape's interrupt counter hands it the engine every few
+        hundred thousand instructions, and at most once per sample interval it
+        walks the call stack with `duk_inspect_callstack_entry`. Each stack is
+        kept as a line of function names, with their file and line, from the
+        outermost call inwards, and counted each time it's seen. The counts come
+        out in the collapsed stack format read by flamegraph.pl, speedscope and
+        the like.
+
+        Samples come from the interpreter's interrupt, so they only exist where
+        BLUEPRINT_SCRIPT_WATCHDOG is enabled, which it is by default.
+     */
+    class ScriptProfiler
+    {
+    public:
+        //==============================================================================
+        ScriptProfiler() = default;
+
+        //==============================================================================
+        /** Discards the samples so far, and starts sampling at most once per the
+            given interval.
+         */
+        void start (double sampleIntervalMs = 1.0)
+        {
+            const juce::ScopedLock sl (lock);
+
+            stacks.clear();
+            numSamples = 0;
+            intervalMs = sampleIntervalMs;
+            nextSampleMs = 0.0;
+            running = true;
+        }
+
+        /** Stops sampling, keeping the samples so far. */
+        void stop()
+        {
+            running = false;
+        }
+
+        /** Returns true between `start` and `stop`. */
+        bool isRunning() const { return running; }
+
+        //==============================================================================
+        /** Records the call stack of the given context, if it's time for another
+            sample. Call from the interpreter's interrupt, on the engine's thread.
+         */
+        void sample (duk_context* ctx)
+        {
+            if (!running.load(std::memory_order_relaxed))
+                return;
+
+            const double now = juce::Time::getMillisecondCounterHiRes();
+
+            if (now < nextSampleMs || !duk_check_stack(ctx, 3))
+                return;
+
+            nextSampleMs = now + intervalMs;
+
+            // Walked from the innermost call outwards, and then reversed.
+            juce::StringArray frames;
+
+            for (duk_int_t level = -1; level >= -maxStackDepth; --level)
+            {
+                duk_inspect_callstack_entry(ctx, level);
+
+                if (duk_is_undefined(ctx, -1))
+                {
+                    duk_pop(ctx);
+                    break;
+                }
+
+                frames.add(readFrame(ctx, duk_get_top_index(ctx)));
+                duk_pop(ctx);
+            }
+
+            if (frames.isEmpty())
+                return;
+
+            juce::String stack;
+
+            for (int i = frames.size(); --i >= 0;)
+                stack << frames[i] << (i > 0 ? ";" : "");
+
+            const juce::ScopedLock sl (lock);
+            stacks[stack]++;
+            numSamples++;
+        }
+
+        //==============================================================================
+        /** Returns the number of samples so far. */
+        int getNumSamples() const
+        {
+            const juce::ScopedLock sl (lock);
+            return numSamples;
+        }
+
+        /** Returns the samples so far in the collapsed stack format: a line for
+            each distinct stack, its frames separated by semicolons, followed by
+            the number of samples seen with it.
+         */
+        juce::String getCollapsedStacks() const
+        {
+            const juce::ScopedLock sl (lock);
+            juce::String result;
+
+            for (const auto& [stack, count] : stacks)
+                result << stack << " " << count << "\n";
+
+            return result;
+        }
+
+        // Deeper frames are left out of a sample.
+        static constexpr duk_int_t maxStackDepth = 128;
+
+    private:
+        //==============================================================================
+        /** Reads the entry on the stack at the given index, as returned by
+            `duk_inspect_callstack_entry`, as "name (file:line)".
+         */
+        static juce::String readFrame (duk_context* ctx, duk_idx_t entryIdx)
+        {
+            duk_get_prop_string(ctx, entryIdx, "lineNumber");
+            const auto lineNumber = duk_get_int_default(ctx, -1, 0);
+            duk_pop(ctx);
+
+            duk_get_prop_string(ctx, entryIdx, "function");
+
+            juce::String name, fileName;
+
+            if (duk_is_function(ctx, -1))
+            {
+                duk_get_prop_string(ctx, -1, "name");
+                name = juce::String(juce::CharPointer_UTF8(duk_get_string_default(ctx, -1, "")));
+                duk_pop(ctx);
+
+                duk_get_prop_string(ctx, -1, "fileName");
+                fileName = juce::String(juce::CharPointer_UTF8(duk_get_string_default(ctx, -1, "")));
+                duk_pop(ctx);
+            }
+
+            duk_pop(ctx);
+
+            if (name.isEmpty())
+                name = "(anonymous)";
+
+            // Semicolons separate frames in the collapsed format.
+            return (name + " (" + fileName + ":" + juce::String(lineNumber) + ")").replaceCharacter(';', ':');
+        }
+
+        //==============================================================================
+        std::atomic<bool> running { false };
+        double intervalMs = 1.0;
+        double nextSampleMs = 0.0;
+
+        juce::CriticalSection lock;
+        std::map<juce::String, int> stacks;
+        int numSamples = 0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScriptProfiler)
+    };
+
+}
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    blueprint_ScriptThread.h
+    Created: 15 Oct 2026 1:37:45pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <deque>
+#include <functional>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A thread of its own for a root's JavaScript engine, so that long renders
+        and handlers run alongside the host's interface rather than on its
+        message thread.
+
+        The thread runs the tasks posted to it, one at a time in the order they
+        were posted. Whenever it runs out of tasks it calls the idle callback,
+        which does whatever periodic work is due, such as timers, and says how
+        long the thread may sleep before it's due again.
+     */
+    class ScriptThread : private juce::Thread
+    {
+    public:
+        //==============================================================================
+        typedef std::function<void()> Task;
+
+        // Returns the time in milliseconds until there's more idle work, or -1
+        // for none until the next task.
+        typedef std::function<int()> IdleCallback;
+
+        //==============================================================================
+        explicit ScriptThread (IdleCallback callback)
+            : juce::Thread("Blueprint script"), idleCallback(std::move(callback))
+        {
+            startThread();
+        }
+
+        /** Stops the thread, waiting for the task in progress. Tasks which haven't
+            started are dropped.
+         */
+        ~ScriptThread() override
+        {
+            signalThreadShouldExit();
+            wakeUp.signal();
+            stopThread(-1);
+        }
+
+        //==============================================================================
+        /** Queues a task to run on the thread. Safe to call from any thread. */
+        void post (Task task)
+        {
+            {
+                const juce::ScopedLock sl (lock);
+                tasks.push_back(std::move(task));
+            }
+
+            wakeUp.signal();
+        }
+
+        /** Wakes the thread to look at its idle work again, e.g. after a timer
+            has been added from another thread.
+         */
+        void wake()
+        {
+            wakeUp.signal();
+        }
+
+        /** Returns true if tasks are queued, such as events waiting on whatever
+            long idle work is running, which may then stop early for them.
+         */
+        bool hasPendingTasks() const
+        {
+            const juce::ScopedLock sl (lock);
+            return !tasks.empty();
+        }
+
+        /** Returns true if called from the thread itself. */
+        bool isCurrentThread() const
+        {
+            return juce::Thread::getCurrentThreadId() == getThreadId();
+        }
+
+    private:
+        //==============================================================================
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                Task task;
+
+                {
+                    const juce::ScopedLock sl (lock);
+
+                    if (!tasks.empty())
+                    {
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                }
+
+                if (task)
+                {
+                    task();
+                    continue;
+                }
+
+                wakeUp.wait(idleCallback());
+            }
+        }
+
+        //==============================================================================
+        IdleCallback idleCallback;
+
+        juce::CriticalSection lock;
+        std::deque<Task> tasks;
+        juce::WaitableEvent wakeUp;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScriptThread)
+    };
+
+}
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    blueprint_ScriptWatchdog.h
+    Created: 15 Oct 2026 5:38:52am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Puts a time budget on each call a root makes into JavaScript, so that a
+        runaway render can't hang the host's message thread.
+
+        The budget covers each call from the outside in: an event dispatch, a
+        timer or frame callback, or a bundle evaluation. Calls nested inside it
+        share its budget. Duktape's interrupt counter checks the clock every few
+        hundred thousand instructions while the call runs. Once the budget is
+        spent, the overrun callback decides what happens next. It can abort the
+        call, which throws a RangeError through the script, or let the call
+        carry on for another budget.
+
+        The overrun callback runs inside the interpreter, so it mustn't call
+        back into the root or the Duktape context.
+
+        The check only exists where BLUEPRINT_SCRIPT_WATCHDOG is enabled, which
+        it is by default.
+     */
+    class ScriptWatchdog
+    {
+    public:
+        //==============================================================================
+        enum class OverrunAction
+        {
+            /** Throws a RangeError out of the call, past any catch blocks. */
+            Abort,
+
+            /** Lets the call run for another budget, then asks again. */
+            Continue,
+        };
+
+        /** Called with the call's running time once it overruns its budget. */
+        typedef std::function<OverrunAction (double elapsedMs)> OverrunCallback;
+
+        struct Options
+        {
+            /** How long a call may run before it overruns, or 0 for no limit. */
+            double budgetMs = 2000.0;
+
+            /** Decides what to do about an overrun. Without one, we abort. */
+            OverrunCallback onOverrun;
+        };
+
+        //==============================================================================
+        /** Marks a call into JavaScript for as long as it's in scope. */
+        class ScopedCall
+        {
+        public:
+            explicit ScopedCall (ScriptWatchdog& _watchdog)
+                : watchdog(_watchdog)
+            {
+                watchdog.enter();
+            }
+
+            ~ScopedCall()
+            {
+                watchdog.exit();
+            }
+
+        private:
+            ScriptWatchdog& watchdog;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedCall)
+        };
+
+        //==============================================================================
+        ScriptWatchdog() = default;
+
+        //==============================================================================
+        void setOptions (const Options& newOptions) { options = newOptions; }
+        const Options& getOptions() const { return options; }
+
+        /** Returns true while a call is running under the watchdog. */
+        bool isInCall() const { return depth > 0; }
+
+        /** Returns when the outermost call running began, on the hi-res
+            millisecond counter.
+         */
+        double getCallStartTime() const { return startMs; }
+
+        /** Returns the number of calls aborted so far. */
+        int getNumAborts() const { return numAborts; }
+
+        /** Sets a function to call from each of the interpreter's interrupts while
+            a call is running, e.g. to sample the call stack. Like the overrun
+            callback, it runs inside the interpreter.
+         */
+        void setInterruptCallback (std::function<void()> callback) { interruptCallback = std::move(callback); }
+
+        //==============================================================================
+        /** Duktape's execution timeout check. It tells the interpreter whether to
+            abort the call running on this thread.
+
+            The interpreter doesn't know which root it runs for. So each outermost
+            call makes its watchdog the current one for the thread, and keeps it
+            current until the call returns.
+         */
+        static bool shouldAbortCurrentCall()
+        {
+            if (current == nullptr)
+                return false;
+
+            if (current->interruptCallback && !current->aborting)
+                current->interruptCallback();
+
+            return current->shouldAbort();
+        }
+
+    private:
+        //==============================================================================
+        void enter()
+        {
+            if (depth++ > 0)
+                return;
+
+            previous = current;
+            current = this;
+
+            startMs = juce::Time::getMillisecondCounterHiRes();
+            deadlineMs = startMs + options.budgetMs;
+            aborting = false;
+        }
+
+        void exit()
+        {
+            jassert (depth > 0);
+
+            if (--depth > 0)
+                return;
+
+            current = previous;
+            previous = nullptr;
+            aborting = false;
+        }
+
+        bool shouldAbort()
+        {
+            // Once we've aborted, Duktape asks us again at every catch point on the
+            // way out, and we have to keep saying yes until the call has unwound.
+            if (aborting)
+                return true;
+
+            if (options.budgetMs <= 0.0)
+                return false;
+
+            const double now = juce::Time::getMillisecondCounterHiRes();
+
+            if (now < deadlineMs)
+                return false;
+
+            const auto action = options.onOverrun ? options.onOverrun(now - startMs) : OverrunAction::Abort;
+
+            if (action == OverrunAction::Continue)
+            {
+                deadlineMs = now + options.budgetMs;
+                return false;
+            }
+
+            DBG("Aborting a JavaScript call after " << juce::roundToInt(now - startMs) << "ms.");
+
+            ++numAborts;
+            aborting = true;
+            return true;
+        }
+
+        //==============================================================================
+        inline static thread_local ScriptWatchdog* current = nullptr;
+
+        Options options;
+        std::function<void()> interruptCallback;
+        ScriptWatchdog* previous = nullptr;
+        int depth = 0;
+        double startMs = 0.0;
+        double deadlineMs = 0.0;
+        bool aborting = false;
+        int numAborts = 0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScriptWatchdog)
+    };
+
+}
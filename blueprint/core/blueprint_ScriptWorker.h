@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+
+    blueprint_ScriptWorker.h
+    Created: 15 Oct 2026 8:47:21pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+
+#include "blueprint_ConsoleLogger.h"
+#include "blueprint_ScriptThread.h"
+#include "blueprint_ScriptWatchdog.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A background JavaScript worker: a Duktape heap of its own, running a
+        bundle on a thread of its own, for work too heavy for the interface's
+        heap, such as parsing presets or laying out a modulation graph.
+
+        The worker's bundle sees a global `postMessage(value)`, which sends a
+        value back to the root's heap, and calls the global `onmessage(event)`
+        with each message the root sends it, the value as `event.data`. It has
+        `console` too, logging through the same ConsoleLogger as the roots, but
+        no views, timers or modules.
+
+        Messages cross between the heaps as CBOR, encoded and decoded by
+        Duktape in one pass: numbers, strings, bools, arrays, plain objects and
+        buffers arrive as they were sent. There's no sharing of memory between
+        heaps, so a buffer is copied once, into the message, rather than
+        transferred.
+
+        Terminating the worker aborts whatever it's running at the
+        interpreter's next interrupt, and waits for it to unwind. The
+        interrupt is the script watchdog's, so with BLUEPRINT_SCRIPT_WATCHDOG
+        disabled nothing can stop a running script, and terminating a worker
+        in the middle of one waits for it to finish, however long that takes.
+     */
+    class ScriptWorker
+    {
+    public:
+        //==============================================================================
+        /** A message between heaps, as CBOR. */
+        struct Message
+        {
+            juce::MemoryBlock cbor;
+
+            /** Encodes the value at the given index of a heap's stack. */
+            static Message encode (duk_context* ctx, duk_idx_t idx)
+            {
+                duk_dup(ctx, idx);
+                duk_cbor_encode(ctx, -1, 0);
+
+                duk_size_t size = 0;
+                auto* data = duk_get_buffer_data(ctx, -1, &size);
+
+                Message m { juce::MemoryBlock(data, size) };
+                duk_pop(ctx);
+
+                return m;
+            }
+
+            /** Pushes the decoded value to the given heap's stack. */
+            void push (duk_context* ctx) const
+            {
+                auto* buffer = duk_push_fixed_buffer(ctx, cbor.getSize());
+
+                if (cbor.getSize() > 0)
+                    std::memcpy(buffer, cbor.getData(), cbor.getSize());
+
+                duk_cbor_decode(ctx, -1, 0);
+            }
+        };
+
+        /** Called on the worker's thread with each message it posts. */
+        typedef std::function<void(Message)> MessageCallback;
+
+        /** Called on the worker's thread with each error it doesn't catch. */
+        typedef std::function<void(juce::String)> ErrorCallback;
+
+        //==============================================================================
+        /** Starts a worker running the given bundle. */
+        ScriptWorker (juce::String code, juce::String filename, MessageCallback onMessage, ErrorCallback onError)
+            : messageCallback(std::move(onMessage)), errorCallback(std::move(onError))
+        {
+            // A worker runs for as long as its work takes, but stops when told to.
+            watchdog.setOptions({ terminateCheckIntervalMs, [this](double) {
+                return terminating.load() ? ScriptWatchdog::OverrunAction::Abort
+                                          : ScriptWatchdog::OverrunAction::Continue;
+            } });
+
+            thread->post([this, code = std::move(code), filename = std::move(filename)]() {
+                createContext();
+                evaluate(code, filename);
+            });
+        }
+
+        ~ScriptWorker()
+        {
+            terminating = true;
+
+           #if ! BLUEPRINT_SCRIPT_WATCHDOG
+            // If you hit this, the worker is in the middle of a script which,
+            // without the watchdog's interrupt, can't be aborted, so we'll wait
+            // here until it finishes by itself.
+            jassert (!running.load());
+           #endif
+
+            thread.reset();
+
+            if (ctx != nullptr)
+                duk_destroy_heap(ctx);
+        }
+
+        //==============================================================================
+        /** Sends a message to the worker's `onmessage`. Safe to call from any thread. */
+        void postMessage (Message message)
+        {
+            if (thread == nullptr)
+                return;
+
+            thread->post([this, message = std::move(message)]() {
+                if (ctx == nullptr)
+                    return;
+
+                duk_push_global_object(ctx);
+
+                if (!duk_get_prop_string(ctx, -1, "onmessage") || !duk_is_callable(ctx, -1))
+                {
+                    duk_pop_2(ctx);
+                    return;
+                }
+
+                duk_push_object(ctx);
+                message.push(ctx);
+                duk_put_prop_string(ctx, -2, "data");
+
+                const ScopedRun run (*this);
+
+                if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                    reportError();
+
+                duk_pop_2(ctx);
+            });
+        }
+
+    private:
+        //==============================================================================
+        void createContext()
+        {
+            ctx = duk_create_heap_default();
+            jassert (ctx != nullptr);
+
+            consoleLogger->install(ctx);
+
+            duk_push_global_stash(ctx);
+            duk_push_pointer(ctx, (void*) this);
+            duk_put_prop_string(ctx, -2, "workerInstance");
+            duk_pop(ctx);
+
+            duk_push_global_object(ctx);
+            duk_push_c_function(ctx, postMessageFromWorker, 1);
+            duk_put_prop_string(ctx, -2, "postMessage");
+
+            // As in a browser's worker, `self` is the global object.
+            duk_push_global_object(ctx);
+            duk_put_prop_string(ctx, -2, "self");
+            duk_pop(ctx);
+        }
+
+        void evaluate (const juce::String& code, const juce::String& filename)
+        {
+            const ScopedRun run (*this);
+
+            duk_push_string(ctx, filename.toRawUTF8());
+
+            if (duk_pcompile_lstring_filename(ctx, 0, code.toRawUTF8(), code.getNumBytesAsUTF8()) != 0
+                || duk_pcall(ctx, 0) != DUK_EXEC_SUCCESS)
+            {
+                reportError();
+            }
+
+            duk_pop(ctx);
+        }
+
+        /** Reports the error at the top of the stack. */
+        void reportError()
+        {
+            // An error object's stack tells more than its message does.
+            if (duk_is_error(ctx, -1))
+                duk_get_prop_string(ctx, -1, "stack");
+            else
+                duk_dup(ctx, -1);
+
+            const juce::String error (juce::CharPointer_UTF8(duk_safe_to_string(ctx, -1)));
+            duk_pop(ctx);
+
+            DBG("Worker error: " << error);
+
+            if (errorCallback)
+                errorCallback(error);
+        }
+
+        static duk_ret_t postMessageFromWorker (duk_context* ctx)
+        {
+            duk_push_global_stash(ctx);
+            duk_get_prop_string(ctx, -1, "workerInstance");
+            auto* worker = static_cast<ScriptWorker*>(duk_get_pointer(ctx, -1));
+            duk_pop_2(ctx);
+
+            jassert (worker != nullptr);
+
+            if (worker->messageCallback)
+                worker->messageCallback(Message::encode(ctx, 0));
+
+            return 0;
+        }
+
+        //==============================================================================
+        /** Marks the worker as running a script, under its watchdog. */
+        struct ScopedRun
+        {
+            explicit ScopedRun (ScriptWorker& _worker)
+                : worker(_worker), watchdogCall(_worker.watchdog)
+            {
+                worker.running = true;
+            }
+
+            ~ScopedRun()
+            {
+                worker.running = false;
+            }
+
+            ScriptWorker& worker;
+            const ScriptWatchdog::ScopedCall watchdogCall;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedRun)
+        };
+
+        //==============================================================================
+        // How often a running call checks whether we're terminating.
+        static constexpr double terminateCheckIntervalMs = 50.0;
+
+        MessageCallback messageCallback;
+        ErrorCallback errorCallback;
+
+        duk_context* ctx = nullptr;
+        ScriptWatchdog watchdog;
+        std::atomic<bool> terminating { false };
+        std::atomic<bool> running { false };
+        juce::SharedResourcePointer<ConsoleLogger> consoleLogger;
+
+        // Last, so that it starts once everything it runs with is ready.
+        std::unique_ptr<ScriptThread> thread = std::make_unique<ScriptThread>([]() { return -1; });
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScriptWorker)
+    };
+
+}
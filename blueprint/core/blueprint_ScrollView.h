@@ -19,6 +19,12 @@ namespace blueprint
     /** The ScrollView class is a core view for scrollable content within Blueprint's
         layout system. It's basically a proxy component where the appendChild/removeChild
         methods delegate to a single child juce::Viewport.
+
+        Scrolling only moves the content component, so it never needs a layout.
+        With `smooth-scroll`, mouse wheel steps glide to their new position
+        rather than jump, and with `scroll-on-drag` the content can be dragged,
+        with momentum. A view with an `onScroll` handler hears the new scroll
+        position at most once a frame.
      */
     class ScrollView : public View
     {
@@ -36,19 +42,26 @@ namespace blueprint
         {
             View::setProperty(name, value);
 
-            if (name == juce::Identifier("scrollbar-thumb-color"))
+            if (name == IDs::scrollbarThumbColor)
             {
-                juce::Colour c = juce::Colour::fromString(props["scrollbar-thumb-color"].toString());
+                juce::Colour c = parseColourValue(value);
 
                 viewport.getVerticalScrollBar().setColour(juce::ScrollBar::thumbColourId, c);
                 viewport.getHorizontalScrollBar().setColour(juce::ScrollBar::thumbColourId, c);
             }
+
+            if (name == IDs::smoothScroll)
+                viewport.smoothScrolling = (bool) value;
+
+            if (name == IDs::scrollOnDrag)
+                viewport.setScrollOnDragEnabled((bool) value);
         }
 
         void addChild (View* childView, int index = -1) override
         {
             jassert (viewport.getViewedComponent() == nullptr);
             viewport.setViewedComponent(childView, false);
+            childView->setVisible(!childView->isHidden());
         }
 
         //==============================================================================
@@ -60,7 +73,68 @@ namespace blueprint
 
     private:
         //==============================================================================
-        juce::Viewport viewport;
+        /** A Viewport which tells the scroll view whenever it scrolls, and which
+            can glide to the positions the mouse wheel scrolls it to.
+         */
+        class ContentViewport : public juce::Viewport, private juce::Timer
+        {
+        public:
+            explicit ContentViewport (ScrollView& _owner) : owner(_owner) {}
+
+            void visibleAreaChanged (const juce::Rectangle<int>& area) override
+            {
+                owner.scrolledAreaChanged(area.getPosition());
+            }
+
+            void mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override
+            {
+                // Trackpads and the like scroll smoothly already.
+                if (!smoothScrolling || wheel.isSmooth || wheel.isInertial || wheel.deltaY == 0.0f
+                    || !getVerticalScrollBar().isVisible())
+                {
+                    stopTimer();
+                    return juce::Viewport::mouseWheelMove(e, wheel);
+                }
+
+                if (!isTimerRunning())
+                    targetY = (float) getViewPositionY();
+
+                // The same distance as a plain Viewport scrolls for each step.
+                const float step = wheel.deltaY * 14.0f * (float) getVerticalScrollBar().getSingleStepSize();
+                const float maxY = (float) juce::jmax(0, getViewedComponent() != nullptr
+                                                      ? getViewedComponent()->getHeight() - getViewHeight()
+                                                      : 0);
+
+                targetY = juce::jlimit(0.0f, maxY, targetY - step);
+                startTimerHz(60);
+            }
+
+            bool smoothScrolling = false;
+
+        private:
+            void timerCallback() override
+            {
+                const float y = (float) getViewPositionY();
+                const float distance = targetY - y;
+
+                // Closes a third of the distance each frame, which settles within
+                // a few hundred milliseconds.
+                if (std::abs(distance) < 1.0f)
+                {
+                    setViewPosition(getViewPositionX(), juce::roundToInt(targetY));
+                    stopTimer();
+                    return;
+                }
+
+                setViewPosition(getViewPositionX(), juce::roundToInt(y + distance / 3.0f));
+            }
+
+            ScrollView& owner;
+            float targetY = 0.0f;
+        };
+
+        //==============================================================================
+        ContentViewport viewport { *this };
 
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScrollView)
@@ -35,16 +35,14 @@ namespace blueprint
             : ShadowView(_view) {}
 
         //==============================================================================
-        void flushViewLayout() override
+        void applyComputedLayout (const juce::Rectangle<float>& bounds, LayoutAnimator* animator) override
         {
-            auto pos = view->getPosition().toFloat();
-            auto bounds = getCachedLayoutBounds().withPosition(pos);
+            // The viewport owns the content's position, so we fold the scroll
+            // offset into the view's layout offset. Its layout bounds then only
+            // change with its layout, and scrolling never moves them.
+            view->setLayoutOffset(view->getPosition().toFloat() - view->getFloatBounds().getPosition());
 
-            view->setFloatBounds(bounds);
-            view->setBounds(bounds.toNearestInt());
-
-            for (auto& child : children)
-                child->flushViewLayout();
+            applyLayoutBounds(bounds, animator);
         }
 
     private:
@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    blueprint_ShaderView.cpp
+    Created: 15 Oct 2026 11:17:52pm
+
+  ==============================================================================
+*/
+
+
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+
+namespace blueprint
+{
+
+    namespace
+    {
+        /** Returns the shader for the given source, made on first use. JUCE keeps
+            each compiled program with the context, under the address of the
+            shader it's compiled for, so these are never deleted: a new shader
+            at a deleted one's address would run the old program.
+         */
+        juce::OpenGLGraphicsContextCustomShader* getSharedShader (const juce::String& source)
+        {
+            JUCE_ASSERT_MESSAGE_THREAD
+
+            static std::map<juce::String, std::unique_ptr<juce::OpenGLGraphicsContextCustomShader>> shaders;
+
+            auto& shader = shaders[source];
+
+            if (shader == nullptr)
+            {
+                static const char* const prelude =
+                    "uniform " JUCE_HIGHP " vec2 origin;\n"
+                    "uniform " JUCE_HIGHP " vec2 resolution;\n"
+                    "uniform " JUCE_HIGHP " float time;\n";
+
+                shader = std::make_unique<juce::OpenGLGraphicsContextCustomShader>(prelude + source);
+            }
+
+            return shader.get();
+        }
+
+        void setUniform (juce::OpenGLShaderProgram& program, const juce::String& name, const std::vector<GLfloat>& values)
+        {
+            const auto* n = name.toRawUTF8();
+
+            switch (values.size())
+            {
+                case 0: break;
+                case 1: program.setUniform(n, values[0]); break;
+                case 2: program.setUniform(n, values[0], values[1]); break;
+                case 3: program.setUniform(n, values[0], values[1], values[2]); break;
+                case 4: program.setUniform(n, values[0], values[1], values[2], values[3]); break;
+                default: program.setUniform(n, values.data(), static_cast<GLsizei>(values.size())); break;
+            }
+        }
+    }
+
+    //==============================================================================
+    void ShaderView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+        getPropertyTable().apply(*this, name, v);
+    }
+
+    const ViewPropertyTable<ShaderView>& ShaderView::getPropertyTable()
+    {
+        typedef ViewPropertyTable<ShaderView> Table;
+
+        static constexpr Table::Entry entries[] = {
+            { "fragment-shader", Table::ConsumedByView, [](ShaderView& s, const juce::var& v) {
+                s.setShaderSource(v.toString());
+            }},
+            { "uniforms", Table::ConsumedByView, [](ShaderView& s, const juce::var& v) {
+                s.uniformValues.clear();
+
+                if (auto* object = v.getDynamicObject())
+                {
+                    for (const auto& p : object->getProperties())
+                    {
+                        std::vector<GLfloat> values;
+
+                        if (auto* array = p.value.getArray())
+                            for (const auto& x : *array)
+                                values.push_back((float) x);
+                        else
+                            values.push_back((float) p.value);
+
+                        s.uniformValues[p.name.toString()] = std::move(values);
+                    }
+                }
+
+                s.repaint();
+            }},
+            { "channels", Table::ConsumedByView, [](ShaderView& s, const juce::var& v) {
+                s.channelBindings.clear();
+
+                if (auto* object = v.getDynamicObject())
+                    for (const auto& p : object->getProperties())
+                        if (p.value.toString().isNotEmpty())
+                            s.channelBindings[p.name.toString()] = { p.value.toString(), {} };
+
+                s.updateScheduling();
+                s.repaint();
+            }},
+            { "animate", Table::ConsumedByView, [](ShaderView& s, const juce::var& v) {
+                s.animate = (bool) v;
+                s.updateScheduling();
+            }},
+        };
+
+        static const Table table (entries);
+        return table;
+    }
+
+    void ShaderView::resetForReuse()
+    {
+        View::resetForReuse();
+
+        shader = nullptr;
+        compileFailed = false;
+        uniformValues.clear();
+        channelBindings.clear();
+        animate = false;
+        startTime = juce::Time::getMillisecondCounterHiRes();
+        scheduler.cancel();
+    }
+
+    //==============================================================================
+    void ShaderView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("ShaderView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "ShaderView");
+
+        View::paint(g);
+
+        // Without a current context we're painting in software, and only the
+        // background shows.
+        if (shader == nullptr || compileFailed || getLocalBounds().isEmpty()
+            || juce::OpenGLContext::getCurrentContext() == nullptr)
+            return;
+
+        auto& context = g.getInternalContext();
+
+        // A failed compile would be tried again each paint, so we give up on it.
+        if (shader->getProgram(context) == nullptr)
+        {
+            DBG("ShaderView failed to compile: " << shader->checkCompilation(context).getErrorMessage());
+            compileFailed = true;
+            return;
+        }
+
+        auto area = getLocalBounds().toFloat();
+
+        if (auto* root = getOwningRoot())
+            area = root->getLocalArea(this, area);
+
+        frameArea = area * context.getPhysicalPixelScaleFactor();
+
+        // The shader is shared, so its uniforms are whichever view's is filling.
+        shader->onShaderActivated = [this](juce::OpenGLShaderProgram& program) { setUniforms(program); };
+        shader->fillRect(context, getLocalBounds());
+        shader->onShaderActivated = nullptr;
+    }
+
+    //==============================================================================
+    void ShaderView::frameCallback()
+    {
+        if (channelBindings.empty() && !animate)
+            return;
+
+        bool changed = animate;
+        ReactApplicationRoot* root = getOwningRoot();
+
+        for (auto& b : channelBindings)
+        {
+            auto& binding = b.second;
+            auto* channel = root != nullptr ? root->getValueChannel(binding.channelName) : nullptr;
+            const int numValues = channel != nullptr ? channel->getNumValues() : 0;
+
+            if ((int) binding.values.size() != numValues)
+            {
+                binding.values.assign(static_cast<size_t>(numValues), 0.0f);
+                changed = true;
+            }
+
+            // Live values, as ValueChannel::getLiveValue explains.
+            for (int i = 0; i < numValues; ++i)
+            {
+                const float value = channel->getLiveValue(i);
+                auto& current = binding.values[static_cast<size_t>(i)];
+
+                if (value != current)
+                {
+                    current = value;
+                    changed = true;
+                }
+            }
+        }
+
+        if (changed)
+            repaint();
+
+        scheduler.scheduleFrame();
+    }
+
+    void ShaderView::updateScheduling()
+    {
+        if (animate || !channelBindings.empty())
+            scheduler.scheduleFrame();
+        else
+            scheduler.cancel();
+    }
+
+    void ShaderView::setUniforms (juce::OpenGLShaderProgram& program)
+    {
+        program.setUniform("origin", frameArea.getX(), frameArea.getY());
+        program.setUniform("resolution", frameArea.getWidth(), frameArea.getHeight());
+        program.setUniform("time", (GLfloat) ((juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0));
+
+        for (const auto& u : uniformValues)
+            setUniform(program, u.first, u.second);
+
+        // Bound channels are always float arrays, however many values they hold.
+        for (const auto& b : channelBindings)
+            if (!b.second.values.empty())
+                program.setUniform(b.first.toRawUTF8(), b.second.values.data(), static_cast<GLsizei>(b.second.values.size()));
+    }
+
+    void ShaderView::setShaderSource (const juce::String& source)
+    {
+        shader = source.isNotEmpty() ? getSharedShader(source) : nullptr;
+        compileFailed = false;
+        repaint();
+    }
+
+}
+
+#endif
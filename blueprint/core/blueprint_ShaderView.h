@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    blueprint_ShaderView.h
+    Created: 15 Oct 2026 11:17:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "blueprint_FrameScheduler.h"
+#include "blueprint_View.h"
+#include "blueprint_ViewPropertyTable.h"
+
+
+#if JUCE_MODULE_AVAILABLE_juce_opengl
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The ShaderView class is a core view which fills its bounds with a GLSL
+        fragment shader of the user's own, run on the GPU as the root renders
+        through OpenGL. Nothing is drawn on the CPU, and no image is made: the
+        shader fills the view's area of the frame directly, in the same pass as
+        every other view.
+
+        `fragment-shader` is the shader's source, a `main` which sets
+        `gl_FragColor`, in the form juce::OpenGLGraphicsContextCustomShader
+        takes: `pixelPos` is the fragment's position in the frame, in physical
+        pixels, and `pixelAlpha` the view's opacity. On top of these, every
+        shader is given
+
+            uniform vec2 origin;       // the view's top left, in the frame's pixels
+            uniform vec2 resolution;   // the view's size, in the frame's pixels
+            uniform float time;        // seconds since the view was mounted
+
+        so that `(pixelPos - origin) / resolution` runs from 0 to 1 across the
+        view. They follow the view's position within the root, and so not a
+        rotation, nor an ancestor rasterized into an image of its own.
+
+        Each distinct source compiles once per OpenGL context, and views with
+        the same source share the program, so the source should stay fixed,
+        with whatever changes passed in uniforms.
+
+        Any other uniforms the shader declares for itself are set from the
+        `uniforms` object, by name, with a number for a float, or an array of
+        two to four numbers for a vec2 to vec4, and longer arrays for a float
+        array. `channels` binds uniforms to ValueChannels registered with the
+        root instead, by name, as `{ levels: "meters" }` for a
+        `uniform float levels[N]` of the channel's values, read once a frame
+        and never through JavaScript. The view repaints when a bound channel's
+        values move, or every frame while `animate` is set.
+
+        When the root isn't rendering through OpenGL, or the shader fails to
+        compile, the view paints its background only, and logs the compile
+        error.
+     */
+    class ShaderView : public View
+    {
+    public:
+        //==============================================================================
+        ShaderView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        /** The shader view's own properties, and how it applies them. */
+        static const ViewPropertyTable<ShaderView>& getPropertyTable();
+
+        /** Drops the shader, its uniforms and bindings. */
+        void resetForReuse() override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+    private:
+        //==============================================================================
+        /** Reads the bound channels, repainting if they've moved, and waits for
+            the next frame.
+         */
+        void frameCallback();
+
+        /** Starts or stops the frame callback as the bindings and `animate` need. */
+        void updateScheduling();
+
+        /** Sets every uniform on the program, as it's about to run. */
+        void setUniforms (juce::OpenGLShaderProgram& program);
+
+        void setShaderSource (const juce::String& source);
+
+        //==============================================================================
+        struct ChannelBinding
+        {
+            juce::String channelName;
+            std::vector<GLfloat> values;
+        };
+
+        // Shared between every view with the same source, and never deleted.
+        juce::OpenGLGraphicsContextCustomShader* shader = nullptr;
+        bool compileFailed = false;
+
+        std::map<juce::String, std::vector<GLfloat>> uniformValues;
+        std::map<juce::String, ChannelBinding> channelBindings;
+
+        bool animate = false;
+        double startTime = juce::Time::getMillisecondCounterHiRes();
+
+        // Where the view is in the frame being painted, for the shader's own
+        // uniforms.
+        juce::Rectangle<float> frameArea;
+
+        FrameScheduler scheduler { *this, [this]() { frameCallback(); } };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ShaderView)
+    };
+
+}
+
+#endif
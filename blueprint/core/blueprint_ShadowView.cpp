@@ -42,33 +42,13 @@ switch (ygvalue.unit)                                   \
 
 #define BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(value, setter, ...)                     \
 {                                                                                   \
-    YGValue ygval = { 0.0f, YGUnitUndefined };                                      \
-                                                                                    \
-    if (value.isDouble())                                                           \
-        ygval = { (float) value, YGUnitPoint };                                     \
-    else if (value.isString() && value.toString() == "auto")                        \
-        ygval = { 0.0f, YGUnitAuto };                                               \
-    else if (value.isString() && value.toString().trim().contains("%"))             \
-    {                                                                               \
-        juce::String strVal = value.toString().retainCharacters("-1234567890.");    \
-        ygval = { strVal.getFloatValue(), YGUnitPercent };                          \
-    }                                                                               \
-                                                                                    \
+    YGValue ygval = blueprint::parseLengthValue(value, true);                       \
     BP_SET_YGVALUE_AUTO(ygval, setter, __VA_ARGS__);                                \
 }
 
 #define BP_SET_FLEX_DIMENSION_PROPERTY(value, setter, ...)                          \
 {                                                                                   \
-    YGValue ygval = { 0.0f, YGUnitUndefined };                                      \
-                                                                                    \
-    if (value.isDouble())                                                           \
-        ygval = { (float) value, YGUnitPoint };                                     \
-    else if (value.isString() && value.toString().trim().contains("%"))             \
-    {                                                                               \
-        juce::String strVal = value.toString().retainCharacters("-1234567890.");    \
-        ygval = { strVal.getFloatValue(), YGUnitPercent };                          \
-    }                                                                               \
-                                                                                    \
+    YGValue ygval = blueprint::parseLengthValue(value, false);                      \
     BP_SET_YGVALUE(ygval, setter, __VA_ARGS__);                                     \
 }
 
@@ -128,6 +108,11 @@ namespace blueprint
             { YGWrapToString(YGWrapWrapReverse), YGWrapWrapReverse },
         };
 
+        std::map<juce::String, YGDisplay> ValidDisplayValues {
+            { YGDisplayToString(YGDisplayFlex), YGDisplayFlex },
+            { YGDisplayToString(YGDisplayNone), YGDisplayNone },
+        };
+
         std::map<juce::String, YGOverflow> ValidOverflowValues {
             { YGOverflowToString(YGOverflowVisible), YGOverflowVisible },
             { YGOverflowToString(YGOverflowHidden), YGOverflowHidden },
@@ -161,130 +146,215 @@ namespace blueprint
             return false;
         }
 
-    }
-
-    //==============================================================================
-    void ShadowView::setProperty (const juce::Identifier& name, const juce::var& newValue)
-    {
-        props.set(name, newValue);
-
         //==============================================================================
-        // Flex enums
-        if (name == juce::Identifier("direction"))
-        {
-            jassert (validateFlexProperty(newValue, ValidDirectionValues));
-            YGNodeStyleSetDirection(yogaNode, ValidDirectionValues[newValue]);
-        }
-
-        if (name == juce::Identifier("flex-direction"))
-        {
-            jassert (validateFlexProperty(newValue, ValidFlexDirectionValues));
-            YGNodeStyleSetFlexDirection(yogaNode, ValidFlexDirectionValues[newValue]);
-        }
-
-        if (name == juce::Identifier("justify-content"))
+        /** The set of layout properties understood by the shadow view. */
+        enum class LayoutProperty
         {
-            jassert (validateFlexProperty(newValue, ValidJustifyValues));
-            YGNodeStyleSetJustifyContent(yogaNode, ValidJustifyValues[newValue]);
-        }
+            Direction,
+            FlexDirection,
+            JustifyContent,
+            AlignItems,
+            AlignContent,
+            AlignSelf,
+            Position,
+            FlexWrap,
+            Overflow,
+            Display,
+            Flex,
+            FlexGrow,
+            FlexShrink,
+            FlexBasis,
+            Width,
+            Height,
+            MinWidth,
+            MinHeight,
+            MaxWidth,
+            MaxHeight,
+            AspectRatio,
+            Margin,
+            Padding,
+            PositionEdge,
+        };
 
-        if (name == juce::Identifier("align-items"))
+        /** A layout property, and the edge it applies to for the edge-valued properties. */
+        struct LayoutPropertyKey
         {
-            jassert (validateFlexProperty(newValue, ValidAlignValues));
-            YGNodeStyleSetAlignItems(yogaNode, ValidAlignValues[newValue]);
-        }
+            LayoutProperty property;
+            YGEdge edge;
+        };
 
-        if (name == juce::Identifier("align-content"))
+        /** Returns the table mapping each pre-interned property name to its layout
+            property, built once on first use.
+         */
+        const std::unordered_map<juce::Identifier, LayoutPropertyKey, IdentifierHash>& getLayoutPropertyTable()
         {
-            jassert (validateFlexProperty(newValue, ValidAlignValues));
-            YGNodeStyleSetAlignContent(yogaNode, ValidAlignValues[newValue]);
-        }
+            static const auto table = []()
+            {
+                std::unordered_map<juce::Identifier, LayoutPropertyKey, IdentifierHash> t {
+                    { "direction",          { LayoutProperty::Direction, YGEdgeAll } },
+                    { "flex-direction",     { LayoutProperty::FlexDirection, YGEdgeAll } },
+                    { "justify-content",    { LayoutProperty::JustifyContent, YGEdgeAll } },
+                    { "align-items",        { LayoutProperty::AlignItems, YGEdgeAll } },
+                    { "align-content",      { LayoutProperty::AlignContent, YGEdgeAll } },
+                    { "align-self",         { LayoutProperty::AlignSelf, YGEdgeAll } },
+                    { "position",           { LayoutProperty::Position, YGEdgeAll } },
+                    { "flex-wrap",          { LayoutProperty::FlexWrap, YGEdgeAll } },
+                    { "overflow",           { LayoutProperty::Overflow, YGEdgeAll } },
+                    { "display",            { LayoutProperty::Display, YGEdgeAll } },
+                    { "flex",               { LayoutProperty::Flex, YGEdgeAll } },
+                    { "flex-grow",          { LayoutProperty::FlexGrow, YGEdgeAll } },
+                    { "flex-shrink",        { LayoutProperty::FlexShrink, YGEdgeAll } },
+                    { "flex-basis",         { LayoutProperty::FlexBasis, YGEdgeAll } },
+                    { "width",              { LayoutProperty::Width, YGEdgeAll } },
+                    { "height",             { LayoutProperty::Height, YGEdgeAll } },
+                    { "min-width",          { LayoutProperty::MinWidth, YGEdgeAll } },
+                    { "min-height",         { LayoutProperty::MinHeight, YGEdgeAll } },
+                    { "max-width",          { LayoutProperty::MaxWidth, YGEdgeAll } },
+                    { "max-height",         { LayoutProperty::MaxHeight, YGEdgeAll } },
+                    { "aspect-ratio",       { LayoutProperty::AspectRatio, YGEdgeAll } },
+                    { "margin",             { LayoutProperty::Margin, YGEdgeAll } },
+                    { "padding",            { LayoutProperty::Padding, YGEdgeAll } },
+                };
+
+                // The edge-valued properties expand to one entry per edge, e.g.
+                // `margin-left`, `padding-horizontal`, or just `top` for position.
+                for (const auto& [edgeName, enumValue] : ValidEdgeValues)
+                {
+                    t[juce::Identifier(juce::String("margin-") + edgeName)] = { LayoutProperty::Margin, enumValue };
+                    t[juce::Identifier(juce::String("padding-") + edgeName)] = { LayoutProperty::Padding, enumValue };
+                    t[juce::Identifier(edgeName)] = { LayoutProperty::PositionEdge, enumValue };
+                }
 
-        if (name == juce::Identifier("align-self"))
-        {
-            jassert (validateFlexProperty(newValue, ValidAlignValues));
-            YGNodeStyleSetAlignSelf(yogaNode, ValidAlignValues[newValue]);
-        }
+                return t;
+            }();
 
-        if (name == juce::Identifier("position"))
-        {
-            jassert (validateFlexProperty(newValue, ValidPositionTypeValues));
-            YGNodeStyleSetPositionType(yogaNode, ValidPositionTypeValues[newValue]);
+            return table;
         }
 
-        if (name == juce::Identifier("flex-wrap"))
-        {
-            jassert (validateFlexProperty(newValue, ValidFlexWrapValues));
-            YGNodeStyleSetFlexWrap(yogaNode, ValidFlexWrapValues[newValue]);
-        }
-
-        if (name == juce::Identifier("overflow"))
-        {
-            jassert (validateFlexProperty(newValue, ValidOverflowValues));
-            YGNodeStyleSetOverflow(yogaNode, ValidOverflowValues[newValue]);
-        }
+    }
 
-        //==============================================================================
-        // Flex dimensions
-        if (name == juce::Identifier("flex"))
-            BP_SET_FLEX_FLOAT_PROPERTY(newValue, YGNodeStyleSetFlex, yogaNode)
-        if (name == juce::Identifier("flex-grow"))
-            BP_SET_FLEX_FLOAT_PROPERTY(newValue, YGNodeStyleSetFlexGrow, yogaNode)
-        if (name == juce::Identifier("flex-shrink"))
-            BP_SET_FLEX_FLOAT_PROPERTY(newValue, YGNodeStyleSetFlexShrink, yogaNode)
-        if (name == juce::Identifier("flex-basis"))
-            BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(newValue, YGNodeStyleSetFlexBasis, yogaNode)
-        if (name == juce::Identifier("width"))
-            BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(newValue, YGNodeStyleSetWidth, yogaNode)
-        if (name == juce::Identifier("height"))
-            BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(newValue, YGNodeStyleSetHeight, yogaNode)
-        if (name == juce::Identifier("min-width"))
-            BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetMinWidth, yogaNode)
-        if (name == juce::Identifier("min-height"))
-            BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetMinHeight, yogaNode)
-        if (name == juce::Identifier("max-width"))
-            BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetMaxWidth, yogaNode)
-        if (name == juce::Identifier("max-height"))
-            BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetMaxHeight, yogaNode)
-        if (name == juce::Identifier("aspect-ratio"))
-            BP_SET_FLEX_FLOAT_PROPERTY(newValue, YGNodeStyleSetAspectRatio, yogaNode)
+    //==============================================================================
+    bool ShadowView::isLayoutProperty (const juce::Identifier& name)
+    {
+        const auto& table = getLayoutPropertyTable();
+        return table.find(name) != table.end();
+    }
 
-        //==============================================================================
-        // Margin
-        juce::Identifier marginMetaProp ("margin");
+    void ShadowView::setProperty (const juce::Identifier& name, const juce::var& newValue)
+    {
+        const auto& table = getLayoutPropertyTable();
+        const auto it = table.find(name);
 
-        for (const auto& [edgeName, enumValue] : ValidEdgeValues)
+        // Not a flex property; anything else a derived shadow view declared is
+        // its own to handle.
+        if (it == table.end())
         {
-            juce::Identifier propId (juce::String("margin-") + edgeName);
-
-            if (name == propId || (name == marginMetaProp && enumValue == YGEdgeAll))
-            {
-                BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(newValue, YGNodeStyleSetMargin, yogaNode, enumValue);
-            }
+            if (name == IDs::debug)
+                debugLayout = true;
+            else if (name == IDs::layoutTransition)
+                hasLayoutTransition = LayoutAnimator::parseTransition(newValue, layoutTransition);
+            else if (name == IDs::layoutBoundary)
+                layoutBoundary = (bool) newValue;
+
+            return;
         }
 
-        //==============================================================================
-        // Padding
-        juce::Identifier paddingMetaProp ("padding");
-
-        for (const auto& [edgeName, enumValue] : ValidEdgeValues)
-        {
-            juce::Identifier propId (juce::String("padding-") + edgeName);
-
-            if (name == propId || (name == paddingMetaProp && enumValue == YGEdgeAll))
-            {
-                BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetPadding, yogaNode, enumValue);
-            }
-        }
+        const auto [property, edge] = it->second;
+        hasLayoutStyle = true;
+        markLayoutChanged();
 
-        //==============================================================================
-        // Position
-        for (const auto& [edgeName, enumValue] : ValidEdgeValues)
+        switch (property)
         {
-            if (name == juce::Identifier(edgeName))
-            {
-                BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetPosition, yogaNode, enumValue);
-            }
+            //==============================================================================
+            // Flex enums
+            case LayoutProperty::Direction:
+                jassert (validateFlexProperty(newValue, ValidDirectionValues));
+                YGNodeStyleSetDirection(yogaNode, ValidDirectionValues[newValue]);
+                break;
+            case LayoutProperty::FlexDirection:
+                jassert (validateFlexProperty(newValue, ValidFlexDirectionValues));
+                YGNodeStyleSetFlexDirection(yogaNode, ValidFlexDirectionValues[newValue]);
+                break;
+            case LayoutProperty::JustifyContent:
+                jassert (validateFlexProperty(newValue, ValidJustifyValues));
+                YGNodeStyleSetJustifyContent(yogaNode, ValidJustifyValues[newValue]);
+                break;
+            case LayoutProperty::AlignItems:
+                jassert (validateFlexProperty(newValue, ValidAlignValues));
+                YGNodeStyleSetAlignItems(yogaNode, ValidAlignValues[newValue]);
+                break;
+            case LayoutProperty::AlignContent:
+                jassert (validateFlexProperty(newValue, ValidAlignValues));
+                YGNodeStyleSetAlignContent(yogaNode, ValidAlignValues[newValue]);
+                break;
+            case LayoutProperty::AlignSelf:
+                jassert (validateFlexProperty(newValue, ValidAlignValues));
+                YGNodeStyleSetAlignSelf(yogaNode, ValidAlignValues[newValue]);
+                break;
+            case LayoutProperty::Position:
+                jassert (validateFlexProperty(newValue, ValidPositionTypeValues));
+                YGNodeStyleSetPositionType(yogaNode, ValidPositionTypeValues[newValue]);
+                break;
+            case LayoutProperty::FlexWrap:
+                jassert (validateFlexProperty(newValue, ValidFlexWrapValues));
+                YGNodeStyleSetFlexWrap(yogaNode, ValidFlexWrapValues[newValue]);
+                break;
+            case LayoutProperty::Overflow:
+                jassert (validateFlexProperty(newValue, ValidOverflowValues));
+                YGNodeStyleSetOverflow(yogaNode, ValidOverflowValues[newValue]);
+                break;
+            case LayoutProperty::Display:
+                jassert (validateFlexProperty(newValue, ValidDisplayValues));
+                YGNodeStyleSetDisplay(yogaNode, ValidDisplayValues[newValue]);
+                break;
+
+            //==============================================================================
+            // Flex dimensions
+            case LayoutProperty::Flex:
+                BP_SET_FLEX_FLOAT_PROPERTY(newValue, YGNodeStyleSetFlex, yogaNode)
+                break;
+            case LayoutProperty::FlexGrow:
+                BP_SET_FLEX_FLOAT_PROPERTY(newValue, YGNodeStyleSetFlexGrow, yogaNode)
+                break;
+            case LayoutProperty::FlexShrink:
+                BP_SET_FLEX_FLOAT_PROPERTY(newValue, YGNodeStyleSetFlexShrink, yogaNode)
+                break;
+            case LayoutProperty::FlexBasis:
+                BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(newValue, YGNodeStyleSetFlexBasis, yogaNode)
+                break;
+            case LayoutProperty::Width:
+                BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(newValue, YGNodeStyleSetWidth, yogaNode)
+                break;
+            case LayoutProperty::Height:
+                BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(newValue, YGNodeStyleSetHeight, yogaNode)
+                break;
+            case LayoutProperty::MinWidth:
+                BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetMinWidth, yogaNode)
+                break;
+            case LayoutProperty::MinHeight:
+                BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetMinHeight, yogaNode)
+                break;
+            case LayoutProperty::MaxWidth:
+                BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetMaxWidth, yogaNode)
+                break;
+            case LayoutProperty::MaxHeight:
+                BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetMaxHeight, yogaNode)
+                break;
+            case LayoutProperty::AspectRatio:
+                BP_SET_FLEX_FLOAT_PROPERTY(newValue, YGNodeStyleSetAspectRatio, yogaNode)
+                break;
+
+            //==============================================================================
+            // Margin, padding and position
+            case LayoutProperty::Margin:
+                BP_SET_FLEX_DIMENSION_PROPERTY_AUTO(newValue, YGNodeStyleSetMargin, yogaNode, edge);
+                break;
+            case LayoutProperty::Padding:
+                BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetPadding, yogaNode, edge);
+                break;
+            case LayoutProperty::PositionEdge:
+                BP_SET_FLEX_DIMENSION_PROPERTY(newValue, YGNodeStyleSetPosition, yogaNode, edge);
+                break;
         }
     }
 
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "blueprint_LayoutAnimator.h"
+#include "blueprint_SlabAllocator.h"
 #include "blueprint_View.h"
 
 
@@ -19,16 +21,27 @@ namespace blueprint
     /** The ShadowView class decouples layout constraints from the actual View instances
         so that our View tree and ShadowView tree might differ (i.e. in the case of raw
         text nodes), and so that our View may remain more simple.
+
+        Shadow views, of every derived type, are allocated from a shared slab
+        allocator, so that the nodes of a tree mounted together lie side by side
+        in memory for the layout passes which walk them.
      */
     class ShadowView
     {
     public:
         //==============================================================================
-        ShadowView(View* _view) : view(_view)
+        /** The kinds of shadow view the root has to tell apart, tagged in their
+            constructors as View::Kind is, for shadowViewCast. Every other
+            shadow view is Plain.
+         */
+        enum class Kind
         {
-            YGConfigSetUseWebDefaults(YGConfigGetDefault(), true);
-            yogaNode = YGNodeNew();
-        }
+            Plain,
+            Text,
+            Measured,
+        };
+
+        ShadowView(View* _view) : ShadowView(_view, Kind::Plain) {}
 
         virtual ~ShadowView()
         {
@@ -36,9 +49,73 @@ namespace blueprint
         }
 
         //==============================================================================
-        /** Set a property on the shadow view. */
+        /** Makes the shadow views created on this thread, for the life of the scope,
+            use the given Yoga config. Each root creates its nodes within one, with
+            a config of its own.
+         */
+        struct ScopedConfig
+        {
+            explicit ScopedConfig (YGConfigRef config) : previous(currentConfig()) { currentConfig() = config; }
+            ~ScopedConfig() { currentConfig() = previous; }
+
+            YGConfigRef previous;
+        };
+
+        /** Returns the config a new node gets: that of the innermost ScopedConfig,
+            or else a shared config with web defaults.
+         */
+        static YGConfigRef getConfigForNewNodes()
+        {
+            if (auto config = currentConfig())
+                return config;
+
+            static const YGConfigRef sharedConfig = []() {
+                auto config = YGConfigNew();
+                YGConfigSetUseWebDefaults(config, true);
+                return config;
+            }();
+
+            return sharedConfig;
+        }
+
+        //==============================================================================
+        // The virtual destructor hands the sized delete the derived type's size.
+        static void* operator new (size_t size) { return getAllocator().allocate(size); }
+        static void operator delete (void* p, size_t size) { getAllocator().deallocate(p, size); }
+
+        //==============================================================================
+        /** Set a property on the shadow view.
+
+            The root hands a shadow view only the properties its type consumes:
+            the flex layout properties, `debug`, `layout-transition` and
+            `layout-boundary`, and any more its view type declares. The value itself is stored once, by the
+            view.
+         */
         virtual void setProperty (const juce::Identifier& name, const juce::var& newValue);
 
+        /** Returns true if the given property is a flex layout property. */
+        static bool isLayoutProperty (const juce::Identifier& name);
+
+        /** Gives the node the whole flex style of the given template node in one
+            copy, as when a view takes a style sheet, rather than setting each of
+            its properties in turn. Returns false, leaving the node alone, if any
+            flex property has been set on it since it was made or last reset, as
+            the copy would undo it.
+         */
+        bool copyStyleFrom (const ShadowView& styleTemplate)
+        {
+            if (hasLayoutStyle)
+                return false;
+
+            YGNodeCopyStyle(yogaNode, styleTemplate.yogaNode);
+            hasLayoutStyle = true;
+            markLayoutChanged();
+            return true;
+        }
+
+        /** Returns false if `display: none` takes the node out of the layout. */
+        bool isDisplayed() const { return YGNodeStyleGetDisplay(yogaNode) != YGDisplayNone; }
+
         /** Adds a child component behind the existing children. */
         virtual void addChild (ShadowView* childView, int index = -1)
         {
@@ -54,6 +131,29 @@ namespace blueprint
                 YGNodeInsertChild(yogaNode, childView->yogaNode, index);
                 children.insert(children.begin() + index, childView);
             }
+
+            childView->parent = this;
+            markLayoutChanged(false);
+        }
+
+        /** Moves a child to the given index among the children, leaving its own
+            subtree, and whatever Yoga knows of its layout, as it is.
+         */
+        void moveChild (ShadowView* childView, int index)
+        {
+            auto it = std::find(children.begin(), children.end(), childView);
+
+            if (it == children.end())
+                return;
+
+            jassert (juce::isPositiveAndBelow(index, static_cast<int>(children.size())));
+
+            children.erase(it);
+            children.insert(children.begin() + index, childView);
+
+            YGNodeRemoveChild(yogaNode, childView->yogaNode);
+            YGNodeInsertChild(yogaNode, childView->yogaNode, index);
+            markLayoutChanged(false);
         }
 
         /** Removes a child component from the children array. */
@@ -65,13 +165,167 @@ namespace blueprint
             {
                 YGNodeRemoveChild(yogaNode, childView->yogaNode);
                 children.erase(it);
+                childView->parent = nullptr;
+                markLayoutChanged(false);
             }
         }
 
+        /** Returns the node to its state as constructed, so that the root can
+            reuse it for a new view of the same type. The node must already be
+            detached from its parent.
+         */
+        virtual void resetForReuse()
+        {
+            jassert (parent == nullptr);
+
+            for (auto* child : children)
+                child->parent = nullptr;
+
+            children.clear();
+            YGNodeRemoveAllChildren(yogaNode);
+
+            // Yoga keeps the node's config, so the web defaults still hold.
+            YGNodeReset(yogaNode);
+
+            debugLayout = false;
+            layoutBoundary = false;
+            hasLayoutStyle = false;
+            hasLayoutTransition = false;
+            hasBeenLaidOut = false;
+            layoutTransition = {};
+            markLayoutChanged();
+        }
+
         //==============================================================================
         /** Returns a pointer to the View instance shadowed by this node. */
         View* getAssociatedView() { return view; }
 
+        /** Returns which kind of shadow view this is. */
+        Kind getKind() const noexcept { return kind; }
+
+        /** Returns the parent node, or nullptr if the node hasn't been added to one. */
+        ShadowView* getParent() { return parent; }
+
+        /** Returns the child nodes, in order. */
+        const std::vector<ShadowView*>& getChildren() const { return children; }
+
+        /** Returns the Yoga node holding our flex style and computed layout. */
+        YGNodeRef getYogaNode() const { return yogaNode; }
+
+        /** Returns a number which changes whenever anything in the subtree under
+            this node changes in a way which might move its layout: a flex
+            property, a child added or removed, or text to measure again.
+         */
+        juce::uint64 getLayoutRevision() const { return layoutRevision; }
+
+        /** Gives this node and every ancestor a new layout revision. Call on the
+            message thread.
+
+            Pass false for a change which can only move things within the node,
+            such as a child added or removed, rather than the node's own box.
+         */
+        void markLayoutChanged (bool affectsOwnBox = true)
+        {
+            const auto revision = ++lastRevision();
+
+            ownRevision = revision;
+
+            if (affectsOwnBox)
+                boxRevision = revision;
+
+            for (auto* node = this; node != nullptr; node = node->parent)
+                node->layoutRevision = revision;
+        }
+
+        /** Returns the latest layout revision given to any node. */
+        static juce::uint64 getLatestLayoutRevision() { return lastRevision(); }
+
+        //==============================================================================
+        /** Returns true if the node is a `layout-boundary` whose box nothing within
+            it can move: its width and height are fixed in points, and its padding
+            doesn't depend on its parent's width.
+         */
+        bool isLayoutBoundary() const
+        {
+            if (!layoutBoundary || parent == nullptr)
+                return false;
+
+            if (YGNodeStyleGetWidth(yogaNode).unit != YGUnitPoint || YGNodeStyleGetHeight(yogaNode).unit != YGUnitPoint)
+                return false;
+
+            for (int edge = YGEdgeLeft; edge <= YGEdgeAll; ++edge)
+                if (YGNodeStyleGetPadding(yogaNode, static_cast<YGEdge>(edge)).unit == YGUnitPercent)
+                    return false;
+
+            return true;
+        }
+
+        /** Collects the layout boundaries within which everything changed since
+            the given revision lies. Returns false if anything changed outside of
+            a boundary, or moved a boundary's own box, so that the whole tree
+            must be laid out again.
+         */
+        bool collectDirtyLayoutBoundaries (juce::uint64 sinceRevision, std::vector<ShadowView*>& boundaries)
+        {
+            if (layoutRevision <= sinceRevision)
+                return true;
+
+            if (isLayoutBoundary() && boxRevision <= sinceRevision)
+            {
+                boundaries.push_back(this);
+                return true;
+            }
+
+            if (ownRevision > sinceRevision)
+                return false;
+
+            for (auto* child : children)
+                if (!child->collectDirtyLayoutBoundaries(sinceRevision, boundaries))
+                    return false;
+
+            return true;
+        }
+
+        /** Lays out the subtree under a layout boundary, at the size it already
+            has, and flushes the new bounds within it. The boundary itself stays
+            where it is, so nothing outside of it is touched. Returns the number
+            of nodes flushed.
+         */
+        int layoutWithinBoundary (LayoutAnimator* animator = nullptr)
+        {
+            jassert (isLayoutBoundary());
+
+            // Yoga places a node it lays out as a root at the origin, which the
+            // next full layout puts right; only the children are flushed here.
+            YGNodeCalculateLayout(yogaNode, YGNodeLayoutGetWidth(yogaNode), YGNodeLayoutGetHeight(yogaNode), YGDirectionInherit);
+            YGNodeSetHasNewLayout(yogaNode, false);
+
+            int numFlushed = 0;
+
+            for (auto& child : children)
+                numFlushed += child->flushViewLayout(animator);
+
+            return numFlushed;
+        }
+
+        /** Offsets the children of a layout-only view by the view's position, as
+            they're mounted on the view's nearest ancestor which isn't layout-only.
+            The children of a real view sit in it, with no offset.
+         */
+        void updateChildOffsets()
+        {
+            const auto offset = view->isLayoutOnly() ? view->getLayoutOffset() + view->getFloatBounds().getPosition()
+                                                     : juce::Point<float>();
+
+            for (auto* child : children)
+            {
+                child->view->setLayoutOffset(offset);
+
+                if (child->view->isLayoutOnly())
+                    child->updateChildOffsets();
+            }
+        }
+
         /** Returns the layout bounds held by the internal yogaNode. */
         juce::Rectangle<float> getCachedLayoutBounds()
         {
@@ -92,34 +346,161 @@ namespace blueprint
 
         /** Recursive traversal of the shadow tree, flushing layout bounds to
             the associated view components.
+
+            Yoga flags every node whose layout was recomputed during the last
+            layout pass, and a node without new layout implies none of its
+            descendants have new layout either. So we skip any clean subtree
+            entirely, and clear the flag on the nodes we do visit.
+
+            Given an animator, views with a `layout-transition` tween to their
+            new bounds rather than snapping to them. Returns the number of nodes
+            flushed.
          */
-        virtual void flushViewLayout()
+        virtual int flushViewLayout (LayoutAnimator* animator = nullptr)
         {
-            view->setFloatBounds(getCachedLayoutBounds());
-            view->setBounds(getCachedLayoutBounds().toNearestInt());
+            if (!YGNodeGetHasNewLayout(yogaNode))
+                return 0;
+
+            YGNodeSetHasNewLayout(yogaNode, false);
+
+            // Yoga zeroes a hidden subtree; its views keep their last bounds, and
+            // send no Measure events, so that showing it again is instant.
+            if (!isDisplayed())
+                return 0;
+
+            applyComputedLayout(getCachedLayoutBounds(), animator);
 
 #ifdef DEBUG
-            if (props.contains("debug"))
+            if (debugLayout)
                 YGNodePrint(yogaNode, (YGPrintOptions) (YGPrintOptionsLayout
                                                         | YGPrintOptionsStyle
                                                         | YGPrintOptionsChildren));
 #endif
 
+            int numFlushed = 1;
+
             for (auto& child : children)
-                child->flushViewLayout();
+                numFlushed += child->flushViewLayout(animator);
+
+            return numFlushed;
+        }
+
+        /** Moves the view to its newly computed layout bounds, whether they come
+            from our own node or from a LayoutSnapshot computed elsewhere.
+         */
+        virtual void applyComputedLayout (const juce::Rectangle<float>& bounds, LayoutAnimator* animator)
+        {
+            applyLayoutBounds(bounds, animator);
+
+            // Children whose own layout didn't change still move with a
+            // layout-only parent, so we can't leave them to their own flush.
+            if (view->isLayoutOnly())
+                updateChildOffsets();
         }
 
     protected:
+        //==============================================================================
+        /** Constructs a shadow view of one of the tagged kinds. */
+        ShadowView (View* _view, Kind _kind) : view(_view), kind(_kind)
+        {
+            yogaNode = YGNodeNewWithConfig(getConfigForNewNodes());
+        }
+
+        //==============================================================================
+        /** Moves the view to new layout bounds, or hands them to the animator if
+            the view transitions between layouts.
+         */
+        void applyLayoutBounds (const juce::Rectangle<float>& bounds, LayoutAnimator* animator)
+        {
+            // Yoga flags a node whenever it visits it, whether or not its layout
+            // actually moved, so we only touch the view when the rect changed.
+            if (animator != nullptr && animator->isTransitioningTo(view->getViewId(), bounds))
+                return;
+
+            const auto current = view->getFloatBounds();
+            const bool isFirstLayout = !hasBeenLaidOut;
+            hasBeenLaidOut = true;
+
+            // A view's first layout has nowhere to transition from.
+            if (animator != nullptr && hasLayoutTransition && !isFirstLayout && bounds != current)
+            {
+                animator->animate(*view, bounds, layoutTransition);
+                return;
+            }
+
+            if (animator != nullptr)
+                animator->cancel(view->getViewId());
+
+            if (bounds != current)
+                view->setFloatBounds(bounds);
+        }
+
         //==============================================================================
         YGNodeRef yogaNode;
         View* view = nullptr;
-        juce::NamedValueSet props;
+        ShadowView* parent = nullptr;
+
+        bool debugLayout = false;
+        bool layoutBoundary = false;
+
+        // Whether any flex property has been set since the node was made or reset.
+        bool hasLayoutStyle = false;
+
+        bool hasLayoutTransition = false;
+        bool hasBeenLaidOut = false;
+        AnimatedValue::Config layoutTransition;
+        juce::uint64 layoutRevision = 0;
+
+        // When the node itself last changed, and its own box with it.
+        juce::uint64 ownRevision = 0;
+        juce::uint64 boxRevision = 0;
 
         std::vector<ShadowView*> children;
 
     private:
+        //==============================================================================
+        Kind kind;
+
+        //==============================================================================
+        /** The allocator outlives every shadow view, however late in shutdown the
+            last is destroyed, so we never destroy it.
+         */
+        static SlabAllocator& getAllocator()
+        {
+            static auto* allocator = new SlabAllocator();
+            return *allocator;
+        }
+
+        static juce::uint64& lastRevision()
+        {
+            static juce::uint64 revision = 0;
+            return revision;
+        }
+
+        static YGConfigRef& currentConfig()
+        {
+            thread_local YGConfigRef config = nullptr;
+            return config;
+        }
+
+        LiveObjectCounter<ShadowView> liveCounter;
+
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ShadowView)
     };
 
+    //==============================================================================
+    /** Returns the given shadow view as one of the tagged shadow view classes,
+        or nullptr if it's of another kind, as viewCast does for views.
+     */
+    template <typename ShadowViewClass>
+    ShadowViewClass* shadowViewCast (ShadowView* shadowView) noexcept
+    {
+        if (shadowView == nullptr || shadowView->getKind() != ShadowViewClass::shadowViewKind)
+            return nullptr;
+
+        jassert (dynamic_cast<ShadowViewClass*>(shadowView) != nullptr);
+        return static_cast<ShadowViewClass*>(shadowView);
+    }
+
 }
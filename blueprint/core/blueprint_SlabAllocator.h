@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    blueprint_SlabAllocator.h
+    Created: 15 Oct 2026 12:14:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A small object allocator which carves blocks of a few size classes out of
+        large slabs, for objects made and destroyed in great numbers together,
+        such as the ShadowViews of a tree.
+
+        Objects allocated one after another sit next to each other in the same
+        slab, rather than wherever the heap puts them, so that walking a tree
+        built in one go walks mostly contiguous memory. Freed blocks go back on
+        their size class's free list for the next allocation; slabs themselves
+        are kept for the life of the process.
+
+        Sizes above `maxBlockSize` go straight to the heap. Safe to use from any
+        thread, though it's only quick while uncontended.
+     */
+    class SlabAllocator
+    {
+    public:
+        //==============================================================================
+        SlabAllocator() = default;
+
+        //==============================================================================
+        /** Returns a block of at least the given size, aligned for any object. */
+        void* allocate (size_t size)
+        {
+            if (size > maxBlockSize)
+                return ::operator new(size);
+
+            const auto sizeClass = getSizeClass(size);
+            const juce::SpinLock::ScopedLockType sl (lock);
+
+            auto& freeList = freeLists[sizeClass];
+
+            if (freeList == nullptr)
+                refill(sizeClass);
+
+            auto* block = freeList;
+            freeList = block->next;
+
+            return block;
+        }
+
+        /** Returns a block to the allocator, given the size it was allocated with. */
+        void deallocate (void* p, size_t size)
+        {
+            if (p == nullptr)
+                return;
+
+            if (size > maxBlockSize)
+                return ::operator delete(p);
+
+            const auto sizeClass = getSizeClass(size);
+            const juce::SpinLock::ScopedLockType sl (lock);
+
+            auto* block = static_cast<FreeBlock*>(p);
+            block->next = freeLists[sizeClass];
+            freeLists[sizeClass] = block;
+        }
+
+        //==============================================================================
+        static constexpr size_t granularity = 16;
+        static constexpr size_t maxBlockSize = 512;
+
+    private:
+        //==============================================================================
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        static size_t getSizeClass (size_t size)
+        {
+            return (juce::jmax(size, (size_t) 1) + granularity - 1) / granularity - 1;
+        }
+
+        void refill (size_t sizeClass)
+        {
+            const size_t blockSize = (sizeClass + 1) * granularity;
+            const size_t numBlocks = juce::jmax((size_t) 1, slabSize / blockSize);
+
+            auto* slab = static_cast<char*>(::operator new(blockSize * numBlocks));
+            slabs.push_back(slab);
+
+            // Threaded back to front, so that blocks are handed out in address
+            // order.
+            for (size_t i = numBlocks; i-- > 0;)
+            {
+                auto* block = reinterpret_cast<FreeBlock*>(slab + i * blockSize);
+                block->next = freeLists[sizeClass];
+                freeLists[sizeClass] = block;
+            }
+        }
+
+        //==============================================================================
+        static constexpr size_t slabSize = 64 * 1024;
+
+        juce::SpinLock lock;
+        std::array<FreeBlock*, maxBlockSize / granularity> freeLists {};
+        std::vector<char*> slabs;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE (SlabAllocator)
+    };
+
+}
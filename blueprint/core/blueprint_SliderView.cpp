@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    blueprint_SliderView.cpp
+    Created: 15 Oct 2026 9:21:14am
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    void SliderView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+
+        if (name == IDs::parameterId)
+        {
+            parameterId = v.toString();
+
+            // Parameters give no notice of changes we can rely on from any
+            // thread, so we look at the parameter once a frame.
+            if (parameterId.isNotEmpty())
+            {
+                startTimerHz(60);
+                timerCallback();
+            }
+            else
+            {
+                stopTimer();
+            }
+        }
+        else if (name == IDs::value)
+        {
+            // A parameter, or a drag in progress, knows better.
+            if (parameterId.isEmpty() && !dragging)
+                setValue((double) v, false);
+        }
+        else if (name == IDs::defaultValue)
+        {
+            defaultValue = juce::jlimit(0.0, 1.0, (double) v);
+        }
+        else if (name == IDs::dragMode)
+        {
+            const auto mode = v.toString();
+            dragMode = mode == "vertical" ? DragMode::Vertical
+                     : mode == "horizontal" ? DragMode::Horizontal
+                     : DragMode::Rotary;
+        }
+        else if (name == IDs::dragSensitivity)
+        {
+            dragSensitivity = juce::jmax(1.0f, (float) v);
+        }
+        else if (name == IDs::trackColor)
+        {
+            trackColour = parseColourValue(v);
+        }
+        else if (name == IDs::fillColor)
+        {
+            fillColour = parseColourValue(v);
+        }
+        else if (name == IDs::trackWidth)
+        {
+            trackWidth = juce::jmax(0.0f, (float) v);
+        }
+    }
+
+    //==============================================================================
+    void SliderView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("SliderView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "SliderView");
+
+        View::paint(g);
+
+        const auto bounds = getLocalBounds().toFloat();
+
+        if (dragMode != DragMode::Rotary)
+        {
+            g.setColour(trackColour);
+            g.fillRect(bounds);
+
+            g.setColour(fillColour);
+
+            if (dragMode == DragMode::Vertical)
+                g.fillRect(bounds.withTop(bounds.getBottom() - bounds.getHeight() * (float) value));
+            else
+                g.fillRect(bounds.withWidth(bounds.getWidth() * (float) value));
+
+            return;
+        }
+
+        // As with borders, we bring the radius in by half the stroke so that
+        // the stroke isn't clipped at the edge of the view.
+        const auto centre = bounds.getCentre();
+        const float radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) * 0.5f - trackWidth * 0.5f;
+        const float startAngle = juce::MathConstants<float>::pi * -0.75f;
+        const float arcLength = juce::MathConstants<float>::pi * 1.5f;
+
+        if (radius <= 0.0f)
+            return;
+
+        const juce::PathStrokeType stroke (trackWidth);
+        juce::Path track, fill;
+
+        track.addCentredArc(centre.x, centre.y, radius, radius, 0.0f, startAngle, startAngle + arcLength, true);
+        fill.addCentredArc(centre.x, centre.y, radius, radius, 0.0f, startAngle, startAngle + arcLength * (float) value, true);
+
+        g.setColour(trackColour);
+        g.strokePath(track, stroke);
+
+        if (value > 0.0)
+        {
+            g.setColour(fillColour);
+            g.strokePath(fill, stroke);
+        }
+    }
+
+    //==============================================================================
+    void SliderView::mouseDown (const juce::MouseEvent& e)
+    {
+        View::mouseDown(e);
+
+        dragging = true;
+        valueAtDragStart = value;
+
+        if (auto* target = getTarget())
+            if (target->beginGesture)
+                target->beginGesture();
+    }
+
+    void SliderView::mouseDrag (const juce::MouseEvent& e)
+    {
+        View::mouseDrag(e);
+
+        // Upwards counts as increasing the value.
+        const auto offset = e.getOffsetFromDragStart();
+        const float dx = (float) offset.x;
+        const float dy = (float) -offset.y;
+
+        const float distance = dragMode == DragMode::Vertical ? dy
+                             : dragMode == DragMode::Horizontal ? dx
+                             : dx + dy;
+
+        setValue(valueAtDragStart + distance / dragSensitivity, true);
+    }
+
+    void SliderView::mouseUp (const juce::MouseEvent& e)
+    {
+        View::mouseUp(e);
+
+        dragging = false;
+
+        if (auto* target = getTarget())
+            if (target->endGesture)
+                target->endGesture();
+    }
+
+    void SliderView::mouseDoubleClick (const juce::MouseEvent& e)
+    {
+        View::mouseDoubleClick(e);
+
+        // The double click's second press has opened a gesture of its own,
+        // which the matching mouseUp closes.
+        valueAtDragStart = defaultValue;
+        setValue(defaultValue, true);
+    }
+
+    //==============================================================================
+    const ParameterTarget* SliderView::getTarget()
+    {
+        if (parameterId.isEmpty())
+            return nullptr;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            return root->getParameterTarget(parameterId);
+
+        return nullptr;
+    }
+
+    void SliderView::setValue (double newValue, bool notifyTarget)
+    {
+        newValue = juce::jlimit(0.0, 1.0, newValue);
+
+        if (newValue == value)
+            return;
+
+        value = newValue;
+        repaint();
+
+        if (notifyTarget)
+            if (auto* target = getTarget())
+                if (target->setValue)
+                    target->setValue(value);
+
+        if (!hasEventHandler(ValueChangeEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->queueValueChangeEvent(getViewId(), value);
+    }
+
+    void SliderView::timerCallback()
+    {
+        if (dragging)
+            return;
+
+        if (auto* target = getTarget())
+            if (target->getValue)
+                setValue(target->getValue(), false);
+    }
+
+}
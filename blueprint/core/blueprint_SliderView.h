@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    blueprint_SliderView.h
+    Created: 15 Oct 2026 9:21:14am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_ParameterTarget.h"
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The SliderView class is a core view for knobs and sliders which handle
+        their gestures natively.
+
+        A drag moves the value by its distance over `drag-sensitivity` pixels
+        (200 by default) for the whole range. In the default `rotary` drag mode,
+        the drag counts both rightwards and upwards; in the `vertical` and
+        `horizontal` modes, only the one direction. A double click returns the
+        value to `default-value`. The view paints a rotary arc, or a bar in the
+        linear modes, of `track-color` filled with `fill-color` up to the value.
+
+        With a `parameter-id`, the view drives the ParameterTarget registered
+        with the root under that id. It brackets each drag in a gesture, writes
+        the parameter as it goes, and follows the parameter when anything else
+        moves it. Without one, `value` sets the value.
+
+        Either way, the view tells React of new values in an `onValueChange`
+        event, at most once a frame, with the latest value.
+     */
+    class SliderView : public View, private juce::Timer
+    {
+    public:
+        //==============================================================================
+        SliderView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+        void mouseDown (const juce::MouseEvent& e) override;
+        void mouseDrag (const juce::MouseEvent& e) override;
+        void mouseUp (const juce::MouseEvent& e) override;
+        void mouseDoubleClick (const juce::MouseEvent& e) override;
+
+    protected:
+        //==============================================================================
+        /** Returns the value, from 0 to 1. */
+        double getValue() const { return value; }
+
+    private:
+        //==============================================================================
+        enum class DragMode
+        {
+            Rotary,
+            Vertical,
+            Horizontal,
+        };
+
+        /** Returns the target we drive, or nullptr if there's none registered. */
+        const ParameterTarget* getTarget();
+
+        /** Moves the value, writing the target if `notifyTarget` is set. */
+        void setValue (double newValue, bool notifyTarget);
+
+        /** Follows the target's value while we're not dragging it ourselves. */
+        void timerCallback() override;
+
+        //==============================================================================
+        juce::String parameterId;
+        double value = 0.0;
+        double defaultValue = 0.0;
+        double valueAtDragStart = 0.0;
+        bool dragging = false;
+
+        DragMode dragMode = DragMode::Rotary;
+        float dragSensitivity = 200.0f;
+
+        juce::Colour trackColour { 0xff626262 };
+        juce::Colour fillColour { 0xff66fdcf };
+        float trackWidth = 2.0f;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SliderView)
+    };
+
+}
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    blueprint_SpectrumAnalyser.h
+    Created: 15 Oct 2026 10:41:26am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "blueprint_SampleRingBuffer.h"
+
+
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Performs windowed FFTs of the latest samples of a SampleRingBuffer on a
+        background thread, for a SpectrumView to paint.
+
+        Every analyser in the process shares one analysis thread. Each time slice
+        the analyser takes the latest `fftSize` samples, if any have arrived since
+        the last, applies a Hann window and transforms them, and smooths the bin
+        levels in decibels against the previous spectrum. The message thread then
+        copies out the latest spectrum with `getSpectrum`, which never waits on
+        the analysis: if the analyser is publishing at that moment, it reports
+        nothing new until the next frame.
+     */
+    class SpectrumAnalyser : private juce::TimeSliceClient
+    {
+    public:
+        //==============================================================================
+        SpectrumAnalyser() = default;
+
+        ~SpectrumAnalyser() override
+        {
+            setSource(nullptr);
+        }
+
+        //==============================================================================
+        /** Starts analysing the given buffer, or stops for nullptr. */
+        void setSource (SampleRingBuffer* newSource)
+        {
+            // Removing a client waits for any time slice in progress.
+            thread->removeTimeSliceClient(this);
+
+            source = newSource;
+            numWrittenAtAnalysis = 0;
+
+            if (source != nullptr)
+            {
+                prepare();
+                thread->addTimeSliceClient(this);
+            }
+        }
+
+        /** Sets the FFT size as a power of two, from 2^8 to 2^15. */
+        void setOrder (int newOrder)
+        {
+            newOrder = juce::jlimit(8, 15, newOrder);
+
+            if (newOrder == order)
+                return;
+
+            auto* current = source;
+            setSource(nullptr);
+            order = newOrder;
+            setSource(current);
+        }
+
+        /** Sets how much of the previous spectrum carries into each new one, from
+            0 for none to just below 1 for a very slow response.
+         */
+        void setSmoothing (float newSmoothing)
+        {
+            smoothing.store(juce::jlimit(0.0f, 0.99f, newSmoothing), std::memory_order_relaxed);
+        }
+
+        //==============================================================================
+        /** Copies the latest spectrum, in decibels per bin from DC upwards, if it's
+            changed since the given sequence number, which is then updated. Returns
+            false if there's nothing new.
+         */
+        bool getSpectrum (std::vector<float>& dest, juce::uint32& sequence)
+        {
+            const juce::SpinLock::ScopedTryLockType sl (publishLock);
+
+            if (!sl.isLocked() || sequence == publishedSequence)
+                return false;
+
+            dest = published;
+            sequence = publishedSequence;
+            return true;
+        }
+
+        /** Returns the number of samples per FFT. */
+        int getSize() const { return 1 << order; }
+
+        /** Returns the rate of the samples analysed. */
+        double getSampleRate() const { return source != nullptr ? source->getSampleRate() : 44100.0; }
+
+    private:
+        //==============================================================================
+        struct AnalysisThread : public juce::TimeSliceThread
+        {
+            AnalysisThread() : juce::TimeSliceThread("Blueprint spectrum analysis") { startThread(); }
+            ~AnalysisThread() override { stopThread(-1); }
+        };
+
+        void prepare()
+        {
+            const int size = getSize();
+
+            fft = std::make_unique<juce::dsp::FFT>(order);
+            window = std::make_unique<juce::dsp::WindowingFunction<float>>(static_cast<size_t>(size),
+                                                                             juce::dsp::WindowingFunction<float>::hann,
+                                                                             true);
+
+            // The frequency only transform works in place on twice the samples.
+            workspace.assign(static_cast<size_t>(size) * 2, 0.0f);
+            levels.assign(static_cast<size_t>(size / 2 + 1), floorDecibels);
+
+            const juce::SpinLock::ScopedLockType sl (publishLock);
+            published = levels;
+            ++publishedSequence;
+        }
+
+        int useTimeSlice() override
+        {
+            const auto numWritten = source->getNumWritten();
+
+            if (numWritten == numWrittenAtAnalysis)
+                return idleIntervalMs;
+
+            numWrittenAtAnalysis = numWritten;
+
+            const int size = getSize();
+            const int numRead = source->readLatest(workspace.data(), size);
+
+            // Until there's a whole window, the rest stays silent.
+            if (numRead < size)
+            {
+                std::memmove(workspace.data() + (size - numRead), workspace.data(), static_cast<size_t>(numRead) * sizeof(float));
+                std::fill(workspace.begin(), workspace.begin() + (size - numRead), 0.0f);
+            }
+
+            window->multiplyWithWindowingTable(workspace.data(), static_cast<size_t>(size));
+            fft->performFrequencyOnlyForwardTransform(workspace.data());
+
+            // The window is normalised, so a full scale sine peaks at half the size.
+            const float scale = 2.0f / (float) size;
+            const float s = smoothing.load(std::memory_order_relaxed);
+
+            for (size_t i = 0; i < levels.size(); ++i)
+            {
+                const float db = juce::Decibels::gainToDecibels(workspace[i] * scale, floorDecibels);
+                levels[i] = levels[i] * s + db * (1.0f - s);
+            }
+
+            {
+                const juce::SpinLock::ScopedLockType sl (publishLock);
+                published = levels;
+                ++publishedSequence;
+            }
+
+            return analysisIntervalMs;
+        }
+
+        //==============================================================================
+        // A little faster than the display, so that each frame has a fresh spectrum.
+        static constexpr int analysisIntervalMs = 10;
+        static constexpr int idleIntervalMs = 20;
+        static constexpr float floorDecibels = -140.0f;
+
+        juce::SharedResourcePointer<AnalysisThread> thread;
+
+        SampleRingBuffer* source = nullptr;
+        size_t numWrittenAtAnalysis = 0;
+
+        int order = 11;
+        std::atomic<float> smoothing { 0.8f };
+
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+        std::vector<float> workspace;
+        std::vector<float> levels;
+
+        juce::SpinLock publishLock;
+        std::vector<float> published;
+        juce::uint32 publishedSequence = 0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyser)
+    };
+
+}
+
+#endif
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    blueprint_SpectrumView.cpp
+    Created: 15 Oct 2026 10:41:26am
+
+  ==============================================================================
+*/
+
+
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+
+namespace blueprint
+{
+
+    //==============================================================================
+    void SpectrumView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+
+        if (name == IDs::source)
+        {
+            sourceName = v.toString();
+            attached = false;
+            analyser.setSource(nullptr);
+
+            if (sourceName.isNotEmpty())
+                scheduler.scheduleFrame();
+            else
+                scheduler.cancel();
+        }
+        else if (name == IDs::fftSize)
+        {
+            const int size = juce::jmax(1, (int) v);
+            analyser.setOrder(juce::roundToInt(std::log2((double) size)));
+        }
+        else if (name == IDs::smoothing)
+        {
+            analyser.setSmoothing((float) v);
+        }
+        else if (name == IDs::minFrequency)
+        {
+            minFrequency = juce::jmax(1.0f, (float) v);
+        }
+        else if (name == IDs::maxFrequency)
+        {
+            maxFrequency = juce::jmax(1.0f, (float) v);
+        }
+        else if (name == IDs::minDecibels)
+        {
+            minDecibels = (float) v;
+        }
+        else if (name == IDs::maxDecibels)
+        {
+            maxDecibels = (float) v;
+        }
+        else if (name == IDs::lineColor)
+        {
+            lineColour = parseColourValue(v);
+        }
+        else if (name == IDs::fillColor)
+        {
+            fillColour = parseColourValue(v);
+        }
+        else if (name == IDs::lineWidth)
+        {
+            lineWidth = juce::jmax(0.0f, (float) v);
+        }
+    }
+
+    //==============================================================================
+    void SpectrumView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("SpectrumView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "SpectrumView");
+
+        View::paint(g);
+
+        const int width = getWidth();
+
+        if (spectrum.size() < 2 || width < 2 || maxFrequency <= minFrequency || maxDecibels <= minDecibels)
+            return;
+
+        const auto bounds = getLocalBounds().toFloat();
+        const float binsPerHz = (float) analyser.getSize() / (float) analyser.getSampleRate();
+        const float logRange = std::log(maxFrequency / minFrequency);
+        const float lastBin = (float) (spectrum.size() - 1);
+
+        auto levelToY = [&](float db) {
+            const float proportion = (db - minDecibels) / (maxDecibels - minDecibels);
+            return bounds.getBottom() - juce::jlimit(0.0f, 1.0f, proportion) * bounds.getHeight();
+        };
+
+        auto binAtX = [&](float x) {
+            return juce::jmin(lastBin, minFrequency * std::exp(logRange * x / (float) width) * binsPerHz);
+        };
+
+        juce::Path path;
+        float bin = binAtX(0.0f);
+
+        for (int x = 0; x < width; ++x)
+        {
+            const float nextBin = binAtX((float) (x + 1));
+
+            // Towards the top, a column spans many bins, and we take the loudest
+            // so that narrow peaks survive. Lower down, we interpolate.
+            float level = getLevelAt(bin);
+
+            for (int b = (int) std::ceil(bin); b < (int) nextBin; ++b)
+                level = juce::jmax(level, spectrum[static_cast<size_t>(b)]);
+
+            const float y = levelToY(level);
+
+            if (x == 0)
+                path.startNewSubPath(0.0f, y);
+            else
+                path.lineTo((float) x, y);
+
+            bin = nextBin;
+        }
+
+        if (!fillColour.isTransparent())
+        {
+            juce::Path area (path);
+            area.lineTo(bounds.getRight(), bounds.getBottom());
+            area.lineTo(bounds.getX(), bounds.getBottom());
+            area.closeSubPath();
+
+            g.setColour(fillColour);
+            g.fillPath(area);
+        }
+
+        g.setColour(lineColour);
+        g.strokePath(path, juce::PathStrokeType (lineWidth));
+    }
+
+    //==============================================================================
+    void SpectrumView::attachSource()
+    {
+        if (attached || sourceName.isEmpty())
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+        {
+            if (auto* buffer = root->getSampleBuffer(sourceName))
+            {
+                analyser.setSource(buffer);
+                attached = true;
+            }
+        }
+    }
+
+    void SpectrumView::frameCallback()
+    {
+        if (sourceName.isEmpty())
+            return;
+
+        attachSource();
+
+        if (attached && analyser.getSpectrum(spectrum, spectrumSequence))
+            repaint();
+
+        scheduler.scheduleFrame();
+    }
+
+    float SpectrumView::getLevelAt (float bin) const
+    {
+        const auto i = static_cast<size_t>(bin);
+        const float frac = bin - (float) i;
+
+        if (i + 1 >= spectrum.size())
+            return spectrum.back();
+
+        return spectrum[i] + (spectrum[i + 1] - spectrum[i]) * frac;
+    }
+
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    blueprint_SpectrumView.h
+    Created: 15 Oct 2026 10:41:26am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "blueprint_FrameScheduler.h"
+#include "blueprint_SpectrumAnalyser.h"
+#include "blueprint_View.h"
+
+
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The SpectrumView class is a core view which draws the frequency spectrum
+        of the latest samples of a SampleRingBuffer.
+
+        `source` names a buffer registered with the root. A SpectrumAnalyser
+        transforms the buffer's latest `fft-size` samples (2048 by default) on
+        a background thread, smoothed by `smoothing`, and the view picks up the
+        latest spectrum once a display frame, repainting only when it's changed.
+        Neither samples nor bins cross the bridge.
+
+        Frequencies from `min-frequency` to `max-frequency` map logarithmically
+        across the view, and levels from `min-decibels` to `max-decibels` from
+        bottom to top. Where a pixel column spans several bins, it shows the
+        loudest of them. The curve strokes with `line-color`, `line-width` thick,
+        and with a `fill-color`, the area beneath it fills too.
+     */
+    class SpectrumView : public View
+    {
+    public:
+        //==============================================================================
+        SpectrumView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+    private:
+        //==============================================================================
+        /** Attaches the analyser to our buffer once the root has it. */
+        void attachSource();
+
+        /** Repaints if there's a new spectrum, and waits for the next frame. */
+        void frameCallback();
+
+        /** Returns the level at the given fractional bin, interpolated. */
+        float getLevelAt (float bin) const;
+
+        //==============================================================================
+        juce::String sourceName;
+        bool attached = false;
+
+        SpectrumAnalyser analyser;
+        std::vector<float> spectrum;
+        juce::uint32 spectrumSequence = 0;
+
+        FrameScheduler scheduler { *this, [this]() { frameCallback(); } };
+
+        float minFrequency = 20.0f;
+        float maxFrequency = 20000.0f;
+        float minDecibels = -100.0f;
+        float maxDecibels = 0.0f;
+
+        juce::Colour lineColour { 0xff66fdcf };
+        juce::Colour fillColour { juce::Colours::transparentBlack };
+        float lineWidth = 1.0f;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumView)
+    };
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    blueprint_TextInputView.cpp
+    Created: 15 Oct 2026 7:52:18pm
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    TextInputView::TextInputView()
+    {
+        // The view paints its own background and border.
+        editor.setColour(juce::TextEditor::backgroundColourId, juce::Colours::transparentBlack);
+        editor.setColour(juce::TextEditor::outlineColourId, juce::Colours::transparentBlack);
+        editor.setColour(juce::TextEditor::focusedOutlineColourId, juce::Colours::transparentBlack);
+
+        editor.addListener(this);
+        addAndMakeVisible(editor);
+
+        updateTextStyle();
+    }
+
+    //==============================================================================
+    void TextInputView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+
+        if (name == IDs::value)
+        {
+            const auto text = v.toString();
+
+            // A change we've sent may come straight back; the editor already
+            // has it, so there's nothing to do, and the caret stays put.
+            if (text != editor.getText())
+            {
+                stopTimer();
+                changePending = false;
+                editor.setText(text, false);
+            }
+        }
+        else if (name == IDs::placeholder)
+        {
+            placeholder = v.toString();
+            updateTextStyle();
+        }
+        else if (name == IDs::multiline)
+        {
+            editor.setMultiLine((bool) v, true);
+            editor.setReturnKeyStartsNewLine((bool) v);
+        }
+        else if (name == IDs::maxLength)
+        {
+            editor.setInputRestrictions(juce::jmax(0, (int) v));
+        }
+        else if (name == IDs::changeDelay)
+        {
+            changeDelayMs = juce::jmax(0, (int) v);
+        }
+        else if (name == IDs::fontSize
+                 || name == IDs::fontStyle
+                 || name == IDs::fontFamily
+                 || name == IDs::kerningFactor
+                 || name == IDs::color)
+        {
+            updateTextStyle();
+        }
+    }
+
+    //==============================================================================
+    void TextInputView::resized()
+    {
+        View::resized();
+        editor.setBounds(getLocalBounds());
+    }
+
+    //==============================================================================
+    void TextInputView::textEditorTextChanged (juce::TextEditor&)
+    {
+        changePending = true;
+
+        if (changeDelayMs == 0)
+            sendPendingChange();
+        else
+            startTimer(changeDelayMs);
+    }
+
+    void TextInputView::textEditorReturnKeyPressed (juce::TextEditor&)
+    {
+        sendPendingChange();
+
+        if (!hasEventHandler(SubmitEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->dispatchViewEvent(getViewId(), IDs::Submit, editor.getText());
+    }
+
+    void TextInputView::textEditorFocusLost (juce::TextEditor&)
+    {
+        sendPendingChange();
+    }
+
+    void TextInputView::timerCallback()
+    {
+        sendPendingChange();
+    }
+
+    void TextInputView::sendPendingChange()
+    {
+        stopTimer();
+
+        if (!changePending)
+            return;
+
+        changePending = false;
+
+        if (!hasEventHandler(ChangeEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->dispatchViewEvent(getViewId(), IDs::Change, editor.getText());
+    }
+
+    //==============================================================================
+    void TextInputView::updateTextStyle()
+    {
+        const auto& s = getStyle();
+
+        font = fontCache->getFont(s.fontFamily, s.fontSize, s.fontStyle, s.kerningFactor);
+
+        editor.setFont(*font);
+        editor.applyFontToAllText(*font);
+
+        editor.setColour(juce::TextEditor::textColourId, s.textColour);
+        editor.setColour(juce::CaretComponent::caretColourId, s.textColour);
+        editor.applyColourToAllText(s.textColour);
+
+        editor.setTextToShowWhenEmpty(placeholder, s.textColour.withMultipliedAlpha(0.5f));
+    }
+
+}
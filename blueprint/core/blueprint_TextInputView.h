@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    blueprint_TextInputView.h
+    Created: 15 Oct 2026 7:52:18pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_FontCache.h"
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The TextInputView class is a core view for editable text, wrapping a
+        juce::TextEditor which edits natively: each keystroke shows straight
+        away, without a round trip through JavaScript.
+
+        React hears of the text in an `onChange` event once typing pauses for
+        `change-delay` milliseconds (150 by default, 0 for every change), and
+        when the editor loses focus, and in an `onSubmit` event, straight away,
+        when return is pressed on a single line editor. A pending change always
+        goes out before the submit.
+
+        `value` sets the text. A value which matches the text already in the
+        editor, such as React echoing back the last change, leaves the editor
+        and its caret alone. `placeholder` shows while the editor is empty,
+        `multiline` lets return start a new line, and `max-length` limits the
+        length of the text. The text takes the view's font properties and
+        `color`; the view's own background and border paint behind it.
+     */
+    class TextInputView : public View,
+                          private juce::TextEditor::Listener,
+                          private juce::Timer
+    {
+    public:
+        //==============================================================================
+        TextInputView();
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        /** Returns the text in the editor. */
+        juce::String getText() const { return editor.getText(); }
+
+        //==============================================================================
+        void resized() override;
+
+    private:
+        //==============================================================================
+        void textEditorTextChanged (juce::TextEditor&) override;
+        void textEditorReturnKeyPressed (juce::TextEditor&) override;
+        void textEditorFocusLost (juce::TextEditor&) override;
+
+        /** Sends the pending change, once typing pauses. */
+        void timerCallback() override;
+
+        /** Sends an `onChange` event with the text, if one is pending. */
+        void sendPendingChange();
+
+        /** Applies the font and colour properties to the editor's text. */
+        void updateTextStyle();
+
+        //==============================================================================
+        juce::TextEditor editor;
+        juce::SharedResourcePointer<FontCache> fontCache;
+        FontCache::FontHandle font;
+
+        juce::String placeholder;
+        int changeDelayMs = 150;
+        bool changePending = false;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TextInputView)
+    };
+
+}
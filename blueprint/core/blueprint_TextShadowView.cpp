@@ -16,21 +16,32 @@ namespace blueprint
     //==============================================================================
     YGSize measureTextNode(YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) {
         TextShadowView* context = reinterpret_cast<TextShadowView*>(YGNodeGetContext(node));
-        TextView* view = dynamic_cast<TextView*>(context->getAssociatedView());
+        TextView* view = viewCast<TextView>(context->getAssociatedView());
 
         jassert (view != nullptr);
 
-        // TODO: This is a bit of an oversimplification. We have a YGMeasureMode which
-        // is one of three things, "undefined", "exact", or "at-most." Here we're kind of
-        // just ignoring that, and in cases like `white-space: nowrap;` we want to ignore it,
-        // but it would probably be good to get specific for each case.
-        // See https://github.com/facebook/yoga/pull/576/files
-        auto tl = view->getTextLayout(width);
-
-        return {
-            tl.getWidth(),
-            tl.getHeight()
-        };
+        // If Yoga has already decided on both dimensions there's nothing to measure.
+        if (widthMode == YGMeasureModeExactly && heightMode == YGMeasureModeExactly)
+            return { width, height };
+
+        YGSize result;
+
+        if (context->findMemoizedMeasure(width, widthMode, height, heightMode, result))
+            return result;
+
+        // A single line label, the common case, measures from its shared glyph
+        // run, and never builds a TextLayout at all.
+        if (auto* run = view->getGlyphRun(getTextLayoutWidth(width, widthMode)))
+            result = fitTextSize(run->width, run->height, width, widthMode, height, heightMode);
+        else
+            result = measureTextLayout([view](float layoutWidth) -> const juce::TextLayout& { return view->getTextLayout(layoutWidth); },
+                                       width, widthMode, height, heightMode);
+
+        if (auto* root = view->getOwningRoot())
+            root->recordTextMeasures(1);
+
+        context->memoizeMeasure(width, widthMode, height, heightMode, result);
+        return result;
     }
 
 }
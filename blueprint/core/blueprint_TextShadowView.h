@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <array>
+#include <limits>
+
 #include "blueprint_ShadowView.h"
 #include "blueprint_View.h"
 
@@ -22,6 +25,53 @@ namespace blueprint
      */
     YGSize measureTextNode(YGNodeRef, float, YGMeasureMode, float, YGMeasureMode);
 
+    /** Returns the width to lay text out at for Yoga's width constraint.
+     *
+     *  With an undefined width the offered width is meaningless (typically NaN),
+     *  so we lay out on a single unbounded line and take its natural width.
+     *  See https://github.com/facebook/yoga/pull/576/files
+     */
+    inline float getTextLayoutWidth (float width, YGMeasureMode widthMode)
+    {
+        return (widthMode == YGMeasureModeUndefined)
+            ? std::numeric_limits<float>::max()
+            : width;
+    }
+
+    /** Fits text of the given natural size to Yoga's measure constraints. */
+    inline YGSize fitTextSize (float textWidth, float textHeight, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+    {
+        YGSize result;
+
+        switch (widthMode)
+        {
+            case YGMeasureModeExactly:  result.width = width; break;
+            case YGMeasureModeAtMost:   result.width = std::min(textWidth, width); break;
+            case YGMeasureModeUndefined:
+            default:                    result.width = textWidth; break;
+        }
+
+        switch (heightMode)
+        {
+            case YGMeasureModeExactly:  result.height = height; break;
+            case YGMeasureModeAtMost:   result.height = std::min(textHeight, height); break;
+            case YGMeasureModeUndefined:
+            default:                    result.height = textHeight; break;
+        }
+
+        return result;
+    }
+
+    /** Fits text to Yoga's measure constraints, given a function which returns a
+     *  TextLayout of the text at a given width.
+     */
+    template <typename LayoutAtWidth>
+    YGSize measureTextLayout (LayoutAtWidth&& getLayout, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+    {
+        const juce::TextLayout& tl = getLayout(getTextLayoutWidth(width, widthMode));
+        return fitTextSize(tl.getWidth(), tl.getHeight(), width, widthMode, height, heightMode);
+    }
+
     //==============================================================================
     /** The TextShadowView extends a ShadowView to provide specialized behavior
      *  for measuring text content, as text layout is removed from the FlexBox
@@ -31,13 +81,24 @@ namespace blueprint
     {
     public:
         //==============================================================================
-        TextShadowView(View* _view) : ShadowView(_view)
+        static constexpr Kind shadowViewKind = Kind::Text;
+
+        TextShadowView(View* _view) : ShadowView(_view, shadowViewKind)
         {
             YGNodeSetContext(yogaNode, this);
             YGNodeSetMeasureFunc(yogaNode, measureTextNode);
         }
 
         //==============================================================================
+        /** Resets the node, which also clears our measure function. */
+        void resetForReuse() override
+        {
+            ShadowView::resetForReuse();
+
+            YGNodeSetContext(yogaNode, this);
+            YGNodeSetMeasureFunc(yogaNode, measureTextNode);
+        }
+
         /** Set a property on the shadow view. */
         void setProperty (const juce::Identifier& name, const juce::var& value) override
         {
@@ -45,10 +106,21 @@ namespace blueprint
 
             // For certain text properties we want Yoga to know that we need
             // to measure again. For example, changing the font size.
-            if (name == juce::Identifier("font-size"))
+            if (isMeasureProperty(name))
                 markDirty();
         }
 
+        /** Returns true if the given property affects the measured size of text. */
+        static bool isMeasureProperty (const juce::Identifier& name)
+        {
+            return name == IDs::fontSize
+                || name == IDs::fontStyle
+                || name == IDs::fontFamily
+                || name == IDs::kerningFactor
+                || name == IDs::lineSpacing
+                || name == IDs::wordWrap;
+        }
+
         /** Override the default ShadowView behavior to explicitly error. */
         void addChild (ShadowView* childView, int index = -1) override
         {
@@ -58,13 +130,82 @@ namespace blueprint
             }
         }
 
+        /** Returns true if the node's width and height are both given in points,
+         *  so that Yoga never measures its text and no change to the text can
+         *  change the layout.
+         */
+        bool hasFixedSize() const
+        {
+            return YGNodeStyleGetWidth(yogaNode).unit == YGUnitPoint
+                && YGNodeStyleGetHeight(yogaNode).unit == YGUnitPoint;
+        }
+
         /** Sets a flag to indicate that this node needs to be measured at the next layout pass. */
         void markDirty()
         {
+            clearMemoizedMeasures();
             YGNodeMarkDirty(yogaNode);
+            markLayoutChanged();
+        }
+
+        /** Forgets every measurement, as the text they were of has changed. */
+        void clearMemoizedMeasures()
+        {
+            numMemoizedMeasures = 0;
+            nextMemoizedMeasure = 0;
+        }
+
+        //==============================================================================
+        /** Looks up a previous measurement for the given constraints, returning true
+         *  and filling in the result if one is found.
+         *
+         *  A single layout pass may measure a node several times under different
+         *  constraints, and Yoga's own cache only remembers a handful of those, so
+         *  we keep a small memo of our own which lives until the text changes.
+         */
+        bool findMemoizedMeasure (float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode, YGSize& result) const
+        {
+            for (int i = 0; i < numMemoizedMeasures; ++i)
+            {
+                const auto& m = memoizedMeasures[static_cast<size_t>(i)];
+
+                if (m.widthMode == widthMode && m.heightMode == heightMode
+                    && (widthMode == YGMeasureModeUndefined || m.width == width)
+                    && (heightMode == YGMeasureModeUndefined || m.height == height))
+                {
+                    result = m.result;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /** Records a measurement, evicting the oldest if the memo is full. */
+        void memoizeMeasure (float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode, YGSize result)
+        {
+            memoizedMeasures[static_cast<size_t>(nextMemoizedMeasure)] = { width, widthMode, height, heightMode, result };
+            nextMemoizedMeasure = (nextMemoizedMeasure + 1) % maxMemoizedMeasures;
+            numMemoizedMeasures = std::min(numMemoizedMeasures + 1, maxMemoizedMeasures);
         }
 
     private:
+        //==============================================================================
+        struct MemoizedMeasure
+        {
+            float width;
+            YGMeasureMode widthMode;
+            float height;
+            YGMeasureMode heightMode;
+            YGSize result;
+        };
+
+        static constexpr int maxMemoizedMeasures = 4;
+
+        std::array<MemoizedMeasure, maxMemoizedMeasures> memoizedMeasures;
+        int numMemoizedMeasures = 0;
+        int nextMemoizedMeasure = 0;
+
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TextShadowView)
     };
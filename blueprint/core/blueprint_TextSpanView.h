@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    blueprint_TextSpanView.h
+    Created: 15 Oct 2026 7:44:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The TextSpanView class is a <Text> element nested within another, such as
+        a word in bold partway through a sentence:
+
+            `<Text>Gain is <Text font-style={1}>{gain}</Text> dB</Text>`
+
+        Like a RawTextView it's a leaf of the layout, with no shadow view, no size
+        and nothing to paint of its own. Its RawTextView children, and any spans
+        nested within it, become runs of the enclosing TextView's attributed
+        string, carrying the font and colour properties the span sets and
+        inheriting the rest. The whole paragraph is then measured and laid out
+        once, by the TextView, however many styles it mixes; paragraph properties,
+        such as justification, line spacing and word wrap, are the TextView's
+        alone.
+     */
+    class TextSpanView : public View
+    {
+    public:
+        //==============================================================================
+        /** The font and colour of a run of text. */
+        struct Attributes
+        {
+            juce::String fontFamily;
+            float fontSize = 12.0f;
+            int fontStyle = 0;
+            float kerningFactor = 0.0f;
+            juce::Colour colour;
+        };
+
+        static constexpr Kind viewKind = Kind::TextSpan;
+
+        TextSpanView() : View(viewKind) {}
+
+        //==============================================================================
+        /** Returns the given attributes, inherited from the span's parent, with
+            those the span sets replaced by its own.
+
+            Unlike a TextView's, a span's font style applies whether or not it
+            names a family, so that a span can embolden a word of the default
+            typeface.
+         */
+        Attributes getAttributes (Attributes inherited) const
+        {
+            if (props.contains(IDs::fontFamily))
+                inherited.fontFamily = style.fontFamily;
+
+            if (props.contains(IDs::fontSize))
+                inherited.fontSize = style.fontSize;
+
+            if (props.contains(IDs::fontStyle))
+                inherited.fontStyle = style.fontStyle;
+
+            if (props.contains(IDs::kerningFactor))
+                inherited.kerningFactor = style.kerningFactor;
+
+            if (props.contains(IDs::color))
+                inherited.colour = style.textColour;
+
+            return inherited;
+        }
+
+    private:
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TextSpanView)
+    };
+
+}
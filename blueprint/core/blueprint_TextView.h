@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include "blueprint_FontCache.h"
+#include "blueprint_GlyphRunCache.h"
+#include "blueprint_TextSpanView.h"
 #include "blueprint_View.h"
 
 
@@ -18,60 +21,222 @@ namespace blueprint
     //==============================================================================
     /** The TextView class is a core container abstraction for declaring text components
         within Blueprint's layout system.
+
+        Text on a single line which fits the view paints from a shared glyph run,
+        rather than a TextLayout of its own, so that a label cycling through
+        values shapes each value once. With `glyph-atlas`, a run of printable
+        ASCII paints its glyphs as blits from a glyph atlas of the font, which
+        suits numeric readouts redrawn at a high rate.
+
+        Nested <Text> elements are TextSpanView children, whose text joins ours
+        as runs of its own font and colour within a single attributed string;
+        text with spans always paints from a TextLayout.
      */
     class TextView : public View
     {
     public:
         //==============================================================================
-        TextView() = default;
+        static constexpr Kind viewKind = Kind::Text;
+
+        TextView() : View(viewKind) {}
 
         //==============================================================================
-        /** Assembles a Font from the current node properties. */
-        juce::Font getFont()
+        /** Returns the Font described by the current node properties.
+
+            The font comes from the shared FontCache and is looked up again only
+            after one of the font properties changes.
+         */
+        const juce::Font& getFont()
+        {
+            if (font == nullptr)
+            {
+                // As before, the style flags only apply when a family is given.
+                const auto& family = style.fontFamily;
+
+                font = fontCache->getFont(family,
+                                          style.fontSize,
+                                          family.isEmpty() ? 0 : style.fontStyle,
+                                          style.kerningFactor);
+            }
+
+            return *font;
+        }
+
+        /** Set a property on the native view, invalidating the cached text layout. */
+        void setProperty (const juce::Identifier& name, const juce::var& value) override
         {
-            float fontHeight = props.getWithDefault("font-size", 12.0f);
-            int textStyleFlags = props.getWithDefault("font-style", 0);
+            View::setProperty(name, value);
 
-            juce::Font f (fontHeight);
+            if (name == IDs::glyphAtlas)
+                useGlyphAtlas = (bool) value;
 
-            if (props.contains("font-family"))
-                f = juce::Font (props["font-family"], fontHeight, textStyleFlags);
+            if (name == IDs::fontSize
+                || name == IDs::fontStyle
+                || name == IDs::fontFamily
+                || name == IDs::kerningFactor)
+                font = nullptr;
 
-            f.setExtraKerningFactor(props.getWithDefault("kerning-factor", 0.0));
-            return f;
+            invalidateTextLayout();
         }
 
-        /** Constructs a TextLayout from all the children string values. */
-        juce::TextLayout getTextLayout (float maxWidth)
+        /** Clears our font and text caches along with the view's own state. */
+        void resetForReuse() override
+        {
+            View::resetForReuse();
+
+            font = nullptr;
+            useGlyphAtlas = false;
+            cachedLayout = {};
+            invalidateTextLayout();
+        }
+
+        /** Discards the cached text layout so that it's rebuilt on next use.
+
+            Must be called whenever anything that feeds the layout changes: our own
+            properties, the text of one of our RawTextView children, or the
+            properties or children of one of our spans.
+         */
+        void invalidateTextLayout()
+        {
+            layoutCacheValid = false;
+            glyphRunValid = false;
+            glyphRun = nullptr;
+        }
+
+        /** Returns a TextLayout of all the children string values at the given width.
+
+            The layout is cached, so that measuring a node and then painting it at
+            the measured width shapes the text only once. Every other input to the
+            layout invalidates the cache when it changes, which leaves the width as
+            the only key we need to compare.
+         */
+        const juce::TextLayout& getTextLayout (float maxWidth)
+        {
+            if (!layoutCacheValid || cachedLayoutWidth != maxWidth)
+            {
+                cachedLayout = createTextLayout(maxWidth);
+                cachedLayoutWidth = maxWidth;
+                layoutCacheValid = true;
+            }
+
+            return cachedLayout;
+        }
+
+        /** Returns the area the view's text paints over, in local coordinates.
+
+            The layout is sized to its lines, and drawn justified within the view,
+            so this is where it lands, with a little room for glyphs which
+            overhang their line.
+         */
+        juce::Rectangle<int> getTextArea()
+        {
+            const auto bounds = getLocalBounds().toFloat();
+            juce::Rectangle<float> textBox;
+
+            if (auto* run = getGlyphRun(bounds.getWidth()))
+            {
+                textBox.setSize(run->width, run->height);
+            }
+            else
+            {
+                const auto& layout = getTextLayout(bounds.getWidth());
+                textBox.setSize(layout.getWidth(), layout.getHeight());
+            }
+
+            return juce::Justification(style.justification)
+                .appliedToRectangle(textBox, bounds)
+                .getSmallestIntegerContainer()
+                .expanded(2);
+        }
+
+        /** Returns the shared glyph run of our text, if it can paint in place of
+            a TextLayout at the given width: if the text is a single line, which
+            fits or isn't wrapped. Otherwise returns nullptr.
+         */
+        const GlyphRunCache::GlyphRun* getGlyphRun (float maxWidth)
+        {
+            if (!glyphRunValid)
+            {
+                const auto text = getText();
+                glyphRunValid = true;
+
+                if (!text.containsAnyOf("\r\n") && !hasSpans())
+                {
+                    getFont();
+                    glyphRun = glyphRunCache->getGlyphRun(text, font);
+                }
+            }
+
+            if (glyphRun == nullptr)
+                return nullptr;
+
+            const bool unwrapped = style.hasWordWrap && style.wordWrap == 0;
+            return (glyphRun->width <= maxWidth || unwrapped) ? glyphRun.get() : nullptr;
+        }
+
+        /** Returns the text of all our RawTextView children, and of those within
+            our spans.
+         */
+        juce::String getText()
         {
-            juce::String hexColor = props.getWithDefault("color", "ff000000");
-            juce::Colour colour = juce::Colour::fromString(hexColor);
-            int just = props.getWithDefault("justification", 1);
             juce::String text;
+            appendText(text, *this);
+            return text;
+        }
+
+        /** Returns true if any of our children is a TextSpanView. */
+        bool hasSpans()
+        {
+            // Our children are all raw text or spans, so all views.
+            for (auto* c : getChildren())
+                if (static_cast<View*>(c)->getKind() == Kind::TextSpan)
+                    return true;
+
+            return false;
+        }
 
-            // TODO: Right now a <Text> element maps 1:1 to a TextView instance,
-            // and all children must be RawTextView instances, which are basically
-            // just juce::String. A much more flexible alternative would be for a <Text>
-            // element to map to a TextView and any nested raw text nodes or <Text> elements
-            // map to a juce::AttributedString and carry their own properties. This allows
-            // bolding single words inline, for example, and setting line-height, etc.
-            for (auto& c : getChildren())
-                if (RawTextView* v = dynamic_cast<RawTextView*>(c))
-                    text += v->getText();
-
-            juce::AttributedString as (text);
+        /** Constructs a TextLayout from all the children string values. */
+        juce::TextLayout createTextLayout (float maxWidth)
+        {
             juce::TextLayout tl;
+            tl.createLayout(createAttributedString(), maxWidth);
+            return tl;
+        }
 
-            as.setLineSpacing(props.getWithDefault("line-spacing", 1.0f));
-            as.setFont(getFont());
-            as.setColour(colour);
-            as.setJustification(just);
+        /** Returns our text with the font and paragraph style of our properties,
+            from which a TextLayout of it can be built at any width.
 
-            if (props.contains("word-wrap"))
+            The text of each span is a run with the span's font and colour; text
+            without spans is a single run in our own.
+         */
+        juce::AttributedString createAttributedString()
+        {
+            juce::AttributedString as;
+
+            if (hasSpans())
             {
-                int wwValue = props["word-wrap"];
+                TextSpanView::Attributes attributes;
+                attributes.fontFamily = style.fontFamily;
+                attributes.fontSize = style.fontSize;
+                attributes.fontStyle = style.fontFamily.isEmpty() ? 0 : style.fontStyle;
+                attributes.kerningFactor = style.kerningFactor;
+                attributes.colour = style.textColour;
+
+                appendRuns(as, *this, attributes);
+            }
+            else
+            {
+                as.setText(getText());
+                as.setFont(getFont());
+                as.setColour(style.textColour);
+            }
+
+            as.setLineSpacing(style.lineSpacing);
+            as.setJustification(style.justification);
 
-                switch (wwValue)
+            if (style.hasWordWrap)
+            {
+                switch (style.wordWrap)
                 {
                     case 0:
                         as.setWordWrap(juce::AttributedString::WordWrap::none);
@@ -87,20 +252,137 @@ namespace blueprint
                 }
             }
 
-            tl.createLayout(as, maxWidth);
-            return tl;
+            return as;
         }
 
         //==============================================================================
         void paint (juce::Graphics& g) override
         {
+            BLUEPRINT_TRACE_SCOPE("TextView::paint", getViewId());
+            const ScopedPaintTimer paintTimer (*this, "TextView");
+
             auto floatBounds = getLocalBounds().toFloat();
 
             View::paint(g);
+
+            if (auto* run = getGlyphRun(floatBounds.getWidth()))
+                return paintGlyphRun(g, *run, floatBounds);
+
             getTextLayout(floatBounds.getWidth()).draw(g, floatBounds);
         }
 
+        /** Builds its layout and glyph run lazily, as it paints. */
+        bool canPaintConcurrently() const override { return false; }
+
+        /** Invalidates the cached text layout as RawTextView and span children
+            come and go.
+         */
+        void childrenChanged() override
+        {
+            invalidateTextLayout();
+        }
+
     private:
+        //==============================================================================
+        /** Appends the text of the given view's raw text children, and of spans
+            nested within it, in order.
+         */
+        static void appendText (juce::String& text, juce::Component& within)
+        {
+            for (auto* c : within.getChildren())
+            {
+                auto* v = static_cast<View*>(c);
+
+                if (auto* raw = viewCast<RawTextView>(v))
+                    text += raw->getText();
+                else if (viewCast<TextSpanView>(v) != nullptr)
+                    appendText(text, *c);
+            }
+        }
+
+        /** Appends a run for each raw text child of the given view, in the given
+            attributes, and the runs of each span within it in the span's.
+         */
+        void appendRuns (juce::AttributedString& as, juce::Component& within, const TextSpanView::Attributes& attributes)
+        {
+            FontCache::FontHandle runFont;
+
+            for (auto* c : within.getChildren())
+            {
+                auto* v = static_cast<View*>(c);
+
+                if (auto* raw = viewCast<RawTextView>(v))
+                {
+                    if (runFont == nullptr)
+                        runFont = fontCache->getFont(attributes.fontFamily, attributes.fontSize, attributes.fontStyle, attributes.kerningFactor);
+
+                    as.append(raw->getText(), *runFont, attributes.colour);
+                }
+                else if (auto* span = viewCast<TextSpanView>(v))
+                {
+                    appendRuns(as, *span, span->getAttributes(attributes));
+                }
+            }
+        }
+
+        //==============================================================================
+        /** Paints a glyph run justified within the given area, as a TextLayout
+            would place it.
+         */
+        void paintGlyphRun (juce::Graphics& g, const GlyphRunCache::GlyphRun& run, juce::Rectangle<float> area)
+        {
+            const auto origin = juce::Justification(style.justification)
+                .appliedToRectangle(juce::Rectangle<float>(run.width, run.height), area)
+                .getPosition();
+
+            g.setColour(style.textColour);
+
+            if (!useGlyphAtlas || !run.atlasCharactersOnly)
+                return run.glyphs.draw(g, juce::AffineTransform::translation(origin));
+
+            const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+            // After a change of display scale, the font's atlas at the new scale
+            // waits its turn, and the glyphs draw as paths meanwhile.
+            const bool rescaling = glyphRunCache->needsGlyphAtlasAtNewScale(font, scale);
+
+            if (rescaling && !RescaleBudget::mayRerender())
+                return run.glyphs.draw(g, juce::AffineTransform::translation(origin));
+
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+            const auto atlas = glyphRunCache->getGlyphAtlas(font, scale);
+
+            if (rescaling)
+                RescaleBudget::addRerenderTime(juce::Time::getMillisecondCounterHiRes() - start);
+
+            // Each glyph lands on a whole physical pixel, so that its blit needs
+            // no resampling.
+            for (auto& glyph : run.glyphs)
+            {
+                if (glyph.isWhitespace())
+                    continue;
+
+                const auto& cell = atlas->getCell(glyph.getCharacter());
+                const float x = std::round((origin.x + glyph.getLeft()) * scale - cell.origin.x);
+                const float y = std::round((origin.y + glyph.getBaselineY()) * scale - cell.origin.y);
+
+                g.drawImageTransformed(cell.image, juce::AffineTransform::translation(x, y).scaled(1.0f / scale), true);
+            }
+        }
+
+        //==============================================================================
+        juce::SharedResourcePointer<FontCache> fontCache;
+        FontCache::FontHandle font;
+
+        juce::SharedResourcePointer<GlyphRunCache> glyphRunCache;
+        GlyphRunCache::GlyphRunHandle glyphRun;
+        bool glyphRunValid = false;
+        bool useGlyphAtlas = false;
+
+        juce::TextLayout cachedLayout;
+        float cachedLayoutWidth = 0.0f;
+        bool layoutCacheValid = false;
+
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TextView)
     };
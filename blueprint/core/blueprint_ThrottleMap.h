@@ -9,52 +9,139 @@
 
 #pragma once
 
+#include <limits>
+
+#include "blueprint_RealtimeEventQueue.h"
+
 
 namespace blueprint
 {
 
     //==============================================================================
-    /** A small utility that throttles invocations to a given callback based on a given
-        key. Particularly useful for propagating parameter updates into the Duktape
+    /** A small utility that throttles updates to a fixed set of integer keys.
+        Particularly useful for propagating parameter updates into the Duktape
         environment at a controlled rate.
+
+        Any thread, including the audio thread, may set a key's latest value; this
+        never locks, allocates or reads the clock. The consumer, normally the
+        message thread, flushes the map from its scheduler, and for each key sees
+        the first value of a burst at the next flush (the leading edge) and then at
+        most one value per throttle window, the last of which is always the final
+        value of the burst (the trailing edge). `flush` returns when the next
+        trailing value falls due, so the consumer can sleep until then.
+
+        Each key has a fixed slot holding its latest value and a pending flag. A key
+        joins the queue of changed keys only when its flag goes from clear to set,
+        so the queue never holds more than one entry per key and never fills.
      */
     class ThrottleMap
     {
     public:
         //==============================================================================
-        ThrottleMap() = default;
+        /** Creates a map for keys in the range [0, numKeys).
+
+            With a zero window, every flush delivers the latest value of every key
+            changed since the previous one.
+         */
+        ThrottleMap (int _numKeys, double _throttleWindowMs)
+            : numKeys(juce::jmax(0, _numKeys)),
+              throttleWindowMs(juce::jmax(0.0, _throttleWindowMs)),
+              slots(std::make_unique<Slot[]>(static_cast<size_t>(numKeys))),
+              changedKeys(static_cast<size_t>(juce::jmax(1, numKeys)))
+        {
+            waitingKeys.reserve(static_cast<size_t>(numKeys));
+        }
 
         //==============================================================================
+        /** Sets the latest value for the given key. Safe to call from any thread.
+
+            Returns true if the key wasn't already waiting to be flushed.
+         */
+        bool set (int key, double value)
+        {
+            // If you hit this, the key is outside the range the map was made for.
+            jassert (juce::isPositiveAndBelow(key, numKeys));
+
+            if (!juce::isPositiveAndBelow(key, numKeys))
+                return false;
+
+            auto& slot = slots[static_cast<size_t>(key)];
+            slot.value.store(value, std::memory_order_relaxed);
+
+            if (slot.pending.exchange(true, std::memory_order_acq_rel))
+                return false;
+
+            changedKeys.push(key);
+            return true;
+        }
+
+        /** Invokes the callback with (int key, double value) for each changed key
+            whose throttle window has passed, and returns the time at which the
+            next waiting key falls due, or -1 if none is waiting.
+
+            Only one thread may flush.
+         */
         template <typename Fn>
-        void throttle (int key, double throttleWindowMs, Fn callback)
+        double flush (double timeNowMs, Fn&& fn)
         {
-            // We need to be able to invoke the callback..
-            // C++17 only: static_assert(std::is_invocable<Fn>::value);
+            int key = 0;
 
-            double timeNow = juce::Time::getMillisecondCounterHiRes();
+            // Never more than one entry per key, so this never reallocates.
+            while (changedKeys.pop(key))
+                waitingKeys.push_back(key);
 
-            if (tMap.count(key) == 0)
-            {
-                // TODO: Should this automatically invoke on the message thread?
-                tMap[key] = timeNow;
-                callback();
-            }
-            else
+            double nextDeadline = -1.0;
+            size_t numWaiting = 0;
+
+            for (size_t i = 0; i < waitingKeys.size(); ++i)
             {
-                double lastDispatchTime = tMap[key];
-                double diff = timeNow - lastDispatchTime;
+                key = waitingKeys[i];
+                auto& slot = slots[static_cast<size_t>(key)];
+                const double due = slot.lastFlushTime + throttleWindowMs;
 
-                if (diff >= throttleWindowMs)
+                if (timeNowMs >= due)
+                {
+                    // We clear the flag before reading the value. The exchange
+                    // keeps the read from moving ahead of it, and a setter whose
+                    // exchange comes before ours has its value seen by our read,
+                    // while one whose exchange comes after finds the flag clear
+                    // and queues the key again. Either way no value is lost.
+                    slot.pending.exchange(false, std::memory_order_acq_rel);
+                    slot.lastFlushTime = timeNowMs;
+                    fn(key, slot.value.load(std::memory_order_seq_cst));
+                }
+                else
                 {
-                    tMap[key] = timeNow;
-                    callback();
+                    nextDeadline = (nextDeadline < 0.0) ? due : juce::jmin(nextDeadline, due);
+                    waitingKeys[numWaiting++] = key;
                 }
             }
+
+            waitingKeys.resize(numWaiting);
+            return nextDeadline;
         }
 
+        /** Returns the number of keys in the map. */
+        int getNumKeys() const { return numKeys; }
+
     private:
         //==============================================================================
-        std::map<int, double> tMap;
+        struct Slot
+        {
+            std::atomic<double> value { 0.0 };
+            std::atomic<bool> pending { false };
+
+            // Only the flushing thread touches this.
+            double lastFlushTime = std::numeric_limits<double>::lowest();
+        };
+
+        const int numKeys;
+        const double throttleWindowMs;
+        std::unique_ptr<Slot[]> slots;
+        RealtimeEventQueue<int> changedKeys;
+
+        // Changed keys still inside their throttle window, in the order they changed.
+        std::vector<int> waitingKeys;
 
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThrottleMap)
@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    blueprint_TiledRasterizer.h
+    Created: 15 Oct 2026 9:14:08pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Paints a large component's dirty area in tiles, across a shared pool of
+        threads, for editors big enough that a software repaint of one frame is
+        more than one core can do in time.
+
+        Installed as the component's CachedComponentImage, it splits the area
+        being painted into tiles of about tileSize physical pixels, and the pool,
+        with the message thread, paints the whole tree into each tile's own
+        image before the tiles are composited into the real context. The message
+        thread does nothing else meanwhile, so the tree holds still.
+
+        Only Views which say they can paint concurrently are painted this way.
+        The areas of any which can't, and of any components which aren't Views,
+        are left out of the tiles and painted on the message thread afterwards,
+        clipped to just those areas, as are dirty areas too small to be worth
+        splitting. Each pixel is painted by exactly one pass, so nothing is
+        blended twice.
+
+        Components painted directly by their peer, rather than within a parent,
+        never consult their CachedComponentImage, so the component should be a
+        child, such as an editor's content.
+     */
+    class TiledRasterizer : public juce::CachedComponentImage
+    {
+    public:
+        //==============================================================================
+        /** Paints the given component in tiles. `paintOverTiles` is called on the
+            message thread, once the tiles and the areas left out of them are
+            painted, for what the component paints over its children and mustn't
+            paint once per tile; the component skips that while isPaintingTile()
+            is true. A dirty area painted whole paints over its children as
+            usual.
+         */
+        TiledRasterizer (juce::Component& _component, std::function<void (juce::Graphics&)> _paintOverTiles)
+            : component(_component), paintOverTiles(std::move(_paintOverTiles))
+        {
+        }
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override
+        {
+            const auto clip = g.getClipBounds().getIntersection(component.getLocalBounds());
+
+            if (clip.isEmpty())
+                return;
+
+            const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+            const auto physicalClip = (clip.toFloat() * scale).getSmallestIntegerContainer();
+
+            if (physicalClip.getWidth() * (juce::int64) physicalClip.getHeight() < minTiledPixels || scale <= 0.0f)
+                return component.paintEntireComponent(g, false);
+
+            // What can't be painted in a tile is painted afterwards on its own.
+            juce::RectangleList<int> serialArea;
+            addSerialAreas(serialArea, component, clip);
+
+            auto job = std::make_shared<Job>(component, scale, serialArea);
+
+            for (int y = physicalClip.getY(); y < physicalClip.getBottom(); y += tileSize)
+                for (int x = physicalClip.getX(); x < physicalClip.getRight(); x += tileSize)
+                    job->tiles.push_back({ juce::Rectangle<int>(x, y, tileSize, tileSize).getIntersection(physicalClip), {} });
+
+            if (job->tiles.size() < 2)
+                return component.paintEntireComponent(g, false);
+
+            const int numWorkers = juce::jmin(pool->getNumThreads(), (int) job->tiles.size() - 1);
+
+            for (int i = 0; i < numWorkers; ++i)
+                pool->addJob([job]() { job->paintTiles(); });
+
+            job->paintTiles();
+            job->finished.wait(-1);
+
+            for (const auto& tile : job->tiles)
+            {
+                g.drawImageTransformed(tile.image, juce::AffineTransform::translation((float) tile.area.getX(), (float) tile.area.getY())
+                                                       .scaled(1.0f / scale));
+            }
+
+            {
+                const juce::ScopedValueSetter<bool> setter (paintingTile, true);
+
+                for (const auto& area : serialArea)
+                {
+                    juce::Graphics::ScopedSaveState state (g);
+
+                    if (g.reduceClipRegion(area))
+                        component.paintEntireComponent(g, false);
+                }
+            }
+
+            if (paintOverTiles)
+                paintOverTiles(g);
+        }
+
+        bool invalidateAll() override { return true; }
+        bool invalidate (const juce::Rectangle<int>&) override { return true; }
+        void releaseResources() override {}
+
+        //==============================================================================
+        /** Returns true while this thread paints a tile, or one of the areas
+            left out of the tiles.
+         */
+        static bool isPaintingTile() { return paintingTile; }
+
+    private:
+        //==============================================================================
+        struct Tile
+        {
+            juce::Rectangle<int> area;
+            juce::Image image;
+        };
+
+        /** The tiles of one paint, shared with the pool's jobs, which may not
+            start until the paint is done with them.
+         */
+        struct Job
+        {
+            Job (juce::Component& c, float s, const juce::RectangleList<int>& excluded)
+                : component(c), scale(s), serialArea(excluded)
+            {
+            }
+
+            /** Paints tiles until there are none left to take. */
+            void paintTiles()
+            {
+                const juce::ScopedValueSetter<bool> setter (paintingTile, true);
+
+                for (size_t i = nextTile++; i < tiles.size(); i = nextTile++)
+                {
+                    auto& tile = tiles[i];
+                    tile.image = juce::Image(juce::Image::ARGB, tile.area.getWidth(), tile.area.getHeight(), true);
+
+                    {
+                        juce::Graphics tg (tile.image);
+                        tg.addTransform(juce::AffineTransform::scale(scale)
+                                            .translated((float) -tile.area.getX(), (float) -tile.area.getY()));
+
+                        for (const auto& area : serialArea)
+                            tg.excludeClipRegion(area);
+
+                        if (!tg.isClipEmpty())
+                            component.paintEntireComponent(tg, false);
+                    }
+
+                    if (++numPainted == tiles.size())
+                        finished.signal();
+                }
+            }
+
+            juce::Component& component;
+            const float scale;
+            const juce::RectangleList<int> serialArea;
+
+            std::vector<Tile> tiles;
+            std::atomic<size_t> nextTile { 0 };
+            std::atomic<size_t> numPainted { 0 };
+            juce::WaitableEvent finished;
+        };
+
+        /** The threads painting tiles, shared by every rasterizer. We leave a
+            core for the message thread, which takes tiles too.
+         */
+        struct Pool : public juce::ThreadPool
+        {
+            Pool() : juce::ThreadPool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1)) {}
+        };
+
+        //==============================================================================
+        /** Adds the areas, in the root's coordinates, of the visible components
+            within the given one which mustn't be painted in a tile.
+         */
+        void addSerialAreas (juce::RectangleList<int>& areas, juce::Component& within, juce::Rectangle<int> clip) const
+        {
+            for (auto* c : within.getChildren())
+            {
+                if (!c->isVisible())
+                    continue;
+
+                const auto bounds = component.getLocalArea(c, c->getLocalBounds()).getIntersection(clip);
+
+                if (bounds.isEmpty())
+                    continue;
+
+                auto* view = dynamic_cast<View*>(c);
+
+                if (view == nullptr || !view->canPaintConcurrently())
+                    areas.add(bounds);
+                else
+                    addSerialAreas(areas, *c, clip);
+            }
+        }
+
+        //==============================================================================
+        // Big enough to keep a thread busy for a while, small enough to share
+        // out a dirty area between several.
+        static constexpr int tileSize = 256;
+
+        // Below about twice a tile, splitting costs more than it saves.
+        static constexpr juce::int64 minTiledPixels = 2 * tileSize * tileSize;
+
+        static inline thread_local bool paintingTile = false;
+
+        juce::Component& component;
+        std::function<void (juce::Graphics&)> paintOverTiles;
+        juce::SharedResourcePointer<Pool> pool;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TiledRasterizer)
+    };
+
+}
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    blueprint_TimerQueue.h
+    Created: 14 Oct 2026 7:26:44pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The TimerQueue keeps the JavaScript timers of a ReactApplicationRoot in a
+        min-heap keyed on deadline.
+
+        Adding, cancelling and popping a timer are O(log n), and the earliest
+        deadline is always at hand, which tells the root exactly when it next needs
+        to wake. The queue only deals in ids and times; the callbacks themselves
+        belong to the JavaScript heap.
+
+        Cancelled timers are dropped lazily as they reach the top of the heap.
+     */
+    class TimerQueue
+    {
+    public:
+        //==============================================================================
+        using TimerId = int;
+
+        TimerQueue() = default;
+
+        //==============================================================================
+        /** Adds a timer due after the given delay, returning its id. An interval
+            timer is rescheduled by its delay each time it's popped, until cancelled.
+         */
+        TimerId add (double now, double delayMs, bool repeating)
+        {
+            const TimerId id = nextId++;
+            const double delay = std::max(0.0, delayMs);
+
+            timers[id] = { delay, repeating };
+            push(now + delay, id);
+
+            return id;
+        }
+
+        /** Cancels the timer with the given id, if it's still pending. */
+        void cancel (TimerId id)
+        {
+            timers.erase(id);
+        }
+
+        /** Marks the current end of the queue. Timers added after the mark, even
+            ones already due, aren't popped until the next mark, so that a timer
+            which keeps scheduling zero-delay timers can't starve the message loop.
+         */
+        void mark()
+        {
+            markedSequence = nextSequence;
+        }
+
+        /** Pops the next timer that's due by the given time and was added before
+            the last mark. Returns true, with the timer's id and whether it repeats,
+            if there was one.
+         */
+        bool popDue (double now, TimerId& id, bool& repeating)
+        {
+            while (!heap.empty())
+            {
+                const Entry top = heap.front();
+
+                auto it = timers.find(top.id);
+
+                if (it == timers.end())
+                {
+                    pop();
+                    continue;
+                }
+
+                if (top.deadline > now || top.sequence >= markedSequence)
+                    return false;
+
+                pop();
+
+                id = top.id;
+                repeating = it->second.repeating;
+
+                if (repeating)
+                {
+                    // Keep to the original cadence where we can, without trying
+                    // to catch up on ticks we've slept through.
+                    push(std::max(now, top.deadline + it->second.interval), top.id);
+                }
+                else
+                {
+                    timers.erase(it);
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+
+        /** Returns the deadline of the earliest pending timer, or a negative value
+            if there are none.
+         */
+        double getNextDeadline()
+        {
+            while (!heap.empty() && timers.find(heap.front().id) == timers.end())
+                pop();
+
+            return heap.empty() ? -1.0 : heap.front().deadline;
+        }
+
+        /** Returns true if the given timer is still pending. */
+        bool contains (TimerId id) const
+        {
+            return timers.find(id) != timers.end();
+        }
+
+        /** Drops every timer. */
+        void clear()
+        {
+            heap.clear();
+            timers.clear();
+        }
+
+    private:
+        //==============================================================================
+        struct Entry
+        {
+            double deadline;
+            juce::uint64 sequence;
+            TimerId id;
+
+            // Ties go to the timer which was scheduled first.
+            bool operator> (const Entry& other) const
+            {
+                return deadline > other.deadline
+                    || (deadline == other.deadline && sequence > other.sequence);
+            }
+        };
+
+        struct Timer
+        {
+            double interval;
+            bool repeating;
+        };
+
+        void push (double deadline, TimerId id)
+        {
+            heap.push_back({ deadline, nextSequence++, id });
+            std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        }
+
+        void pop()
+        {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+            heap.pop_back();
+        }
+
+        //==============================================================================
+        std::vector<Entry> heap;
+        std::unordered_map<TimerId, Timer> timers;
+
+        // Id zero is never handed out, so that callers may treat it as "no timer."
+        TimerId nextId = 1;
+        juce::uint64 nextSequence = 0;
+        juce::uint64 markedSequence = 0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimerQueue)
+    };
+
+}
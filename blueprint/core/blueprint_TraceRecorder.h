@@ -0,0 +1,329 @@
+/*
+  ==============================================================================
+
+    blueprint_TraceRecorder.h
+    Created: 15 Oct 2026 2:58:07pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#if BLUEPRINT_TRACING
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Records a timeline of what Blueprint does on each thread, for viewing in
+        chrome://tracing or Perfetto: the bridge calls JavaScript makes, event
+        dispatches, layout passes, layout flushes and view paints.
+
+        Events are recorded with BLUEPRINT_TRACE_SCOPE, which marks the start
+        and end of the enclosing scope, and BLUEPRINT_TRACE_INSTANT, which
+        marks a moment, between `start` and `stop`. JavaScript's
+        `performance.mark` and `performance.measure` record instants and spans
+        of their own, with `recordInstant` and `recordSpan`, so that React's
+        profiling and a bundle's own timings land on the same timeline. Each thread
+        writes into a fixed-size buffer of its own, without locks or
+        allocation, so recording costs a clock read and a few stores. Once a
+        thread's buffer is full, its further events are dropped until the next
+        `start`.
+
+        The recorder and the macro only exist where BLUEPRINT_TRACING is
+        enabled, which it isn't by default; otherwise the macros compile to
+        nothing.
+     */
+    class TraceRecorder
+    {
+    public:
+        //==============================================================================
+        /** Returns the process's recorder. */
+        static TraceRecorder& getInstance()
+        {
+            static TraceRecorder instance;
+            return instance;
+        }
+
+        //==============================================================================
+        /** Marks the start and end of a scope, with an optional view and detail
+            such as an event type. The name and detail must outlive the recorder,
+            as string literals and Identifiers do.
+         */
+        class ScopedEvent
+        {
+        public:
+            explicit ScopedEvent (const char* _name, int _viewId = -1, const char* _detail = nullptr)
+                : name(_name), viewId(_viewId), detail(_detail)
+            {
+                getInstance().record(name, 'B', viewId, detail);
+            }
+
+            ScopedEvent (const char* _name, int _viewId, const juce::Identifier& _detail)
+                : ScopedEvent(_name, _viewId, _detail.getCharPointer().getAddress()) {}
+
+            ~ScopedEvent()
+            {
+                getInstance().record(name, 'E', viewId, detail);
+            }
+
+        private:
+            const char* name;
+            int viewId;
+            const char* detail;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedEvent)
+        };
+
+        //==============================================================================
+        /** Records an instant, such as a `performance.mark`, in the given category. */
+        void recordInstant (const char* name, const char* category)
+        {
+            record(name, 'i', -1, nullptr, category);
+        }
+
+        /** Records an instant against a view, with a detail, such as the
+            property whose change invalidated the view's layout. As with
+            ScopedEvent, the name and detail must outlive the recorder.
+         */
+        void recordInstant (const char* name, int viewId, const char* detail)
+        {
+            record(name, 'i', viewId, detail);
+        }
+
+        /** Records a span between the given high resolution ticks, such as a
+            `performance.measure`, in the given category.
+         */
+        void recordSpan (const char* name, const char* category, juce::int64 startTicks, juce::int64 endTicks)
+        {
+            record(name, 'X', -1, nullptr, category, startTicks, juce::jmax((juce::int64) 0, endTicks - startTicks));
+        }
+
+        /** Returns a copy of the given name which lives as long as the recorder,
+            for names made at run time, such as JavaScript's marks. Past
+            `maxInternedNames` distinct names, every further one comes back as
+            the fallback.
+         */
+        const char* intern (const juce::String& name, const char* fallback)
+        {
+            const juce::ScopedLock sl (internedNamesLock);
+
+            auto it = internedNames.find(name);
+
+            if (it == internedNames.end())
+            {
+                if (internedNames.size() >= maxInternedNames)
+                    return fallback;
+
+                it = internedNames.insert(name).first;
+            }
+
+            return it->toRawUTF8();
+        }
+
+        //==============================================================================
+        /** Discards whatever was recorded, and starts recording. */
+        void start()
+        {
+            ++session;
+            recording = true;
+        }
+
+        /** Stops recording, keeping what was recorded for writing out. */
+        void stop()
+        {
+            recording = false;
+        }
+
+        /** Returns true between `start` and `stop`. */
+        bool isRecording() const { return recording; }
+
+        //==============================================================================
+        /** Writes what was recorded in the trace event format read by
+            chrome://tracing and Perfetto. Call once recording has stopped, or
+            the events still in progress on other threads may be left out.
+         */
+        void writeChromeTrace (juce::OutputStream& out) const
+        {
+            const juce::ScopedLock sl (buffersLock);
+            const auto currentSession = session.load();
+            bool first = true;
+
+            auto writeSeparator = [&]() {
+                out << (first ? "\n" : ",\n");
+                first = false;
+            };
+
+            out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+            for (const auto& buffer : buffers)
+            {
+                if (buffer->session.load(std::memory_order_acquire) != currentSession)
+                    continue;
+
+                writeSeparator();
+                out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadIndex
+                    << ",\"args\":{\"name\":" << juce::JSON::toString(buffer->threadName) << "}}";
+
+                const auto numEvents = buffer->numEvents.load(std::memory_order_acquire);
+
+                for (size_t i = 0; i < numEvents; ++i)
+                {
+                    const auto& event = buffer->events[i];
+                    const auto micros = juce::Time::highResolutionTicksToSeconds(event.ticks) * 1000000.0;
+
+                    writeSeparator();
+                    out << "{\"name\":" << juce::JSON::toString(juce::String(juce::CharPointer_UTF8(event.name)))
+                        << ",\"cat\":\"" << event.category << "\",\"ph\":\"" << juce::String::charToString(event.phase)
+                        << "\",\"ts\":" << juce::String(micros, 3) << ",\"pid\":1,\"tid\":" << buffer->threadIndex;
+
+                    if (event.phase == 'X')
+                        out << ",\"dur\":" << juce::String(juce::Time::highResolutionTicksToSeconds(event.durationTicks) * 1000000.0, 3);
+                    else if (event.phase == 'i')
+                        out << ",\"s\":\"t\"";
+
+                    if ((event.phase == 'B' || event.phase == 'i') && (event.viewId >= 0 || event.detail != nullptr))
+                    {
+                        out << ",\"args\":{";
+
+                        if (event.viewId >= 0)
+                            out << "\"viewId\":" << event.viewId << (event.detail != nullptr ? "," : "");
+
+                        if (event.detail != nullptr)
+                            out << "\"detail\":" << juce::JSON::toString(juce::String(juce::CharPointer_UTF8(event.detail)));
+
+                        out << "}";
+                    }
+
+                    out << "}";
+                }
+            }
+
+            out << "\n]}\n";
+        }
+
+        /** Returns what was recorded in the trace event format, as a string. */
+        juce::String toChromeTrace() const
+        {
+            juce::MemoryOutputStream out;
+            writeChromeTrace(out);
+            return out.toString();
+        }
+
+        //==============================================================================
+        // About 2MB for each thread which records.
+        static constexpr size_t numEventsPerThread = 64 * 1024;
+
+        // Enough for every distinct mark of a bundle's own, and React's.
+        static constexpr size_t maxInternedNames = 4096;
+
+    private:
+        //==============================================================================
+        struct Event
+        {
+            juce::int64 ticks;
+            juce::int64 durationTicks;
+            const char* name;
+            const char* detail;
+            const char* category;
+            int viewId;
+            char phase;
+        };
+
+        /** A thread's events, written only by that thread. */
+        struct ThreadBuffer
+        {
+            std::unique_ptr<Event[]> events { new Event[numEventsPerThread] };
+            std::atomic<size_t> numEvents { 0 };
+            std::atomic<juce::uint32> session { 0 };
+
+            int threadIndex = 0;
+            juce::String threadName;
+        };
+
+        //==============================================================================
+        TraceRecorder() = default;
+
+        void record (const char* name, char phase, int viewId, const char* detail,
+                     const char* category = "blueprint", juce::int64 ticks = 0, juce::int64 durationTicks = 0)
+        {
+            if (!recording.load(std::memory_order_relaxed))
+                return;
+
+            auto& buffer = getThreadBuffer();
+            const auto currentSession = session.load(std::memory_order_relaxed);
+
+            // The first event of a new session on this thread drops those of the
+            // last.
+            if (buffer.session.load(std::memory_order_relaxed) != currentSession)
+            {
+                buffer.numEvents.store(0, std::memory_order_relaxed);
+                buffer.session.store(currentSession, std::memory_order_release);
+            }
+
+            const auto index = buffer.numEvents.load(std::memory_order_relaxed);
+
+            if (index == numEventsPerThread)
+                return;
+
+            buffer.events[index] = { ticks != 0 ? ticks : juce::Time::getHighResolutionTicks(), durationTicks,
+                                     name, detail, category, viewId, phase };
+            buffer.numEvents.store(index + 1, std::memory_order_release);
+        }
+
+        /** Returns the calling thread's buffer, creating it on its first event.
+            Buffers are kept for the life of the process, as a thread's events
+            outlive the thread.
+         */
+        ThreadBuffer& getThreadBuffer()
+        {
+            thread_local ThreadBuffer* threadBuffer = nullptr;
+
+            if (threadBuffer == nullptr)
+            {
+                auto buffer = std::make_unique<ThreadBuffer>();
+
+                if (auto* thread = juce::Thread::getCurrentThread())
+                    buffer->threadName = thread->getThreadName();
+                else if (juce::MessageManager::existsAndIsCurrentThread())
+                    buffer->threadName = "Message thread";
+                else
+                    buffer->threadName = "Thread";
+
+                const juce::ScopedLock sl (buffersLock);
+                buffer->threadIndex = static_cast<int>(buffers.size()) + 1;
+                threadBuffer = buffer.get();
+                buffers.push_back(std::move(buffer));
+            }
+
+            return *threadBuffer;
+        }
+
+        //==============================================================================
+        std::atomic<bool> recording { false };
+        std::atomic<juce::uint32> session { 0 };
+
+        juce::CriticalSection buffersLock;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        juce::CriticalSection internedNamesLock;
+        std::set<juce::String> internedNames;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE (TraceRecorder)
+    };
+
+}
+
+ #define BLUEPRINT_TRACE_SCOPE(...) const blueprint::TraceRecorder::ScopedEvent JUCE_JOIN_MACRO (blueprintTraceEvent, __LINE__) (__VA_ARGS__)
+ #define BLUEPRINT_TRACE_INSTANT(name, viewId, detail) blueprint::TraceRecorder::getInstance().recordInstant (name, viewId, detail)
+#else
+ #define BLUEPRINT_TRACE_SCOPE(...)
+ #define BLUEPRINT_TRACE_INSTANT(name, viewId, detail)
+#endif
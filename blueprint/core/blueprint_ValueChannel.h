@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    blueprint_ValueChannel.h
+    Created: 14 Oct 2026 11:40:18pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** A fixed array of floats written by realtime code and read by JavaScript as
+        a Float32Array, such as the peak levels of a many-channel meter.
+
+        A single writer, typically the audio thread, updates the live values
+        under a sequence lock: it never waits, locks or allocates. Once per frame
+        the message thread copies a consistent snapshot of the live values into
+        a second array, and that array is the memory behind the Float32Array which
+        JavaScript sees. Reading a value in JavaScript is then just an array read,
+        with nothing marshalled across the bridge per update.
+
+        The snapshot is taken before each frame's animation frame callbacks, so
+        values read from within `requestAnimationFrame` are always fresh.
+     */
+    class ValueChannel
+    {
+    public:
+        //==============================================================================
+        explicit ValueChannel (int _numValues)
+            : numValues(juce::jmax(1, _numValues)),
+              liveValues(std::make_unique<std::atomic<float>[]>(static_cast<size_t>(numValues))),
+              snapshot(std::make_unique<float[]>(static_cast<size_t>(numValues)))
+        {
+            for (int i = 0; i < numValues; ++i)
+            {
+                liveValues[static_cast<size_t>(i)].store(0.0f, std::memory_order_relaxed);
+                snapshot[static_cast<size_t>(i)] = 0.0f;
+            }
+        }
+
+        //==============================================================================
+        /** Sets a single value. Only one thread may write to a channel. */
+        void setValue (int index, float value)
+        {
+            setValues(&value, 1, index);
+        }
+
+        /** Sets a run of values starting at the given index, all of which JavaScript
+            then sees change together. Only one thread may write to a channel.
+         */
+        void setValues (const float* values, int num, int startIndex = 0)
+        {
+            // If you hit this, you're writing outside the channel.
+            jassert (startIndex >= 0 && startIndex + num <= numValues);
+
+            const int end = juce::jmin(numValues, startIndex + num);
+
+            // An odd sequence number marks a write in progress.
+            const auto s = sequence.load(std::memory_order_relaxed);
+            sequence.store(s + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (int i = juce::jmax(0, startIndex); i < end; ++i)
+                liveValues[static_cast<size_t>(i)].store(values[i - startIndex], std::memory_order_relaxed);
+
+            sequence.store(s + 2, std::memory_order_release);
+        }
+
+        //==============================================================================
+        /** Copies the live values into the snapshot, returning true if anything had
+            been written since the last snapshot. Only one thread may take snapshots.
+
+            If the writer keeps interrupting the copy, we give up after a few tries
+            and keep the previous snapshot until the next frame, rather than make
+            the writer wait.
+         */
+        bool updateSnapshot()
+        {
+            for (int attempt = 0; attempt < maxSnapshotAttempts; ++attempt)
+            {
+                const auto before = sequence.load(std::memory_order_acquire);
+
+                if (before == snapshotSequence)
+                    return false;
+
+                if ((before & 1) != 0)
+                    continue;
+
+                for (int i = 0; i < numValues; ++i)
+                    snapshot[static_cast<size_t>(i)] = liveValues[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (sequence.load(std::memory_order_relaxed) == before)
+                {
+                    snapshotSequence = before;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /** Returns a value as last written, from any thread, without waiting on the
+            snapshot. Unlike the snapshot, values read this way one at a time may
+            come from different writes.
+
+            Native views drawing from a channel read it this way, rather than
+            from the snapshot, which belongs to whichever thread runs the script.
+         */
+        float getLiveValue (int index) const
+        {
+            jassert (juce::isPositiveAndBelow(index, numValues));
+            return liveValues[static_cast<size_t>(index)].load(std::memory_order_relaxed);
+        }
+
+        /** Returns the snapshot memory which backs the channel's Float32Array. */
+        float* getSnapshotData() { return snapshot.get(); }
+
+        /** Returns the number of values in the channel. */
+        int getNumValues() const { return numValues; }
+
+    private:
+        //==============================================================================
+        static constexpr int maxSnapshotAttempts = 4;
+
+        const int numValues;
+        std::unique_ptr<std::atomic<float>[]> liveValues;
+        std::unique_ptr<float[]> snapshot;
+
+        std::atomic<juce::uint32> sequence { 0 };
+        juce::uint32 snapshotSequence = 0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueChannel)
+    };
+
+}
@@ -0,0 +1,265 @@
+/*
+  ==============================================================================
+
+    blueprint_ValueTreeStore.h
+    Created: 15 Oct 2026 11:26:08pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <map>
+
+#include "blueprint_FrameScheduler.h"
+#include "blueprint_ReactApplicationRoot.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Mirrors a juce::ValueTree into the ValueTreeStore of juce-blueprint, by
+        name, for state the interface shows which lives in a tree on the native
+        side.
+
+        The store listens to the whole tree, and gathers its changes as they
+        come into a list of patches, which goes to JavaScript in a single
+        "valueTreeChange" event at the next frame, with the store's name. The
+        JavaScript store applies them in order to its copy of the tree, in
+        place. A node is addressed by its `path`, the index of each node on the
+        way down from the root, as it was when the change was made:
+
+            { op: "set", path, property, value }
+            { op: "remove-property", path, property }
+            { op: "insert", path, index, node }
+            { op: "remove", path, index }
+            { op: "move", path, from, to }
+            { op: "reset", node }
+
+        where a node is `{ type, properties, children }`. A property set more
+        than once between structural changes only goes out with its latest
+        value. The store sends the whole tree when it's made, and again with
+        `resync`, after the bundle reloads say.
+
+        The tree is only ever used on the message thread, and so is the store,
+        which must not outlive the root.
+     */
+    class ValueTreeStore : private juce::ValueTree::Listener
+    {
+    public:
+        //==============================================================================
+        ValueTreeStore (const juce::String& _name, juce::ValueTree _tree, ReactApplicationRoot& _root)
+            : name(_name), tree(std::move(_tree)), root(_root)
+        {
+            jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+            tree.addListener(this);
+            resync();
+        }
+
+        ~ValueTreeStore() override
+        {
+            tree.removeListener(this);
+        }
+
+        //==============================================================================
+        /** Returns the name JavaScript knows the tree by. */
+        const juce::String& getName() const { return name; }
+
+        /** Returns the tree. */
+        juce::ValueTree& getTree() { return tree; }
+
+        /** Sends the whole tree again at the next frame, in place of any changes
+            waiting to go.
+         */
+        void resync()
+        {
+            auto* patch = new juce::DynamicObject();
+            patch->setProperty("op", "reset");
+            patch->setProperty("node", toVar(tree));
+
+            pending.clear();
+            pendingProperties.clear();
+            pending.add(juce::var(patch));
+            scheduler.scheduleFrame();
+        }
+
+    private:
+        //==============================================================================
+        void valueTreePropertyChanged (juce::ValueTree& node, const juce::Identifier& property) override
+        {
+            juce::Array<juce::var> path;
+
+            if (!getPath(node, path))
+                return;
+
+            const bool hasProperty = node.hasProperty(property);
+
+            auto* patch = new juce::DynamicObject();
+            patch->setProperty("op", hasProperty ? "set" : "remove-property");
+            patch->setProperty("path", path);
+            patch->setProperty("property", property.toString());
+
+            if (hasProperty)
+                patch->setProperty("value", node.getProperty(property));
+
+            // A later change to the same property replaces the earlier, unless
+            // the tree's shape has changed in between.
+            juce::String key;
+
+            for (const auto& index : path)
+                key << (int) index << '/';
+
+            key << property.toString();
+
+            const auto it = pendingProperties.find(key);
+
+            if (it != pendingProperties.end())
+            {
+                pending.set(it->second, juce::var(patch));
+            }
+            else
+            {
+                pendingProperties[key] = pending.size();
+                pending.add(juce::var(patch));
+            }
+
+            scheduler.scheduleFrame();
+        }
+
+        void valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child) override
+        {
+            juce::Array<juce::var> path;
+
+            if (!getPath(parent, path))
+                return;
+
+            auto* patch = new juce::DynamicObject();
+            patch->setProperty("op", "insert");
+            patch->setProperty("path", path);
+            patch->setProperty("index", parent.indexOf(child));
+            patch->setProperty("node", toVar(child));
+
+            addStructuralPatch(patch);
+        }
+
+        void valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree&, int index) override
+        {
+            juce::Array<juce::var> path;
+
+            if (!getPath(parent, path))
+                return;
+
+            auto* patch = new juce::DynamicObject();
+            patch->setProperty("op", "remove");
+            patch->setProperty("path", path);
+            patch->setProperty("index", index);
+
+            addStructuralPatch(patch);
+        }
+
+        void valueTreeChildOrderChanged (juce::ValueTree& parent, int oldIndex, int newIndex) override
+        {
+            juce::Array<juce::var> path;
+
+            if (!getPath(parent, path))
+                return;
+
+            auto* patch = new juce::DynamicObject();
+            patch->setProperty("op", "move");
+            patch->setProperty("path", path);
+            patch->setProperty("from", oldIndex);
+            patch->setProperty("to", newIndex);
+
+            addStructuralPatch(patch);
+        }
+
+        void valueTreeParentChanged (juce::ValueTree&) override {}
+
+        void valueTreeRedirected (juce::ValueTree&) override
+        {
+            resync();
+        }
+
+        //==============================================================================
+        void addStructuralPatch (juce::DynamicObject* patch)
+        {
+            // Paths recorded before this may no longer lead to the same nodes.
+            pendingProperties.clear();
+            pending.add(juce::var(patch));
+            scheduler.scheduleFrame();
+        }
+
+        /** Sends the patches gathered since the last frame. */
+        void flush()
+        {
+            if (pending.isEmpty())
+                return;
+
+            juce::Array<juce::var> patches;
+            patches.swapWith(pending);
+            pendingProperties.clear();
+
+            root.dispatchEvent(IDs::valueTreeChange, name, juce::var(patches));
+        }
+
+        /** Fills in the path from the root of the tree down to the given node,
+            returning false if the node isn't within the tree.
+         */
+        bool getPath (const juce::ValueTree& node, juce::Array<juce::var>& path) const
+        {
+            for (auto n = node; n != tree; n = n.getParent())
+            {
+                const auto parent = n.getParent();
+
+                if (!parent.isValid())
+                    return false;
+
+                path.insert(0, parent.indexOf(n));
+            }
+
+            return true;
+        }
+
+        static juce::var toVar (const juce::ValueTree& node)
+        {
+            auto* properties = new juce::DynamicObject();
+
+            for (int i = 0; i < node.getNumProperties(); ++i)
+            {
+                const auto property = node.getPropertyName(i);
+                properties->setProperty(property, node.getProperty(property));
+            }
+
+            juce::Array<juce::var> children;
+
+            for (const auto& child : node)
+                children.add(toVar(child));
+
+            auto* result = new juce::DynamicObject();
+            result->setProperty("type", node.getType().toString());
+            result->setProperty("properties", juce::var(properties));
+            result->setProperty("children", children);
+
+            return juce::var(result);
+        }
+
+        //==============================================================================
+        const juce::String name;
+        juce::ValueTree tree;
+        ReactApplicationRoot& root;
+
+        juce::Array<juce::var> pending;
+
+        // The index in `pending` of the latest change of each property, by path
+        // and name, since the last structural change.
+        std::map<juce::String, int> pendingProperties;
+
+        FrameScheduler scheduler { root, [this]() { flush(); } };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeStore)
+    };
+
+}
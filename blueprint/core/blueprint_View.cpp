@@ -11,10 +11,203 @@
 namespace blueprint
 {
 
+    namespace
+    {
+        /** An event handler prop: the event it handles, and whether it handles
+            the event in the capture phase, as with `onMouseDownCapture`.
+         */
+        struct EventHandlerProp
+        {
+            View::EventFlags event;
+            bool capture;
+        };
+
+        /** Maps each event handler prop to its event flag. */
+        const std::unordered_map<juce::Identifier, EventHandlerProp, IdentifierHash>& getEventHandlerTable()
+        {
+            static const auto table = []()
+            {
+                const std::pair<juce::Identifier, View::EventFlags> handlers[] = {
+                    { IDs::onMeasure,           View::MeasureEvent },
+                    { IDs::onMouseDown,         View::MouseDownEvent },
+                    { IDs::onMouseUp,           View::MouseUpEvent },
+                    { IDs::onMouseDrag,         View::MouseDragEvent },
+                    { IDs::onMouseDoubleClick,  View::MouseDoubleClickEvent },
+                    { IDs::onMouseMove,         View::MouseMoveEvent },
+                    { IDs::onMouseEnter,        View::MouseEnterEvent },
+                    { IDs::onMouseExit,         View::MouseExitEvent },
+                    { IDs::onMouseWheel,        View::MouseWheelEvent },
+                    { IDs::onLoad,              View::LoadEvent },
+                    { IDs::onVisibleRangeChange, View::VisibleRangeChangeEvent },
+                    { IDs::onScroll,            View::ScrollEvent },
+                    { IDs::onValueChange,       View::ValueChangeEvent },
+                    { IDs::onChange,            View::ChangeEvent },
+                    { IDs::onSubmit,            View::SubmitEvent },
+                    { IDs::onKeyDown,           View::KeyDownEvent },
+                    { IDs::onFocus,             View::FocusEvent },
+                    { IDs::onBlur,              View::BlurEvent },
+                    { IDs::onNoteChange,        View::NoteChangeEvent },
+                };
+
+                std::unordered_map<juce::Identifier, EventHandlerProp, IdentifierHash> t;
+
+                for (const auto& [name, event] : handlers)
+                {
+                    t[name] = { event, false };
+                    t[juce::Identifier(name.toString() + "Capture")] = { event, true };
+                }
+
+                return t;
+            }();
+
+            return table;
+        }
+
+        /** Compares two property values by content. JavaScript hands us a new
+            but equal object or array on every render of an inline value, which
+            juce::var would compare by identity. Past `budget` values compared,
+            we give up and call them different.
+         */
+        bool isEquivalentValue (const juce::var& a, const juce::var& b, int& budget)
+        {
+            if (--budget < 0)
+                return false;
+
+            if (const auto* arrayA = a.getArray())
+            {
+                const auto* arrayB = b.getArray();
+
+                if (arrayA == arrayB)
+                    return true;
+
+                if (arrayB == nullptr || arrayA->size() != arrayB->size())
+                    return false;
+
+                for (int i = 0; i < arrayA->size(); ++i)
+                    if (!isEquivalentValue(arrayA->getReference(i), arrayB->getReference(i), budget))
+                        return false;
+
+                return true;
+            }
+
+            if (auto* objectA = a.getDynamicObject())
+            {
+                auto* objectB = b.getDynamicObject();
+
+                if (objectA == objectB)
+                    return true;
+
+                if (objectB == nullptr || objectA->getProperties().size() != objectB->getProperties().size())
+                    return false;
+
+                for (const auto& p : objectA->getProperties())
+                {
+                    const auto* other = objectB->getProperties().getVarPointer(p.name);
+
+                    if (other == nullptr || !isEquivalentValue(p.value, *other, budget))
+                        return false;
+                }
+
+                return true;
+            }
+
+            return a.equalsWithSameType(b);
+        }
+
+        // Enough for a transform list or a small style object.
+        constexpr int maxComparedValues = 64;
+
+        //==============================================================================
+        /** Returns true if the given style property is one the view paints for
+            itself, and so may change with its hover or pressed state. Text and
+            image properties are cached by the views which use them.
+         */
+        bool isStatePaintedProperty (const juce::Identifier& name)
+        {
+            return name == IDs::opacity
+                || name == IDs::backgroundColor
+                || name == IDs::backgroundGradient
+                || name == IDs::boxShadow
+                || ViewStyle::isBorderProperty(name)
+                || ViewStyle::isTransformProperty(name);
+        }
+
+        /** Splits a state style's name, e.g. `hover-background-color`, into its
+            state's values and the style property it sets, returning false if the
+            name isn't a state style's.
+         */
+        bool splitStateStyleName (const juce::Identifier& name, bool& isPressed, juce::Identifier& styleName)
+        {
+            static const juce::String hoverPrefix ("hover-");
+            static const juce::String pressedPrefix ("pressed-");
+
+            const auto s = name.toString();
+
+            if (s.startsWith(hoverPrefix))
+                isPressed = false;
+            else if (s.startsWith(pressedPrefix))
+                isPressed = true;
+            else
+                return false;
+
+            styleName = juce::Identifier(s.substring(isPressed ? pressedPrefix.length() : hoverPrefix.length()));
+            return isStatePaintedProperty(styleName);
+        }
+    }
+
     //==============================================================================
-    ViewId View::getViewId()
+    ReactApplicationRoot* View::getOwningRoot()
     {
-        return juce::DefaultHashFunctions::generateHash(_viewId, INT_MAX);
+        // Views which weren't created by a root, e.g. by a custom view for its own
+        // use, fall back to finding the root in the component hierarchy.
+        if (owningRoot == nullptr)
+            return findParentComponentOfClass<ReactApplicationRoot>();
+
+        return owningRoot;
+    }
+
+    //==============================================================================
+    namespace
+    {
+        // The view whose paint this thread is timing, if any.
+        thread_local View* viewBeingTimed = nullptr;
+    }
+
+    View::ScopedPaintTimer::ScopedPaintTimer (View& _view, const char* _viewType)
+        : view(_view), viewType(_viewType), enclosingView(viewBeingTimed)
+    {
+        // A view created by its root always knows it; the walk up the hierarchy
+        // for any other isn't worth a paint.
+        if (view.owningRoot == nullptr || enclosingView == &view)
+            return;
+
+        profiler = view.owningRoot->getActivePaintProfiler();
+
+        if (profiler != nullptr)
+        {
+            viewBeingTimed = &view;
+            startTicks = juce::Time::getHighResolutionTicks();
+        }
+    }
+
+    View::ScopedPaintTimer::~ScopedPaintTimer()
+    {
+        if (profiler == nullptr)
+            return;
+
+        const auto ms = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+        profiler->record(view.getViewId(), view._refId, viewType, ms);
+        viewBeingTimed = enclosingView;
+    }
+
+    bool View::hasEventHandlerInPath (EventFlags event)
+    {
+        for (auto* c = static_cast<juce::Component*>(this); c != nullptr; c = c->getParentComponent())
+            if (auto* v = dynamic_cast<View*>(c))
+                if (v->hasEventHandler(event) || v->hasCaptureHandler(event))
+                    return true;
+
+        return false;
     }
 
     juce::Identifier View::getRefId()
@@ -24,9 +217,59 @@ namespace blueprint
 
     void View::setProperty (const juce::Identifier& name, const juce::var& value)
     {
+        // Handlers themselves stay in JavaScript; we only need to know whether
+        // there is one, which the bridge marks with `true`.
+        const auto& handlers = getEventHandlerTable();
+        const auto handler = handlers.find(name);
+
+        if (handler != handlers.end())
+        {
+            auto& mask = handler->second.capture ? captureMask : eventMask;
+
+            if ((bool) value)
+                mask |= handler->second.event;
+            else
+                mask &= ~static_cast<juce::uint32>(handler->second.event);
+
+            return;
+        }
+
+        // A state style showing over this one takes it up again once the state
+        // ends.
+        if (isStateStyleShowing(name) && ViewStyle::isStyleProperty(name))
+        {
+            props.set(name, value);
+            return;
+        }
+
+        if (style.set(name, value))
+        {
+            props.set(name, value);
+            styleChanged(name);
+            return;
+        }
+
+        bool isPressed = false;
+        juce::Identifier styleName;
+
+        if (splitStateStyleName(name, isPressed, styleName))
+        {
+            auto& values = isPressed ? pressedStyleValues : hoverStyleValues;
+
+            if (value.isVoid())
+                values.remove(styleName);
+            else
+                values.set(styleName, value);
+
+            if (isPressed ? pressed : hovered)
+                applyStateStyles();
+
+            return;
+        }
+
         props.set(name, value);
 
-        if (name == juce::Identifier("interceptClickEvents"))
+        if (name == IDs::interceptClickEvents)
         {
             int flag = value;
 
@@ -47,78 +290,275 @@ namespace blueprint
             }
         }
 
-        if (name == juce::Identifier("opacity"))
-            setAlpha((double) value);
-        if (name == juce::Identifier("refId"))
+        // The layer is invalidated by every repaint of the view or of anything
+        // inside it, which commits already issue for changed props, children and
+        // bounds.
+        if (name == IDs::cacheAsLayer)
+            setBufferedToImage((bool) value);
+
+        if (name == IDs::focusable)
+            setWantsKeyboardFocus((bool) value);
+
+        // Both hide the view from paint and hit testing; `display: none` takes
+        // it out of the layout as well, which is the shadow view's to do.
+        if (name == IDs::display || name == IDs::visibility)
+        {
+            if (name == IDs::display)
+                displayNone = value.toString() == "none";
+            else
+                visibilityHidden = value.toString() == "hidden";
+
+            setVisible(!isHidden());
+        }
+
+        if (name == IDs::refId)
             _refId = juce::Identifier(value.toString());
     }
 
+    void View::styleChanged (const juce::Identifier& name)
+    {
+        // Both of these repaint by themselves, so that neither needs a layout
+        // or an explicit repaint from the root.
+        if (name == IDs::opacity)
+            setAlpha(style.opacity);
+        if (ViewStyle::isTransformProperty(name))
+        {
+            transformValid = false;
+            updateTransform();
+        }
+        if (ViewStyle::isBorderProperty(name) || name == IDs::rasterize)
+            borderRaster.invalidate();
+        if (name == IDs::borderPath)
+        {
+            hitTestPathValid = false;
+            invalidateClipPath();
+        }
+        if (name == IDs::backgroundGradient)
+            gradientRaster.invalidate();
+
+        // The shadow falls outside of the view, where only the parent paints.
+        if (name == IDs::boxShadow || name == IDs::borderPath || name == IDs::borderRadius)
+            shadowRaster.invalidate();
+        if (name == IDs::boxShadow || ViewStyle::isTransformProperty(name) || (style.hasBoxShadow && ViewStyle::isBorderProperty(name)))
+            repaintShadowArea();
+
+        updateOpaque();
+    }
+
+    //==============================================================================
+    bool View::isStateStyleProperty (const juce::Identifier& name)
+    {
+        bool isPressed = false;
+        juce::Identifier styleName;
+
+        return splitStateStyleName(name, isPressed, styleName);
+    }
+
+    bool View::isStateStyleShowing (const juce::Identifier& name) const
+    {
+        return (pressed && pressedStyleValues.contains(name))
+            || (hovered && hoverStyleValues.contains(name));
+    }
+
+    void View::applyStateStyles()
+    {
+        // The style is rebuilt from the values given, with those of the states
+        // the view is in over them, so that a style the state no longer sets
+        // goes back to its own value, or its default.
+        ViewStyle effective;
+
+        for (const auto& nv : props)
+            effective.set(nv.name, nv.value);
+
+        if (hovered)
+            for (const auto& nv : hoverStyleValues)
+                effective.set(nv.name, nv.value);
+
+        if (pressed)
+            for (const auto& nv : pressedStyleValues)
+                effective.set(nv.name, nv.value);
+
+        style = std::move(effective);
+
+        for (const auto* values : { &hoverStyleValues, &pressedStyleValues })
+            for (const auto& nv : *values)
+                styleChanged(nv.name);
+
+        repaint();
+    }
+
+    void View::setInteractionState (bool isHovered, bool isPressed)
+    {
+        if (isHovered == hovered && isPressed == pressed)
+            return;
+
+        const bool hoverChanged = isHovered != hovered && !hoverStyleValues.isEmpty();
+        const bool pressedChanged = isPressed != pressed && !pressedStyleValues.isEmpty();
+
+        hovered = isHovered;
+        pressed = isPressed;
+
+        if (hoverChanged || pressedChanged)
+            applyStateStyles();
+    }
+
+    void View::updateInteractionStates (int pressChange)
+    {
+        // The mouse moving onto a child takes it off its parent, as far as JUCE's
+        // enter and exit go, so every view up the tree looks for itself.
+        for (auto* c = static_cast<juce::Component*>(this); c != nullptr; c = c->getParentComponent())
+        {
+            if (auto* v = dynamic_cast<View*>(c))
+            {
+                const bool isPressed = pressChange > 0 ? true : (pressChange < 0 ? false : v->pressed);
+                v->setInteractionState(v->isMouseOver(true), isPressed);
+            }
+        }
+    }
+
     void View::addChild (View* childView, int index)
     {
         // Add the child view to our component heirarchy.
-        addAndMakeVisible(childView, index);
+        addChildComponent(childView, index);
+        childView->setVisible(!childView->isHidden());
+    }
+
+    void View::resetForReuse()
+    {
+        removeAllChildren();
+
+        style = ViewStyle();
+        props.clear();
+        cachedFloatBounds = {};
+
+        _refId = {};
+        layoutOnly = false;
+        layoutOffset = {};
+        borderRaster.invalidate();
+        hitTestPath.clear();
+        hitTestPathValid = false;
+        invalidateClipPath();
+        gradientRaster.invalidate();
+        shadowRaster.invalidate();
+        lastShadowArea = {};
+        eventMask = 0;
+        captureMask = 0;
+        lastPointerPosition = {};
+        displayNone = false;
+        visibilityHidden = false;
+        hoverStyleValues.clear();
+        pressedStyleValues.clear();
+        hovered = false;
+        pressed = false;
+
+        setAlpha(1.0f);
+        setTransform({});
+        transformValid = false;
+        setInterceptsMouseClicks(true, true);
+        setWantsKeyboardFocus(false);
+        setBufferedToImage(false);
+        setOpaque(false);
+        setVisible(true);
+        setBounds({});
     }
 
     void View::setFloatBounds(juce::Rectangle<float> bounds)
     {
         cachedFloatBounds = bounds;
+        setBounds((bounds + layoutOffset).toNearestInt());
+        updateTransform();
+        repaintShadowArea();
+    }
+
+    void View::setLayoutOffset (juce::Point<float> offset)
+    {
+        if (offset == layoutOffset)
+            return;
+
+        layoutOffset = offset;
+        setFloatBounds(cachedFloatBounds);
+    }
 
-        // Update transforms
-        if (props.contains("transform-rotate"))
+    void View::updateTransform()
+    {
+        if (style.hasTransform)
         {
-            float cxRelParent = cachedFloatBounds.getX() + cachedFloatBounds.getWidth() * 0.5f;
-            float cyRelParent = cachedFloatBounds.getY() + cachedFloatBounds.getHeight() * 0.5f;
-            double angle = props["transform-rotate"];
+            // Most layout flushes leave the view where it was.
+            const auto bounds = cachedFloatBounds + layoutOffset;
+
+            if (transformValid && bounds == transformedBounds)
+                return;
+
+            const auto centre = bounds.getCentre();
+
+            setTransform(juce::AffineTransform::translation(-centre.x, -centre.y)
+                             .followedBy(style.transform)
+                             .translated(centre.x, centre.y));
 
-            setTransform(juce::AffineTransform::rotation(angle, cxRelParent, cyRelParent));
+            transformedBounds = bounds;
+            transformValid = true;
         }
     }
 
-    //==============================================================================
-    float View::getResolvedLengthProperty (const juce::String& name, float axisLength)
+    bool View::hasPropertyValue (const juce::Identifier& name, const juce::var& value) const
     {
-        float ret = 0.0;
+        const auto* current = props.getVarPointer(name);
 
-        if (props.contains(name))
-        {
-            const auto& v = props[name];
+        bool isPressed = false;
+        juce::Identifier styleName;
 
-            if (v.isString() && v.toString().trim().endsWithChar('%'))
-            {
-                float pctVal = v.toString().retainCharacters("-1234567890.").getFloatValue();
-                ret = axisLength * (pctVal / 100.0f);
-            }
-            else
-            {
-                ret = (float) v;
-            }
-        }
+        if (current == nullptr && splitStateStyleName(name, isPressed, styleName))
+            current = (isPressed ? pressedStyleValues : hoverStyleValues).getVarPointer(styleName);
 
-        return ret;
+        int budget = maxComparedValues;
+        return current != nullptr && isEquivalentValue(*current, value, budget);
     }
 
-    void View::paint (juce::Graphics& g)
+    juce::RectangleList<int> View::getBorderArea()
     {
-        if (props.contains("border-path"))
-        {
-            juce::Path p = juce::Drawable::parseSVGPath(props["border-path"].toString());
+        juce::RectangleList<int> area (getLocalBounds());
 
-            if (props.contains("border-color"))
-            {
-                juce::Colour c = juce::Colour::fromString(props["border-color"].toString());
-                float borderWidth = props.getWithDefault("border-width", 1.0);
+        if (style.hasBorderPath || !style.hasBorderWidth)
+            return area;
 
-                g.setColour(c);
-                g.strokePath(p, juce::PathStrokeType(borderWidth));
-            }
+        // The stroke, corners included, lies within the width plus the radius
+        // of the edge.
+        const auto bounds = getLocalBounds();
+        const float radius = resolveLengthValue(style.borderRadius, (float) juce::jmin(bounds.getWidth(), bounds.getHeight()));
+        const int inset = (int) std::ceil(style.borderWidth + radius) + 1;
+
+        area.subtract(bounds.reduced(inset));
+        return area;
+    }
+
+    //==============================================================================
+    float View::getResolvedLengthProperty (const juce::Identifier& name, float axisLength)
+    {
+        if (name == IDs::borderRadius)
+            return resolveLengthValue(style.borderRadius, axisLength);
+
+        if (const auto* v = props.getVarPointer(name))
+            return resolveLengthValue(parseLengthValue(*v, false), axisLength);
+
+        return 0.0f;
+    }
+
+    void View::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("View::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "View");
+
+        if (style.hasBorderPath)
+        {
+            if (style.hasBorderColour)
+                strokeBorder(g, style.borderPath, style.borderWidth);
 
-            g.reduceClipRegion(p);
+            clipToBorderPath(g);
         }
-        else if (props.contains("border-color") && props.contains("border-width"))
+        else if (style.hasBorderColour && style.hasBorderWidth)
         {
             juce::Path border;
-            juce::Colour c = juce::Colour::fromString(props["border-color"].toString());
-            float borderWidth = props["border-width"];
+            const float borderWidth = style.borderWidth;
 
             // Note this little bounds trick. When a Path is stroked, the line width extends
             // outwards in both directions from the coordinate line. If the coordinate
@@ -128,58 +568,454 @@ namespace blueprint
             const float width = borderBounds.getWidth();
             const float height = borderBounds.getHeight();
             const float minLength = std::min(width, height);
-            float borderRadius = getResolvedLengthProperty("border-radius", minLength);
+            float borderRadius = resolveLengthValue(style.borderRadius, minLength);
 
             border.addRoundedRectangle(borderBounds, borderRadius);
-            g.setColour(c);
-            g.strokePath(border, juce::PathStrokeType(borderWidth));
-            g.reduceClipRegion(border);
+            strokeBorder(g, border, borderWidth);
+
+            // Clipping to a path turns every fill within it, our children's
+            // included, into an edge table walk. A square border clips to a
+            // rectangle, and a rounded one only needs its corners where
+            // something is painted into them: a plain view whose children
+            // keep clear of the corners clips to a rectangle and rounds its
+            // own background instead.
+            borderRadius = juce::jmin(borderRadius, width * 0.5f, height * 0.5f);
+
+            if (borderRadius <= 0.0f)
+            {
+                g.reduceClipRegion(borderBounds.toNearestIntEdges());
+            }
+            else if (typeid(*this) == typeid(View) && !style.hasBackgroundGradient && !childrenReachCorners(borderBounds, borderRadius))
+            {
+                g.reduceClipRegion(borderBounds.toNearestIntEdges());
+
+                if (style.hasBackgroundColour && !style.backgroundColour.isTransparent())
+                {
+                    g.setColour(style.backgroundColour);
+                    g.fillPath(border);
+                }
+
+                paintChildShadows(g);
+                return;
+            }
+            else
+            {
+                g.reduceClipRegion(border);
+            }
         }
 
-        if (props.contains("background-color"))
+        if (style.hasBackgroundColour && !style.backgroundColour.isTransparent())
+            g.fillAll(style.backgroundColour);
+
+        // Filling a gradient touches every pixel at some cost, so it's filled
+        // once for each size and scale, and blitted from then on.
+        if (style.hasBackgroundGradient)
+        {
+            gradientRaster.draw(g, getLocalBounds(), 1.0f, [this](juce::Graphics& target) {
+                target.setGradientFill(style.backgroundGradient.createFor(getLocalBounds().toFloat()));
+                target.fillAll();
+            });
+        }
+
+        paintChildShadows(g);
+    }
+
+    void View::paintChildShadows (juce::Graphics& g)
+    {
+        // Our children's shadows fall behind them, and outside them, so we paint
+        // them.
+        for (auto* c : getChildren())
+            if (auto* child = dynamic_cast<View*>(c))
+                if (child->style.hasBoxShadow && child->isVisible())
+                    child->paintBoxShadow(g);
+    }
+
+    bool View::childrenReachCorners (juce::Rectangle<float> bounds, float radius)
+    {
+        const juce::Rectangle<float> corners[] = {
+            bounds.withSize(radius, radius),
+            bounds.withLeft(bounds.getRight() - radius).withHeight(radius),
+            bounds.withTop(bounds.getBottom() - radius).withWidth(radius),
+            bounds.withLeft(bounds.getRight() - radius).withTop(bounds.getBottom() - radius),
+        };
+
+        for (auto* c : getChildren())
         {
-            juce::Colour c = juce::Colour::fromString(props["background-color"].toString());
+            if (!c->isVisible())
+                continue;
 
-            if (!c.isTransparent())
-                g.fillAll(c);
+            // A child's shadow is ours to paint, so it counts as the child's.
+            auto* child = dynamic_cast<View*>(c);
+            const auto area = (child != nullptr && child->style.hasBoxShadow ? getLocalArea(child, child->getShadowArea())
+                                                                             : c->getBoundsInParent()).toFloat();
+
+            for (const auto& corner : corners)
+                if (area.intersects(corner))
+                    return true;
+        }
+
+        return false;
+    }
+
+    void View::clipToBorderPath (juce::Graphics& g)
+    {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        std::shared_ptr<const juce::Path> path;
+
+        {
+            const juce::ScopedLock sl (clipPathLock);
+
+            // The path flattened into lines at the scale we paint at, which is
+            // most of the work of clipping to it, done once.
+            if (clipPath == nullptr || scale != clipPathScale)
+            {
+                auto flattened = std::make_shared<juce::Path>();
+                flattened->setUsingNonZeroWinding(style.borderPath.isUsingNonZeroWinding());
+
+                for (juce::PathFlatteningIterator it (style.borderPath, juce::AffineTransform::scale(scale)); it.next();)
+                {
+                    if (it.subPathIndex == 0)
+                        flattened->startNewSubPath(it.x1, it.y1);
+
+                    flattened->lineTo(it.x2, it.y2);
+
+                    if (it.closesSubPath)
+                        flattened->closeSubPath();
+                }
+
+                clipPath = std::move(flattened);
+                clipPathScale = scale;
+            }
+
+            path = clipPath;
         }
 
+        g.reduceClipRegion(*path, juce::AffineTransform::scale(1.0f / scale));
+    }
+
+    bool View::hitTest (int x, int y)
+    {
+        if (style.hasBorderPath)
+        {
+            if (!hitTestPathValid)
+            {
+                hitTestPath.clear();
+                hitTestPath.setUsingNonZeroWinding(style.borderPath.isUsingNonZeroWinding());
+
+                for (juce::PathFlatteningIterator it (style.borderPath); it.next();)
+                {
+                    if (it.subPathIndex == 0)
+                        hitTestPath.startNewSubPath(it.x1, it.y1);
+
+                    hitTestPath.lineTo(it.x2, it.y2);
+
+                    if (it.closesSubPath)
+                        hitTestPath.closeSubPath();
+                }
+
+                hitTestPathValid = true;
+            }
+
+            // Path::contains rejects points outside the path's bounds before
+            // it looks at a single line.
+            if (!hitTestPath.contains((float) x + 0.5f, (float) y + 0.5f))
+                return false;
+        }
+
+        return juce::Component::hitTest(x, y);
+    }
+
+    //==============================================================================
+    juce::Rectangle<int> View::getShadowArea() const
+    {
+        const auto& shadow = style.boxShadow;
+
+        return getLocalBounds()
+            .expanded(shadow.radius + 1)
+            .translated(shadow.offset.x, shadow.offset.y)
+            .getUnion(getLocalBounds());
+    }
+
+    void View::paintBoxShadow (juce::Graphics& g)
+    {
+        // In our parent's coordinates, through our own transform.
+        juce::Graphics::ScopedSaveState state (g);
+        g.addTransform(juce::AffineTransform::translation(getPosition().toFloat()).followedBy(getTransform()));
+
+        // The shadow is rendered in our own coordinates, so moving the view
+        // blits the same image somewhere else.
+        const auto area = getShadowArea();
+
+        shadowRaster.draw(g, area, getAlpha(), [this, area](juce::Graphics& target) {
+            juce::Path shape;
+
+            if (style.hasBorderPath)
+            {
+                shape = style.borderPath;
+            }
+            else
+            {
+                const auto bounds = getLocalBounds().toFloat();
+                shape.addRoundedRectangle(bounds, resolveLengthValue(style.borderRadius, juce::jmin(bounds.getWidth(), bounds.getHeight())));
+            }
+
+            shape.applyTransform(juce::AffineTransform::translation((float) -area.getX(), (float) -area.getY()));
+            style.boxShadow.drawForPath(target, shape);
+        });
+    }
+
+    void View::repaintShadowArea()
+    {
+        if (!style.hasBoxShadow && lastShadowArea.isEmpty())
+            return;
+
+        auto* parent = getParentComponent();
+
+        if (parent == nullptr)
+            return;
+
+        const auto area = style.hasBoxShadow ? parent->getLocalArea(this, getShadowArea()) : juce::Rectangle<int>();
+
+        parent->repaint(lastShadowArea.getUnion(area));
+        lastShadowArea = area;
+    }
+
+    void View::invalidateClipPath()
+    {
+        const juce::ScopedLock sl (clipPathLock);
+        clipPath = nullptr;
+    }
+
+    void View::updateOpaque()
+    {
+        // The background fill covers every pixel of the view unless the border
+        // clips it, in which case we can't tell without painting. A square
+        // border's clip only cuts into the outer half of its stroke, which is
+        // opaque in turn if its colour is.
+        const bool radiusIsZero = (style.borderRadius.unit == YGUnitUndefined || style.borderRadius.value == 0.0f);
+
+        setOpaque(style.hasBackgroundColour
+                  && style.backgroundColour.isOpaque()
+                  && !style.hasBorderPath
+                  && radiusIsZero
+                  && (!style.hasBorderColour || style.borderColour.isOpaque())
+                  && style.opacity >= 1.0f);
+    }
+
+    void View::strokeBorder (juce::Graphics& g, const juce::Path& border, float width)
+    {
+        auto stroke = [&](juce::Graphics& target)
+        {
+            target.setColour(style.borderColour);
+            target.strokePath(border, juce::PathStrokeType(width));
+        };
+
+        if (style.rasterize)
+            borderRaster.draw(g, getLocalBounds(), 1.0f, stroke);
+        else
+            stroke(g);
     }
 
     //==============================================================================
     void View::resized()
     {
+        if (!hasEventHandler(MeasureEvent))
+            return;
+
         auto w = cachedFloatBounds.getWidth();
         auto h = cachedFloatBounds.getHeight();
 
-        if (ReactApplicationRoot* root = findParentComponentOfClass<ReactApplicationRoot>())
-            root->dispatchViewEvent(getViewId(), "Measure", w, h);
+        if (ReactApplicationRoot* root = getOwningRoot())
+        {
+            // Content scrolled out of sight, which is most of a long list, gets
+            // laid out with everything else, but JavaScript need only hear about
+            // its size once it can be seen.
+            if (isScrolledOutOfView())
+                root->holdMeasureEvent(getViewId(), w, h);
+            else
+                root->queueMeasureEvent(getViewId(), w, h);
+        }
+    }
+
+    bool View::isScrolledOutOfView()
+    {
+        for (auto* c = getParentComponent(); c != nullptr; c = c->getParentComponent())
+        {
+            if (auto* viewport = dynamic_cast<juce::Viewport*>(c))
+            {
+                const auto area = viewport->getLocalArea(this, getLocalBounds());
+                return !area.isEmpty() && !viewport->getLocalBounds().intersects(area);
+            }
+        }
+
+        return false;
+    }
+
+    void View::scrolledAreaChanged (juce::Point<int> scrollPosition)
+    {
+        if (ReactApplicationRoot* root = getOwningRoot())
+        {
+            root->releaseHeldMeasureEvents();
+
+            if (hasEventHandler(ScrollEvent))
+                root->queuePointerEvent(getViewId(), PointerEventType::Scroll, scrollPosition.toFloat(), {}, {});
+        }
+    }
+
+    void View::queueLoadEvent (float width, float height)
+    {
+        if (!hasEventHandler(LoadEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->queueLoadEvent(getViewId(), width, height);
     }
 
+    void View::intrinsicSizeChanged()
+    {
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->intrinsicSizeChanged(getViewId());
+    }
+
+    // Discrete events are dispatched straight away, after flushing any queued
+    // pointer events so that JavaScript sees everything in order.
     void View::mouseDown (const juce::MouseEvent& e)
     {
-        if (ReactApplicationRoot* root = findParentComponentOfClass<ReactApplicationRoot>())
-            root->dispatchViewEvent(getViewId(), "MouseDown", e.x, e.y);
+        lastPointerPosition = e.position;
+        updateInteractionStates(1);
+
+        if (!hasEventHandlerInPath(MouseDownEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+        {
+            root->flushPointerEvents();
+            root->noteInputEvent(e);
+            root->dispatchBubblingViewEvent(*this, MouseDownEvent, IDs::MouseDown, e.x, e.y);
+        }
     }
 
     void View::mouseUp (const juce::MouseEvent& e)
     {
-        if (ReactApplicationRoot* root = findParentComponentOfClass<ReactApplicationRoot>())
-            root->dispatchViewEvent(getViewId(), "MouseUp", e.x, e.y);
+        updateInteractionStates(-1);
+
+        if (!hasEventHandlerInPath(MouseUpEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+        {
+            root->flushPointerEvents();
+            root->dispatchBubblingViewEvent(*this, MouseUpEvent, IDs::MouseUp, e.x, e.y);
+        }
+    }
+
+    void View::mouseDoubleClick (const juce::MouseEvent& e)
+    {
+        if (!hasEventHandlerInPath(MouseDoubleClickEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+        {
+            root->flushPointerEvents();
+            root->dispatchBubblingViewEvent(*this, MouseDoubleClickEvent, IDs::MouseDoubleClick, e.x, e.y);
+        }
     }
 
+    //==============================================================================
+    // Continuous events go through the root's pointer event queue, which merges
+    // everything a view receives within a frame into one dispatch.
     void View::mouseDrag (const juce::MouseEvent& e)
     {
-        float mouseDownX = e.mouseDownPosition.getX();
-        float mouseDownY = e.mouseDownPosition.getY();
+        const auto delta = e.position - lastPointerPosition;
+        lastPointerPosition = e.position;
+
+        if (!hasEventHandlerInPath(MouseDragEvent))
+            return;
 
-        if (ReactApplicationRoot* root = findParentComponentOfClass<ReactApplicationRoot>())
-            root->dispatchViewEvent(getViewId(), "MouseDrag", e.x, e.y, mouseDownX, mouseDownY);
+        if (ReactApplicationRoot* root = getOwningRoot())
+        {
+            root->noteInputEvent(e);
+            root->queuePointerEvent(getViewId(), PointerEventType::Drag, e.position, e.mouseDownPosition, delta);
+        }
     }
 
-    void View::mouseDoubleClick (const juce::MouseEvent& e)
+    void View::mouseMove (const juce::MouseEvent& e)
+    {
+        const auto delta = e.position - lastPointerPosition;
+        lastPointerPosition = e.position;
+
+        if (!hasEventHandlerInPath(MouseMoveEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->queuePointerEvent(getViewId(), PointerEventType::Move, e.position, e.mouseDownPosition, delta);
+    }
+
+    void View::mouseEnter (const juce::MouseEvent& e)
+    {
+        lastPointerPosition = e.position;
+        updateInteractionStates(0);
+
+        if (!hasEventHandler(MouseEnterEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->queuePointerEvent(getViewId(), PointerEventType::Enter, e.position, e.mouseDownPosition, {});
+    }
+
+    void View::mouseExit (const juce::MouseEvent& e)
+    {
+        updateInteractionStates(0);
+
+        if (!hasEventHandler(MouseExitEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->queuePointerEvent(getViewId(), PointerEventType::Exit, e.position, e.mouseDownPosition, {});
+    }
+
+    void View::mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+    {
+        if (!hasEventHandlerInPath(MouseWheelEvent))
+            return juce::Component::mouseWheelMove(e, wheel);
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->queuePointerEvent(getViewId(), PointerEventType::Wheel, e.position, e.mouseDownPosition, { wheel.deltaX, wheel.deltaY });
+    }
+
+    //==============================================================================
+    bool View::keyPressed (const juce::KeyPress& key)
+    {
+        if (!hasEventHandlerInPath(KeyDownEvent))
+            return false;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+        {
+            root->flushPointerEvents();
+            root->dispatchBubblingViewEvent(*this, KeyDownEvent, IDs::KeyDown,
+                                            key.getKeyCode(),
+                                            juce::String::charToString(key.getTextCharacter()),
+                                            key.getModifiers().getRawFlags());
+        }
+
+        return true;
+    }
+
+    void View::focusGained (FocusChangeType)
     {
-        if (ReactApplicationRoot* root = findParentComponentOfClass<ReactApplicationRoot>())
-            root->dispatchViewEvent(getViewId(), "MouseDoubleClick", e.x, e.y);
+        if (!hasEventHandler(FocusEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->dispatchViewEvent(getViewId(), IDs::Focus);
+    }
+
+    void View::focusLost (FocusChangeType)
+    {
+        if (!hasEventHandler(BlurEvent))
+            return;
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->dispatchViewEvent(getViewId(), IDs::Blur);
     }
 }
@@ -10,32 +10,126 @@
 #pragma once
 
 #include <map>
+#include <memory>
+
+#include "blueprint_Identifiers.h"
+#include "blueprint_ObjectCensus.h"
+#include "blueprint_RasterCache.h"
+#include "blueprint_TraceRecorder.h"
+#include "blueprint_ViewStyle.h"
 
 
 namespace blueprint
 {
 
-    // Internally we use a juce::Uuid for uniquely identifying views, but we
-    // need that same identifier to make a transit through JavaScript land
-    // and still match afterwards. So we map our Uuids into a signed 32-bit integer
-    // type and leave Duktape to perform the appropriate cast through JavaScript's
-    // double-width "Number" type.
+    class PaintProfiler;
+    class ReactApplicationRoot;
+
+    // Views are identified by a signed 32-bit integer allocated by the owning
+    // root's ViewTable, which encodes the view's slot in that table. We need the
+    // identifier to make a transit through JavaScript land and still match
+    // afterwards, and a positive int32 survives the cast through JavaScript's
+    // double-width "Number" type exactly.
     typedef juce::int32 ViewId;
 
+    /** The continuous pointer events, which are queued and coalesced per frame
+        rather than dispatched as they arrive.
+     */
+    enum class PointerEventType
+    {
+        Drag,
+        Move,
+        Enter,
+        Exit,
+        Wheel,
+        Scroll,
+    };
+
     //==============================================================================
     /** The View class is the core component abstraction for Blueprint's declarative
         flex-based component composition.
+
+        A view's own painted style properties, its background, border, shadow,
+        opacity and transform, may each be given again for while the mouse is
+        over the view or pressed on it, as in `hover-background-color` or
+        `pressed-opacity`. The view switches between them itself and repaints,
+        with no event sent to JavaScript and no render in between.
      */
     class View : public juce::Component
     {
     public:
         //==============================================================================
+        /** The kinds of view the root has to tell apart as it mounts and updates
+            them, each tagged in its class's constructor so that the root checks
+            a tag rather than making a dynamic_cast. Every other view is Plain.
+         */
+        enum class Kind
+        {
+            Plain,
+            Text,
+            TextSpan,
+            RawText,
+        };
+
         View() = default;
         virtual ~View() = default;
 
+        /** Returns which kind of view this is. See viewCast. */
+        Kind getKind() const noexcept { return kind; }
+
         //==============================================================================
         /** Returns this view's identifier. */
-        ViewId getViewId();
+        ViewId getViewId() const { return _viewId; }
+
+        /** Assigns this view's identifier; called by the ViewTable which owns the view. */
+        void setViewId (ViewId id) { _viewId = id; }
+
+        /** Returns the root which owns this view, or nullptr if it has none. */
+        ReactApplicationRoot* getOwningRoot();
+
+        /** Records the root which owns this view; called by the root as it creates
+            the view, saving a walk up the component hierarchy for every event.
+         */
+        void setOwningRoot (ReactApplicationRoot* root) { owningRoot = root; }
+
+        //==============================================================================
+        /** The events which a view may have a handler for on the JavaScript side. */
+        enum EventFlags
+        {
+            MeasureEvent            = 1 << 0,
+            MouseDownEvent          = 1 << 1,
+            MouseUpEvent            = 1 << 2,
+            MouseDragEvent          = 1 << 3,
+            MouseDoubleClickEvent   = 1 << 4,
+            MouseMoveEvent          = 1 << 5,
+            MouseEnterEvent         = 1 << 6,
+            MouseExitEvent          = 1 << 7,
+            MouseWheelEvent         = 1 << 8,
+            LoadEvent               = 1 << 9,
+            VisibleRangeChangeEvent = 1 << 10,
+            ScrollEvent             = 1 << 11,
+            ValueChangeEvent        = 1 << 12,
+            ChangeEvent             = 1 << 13,
+            SubmitEvent             = 1 << 14,
+            KeyDownEvent            = 1 << 15,
+            FocusEvent              = 1 << 16,
+            BlurEvent               = 1 << 17,
+            NoteChangeEvent         = 1 << 18,
+        };
+
+        /** Returns true if the JavaScript view has a handler for the given event. */
+        bool hasEventHandler (EventFlags event) const { return (eventMask & event) != 0; }
+
+        /** Returns true if the JavaScript view has a capture phase handler for
+            the given event, e.g. `onMouseDownCapture`.
+         */
+        bool hasCaptureHandler (EventFlags event) const { return (captureMask & event) != 0; }
+
+        /** Returns true if this view or any ancestor view has a handler, of either
+            phase, for the given event; i.e. if the event would reach a handler
+            as it propagates.
+         */
+        bool hasEventHandlerInPath (EventFlags event);
 
         /** Returns this view's reference identifier, optionally set via React props. */
         juce::Identifier getRefId();
@@ -43,23 +137,145 @@ namespace blueprint
         /** Set a property on the native view. */
         virtual void setProperty (const juce::Identifier&, const juce::var&);
 
+        /** Returns true if the given property was last set to the given value, so
+            that setting it again would change nothing. Small arrays and objects
+            compare by content.
+         */
+        bool hasPropertyValue (const juce::Identifier& name, const juce::var& value) const;
+
+        /** Stores the value of a property which only the shadow view consumes,
+            such as a flex property, without setting it on the view, so that the
+            value is kept once, here, for `hasPropertyValue` and the like.
+         */
+        void storePropertyValue (const juce::Identifier& name, const juce::var& value) { props.set(name, value); }
+
+        /** Returns the area of the view which its border paints, in local
+            coordinates, which is all of it unless a simple border leaves an
+            interior which the border colour doesn't touch.
+         */
+        juce::RectangleList<int> getBorderArea();
+
         /** Adds a child component behind the existing children. */
         virtual void addChild (View* childView, int index = -1);
 
-        /** Updates the cached float layout bounds from the shadow tree. */
+        /** Returns the view to its state as constructed, with no properties,
+            handlers or children, so that the root can reuse it for a new view of
+            the same type. Views with state of their own reset it too.
+         */
+        virtual void resetForReuse();
+
+        /** Moves the view to the given layout bounds, relative to its parent in
+            the shadow tree.
+         */
         void setFloatBounds (juce::Rectangle<float> bounds);
 
+        /** Returns the float layout bounds last flushed from the shadow tree. */
+        juce::Rectangle<float> getFloatBounds() const { return cachedFloatBounds; }
+
+        //==============================================================================
+        /** Returns true while the view is flattened out of the component hierarchy.
+
+            A layout-only view is a plain View which has only been given flex
+            layout properties, so it has nothing to paint and no events to handle.
+            It keeps its place in the shadow tree, but its children are mounted on
+            the nearest ancestor which isn't layout-only, offset by the view's own
+            position. A view stops being layout-only, for good, as soon as it's
+            given any other property.
+         */
+        bool isLayoutOnly() const { return layoutOnly; }
+
+        /** Returns true if the given property is a hover or pressed style, such
+            as `hover-background-color`.
+         */
+        static bool isStateStyleProperty (const juce::Identifier& name);
+
+        /** Returns true if `display: none` or `visibility: hidden` hides the view. */
+        bool isHidden() const { return displayNone || visibilityHidden; }
+
+        /** Marks the view as layout-only or not; called by the root which mounts it. */
+        void setLayoutOnly (bool shouldBeLayoutOnly) { layoutOnly = shouldBeLayoutOnly; }
+
+        /** Returns true if the view's children are simply its child components,
+            so that the root may mount a layout-only child's children straight on
+            it, as it does for plain Views.
+         */
+        bool mountsChildComponents() const { return childComponentsMounted; }
+
+        /** Records whether the view mounts its children as its own components;
+            called once by the root which creates the view.
+         */
+        void setMountsChildComponents (bool shouldMount) { childComponentsMounted = shouldMount; }
+
+        /** Sets the offset from the component the view is mounted on to its parent
+            in the shadow tree, which differ when the parent is layout-only.
+         */
+        void setLayoutOffset (juce::Point<float> offset);
+
+        /** Returns the offset set by setLayoutOffset. */
+        juce::Point<float> getLayoutOffset() const { return layoutOffset; }
+
+        /** Applies the style's transform about the centre of the current bounds,
+            unless it's already applied at these bounds.
+         */
+        void updateTransform();
+
+        /** Returns the view's parsed style properties. */
+        const ViewStyle& getStyle() const { return style; }
+
         //==============================================================================
         /** Resolves a property to a specific point value or 0 if not present. */
-        float getResolvedLengthProperty (const juce::String& name, float axisLength);
+        float getResolvedLengthProperty (const juce::Identifier& name, float axisLength);
 
         /** Override the default Component method with default paint behaviors. */
         void paint (juce::Graphics& g) override;
 
+        /** Returns true if the view can be painted on another thread, into
+            several tiles at once, while the message thread waits. See
+            TiledRasterizer.
+
+            A view which keeps any state while it paints, other than through a
+            RasterCache, or reads state another thread writes, must return false,
+            and is then painted on the message thread as before.
+         */
+        virtual bool canPaintConcurrently() const { return true; }
+
+        /** Times the enclosing `paint` for the owning root's PaintProfiler,
+            while it's profiling, as a paint of the given view type. Views
+            declare one at the top of `paint`; a paint which calls on View::paint
+            is timed once, as the outer type.
+         */
+        class ScopedPaintTimer
+        {
+        public:
+            ScopedPaintTimer (View& view, const char* viewType);
+            ~ScopedPaintTimer();
+
+        private:
+            View& view;
+            const char* viewType;
+            PaintProfiler* profiler = nullptr;
+            View* enclosingView = nullptr;
+            juce::int64 startTicks = 0;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedPaintTimer)
+        };
+
+        /** Misses wherever the view's `border-path` leaves out, just as its paint
+            is clipped there, and otherwise hit-tests as a plain Component.
+         */
+        bool hitTest (int x, int y) override;
+
         //==============================================================================
-        /** Dispatches a resized event to the React application. */
+        /** Queues a Measure event for the React application, or holds it back
+            while the view is scrolled out of sight.
+         */
         void resized() override;
 
+        /** Returns true if the view lies entirely outside the visible area of
+            the nearest Viewport it's in, such as a ScrollView's.
+         */
+        bool isScrolledOutOfView();
+
         /** Dispatches a mouseDown event to the React application. */
         void mouseDown (const juce::MouseEvent& e) override;
 
@@ -72,18 +288,208 @@ namespace blueprint
         /** Dispatches a mouseDoubleClick event to the React application. */
         void mouseDoubleClick (const juce::MouseEvent& e) override;
 
+        /** Queues a coalesced mouseMove event for the React application. */
+        void mouseMove (const juce::MouseEvent& e) override;
+
+        /** Queues a mouseEnter event for the React application. */
+        void mouseEnter (const juce::MouseEvent& e) override;
+
+        /** Queues a mouseExit event for the React application. */
+        void mouseExit (const juce::MouseEvent& e) override;
+
+        /** Queues a coalesced mouseWheelMove event for the React application, or
+            passes the event up to the parent if there's no handler, as a plain
+            Component does.
+         */
+        void mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+
+        /** Dispatches a keyDown event to the React application, with the key
+            code, the character typed and the raw modifier flags, if the view or
+            an ancestor has a handler for it. Otherwise passes the key up to the
+            parent, as a plain Component does, so that keys nothing wants reach
+            the host's shortcuts.
+
+            Keys go to the view with keyboard focus, which a view given the
+            `focusable` property takes when clicked, or to the root otherwise.
+         */
+        bool keyPressed (const juce::KeyPress& key) override;
+
+        /** Dispatches a focus event to the React application. */
+        void focusGained (FocusChangeType cause) override;
+
+        /** Dispatches a blur event to the React application. */
+        void focusLost (FocusChangeType cause) override;
+
     protected:
         //==============================================================================
+        /** Constructs a view of one of the tagged kinds. */
+        explicit View (Kind _kind) : kind(_kind) {}
+
+        //==============================================================================
+        /** Tells the React application, if it's listening, that this view has
+            loaded its content, of the given natural size. The event is delivered
+            asynchronously.
+         */
+        void queueLoadEvent (float width, float height);
+
+        /** Called by views with an intrinsic size whenever it changes, so that
+            the root measures the view again at the next layout.
+         */
+        void intrinsicSizeChanged();
+
+        /** Called by views which scroll their content whenever the visible area
+            changes, to queue an `onScroll` event with the new scroll position,
+            and so that events held back from views out of sight go out as they
+            come into view.
+         */
+        void scrolledAreaChanged (juce::Point<int> scrollPosition);
+
+        //==============================================================================
+        // Style properties are parsed into the typed style as they're set, for
+        // painting. props holds every property as given, style properties too,
+        // so that user-defined views can read any of them.
+        ViewStyle style;
         juce::NamedValueSet props;
         juce::Rectangle<float> cachedFloatBounds;
 
     private:
         //==============================================================================
-        juce::Uuid _viewId;
+        /** Brings what the view caches of its style up to date with a change to
+            the given style property.
+         */
+        void styleChanged (const juce::Identifier& name);
+
+        /** Returns true if a hover or pressed style the view is showing sets the
+            given style property.
+         */
+        bool isStateStyleShowing (const juce::Identifier& name) const;
+
+        /** Rebuilds the style from its own values and those of the states the
+            view is in, and repaints the view.
+         */
+        void applyStateStyles();
+
+        /** Moves the view into the given hover and pressed states, applying its
+            state styles if that changes what it shows.
+         */
+        void setInteractionState (bool isHovered, bool isPressed);
+
+        /** Updates the hover state of this view and each of its ancestors, and
+            their pressed state too given a press (1) or release (-1).
+         */
+        void updateInteractionStates (int pressChange);
+
+        /** Marks the view opaque when its style fills all of its bounds, so that
+            JUCE needn't paint what's behind it.
+         */
+        void updateOpaque();
+
+        /** Strokes the view's border, from its cached image if the view is rasterized. */
+        void strokeBorder (juce::Graphics& g, const juce::Path& border, float width);
+
+        /** Paints the shadows of our children which have a `box-shadow`. */
+        void paintChildShadows (juce::Graphics& g);
+
+        /** Returns true if any visible child, or its shadow, overlaps a corner
+            of the given rounded rectangle.
+         */
+        bool childrenReachCorners (juce::Rectangle<float> bounds, float radius);
+
+        /** Clips to the `border-path`, flattened into lines once per scale. */
+        void clipToBorderPath (juce::Graphics& g);
+        void invalidateClipPath();
+
+        /** Returns the area the view's `box-shadow` covers, in local coordinates,
+            the view itself included.
+         */
+        juce::Rectangle<int> getShadowArea() const;
+
+        /** Paints the view's shadow into its parent's graphics, from its cached
+            image.
+         */
+        void paintBoxShadow (juce::Graphics& g);
+
+        /** Has the parent repaint wherever the shadow was and now is, which the
+            view's own repaints don't reach.
+         */
+        void repaintShadowArea();
+
+        //==============================================================================
+        ViewId _viewId = 0;
+        Kind kind = Kind::Plain;
         juce::Identifier _refId;
+        ReactApplicationRoot* owningRoot = nullptr;
+
+        bool layoutOnly = false;
+        bool childComponentsMounted = false;
+        juce::Point<float> layoutOffset;
+
+        bool displayNone = false;
+        bool visibilityHidden = false;
+
+        // The styles shown over the view's own while the mouse is over it or
+        // pressed on it, e.g. `hover-background-color`, by style property.
+        juce::NamedValueSet hoverStyleValues;
+        juce::NamedValueSet pressedStyleValues;
+        bool hovered = false;
+        bool pressed = false;
+
+        // The bounds the transform was last applied about.
+        juce::Rectangle<float> transformedBounds;
+        bool transformValid = false;
+
+        // The border's stroke, when the view is rasterized.
+        RasterCache borderRaster;
+
+        // The background gradient, and the shadow our parent paints for us,
+        // each rendered once for a given size and scale.
+        RasterCache gradientRaster;
+        RasterCache shadowRaster;
+        juce::Rectangle<int> lastShadowArea;
+
+        // The border path flattened into lines, built on the first hit-test after
+        // the path changes, so that a mouse moving over the view doesn't
+        // subdivide the path's curves again at every step.
+        juce::Path hitTestPath;
+        bool hitTestPathValid = false;
+
+        // The border path flattened at the scale it was last clipped to. Tiles
+        // may paint the view at once, so each takes its own reference.
+        std::shared_ptr<const juce::Path> clipPath;
+        float clipPathScale = 0.0f;
+        juce::CriticalSection clipPathLock;
+
+        // One EventFlags bit for each event handler prop the view has. We only
+        // cross the bridge for events with a handler.
+        juce::uint32 eventMask = 0;
+        juce::uint32 captureMask = 0;
+
+        // The last pointer position we reported, from which move and drag
+        // events carry their deltas.
+        juce::Point<float> lastPointerPosition;
+
+        LiveObjectCounter<View> liveCounter;
 
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (View)
     };
 
+    //==============================================================================
+    /** Returns the given view as one of the tagged view classes, as in
+        `viewCast<TextView>(view)`, or nullptr if it's of another kind.
+
+        The class names its kind as `static constexpr View::Kind viewKind`. The
+        tag is checked in place of a dynamic_cast, and debug builds check the
+        cast against one as well.
+     */
+    template <typename ViewClass>
+    ViewClass* viewCast (View* view) noexcept
+    {
+        if (view == nullptr || view->getKind() != ViewClass::viewKind)
+            return nullptr;
+
+        jassert (dynamic_cast<ViewClass*>(view) != nullptr);
+        return static_cast<ViewClass*>(view);
+    }
+
 }
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    blueprint_ViewPropertyTable.h
+    Created: 15 Oct 2026 10:12:33pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <type_traits>
+#include <unordered_map>
+
+#include "blueprint_Identifiers.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Which of a view and its shadow view a property is for. */
+    struct ViewPropertyConsumers
+    {
+        enum PropertyConsumer
+        {
+            ConsumedByView      = 1 << 0,
+            ConsumedByShadow    = 1 << 1,
+            ConsumedByBoth      = ConsumedByView | ConsumedByShadow,
+        };
+    };
+
+    //==============================================================================
+    /** A view class's own properties, declared in one table with who consumes
+        each and how the view applies it, in place of a chain of comparisons in
+        its setProperty.
+
+        The class declares its entries as a constexpr array, each a property
+        name, its consumers, and a setter, any captureless lambda taking the view
+        and the value, or nullptr for a property only the shadow view consumes:
+
+            static const ViewPropertyTable<MeterView>& getPropertyTable()
+            {
+                static constexpr ViewPropertyTable<MeterView>::Entry entries[] = {
+                    { "channel", ViewPropertyConsumers::ConsumedByView,
+                      [](MeterView& m, const juce::var& v) { m.firstChannel = (int) v; } },
+                };
+
+                static const ViewPropertyTable<MeterView> table (entries);
+                return table;
+            }
+
+        and its setProperty passes whatever View::setProperty doesn't take on to
+        `apply`. Registered with `ReactApplicationRoot::registerViewType<T>`, the
+        type's consumers come from the same table.
+
+        Identifiers are pooled as the process runs, so the lookup can't be built
+        at compile time; the table indexes its entries once, on first use, by
+        their pooled names, each lookup then hashing a pointer as IdentifierHash
+        does.
+     */
+    template <typename ViewClass>
+    class ViewPropertyTable : public ViewPropertyConsumers
+    {
+    public:
+        //==============================================================================
+        typedef void (*Setter)(ViewClass&, const juce::var&);
+
+        struct Entry
+        {
+            const char* name;
+            int consumers;
+            Setter setter;
+        };
+
+        //==============================================================================
+        template <size_t numEntries>
+        explicit ViewPropertyTable (const Entry (&entries)[numEntries])
+        {
+            index.reserve(numEntries);
+
+            for (const auto& entry : entries)
+            {
+                // If you hit this, the table names a property twice.
+                jassert (index.find(juce::Identifier(entry.name)) == index.end());
+
+                // And if you hit this, the view consumes a property it has no
+                // setter for.
+                jassert (entry.setter != nullptr || (entry.consumers & ConsumedByView) == 0);
+
+                index.emplace(juce::Identifier(entry.name), entry);
+            }
+        }
+
+        //==============================================================================
+        /** Applies the given property to the view, returning false if it isn't
+            one of the table's, or has no setter.
+         */
+        bool apply (ViewClass& view, const juce::Identifier& name, const juce::var& value) const
+        {
+            const auto it = index.find(name);
+
+            if (it == index.end() || it->second.setter == nullptr)
+                return false;
+
+            it->second.setter(view, value);
+            return true;
+        }
+
+        /** Calls the given function with the name and consumers of each entry. */
+        template <typename Fn>
+        void forEachProperty (Fn&& fn) const
+        {
+            for (const auto& entry : index)
+                fn(entry.first, entry.second.consumers);
+        }
+
+    private:
+        //==============================================================================
+        std::unordered_map<juce::Identifier, Entry, IdentifierHash> index;
+    };
+
+    //==============================================================================
+    /** True for view classes which declare a static getPropertyTable(). */
+    template <typename ViewClass, typename = void>
+    struct HasViewPropertyTable : std::false_type {};
+
+    template <typename ViewClass>
+    struct HasViewPropertyTable<ViewClass, std::void_t<decltype(ViewClass::getPropertyTable())>> : std::true_type {};
+
+}
@@ -0,0 +1,471 @@
+/*
+  ==============================================================================
+
+    blueprint_ViewStyle.h
+    Created: 14 Oct 2026 4:18:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_Identifiers.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** Lengths other than points cross the bridge as tagged numbers, as the
+        JavaScript `percent(n)` and `auto` encode them, so that they're read
+        without parsing a string. A percentage is percentLengthOffset plus the
+        percentage, and `auto` is autoLengthValue; no point value comes near.
+     */
+    constexpr double taggedLengthThreshold = 2147483648.0;
+    constexpr double percentLengthOffset = 4294967296.0;
+    constexpr double autoLengthValue = 8589934592.0;
+
+    /** Parses a length property value into a (value, unit) pair.
+
+        Numbers are point values, or tagged percentages or `auto`, and strings
+        containing a `%` are percentages; with `allowAuto`, `auto` in either
+        form gives YGUnitAuto. Anything else is undefined. This is the one
+        parser for lengths, shared by the shadow view's flex dimension
+        properties and the view's own length properties.
+     */
+    inline YGValue parseLengthValue (const juce::var& value, bool allowAuto)
+    {
+        if (value.isDouble() || value.isInt() || value.isInt64())
+        {
+            const double d = value;
+
+            if (d < taggedLengthThreshold)
+                return { (float) d, YGUnitPoint };
+
+            if (d >= autoLengthValue)
+                return { 0.0f, allowAuto ? YGUnitAuto : YGUnitUndefined };
+
+            return { (float) (d - percentLengthOffset), YGUnitPercent };
+        }
+
+        if (value.isString())
+        {
+            const juce::String s = value.toString();
+
+            if (allowAuto && s == "auto")
+                return { 0.0f, YGUnitAuto };
+
+            if (s.trim().contains("%"))
+                return { s.retainCharacters("-1234567890.").getFloatValue(), YGUnitPercent };
+        }
+
+        return { 0.0f, YGUnitUndefined };
+    }
+
+    /** Resolves a parsed length against the length of the relevant axis, giving 0
+        for lengths which aren't a point or percentage value.
+     */
+    inline float resolveLengthValue (const YGValue& length, float axisLength)
+    {
+        switch (length.unit)
+        {
+            case YGUnitPoint:   return length.value;
+            case YGUnitPercent: return axisLength * (length.value / 100.0f);
+            case YGUnitAuto:
+            case YGUnitUndefined:
+            default:            return 0.0f;
+        }
+    }
+
+    /** Parses a colour property value: a number is packed ARGB, 0xAARRGGBB, as
+        the JavaScript `color` and `rgba` give it, and a string is hex ARGB as
+        juce::Colour::fromString reads it.
+     */
+    inline juce::Colour parseColourValue (const juce::var& value)
+    {
+        if (value.isDouble() || value.isInt() || value.isInt64())
+            return juce::Colour(static_cast<juce::uint32>(static_cast<juce::int64>(value)));
+
+        return juce::Colour::fromString(value.toString());
+    }
+
+    //==============================================================================
+    /** A parsed `background-gradient`, which builds the juce::ColourGradient
+        for any area.
+
+        Written `linear(<degrees>, <colour> <position>, ...)`, the angle as in
+        CSS, 0 running to the top and 90 to the right, or `radial(<colour>
+        <position>, ...)` from the centre out to the corners. Positions run
+        from 0 to 1, and stops without one are spread evenly.
+     */
+    struct GradientStyle
+    {
+        bool radial = false;
+        float angle = 0.0f;
+        std::vector<std::pair<double, juce::Colour>> stops;
+
+        /** Parses a gradient, returning false if it has fewer than two stops. */
+        bool parse (const juce::String& s)
+        {
+            const auto type = s.upToFirstOccurrenceOf("(", false, false).trim();
+            auto args = juce::StringArray::fromTokens(s.fromFirstOccurrenceOf("(", false, false)
+                                                       .upToLastOccurrenceOf(")", false, false), ",", "");
+            args.trim();
+
+            radial = type == "radial";
+            angle = 0.0f;
+            stops.clear();
+
+            if (!radial && args.size() > 0)
+            {
+                angle = juce::degreesToRadians(args[0].getFloatValue());
+                args.remove(0);
+            }
+
+            for (int i = 0; i < args.size(); ++i)
+            {
+                const auto tokens = juce::StringArray::fromTokens(args[i], false);
+
+                if (tokens.isEmpty())
+                    continue;
+
+                const double spread = args.size() > 1 ? (double) i / (double) (args.size() - 1) : 0.0;
+                stops.push_back({ tokens.size() > 1 ? tokens[1].getDoubleValue() : spread,
+                                  juce::Colour::fromString(tokens[0]) });
+            }
+
+            return stops.size() >= 2;
+        }
+
+        /** Returns the gradient laid over the given area. */
+        juce::ColourGradient createFor (juce::Rectangle<float> area) const
+        {
+            juce::ColourGradient gradient;
+            const auto centre = area.getCentre();
+
+            gradient.isRadial = radial;
+            gradient.point1 = centre;
+
+            if (radial)
+            {
+                gradient.point2 = area.getBottomRight();
+            }
+            else
+            {
+                // Long enough that the ends of the line pass through the corners.
+                const juce::Point<float> direction (std::sin(angle), -std::cos(angle));
+                const float halfLength = std::abs(area.getWidth() * 0.5f * direction.x)
+                                       + std::abs(area.getHeight() * 0.5f * direction.y);
+
+                gradient.point1 = centre - direction * halfLength;
+                gradient.point2 = centre + direction * halfLength;
+            }
+
+            for (const auto& [position, colour] : stops)
+                gradient.addColour(juce::jlimit(0.0, 1.0, position), colour);
+
+            return gradient;
+        }
+    };
+
+    //==============================================================================
+    /** The ViewStyle struct holds the typed, already-parsed values of the style
+        properties read by the core views.
+
+        A View populates its style as properties are set, so paint and layout
+        flushes read plain members rather than looking strings up in, and parsing
+        values out of, a NamedValueSet. Properties which aren't listed here are
+        kept in the View's props as before.
+     */
+    struct ViewStyle
+    {
+        //==============================================================================
+        /** Applies a property to the style, returning false if the property isn't a
+            style property, in which case the style is left untouched.
+         */
+        bool set (const juce::Identifier& name, const juce::var& value)
+        {
+            const auto& table = getPropertyTable();
+            const auto it = table.find(name);
+
+            if (it == table.end())
+                return false;
+
+            switch (it->second)
+            {
+                case Property::Opacity:
+                    opacity = (float) value;
+                    break;
+                case Property::TransformRotate:
+                    rotation = (double) value;
+                    updateTransform();
+                    break;
+                case Property::TransformScale:
+                    scale = (float) value;
+                    updateTransform();
+                    break;
+                case Property::TransformScaleX:
+                    scaleX = (float) value;
+                    updateTransform();
+                    break;
+                case Property::TransformScaleY:
+                    scaleY = (float) value;
+                    updateTransform();
+                    break;
+                case Property::TransformSkewX:
+                    skewX = (double) value;
+                    updateTransform();
+                    break;
+                case Property::TransformSkewY:
+                    skewY = (double) value;
+                    updateTransform();
+                    break;
+                case Property::TransformTranslateX:
+                    translateX = (float) value;
+                    updateTransform();
+                    break;
+                case Property::TransformTranslateY:
+                    translateY = (float) value;
+                    updateTransform();
+                    break;
+                case Property::BorderPath:
+                    hasBorderPath = true;
+                    borderPath = juce::Drawable::parseSVGPath(value.toString());
+                    break;
+                case Property::BorderColor:
+                    hasBorderColour = true;
+                    borderColour = parseColourValue(value);
+                    break;
+                case Property::BorderWidth:
+                    hasBorderWidth = true;
+                    borderWidth = (float) value;
+                    break;
+                case Property::BorderRadius:
+                    borderRadius = parseLengthValue(value, false);
+                    break;
+                case Property::Rasterize:
+                    rasterize = (bool) value;
+                    break;
+                case Property::BackgroundColor:
+                    hasBackgroundColour = true;
+                    backgroundColour = parseColourValue(value);
+                    break;
+                case Property::BackgroundGradient:
+                    hasBackgroundGradient = backgroundGradient.parse(value.toString());
+                    break;
+                case Property::BoxShadow:
+                {
+                    // <colour> <radius> <x offset> <y offset>
+                    const auto tokens = juce::StringArray::fromTokens(value.toString(), false);
+
+                    hasBoxShadow = tokens.size() >= 2;
+                    boxShadow = juce::DropShadow(juce::Colour::fromString(tokens[0]),
+                                                 juce::jmax(1, tokens[1].getIntValue()),
+                                                 { tokens[2].getIntValue(), tokens[3].getIntValue() });
+                    break;
+                }
+                case Property::Color:
+                    textColour = parseColourValue(value);
+                    break;
+                case Property::FontSize:
+                    fontSize = (float) value;
+                    break;
+                case Property::FontStyle:
+                    fontStyle = (int) value;
+                    break;
+                case Property::FontFamily:
+                    fontFamily = value.toString();
+                    break;
+                case Property::KerningFactor:
+                    kerningFactor = (float) value;
+                    break;
+                case Property::LineSpacing:
+                    lineSpacing = (float) value;
+                    break;
+                case Property::Justification:
+                    justification = (int) value;
+                    break;
+                case Property::WordWrap:
+                    hasWordWrap = true;
+                    wordWrap = (int) value;
+                    break;
+                case Property::Placement:
+                    hasPlacement = true;
+                    placement = (int) value;
+                    break;
+            }
+
+            return true;
+        }
+
+        /** Returns true if the given property is held by the ViewStyle. */
+        static bool isStyleProperty (const juce::Identifier& name)
+        {
+            const auto& table = getPropertyTable();
+            return table.find(name) != table.end();
+        }
+
+        /** Returns true if the given property is part of the view's transform. */
+        static bool isTransformProperty (const juce::Identifier& name)
+        {
+            return name == IDs::transformRotate
+                || name == IDs::transformScale
+                || name == IDs::transformScaleX
+                || name == IDs::transformScaleY
+                || name == IDs::transformSkewX
+                || name == IDs::transformSkewY
+                || name == IDs::transformTranslateX
+                || name == IDs::transformTranslateY;
+        }
+
+        /** Returns true if the given property changes how the view's border is
+            drawn.
+         */
+        static bool isBorderProperty (const juce::Identifier& name)
+        {
+            return name == IDs::borderPath
+                || name == IDs::borderColor
+                || name == IDs::borderWidth
+                || name == IDs::borderRadius;
+        }
+
+        //==============================================================================
+        // View
+        float opacity = 1.0f;
+
+        // Vector content, i.e. borders and drawables, is rendered once to an
+        // image at device scale, and blitted on each repaint.
+        bool rasterize = false;
+
+        // Applied about the centre of the view: scale, then skew, then rotation,
+        // then translation. Angles are in radians; `transform-scale` multiplies
+        // both of the axis scales. The composed matrix, about the origin, is
+        // built as the properties are set, so a layout flush only has to move
+        // it to the view's centre.
+        bool hasTransform = false;
+        double rotation = 0.0;
+        float scale = 1.0f;
+        float scaleX = 1.0f;
+        float scaleY = 1.0f;
+        double skewX = 0.0;
+        double skewY = 0.0;
+        float translateX = 0.0f;
+        float translateY = 0.0f;
+        juce::AffineTransform transform;
+
+        bool hasBorderPath = false;
+        juce::Path borderPath;
+
+        bool hasBorderColour = false;
+        juce::Colour borderColour;
+
+        bool hasBorderWidth = false;
+        float borderWidth = 1.0f;
+
+        YGValue borderRadius = { 0.0f, YGUnitUndefined };
+
+        bool hasBackgroundColour = false;
+        juce::Colour backgroundColour;
+
+        // Painted over the background colour.
+        bool hasBackgroundGradient = false;
+        GradientStyle backgroundGradient;
+
+        // Cast by the view's border shape, `<colour> <radius> <x offset> <y offset>`.
+        bool hasBoxShadow = false;
+        juce::DropShadow boxShadow;
+
+        // TextView
+        juce::Colour textColour { 0xff000000 };
+        float fontSize = 12.0f;
+        int fontStyle = 0;
+        juce::String fontFamily;
+        float kerningFactor = 0.0f;
+        float lineSpacing = 1.0f;
+        int justification = 1;
+
+        bool hasWordWrap = false;
+        int wordWrap = 1;
+
+        // ImageView
+        bool hasPlacement = false;
+        int placement = 0;
+
+    private:
+        //==============================================================================
+        void updateTransform()
+        {
+            hasTransform = true;
+            transform = juce::AffineTransform::scale(scale * scaleX, scale * scaleY)
+                            .followedBy(juce::AffineTransform::shear((float) std::tan(skewX), (float) std::tan(skewY)))
+                            .rotated((float) rotation)
+                            .translated(translateX, translateY);
+        }
+
+        //==============================================================================
+        enum class Property
+        {
+            Opacity,
+            TransformRotate,
+            TransformScale,
+            TransformScaleX,
+            TransformScaleY,
+            TransformSkewX,
+            TransformSkewY,
+            TransformTranslateX,
+            TransformTranslateY,
+            BorderPath,
+            BorderColor,
+            BorderWidth,
+            BorderRadius,
+            Rasterize,
+            BackgroundColor,
+            BackgroundGradient,
+            BoxShadow,
+            Color,
+            FontSize,
+            FontStyle,
+            FontFamily,
+            KerningFactor,
+            LineSpacing,
+            Justification,
+            WordWrap,
+            Placement,
+        };
+
+        static const std::unordered_map<juce::Identifier, Property, IdentifierHash>& getPropertyTable()
+        {
+            static const std::unordered_map<juce::Identifier, Property, IdentifierHash> table {
+                { IDs::opacity,             Property::Opacity },
+                { IDs::transformRotate,     Property::TransformRotate },
+                { IDs::transformScale,      Property::TransformScale },
+                { IDs::transformScaleX,     Property::TransformScaleX },
+                { IDs::transformScaleY,     Property::TransformScaleY },
+                { IDs::transformSkewX,      Property::TransformSkewX },
+                { IDs::transformSkewY,      Property::TransformSkewY },
+                { IDs::transformTranslateX, Property::TransformTranslateX },
+                { IDs::transformTranslateY, Property::TransformTranslateY },
+                { IDs::borderPath,          Property::BorderPath },
+                { IDs::borderColor,         Property::BorderColor },
+                { IDs::borderWidth,         Property::BorderWidth },
+                { IDs::borderRadius,        Property::BorderRadius },
+                { IDs::rasterize,           Property::Rasterize },
+                { IDs::backgroundColor,     Property::BackgroundColor },
+                { IDs::backgroundGradient,  Property::BackgroundGradient },
+                { IDs::boxShadow,           Property::BoxShadow },
+                { IDs::color,               Property::Color },
+                { IDs::fontSize,            Property::FontSize },
+                { IDs::fontStyle,           Property::FontStyle },
+                { IDs::fontFamily,          Property::FontFamily },
+                { IDs::kerningFactor,       Property::KerningFactor },
+                { IDs::lineSpacing,         Property::LineSpacing },
+                { IDs::justification,       Property::Justification },
+                { IDs::wordWrap,            Property::WordWrap },
+                { IDs::placement,           Property::Placement },
+            };
+
+            return table;
+        }
+    };
+
+}
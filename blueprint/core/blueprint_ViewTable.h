@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    blueprint_ViewTable.h
+    Created: 14 Oct 2026 11:02:15am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_ShadowView.h"
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    struct ViewType;
+
+    //==============================================================================
+    /** The ViewTable owns the View and ShadowView pairs of a ReactApplicationRoot
+        and allocates their ids.
+
+        Entries are held side by side in a dense vector. A ViewId encodes the slot
+        index of its entry in the low bits and the slot's generation in the high
+        bits, so a lookup is a bounds check, an index and a generation compare. When
+        an entry is removed its slot is recycled with the next generation, and a
+        slot which has used up every generation is retired rather than wrapping
+        round, which means a stale id held by JavaScript can never alias a newer
+        view.
+     */
+    class ViewTable
+    {
+    public:
+        //==============================================================================
+        struct Entry
+        {
+            std::unique_ptr<View> view;
+            std::unique_ptr<ShadowView> shadowView;
+            ViewId generation = 0;
+
+            // The registered type the view was created as, if any.
+            ViewType* type = nullptr;
+        };
+
+        //==============================================================================
+        static constexpr int slotBits = 20;
+        static constexpr ViewId slotMask = (1 << slotBits) - 1;
+        static constexpr ViewId generationMask = (1 << (31 - slotBits)) - 1;
+
+        /** Slot zero is reserved for the root view, which the table doesn't own. */
+        static constexpr ViewId rootViewId = (1 << slotBits) | 0;
+
+        //==============================================================================
+        ViewTable()
+        {
+            entries.emplace_back();
+            entries[0].generation = 1;
+        }
+
+        //==============================================================================
+        /** Takes ownership of a view and its (possibly null) shadow view, assigning
+            the view its new id.
+         */
+        ViewId add (std::unique_ptr<View> view, std::unique_ptr<ShadowView> shadowView, ViewType* type = nullptr)
+        {
+            size_t slot = entries.size();
+
+            if (freeSlots.empty())
+            {
+                entries.emplace_back();
+            }
+            else
+            {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+
+            // If you hit this you've got more than a million live views, which is
+            // probably a bug rather than a very large interface.
+            jassert (slot <= static_cast<size_t>(slotMask));
+
+            auto& entry = entries[slot];
+
+            // Generation zero is never used, so that no valid id is ever zero,
+            // and a free slot always has a generation left.
+            jassert (entry.generation < generationMask);
+            ++entry.generation;
+
+            const ViewId id = (entry.generation << slotBits) | static_cast<ViewId>(slot);
+
+            view->setViewId(id);
+            entry.view = std::move(view);
+            entry.shadowView = std::move(shadowView);
+            entry.type = type;
+
+            ++numEntries;
+            return id;
+        }
+
+        /** Returns the entry for the given id, or nullptr if there's no such live view. */
+        Entry* find (ViewId id)
+        {
+            const auto slot = static_cast<size_t>(id & slotMask);
+
+            if (slot < entries.size())
+            {
+                auto& entry = entries[slot];
+
+                if (entry.view != nullptr && entry.generation == ((id >> slotBits) & generationMask))
+                    return &entry;
+            }
+
+            return nullptr;
+        }
+
+        /** Destroys the view and shadow view with the given id, recycling the slot. */
+        void remove (ViewId id)
+        {
+            if (auto* entry = find(id))
+            {
+                entry->view.reset();
+                entry->shadowView.reset();
+
+                recycle(static_cast<size_t>(id & slotMask));
+                --numEntries;
+            }
+        }
+
+        /** Removes the view and shadow view with the given id from the table,
+            recycling the slot, and hands them back to be destroyed later. Returns
+            an empty entry if there's no such live view.
+         */
+        Entry release (ViewId id)
+        {
+            Entry released;
+
+            if (auto* entry = find(id))
+            {
+                released.view = std::move(entry->view);
+                released.shadowView = std::move(entry->shadowView);
+                released.generation = entry->generation;
+                released.type = entry->type;
+
+                recycle(static_cast<size_t>(id & slotMask));
+                --numEntries;
+            }
+
+            return released;
+        }
+
+        /** Destroys every view in the table.
+
+            Slot generations are retained so that ids handed out before clearing
+            remain invalid afterwards.
+         */
+        void clear()
+        {
+            freeSlots.clear();
+
+            for (size_t i = entries.size(); --i > 0;)
+            {
+                entries[i].view.reset();
+                entries[i].shadowView.reset();
+                recycle(i);
+            }
+
+            numEntries = 0;
+        }
+
+        /** Invokes the callback with (ViewId, Entry&) for each live view. */
+        template <typename Fn>
+        void forEach (Fn&& fn)
+        {
+            for (size_t i = 1; i < entries.size(); ++i)
+            {
+                auto& entry = entries[i];
+
+                if (entry.view != nullptr)
+                    fn((entry.generation << slotBits) | static_cast<ViewId>(i), entry);
+            }
+        }
+
+        /** Returns the number of live views in the table. */
+        size_t size() const { return numEntries; }
+
+    private:
+        //==============================================================================
+        /** Frees a slot for reuse, unless every generation of it has been used,
+            in which case it stays empty for good: reusing it would give a new
+            view an id some stale reference may still hold. Each slot serves
+            2047 views before it's retired, so that's one empty entry for every
+            2047 views created.
+         */
+        void recycle (size_t slot)
+        {
+            if (entries[slot].generation < generationMask)
+                freeSlots.push_back(slot);
+        }
+
+        //==============================================================================
+        std::vector<Entry> entries;
+        std::vector<size_t> freeSlots;
+        size_t numEntries = 0;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ViewTable)
+    };
+
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    blueprint_VirtualListView.cpp
+    Created: 15 Oct 2026 7:12:03am
+
+  ==============================================================================
+*/
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    VirtualListView::VirtualListView()
+    {
+        viewport.setViewedComponent(&content, false);
+        viewport.setScrollBarsShown(true, false);
+        addAndMakeVisible(viewport);
+    }
+
+    //==============================================================================
+    void VirtualListView::setProperty (const juce::Identifier& name, const juce::var& value)
+    {
+        View::setProperty(name, value);
+
+        if (name == IDs::itemCount)
+            itemCount = juce::jmax(0, (int) value);
+        else if (name == IDs::itemHeight)
+            itemHeight = juce::jmax(0.0, (double) value);
+        else if (name == IDs::overscan)
+            overscan = juce::jmax(0, (int) value);
+        else if (name == IDs::scrollbarThumbColor)
+            viewport.getVerticalScrollBar().setColour(juce::ScrollBar::thumbColourId, parseColourValue(value));
+        else if (name != IDs::onVisibleRangeChange)
+            return;
+
+        // Any of these may change which items belong in view, so the next
+        // update reports afresh.
+        rangeReported = false;
+        updateContentSize();
+        updateVisibleRange();
+    }
+
+    void VirtualListView::addChild (View* childView, int index)
+    {
+        content.addChildComponent(childView, index);
+        childView->setVisible(!childView->isHidden());
+    }
+
+    //==============================================================================
+    void VirtualListView::resized()
+    {
+        viewport.setBounds(getLocalBounds());
+        updateContentSize();
+        updateVisibleRange();
+
+        View::resized();
+    }
+
+    void VirtualListView::updateContentSize()
+    {
+        const int height = (int) std::ceil(itemCount * itemHeight);
+        content.setSize(viewport.getMaximumVisibleWidth(), height);
+    }
+
+    void VirtualListView::updateVisibleRange()
+    {
+        if (itemHeight <= 0.0 || !hasEventHandler(VisibleRangeChangeEvent))
+            return;
+
+        const auto area = viewport.getViewArea();
+
+        const int firstInView = juce::jlimit(0, itemCount, (int) std::floor(area.getY() / itemHeight));
+        const int lastInView = juce::jlimit(0, itemCount, (int) std::ceil(area.getBottom() / itemHeight));
+
+        if (rangeReported && reportedRange.contains(juce::Range<int>(firstInView, lastInView)))
+            return;
+
+        rangeReported = true;
+        reportedRange = { juce::jmax(0, firstInView - overscan), juce::jmin(itemCount, lastInView + overscan) };
+
+        if (ReactApplicationRoot* root = getOwningRoot())
+            root->queueVisibleRangeEvent(getViewId(), reportedRange.getStart(), reportedRange.getEnd());
+    }
+
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    blueprint_VirtualListView.h
+    Created: 15 Oct 2026 7:12:03am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_View.h"
+
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The VirtualListView class is a core view for long, scrollable lists of
+        items of a fixed height, of which only those in view are mounted.
+
+        The view scrolls a content area tall enough for all `item-count` items
+        of `item-height` each, but mounts only the children it's given, which
+        the JavaScript side positions absolutely at `index * item-height`. As
+        the list scrolls, the view reports the range of items in view, plus
+        `overscan` items either side, in an `onVisibleRangeChange` event with the
+        first index and one past the last. The JavaScript side then renders the
+        items in that range, and no others.
+
+        To save a render for every row scrolled, the range is reported only once
+        the items in view are no longer all within the range last reported.
+     */
+    class VirtualListView : public View
+    {
+    public:
+        //==============================================================================
+        VirtualListView();
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        /** Mounts the child in the scrolled content area, rather than the view. */
+        void addChild (View* childView, int index = -1) override;
+
+        //==============================================================================
+        void resized() override;
+
+    private:
+        //==============================================================================
+        /** A Viewport which tells the list whenever it scrolls. */
+        class ListViewport : public juce::Viewport
+        {
+        public:
+            explicit ListViewport (VirtualListView& _owner) : owner(_owner) {}
+
+            void visibleAreaChanged (const juce::Rectangle<int>& area) override
+            {
+                owner.updateVisibleRange();
+                owner.scrolledAreaChanged(area.getPosition());
+            }
+
+        private:
+            VirtualListView& owner;
+        };
+
+        //==============================================================================
+        /** Sizes the content area to hold every item. */
+        void updateContentSize();
+
+        /** Reports a new range of items to mount, if the items in view need it. */
+        void updateVisibleRange();
+
+        //==============================================================================
+        ListViewport viewport { *this };
+        juce::Component content;
+
+        int itemCount = 0;
+        double itemHeight = 0.0;
+        int overscan = 4;
+
+        juce::Range<int> reportedRange;
+        bool rangeReported = false;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VirtualListView)
+    };
+
+}
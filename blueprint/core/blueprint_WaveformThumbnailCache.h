@@ -0,0 +1,477 @@
+/*
+  ==============================================================================
+
+    blueprint_WaveformThumbnailCache.h
+    Created: 15 Oct 2026 11:26:09am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "blueprint_CacheManager.h"
+
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_formats
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The WaveformThumbnailCache is a process-wide store of the peak pyramids of
+        audio files, from which WaveformViews paint.
+
+        A pyramid holds the minimum and maximum of each channel over every run of
+        `baseSamplesPerPeak` samples, and above that, levels of half as many
+        peaks again, each the envelope of two below it. Painting at any zoom then
+        reads the level whose peaks are just finer than a pixel, so that the cost
+        of a paint is the same per pixel whether the view shows a second or the
+        whole of a long file.
+
+        Pyramids are built on the cache's thread pool, with `getPyramidAsync`,
+        and shared between every view of the same file. With a cache directory,
+        the base level of each pyramid is also written to disk, and read back
+        rather than rebuilt the next time the same file, unmodified, is opened.
+        Pyramids no view is holding stay cached, within the "waveforms" budget
+        of the CacheManager.
+
+        Hold the cache through a juce::SharedResourcePointer<WaveformThumbnailCache>.
+     */
+    class WaveformThumbnailCache : private CacheManager::Cache
+    {
+    public:
+        //==============================================================================
+        /** The peaks of an audio file at every resolution, from fine to coarse. */
+        struct PeakPyramid
+        {
+            struct Level
+            {
+                int samplesPerPeak = 0;
+
+                // Indexed by channel, then peak.
+                std::vector<std::vector<juce::Range<float>>> peaks;
+            };
+
+            /** Returns the coarsest level with peaks no larger than the given
+                number of samples, or the finest if they're all larger.
+             */
+            const Level& getLevelFor (double samplesPerPixel) const
+            {
+                size_t i = 0;
+
+                while (i + 1 < levels.size() && levels[i + 1].samplesPerPeak <= samplesPerPixel)
+                    ++i;
+
+                return levels[i];
+            }
+
+            /** Returns the envelope of the given channel over a range of samples,
+                read from the given level.
+             */
+            static juce::Range<float> getPeak (const Level& level, int channel, double startSample, double endSample)
+            {
+                const auto& peaks = level.peaks[static_cast<size_t>(channel)];
+                const int numPeaks = (int) peaks.size();
+
+                const int first = juce::jlimit(0, numPeaks, (int) (startSample / level.samplesPerPeak));
+                const int last = juce::jlimit(first, numPeaks, (int) std::ceil(endSample / level.samplesPerPeak));
+
+                if (first >= numPeaks)
+                    return {};
+
+                // A zoom finer than the level leaves a single peak per pixel.
+                auto result = peaks[static_cast<size_t>(first)];
+
+                for (int i = first + 1; i < last; ++i)
+                    result = result.getUnionWith(peaks[static_cast<size_t>(i)]);
+
+                return result;
+            }
+
+            int getNumChannels() const { return levels.empty() ? 0 : (int) levels[0].peaks.size(); }
+
+            /** Returns the bytes the peaks take. */
+            size_t getNumBytes() const
+            {
+                size_t numPeaks = 0;
+
+                for (const auto& level : levels)
+                    for (const auto& channel : level.peaks)
+                        numPeaks += channel.size();
+
+                return numPeaks * sizeof(juce::Range<float>);
+            }
+
+            juce::int64 lengthInSamples = 0;
+            double sampleRate = 44100.0;
+            std::vector<Level> levels;
+        };
+
+        using PyramidHandle = std::shared_ptr<const PeakPyramid>;
+
+        /** Called on the message thread with a pyramid, or nullptr if the file
+            couldn't be read.
+         */
+        using Callback = std::function<void (PyramidHandle)>;
+
+        WaveformThumbnailCache()
+        {
+            formatManager.registerBasicFormats();
+        }
+
+        ~WaveformThumbnailCache()
+        {
+            // The builders use the cache, so they stop first.
+            pool.removeAllJobs(true, -1);
+        }
+
+        //==============================================================================
+        /** Calls back with the pyramid of the given file, a path or `file://` URL,
+            building or loading it on the thread pool if needed.
+         */
+        void getPyramidAsync (const juce::String& source, Callback callback)
+        {
+            const auto file = getFile(source);
+            const auto key = file.getFullPathName();
+
+            PyramidHandle cached;
+
+            {
+                const juce::ScopedLock sl (lock);
+
+                auto it = pyramids.find(key);
+
+                if (it != pyramids.end() && it->second.modificationTime == file.getLastModificationTime())
+                {
+                    it->second.lastUse = ++useCounter;
+                    cached = it->second.pyramid;
+                }
+                else
+                {
+                    const bool building = pending.find(key) != pending.end();
+                    pending[key].push_back(std::move(callback));
+
+                    if (building)
+                        return;
+                }
+            }
+
+            if (cached != nullptr)
+                return callback(cached);
+
+            pool.addJob([this, file, key]() {
+                const auto modificationTime = file.getLastModificationTime();
+                PyramidHandle pyramid (loadOrBuild(file));
+                std::vector<Callback> callbacks;
+
+                {
+                    const juce::ScopedLock sl (lock);
+
+                    if (pyramid != nullptr)
+                    {
+                        const size_t numBytes = pyramid->getNumBytes();
+                        pyramids[key] = { pyramid, modificationTime, numBytes, ++useCounter };
+
+                        if (budget.added(numBytes))
+                            trim(budget.budgetBytes);
+                    }
+
+                    callbacks = std::move(pending[key]);
+                    pending.erase(key);
+                }
+
+                juce::MessageManager::callAsync([callbacks, pyramid]() {
+                    for (auto& cb : callbacks)
+                        cb(pyramid);
+                });
+            });
+        }
+
+        //==============================================================================
+        /** Sets a directory in which to keep each pyramid's base level between
+            sessions, or none for an invalid file.
+         */
+        void setCacheDirectory (const juce::File& directory)
+        {
+            const juce::ScopedLock sl (lock);
+            cacheDirectory = directory;
+        }
+
+        /** Drops every cached pyramid that no view is currently holding. */
+        void purgeUnused()
+        {
+            const juce::ScopedLock sl (lock);
+            trim(0);
+        }
+
+        //==============================================================================
+        // Fine enough to show the shape of a waveform at any sensible zoom, coarse
+        // enough that the pyramid of a long file stays a few megabytes.
+        static constexpr int baseSamplesPerPeak = 64;
+
+    private:
+        //==============================================================================
+        struct Entry
+        {
+            PyramidHandle pyramid;
+            juce::Time modificationTime;
+            size_t numBytes;
+            juce::uint64 lastUse;
+
+            bool isUnused() const { return pyramid.use_count() == 1; }
+        };
+
+        static juce::File getFile (const juce::String& source)
+        {
+            if (source.startsWith("file://"))
+                return juce::URL(source).getLocalFile();
+
+            return juce::File::isAbsolutePath(source) ? juce::File(source) : juce::File();
+        }
+
+        //==============================================================================
+        CacheManager::Stats getCacheStats() override
+        {
+            const juce::ScopedLock sl (lock);
+            CacheManager::Stats stats;
+
+            for (const auto& p : pyramids)
+                stats.add(p.second);
+
+            stats.budgetBytes = budget.budgetBytes;
+            return stats;
+        }
+
+        void setCacheBudget (size_t numBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+
+            budget.budgetBytes = numBytes;
+            trim(numBytes);
+        }
+
+        void trimCache (size_t maxUnusedBytes) override
+        {
+            const juce::ScopedLock sl (lock);
+            trim(maxUnusedBytes);
+        }
+
+        void trim (size_t maxUnusedBytes)
+        {
+            CacheManager::LruEviction eviction;
+            eviction.add(pyramids);
+            eviction.evictTo(maxUnusedBytes);
+            budget.trimmed();
+        }
+
+        //==============================================================================
+        std::unique_ptr<PeakPyramid> loadOrBuild (const juce::File& file)
+        {
+            if (!file.existsAsFile())
+                return nullptr;
+
+            const auto cacheFile = getCacheFile(file);
+
+            if (cacheFile.existsAsFile())
+            {
+                juce::FileInputStream in (cacheFile);
+
+                if (auto pyramid = read(in))
+                    return pyramid;
+            }
+
+            std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor(file));
+
+            if (reader == nullptr)
+            {
+                DBG("Failed to read audio file: " << file.getFullPathName());
+                return nullptr;
+            }
+
+            auto pyramid = build(*reader);
+
+            if (pyramid != nullptr && cacheFile != juce::File())
+            {
+                cacheFile.getParentDirectory().createDirectory();
+
+                juce::FileOutputStream out (cacheFile);
+
+                if (out.openedOk())
+                {
+                    out.setPosition(0);
+                    out.truncate();
+                    write(*pyramid, out);
+                }
+            }
+
+            return pyramid;
+        }
+
+        /** Names the cache file after the audio file's path, size and modification
+            time, so that an edited file never reads a stale pyramid.
+         */
+        juce::File getCacheFile (const juce::File& file)
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (cacheDirectory == juce::File())
+                return {};
+
+            const auto identity = file.getFullPathName()
+                                + juce::String(file.getSize())
+                                + juce::String(file.getLastModificationTime().toMilliseconds());
+
+            return cacheDirectory.getChildFile(juce::String::toHexString(identity.hashCode64()) + ".peaks");
+        }
+
+        /** Reads the file through once, into the base level, then builds the
+            levels above from that.
+         */
+        static std::unique_ptr<PeakPyramid> build (juce::AudioFormatReader& reader)
+        {
+            const int numChannels = juce::jmax(1, (int) reader.numChannels);
+            const int blockSize = baseSamplesPerPeak * 1024;
+
+            auto pyramid = std::make_unique<PeakPyramid>();
+            pyramid->lengthInSamples = reader.lengthInSamples;
+            pyramid->sampleRate = reader.sampleRate;
+
+            PeakPyramid::Level base;
+            base.samplesPerPeak = baseSamplesPerPeak;
+            base.peaks.resize(static_cast<size_t>(numChannels));
+
+            const auto numPeaks = static_cast<size_t>((reader.lengthInSamples + baseSamplesPerPeak - 1) / baseSamplesPerPeak);
+
+            for (auto& channel : base.peaks)
+                channel.reserve(numPeaks);
+
+            juce::AudioBuffer<float> buffer (numChannels, blockSize);
+
+            for (juce::int64 pos = 0; pos < reader.lengthInSamples; pos += blockSize)
+            {
+                const int num = (int) juce::jmin((juce::int64) blockSize, reader.lengthInSamples - pos);
+
+                if (!reader.read(&buffer, 0, num, pos, true, true))
+                    return nullptr;
+
+                for (int c = 0; c < numChannels; ++c)
+                    for (int i = 0; i < num; i += baseSamplesPerPeak)
+                        base.peaks[static_cast<size_t>(c)].push_back(
+                            juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(c, i), juce::jmin(baseSamplesPerPeak, num - i)));
+            }
+
+            pyramid->levels.push_back(std::move(base));
+            buildLevels(*pyramid);
+
+            return pyramid;
+        }
+
+        /** Halves each level into the next, until a level would fit a few pixels. */
+        static void buildLevels (PeakPyramid& pyramid)
+        {
+            while (pyramid.levels.back().peaks[0].size() > minPeaksPerLevel)
+            {
+                const auto& below = pyramid.levels.back();
+
+                PeakPyramid::Level level;
+                level.samplesPerPeak = below.samplesPerPeak * 2;
+                level.peaks.resize(below.peaks.size());
+
+                for (size_t c = 0; c < below.peaks.size(); ++c)
+                {
+                    const auto& src = below.peaks[c];
+                    auto& dest = level.peaks[c];
+
+                    dest.reserve((src.size() + 1) / 2);
+
+                    for (size_t i = 0; i < src.size(); i += 2)
+                        dest.push_back(i + 1 < src.size() ? src[i].getUnionWith(src[i + 1]) : src[i]);
+                }
+
+                pyramid.levels.push_back(std::move(level));
+            }
+        }
+
+        //==============================================================================
+        static void write (const PeakPyramid& pyramid, juce::OutputStream& out)
+        {
+            const auto& base = pyramid.levels[0];
+
+            out.writeInt(fileMagic);
+            out.writeInt(baseSamplesPerPeak);
+            out.writeInt(pyramid.getNumChannels());
+            out.writeInt64(pyramid.lengthInSamples);
+            out.writeDouble(pyramid.sampleRate);
+            out.writeInt64((juce::int64) base.peaks[0].size());
+
+            for (const auto& channel : base.peaks)
+                out.write(channel.data(), channel.size() * sizeof(juce::Range<float>));
+        }
+
+        static std::unique_ptr<PeakPyramid> read (juce::InputStream& in)
+        {
+            if (in.readInt() != fileMagic || in.readInt() != baseSamplesPerPeak)
+                return nullptr;
+
+            const int numChannels = in.readInt();
+            auto pyramid = std::make_unique<PeakPyramid>();
+            pyramid->lengthInSamples = in.readInt64();
+            pyramid->sampleRate = in.readDouble();
+
+            const auto numPeaks = in.readInt64();
+            const auto numBytes = static_cast<size_t>(numPeaks) * sizeof(juce::Range<float>);
+
+            if (numChannels < 1 || numPeaks < 1 || in.getNumBytesRemaining() != (juce::int64) numBytes * numChannels)
+                return nullptr;
+
+            PeakPyramid::Level base;
+            base.samplesPerPeak = baseSamplesPerPeak;
+            base.peaks.resize(static_cast<size_t>(numChannels));
+
+            for (auto& channel : base.peaks)
+            {
+                channel.resize(static_cast<size_t>(numPeaks));
+
+                if (in.read(channel.data(), (int) numBytes) != (int) numBytes)
+                    return nullptr;
+            }
+
+            pyramid->levels.push_back(std::move(base));
+            buildLevels(*pyramid);
+
+            return pyramid;
+        }
+
+        //==============================================================================
+        static constexpr size_t minPeaksPerLevel = 64;
+
+        // The pyramids of a session's worth of files no view is showing.
+        static constexpr size_t defaultBudgetBytes = 32 * 1024 * 1024;
+
+        static constexpr int fileMagic = 0x4b504242; // "BBPK"
+
+        juce::CriticalSection lock;
+        std::map<juce::String, Entry> pyramids;
+        std::map<juce::String, std::vector<Callback>> pending;
+        juce::File cacheDirectory;
+
+        CacheManager::Budget budget { defaultBudgetBytes };
+        juce::uint64 useCounter = 0;
+
+        juce::AudioFormatManager formatManager;
+        juce::ThreadPool pool { 2 };
+
+        CacheManager::Registration registration { "waveforms", *this };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveformThumbnailCache)
+    };
+
+}
+
+#endif
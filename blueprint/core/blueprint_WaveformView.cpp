@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    blueprint_WaveformView.cpp
+    Created: 15 Oct 2026 11:26:09am
+
+  ==============================================================================
+*/
+
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_formats
+
+namespace blueprint
+{
+
+    //==============================================================================
+    void WaveformView::setProperty (const juce::Identifier& name, const juce::var& v)
+    {
+        View::setProperty(name, v);
+
+        if (name == IDs::source)
+            setSource(v.toString());
+        else if (name == IDs::viewStart)
+            viewStart = juce::jmax(0.0, (double) v);
+        else if (name == IDs::viewDuration)
+            viewDuration = juce::jmax(0.0, (double) v);
+        else if (name == IDs::lineColor)
+            lineColour = parseColourValue(v);
+    }
+
+    //==============================================================================
+    void WaveformView::paint (juce::Graphics& g)
+    {
+        BLUEPRINT_TRACE_SCOPE("WaveformView::paint", getViewId());
+        const ScopedPaintTimer paintTimer (*this, "WaveformView");
+
+        View::paint(g);
+
+        const int width = getWidth();
+        const int numChannels = pyramid != nullptr ? pyramid->getNumChannels() : 0;
+
+        if (numChannels == 0 || width < 1 || getHeight() < 1)
+            return;
+
+        const double sampleRate = pyramid->sampleRate;
+        const double duration = viewDuration > 0.0 ? viewDuration : (double) pyramid->lengthInSamples / sampleRate;
+        const double samplesPerPixel = duration * sampleRate / width;
+        const double firstSample = viewStart * sampleRate;
+
+        if (samplesPerPixel <= 0.0)
+            return;
+
+        // Whatever the zoom, each column reads about two peaks of this level.
+        const auto& level = pyramid->getLevelFor(samplesPerPixel);
+        const float laneHeight = (float) getHeight() / (float) numChannels;
+
+        // Only the columns in the clip need reading.
+        const auto clip = g.getClipBounds().getIntersection(getLocalBounds());
+        juce::RectangleList<float> columns;
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            const float centreY = laneHeight * ((float) c + 0.5f);
+            const float halfHeight = laneHeight * 0.5f;
+
+            for (int x = clip.getX(); x < clip.getRight(); ++x)
+            {
+                const double start = firstSample + x * samplesPerPixel;
+
+                if (start >= (double) pyramid->lengthInSamples)
+                    break;
+
+                const auto peak = WaveformThumbnailCache::PeakPyramid::getPeak(level, c, start, start + samplesPerPixel);
+
+                const float top = centreY - juce::jlimit(-1.0f, 1.0f, peak.getEnd()) * halfHeight;
+                const float bottom = centreY - juce::jlimit(-1.0f, 1.0f, peak.getStart()) * halfHeight;
+
+                // A silent stretch still draws a hairline.
+                columns.addWithoutMerging({ (float) x, top, 1.0f, juce::jmax(1.0f, bottom - top) });
+            }
+        }
+
+        g.setColour(lineColour);
+        g.fillRectList(columns);
+    }
+
+    //==============================================================================
+    void WaveformView::setSource (const juce::String& source)
+    {
+        // Any build still running for a previous source is now stale.
+        const auto generation = ++sourceGeneration;
+        pyramid = nullptr;
+
+        if (source.isEmpty())
+            return repaint();
+
+        juce::Component::SafePointer<WaveformView> safeThis (this);
+
+        thumbnailCache->getPyramidAsync(source, [safeThis, generation](WaveformThumbnailCache::PyramidHandle p) {
+            if (safeThis == nullptr || safeThis->sourceGeneration != generation || p == nullptr)
+                return;
+
+            safeThis->pyramid = std::move(p);
+            safeThis->queueLoadEvent((float) ((double) safeThis->pyramid->lengthInSamples / safeThis->pyramid->sampleRate),
+                                     (float) safeThis->pyramid->getNumChannels());
+            safeThis->repaint();
+        });
+    }
+
+}
+
+#endif
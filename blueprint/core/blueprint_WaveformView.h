@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    blueprint_WaveformView.h
+    Created: 15 Oct 2026 11:26:09am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "blueprint_View.h"
+#include "blueprint_WaveformThumbnailCache.h"
+
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_formats
+
+namespace blueprint
+{
+
+    //==============================================================================
+    /** The WaveformView class is a core view which draws the waveform of an audio
+        file, however long, without its samples ever reaching JavaScript.
+
+        `source` is the file's path, or a `file://` URL. Its peak pyramid comes
+        from the shared WaveformThumbnailCache, built in the background, after
+        which the view fires `onLoad` with the file's duration in seconds and its
+        number of channels.
+
+        The view shows `view-duration` seconds from `view-start`, or the whole
+        file without a duration, so that React zooms and scrolls by setting
+        those two. Each channel takes an equal lane, filled with `line-color`
+        between the minimum and maximum under each pixel column.
+     */
+    class WaveformView : public View
+    {
+    public:
+        //==============================================================================
+        WaveformView() = default;
+
+        //==============================================================================
+        void setProperty (const juce::Identifier& name, const juce::var& value) override;
+
+        //==============================================================================
+        void paint (juce::Graphics& g) override;
+
+    private:
+        //==============================================================================
+        void setSource (const juce::String& source);
+
+        //==============================================================================
+        juce::SharedResourcePointer<WaveformThumbnailCache> thumbnailCache;
+        WaveformThumbnailCache::PyramidHandle pyramid;
+        juce::uint32 sourceGeneration = 0;
+
+        double viewStart = 0.0;
+        double viewDuration = 0.0;
+        juce::Colour lineColour { 0xff66fdcf };
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveformView)
+    };
+
+}
+
+#endif
@@ -2986,6 +2986,9 @@ typedef struct duk_hthread duk_context;
 
 /* __OVERRIDE_DEFINES__ */
 
+/* Blueprint: see duk_config_blueprint.h. */
+#include "duk_config_blueprint.h"
+
 /*
  *  Conditional includes
  */
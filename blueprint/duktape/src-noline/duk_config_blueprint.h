@@ -0,0 +1,63 @@
+/*
+ *  Blueprint's overrides, applied at the end of the stock duk_config.h.
+ *
+ *  With BLUEPRINT_DUKTAPE_PERFORMANCE_PROFILE enabled, this applies the part
+ *  of config/examples/blueprint.yaml which only affects how Duktape is
+ *  compiled, and not its built-in objects, so it's safe to apply without
+ *  rerunning configure.py. Keep the two in step.
+ */
+
+#if !defined(DUK_CONFIG_BLUEPRINT_H_INCLUDED)
+#define DUK_CONFIG_BLUEPRINT_H_INCLUDED
+
+#if !defined(BLUEPRINT_SCRIPT_WATCHDOG)
+#define BLUEPRINT_SCRIPT_WATCHDOG 1
+#endif
+
+#if defined(BLUEPRINT_DUKTAPE_PERFORMANCE_PROFILE) && BLUEPRINT_DUKTAPE_PERFORMANCE_PROFILE
+
+#undef DUK_USE_PREFER_SIZE
+#undef DUK_USE_PACKED_TVAL
+
+/* Fastint needs 64-bit integer arithmetic, which nearly every platform has. */
+#if defined(DUK_USE_64BIT_OPS)
+#define DUK_USE_FASTINT
+#endif
+
+#define DUK_USE_JSON_STRINGIFY_FASTPATH
+
+#undef DUK_USE_DEBUGGER_SUPPORT
+
+/* The watchdog needs the interrupt counter; without it we can drop it. */
+#if !BLUEPRINT_SCRIPT_WATCHDOG
+#undef DUK_USE_INTERRUPT_COUNTER
+#endif
+
+#undef DUK_USE_MARK_AND_SWEEP_RECLIMIT
+#define DUK_USE_MARK_AND_SWEEP_RECLIMIT 1024
+
+#undef DUK_USE_STRTAB_MINSIZE
+#define DUK_USE_STRTAB_MINSIZE 4096
+
+#undef DUK_USE_LITCACHE_SIZE
+#define DUK_USE_LITCACHE_SIZE 1024
+
+#endif  /* BLUEPRINT_DUKTAPE_PERFORMANCE_PROFILE */
+
+/*
+ *  The script watchdog: the interpreter asks the root's ScriptWatchdog, every
+ *  few hundred thousand instructions, whether to abort the running call.
+ */
+#if BLUEPRINT_SCRIPT_WATCHDOG
+
+#define DUK_USE_INTERRUPT_COUNTER
+#define DUK_USE_EXEC_TIMEOUT_CHECK(udata) blueprint_exec_timeout_check((udata))
+
+#if defined(__cplusplus)
+extern "C"
+#endif
+duk_bool_t blueprint_exec_timeout_check(void *udata);
+
+#endif  /* BLUEPRINT_SCRIPT_WATCHDOG */
+
+#endif  /* DUK_CONFIG_BLUEPRINT_H_INCLUDED */
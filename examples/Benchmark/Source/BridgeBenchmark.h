@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    BridgeBenchmark.h
+    Created: 15 Oct 2026 4:40:09pm
+
+    Micro-benchmarks of the bridge between JavaScript and the native tree:
+    the __BlueprintNative__ calls the reconciler makes, registered native
+    methods and functions, and events dispatched into JavaScript, each with a
+    range of payloads, bulk lists both as plain values and as CBOR. Results
+    come out as JSON, for tracking across releases.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+//==============================================================================
+class BridgeBenchmark
+{
+public:
+    //==============================================================================
+    /** Runs every case the given number of times, each a batch of calls. */
+    explicit BridgeBenchmark (int _numBatches, int _callsPerBatch = 10000)
+        : numBatches (jmax (1, _numBatches)), callsPerBatch (jmax (1, _callsPerBatch)) {}
+
+    /** Runs the benchmarks, returning the results as a JSON object. */
+    var run()
+    {
+        auto* results = new DynamicObject();
+        Array<var> cases;
+
+        // JavaScript calling into the native tree
+        cases.add (runScriptCase ("createViewInstance", "none", "B.createViewInstance('View');"));
+        cases.add (runScriptCase ("setViewProperty", "int", "B.setViewProperty(viewId, 'width', i);"));
+        cases.add (runScriptCase ("setViewProperty", "string", "B.setViewProperty(viewId, 'background-color', (i % 2) ? 'ff000000' : 'ffffffff');"));
+        cases.add (runScriptCase ("setViewProperty", "object", "B.setViewProperty(viewId, 'benchmark-data', nestedPayload);"));
+        cases.add (runScriptCase ("setViewProperties", "object", "B.setViewProperties(viewId, { 'width': i, 'height': i, 'opacity': 0.5, 'background-color': 'ff202020' });"));
+        cases.add (runScriptCase ("addChild", "none", "B.addChild(containerId, childIds[i]);",
+                                  "var childIds = []; for (var k = 0; k < N; ++k) childIds.push(B.createViewInstance('View'));"));
+        cases.add (runScriptCase ("registerNativeMethod", "int", "B.benchmarkMethod(i);"));
+        cases.add (runScriptCase ("registerNativeMethod", "string", "B.benchmarkMethod('payload ' + (i % 16));"));
+
+        // Native code dispatching into JavaScript
+        DynamicObject::Ptr nested = new DynamicObject();
+        nested->setProperty ("x", 12.5);
+        nested->setProperty ("y", 40);
+        nested->setProperty ("label", "pointer");
+        nested->setProperty ("modifiers", Array<var> { true, false, "shift" });
+
+        const var nestedPayload (nested.get());
+        const Identifier eventType ("benchmark");
+
+        cases.add (runDispatchCase ("dispatchViewEvent", "int", [=] (Root& root, ViewId viewId, int i) { root.dispatchViewEvent (viewId, eventType, i); }));
+        cases.add (runDispatchCase ("dispatchViewEvent", "string", [=] (Root& root, ViewId viewId, int) { root.dispatchViewEvent (viewId, eventType, String ("payload")); }));
+        cases.add (runDispatchCase ("dispatchViewEvent", "object", [=] (Root& root, ViewId viewId, int) { root.dispatchViewEvent (viewId, eventType, nestedPayload); }));
+        cases.add (runDispatchCase ("dispatchEvent", "int", [=] (Root& root, ViewId, int i) { root.dispatchEvent (eventType, i); }));
+        cases.add (runDispatchCase ("dispatchEvent", "string", [=] (Root& root, ViewId, int) { root.dispatchEvent (eventType, String ("payload")); }));
+        cases.add (runDispatchCase ("dispatchEvent", "object", [=] (Root& root, ViewId, int) { root.dispatchEvent (eventType, nestedPayload); }));
+
+        // Bulk payloads, pushed a value at a time and by way of CBOR
+        const var list = createListPayload();
+        const int listCalls = jmax (1, callsPerBatch / 100);
+
+        cases.add (runDispatchCase ("dispatchEvent", "list1k", [=] (Root& root, ViewId, int) { root.dispatchEvent (eventType, list); }, listCalls));
+        cases.add (runDispatchCase ("dispatchEvent", "list1kCbor", [=] (Root& root, ViewId, int) { root.dispatchEvent (eventType, blueprint::CborPayload (list)); }, listCalls));
+        cases.add (runScriptCase ("registerNativeFunction", "list1k", "B.benchmarkList();", {}, listCalls));
+        cases.add (runScriptCase ("registerNativeFunction", "list1kCbor", "B.benchmarkListCbor();", {}, listCalls));
+
+        results->setProperty ("benchmark", "bridge");
+        results->setProperty ("batches", numBatches);
+        results->setProperty ("callsPerBatch", callsPerBatch);
+        results->setProperty ("cases", cases);
+
+        return var (results);
+    }
+
+private:
+    //==============================================================================
+    typedef blueprint::ReactApplicationRoot Root;
+    typedef blueprint::ViewId ViewId;
+
+    /** Set up for every batch: a view to set properties on, a container to
+        add children to, and JavaScript handlers for the events.
+     */
+    static constexpr const char* preamble = R"js(
+var B = __BlueprintNative__;
+var rootId = B.getRootInstanceId();
+var viewId = B.createViewInstance('Canvas');
+var containerId = B.createViewInstance('View');
+var nestedPayload = { x: 12.5, y: 40, label: 'pointer', modifiers: [true, false, 'shift'], nested: { depth: [1, 2, 3] } };
+var received = 0;
+
+B.addChild(rootId, viewId);
+B.addChild(rootId, containerId);
+
+B.dispatchViewEvent = function (record) { received++; };
+B.dispatchEvent = function (type, payload) { received++; };
+)js";
+
+    std::unique_ptr<Root> createRoot (ViewId* viewId = nullptr)
+    {
+        auto root = std::make_unique<Root>();
+        root->setSize (400, 300);
+
+        // There's no window; without this, events wait for it to show.
+        root->setPausedWhileHidden (false);
+        root->registerNativeMethod ("benchmarkMethod", [] (const var::NativeFunctionArgs&) {});
+
+        const var list = createListPayload();
+        root->registerNativeFunction ("benchmarkList", [list]() { return list; });
+        root->registerNativeFunction ("benchmarkListCbor", [list]() { return blueprint::CborPayload (list); });
+        root->evalScript (String ("var N = ") + String (callsPerBatch) + ";" + preamble);
+
+        if (viewId != nullptr)
+        {
+            auto* ctx = root->getDuktapeContext();
+            duk_get_global_string (ctx, "viewId");
+            *viewId = duk_get_int (ctx, -1);
+            duk_pop (ctx);
+        }
+
+        return root;
+    }
+
+    /** Times a batch of calls made from JavaScript, set up by the given script.
+        Heavy calls can make a smaller batch.
+     */
+    var runScriptCase (const String& name, const String& payload, const String& call, const String& setup = {}, int numCalls = 0)
+    {
+        std::vector<double> nsPerCall;
+        numCalls = numCalls > 0 ? numCalls : callsPerBatch;
+
+        for (int batch = 0; batch < numBatches + numWarmupBatches; ++batch)
+        {
+            auto root = createRoot();
+            root->evalScript (setup);
+
+            const String loop = "B.beginCommit(); for (var i = 0; i < " + String (numCalls) + "; ++i) { " + call + " } B.endCommit();";
+            const double ms = timeMs ([&] { root->evalScript (loop); });
+
+            if (batch >= numWarmupBatches)
+                nsPerCall.push_back (ms * 1.0e6 / numCalls);
+        }
+
+        return summarise (name, payload, nsPerCall);
+    }
+
+    /** Times a batch of events dispatched from native code. Heavy events can
+        make a smaller batch.
+     */
+    var runDispatchCase (const String& name, const String& payload, std::function<void (Root&, ViewId, int)> dispatch, int numCalls = 0)
+    {
+        std::vector<double> nsPerCall;
+        numCalls = numCalls > 0 ? numCalls : callsPerBatch;
+
+        for (int batch = 0; batch < numBatches + numWarmupBatches; ++batch)
+        {
+            ViewId viewId = 0;
+            auto root = createRoot (&viewId);
+
+            const double ms = timeMs ([&] {
+                for (int i = 0; i < numCalls; ++i)
+                    dispatch (*root, viewId, i);
+            });
+
+            if (batch >= numWarmupBatches)
+                nsPerCall.push_back (ms * 1.0e6 / numCalls);
+        }
+
+        return summarise (name, payload, nsPerCall);
+    }
+
+    /** A parameter snapshot's worth of entries, as a plugin might send when
+        its editor opens.
+     */
+    static var createListPayload()
+    {
+        Array<var> entries;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            DynamicObject::Ptr entry = new DynamicObject();
+            entry->setProperty ("id", "param" + String (i));
+            entry->setProperty ("name", "Parameter " + String (i));
+            entry->setProperty ("value", i / 1000.0);
+            entry->setProperty ("steps", i % 8);
+            entry->setProperty ("automatable", (i % 3) != 0);
+            entries.add (var (entry.get()));
+        }
+
+        return entries;
+    }
+
+    //==============================================================================
+    static double timeMs (const std::function<void()>& work)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        work();
+        return Time::getMillisecondCounterHiRes() - start;
+    }
+
+    /** Returns a case's per-call latency across batches, and its throughput at
+        the median.
+     */
+    static var summarise (const String& name, const String& payload, std::vector<double> nsPerCall)
+    {
+        std::sort (nsPerCall.begin(), nsPerCall.end());
+
+        double mean = 0.0;
+
+        for (auto ns : nsPerCall)
+            mean += ns;
+
+        mean /= static_cast<double> (nsPerCall.size());
+
+        auto percentile = [&nsPerCall] (double p)
+        {
+            return nsPerCall[static_cast<size_t> (std::round (p * static_cast<double> (nsPerCall.size() - 1)))];
+        };
+
+        auto* latency = new DynamicObject();
+        latency->setProperty ("min", nsPerCall.front());
+        latency->setProperty ("median", percentile (0.5));
+        latency->setProperty ("mean", mean);
+        latency->setProperty ("p95", percentile (0.95));
+        latency->setProperty ("max", nsPerCall.back());
+
+        auto* result = new DynamicObject();
+        result->setProperty ("name", name);
+        result->setProperty ("payload", payload);
+        result->setProperty ("nsPerCall", var (latency));
+        result->setProperty ("callsPerSecond", percentile (0.5) > 0.0 ? 1.0e9 / percentile (0.5) : 0.0);
+
+        return var (result);
+    }
+
+    //==============================================================================
+    static constexpr int numWarmupBatches = 2;
+
+    const int numBatches;
+    const int callsPerBatch;
+};
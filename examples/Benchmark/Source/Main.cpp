@@ -0,0 +1,347 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 15 Oct 2026 4:12:36pm
+
+    A headless benchmark of Blueprint's native side. Each scenario is a
+    synthetic bundle which drives __BlueprintNative__ the way the reconciler
+    does, so no React build is needed. For every run we time:
+
+      mount   evaluating the bundle, which builds the tree in one commit and
+              lays it out as the commit closes
+      commit  a commit changing a property on every view in the tree
+      layout  a full layout, by resizing the root
+      paint   painting the whole root into a juce::Image
+
+    Run with an optional number of runs, e.g. `Benchmark 50`, or run the
+    bridge micro-benchmarks instead with `Benchmark bridge [batches]`, which
+    prints its results as JSON. `Benchmark workload [plugin] [bundle]` plays
+    an automation trace against one of the example plugins' bundles, the
+    BlueprintPlugin (`blueprint`, the default) or the GainPlugin (`gain`),
+    also printing JSON; build the bundle with `npm run build` first.
+    `Benchmark stress [ops] [seed]` runs random mutations through the
+    reconciler's entry points, checking the tree after every commit.
+    `Benchmark scaling [bundle]` opens 1, 8, 32 and then 64 GainPlugin roots
+    at once, reporting the memory, frame times and idle CPU of each count.
+    `Benchmark startup [opens] [bundle]` breaks opening the GainPlugin's
+    editor down into phases, cold and warm, from source and from bytecode.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BridgeBenchmark.h"
+#include "ScalingBenchmark.h"
+#include "StartupBenchmark.h"
+#include "StressBenchmark.h"
+#include "WorkloadBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+
+//==============================================================================
+/** The bundle preamble every scenario builds on. Each scenario defines
+    `mount()`, returning the views to churn, and may define `churn(views, i)`.
+ */
+static const char* const benchmarkPreamble = R"js(
+var B = __BlueprintNative__;
+var rootId = B.getRootInstanceId();
+
+function setProps(id, props) {
+  for (var k in props)
+    B.setViewProperty(id, k, props[k]);
+}
+
+function view(parent, props) {
+  var id = B.createViewInstance("View");
+  setProps(id, props);
+  B.addChild(parent, id);
+  return id;
+}
+
+function text(parent, value, props) {
+  var id = B.createViewInstance("Text");
+  setProps(id, props);
+  B.addChild(id, B.createTextViewInstance(value));
+  B.addChild(parent, id);
+  return id;
+}
+
+function churn(views, i) {
+  var colour = (i % 2) ? "ff3366cc" : "ffcc6633";
+
+  for (var k = 0; k < views.length; ++k)
+    B.setViewProperty(views[k], "background-color", colour);
+}
+)js";
+
+static const char* const benchmarkEpilogue = R"js(
+B.beginCommit();
+var benchmarkViews = mount();
+B.endCommit();
+
+function benchmarkChurn(i) {
+  B.beginCommit();
+  churn(benchmarkViews, i);
+  B.endCommit();
+}
+)js";
+
+struct Scenario
+{
+    const char* name;
+    const char* script;
+};
+
+static const Scenario scenarios[] = {
+    { "deep tree (200 levels)", R"js(
+function mount() {
+  var views = [];
+  var parent = rootId;
+
+  for (var i = 0; i < 200; ++i) {
+    parent = view(parent, { "flex": 1, "padding": 1, "background-color": "ff202020" });
+    views.push(parent);
+  }
+
+  return views;
+}
+)js" },
+
+    { "wide tree (2000 views)", R"js(
+function mount() {
+  var views = [];
+  var container = view(rootId, { "flex": 1, "flex-direction": "row", "flex-wrap": "wrap" });
+
+  for (var i = 0; i < 2000; ++i)
+    views.push(view(container, { "width": 12, "height": 12, "margin": 1, "background-color": "ff404040" }));
+
+  return views;
+}
+)js" },
+
+    { "1k text nodes", R"js(
+function mount() {
+  var views = [];
+  var container = view(rootId, { "flex": 1, "flex-direction": "row", "flex-wrap": "wrap" });
+
+  for (var i = 0; i < 1000; ++i)
+    views.push(text(container, "Label " + i, { "font-size": 12, "color": "ffffffff", "margin": 2 }));
+
+  return views;
+}
+
+function churn(views, i) {
+  for (var k = 0; k < views.length; ++k)
+    B.setViewProperty(views[k], "font-size", (i % 2) ? 12 : 13);
+}
+)js" },
+
+    { "10k text nodes", R"js(
+function mount() {
+  var views = [];
+  var container = view(rootId, { "flex": 1, "flex-direction": "row", "flex-wrap": "wrap" });
+
+  for (var i = 0; i < 10000; ++i)
+    views.push(text(container, "" + i, { "font-size": 10, "color": "ffffffff", "margin": 1 }));
+
+  return views;
+}
+
+function churn(views, i) {
+  for (var k = 0; k < views.length; ++k)
+    B.setViewProperty(views[k], "font-size", (i % 2) ? 10 : 11);
+}
+)js" },
+
+    { "prop churn (1000 views, 4 props)", R"js(
+function mount() {
+  var views = [];
+  var container = view(rootId, { "flex": 1, "flex-direction": "row", "flex-wrap": "wrap" });
+
+  for (var i = 0; i < 1000; ++i)
+    views.push(view(container, { "width": 20, "height": 20, "background-color": "ff808080" }));
+
+  return views;
+}
+
+function churn(views, i) {
+  var size = (i % 2) ? 20 : 22;
+  var colour = (i % 2) ? "ff808080" : "ff8080ff";
+
+  for (var k = 0; k < views.length; ++k)
+    setProps(views[k], { "width": size, "height": size, "opacity": (i % 2) ? 1 : 0.9, "background-color": colour });
+}
+)js" },
+};
+
+//==============================================================================
+/** Timings of one measurement across runs, in milliseconds. */
+class Samples
+{
+public:
+    void add (double ms) { samples.push_back (ms); }
+
+    String describe() const
+    {
+        if (samples.empty())
+            return "-";
+
+        auto sorted = samples;
+        std::sort (sorted.begin(), sorted.end());
+
+        const auto n = static_cast<double> (sorted.size());
+        double mean = 0.0;
+
+        for (auto s : sorted)
+            mean += s;
+
+        mean /= n;
+        double variance = 0.0;
+
+        for (auto s : sorted)
+            variance += (s - mean) * (s - mean);
+
+        const double stddev = sorted.size() > 1 ? std::sqrt (variance / (n - 1.0)) : 0.0;
+
+        auto percentile = [&sorted] (double p)
+        {
+            return sorted[static_cast<size_t> (std::round (p * static_cast<double> (sorted.size() - 1)))];
+        };
+
+        return "min " + String (sorted.front(), 3)
+             + "  median " + String (percentile (0.5), 3)
+             + "  mean " + String (mean, 3) + " +/- " + String (stddev, 3)
+             + "  p95 " + String (percentile (0.95), 3)
+             + "  max " + String (sorted.back(), 3);
+    }
+
+private:
+    std::vector<double> samples;
+};
+
+static double timeMs (const std::function<void()>& work)
+{
+    const auto start = Time::getMillisecondCounterHiRes();
+    work();
+    return Time::getMillisecondCounterHiRes() - start;
+}
+
+//==============================================================================
+static void runScenario (const Scenario& scenario, int numRuns, int numWarmupRuns)
+{
+    const String bundle = String (benchmarkPreamble) + scenario.script + benchmarkEpilogue;
+    Samples mount, mountLayout, commit, layout, paint;
+
+    for (int run = 0; run < numWarmupRuns + numRuns; ++run)
+    {
+        auto root = std::make_unique<blueprint::ReactApplicationRoot>();
+        root->setHeadless (true);
+        root->setSize (800, 600);
+
+        const auto layoutMsBefore = root->getPerformanceStats().getCurrentFrame().layoutMs;
+        const auto mountMs = timeMs ([&] { root->evalScript (bundle); });
+        const auto mountLayoutMs = root->getPerformanceStats().getCurrentFrame().layoutMs - layoutMsBefore;
+
+        const auto commitMs = timeMs ([&] { root->evalScript ("benchmarkChurn(" + String (run) + ");"); });
+        const auto layoutMs = timeMs ([&] { root->setSize (801 + run % 2, 600); });
+        const auto paintMs = timeMs ([&] { root->renderToImage(); });
+
+        if (run < numWarmupRuns)
+            continue;
+
+        mount.add (mountMs);
+        mountLayout.add (mountLayoutMs);
+        commit.add (commitMs);
+        layout.add (layoutMs);
+        paint.add (paintMs);
+    }
+
+    std::cout << scenario.name << " (" << numRuns << " runs, ms)" << std::endl
+              << "  mount   " << mount.describe() << std::endl
+              << "   layout " << mountLayout.describe() << std::endl
+              << "  commit  " << commit.describe() << std::endl
+              << "  layout  " << layout.describe() << std::endl
+              << "  paint   " << paint.describe() << std::endl
+              << std::endl;
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    if (argc > 1 && String (argv[1]) == "bridge")
+    {
+        BridgeBenchmark bridge (argc > 2 ? String (argv[2]).getIntValue() : 20);
+        std::cout << JSON::toString (bridge.run()) << std::endl;
+        return 0;
+    }
+
+    if (argc > 1 && String (argv[1]) == "workload")
+    {
+        const File examplesDir = File (__FILE__).getParentDirectory().getParentDirectory().getParentDirectory();
+        const bool gain = argc > 2 && String (argv[2]) == "gain";
+
+        const File bundle = argc > 3 ? File::getCurrentWorkingDirectory().getChildFile (argv[3])
+                          : gain ? examplesDir.getChildFile ("GainPlugin/Source/jsui/build/js/main.js")
+                                 : examplesDir.getChildFile ("BlueprintPlugin/Source/ui/build/js/main.js");
+
+        WorkloadBenchmark workload (gain ? WorkloadBenchmark::createGainPluginWorkload (bundle)
+                                         : WorkloadBenchmark::createBlueprintPluginWorkload (bundle),
+                                    WorkloadBenchmark::Trace());
+
+        const var result = workload.run();
+        std::cout << JSON::toString (result) << std::endl;
+        return result.hasProperty ("error") ? 1 : 0;
+    }
+
+    if (argc > 1 && String (argv[1]) == "stress")
+    {
+        StressBenchmark stress (argc > 2 ? String (argv[2]).getIntValue() : 200000,
+                                argc > 3 ? String (argv[3]).getIntValue() : 1);
+
+        const var result = stress.run();
+        std::cout << JSON::toString (result) << std::endl;
+        return result.hasProperty ("error") ? 1 : 0;
+    }
+
+    if (argc > 1 && String (argv[1]) == "scaling")
+    {
+        const File examplesDir = File (__FILE__).getParentDirectory().getParentDirectory().getParentDirectory();
+        const File bundle = argc > 2 ? File::getCurrentWorkingDirectory().getChildFile (argv[2])
+                                     : examplesDir.getChildFile ("GainPlugin/Source/jsui/build/js/main.js");
+
+        ScalingBenchmark scaling (bundle, ScalingBenchmark::Options());
+
+        const var result = scaling.run();
+        std::cout << JSON::toString (result) << std::endl;
+        return result.hasProperty ("error") ? 1 : 0;
+    }
+
+    if (argc > 1 && String (argv[1]) == "startup")
+    {
+        const File examplesDir = File (__FILE__).getParentDirectory().getParentDirectory().getParentDirectory();
+        const File bundle = argc > 3 ? File::getCurrentWorkingDirectory().getChildFile (argv[3])
+                                     : examplesDir.getChildFile ("GainPlugin/Source/jsui/build/js/main.js");
+
+        StartupBenchmark startup (bundle, argc > 2 ? String (argv[2]).getIntValue() : 10);
+
+        const var result = startup.run();
+        std::cout << JSON::toString (result) << std::endl;
+        return result.hasProperty ("error") ? 1 : 0;
+    }
+
+    const int numRuns = argc > 1 ? jmax (1, String (argv[1]).getIntValue()) : 20;
+    const int numWarmupRuns = 3;
+
+    for (const auto& scenario : scenarios)
+        runScenario (scenario, numRuns, numWarmupRuns);
+
+    return 0;
+}
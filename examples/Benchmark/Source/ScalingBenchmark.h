@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+
+    ScalingBenchmark.h
+    Created: 15 Oct 2026 10:41:19pm
+
+    How Blueprint scales with many plugin instances open at once. For each
+    instance count, it opens that many roots running the GainPlugin's bundle,
+    each with its own meter, scope and automated gain, and reports, as JSON:
+
+      rssBytesPerInstance   the process's resident memory grown per root
+      heapBytesPerInstance  each root's own engine heap, on average
+      frameMs               what a frame of one root costs, with meter traffic
+      busyMsPerSecond       the frames of every root, per second of playing
+      idleCpuPercent        the process's CPU time, all threads, while every
+                            root sits idle with the message loop running
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "WorkloadBenchmark.h"
+
+#include <memory>
+#include <vector>
+
+#if JUCE_LINUX
+ #include <sys/resource.h>
+ #include <unistd.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+ #include <sys/resource.h>
+#endif
+
+
+//==============================================================================
+class ScalingBenchmark
+{
+public:
+    //==============================================================================
+    typedef blueprint::ReactApplicationRoot Root;
+
+    struct Options
+    {
+        std::vector<int> instanceCounts { 1, 8, 32, 64 };
+
+        /** How long to play meter traffic, and then to sit idle, per count. */
+        double playSeconds = 5.0;
+        double idleSeconds = 5.0;
+
+        double frameRateHz = 60.0;
+    };
+
+    //==============================================================================
+    ScalingBenchmark (const File& _bundle, Options _options)
+        : bundle (_bundle), options (std::move (_options)) {}
+
+    /** Runs every instance count in turn, returning the results as a JSON object. */
+    var run()
+    {
+        auto* result = new DynamicObject();
+        result->setProperty ("benchmark", "scaling");
+
+        if (! bundle.existsAsFile())
+        {
+            result->setProperty ("error", "Bundle not found, build it first: " + bundle.getFullPathName());
+            return var (result);
+        }
+
+        Array<var> runs;
+
+        for (auto count : options.instanceCounts)
+            runs.add (runInstances (count));
+
+        result->setProperty ("runs", runs);
+        return var (result);
+    }
+
+private:
+    //==============================================================================
+    struct Instance
+    {
+        WorkloadBenchmark::Workload workload;
+        std::unique_ptr<Root> root;
+    };
+
+    var runInstances (int count)
+    {
+        std::vector<Instance> instances;
+        instances.reserve (static_cast<size_t> (count));
+
+        const auto rssBefore = getResidentBytes();
+
+        // As the plugin opens its editors: one root each, every one with its
+        // own processor state.
+        const double mountMs = timeMs ([&]
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                Instance instance { WorkloadBenchmark::createGainPluginWorkload (bundle), std::make_unique<Root>() };
+                auto& root = *instance.root;
+
+                root.setSize (instance.workload.width, instance.workload.height);
+                root.setPausedWhileHidden (false);
+                instance.workload.setUp (root);
+                root.evalScript (bundle);
+
+                instances.push_back (std::move (instance));
+            }
+        });
+
+        const auto rssAfter = getResidentBytes();
+
+        // Meter traffic: each frame, each instance's audio thread delivers a
+        // block and the host moves its gain, and then every root renders.
+        const double frameMs = 1000.0 / options.frameRateHz;
+        const int numFrames = roundToInt (options.playSeconds * options.frameRateHz);
+
+        std::vector<double> frameCosts;
+        frameCosts.reserve (static_cast<size_t> (numFrames * count));
+
+        double busyMs = 0.0;
+        const double startMs = Time::getMillisecondCounterHiRes();
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            const double frameStartMs = startMs + frame * frameMs;
+
+            while (Time::getMillisecondCounterHiRes() < frameStartMs)
+                Thread::sleep (jmax (0, static_cast<int> (frameStartMs - Time::getMillisecondCounterHiRes()) - 1));
+
+            const double t = frame / options.frameRateHz;
+
+            for (size_t i = 0; i < instances.size(); ++i)
+            {
+                auto& instance = instances[i];
+
+                const double costMs = timeMs ([&]
+                {
+                    instance.workload.setParameter (*instance.root, 0, 0.5 + 0.5 * std::sin (MathConstants<double>::twoPi * (0.25 * t + static_cast<double> (i) / count)));
+                    instance.workload.process (t);
+
+                    instance.root->runScheduledWork();
+                    instance.root->createComponentSnapshot (instance.root->getLocalBounds());
+                });
+
+                frameCosts.push_back (costMs);
+                busyMs += costMs;
+            }
+        }
+
+        const double playedSeconds = (Time::getMillisecondCounterHiRes() - startMs) / 1000.0;
+
+        int64 heapBytes = 0;
+
+        for (auto& instance : instances)
+            heapBytes += static_cast<int64> (instance.root->getHeapSize());
+
+        auto* result = new DynamicObject();
+        result->setProperty ("instances", count);
+        result->setProperty ("mountMs", mountMs);
+        result->setProperty ("rssBytesPerInstance", rssBefore >= 0 && rssAfter >= 0 ? (rssAfter - rssBefore) / count : -1);
+        result->setProperty ("heapBytesPerInstance", heapBytes / count);
+        result->setProperty ("frameMs", summarise (frameCosts));
+        result->setProperty ("busyMsPerSecond", playedSeconds > 0.0 ? busyMs / playedSeconds : 0.0);
+        result->setProperty ("idleCpuPercent", measureIdleCpuPercent());
+
+        return var (result);
+    }
+
+    /** Runs the message loop with nothing for the roots to do, returning the
+        process's CPU time over it as a percentage of one core, or -1 if it
+        can't be measured.
+     */
+    double measureIdleCpuPercent() const
+    {
+       #if JUCE_MODAL_LOOPS_PERMITTED
+        // Lets anything the traffic left behind, such as a fading peak, settle.
+        MessageManager::getInstance()->runDispatchLoopUntil (500);
+
+        const double cpuBefore = getProcessCpuSeconds();
+        const double wallBefore = Time::getMillisecondCounterHiRes();
+
+        MessageManager::getInstance()->runDispatchLoopUntil (roundToInt (options.idleSeconds * 1000.0));
+
+        const double cpu = getProcessCpuSeconds() - cpuBefore;
+        const double wall = (Time::getMillisecondCounterHiRes() - wallBefore) / 1000.0;
+
+        return cpuBefore >= 0.0 && wall > 0.0 ? 100.0 * cpu / wall : -1.0;
+       #else
+        return -1.0;
+       #endif
+    }
+
+    //==============================================================================
+    /** Returns the process's resident memory, in bytes, or -1 if unknown. */
+    static int64 getResidentBytes()
+    {
+       #if JUCE_LINUX
+        const auto fields = StringArray::fromTokens (File ("/proc/self/statm").loadFileAsString(), false);
+        return fields.size() > 1 ? fields[1].getLargeIntValue() * static_cast<int64> (sysconf (_SC_PAGESIZE)) : -1;
+       #elif JUCE_MAC
+        mach_task_basic_info info;
+        mach_msg_type_number_t infoCount = MACH_TASK_BASIC_INFO_COUNT;
+
+        if (task_info (mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t> (&info), &infoCount) != KERN_SUCCESS)
+            return -1;
+
+        return static_cast<int64> (info.resident_size);
+       #else
+        return -1;
+       #endif
+    }
+
+    /** Returns the CPU time of every thread of the process so far, or -1 if
+        unknown.
+     */
+    static double getProcessCpuSeconds()
+    {
+       #if JUCE_LINUX || JUCE_MAC
+        rusage usage;
+
+        if (getrusage (RUSAGE_SELF, &usage) != 0)
+            return -1.0;
+
+        auto seconds = [] (const timeval& t) { return static_cast<double> (t.tv_sec) + static_cast<double> (t.tv_usec) / 1.0e6; };
+        return seconds (usage.ru_utime) + seconds (usage.ru_stime);
+       #else
+        return -1.0;
+       #endif
+    }
+
+    static double timeMs (const std::function<void()>& work)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        work();
+        return Time::getMillisecondCounterHiRes() - start;
+    }
+
+    static var summarise (std::vector<double> ms)
+    {
+        auto* summary = new DynamicObject();
+
+        if (ms.empty())
+            return var (summary);
+
+        std::sort (ms.begin(), ms.end());
+
+        auto percentile = [&ms] (double p)
+        {
+            return ms[static_cast<size_t> (std::round (p * static_cast<double> (ms.size() - 1)))];
+        };
+
+        summary->setProperty ("min", ms.front());
+        summary->setProperty ("p50", percentile (0.5));
+        summary->setProperty ("p90", percentile (0.9));
+        summary->setProperty ("p99", percentile (0.99));
+        summary->setProperty ("max", ms.back());
+
+        return var (summary);
+    }
+
+    //==============================================================================
+    const File bundle;
+    const Options options;
+};
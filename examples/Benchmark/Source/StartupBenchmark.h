@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    StartupBenchmark.h
+    Created: 15 Oct 2026 10:58:06pm
+
+    How long an editor takes to open, phase by phase, from the root's stats:
+    heap creation, bundle read, compile, evaluation, first commit, first layout
+    and first paint. Each open makes a root, runs the GainPlugin's bundle in it
+    and paints it, then destroys it again.
+
+    Bundles run either from source, with `evalScript`, or as bytecode, with
+    `loadBundle` and a cache directory. The first open of each is cold: for
+    bytecode, the cache directory starts empty, so the bundle compiles and
+    the cache is written. The rest are warm, reading the cached bytecode, and
+    for either, a bundle the OS has already read. Warm opens report the median
+    of each phase, as JSON.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "WorkloadBenchmark.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+
+//==============================================================================
+class StartupBenchmark
+{
+public:
+    //==============================================================================
+    typedef blueprint::ReactApplicationRoot Root;
+    typedef blueprint::PerformanceStats PerformanceStats;
+
+    //==============================================================================
+    StartupBenchmark (const File& _bundle, int _numWarmOpens)
+        : bundle (_bundle), numWarmOpens (jmax (1, _numWarmOpens)) {}
+
+    /** Opens the bundle cold and then warm, from source and then as bytecode,
+        returning the results as a JSON object.
+     */
+    var run()
+    {
+        auto* result = new DynamicObject();
+        result->setProperty ("benchmark", "startup");
+
+        if (! bundle.existsAsFile())
+        {
+            result->setProperty ("error", "Bundle not found, build it first: " + bundle.getFullPathName());
+            return var (result);
+        }
+
+        const File cacheDirectory = blueprint::BytecodeBundle::getDefaultCacheDirectory ("BlueprintStartupBenchmark");
+        Array<var> runs;
+
+        for (const bool bytecode : { false, true })
+        {
+            cacheDirectory.deleteRecursively();
+            cacheDirectory.createDirectory();
+
+            std::vector<Open> warm;
+
+            const auto cold = open (bytecode, cacheDirectory);
+
+            for (int i = 0; i < numWarmOpens; ++i)
+                warm.push_back (open (bytecode, cacheDirectory));
+
+            runs.add (toVar (bytecode, "cold", { cold }));
+            runs.add (toVar (bytecode, "warm", warm));
+        }
+
+        cacheDirectory.deleteRecursively();
+
+        result->setProperty ("warmOpens", numWarmOpens);
+        result->setProperty ("runs", runs);
+        return var (result);
+    }
+
+private:
+    //==============================================================================
+    /** What one open took: the root's own phases, and the whole, as we saw it. */
+    struct Open
+    {
+        PerformanceStats::Startup startup;
+        double wallMs = 0.0;
+    };
+
+    Open open (bool bytecode, const File& cacheDirectory) const
+    {
+        auto workload = WorkloadBenchmark::createGainPluginWorkload (bundle);
+        Open result;
+
+        const auto start = Time::getMillisecondCounterHiRes();
+
+        {
+            auto root = std::make_unique<Root>();
+            root->setSize (workload.width, workload.height);
+            root->setPausedWhileHidden (false);
+
+            if (workload.setUp)
+                workload.setUp (*root);
+
+            if (bytecode)
+                root->loadBundle (bundle, cacheDirectory);
+            else
+                root->evalScript (bundle);
+
+            root->runScheduledWork();
+            root->createComponentSnapshot (root->getLocalBounds());
+
+            result.wallMs = Time::getMillisecondCounterHiRes() - start;
+            result.startup = root->getPerformanceStats().getStartup();
+        }
+
+        return result;
+    }
+
+    static var toVar (bool bytecode, const String& kind, const std::vector<Open>& opens)
+    {
+        auto* result = new DynamicObject();
+        result->setProperty ("bundle", bytecode ? "bytecode" : "source");
+        result->setProperty ("open", kind);
+
+        std::vector<double> wall;
+
+        for (const auto& o : opens)
+            wall.push_back (o.wallMs);
+
+        result->setProperty ("wallMs", median (wall));
+
+        auto* phases = new DynamicObject();
+
+        for (int i = 0; i < PerformanceStats::numStartupPhases; ++i)
+        {
+            std::vector<double> startMs, durationMs;
+
+            for (const auto& o : opens)
+            {
+                startMs.push_back (o.startup.startMs[static_cast<size_t> (i)]);
+                durationMs.push_back (o.startup.durationMs[static_cast<size_t> (i)]);
+            }
+
+            auto* phase = new DynamicObject();
+            phase->setProperty ("startMs", median (startMs));
+            phase->setProperty ("durationMs", median (durationMs));
+            phases->setProperty (PerformanceStats::getStartupPhaseName (i), var (phase));
+        }
+
+        result->setProperty ("phases", var (phases));
+        return var (result);
+    }
+
+    static double median (std::vector<double> values)
+    {
+        if (values.empty())
+            return -1.0;
+
+        std::sort (values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    //==============================================================================
+    const File bundle;
+    const int numWarmOpens;
+};
@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+    StressBenchmark.h
+    Created: 15 Oct 2026 5:31:18pm
+
+    A stress test of the reconciler's mutation path. A seeded script drives
+    random sequences of creates, inserts, removes, property and text changes
+    through __BlueprintNative__, keeping a model of the tree it expects, and
+    after every commit the root checks its view table against its trees. It
+    reports the mutations per second it sustained, as JSON, or the commit at
+    which the tree first went wrong, which the same seed reproduces.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+#include <functional>
+#include <memory>
+
+
+//==============================================================================
+class StressBenchmark
+{
+public:
+    //==============================================================================
+    /** Runs the given number of random mutations, a commit of the given size at
+        a time, from the given seed.
+     */
+    StressBenchmark (int _numOps, int _seed, int _opsPerCommit = 64)
+        : numOps (jmax (1, _numOps)), seed (jmax (1, _seed)), opsPerCommit (jmax (1, _opsPerCommit)) {}
+
+    /** Runs the stress test, returning the results as a JSON object. */
+    var run()
+    {
+        auto root = std::make_unique<blueprint::ReactApplicationRoot>();
+        root->setHeadless (true);
+        root->setSize (800, 600);
+        root->evalScript ("var SEED = " + String (seed) + ";" + stressScript);
+
+        auto* result = new DynamicObject();
+        result->setProperty ("benchmark", "stress");
+        result->setProperty ("seed", seed);
+        result->setProperty ("opsPerCommit", opsPerCommit);
+
+        const String step = "stressStep(" + String (opsPerCommit) + ");";
+        const int numCommits = (numOps + opsPerCommit - 1) / opsPerCommit;
+        double elapsedMs = 0.0;
+        int commit = 0;
+
+        for (; commit < numCommits; ++commit)
+        {
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            // A frame after each commit gives buried views their chance to go.
+            root->evalScript (step);
+            root->advanceClock (1000.0 / 60.0);
+
+            elapsedMs += Time::getMillisecondCounterHiRes() - start;
+
+            auto check = root->verifyViewTree();
+            const int expectedViews = readGlobalInt (*root, "liveCount");
+
+            if (check.wasOk() && static_cast<int> (root->getNumViews()) != expectedViews)
+                check = Result::fail ("The table holds " + String (static_cast<int> (root->getNumViews()))
+                                      + " views where the script expects " + String (expectedViews));
+
+            if (check.failed())
+            {
+                result->setProperty ("failedAtCommit", commit);
+                result->setProperty ("error", check.getErrorMessage());
+                break;
+            }
+        }
+
+        const int opsRun = jmin (numOps, commit * opsPerCommit);
+
+        result->setProperty ("ops", opsRun);
+        result->setProperty ("commits", commit);
+        result->setProperty ("opsPerSecond", elapsedMs > 0.0 ? opsRun * 1000.0 / elapsedMs : 0.0);
+        result->setProperty ("finalViews", static_cast<int> (root->getNumViews()));
+
+        return var (result);
+    }
+
+private:
+    //==============================================================================
+    static int readGlobalInt (blueprint::ReactApplicationRoot& root, const char* name)
+    {
+        auto* ctx = root.getDuktapeContext();
+        duk_get_global_string (ctx, name);
+        const int value = duk_get_int (ctx, -1);
+        duk_pop (ctx);
+
+        return value;
+    }
+
+    /** The model and the mutations. Like React, it only ever adds a view
+        which has no parent, whether to the tree or to a subtree still being
+        built, and a removal takes the whole subtree with it.
+     */
+    static constexpr const char* stressScript = R"js(
+var B = __BlueprintNative__;
+var rootId = B.getRootInstanceId();
+var maxViews = 2000;
+var maxDetached = 32;
+
+// Park-Miller, which stays exact in doubles.
+var state = SEED % 2147483647;
+
+function random() {
+  state = (state * 16807) % 2147483647;
+  return (state - 1) / 2147483646;
+}
+
+function randomInt(n) {
+  return Math.floor(random() * n);
+}
+
+var rootNode = { id: rootId, kind: 'view', parent: null, children: [] };
+var nodes = [];
+var detached = [];
+var liveCount = 0;
+var textCount = 0;
+
+function track(list, node, key) {
+  node[key] = list.length;
+  list.push(node);
+}
+
+function untrack(list, node, key) {
+  var last = list.pop();
+
+  if (last !== node) {
+    list[node[key]] = last;
+    last[key] = node[key];
+  }
+
+  node[key] = -1;
+}
+
+function createNode(kind, id, parent) {
+  var node = { id: id, kind: kind, parent: parent, children: [], index: -1, detachedIndex: -1 };
+  track(nodes, node, 'index');
+  liveCount++;
+
+  if (parent === null)
+    track(detached, node, 'detachedIndex');
+  else
+    parent.children.push(node);
+
+  return node;
+}
+
+function opCreate() {
+  if (random() < 0.7)
+    return createNode('view', B.createViewInstance('View'), null);
+
+  var text = createNode('text', B.createViewInstance('Text'), null);
+  var raw = createNode('raw', B.createTextViewInstance('text ' + textCount++), text);
+  B.addChild(text.id, raw.id);
+}
+
+function isWithin(node, ancestor) {
+  for (var n = node; n !== null; n = n.parent)
+    if (n === ancestor)
+      return true;
+
+  return false;
+}
+
+function opInsert() {
+  if (detached.length === 0)
+    return opCreate();
+
+  var child = detached[randomInt(detached.length)];
+  var parent = nodes.length > 0 && random() < 0.6 ? nodes[randomInt(nodes.length)] : rootNode;
+
+  if (parent.kind !== 'view' || isWithin(parent, child))
+    parent = rootNode;
+
+  untrack(detached, child, 'detachedIndex');
+  child.parent = parent;
+
+  if (random() < 0.5) {
+    B.addChild(parent.id, child.id);
+    parent.children.push(child);
+  } else {
+    var index = randomInt(parent.children.length + 1);
+    B.addChild(parent.id, child.id, index);
+    parent.children.splice(index, 0, child);
+  }
+}
+
+function forget(node) {
+  for (var i = 0; i < node.children.length; ++i)
+    forget(node.children[i]);
+
+  untrack(nodes, node, 'index');
+
+  if (node.detachedIndex >= 0)
+    untrack(detached, node, 'detachedIndex');
+
+  liveCount--;
+}
+
+function opRemove() {
+  var node = nodes.length > 0 ? nodes[randomInt(nodes.length)] : null;
+
+  // A view not yet added goes in instead, so that they don't pile up.
+  if (node === null || node.parent === null)
+    return opInsert();
+
+  var siblings = node.parent.children;
+  siblings.splice(siblings.indexOf(node), 1);
+  B.removeChild(node.parent.id, node.id);
+  forget(node);
+}
+
+var colours = ['ff202020', 'ff3366cc', 'ffcc6633', '80ffffff'];
+
+function opSetProperty() {
+  if (nodes.length === 0)
+    return opCreate();
+
+  var node = nodes[randomInt(nodes.length)];
+
+  if (node.kind === 'raw')
+    return B.setRawTextValue(node.id, 'text ' + textCount++);
+
+  switch (randomInt(7)) {
+    case 0: return B.setViewProperty(node.id, 'width', randomInt(200));
+    case 1: return B.setViewProperty(node.id, 'height', randomInt(200));
+    case 2: return B.setViewProperty(node.id, 'flex', randomInt(2));
+    case 3: return B.setViewProperty(node.id, 'flex-direction', random() < 0.5 ? 'row' : 'column');
+    case 4: return B.setViewProperty(node.id, 'background-color', colours[randomInt(colours.length)]);
+    case 5: return B.setViewProperty(node.id, 'refId', 'ref' + randomInt(16));
+    default: return B.setViewProperties(node.id, { 'opacity': random(), 'margin': randomInt(4) });
+  }
+}
+
+function opSetText() {
+  for (var attempt = 0; attempt < 4 && nodes.length > 0; ++attempt) {
+    var node = nodes[randomInt(nodes.length)];
+
+    if (node.kind === 'raw')
+      return B.setRawTextValue(node.id, 'text ' + textCount++);
+  }
+
+  opSetProperty();
+}
+
+function randomOp() {
+  if (liveCount > maxViews)
+    return opRemove();
+
+  if (detached.length > maxDetached)
+    return opInsert();
+
+  var r = randomInt(14);
+
+  if (r < 3) return opCreate();
+  if (r < 6) return opInsert();
+  if (r < 8) return opRemove();
+  if (r < 12) return opSetProperty();
+  return opSetText();
+}
+
+function stressStep(numOps) {
+  B.beginCommit();
+
+  for (var i = 0; i < numOps; ++i)
+    randomOp();
+
+  B.endCommit();
+}
+)js";
+
+    //==============================================================================
+    const int numOps;
+    const int seed;
+    const int opsPerCommit;
+};
@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    WorkloadBenchmark.h
+    Created: 15 Oct 2026 5:06:52pm
+
+    Reference workloads built on the example plugins' own bundles: the
+    BlueprintPlugin's parameter grid and rotary knobs, and the GainPlugin's
+    knob and meter. Each plays a scripted trace against its bundle, the host
+    automating parameters while the user drags a knob, and reports what the
+    frames cost over it, as JSON.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+//==============================================================================
+class WorkloadBenchmark
+{
+public:
+    //==============================================================================
+    typedef blueprint::ReactApplicationRoot Root;
+
+    /** One of the example plugins, as far as its bundle can tell. */
+    struct Workload
+    {
+        String name;
+
+        /** The built bundle, from the example's `npm run build`. */
+        File bundle;
+
+        int width = 400;
+        int height = 300;
+
+        /** Where the dragged knob sits, in proportions of the root's bounds. */
+        Point<float> knobPosition;
+
+        /** The ids of the parameters the host automates, in index order. */
+        StringArray parameterIds;
+
+        /** Registers whatever the plugin's editor would before the bundle runs. */
+        std::function<void (Root&)> setUp;
+
+        /** Tells the bundle of a parameter's new value, as the plugin would. */
+        std::function<void (Root&, int index, double value)> setParameter;
+
+        /** Stands in for the audio thread, once per automation step; may be
+            left empty.
+         */
+        std::function<void (double timeSeconds)> process;
+    };
+
+    /** The trace played against a workload. */
+    struct Trace
+    {
+        double lengthSeconds = 10.0;
+        double frameRateHz = 60.0;
+
+        /** How often, and how many of its parameters, the host automates. */
+        double automationRateHz = 100.0;
+        int numAutomatedParameters = 16;
+
+        /** Whether a knob is dragged up and down the whole time. */
+        bool dragKnob = true;
+    };
+
+    //==============================================================================
+    /** The BlueprintPlugin, whose ParameterGrid and FloatingGlobalKnobs hear of
+        each parameter change as its own `parameterValueChange` event.
+     */
+    static Workload createBlueprintPluginWorkload (const File& bundle)
+    {
+        Workload w;
+        w.name = "BlueprintPlugin";
+        w.bundle = bundle;
+        w.width = 667;
+        w.height = 375;
+        w.knobPosition = { 0.2f, 0.5f };
+        w.parameterIds = { "DelayMs", "Warp", "Cutoff", "GrainFrequency", "Spray", "Spread", "Pitch", "Feedback",
+                           "GrainFrequencyG2", "SprayG2", "SpreadG2", "PitchG2", "FeedbackG2",
+                           "EnvelopeThreshold", "WetAmp", "Mix" };
+
+        w.setUp = [] (Root& root)
+        {
+            root.registerNativeMethod ("setParameterValueNotifyingHost", [] (const var::NativeFunctionArgs&) {});
+        };
+
+        auto ids = w.parameterIds;
+
+        w.setParameter = [ids] (Root& root, int index, double value)
+        {
+            root.dispatchEvent ("parameterValueChange", index, ids[index], 0.5, value, String (value, 2));
+        };
+
+        return w;
+    }
+
+    /** The GainPlugin, whose parameter changes go out through a coalesced
+        channel once a frame, and whose meter and scope read the audio thread's
+        values directly.
+     */
+    static Workload createGainPluginWorkload (const File& bundle)
+    {
+        struct AudioState
+        {
+            blueprint::ValueChannel peakValues { 2 };
+            blueprint::SampleRingBuffer outputSamples { 4096 };
+            double gain = 0.8;
+            std::vector<float> block = std::vector<float> (512);
+        };
+
+        auto state = std::make_shared<AudioState>();
+
+        Workload w;
+        w.name = "GainPlugin";
+        w.bundle = bundle;
+        w.width = 400;
+        w.height = 240;
+        w.knobPosition = { 0.5f, 0.5f };
+        w.parameterIds = { "MainGain" };
+
+        w.setUp = [state] (Root& root)
+        {
+            root.registerNativeMethod ("beginParameterChangeGesture", [] (const var::NativeFunctionArgs&) {});
+            root.registerNativeMethod ("setParameterValueNotifyingHost", [] (const var::NativeFunctionArgs&) {});
+            root.registerNativeMethod ("endParameterChangeGesture", [] (const var::NativeFunctionArgs&) {});
+
+            root.registerCoalescedEventType ("parameterValuesChange", 1, [] (int parameterIndex, double value) -> var
+            {
+                auto* change = new DynamicObject();
+                change->setProperty ("parameterIndex", parameterIndex);
+                change->setProperty ("parameterId", "MainGain");
+                change->setProperty ("defaultValue", 0.8);
+                change->setProperty ("currentValue", value);
+                change->setProperty ("stringValue", String (Decibels::gainToDecibels (value), 1) + "dB");
+
+                return var (change);
+            });
+
+            blueprint::ParameterTarget target;
+            target.getValue = [state] { return state->gain; };
+            target.setValue = [state] (double v) { state->gain = v; };
+
+            root.registerParameterTarget ("MainGain", target);
+            root.registerValueChannel ("gainPeakValues", state->peakValues);
+            root.registerSampleBuffer ("gainOutput", state->outputSamples);
+        };
+
+        w.setParameter = [state] (Root& root, int index, double value)
+        {
+            state->gain = value;
+
+            if (auto* channel = root.getCoalescedEventChannel ("parameterValuesChange"))
+                channel->set (index, value);
+        };
+
+        w.process = [state] (double timeSeconds)
+        {
+            auto& block = state->block;
+
+            for (size_t i = 0; i < block.size(); ++i)
+                block[i] = static_cast<float> (state->gain * std::sin (MathConstants<double>::twoPi * 220.0 * (timeSeconds + static_cast<double> (i) / 48000.0)));
+
+            const float peak = static_cast<float> (state->gain);
+            state->peakValues.setValue (0, peak);
+            state->peakValues.setValue (1, peak * 0.9f);
+            state->outputSamples.write (block.data(), static_cast<int> (block.size()));
+        };
+
+        return w;
+    }
+
+    //==============================================================================
+    WorkloadBenchmark (Workload _workload, Trace _trace)
+        : workload (std::move (_workload)), trace (_trace) {}
+
+    /** Plays the trace in real time, returning the results as a JSON object. */
+    var run()
+    {
+        if (! workload.bundle.existsAsFile())
+            return error ("Bundle not found, build it first: " + workload.bundle.getFullPathName());
+
+        auto root = std::make_unique<Root>();
+        root->setSize (workload.width, workload.height);
+
+        // There's no window; without this, events wait for it to show.
+        root->setPausedWhileHidden (false);
+
+        if (workload.setUp)
+            workload.setUp (*root);
+
+        const double mountMs = timeMs ([&] { root->evalScript (workload.bundle); });
+
+        const double frameMs = 1000.0 / trace.frameRateHz;
+        const double stepMs = 1000.0 / trace.automationRateHz;
+        const int numFrames = roundToInt (trace.lengthSeconds * trace.frameRateHz);
+        const int numParameters = jmin (trace.numAutomatedParameters, workload.parameterIds.size());
+
+        Component* knob = nullptr;
+        Point<float> knobDown;
+
+        if (trace.dragKnob)
+        {
+            const auto position = root->getLocalBounds().toFloat().getRelativePoint (workload.knobPosition.x, workload.knobPosition.y);
+            knob = root->getComponentAt (position.roundToInt());
+
+            if (knob != nullptr)
+            {
+                knobDown = knob->getLocalPoint (root.get(), position);
+                sendMouseEvent (*knob, knobDown, knobDown, mouseDown);
+            }
+        }
+
+        std::vector<double> frameCosts;
+        frameCosts.reserve (static_cast<size_t> (numFrames));
+
+        double busyMs = 0.0;
+        int numSteps = 0;
+        const double startMs = Time::getMillisecondCounterHiRes();
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            // Waits for the frame's slot, unless the last one overran it.
+            const double frameStartMs = startMs + frame * frameMs;
+
+            while (Time::getMillisecondCounterHiRes() < frameStartMs)
+                Thread::sleep (jmax (0, static_cast<int> (frameStartMs - Time::getMillisecondCounterHiRes()) - 1));
+
+            const double costMs = timeMs ([&]
+            {
+                // Every automation step due by this frame, with the audio
+                // thread's work alongside.
+                for (; numSteps * stepMs < (frame + 1) * frameMs; ++numSteps)
+                {
+                    const double t = numSteps * stepMs / 1000.0;
+
+                    for (int i = 0; i < numParameters; ++i)
+                        workload.setParameter (*root, i, 0.5 + 0.5 * std::sin (MathConstants<double>::twoPi * (0.25 * t + static_cast<double> (i) / numParameters)));
+
+                    if (workload.process)
+                        workload.process (t);
+                }
+
+                // The drag sweeps 100px up and down, once a second.
+                if (knob != nullptr)
+                {
+                    const double phase = std::fmod (frame / trace.frameRateHz, 1.0);
+                    const float offset = static_cast<float> (100.0 * (phase < 0.5 ? phase * 2.0 : 2.0 - phase * 2.0));
+                    sendMouseEvent (*knob, knobDown.translated (0.0f, -offset), knobDown, mouseDrag);
+                }
+
+                root->runScheduledWork();
+                root->createComponentSnapshot (root->getLocalBounds());
+            });
+
+            frameCosts.push_back (costMs);
+            busyMs += costMs;
+        }
+
+        const double elapsedSeconds = (Time::getMillisecondCounterHiRes() - startMs) / 1000.0;
+
+        if (knob != nullptr)
+            sendMouseEvent (*knob, knobDown, knobDown, mouseUp);
+
+        const auto numDropped = std::count_if (frameCosts.begin(), frameCosts.end(), [=] (double ms) { return ms > frameMs; });
+
+        auto* result = new DynamicObject();
+        result->setProperty ("benchmark", "workload");
+        result->setProperty ("workload", workload.name);
+        result->setProperty ("seconds", trace.lengthSeconds);
+        result->setProperty ("automatedParameters", numParameters);
+        result->setProperty ("automationRateHz", trace.automationRateHz);
+        result->setProperty ("draggedKnob", knob != nullptr);
+        result->setProperty ("mountMs", mountMs);
+        result->setProperty ("frames", numFrames);
+        result->setProperty ("frameMs", summarise (frameCosts));
+        result->setProperty ("droppedFrames", static_cast<int> (numDropped));
+        result->setProperty ("busyMsPerSecond", elapsedSeconds > 0.0 ? busyMs / elapsedSeconds : 0.0);
+        result->setProperty ("heapPeakBytes", static_cast<int64> (root->getHeapStats().peakBytes));
+
+        return var (result);
+    }
+
+private:
+    //==============================================================================
+    enum MouseEventType { mouseDown, mouseDrag, mouseUp };
+
+    /** Hands the component a mouse event as if from the main mouse, with the
+        button down from the given position.
+     */
+    static void sendMouseEvent (Component& c, Point<float> position, Point<float> downPosition, MouseEventType type)
+    {
+        const auto now = Time::getCurrentTime();
+        const auto modifiers = type == mouseUp ? ModifierKeys() : ModifierKeys (ModifierKeys::leftButtonModifier);
+
+        const MouseEvent e (Desktop::getInstance().getMainMouseSource(), position, modifiers,
+                            MouseInputSource::invalidPressure, MouseInputSource::invalidOrientation,
+                            MouseInputSource::invalidRotation, MouseInputSource::invalidTiltX, MouseInputSource::invalidTiltY,
+                            &c, &c, now, downPosition, now, 1, type != mouseDown);
+
+        switch (type)
+        {
+            case mouseDown: c.mouseDown (e); break;
+            case mouseDrag: c.mouseDrag (e); break;
+            case mouseUp:   c.mouseUp (e); break;
+        }
+    }
+
+    static double timeMs (const std::function<void()>& work)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        work();
+        return Time::getMillisecondCounterHiRes() - start;
+    }
+
+    static var summarise (std::vector<double> ms)
+    {
+        auto* summary = new DynamicObject();
+
+        if (ms.empty())
+            return var (summary);
+
+        std::sort (ms.begin(), ms.end());
+
+        auto percentile = [&ms] (double p)
+        {
+            return ms[static_cast<size_t> (std::round (p * static_cast<double> (ms.size() - 1)))];
+        };
+
+        summary->setProperty ("min", ms.front());
+        summary->setProperty ("p50", percentile (0.5));
+        summary->setProperty ("p90", percentile (0.9));
+        summary->setProperty ("p99", percentile (0.99));
+        summary->setProperty ("max", ms.back());
+
+        return var (summary);
+    }
+
+    var error (const String& message) const
+    {
+        auto* result = new DynamicObject();
+        result->setProperty ("benchmark", "workload");
+        result->setProperty ("workload", workload.name);
+        result->setProperty ("error", message);
+
+        return var (result);
+    }
+
+    //==============================================================================
+    const Workload workload;
+    const Trace trace;
+};
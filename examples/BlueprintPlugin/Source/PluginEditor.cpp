@@ -18,7 +18,7 @@ BlueprintPluginAudioProcessorEditor::BlueprintPluginAudioProcessorEditor (Bluepr
     File sourceDir = (File (__FILE__)).getParentDirectory();
 
     addAndMakeVisible(appRoot);
-    appRoot.evalScript(sourceDir.getChildFile("ui/build/js/main.js").loadFileAsString());
+    appRoot.evalScript(sourceDir.getChildFile("ui/build/js/main.js"));
     appRoot.enableHotkeyReloading();
 
     appRoot.registerNativeMethod(
@@ -15,6 +15,44 @@
 GainPluginAudioProcessorEditor::GainPluginAudioProcessorEditor (GainPluginAudioProcessor& p)
     : AudioProcessorEditor (&p), processor (p)
 {
+    // If an earlier editor parked its appRoot with the processor, we take it over
+    // as it was, bundle running and views mounted, and reopening is all but
+    // instant. Otherwise we build one of our own.
+    appRoot = processor.getParkedRoot().take();
+
+    if (appRoot == nullptr)
+        createAppRoot();
+
+    addAndMakeVisible(*appRoot);
+
+    // Now we can mirror the parameter values into the JavaScript ParameterStore.
+    // The first snapshot waits for the bundle to be running, and then goes out
+    // at the first frame. A parked appRoot missed any changes made while it was
+    // away, so it gets the snapshot too.
+    parameterStore = std::make_unique<blueprint::ParameterStore>(processor, *appRoot);
+
+    // And of course set our editor size before we're done.
+    setResizable(true, true);
+    setResizeLimits(400, 240, 400 * 2, 240 * 2);
+    getConstrainer()->setFixedAspectRatio(400.0 / 240.0);
+    setSize (400, 240);
+}
+
+GainPluginAudioProcessorEditor::~GainPluginAudioProcessorEditor()
+{
+    // Tear down parameter listeners
+    parameterStore = nullptr;
+
+    // And leave the appRoot with the processor for the next editor, unless its
+    // heap is over the processor's budget.
+    processor.getParkedRoot().park(std::move(appRoot));
+}
+
+//==============================================================================
+void GainPluginAudioProcessorEditor::createAppRoot()
+{
+    appRoot = std::make_unique<blueprint::ReactApplicationRoot>();
+
     // First thing we have to do is load our javascript bundle from the build
     // directory so that we can evaluate it within our appRot.
     File sourceDir = File(__FILE__).getParentDirectory();
@@ -23,67 +61,55 @@ GainPluginAudioProcessorEditor::GainPluginAudioProcessorEditor (GainPluginAudioP
     // Sanity check
     jassert (bundle.existsAsFile());
 
-    // Bind some native callbacks
-    appRoot.registerNativeMethod(
+    // Bind some native callbacks. The appRoot may outlive us, parked with the
+    // processor, so these refer to the processor rather than to the editor.
+    auto& proc = processor;
+
+    appRoot->registerNativeMethod(
         "beginParameterChangeGesture",
-        [this](const juce::var::NativeFunctionArgs& args) {
+        [&proc](const juce::var::NativeFunctionArgs& args) {
             const juce::String& paramId = args.arguments[0].toString();
 
-            if (auto* parameter = processor.getValueTreeState().getParameter(paramId))
+            if (auto* parameter = proc.getValueTreeState().getParameter(paramId))
                 parameter->beginChangeGesture();
         }
     );
 
-    appRoot.registerNativeMethod(
+    appRoot->registerNativeMethod(
         "setParameterValueNotifyingHost",
-        [this](const juce::var::NativeFunctionArgs& args) {
+        [&proc](const juce::var::NativeFunctionArgs& args) {
             const juce::String& paramId = args.arguments[0].toString();
             const double value = args.arguments[1];
 
-            if (auto* parameter = processor.getValueTreeState().getParameter(paramId))
+            if (auto* parameter = proc.getValueTreeState().getParameter(paramId))
                 parameter->setValueNotifyingHost(value);
         }
     );
 
-    appRoot.registerNativeMethod(
+    appRoot->registerNativeMethod(
         "endParameterChangeGesture",
-        [this](const juce::var::NativeFunctionArgs& args) {
+        [&proc](const juce::var::NativeFunctionArgs& args) {
             const juce::String& paramId = args.arguments[0].toString();
 
-            if (auto* parameter = processor.getValueTreeState().getParameter(paramId))
+            if (auto* parameter = proc.getValueTreeState().getParameter(paramId))
                 parameter->endChangeGesture();
         }
     );
 
-    // Next we just add our appRoot and kick off the app bundle.
-    addAndMakeVisible(appRoot);
-    appRoot.evalScript(bundle.loadFileAsString());
+    // Our sliders drive the parameters themselves, natively, by id.
+    for (auto* p : processor.getParameters())
+        if (auto* x = dynamic_cast<AudioProcessorParameterWithID*>(p))
+            appRoot->registerParameterTarget(x->paramID, blueprint::ParameterTarget::fromParameter(*p));
 
-    // Now our React application is up and running, so we can start dispatching
-    // events, such as current parameter values.
-    for (auto& p : processor.getParameters())
-    {
-        p->addListener(this);
-        p->sendValueChangedMessageToListeners(p->getValue());
-    }
+    // The meter reads the processor's peak values directly, once a frame.
+    appRoot->registerValueChannel("gainPeakValues", processor.getPeakValues());
+    appRoot->registerSampleBuffer("gainOutput", processor.getOutputSamples());
 
-    // Lastly, start our timer for reporting meter values
-    startTimerHz(30);
-
-    // And of course set our editor size before we're done.
-    setResizable(true, true);
-    setResizeLimits(400, 240, 400 * 2, 240 * 2);
-    getConstrainer()->setFixedAspectRatio(400.0 / 240.0);
-    setSize (400, 240);
-}
-
-GainPluginAudioProcessorEditor::~GainPluginAudioProcessorEditor()
-{
-    stopTimer();
-
-    // Tear down parameter listeners
-    for (auto& p : processor.getParameters())
-        p->removeListener(this);
+    // Then we kick off the app bundle. The bundle is compiled in the background,
+    // once, and its bytecode cached, so the editor opens straight away and later
+    // editors skip the compile. The cache lives in the user's own application
+    // data, as bytecode is trusted when loaded and must not be writable by others.
+    appRoot->loadBundleAsync(bundle, blueprint::BytecodeBundle::getDefaultCacheDirectory("GainPlugin"));
 }
 
 //==============================================================================
@@ -97,39 +123,5 @@ void GainPluginAudioProcessorEditor::resized()
 {
     // For this example we'll build the whole UI in javascript, so just
     // let the appRoot take over the whole editor area.
-    appRoot.setBounds(getLocalBounds());
-}
-
-//==============================================================================
-void GainPluginAudioProcessorEditor::parameterValueChanged (int parameterIndex, float newValue)
-{
-    const auto& p = processor.getParameters()[parameterIndex];
-    juce::String id = p->getName(100);
-
-    if (auto* x = dynamic_cast<AudioProcessorParameterWithID*>(p))
-        id = x->paramID;
-
-    float defaultValue = p->getDefaultValue();
-    juce::String stringValue = p->getText(newValue, 0);
-
-    Component::SafePointer<blueprint::ReactApplicationRoot> safeAppRoot (&appRoot);
-
-    juce::MessageManager::callAsync([=]() {
-        if (blueprint::ReactApplicationRoot* root = safeAppRoot.getComponent())
-            root->dispatchEvent("parameterValueChange",
-                                parameterIndex,
-                                id,
-                                defaultValue,
-                                newValue,
-                                stringValue);
-    });
-}
-
-void GainPluginAudioProcessorEditor::timerCallback()
-{
-    appRoot.dispatchEvent(
-        "gainPeakValues",
-        processor.getLeftChannelPeak(),
-        processor.getRightChannelPeak()
-    );
+    appRoot->setBounds(getLocalBounds());
 }
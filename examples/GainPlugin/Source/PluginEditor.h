@@ -17,28 +17,25 @@
 /**
 */
 class GainPluginAudioProcessorEditor
-    : public AudioProcessorEditor,
-      public AudioProcessorParameter::Listener,
-      public Timer
+    : public AudioProcessorEditor
 {
 public:
     GainPluginAudioProcessorEditor (GainPluginAudioProcessor&);
     ~GainPluginAudioProcessorEditor();
 
-    //==============================================================================
-    void parameterValueChanged (int parameterIndex, float newValue) override;
-    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override {}
-    void timerCallback() override;
-
     //==============================================================================
     void paint (Graphics&) override;
     void resized() override;
 
 private:
+    //==============================================================================
+    void createAppRoot();
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     GainPluginAudioProcessor& processor;
-    blueprint::ReactApplicationRoot appRoot;
+    std::unique_ptr<blueprint::ReactApplicationRoot> appRoot;
+    std::unique_ptr<blueprint::ParameterStore> parameterStore;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GainPluginAudioProcessorEditor)
 };
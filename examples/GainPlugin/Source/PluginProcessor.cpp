@@ -113,6 +113,7 @@ void GainPluginAudioProcessor::changeProgramName (int index, const String& newNa
 void GainPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     gain.reset(sampleRate, 0.02);
+    outputSamples.setSampleRate(sampleRate);
 }
 
 void GainPluginAudioProcessor::releaseResources()
@@ -164,12 +165,20 @@ void GainPluginAudioProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuf
     gain.setValue(*params.getRawParameterValue("MainGain"));
     gain.applyGain(buffer, buffer.getNumSamples());
 
-    // We'll also report peak values for our meter. This isn't an ideal way to do this
-    // as the rate between the audio processing callback and the timer on which the
-    // editor reads these values could mean missing peaks in the visual display, but
-    // this is a simple example plugin so let's not worry about it.
-    lcPeak.store(buffer.getMagnitude(0, 0, buffer.getNumSamples()));
-    rcPeak.store(buffer.getMagnitude(1, 0, buffer.getNumSamples()));
+    // We'll also report peak values for our meter, which reads them straight out of
+    // the value channel once per frame. This isn't an ideal way to do this as the
+    // rate between the audio processing callback and the display frame could mean
+    // missing peaks in the visual display, but this is a simple example plugin so
+    // let's not worry about it.
+    const float peaks[] = {
+        buffer.getMagnitude(0, 0, buffer.getNumSamples()),
+        buffer.getMagnitude(1, 0, buffer.getNumSamples())
+    };
+
+    peakValues.setValues(peaks, 2);
+
+    // And the output itself, mixed to mono, for the scope to draw.
+    outputSamples.write(buffer, 0, buffer.getNumSamples());
 }
 
 //==============================================================================
@@ -57,14 +57,19 @@ public:
 
     //==============================================================================
     AudioProcessorValueTreeState& getValueTreeState() { return params; }
-    float getLeftChannelPeak() { return lcPeak; }
-    float getRightChannelPeak() { return rcPeak; }
+    blueprint::ValueChannel& getPeakValues() { return peakValues; }
+    blueprint::SampleRingBuffer& getOutputSamples() { return outputSamples; }
+    blueprint::ParkedRoot& getParkedRoot() { return parkedRoot; }
 
 private:
     //==============================================================================
     AudioProcessorValueTreeState params;
     LinearSmoothedValue<float> gain;
-    std::atomic<float> lcPeak, rcPeak;
+    blueprint::ValueChannel peakValues { 2 };
+    blueprint::SampleRingBuffer outputSamples { 1 << 15 };
+
+    // The editor's appRoot, kept between one editor and the next.
+    blueprint::ParkedRoot parkedRoot;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GainPluginAudioProcessor)
@@ -4,6 +4,7 @@ import React, { Component } from 'react';
 import Slider from './Slider';
 import {
   Image,
+  Scope,
   View,
   Text,
 } from 'juce-blueprint';
@@ -19,6 +20,7 @@ class App extends Component {
             <Label paramId="MainGain" {...styles.label} />
           </Slider>
           <Meter {...styles.meter} />
+          <Scope source="gainOutput" {...styles.scope} />
         </View>
       </View>
     );
@@ -65,6 +67,14 @@ const styles = {
     'width': 100.0,
     'height': 16.0,
   },
+  scope: {
+    'flex': 0.0,
+    'width': '80%',
+    'height': 48.0,
+    'window-size': 2048,
+    'trigger': true,
+    'line-color': 'ff66fdcf',
+  },
 };
 
 export default App;
@@ -10,7 +10,7 @@ class Label extends Component {
   constructor(props) {
     super(props);
 
-    this._onParameterValueChange = this._onParameterValueChange.bind(this);
+    this._onParameterValuesChange = this._onParameterValuesChange.bind(this);
 
     this.state = {
       label: '',
@@ -18,18 +18,20 @@ class Label extends Component {
   }
 
   componentDidMount() {
-    EventBridge.addListener('parameterValueChange', this._onParameterValueChange);
+    EventBridge.addListener('parameterValuesChange', this._onParameterValuesChange);
   }
 
   componentWillUnmount() {
-    EventBridge.removeListener('parameterValueChange', this._onParameterValueChange);
+    EventBridge.removeListener('parameterValuesChange', this._onParameterValuesChange);
   }
 
-  _onParameterValueChange(index, paramId, defaultValue, currentValue, stringValue) {
-    if (paramId === this.props.paramId) {
-      this.setState({
-        label: stringValue,
-      });
+  _onParameterValuesChange(changes) {
+    for (let i = 0; i < changes.length; ++i) {
+      if (changes[i].parameterId === this.props.paramId) {
+        this.setState({
+          label: changes[i].stringValue,
+        });
+      }
     }
   }
 
@@ -1,11 +1,192 @@
+/* global __BlueprintNative__:false */
+
 import BlueprintBackend from './lib/BlueprintBackend';
 import BlueprintRenderer, { BlueprintTracedRenderer } from './lib/BlueprintRenderer';
+import CanvasContext from './lib/CanvasContext';
+import EventBridge from './lib/EventBridge';
 import React, { Component } from 'react';
 
 import invariant from 'invariant';
 
 export { default as NativeMethods } from './lib/NativeMethods';
 export { default as EventBridge } from './lib/EventBridge';
+export { default as ParameterStore } from './lib/ParameterStore';
+export { default as ValueTreeStore } from './lib/ValueTreeStore';
+export { default as StyleSheet } from './lib/StyleSheet';
+export { default as Animation } from './lib/Animation';
+export { default as CanvasContext } from './lib/CanvasContext';
+export { default as Worker } from './lib/Worker';
+export { color, rgba, percent, auto } from './lib/Units';
+
+/** Returns the named native value channel as a Float32Array, or undefined if
+ *  there's no such channel. The array reads the native values in place; they're
+ *  brought up to date before each animation frame, so read them from within a
+ *  `requestAnimationFrame` callback rather than waiting on events.
+ */
+export function getValueChannel(name) {
+  return __BlueprintNative__.getValueChannel(name);
+}
+
+/** Returns a handle on the named native list model, or undefined if the root
+ *  has none. The model holds its items natively and searches and sorts them
+ *  off the message thread; we only ask for the slice of results in view.
+ *
+ *  `setQuery(text, sortColumn, descending)` starts a search, `getCount()` and
+ *  `getSlice(start, count)` read the latest results, each row an object of the
+ *  item's columns and its `index`, and `subscribe(callback)` calls back as new
+ *  results come in, returning a function to unsubscribe.
+ */
+export function getListModel(name) {
+  if (typeof __BlueprintNative__.listModelGetCount !== 'function') {
+    return undefined;
+  }
+
+  return {
+    setQuery(text, sortColumn, descending) {
+      __BlueprintNative__.listModelSetQuery(name, text || '', sortColumn || '', !!descending);
+    },
+    getCount() {
+      return __BlueprintNative__.listModelGetCount(name);
+    },
+    getSlice(start, count) {
+      return __BlueprintNative__.listModelGetSlice(name, start, count);
+    },
+    subscribe(callback) {
+      const listener = (modelName) => {
+        if (modelName === name) {
+          callback();
+        }
+      };
+
+      EventBridge.on('listModelChange', listener);
+      return () => EventBridge.removeListener('listModelChange', listener);
+    },
+  };
+}
+
+const __noteGrids = {};
+
+/** Returns a handle on the named native note grid model, or undefined if the
+ *  root has none. The model holds its notes natively, where NoteGrid views
+ *  draw and edit them; we keep a mirror in `notes`, by id, brought up to date
+ *  by the diffs the model sends once a frame, whoever made the edits.
+ *
+ *  `setNotes(notes)`, `addNote(note)`, `updateNote(note)` and `removeNote(id)`
+ *  edit the model natively; each note is `{ id, pitch, start, length,
+ *  velocity }`, times in beats, and a note added has its id by the next diff.
+ *  `subscribe(callback)` calls back with each diff, `{ reset, added, changed,
+ *  removed }`, once it has been applied to `notes`, returning a function to
+ *  unsubscribe.
+ */
+export function getNoteGrid(name) {
+  if (typeof __BlueprintNative__.noteGridResync !== 'function') {
+    return undefined;
+  }
+
+  if (__noteGrids[name]) {
+    return __noteGrids[name];
+  }
+
+  const callbacks = [];
+
+  const grid = {
+    notes: {},
+    setNotes(notes) {
+      __BlueprintNative__.noteGridSetNotes(name, notes);
+    },
+    addNote(note) {
+      __BlueprintNative__.noteGridAddNote(name, note.pitch, note.start, note.length,
+        typeof note.velocity === 'number' ? note.velocity : 0.8);
+    },
+    updateNote(note) {
+      __BlueprintNative__.noteGridUpdateNote(name, note);
+    },
+    removeNote(id) {
+      __BlueprintNative__.noteGridRemoveNote(name, id);
+    },
+    subscribe(callback) {
+      callbacks.push(callback);
+
+      return () => {
+        const index = callbacks.indexOf(callback);
+
+        if (index >= 0) {
+          callbacks.splice(index, 1);
+        }
+      };
+    },
+  };
+
+  EventBridge.on('noteGridChange', (modelName, diff) => {
+    if (modelName !== name) {
+      return;
+    }
+
+    if (diff.reset) {
+      grid.notes = {};
+    }
+
+    diff.added.forEach((note) => { grid.notes[note.id] = note; });
+    diff.changed.forEach((note) => { grid.notes[note.id] = note; });
+    diff.removed.forEach((id) => { delete grid.notes[id]; });
+
+    callbacks.slice().forEach((callback) => callback(diff));
+  });
+
+  // The model sends us every note as it is, and its edits after that.
+  __BlueprintNative__.noteGridResync(name);
+
+  __noteGrids[name] = grid;
+  return grid;
+}
+
+const __parameterIndices = {};
+
+/** Writes many parameters, registered natively as parameter targets, in one
+ *  call: `updates` is an array of `[parameterId, value]` pairs, each value
+ *  normalised to [0, 1]. Pass `'begin'` as the gesture with the first writes of
+ *  a drag, and `'end'` with the last, and each parameter's change gesture is
+ *  begun and ended with them. The native side writes each parameter at most
+ *  once a frame, with its latest value.
+ */
+export function setParameterValues(updates, gesture) {
+  const flat = new Array(updates.length * 2);
+
+  for (let i = 0; i < updates.length; ++i) {
+    const id = updates[i][0];
+    let index = __parameterIndices[id];
+
+    // Ids resolve to indices once; an id not yet registered is looked up again.
+    if (index === undefined) {
+      index = __BlueprintNative__.getParameterIndex(id);
+
+      if (index >= 0) {
+        __parameterIndices[id] = index;
+      }
+    }
+
+    flat[i * 2] = index;
+    flat[i * 2 + 1] = updates[i][1];
+  }
+
+  __BlueprintNative__.setParameterValues(flat, gesture);
+}
+
+/** Calls `fn`, holding off the engine's own garbage collections until it
+ *  returns, for work which makes a great many short-lived objects at once,
+ *  such as rendering a large new subtree. The native side runs one compacting
+ *  collection in its next idle slot instead. Evaluating the bundle, and with it
+ *  the first mount, is held like this already.
+ */
+export function withAllocationBurst(fn) {
+  __BlueprintNative__.beginAllocationBurst();
+
+  try {
+    return fn();
+  } finally {
+    __BlueprintNative__.endAllocationBurst();
+  }
+}
 
 // We'll need to wrap the default native components in stuff like this so that
 // you can use <View> in your JSX. Otherwise we need the dynamic friendliness
@@ -22,6 +203,95 @@ export function Image(props) {
   return React.createElement('Image', props, props.children);
 }
 
+/** An oscilloscope drawing the latest samples of the native sample buffer
+ *  named by `source`. The samples never reach JavaScript; the native view
+ *  repaints itself as they arrive.
+ */
+export function Scope(props) {
+  return React.createElement('Scope', props, props.children);
+}
+
+/** A spectrum analyser drawing the native sample buffer named by `source`.
+ *  The FFTs run natively, in the background, and neither samples nor bins
+ *  reach JavaScript. Only available where the project has juce_dsp.
+ */
+export function Spectrum(props) {
+  return React.createElement('Spectrum', props, props.children);
+}
+
+/** The waveform of the audio file at `source`, drawn natively from a peak
+ *  pyramid built in the background. Set `view-start` and `view-duration`, in
+ *  seconds, to zoom and scroll; `onLoad` reports the file's duration and
+ *  number of channels. Only available where the project has juce_audio_formats.
+ */
+export function Waveform(props) {
+  return React.createElement('Waveform', props, props.children);
+}
+
+/** A knob or slider which handles its drag natively. With a `parameter-id`,
+ *  it drives the matching parameter target registered with the root, without
+ *  a round trip through JavaScript; `onValueChange` reports new values.
+ */
+export function Slider(props) {
+  return React.createElement('Slider', props, props.children);
+}
+
+/** A Slider skinned with a filmstrip: the image at `source` holds
+ *  `frame-count` pre-rendered frames, and the view blits the one for its value.
+ */
+export function Filmstrip(props) {
+  return React.createElement('Filmstrip', props, props.children);
+}
+
+/** Level meters for the linear levels in the value channel named `source`,
+ *  one bar per value from `channel` for `channel-count` values. Attack,
+ *  release, peak hold and clip indication all run natively once a frame;
+ *  JavaScript only sets the ranges, timings and colours.
+ */
+export function Meter(props) {
+  return React.createElement('Meter', props, props.children);
+}
+
+/** A piano keyboard from `lowest-note` to `highest-note`, painted natively.
+ *  The keys light from the value channel named `source`, of 128 velocities,
+ *  which the processor writes as it sees MIDI, and from `active-notes`.
+ *  Playing the keys with the mouse calls `onNoteChange` once a frame with the
+ *  notes played, as `{ note, velocity }`, a velocity of 0 for a release.
+ */
+export function Keyboard(props) {
+  return React.createElement('Keyboard', props, props.children);
+}
+
+/** A piano roll of the native note grid model named `model`, drawing and
+ *  editing every note natively, so a clip of thousands of notes is still one
+ *  view. `scroll-beat`, `top-pitch`, `beat-width` and `row-height` place the
+ *  grid, which the mouse wheel also scrolls and zooms; clicks add, move,
+ *  resize and remove notes, snapped to `snap` beats, while `editable`. Read
+ *  the notes, and hear of edits, through `getNoteGrid`.
+ */
+export function NoteGrid(props) {
+  return React.createElement('NoteGrid', props, props.children);
+}
+
+/** A GLSL fragment shader filling the view, on the GPU, while the root renders
+ *  through OpenGL. `fragment-shader` is the source; `uniforms` sets the
+ *  shader's uniforms by name, and `channels` binds them to value channels,
+ *  read natively once a frame. `animate` repaints every frame, for shaders of
+ *  `time`. Without OpenGL, only the view's background paints.
+ */
+export function Shader(props) {
+  return React.createElement('Shader', props, props.children);
+}
+
+/** A text input which edits natively, so typing never waits on JavaScript.
+ *  `onChange` reports the text once typing pauses for `change-delay`
+ *  milliseconds, and `onSubmit` as soon as return is pressed; `value` sets
+ *  the text.
+ */
+export function TextInput(props) {
+  return React.createElement('TextInput', props, props.children);
+}
+
 function ScrollViewContentView(props) {
   return React.createElement('ScrollViewContentView', props, props.children);
 }
@@ -39,6 +309,169 @@ export function ScrollView(props) {
 
 ScrollView.ContentView = ScrollViewContentView;
 
+/** A scrollable list of `itemCount` items, each `itemHeight` tall, which mounts
+ *  only the items in view, plus `overscan` items either side.
+ *
+ *  The native view reports which items it wants as the list scrolls, and we
+ *  render those with `renderItem(index)`, each in a row positioned absolutely
+ *  at its place in the list.
+ */
+export class VirtualList extends Component {
+  constructor(props) {
+    super(props);
+
+    this.state = { first: 0, last: 0 };
+    this._onVisibleRangeChange = this._onVisibleRangeChange.bind(this);
+  }
+
+  _onVisibleRangeChange(first, last) {
+    if (first !== this.state.first || last !== this.state.last) {
+      this.setState({ first, last });
+    }
+  }
+
+  render() {
+    const { itemCount, itemHeight, overscan, renderItem, ...other } = this.props;
+    const last = Math.min(this.state.last, itemCount);
+    const rows = [];
+
+    for (let i = this.state.first; i < last; ++i) {
+      rows.push(React.createElement('View', {
+        key: i,
+        'position': 'absolute',
+        'top': i * itemHeight,
+        'left': 0,
+        'right': 0,
+        'height': itemHeight,
+      }, renderItem(i)));
+    }
+
+    return React.createElement('VirtualList', Object.assign({}, other, {
+      'item-count': itemCount,
+      'item-height': itemHeight,
+      'overscan': typeof overscan === 'number' ? overscan : 4,
+      'onVisibleRangeChange': this._onVisibleRangeChange,
+    }), rows);
+  }
+}
+
+/** Mounts its children ahead of their being shown, in idle time, so that
+ *  showing them, on switching to their tab say, only flips their visibility.
+ *
+ *  While `visible` is false the children's view has `display: none`, so takes
+ *  no part in layout or painting, and the children mount into it one at a
+ *  time, each in an idle callback of its own, and so only ever in a frame
+ *  with time to spare. Once shown, any not yet mounted mount at once. Hidden
+ *  again, they stay mounted. With `prerender={false}`, nothing mounts until
+ *  first shown.
+ */
+export class Prerender extends Component {
+  constructor(props) {
+    super(props);
+
+    this.state = { mounted: 0 };
+    this._idleCallback = 0;
+    this._onIdle = this._onIdle.bind(this);
+  }
+
+  static getDerivedStateFromProps(props, state) {
+    const count = React.Children.count(props.children);
+    return props.visible && state.mounted < count ? { mounted: count } : null;
+  }
+
+  componentDidMount() {
+    this._requestIdle();
+  }
+
+  componentDidUpdate() {
+    this._requestIdle();
+  }
+
+  componentWillUnmount() {
+    if (this._idleCallback !== 0) {
+      cancelIdleCallback(this._idleCallback);
+      this._idleCallback = 0;
+    }
+  }
+
+  _requestIdle() {
+    const pending = this.state.mounted < React.Children.count(this.props.children);
+
+    if (pending && this.props.prerender !== false && this._idleCallback === 0) {
+      this._idleCallback = requestIdleCallback(this._onIdle);
+    }
+  }
+
+  _onIdle(deadline) {
+    this._idleCallback = 0;
+
+    // A slot with nothing left of it, we leave for the next.
+    if (deadline.timeRemaining() <= 0) {
+      return this._requestIdle();
+    }
+
+    this.setState((state) => ({ mounted: state.mounted + 1 }));
+  }
+
+  render() {
+    const { visible, prerender, children, ...other } = this.props;
+    const mounted = React.Children.toArray(children).slice(0, this.state.mounted);
+
+    return React.createElement('View', Object.assign({}, other, {
+      'display': visible ? 'flex' : 'none',
+    }), mounted);
+  }
+}
+
+/** A view which paints whatever `draw(ctx, width, height)` records into a
+ *  CanvasContext, at the canvas's measured size.
+ *
+ *  The drawing is recorded on each render, but only sent to the native view
+ *  when it differs from the last one, so a meter redrawn each frame costs a
+ *  copy and a replay only when it actually moves.
+ */
+export class Canvas extends Component {
+  constructor(props) {
+    super(props);
+
+    this.state = { width: 0, height: 0 };
+    this._drawing = null;
+    this._onMeasure = this._onMeasure.bind(this);
+  }
+
+  _onMeasure(width, height, event) {
+    if (width !== this.state.width || height !== this.state.height) {
+      this.setState({ width, height });
+    }
+
+    if (typeof this.props.onMeasure === 'function') {
+      this.props.onMeasure(width, height, event);
+    }
+  }
+
+  render() {
+    const { draw, onMeasure, ...other } = this.props;
+    const ctx = new CanvasContext();
+
+    if (typeof draw === 'function') {
+      draw(ctx, this.state.width, this.state.height);
+    }
+
+    const drawing = ctx.getDrawing();
+
+    // Keeping the previous object when nothing changed means the renderer
+    // sees no change to the property, and sends nothing.
+    if (!CanvasContext.isSameDrawing(drawing, this._drawing)) {
+      this._drawing = drawing;
+    }
+
+    return React.createElement('Canvas', Object.assign({}, other, {
+      'drawing': this._drawing,
+      'onMeasure': this._onMeasure,
+    }), this.props.children);
+  }
+}
+
 View.ClickEventFlags = {
   disableClickEvents: 0,
   allowClickEvents: 1,
@@ -93,8 +526,12 @@ Text.JustificationFlags = {
   bottomRight: 18,
 };
 
+// As React's own renderers tag their portals.
+const REACT_PORTAL_TYPE = (typeof Symbol === 'function' && Symbol.for) ? Symbol.for('react.portal') : 0xeaca;
+
 let __renderStarted = false;
 let __preferredRenderer = BlueprintRenderer;
+let __concurrentRoots = false;
 
 export default {
 
@@ -102,12 +539,39 @@ export default {
     return BlueprintBackend.getRootContainer();
   },
 
+  /** Returns the container for the named surface, a second tree which native
+   *  code shows in a window of its own.
+   */
+  getSurfaceContainer(name) {
+    return BlueprintBackend.getSurfaceContainer(name);
+  },
+
+  /** Returns the container for the named overlay, a tree above the root's own
+   *  views for popups and tooltips, laid out apart from the root's tree.
+   */
+  getOverlayContainer(name) {
+    return BlueprintBackend.getOverlayContainer(name);
+  },
+
+  /** Renders children into another container, such as an overlay, while they
+   *  stay part of the calling component's tree for context and state.
+   */
+  createPortal(children, container, key = null) {
+    return {
+      $$typeof: REACT_PORTAL_TYPE,
+      key: key == null ? null : '' + key,
+      children,
+      containerInfo: container,
+      implementation: null,
+    };
+  },
+
   render(element, container, callback) {
     console.log('Render started...');
 
     // Create a root Container if it doesnt exist
     if (!container._rootContainer) {
-      container._rootContainer = __preferredRenderer.createContainer(container, false);
+      container._rootContainer = __preferredRenderer.createContainer(container, __concurrentRoots);
     }
 
     // Update the root Container
@@ -122,4 +586,35 @@ export default {
     __preferredRenderer = BlueprintTracedRenderer;
   },
 
+  /** Batches every tree mutation of a commit into a binary command buffer,
+   *  applied on the native side with a single bridge call per commit.
+   */
+  enableCommandBuffer() {
+    if (__renderStarted) {
+      throw new Error('Cannot enable the command buffer after initial render.');
+    }
+
+    BlueprintBackend.enableCommandBuffer();
+  },
+
+  /** Renders roots concurrently, so that a long render, such as opening a
+   *  large panel, is split across frames rather than holding up the
+   *  interface until it's done. Work yields whenever `shouldYield()`, below,
+   *  says the frame's budget is spent.
+   */
+  enableConcurrentRendering() {
+    if (__renderStarted) {
+      throw new Error('Cannot enable concurrent rendering after initial render.');
+    }
+
+    __concurrentRoots = true;
+  },
+
+  /** Returns true once the current call into JavaScript has spent the root's
+   *  yield budget, for long work of our own to split across frames too.
+   */
+  shouldYield() {
+    return __BlueprintNative__.shouldYield();
+  },
+
 };
@@ -0,0 +1,65 @@
+/* global __BlueprintNative__:false */
+
+import EventBridge from './EventBridge';
+
+
+// Completion callbacks of the animations in flight, keyed by animation id.
+const __endCallbacks = {};
+
+EventBridge.on('animationEnd', function onAnimationEnd(animationId) {
+  const callback = __endCallbacks[animationId];
+
+  if (typeof callback === 'function') {
+    delete __endCallbacks[animationId];
+    callback(animationId);
+  }
+});
+
+/** Native animations of view properties.
+ *
+ *  An animation is started once from JavaScript and then runs entirely on the
+ *  native side, advancing with each frame and repainting only the animated view,
+ *  so it stays smooth while JavaScript is busy. Animatable properties are
+ *  opacity, transform-rotate, transform-scale, transform-scale-x,
+ *  transform-scale-y, transform-skew-x, transform-skew-y,
+ *  transform-translate-x, transform-translate-y, background-color,
+ *  border-color and color.
+ *
+ *  The config takes `to`, an optional `from` (the view's current value by
+ *  default) and a curve:
+ *
+ *    {type: 'timing', duration: 300, easing: 'easeInOut'}
+ *    {type: 'spring', stiffness: 100, damping: 10, mass: 1, velocity: 0}
+ *    {type: 'decay', velocity: 0.5, deceleration: 0.998}
+ *
+ *  Easings are linear, easeIn, easeOut and easeInOut. Velocities are in units
+ *  per millisecond. A decay comes to rest once its speed falls below an
+ *  optional `restVelocity`, or by default once what's left of its travel is
+ *  negligible.
+ */
+export default {
+
+  /** Starts animating a property of the view behind a ref, replacing any
+   *  animation already running on that property. Returns the animation id, or 0
+   *  if the animation couldn't be started. The optional callback runs once the
+   *  animation comes to rest.
+   */
+  start(instance, property, config, onEnd) {
+    const animationId = __BlueprintNative__.startAnimation(instance._id, property, config);
+
+    if (animationId > 0 && typeof onEnd === 'function') {
+      __endCallbacks[animationId] = onEnd;
+    }
+
+    return animationId;
+  },
+
+  /** Stops an animation, leaving the property at its current value. The
+   *  animation's end callback isn't called.
+   */
+  stop(animationId) {
+    delete __endCallbacks[animationId];
+    __BlueprintNative__.stopAnimation(animationId);
+  },
+
+};
@@ -1,7 +1,14 @@
 /* global __BlueprintNative__:false */
 
+import CommandBuffer from './CommandBuffer';
+
 let __rootViewInstance = null;
+let __surfaceViewInstances = {};
+let __overlayViewInstances = {};
+let __commandBuffer = null;
 let __viewRegistry = {};
+let __viewRegistrySize = 0;
+let __propertyIds = {};
 
 if (typeof window !== 'undefined') {
   // This is just a little shim so that I can build for web and run my renderer
@@ -10,9 +17,18 @@ if (typeof window !== 'undefined') {
     appendChild(parent, child) {
       // noop
     },
+    moveChild(parent, child, index) {
+      // noop
+    },
     getRootInstanceId() {
       return 'rootinstanceid';
     },
+    getSurfaceInstanceId(name) {
+      return 'surfaceinstanceid:' + name;
+    },
+    getOverlayInstanceId(name) {
+      return 'overlayinstanceid:' + name;
+    },
     createViewInstance() {
       return 'someviewinstanceid';
     },
@@ -22,15 +38,105 @@ if (typeof window !== 'undefined') {
     setViewProperty() {
       // Noop
     },
+    getPropertyId() {
+      return 0;
+    },
+    setViewPropertyById() {
+      // Noop
+    },
+    setViewProperties() {
+      // Noop
+    },
+    registerStyleSheet() {
+      return 0;
+    },
+    beginCommit() {
+      // Noop
+    },
+    endCommit() {
+      // Noop
+    },
+    flushCommands() {
+      // Noop
+    },
+    getValueChannel() {
+      return undefined;
+    },
+    shouldYield() {
+      return false;
+    },
+    getFrameTimeRemaining() {
+      return 8;
+    },
+    createWorker() {
+      return 0;
+    },
+    postWorkerMessage() {
+      // Noop
+    },
+    terminateWorker() {
+      // Noop
+    },
+    startAnimation() {
+      return 0;
+    },
+    stopAnimation() {
+      // Noop
+    },
+    getParameterIndex() {
+      return -1;
+    },
+    setParameterValues() {
+      // Noop
+    },
+    beginAllocationBurst() {
+      // Noop
+    },
+    endAllocationBurst() {
+      // Noop
+    },
+    reportViewRegistrySize() {
+      // Noop
+    },
   };
 }
 
+/** Resolves the native integer id for a given property name. We ask the native
+ *  side for each name exactly once and cache the result, so that subsequent
+ *  property updates cross the bridge with an integer rather than a string key.
+ */
+function getPropertyId(propKey) {
+  let propId = __propertyIds[propKey];
+
+  if (typeof propId === 'undefined') {
+    propId = __BlueprintNative__.getPropertyId(propKey);
+    __propertyIds[propKey] = propId;
+  }
+
+  return propId;
+}
+
+/** Copies the handler props, the functions, from a props object into the
+ *  given handler table. The native side holds every other value.
+ */
+function collectHandlers(handlers, props) {
+  for (let key in props) {
+    if (props.hasOwnProperty(key) && typeof props[key] === 'function') {
+      handlers[key] = props[key];
+    }
+  }
+
+  return handlers;
+}
+
 class ViewInstance {
   constructor(id, type, props) {
     this._id = id;
     this._type = type;
     this._children = [];
-    this._props = props;
+
+    // Only the event handlers stay on this side, updated in place.
+    this._handlers = collectHandlers({}, props);
   }
 
   getChildIndex(childInstance) {
@@ -44,30 +150,106 @@ class ViewInstance {
   }
 
   appendChild(childInstance) {
+    // React appends a child it already has to move it to the end.
+    if (this._children.indexOf(childInstance) >= 0)
+      return this.moveChild(childInstance, this._children.length - 1);
+
     this._children.push(childInstance);
+
+    if (__commandBuffer !== null)
+      return __commandBuffer.addChild(this._id, childInstance._id);
+
     return __BlueprintNative__.addChild(this._id, childInstance._id);
   }
 
   insertChild(childInstance, index) {
     this._children.splice(index, 0, childInstance);
+
+    if (__commandBuffer !== null)
+      return __commandBuffer.addChild(this._id, childInstance._id, index);
+
     return __BlueprintNative__.addChild(this._id, childInstance._id, index);
   }
 
+  /** Inserts a child just before another, or, if it's already one of ours,
+   *  moves it there.
+   */
+  insertBefore(childInstance, beforeChild) {
+    const from = this._children.indexOf(childInstance);
+
+    if (from >= 0)
+      this._children.splice(from, 1);
+
+    const index = this._children.indexOf(beforeChild);
+
+    if (index < 0)
+      throw new Error('Failed to find child instance for insertBefore operation.');
+
+    if (from < 0)
+      return this.insertChild(childInstance, index);
+
+    this._children.splice(index, 0, childInstance);
+
+    if (__commandBuffer !== null)
+      return __commandBuffer.moveChild(this._id, childInstance._id, index);
+
+    return __BlueprintNative__.moveChild(this._id, childInstance._id, index);
+  }
+
+  /** Moves one of our children to the given index, in place on the native side,
+   *  so that nothing beneath it is torn down and rebuilt.
+   */
+  moveChild(childInstance, index) {
+    const from = this._children.indexOf(childInstance);
+
+    if (from < 0 || from === index)
+      return;
+
+    this._children.splice(from, 1);
+    this._children.splice(index, 0, childInstance);
+
+    if (__commandBuffer !== null)
+      return __commandBuffer.moveChild(this._id, childInstance._id, index);
+
+    return __BlueprintNative__.moveChild(this._id, childInstance._id, index);
+  }
+
   removeChild(childInstance) {
     const index = this._children.indexOf(childInstance);
 
     if (index >= 0) {
       this._children.splice(index, 1);
+
+      if (__commandBuffer !== null)
+        return __commandBuffer.removeChild(this._id, childInstance._id);
+
       return __BlueprintNative__.removeChild(this._id, childInstance._id);
     }
   }
 
   setProperty(propKey, value) {
-    this._props = Object.assign({}, this._props, {
-      [propKey]: value,
-    });
+    if (typeof value === 'function') {
+      this._handlers[propKey] = value;
+    } else if (this._handlers.hasOwnProperty(propKey)) {
+      delete this._handlers[propKey];
+    }
+
+    if (__commandBuffer !== null)
+      return __commandBuffer.setProperty(this._id, getPropertyId(propKey), value);
+
+    return __BlueprintNative__.setViewPropertyById(this._id, getPropertyId(propKey), value);
+  }
+
+  /** Sets every prop on the native view in a single bridge call. The native side
+   *  ignores the `children` prop, so the props object can be passed as is.
+   */
+  setProperties(props) {
+    collectHandlers(this._handlers, props);
+
+    if (__commandBuffer !== null)
+      return __commandBuffer.setProperties(this._id, props);
 
-    return __BlueprintNative__.setViewProperty(this._id, propKey, value);
+    return __BlueprintNative__.setViewProperties(this._id, props);
   }
 }
 
@@ -79,23 +261,100 @@ class RawTextViewInstance {
 
   setTextValue(text) {
     this._text = text;
+
+    if (__commandBuffer !== null)
+      return __commandBuffer.setText(this._id, text);
+
     return __BlueprintNative__.setRawTextValue(this._id, text);
   }
 }
 
-__BlueprintNative__.dispatchViewEvent = function dispatchEvent(viewId, eventType, ...args) {
-  if (__viewRegistry.hasOwnProperty(viewId)) {
-    let instance = __viewRegistry[viewId];
-    let eventHandler = instance._props[`on${eventType}`];
-
-    // TODO: Could do manual event bubbling here. Form an "event" object, give it to the
-    // handler, and then walk up the parent chain giving the same object to every parent
-    // callback. Would require that ViewInstance carry pointers to parents but that should
-    // be trivial...
-    if (typeof eventHandler === 'function') {
-      eventHandler.call(null, ...args);
+/** The event object handed to view event handlers, after the event arguments. */
+class ViewEvent {
+  constructor(type, target) {
+    this.type = type;
+    this.target = target;
+    this.currentTarget = target;
+    this._propagationStopped = false;
+  }
+
+  stopPropagation() {
+    this._propagationStopped = true;
+  }
+}
+
+/** Invokes a handler prop of the instance with the given id, if it has one. */
+function invokeEventHandler(viewId, handlerName, event, args) {
+  if (!__viewRegistry.hasOwnProperty(viewId))
+    return;
+
+  const instance = __viewRegistry[viewId];
+  const eventHandler = instance._handlers[handlerName];
+
+  if (typeof eventHandler === 'function') {
+    event.currentTarget = instance;
+    eventHandler.apply(null, args);
+  }
+}
+
+/** Drops the instances of views the native side has removed from the tree,
+ *  once per commit, so that neither they nor their handlers outlive the views.
+ */
+__BlueprintNative__.releaseViews = function releaseViews(ids) {
+  for (let i = 0; i < ids.length; ++i) {
+    if (__viewRegistry.hasOwnProperty(ids[i])) {
+      delete __viewRegistry[ids[i]];
+      --__viewRegistrySize;
     }
   }
+
+  __BlueprintNative__.reportViewRegistrySize(__viewRegistrySize);
+};
+
+/** Dispatches a view event along its propagation path.
+ *
+ *  The native side computes the path: the target's id followed by the ids of
+ *  those of its ancestors with a handler for the event. We run the capture
+ *  phase handlers (e.g. `onMouseDownCapture`) from the outermost view inwards,
+ *  then the bubble phase handlers from the target outwards, stopping as soon as
+ *  a handler calls `event.stopPropagation()`.
+ *
+ *  Handlers are called with the event's arguments, followed by the event object.
+ *
+ *  The native side sends the event as a record of its `type`, `path` and
+ *  `args`, one per event type, filled in afresh for each dispatch. We keep the
+ *  event object and handler names on the record in the same way, so a stream
+ *  of drag events reuses one of each rather than leaving garbage behind; an
+ *  event object is only valid during its dispatch, so a handler which wants to
+ *  keep anything of it should copy it out.
+ */
+__BlueprintNative__.dispatchViewEvent = function dispatchEvent(record) {
+  const ids = record.path;
+  const args = record.args;
+  const target = __viewRegistry[ids[0]];
+
+  if (record.event === undefined) {
+    record.event = new ViewEvent(record.type, target);
+    record.handlerName = `on${record.type}`;
+    record.captureName = `${record.handlerName}Capture`;
+  }
+
+  const event = record.event;
+  const handlerName = record.handlerName;
+  const captureName = record.captureName;
+
+  event.target = target;
+  event.currentTarget = target;
+  event._propagationStopped = false;
+  args[args.length] = event;
+
+  for (let i = ids.length - 1; i >= 0 && !event._propagationStopped; --i) {
+    invokeEventHandler(ids[i], captureName, event, args);
+  }
+
+  for (let i = 0; i < ids.length && !event._propagationStopped; ++i) {
+    invokeEventHandler(ids[i], handlerName, event, args);
+  }
 }
 
 export default {
@@ -110,17 +369,92 @@ export default {
     return __rootViewInstance;
   },
 
+  getSurfaceContainer(name) {
+    if (__surfaceViewInstances.hasOwnProperty(name))
+      return __surfaceViewInstances[name];
+
+    const id = __BlueprintNative__.getSurfaceInstanceId(name);
+    __surfaceViewInstances[name] = new ViewInstance(id, 'View');
+
+    return __surfaceViewInstances[name];
+  },
+
+  getOverlayContainer(name) {
+    if (__overlayViewInstances.hasOwnProperty(name))
+      return __overlayViewInstances[name];
+
+    const id = __BlueprintNative__.getOverlayInstanceId(name);
+    __overlayViewInstances[name] = new ViewInstance(id, 'View');
+
+    return __overlayViewInstances[name];
+  },
+
   createViewInstance(viewType, props, parentInstance) {
+    if (__commandBuffer !== null) {
+      // The instance is registered once the buffer is flushed and we know its id.
+      const instance = new ViewInstance(null, viewType, props);
+      instance._id = __commandBuffer.createView(instance, viewType);
+      return instance;
+    }
+
     const id = __BlueprintNative__.createViewInstance(viewType);
     const instance = new ViewInstance(id, viewType, props);
 
     __viewRegistry[id] = instance;
+    ++__viewRegistrySize;
     return instance;
   },
 
   createTextViewInstance(text) {
+    if (__commandBuffer !== null) {
+      const instance = new RawTextViewInstance(null, text);
+      instance._id = __commandBuffer.createTextView(instance, text);
+      return instance;
+    }
+
     const id = __BlueprintNative__.createTextViewInstance(text);
     return new RawTextViewInstance(id, text);
   },
 
+  /** Routes all subsequent tree mutations through a CommandBuffer, which is
+   *  applied on the native side in a single call at the end of each commit.
+   */
+  enableCommandBuffer() {
+    if (__commandBuffer === null) {
+      __commandBuffer = new CommandBuffer();
+    }
+  },
+
+  /** Opens a native commit, deferring layout and repaint until the matching
+   *  `endCommit` call.
+   *
+   *  With the command buffer enabled there's nothing to open; the flush applies
+   *  the whole buffer within a single native commit.
+   */
+  beginCommit() {
+    if (__commandBuffer === null) {
+      __BlueprintNative__.beginCommit();
+    }
+  },
+
+  /** Closes the native commit, after which the native side performs a single
+   *  layout pass and flushes any pending repaints.
+   */
+  endCommit() {
+    if (__commandBuffer !== null) {
+      const result = __commandBuffer.flush(function(instance) {
+        if (instance instanceof ViewInstance) {
+          __viewRegistry[instance._id] = instance;
+          ++__viewRegistrySize;
+        }
+      });
+
+      __BlueprintNative__.reportViewRegistrySize(__viewRegistrySize);
+      return result;
+    }
+
+    __BlueprintNative__.endCommit();
+    __BlueprintNative__.reportViewRegistrySize(__viewRegistrySize);
+  },
+
 };
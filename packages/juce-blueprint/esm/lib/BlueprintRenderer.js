@@ -1,3 +1,5 @@
+/* global __BlueprintNative__:false */
+
 import MethodTracer from './MethodTracer';
 import ReactReconciler from 'react-reconciler';
 import BlueprintBackend from './BlueprintBackend';
@@ -9,11 +11,37 @@ const HostConfig = {
   /** Time provider. */
   now: Date.now,
 
+  /** Time slicing, for a concurrent root. Deferred work runs at the next
+   *  animation frame, and yields back to the native side once the current
+   *  call into JavaScript has spent the root's yield budget; the rest
+   *  carries on at the frame after.
+   */
+  scheduleDeferredCallback(callback, options) {
+    return requestAnimationFrame(() => callback());
+  },
+
+  cancelDeferredCallback(callbackId) {
+    cancelAnimationFrame(callbackId);
+  },
+
+  shouldYield() {
+    return __BlueprintNative__.shouldYield();
+  },
+
   /** Indicates to the reconciler that our DOM tree supports mutating operations
    *  like appendChild, removeChild, etc.
    */
   supportsMutation: true,
 
+  /** Hands refs the ViewInstance itself, so that native methods such as
+   *  animations can address the view by its id.
+   *
+   *  @param {Instance} instance
+   */
+  getPublicInstance(instance) {
+    return instance;
+  },
+
   /** Provides the context for rendering the root level element.
    *
    *  Really only using this and `getChildHostContext` for enforcing nesting
@@ -41,8 +69,26 @@ const HostConfig = {
     return {isInTextParent};
   },
 
-  prepareForCommit: (...args) => {},
-  resetAfterCommit: (...args) => {},
+  /** Called before the reconciler applies a batch of mutations to the tree.
+   *
+   *  We open a native commit here so that the native side can defer all layout
+   *  and repaint work until the whole batch has been applied.
+   *
+   *  @param {Container} containerInfo
+   */
+  prepareForCommit(containerInfo) {
+    BlueprintBackend.beginCommit();
+  },
+
+  /** Called after the reconciler has applied a batch of mutations to the tree.
+   *
+   *  Closing the native commit triggers exactly one layout pass for the batch.
+   *
+   *  @param {Container} containerInfo
+   */
+  resetAfterCommit(containerInfo) {
+    BlueprintBackend.endCommit();
+  },
 
   /** Called to determine whether or not a new text value can be set on an
    *  existing node, or if a new text node needs to be created.
@@ -72,10 +118,16 @@ const HostConfig = {
    *  @param {Object} internalInstanceHandle
    */
   createInstance(elementType, props, rootContainerInstance, hostContext, internalInstanceHandle) {
-    invariant(
-      !hostContext.isInTextParent,
-      'Nesting elements inside of <Text> is currently not supported.'
-    );
+    if (hostContext.isInTextParent) {
+      invariant(
+        elementType === 'Text',
+        'Only <Text> elements may be nested inside of <Text>.'
+      );
+
+      // A nested <Text> is a span of its enclosing text view's text,
+      // laid out along with the rest of it.
+      return BlueprintBackend.createViewInstance('TextSpan', props, rootContainerInstance);
+    }
 
     return BlueprintBackend.createViewInstance(elementType, props, rootContainerInstance);
   },
@@ -107,7 +159,8 @@ const HostConfig = {
 
   /** For each newly constructed node, once we finish the assignment of children
    *  this method will be called to finalize the node. We take this opportunity
-   *  to propagate relevant properties to the node.
+   *  to propagate relevant properties to the node, all at once in a single
+   *  native call.
    *
    *  @param {Instance} instance
    *  @param {String} elementType
@@ -115,11 +168,7 @@ const HostConfig = {
    *  @param {Instance} rootContainerInstance
    */
   finalizeInitialChildren(instance, elementType, props, rootContainerInstance) {
-    Object.keys(props).forEach(function(propKey) {
-      if (propKey !== 'children') {
-        instance.setProperty(propKey, props[propKey]);
-      }
-    });
+    instance.setProperties(props);
   },
 
   /** During a state change, this method will be called to identify the set of
@@ -218,12 +267,18 @@ const HostConfig = {
    *  @Param {Instance} beforeChild
    */
   insertBefore(parentInstance, child, beforeChild) {
-    let index = parentInstance.getChildIndex(beforeChild);
-
-    if (index < 0)
-      throw new Error('Failed to find child instance for insertBefore operation.');
+    parentInstance.insertBefore(child, beforeChild);
+  },
 
-    parentInstance.insertChild(child, index);
+  /** Inserts a child node into a parent container, just before the second
+   *  given child node.
+   *
+   *  @param {Container} parentContainer
+   *  @Param {Instance} child
+   *  @Param {Instance} beforeChild
+   */
+  insertInContainerBefore(parentContainer, child, beforeChild) {
+    parentContainer.insertBefore(child, beforeChild);
   },
 
   /** Remove a child from a parent instance.
@@ -0,0 +1,178 @@
+/** Opcodes understood by the native Canvas view. These must match the Opcode
+ *  enum in blueprint_CanvasView.h.
+ */
+export const CanvasOpcodes = {
+  BEGIN_PATH: 1,
+  MOVE_TO: 2,
+  LINE_TO: 3,
+  QUADRATIC_TO: 4,
+  CUBIC_TO: 5,
+  CLOSE_PATH: 6,
+  RECT: 7,
+  ROUNDED_RECT: 8,
+  ELLIPSE: 9,
+  ARC: 10,
+  FILL: 11,
+  STROKE: 12,
+  CLIP: 13,
+  FILL_RECT: 14,
+  STROKE_RECT: 15,
+  FILL_TEXT: 16,
+  SET_FILL_COLOR: 17,
+  SET_STROKE_COLOR: 18,
+  SET_LINEAR_GRADIENT: 19,
+  SET_RADIAL_GRADIENT: 20,
+  SET_LINE_WIDTH: 21,
+  SET_FONT: 22,
+  SET_GLOBAL_ALPHA: 23,
+  SAVE: 24,
+  RESTORE: 25,
+  TRANSLATE: 26,
+  ROTATE: 27,
+  SCALE: 28,
+};
+
+const Op = CanvasOpcodes;
+
+/** The CanvasContext records drawing calls as opcodes and operands in a
+ *  Float32Array, which a native Canvas view decodes once and replays on each
+ *  paint.
+ *
+ *  Colours, font names and text are held in a side array of strings and
+ *  referenced from the buffer by index. Colours take the same forms as in
+ *  style properties, e.g. 'ff66fdcf'.
+ *
+ *  Gradients are set as `{ type: 'linear', x1, y1, x2, y2, stops }` or
+ *  `{ type: 'radial', cx, cy, r, stops }`, where `stops` is an array of
+ *  `[offset, colour]` pairs, in place of a colour.
+ *
+ *  Angles are in radians, clockwise from 12 o'clock.
+ */
+export default class CanvasContext {
+  constructor(initialCapacity = 256) {
+    this._words = new Float32Array(initialCapacity);
+    this._length = 0;
+    this._strings = [];
+    this._stringIndex = {};
+  }
+
+  _reserve(numWords) {
+    const required = this._length + numWords;
+
+    if (required > this._words.length) {
+      let capacity = this._words.length * 2;
+
+      while (capacity < required) {
+        capacity *= 2;
+      }
+
+      const words = new Float32Array(capacity);
+      words.set(this._words.subarray(0, this._length));
+      this._words = words;
+    }
+  }
+
+  _push(opcode, ...operands) {
+    this._reserve(operands.length + 1);
+    this._words[this._length++] = opcode;
+
+    for (let i = 0; i < operands.length; ++i) {
+      this._words[this._length++] = operands[i];
+    }
+  }
+
+  _string(value) {
+    const key = String(value);
+
+    if (!this._stringIndex.hasOwnProperty(key)) {
+      this._stringIndex[key] = this._strings.length;
+      this._strings.push(key);
+    }
+
+    return this._stringIndex[key];
+  }
+
+  _setStyle(colourOpcode, target, style) {
+    if (typeof style !== 'object') {
+      return this._push(colourOpcode, this._string(style));
+    }
+
+    const stops = style.stops || [];
+    const operands = style.type === 'radial'
+      ? [Op.SET_RADIAL_GRADIENT, target, style.cx, style.cy, style.r, stops.length]
+      : [Op.SET_LINEAR_GRADIENT, target, style.x1, style.y1, style.x2, style.y2, stops.length];
+
+    for (let i = 0; i < stops.length; ++i) {
+      operands.push(stops[i][0], this._string(stops[i][1]));
+    }
+
+    this._push(...operands);
+  }
+
+  set fillStyle(style) { this._setStyle(Op.SET_FILL_COLOR, 0, style); }
+  set strokeStyle(style) { this._setStyle(Op.SET_STROKE_COLOR, 1, style); }
+  set lineWidth(width) { this._push(Op.SET_LINE_WIDTH, width); }
+  set globalAlpha(alpha) { this._push(Op.SET_GLOBAL_ALPHA, alpha); }
+
+  /** Sets the font for `fillText`, with style flags as in Text.FontStyleFlags. */
+  setFont(family, size, styleFlags = 0) {
+    this._push(Op.SET_FONT, this._string(family || ''), size, styleFlags);
+  }
+
+  beginPath() { this._push(Op.BEGIN_PATH); }
+  moveTo(x, y) { this._push(Op.MOVE_TO, x, y); }
+  lineTo(x, y) { this._push(Op.LINE_TO, x, y); }
+  quadraticCurveTo(cx, cy, x, y) { this._push(Op.QUADRATIC_TO, cx, cy, x, y); }
+  bezierCurveTo(c1x, c1y, c2x, c2y, x, y) { this._push(Op.CUBIC_TO, c1x, c1y, c2x, c2y, x, y); }
+  closePath() { this._push(Op.CLOSE_PATH); }
+  rect(x, y, w, h) { this._push(Op.RECT, x, y, w, h); }
+  roundedRect(x, y, w, h, radius) { this._push(Op.ROUNDED_RECT, x, y, w, h, radius); }
+  ellipse(x, y, w, h) { this._push(Op.ELLIPSE, x, y, w, h); }
+  arc(cx, cy, radius, fromRadians, toRadians) { this._push(Op.ARC, cx, cy, radius, fromRadians, toRadians); }
+
+  fill() { this._push(Op.FILL); }
+  stroke() { this._push(Op.STROKE); }
+  clip() { this._push(Op.CLIP); }
+  fillRect(x, y, w, h) { this._push(Op.FILL_RECT, x, y, w, h); }
+  strokeRect(x, y, w, h) { this._push(Op.STROKE_RECT, x, y, w, h); }
+
+  /** Draws text within the given box, justified as in Text.JustificationFlags. */
+  fillText(text, x, y, w, h, justification = 33) {
+    this._push(Op.FILL_TEXT, this._string(text), x, y, w, h, justification);
+  }
+
+  save() { this._push(Op.SAVE); }
+  restore() { this._push(Op.RESTORE); }
+  translate(x, y) { this._push(Op.TRANSLATE, x, y); }
+  rotate(radians) { this._push(Op.ROTATE, radians); }
+  scale(sx, sy = sx) { this._push(Op.SCALE, sx, sy); }
+
+  /** Returns the recorded drawing, as the Canvas view's `drawing` property. */
+  getDrawing() {
+    return {
+      commands: this._words.subarray(0, this._length),
+      strings: this._strings,
+    };
+  }
+
+  /** Returns true if the two drawings have the same commands and strings. */
+  static isSameDrawing(a, b) {
+    if (!a || !b || a.commands.length !== b.commands.length || a.strings.length !== b.strings.length) {
+      return false;
+    }
+
+    for (let i = 0; i < a.commands.length; ++i) {
+      if (a.commands[i] !== b.commands[i]) {
+        return false;
+      }
+    }
+
+    for (let i = 0; i < a.strings.length; ++i) {
+      if (a.strings[i] !== b.strings[i]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,163 @@
+/* global __BlueprintNative__:false */
+
+/** Opcodes understood by the native `flushCommands` call. These must match the
+ *  CommandOpcode enum in blueprint_ReactApplicationRoot.cpp.
+ */
+export const Opcodes = {
+  CREATE_VIEW: 1,
+  CREATE_TEXT_VIEW: 2,
+  SET_PROPERTY: 3,
+  SET_PROPERTIES: 4,
+  ADD_CHILD: 5,
+  REMOVE_CHILD: 6,
+  SET_TEXT: 7,
+  MOVE_CHILD: 8,
+};
+
+/** The CommandBuffer records reconciler mutations as opcodes in an Int32Array
+ *  so that a whole commit can be applied on the native side with a single
+ *  call into `__BlueprintNative__.flushCommands`.
+ *
+ *  Operands which aren't integers (view types, text, property values) are held
+ *  in a side array of values and referenced from the buffer by index.
+ *
+ *  Views created within the buffer don't have a native id until the buffer is
+ *  flushed. Until then they're referenced by a negative handle, -(k + 1), where
+ *  k is the buffer offset at which the native side writes the new view id.
+ */
+export default class CommandBuffer {
+  constructor(initialCapacity = 1024) {
+    this._words = new Int32Array(initialCapacity);
+    this._length = 0;
+    this._values = [];
+    this._pendingCreates = [];
+  }
+
+  _reserve(numWords) {
+    const required = this._length + numWords;
+
+    if (required > this._words.length) {
+      let capacity = this._words.length * 2;
+
+      while (capacity < required) {
+        capacity *= 2;
+      }
+
+      const words = new Int32Array(capacity);
+      words.set(this._words.subarray(0, this._length));
+      this._words = words;
+    }
+  }
+
+  _push(a, b, c, d) {
+    const words = this._words;
+    const at = this._length;
+
+    words[at] = a;
+    words[at + 1] = b;
+    words[at + 2] = c;
+
+    if (typeof d === 'number') {
+      words[at + 3] = d;
+      this._length += 4;
+    } else {
+      this._length += 3;
+    }
+
+    return at;
+  }
+
+  _pushValue(value) {
+    this._values.push(value);
+    return this._values.length - 1;
+  }
+
+  _pushCreate(opcode, instance, value) {
+    this._reserve(3);
+
+    const at = this._push(opcode, 0, this._pushValue(value));
+    const resultOffset = at + 1;
+
+    this._pendingCreates.push(instance, resultOffset);
+    return -(resultOffset + 1);
+  }
+
+  /** Records a view creation, returning a handle to be used as the new view's
+   *  id until the buffer is flushed.
+   */
+  createView(instance, viewType) {
+    return this._pushCreate(Opcodes.CREATE_VIEW, instance, viewType);
+  }
+
+  /** Records a raw text view creation, returning a handle as for createView. */
+  createTextView(instance, text) {
+    return this._pushCreate(Opcodes.CREATE_TEXT_VIEW, instance, text);
+  }
+
+  setProperty(viewId, propId, value) {
+    this._reserve(4);
+    this._push(Opcodes.SET_PROPERTY, viewId, propId, this._pushValue(value));
+  }
+
+  setProperties(viewId, props) {
+    this._reserve(3);
+    this._push(Opcodes.SET_PROPERTIES, viewId, this._pushValue(props));
+  }
+
+  addChild(parentId, childId, index = -1) {
+    this._reserve(4);
+    this._push(Opcodes.ADD_CHILD, parentId, childId, index);
+  }
+
+  removeChild(parentId, childId) {
+    this._reserve(3);
+    this._push(Opcodes.REMOVE_CHILD, parentId, childId);
+  }
+
+  moveChild(parentId, childId, index) {
+    this._reserve(4);
+    this._push(Opcodes.MOVE_CHILD, parentId, childId, index);
+  }
+
+  setText(viewId, text) {
+    this._reserve(3);
+    this._push(Opcodes.SET_TEXT, viewId, this._pushValue(text));
+  }
+
+  /** Applies every recorded command on the native side in a single call, then
+   *  hands each newly created instance its native view id.
+   *
+   *  The native commit stays open until every instance has its id, so that
+   *  each is registered before the commit's layout and events run.
+   *
+   *  @param {Function} onCreated Invoked for each created instance once it has its id.
+   */
+  flush(onCreated) {
+    if (this._length === 0) {
+      return;
+    }
+
+    const words = this._words.subarray(0, this._length);
+    const values = this._values;
+    const pending = this._pendingCreates;
+
+    this._length = 0;
+    this._values = [];
+    this._pendingCreates = [];
+
+    __BlueprintNative__.beginCommit();
+
+    try {
+      __BlueprintNative__.flushCommands(words, values);
+
+      for (let i = 0; i < pending.length; i += 2) {
+        const instance = pending[i];
+
+        instance._id = words[pending[i + 1]];
+        onCreated(instance);
+      }
+    } finally {
+      __BlueprintNative__.endCommit();
+    }
+  }
+}
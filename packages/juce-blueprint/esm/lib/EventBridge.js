@@ -11,4 +11,12 @@ __BlueprintNative__.dispatchEvent = function dispatchEvent(eventType, ...args) {
   EventBridge.emit(eventType, ...args);
 }
 
+// The native side collects events dispatched from realtime threads and hands
+// us a frame's worth at a time, as an array of [eventType, ...args] entries.
+__BlueprintNative__.dispatchEventBatch = function dispatchEventBatch(events) {
+  for (let i = 0; i < events.length; ++i) {
+    EventBridge.emit(...events[i]);
+  }
+}
+
 export default EventBridge;
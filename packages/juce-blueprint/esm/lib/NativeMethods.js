@@ -3,7 +3,7 @@ export default new Proxy(__BlueprintNative__, {
   get(target, propKey, receiver) {
     if (target.hasOwnProperty(propKey) && typeof target[propKey] === 'function') {
       return function __nativeWrapper__(...args) {
-        target[propKey].call(null, ...args);
+        return target[propKey].call(null, ...args);
       }
     }
 
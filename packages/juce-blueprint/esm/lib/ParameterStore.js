@@ -0,0 +1,51 @@
+import EventEmitter from 'events';
+import EventBridge from './EventBridge';
+
+
+/** The latest known state of each of the plugin's parameters, by id, mirrored
+ *  from the native ParameterStore.
+ *
+ *  The native side coalesces parameter changes, sending at most one batch per
+ *  frame with the latest value of each parameter that changed. The store
+ *  applies the whole batch, then emits a change event for each parameter in it.
+ */
+class ParameterStore extends EventEmitter {
+  constructor() {
+    super();
+
+    this.CHANGE_EVENT = 'change';
+
+    this.setMaxListeners(100);
+    this._onParameterValuesChange = this._onParameterValuesChange.bind(this);
+
+    EventBridge.addListener('parameterValuesChange', this._onParameterValuesChange);
+
+    this.state = {};
+  }
+
+  /** Returns { parameterIndex, parameterId, defaultValue, currentValue,
+   *  stringValue } for the given parameter, or an empty object before its
+   *  first value arrives.
+   */
+  getParameterState(paramId) {
+    if (!this.state.hasOwnProperty(paramId)) {
+      return {};
+    }
+
+    return this.state[paramId];
+  }
+
+  _onParameterValuesChange(changes) {
+    for (let i = 0; i < changes.length; ++i) {
+      this.state[changes[i].parameterId] = changes[i];
+    }
+
+    for (let i = 0; i < changes.length; ++i) {
+      this.emit(this.CHANGE_EVENT, changes[i].parameterId);
+    }
+  }
+}
+
+const __singletonInstance = new ParameterStore();
+
+export default __singletonInstance;
@@ -0,0 +1,63 @@
+/* global __BlueprintNative__:false */
+
+import { color, percent } from './Units';
+
+const PERCENT_PATTERN = /^\s*-?[0-9.]+\s*%\s*$/;
+
+/** Returns the style with its colour strings and percentages in their numeric
+ *  encodings, which every view taking the style then reads as is.
+ */
+function encodeStyle(style) {
+  const encoded = {};
+
+  for (let name in style) {
+    if (style.hasOwnProperty(name)) {
+      const value = style[name];
+
+      if (typeof value === 'string' && /color$/.test(name)) {
+        encoded[name] = color(value);
+      } else if (typeof value === 'string' && PERCENT_PATTERN.test(value)) {
+        encoded[name] = percent(parseFloat(value.replace('%', '')));
+      } else {
+        encoded[name] = value;
+      }
+    }
+  }
+
+  return encoded;
+}
+
+/** Static styles, registered natively once and then shared by every view that
+ *  uses them.
+ *
+ *  `create` takes an object of named styles, each a plain object of view
+ *  properties, and returns an object of the same names, each the native id of
+ *  its style. A view takes a style by its `styleId` prop alone, so applying
+ *  it costs one property set however many properties it holds:
+ *
+ *    const styles = StyleSheet.create({
+ *      panel: { 'flex': 1, 'background-color': 'ff17191f', 'border-radius': 4 },
+ *    });
+ *
+ *    <View styleId={styles.panel} padding={8} />
+ *
+ *  Colours and percentages are converted to their numeric encodings as the
+ *  style is created; see Units.js. A view's own props override its style's. Moving a view to another style
+ *  leaves in place whatever the new style doesn't set, as leaving a prop out
+ *  of a later render does.
+ */
+const StyleSheet = {
+  create(styles) {
+    const ids = {};
+
+    for (let name in styles) {
+      if (styles.hasOwnProperty(name)) {
+        ids[name] = __BlueprintNative__.registerStyleSheet(encodeStyle(styles[name]));
+      }
+    }
+
+    return ids;
+  },
+};
+
+export default StyleSheet;
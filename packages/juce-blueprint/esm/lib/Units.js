@@ -0,0 +1,41 @@
+/** Numeric encodings of colours and lengths, which native views read without
+ *  parsing a string.
+ *
+ *  Colour properties take a packed ARGB number, 0xAARRGGBB, as well as the hex
+ *  string `Colour::fromString` reads; `color('ff17191f')` converts the one to
+ *  the other, and `rgba(23, 25, 31, 1)` packs the components. Length
+ *  properties take a number of points as before, and `percent(50)` or `auto`
+ *  in place of '50%' or 'auto'. Convert constants once, outside of render,
+ *  so that the string work isn't done again each render either.
+ *
+ *    const panel = color('ff17191f');
+ *
+ *    <View background-color={panel} width={percent(50)} />
+ */
+
+// As the native ViewStyle decodes them: anything this far past a point value
+// carries a unit instead.
+const PERCENT_OFFSET = 4294967296;
+const AUTO_VALUE = 8589934592;
+
+/** Returns the given hex ARGB colour string as a packed number. Non-hex
+ *  characters, such as a leading '#', are ignored, as they are natively.
+ */
+export function color(hex) {
+  const digits = String(hex).replace(/[^0-9a-fA-F]/g, '').slice(-8);
+  return digits.length > 0 ? parseInt(digits, 16) >>> 0 : 0;
+}
+
+/** Packs the given colour components, each of 0 to 255, and alpha of 0 to 1. */
+export function rgba(r, g, b, a = 1) {
+  const alpha = Math.round(Math.max(0, Math.min(1, a)) * 255);
+  return ((alpha << 24) | ((r & 0xff) << 16) | ((g & 0xff) << 8) | (b & 0xff)) >>> 0;
+}
+
+/** Returns the given percentage as a length. */
+export function percent(value) {
+  return PERCENT_OFFSET + value;
+}
+
+/** The `auto` length, for the flex dimension properties which take one. */
+export const auto = AUTO_VALUE;
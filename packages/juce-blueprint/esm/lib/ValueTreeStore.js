@@ -0,0 +1,84 @@
+import EventEmitter from 'events';
+import EventBridge from './EventBridge';
+
+
+/** Copies of the native juce::ValueTrees mirrored by ValueTreeStores, by name.
+ *
+ *  Each tree is a node, `{ type, properties, children }`, as the native store
+ *  sends it first, and then brought up to date by the patches it sends at
+ *  most once a frame, applied in place. Once a batch is applied, the store
+ *  emits a change event with the tree's name and the batch, whose patches
+ *  say which nodes changed, by their paths from the root:
+ *
+ *    ValueTreeStore.on('change', (name, patches) => { ... });
+ */
+class ValueTreeStore extends EventEmitter {
+  constructor() {
+    super();
+
+    this.CHANGE_EVENT = 'change';
+
+    this.setMaxListeners(100);
+    this._onValueTreeChange = this._onValueTreeChange.bind(this);
+
+    EventBridge.addListener('valueTreeChange', this._onValueTreeChange);
+
+    this.trees = {};
+  }
+
+  /** Returns the named tree, or undefined before it first arrives. The same
+   *  objects are updated as changes come in.
+   */
+  getTree(name) {
+    return this.trees[name];
+  }
+
+  _onValueTreeChange(name, patches) {
+    for (let i = 0; i < patches.length; ++i) {
+      this._applyPatch(name, patches[i]);
+    }
+
+    this.emit(this.CHANGE_EVENT, name, patches);
+  }
+
+  _applyPatch(name, patch) {
+    if (patch.op === 'reset') {
+      this.trees[name] = patch.node;
+      return;
+    }
+
+    let node = this.trees[name];
+
+    for (let i = 0; node !== undefined && i < patch.path.length; ++i) {
+      node = node.children[patch.path[i]];
+    }
+
+    if (node === undefined) {
+      return;
+    }
+
+    switch (patch.op) {
+      case 'set':
+        node.properties[patch.property] = patch.value;
+        break;
+      case 'remove-property':
+        delete node.properties[patch.property];
+        break;
+      case 'insert':
+        node.children.splice(patch.index, 0, patch.node);
+        break;
+      case 'remove':
+        node.children.splice(patch.index, 1);
+        break;
+      case 'move':
+        node.children.splice(patch.to, 0, node.children.splice(patch.from, 1)[0]);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+const __singletonInstance = new ValueTreeStore();
+
+export default __singletonInstance;
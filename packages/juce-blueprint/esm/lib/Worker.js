@@ -0,0 +1,60 @@
+/* global __BlueprintNative__:false */
+
+import EventBridge from './EventBridge';
+
+
+// The workers still running, keyed by worker id.
+const __workers = {};
+
+EventBridge.on('workerMessage', function onWorkerMessage(workerId, data) {
+  const worker = __workers[workerId];
+
+  if (worker && typeof worker.onmessage === 'function') {
+    worker.onmessage({ data });
+  }
+});
+
+EventBridge.on('workerError', function onWorkerError(workerId, message) {
+  const worker = __workers[workerId];
+
+  if (worker && typeof worker.onerror === 'function') {
+    worker.onerror({ message });
+  }
+});
+
+/** A background script on a Duktape heap and thread of its own, for work too
+ *  heavy for the interface's heap.
+ *
+ *  `path` is the worker's bundle, relative to the module directory. The
+ *  bundle calls `postMessage(value)` to send values back, which arrive here
+ *  in `onmessage({data})`, and sets a global `onmessage` for those we send it.
+ *  Values cross between heaps as CBOR, so plain data and buffers survive the
+ *  trip; buffers are copied, and `transfer` is accepted only to match the
+ *  browser's signature. Uncaught errors arrive in `onerror({message})`.
+ */
+export default class Worker {
+  constructor(path) {
+    this.onmessage = null;
+    this.onerror = null;
+    this._id = __BlueprintNative__.createWorker(path);
+
+    if (this._id === 0) {
+      throw new Error(`No worker bundle at ${path}`);
+    }
+
+    __workers[this._id] = this;
+  }
+
+  postMessage(value, transfer) { // eslint-disable-line no-unused-vars
+    if (__workers[this._id] === this) {
+      __BlueprintNative__.postWorkerMessage(this._id, value);
+    }
+  }
+
+  terminate() {
+    if (__workers[this._id] === this) {
+      delete __workers[this._id];
+      __BlueprintNative__.terminateWorker(this._id);
+    }
+  }
+}
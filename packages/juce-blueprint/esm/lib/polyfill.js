@@ -1,76 +1,48 @@
-/** Polyfill ES2015 data structures with core-js. */
-import 'core-js/es6/set';
-import 'core-js/es6/map';
-
-/** The EventLoop manages all outstanding timers, invoking callbacks and
- *  clearing the registry in response to a regular interrupt from the JUCE
- *  backend.
+/** ES2015 data structures.
+ *
+ *  `Map` and `Set` are installed natively by the JUCE backend. core-js adds the
+ *  iterator protocol around them, and keeps their native methods.
  *
- *  This is not a proper event loop; just a thin wrapper for polyfilling
- *  timer methods in the global scope.
+ *  Where Duktape's built-ins live in ROM (BLUEPRINT_DUKTAPE_ROM_BUILTINS), the
+ *  built-in prototypes are read-only and core-js can't patch them, so there we
+ *  make do with the native collections alone.
  */
-class EventLoop {
-  constructor() {
-    this._timers = {};
-    this._nextId = 0;
-  }
-
-  setTimeout(fn, time, a, b, c, d, e, f) {
-    let id = this._nextId++;
-    this._timers[id] = {
-      f: fn,
-      eventTime: performance.now() + time,
-      vargs: [a, b, c, d, e, f],
-    };
-  }
-
-  clearTimeout(id) {
-    if (this._timers.hasOwnProperty(id)) {
-      delete this._timers[id];
-    }
-  }
-
-  tick() {
-    for (let key in this._timers) {
-      if (this._timers.hasOwnProperty(key)) {
-        let timer = this._timers[key];
-        let eventTime = timer.eventTime;
-
-        if (performance.now() >= eventTime) {
-          timer.f.apply(null, timer.vargs);
-          delete this._timers[key];
-        }
-      }
-    }
-  }
+if (Object.isExtensible(Object.prototype)) {
+  require('core-js/es6/set');
+  require('core-js/es6/map');
 }
 
-/** Our polyfills all operate over a single event loop instance. */
-const el = new EventLoop();
+/** Timers.
+ *
+ *  `setTimeout`, `clearTimeout`, `setInterval` and `clearInterval` are installed
+ *  natively by the JUCE backend, and backed by a timer queue that wakes the
+ *  backend only when a timer is due. So is `queueMicrotask`, whose callbacks
+ *  run once the call into JavaScript which queued them returns, and
+ *  `requestIdleCallback` and `cancelIdleCallback`, whose callbacks run once a
+ *  frame's work is done with time to spare, given a deadline whose
+ *  `timeRemaining()` says how much. There's nothing for us to polyfill.
+ *
+ *  Nor for `performance.now()`, on the same high resolution clock as the
+ *  timers and animation frames, or `performance.mark` and `performance.measure`,
+ *  which write into the native trace when it's recording.
+ */
 
-/** This is the native hook that the juce backend looks to call. */
-function __schedulerInterrupt__() {
-  el.tick();
-}
+/** Promises.
+ *
+ *  Duktape has no Promise, so core-js provides one. core-js runs Promise jobs
+ *  with `setImmediate` where there is one, and otherwise on a zero delay timer,
+ *  which waits for the next timer tick. So while it loads we hand it the
+ *  backend's native `queueMicrotask` as its `setImmediate`, and Promise jobs
+ *  then run as soon as the call into JavaScript which queued them returns,
+ *  within the same frame.
+ */
+if (Object.isExtensible(Object.prototype) && typeof Promise === 'undefined' &&
+    typeof queueMicrotask === 'function' && typeof setImmediate === 'undefined') {
+  global.setImmediate = function(fn) { queueMicrotask(fn); };
+  global.clearImmediate = function() {};
 
-/** A simple global setTimeout wrapper around the event loop instance. */
-function __setTimeout__ (a, b, c, d, e, f, g) {
-  return el.setTimeout(a, b, c, d, e, f, g);
-}
+  require('core-js/es6/promise');
 
-/** A global setInterval implementation which falls back to setTimeout. */
-function __setInterval__ (cb, wait, c, d, e, f, g) {
-  // TODO: This isn't quite correct because we'll generate a new timer id
-  // on each iteration and the id returned to the caller will become invalid
-  // by the second iteration.
-  return el.setTimeout(function() {
-    cb.call(null, c, d, e, f, g);
-    el.setTimeout(cb, wait, c, d, e, f, g);
-  }, wait);
+  delete global.setImmediate;
+  delete global.clearImmediate;
 }
-
-
-/** Attach our polyfills */
-global.__schedulerInterrupt__ = __schedulerInterrupt__;
-global.setTimeout = __setTimeout__;
-global.setInterval = __setInterval__;
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 15 Oct 2026 3:12:40am
+
+    A command line tool which compiles a webpack bundle into a Blueprint
+    bytecode bundle, along with a BinaryData style C++ source file embedding
+    it, so that a shipping plugin never has to carry or compile its JavaScript.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+
+namespace
+{
+
+    //==============================================================================
+    void printUsage()
+    {
+        std::cout << "Usage:" << std::endl
+                  << "  BundleCompiler <main.js> <output> [--namespace <name>] [--symbol <name>]" << std::endl
+                  << "      Compiles the bundle into <output>.bpbc, <output>.h and <output>.cpp." << std::endl
+                  << "  BundleCompiler --verify <bundle.bpbc>" << std::endl
+                  << "      Checks that a bytecode bundle can be loaded by this Duktape build." << std::endl
+                  << "  BundleCompiler --fingerprint" << std::endl
+                  << "      Prints the fingerprint of this Duktape build." << std::endl;
+    }
+
+    juce::String getFingerprintString()
+    {
+        return "0x" + juce::String::toHexString(blueprint::BytecodeBundle::getDuktapeFingerprint())
+                    + " (Duktape " + DUK_GIT_DESCRIBE + ")";
+    }
+
+    //==============================================================================
+    /** Writes a header and source file embedding the bundle as BinaryData does,
+        so the generated pair can be dropped into a project as is.
+     */
+    bool writeSourceFiles (const juce::MemoryBlock& bundle, const juce::File& output,
+                           const juce::String& nameSpace, const juce::String& symbol)
+    {
+        const auto headerFile = output.withFileExtension("h");
+        const auto sourceFile = output.withFileExtension("cpp");
+
+        juce::MemoryOutputStream header;
+
+        header << "/* Generated by BundleCompiler; do not edit. */" << juce::newLine
+               << juce::newLine
+               << "#pragma once" << juce::newLine
+               << juce::newLine
+               << "namespace " << nameSpace << juce::newLine
+               << "{" << juce::newLine
+               << "    extern const char*  " << symbol << ";" << juce::newLine
+               << "    const int           " << symbol << "Size = " << (int) bundle.getSize() << ";" << juce::newLine
+               << juce::newLine
+               << "    // The Duktape build the bundle was compiled with, which must match the" << juce::newLine
+               << "    // build it's loaded into; see blueprint::BytecodeBundle." << juce::newLine
+               << "    const long long     " << symbol << "DuktapeFingerprint = "
+               << juce::String(blueprint::BytecodeBundle::getDuktapeFingerprint()) << "LL;" << juce::newLine
+               << "}" << juce::newLine;
+
+        juce::MemoryOutputStream source;
+
+        source << "/* Generated by BundleCompiler; do not edit. */" << juce::newLine
+               << juce::newLine
+               << "#include \"" << headerFile.getFileName() << "\"" << juce::newLine
+               << juce::newLine
+               << "namespace " << nameSpace << juce::newLine
+               << "{" << juce::newLine
+               << juce::newLine
+               << "static const unsigned char " << symbol << "Data[] =" << juce::newLine
+               << "{";
+
+        const auto* bytes = static_cast<const juce::uint8*>(bundle.getData());
+
+        for (size_t i = 0; i < bundle.getSize(); ++i)
+        {
+            if (i % 32 == 0)
+                source << juce::newLine << "    ";
+
+            source << (int) bytes[i] << ",";
+        }
+
+        source << juce::newLine
+               << "};" << juce::newLine
+               << juce::newLine
+               << "const char* " << symbol << " = (const char*) " << symbol << "Data;" << juce::newLine
+               << juce::newLine
+               << "}" << juce::newLine;
+
+        return headerFile.replaceWithData(header.getData(), header.getDataSize())
+            && sourceFile.replaceWithData(source.getData(), source.getDataSize());
+    }
+
+    //==============================================================================
+    int compile (const juce::File& input, const juce::File& output, const juce::String& nameSpace, const juce::String& symbol)
+    {
+        std::unique_ptr<juce::MemoryMappedFile> source;
+
+        if (!blueprint::BytecodeBundle::mapBundle(input, source))
+        {
+            std::cerr << "Failed to read " << input.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        duk_context* ctx = duk_create_heap_default();
+
+        juce::MemoryBlock bundle;
+        juce::String error;
+
+        const bool compiled = blueprint::BytecodeBundle::compile(ctx, static_cast<const char*>(source->getData()),
+                                                                 source->getSize(), input.getFileName(), bundle, error);
+        duk_destroy_heap(ctx);
+
+        if (!compiled)
+        {
+            std::cerr << "Failed to compile " << input.getFileName() << ": " << error << std::endl;
+            return 1;
+        }
+
+        if (!output.getParentDirectory().createDirectory()
+            || !output.withFileExtension("bpbc").replaceWithData(bundle.getData(), bundle.getSize())
+            || !writeSourceFiles(bundle, output, nameSpace, symbol))
+        {
+            std::cerr << "Failed to write " << output.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::cout << "Compiled " << input.getFileName() << " (" << (int) source->getSize() << " bytes) into "
+                  << (int) bundle.getSize() << " bytes of bytecode for " << getFingerprintString() << std::endl;
+        return 0;
+    }
+
+    int verify (const juce::File& file)
+    {
+        juce::MemoryBlock bundle;
+
+        if (!file.loadFileAsData(bundle))
+        {
+            std::cerr << "Failed to read " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        const void* bytecode = nullptr;
+        size_t bytecodeSize = 0;
+        juce::String error;
+
+        if (!blueprint::BytecodeBundle::getBytecode(bundle.getData(), bundle.getSize(), bytecode, bytecodeSize, error))
+        {
+            std::cerr << file.getFileName() << " can't be loaded by " << getFingerprintString() << ": " << error << std::endl;
+            return 1;
+        }
+
+        std::cout << file.getFileName() << " is compatible with " << getFingerprintString() << std::endl;
+        return 0;
+    }
+
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::CharPointer_UTF8(argv[i]));
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    if (args.size() == 1 && args[0] == "--fingerprint")
+    {
+        std::cout << getFingerprintString() << std::endl;
+        return 0;
+    }
+
+    if (args.size() == 2 && args[0] == "--verify")
+        return verify(cwd.getChildFile(args[1]));
+
+    if (args.size() < 2 || args[0].startsWith("--") || args[1].startsWith("--"))
+    {
+        printUsage();
+        return 1;
+    }
+
+    juce::String nameSpace ("BlueprintBundle");
+    juce::String symbol ("mainBundle");
+
+    for (int i = 2; i < args.size(); i += 2)
+    {
+        if (i + 1 >= args.size())
+        {
+            printUsage();
+            return 1;
+        }
+
+        if (args[i] == "--namespace")
+            nameSpace = args[i + 1];
+        else if (args[i] == "--symbol")
+            symbol = args[i + 1];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    return compile(cwd.getChildFile(args[0]), cwd.getChildFile(args[1]), nameSpace, symbol);
+}